@@ -19,15 +19,14 @@
 #include "common/stringtool.h"
 #include "common/tonccpy.h"
 #include "fileCopy.h"
-#include "save/Save.h"
+#include "gbapatch/romScan.h"
+#include "gbapatch/Save.h"
 #include "gbaswitch.h"
 
 static u8 blankBuf[0x10000] = {0};
 u8 borderData[0x30000] = {0};
 std::string gbaBorder = "default.png";
 
-u32 romSize = 0;
-
 u32 greenSwapPatch[8] = {
 	0xE59F000C,	// LDR  R0, =0x4000002
 	0xE59F100C, // LDR  R1, =1
@@ -124,19 +123,14 @@ ITCM_CODE void gptc_patchWait()
 	u32 branchCode = 0xEA000000+(patchOffset/sizeof(u32))-2;
 	tonccpy((u16*)0x08000000, &branchCode, sizeof(u32));
 
-	u32 searchRange = 0x08000000+romSize;
-	if (romSize > 0x01FFFFDC) searchRange = 0x09FFFFDC;
+	u32 searchRange = romSize;
+	if (romSize > 0x01FFFFDC) searchRange = 0x01FFFFDC;
 
 	// General fix for white screen crash
-	// Patch out wait states
-	for (u32 addr = 0x080000C0; addr < searchRange; addr+=4) {
-		if ((*(u8*)(addr-1) == 0x00 || *(u8*)(addr-1) == 0x03 || *(u8*)(addr-1) == 0x04 || *(u8*)(addr+7) == 0x04
-		  || *(u8*)(addr-1) == 0x08 || *(u8*)(addr-1) == 0x09
-		  || *(u8*)(addr-1) == 0x47 || *(u8*)(addr-1) == 0x81 || *(u8*)(addr-1) == 0x85
-		  || *(u8*)(addr-1) == 0xE0 || *(u8*)(addr-1) == 0xE7 || *(u16*)(addr-2) == 0xFFFE)
-		&& *(u32*)addr == 0x04000204) {
-			toncset((u16*)addr, 0, sizeof(u32));
-		}
+	// Patch out wait states, while scanning for the save tag and patch signatures,
+	// unless the menu already did both as it loaded the ROM
+	if (romScan_waitStateEnd() != searchRange) {
+		romScan_run(searchRange);
 	}
 
 	// Also check at 0x410
@@ -625,9 +619,13 @@ int main(int argc, char **argv) {
 		}
 		s2RamAccess(false);
 	} else if (*(u32*)0x080000AC != 0x4732424D) {
+		save_addScanPatterns();
+		const bool scanned = romScan_load(argv[1]);
 		if (*(u16*)(0x020000C0) != 0x5A45) {
 			gptc_patchRom();
 			//iprintf("ROM patched\n");
+		} else if (!scanned) {
+			romScan_run(0);
 		}
 
 		const save_type_t* saveType = save_findTag();
@@ -25,6 +25,7 @@
 #include "common/twlmenusettings.h"
 #include "graphics/gif.hpp"
 #include "common/lodepng.h"
+#include "common/colorConvert.h"
 #include "graphics/color.h"
 
 #include <nds.h>
@@ -148,73 +149,8 @@ void imageLoad(const char* filename) {
 			}
 		}
 
-		bool alternatePixel = false;
-		int x = 0;
-		int y = 0;
-		u8 pixelAdjustInfo = 0;
-		for (unsigned i=0;i<image.size()/4;i++) {
-			pixelAdjustInfo = 0;
-			if (alternatePixel) {
-				if (image[(i*4)] >= 0x4) {
-					image[(i*4)] -= 0x4;
-					pixelAdjustInfo |= BIT(0);
-				}
-				if (image[(i*4)+1] >= 0x4) {
-					image[(i*4)+1] -= 0x4;
-					pixelAdjustInfo |= BIT(1);
-				}
-				if (image[(i*4)+2] >= 0x4) {
-					image[(i*4)+2] -= 0x4;
-					pixelAdjustInfo |= BIT(2);
-				}
-			}
-			if (image[(i*4)+3] > 0) {
-				u16 color = image[i*4]>>3 | (image[(i*4)+1]>>3)<<5 | (image[(i*4)+2]>>3)<<10 | BIT(15);
-				if (ms().colorMode == 1) {
-					color = convertVramColorToGrayscale(color);
-				}
-				dsImageBuffer[0][(xPos+x+(y*256))+(yPos*256)] = alphablend(color, 0, image[(i*4)+3]);
-			} else {
-				dsImageBuffer[0][(xPos+x+(y*256))+(yPos*256)] = 0;
-			}
-			if (alternatePixel) {
-				if (pixelAdjustInfo & BIT(0)) {
-					image[(i*4)] += 0x4;
-				}
-				if (pixelAdjustInfo & BIT(1)) {
-					image[(i*4)+1] += 0x4;
-				}
-				if (pixelAdjustInfo & BIT(2)) {
-					image[(i*4)+2] += 0x4;
-				}
-			} else {
-				if (image[(i*4)] >= 0x4) {
-					image[(i*4)] -= 0x4;
-				}
-				if (image[(i*4)+1] >= 0x4) {
-					image[(i*4)+1] -= 0x4;
-				}
-				if (image[(i*4)+2] >= 0x4) {
-					image[(i*4)+2] -= 0x4;
-				}
-			}
-			if (image[(i*4)+3] > 0) {
-				u16 color = image[i*4]>>3 | (image[(i*4)+1]>>3)<<5 | (image[(i*4)+2]>>3)<<10 | BIT(15);
-				if (ms().colorMode == 1) {
-					color = convertVramColorToGrayscale(color);
-				}
-				dsImageBuffer[1][(xPos+x+(y*256))+(yPos*256)] = alphablend(color, 0, image[(i*4)+3]);
-			} else {
-				dsImageBuffer[1][(xPos+x+(y*256))+(yPos*256)] = 0;
-			}
-			x++;
-			if ((unsigned)x == width) {
-				alternatePixel = !alternatePixel;
-				x=0;
-				y++;
-			}
-			alternatePixel = !alternatePixel;
-		}
+		const int offset = (yPos * 256) + xPos;
+		rgbaToBgr555(dsImageBuffer[0] + offset, dsImageBuffer[1] + offset, 256, image.data(), width, height, 4, COLORCONVERT_ALPHA | ((ms().colorMode == 1) ? COLORCONVERT_GRAYSCALE : 0));
 		doubleBuffer = true;
 		return;
 	} else if (imageType == 1) { // BMP
@@ -273,65 +209,9 @@ void imageLoad(const char* filename) {
 			u8 *bmpImageBuffer = new u8[(width * height)*bits];
 			fread(bmpImageBuffer, bits, width * height, file);
 
-			bool alternatePixel = false;
-			int x = 0;
-			int y = height-1;
-			u8 pixelAdjustInfo = 0;
-			for (u32 i = 0; i < width*height; i++) {
-				pixelAdjustInfo = 0;
-				if (alternatePixel) {
-					if (bmpImageBuffer[(i*bits)] >= 0x4) {
-						bmpImageBuffer[(i*bits)] -= 0x4;
-						pixelAdjustInfo |= BIT(0);
-					}
-					if (bmpImageBuffer[(i*bits)+1] >= 0x4) {
-						bmpImageBuffer[(i*bits)+1] -= 0x4;
-						pixelAdjustInfo |= BIT(1);
-					}
-					if (bmpImageBuffer[(i*bits)+2] >= 0x4) {
-						bmpImageBuffer[(i*bits)+2] -= 0x4;
-						pixelAdjustInfo |= BIT(2);
-					}
-				}
-				u16 color = bmpImageBuffer[(i*bits)+2]>>3 | (bmpImageBuffer[(i*bits)+1]>>3)<<5 | (bmpImageBuffer[i*bits]>>3)<<10 | BIT(15);
-				if (ms().colorMode == 1) {
-					color = convertVramColorToGrayscale(color);
-				}
-				dsImageBuffer[0][(xPos+x+(y*256))+(yPos*256)] = color;
-				if (alternatePixel) {
-					if (pixelAdjustInfo & BIT(0)) {
-						bmpImageBuffer[(i*bits)] += 0x4;
-					}
-					if (pixelAdjustInfo & BIT(1)) {
-						bmpImageBuffer[(i*bits)+1] += 0x4;
-					}
-					if (pixelAdjustInfo & BIT(2)) {
-						bmpImageBuffer[(i*bits)+2] += 0x4;
-					}
-				} else {
-					if (bmpImageBuffer[(i*bits)] >= 0x4) {
-						bmpImageBuffer[(i*bits)] -= 0x4;
-					}
-					if (bmpImageBuffer[(i*bits)+1] >= 0x4) {
-						bmpImageBuffer[(i*bits)+1] -= 0x4;
-					}
-					if (bmpImageBuffer[(i*bits)+2] >= 0x4) {
-						bmpImageBuffer[(i*bits)+2] -= 0x4;
-					}
-				}
-				color = bmpImageBuffer[(i*bits)+2]>>3 | (bmpImageBuffer[(i*bits)+1]>>3)<<5 | (bmpImageBuffer[i*bits]>>3)<<10 | BIT(15);
-				if (ms().colorMode == 1) {
-					color = convertVramColorToGrayscale(color);
-				}
-				dsImageBuffer[1][(xPos+x+(y*256))+(yPos*256)] = color;
-				x++;
-				if (x == (int)width) {
-					alternatePixel = !alternatePixel;
-					x=0;
-					y--;
-				}
-				alternatePixel = !alternatePixel;
-			}
+			// Rows are stored bottom to top
+			const int offset = ((yPos + height - 1) * 256) + xPos;
+			rgbaToBgr555(dsImageBuffer[0] + offset, dsImageBuffer[1] + offset, -256, bmpImageBuffer, width, height, bits, COLORCONVERT_SWAP_RB | ((ms().colorMode == 1) ? COLORCONVERT_GRAYSCALE : 0));
 			delete[] bmpImageBuffer;
 			doubleBuffer = true;
 		} else if (bitsPerPixel == 16) { // 16-bit
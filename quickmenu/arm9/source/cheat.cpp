@@ -19,10 +19,15 @@
 */
 
 #include "cheat.h"
+#include "common/cheatIndex.h"
+#include "common/crc32.h"
 #include "common/stringtool.h"
 #include <algorithm>
 
-CheatCodelist::~CheatCodelist(void) {}
+CheatCodelist::~CheatCodelist(void)
+{
+  free(_arena);
+}
 
 inline u32 gamecode(const char *aGameCode)
 {
@@ -31,18 +36,6 @@ inline u32 gamecode(const char *aGameCode)
     return gameCode;
 }
 
-#define CRCPOLY 0xedb88320
-static u32 crc32(const u8* p,size_t len)
-{
-  u32 crc=-1;
-  while (len--)
-  {
-    crc^=*p++;
-    for (int ii=0;ii<8;++ii) crc=(crc>>1)^((crc&1)?CRCPOLY:0);
-  }
-  return crc;
-}
-
 bool CheatCodelist::parse(const std::string& aFileName)
 {
   bool res=false;
@@ -68,28 +61,10 @@ bool CheatCodelist::searchCheatData(FILE* aDat,u32 gamecode,u32 crc32,long& aPos
   fread(header,12,1,aDat);
   if (strncmp(KHeader,header,12)) return false;
 
-  sDatIndex idx,nidx;
-
-  fseek(aDat,0,SEEK_END);
-  long fileSize=ftell(aDat);
-
-  fseek(aDat,0x100,SEEK_SET);
-  fread(&nidx,sizeof(nidx),1,aDat);
-
-  bool done=false;
-
-  while (!done)
-  {
-    memcpy(&idx,&nidx,sizeof(idx));
-    fread(&nidx,sizeof(nidx),1,aDat);
-    if (gamecode==idx._gameCode&&crc32==idx._crc32)
-    {
-      aSize=((nidx._offset)?nidx._offset:fileSize)-idx._offset;
-      aPos=idx._offset;
-      done=true;
-    }
-    if (!nidx._offset) done=true;
-  }
+  u32 offset,size;
+  if (!cheatIndexFind(aDat,gamecode,crc32,offset,size)) return false;
+  aPos=offset;
+  aSize=size;
   return (aPos&&aSize);
 }
 
@@ -98,6 +73,9 @@ bool CheatCodelist::parseInternal(FILE* aDat,u32 gamecode,u32 crc32)
   // dbg_printf("%x, %x\n",gamecode,crc32);
 
   _data.clear();
+  free(_arena);
+  _arena=NULL;
+  _arenaSize=0;
 
   long dataPos; size_t dataSize;
   if (!searchCheatData(aDat,gamecode,crc32,dataPos,dataSize)) return false;
@@ -105,59 +83,96 @@ bool CheatCodelist::parseInternal(FILE* aDat,u32 gamecode,u32 crc32)
 
   // dbg_printf("record found: %d\n",dataSize);
 
-  char* buffer=(char*)malloc(dataSize);
-  if (!buffer) return false;
-  fread(buffer,dataSize,1,aDat);
-  char* gameTitle=buffer;
+  // Kept for as long as the list, with a zeroed word after it to end any name left unterminated
+  _arena=(char*)malloc(dataSize+4);
+  if (!_arena) return false;
+  fread(_arena,dataSize,1,aDat);
+  memset(_arena+dataSize,0,4);
+  _arenaSize=dataSize;
+  _arenaPos=dataPos;
 
-  u32* ccode=(u32*)(((u32)gameTitle+strlen(gameTitle)+4)&~3);
-  u32 cheatCount=*ccode;
+  u32 pos=(strlen(_arena)+4)&~3;
+  u32 cheatCount=word(pos);
   cheatCount&=0x0fffffff;
-  ccode+=9;
+  pos+=9*4;
 
   u32 cc=0;
-  while (cc<cheatCount)
+  while (cc<cheatCount&&pos+4<=_arenaSize)
   {
-    u32 folderCount=1;
-    char* folderName=NULL;
-    char* folderNote=NULL;
-    u32 flagItem=0;
-    if ((*ccode>>28)&1)
+    u32 entry=word(pos);
+    if ((entry>>28)&1)
     {
-      flagItem|=cParsedItem::EInFolder;
-      if ((*ccode>>24)==0x11) flagItem|=cParsedItem::EOne;
-      folderCount=*ccode&0x00ffffff;
-      folderName=(char*)((u32)ccode+4);
-      folderNote=(char*)((u32)folderName+strlen(folderName)+1);
-      _data.push_back(cParsedItem(folderName,folderNote,cParsedItem::EFolder));
-      cc++;
-      ccode=(u32*)(((u32)folderName+strlen(folderName)+1+strlen(folderNote)+1+3)&~3);
+      // Only the folder itself, its cheats are parsed when it's opened
+      u32 folderName=pos+4;
+      u32 folderNote=folderName+strlen(_arena+folderName)+1;
+      _data.push_back(cParsedItem(folderName,folderNote,cParsedItem::EFolder|(((entry>>24)==0x11)?cParsedItem::EOne:0)));
+      _data.back()._cheat=(folderNote+strlen(_arena+folderNote)+1+3)&~3;
+      _data.back()._cheatCount=entry&0x00ffffff;
+      cc+=1+_data.back()._cheatCount;
+      pos=skipCheats(_data.back()._cheat,_data.back()._cheatCount);
     }
-
-    u32 selectValue=cParsedItem::ESelected;
-    for (size_t ii=0;ii<folderCount;++ii)
+    else
     {
-      char* cheatName=(char*)((u32)ccode+4);
-      char* cheatNote=(char*)((u32)cheatName+strlen(cheatName)+1);
-      u32* cheatData=(u32*)(((u32)cheatNote+strlen(cheatNote)+1+3)&~3);
-      u32 cheatDataLen=*cheatData++;
-
-      if (cheatDataLen)
-      {
-        _data.push_back(cParsedItem(cheatName,cheatNote,flagItem|((*ccode&0xff000000)?selectValue:0),dataPos+(((char*)ccode+3)-buffer)));
-        if ((*ccode&0xff000000)&&(flagItem&cParsedItem::EOne)) selectValue=0;
-        _data.back()._cheat.resize(cheatDataLen);
-        memcpy(_data.back()._cheat.data(),cheatData,cheatDataLen*4);
-      }
       cc++;
-      ccode=(u32*)((u32)ccode+(((*ccode&0x00ffffff)+1)*4));
+      pos=parseCheats(pos,1,0,_data);
     }
   }
-  free(buffer);
   generateList();
   return true;
 }
 
+// Add the cheats with code words from aPos to aCheats, and return where they end
+u32 CheatCodelist::parseCheats(u32 aPos,u32 aCount,u32 aFlags,std::vector<cParsedItem>& aCheats)
+{
+  u32 selectValue=cParsedItem::ESelected;
+  for (u32 ii=0;ii<aCount&&aPos+4<=_arenaSize;++ii)
+  {
+    u32 entry=word(aPos);
+    u32 cheatName=aPos+4;
+    u32 cheatNote=cheatName+strlen(_arena+cheatName)+1;
+    u32 cheatData=(cheatNote+strlen(_arena+cheatNote)+1+3)&~3;
+    u32 cheatDataLen=(cheatData+4<=_arenaSize)?word(cheatData):0;
+
+    if (cheatDataLen&&cheatData+4+cheatDataLen*4<=_arenaSize)
+    {
+      aCheats.push_back(cParsedItem(cheatName,cheatNote,aFlags|((entry&0xff000000)?selectValue:0),_arenaPos+aPos+3));
+      aCheats.back()._cheat=cheatData+4;
+      aCheats.back()._cheatCount=cheatDataLen;
+      if ((entry&0xff000000)&&(aFlags&cParsedItem::EOne)) selectValue=0;
+    }
+    aPos+=((entry&0x00ffffff)+1)*4;
+  }
+  return aPos;
+}
+
+u32 CheatCodelist::skipCheats(u32 aPos,u32 aCount)
+{
+  for (u32 ii=0;ii<aCount&&aPos+4<=_arenaSize;++ii)
+    aPos+=((word(aPos)&0x00ffffff)+1)*4;
+  return aPos;
+}
+
+void CheatCodelist::folderCheats(const cParsedItem& aFolder,std::vector<cParsedItem>& aCheats)
+{
+  size_t first=aCheats.size();
+  parseCheats(aFolder._cheat,aFolder._cheatCount,cParsedItem::EInFolder|(aFolder._flags&cParsedItem::EOne),aCheats);
+  if (aFolder._flags&cParsedItem::ECleared)
+  {
+    for (size_t ii=first;ii<aCheats.size();++ii) aCheats[ii]._flags&=~cParsedItem::ESelected;
+  }
+}
+
+void CheatCodelist::openFolder(size_t anIndex)
+{
+  if (_data[anIndex]._flags&cParsedItem::EParsed) return;
+
+  std::vector<cParsedItem> cheats;
+  folderCheats(_data[anIndex],cheats);
+  _data[anIndex]._flags=(_data[anIndex]._flags|cParsedItem::EParsed)&~cParsedItem::ECleared;
+  _data.insert(_data.begin()+anIndex+1,cheats.begin(),cheats.end());
+  generateList();
+}
+
 void CheatCodelist::generateList(void)
 {
   _indexes.clear();
@@ -168,14 +183,14 @@ void CheatCodelist::generateList(void)
   {
     std::vector<std::string> row;
     row.push_back("");
-    row.push_back((*itr)._title);
+    row.push_back(title(*itr));
     // _List.insertRow(_List.getRowCount(),row);
     _indexes.push_back(itr-_data.begin());
     u32 flags=(*itr)._flags;
     ++itr;
     if ((flags&cParsedItem::EFolder)&&(flags&cParsedItem::EOpen)==0)
     {
-      while (((*itr)._flags&cParsedItem::EInFolder)&&itr!=_data.end()) ++itr;
+      while (itr!=_data.end()&&((*itr)._flags&cParsedItem::EInFolder)) ++itr;
     }
   }
 }
@@ -189,7 +204,8 @@ bool CheatCodelist::romData(const std::string& aFileName,u32& aGameCode,u32& aCr
     u8 header[512];
     if (1==fread(header,sizeof(header),1,rom))
     {
-      aCrc32=crc32(header,sizeof(header));
+      // usrcheat.dat keeps the CRC without the final inversion
+      aCrc32=crc32Update(0xFFFFFFFF,header,sizeof(header));
       aGameCode=gamecode((const char*)(header+12));
       res=true;
     }
@@ -198,24 +214,27 @@ bool CheatCodelist::romData(const std::string& aFileName,u32& aGameCode,u32& aCr
   return res;
 }
 
-std::vector<u32> CheatCodelist::getCheats()
-{
-  std::vector<u32> cheats;
-  for (uint i=0;i<_data.size();i++)
-  {
-    if (_data[i]._flags&cParsedItem::ESelected)
-    {
-      cheats.insert(cheats.end(),_data[i]._cheat.begin(),_data[i]._cheat.end());
-    }
-  }
-  return cheats;
-}
-
 void CheatCodelist::writeCheatsToFile(const char *path) {
   FILE *file = fopen(path, "wb");
   if (file) {
-    std::vector<u32> cheats(getCheats());
-    fwrite(cheats.data(),4,cheats.size(),file);
+    // Straight from the arena, with the cheats of folders never opened as usrcheat.dat has them
+    std::vector<cParsedItem> cheats;
+    for (uint i=0;i<_data.size();i++)
+    {
+      if ((_data[i]._flags&cParsedItem::EFolder)&&!(_data[i]._flags&cParsedItem::EParsed))
+      {
+        cheats.clear();
+        folderCheats(_data[i],cheats);
+        for (uint j=0;j<cheats.size();j++)
+        {
+          if (cheats[j]._flags&cParsedItem::ESelected) fwrite(_arena+cheats[j]._cheat,4,cheats[j]._cheatCount,file);
+        }
+      }
+      else if (_data[i]._flags&cParsedItem::ESelected)
+      {
+        fwrite(_arena+_data[i]._cheat,4,_data[i]._cheatCount,file);
+      }
+    }
     fwrite("\0\0\0\xCF",4,1,file);
     fclose(file);
   }
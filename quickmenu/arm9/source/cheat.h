@@ -9,7 +9,7 @@
 class CheatCodelist
 {
 public:
-  CheatCodelist (void)
+  CheatCodelist (void):_arena(NULL),_arenaSize(0),_arenaPos(0)
   {
   }
   
@@ -26,35 +26,44 @@ public:
   bool romData(const std::string& aFileName,u32& aGameCode,u32& aCrc32);
 
   private:
-    struct sDatIndex
-    {
-      u32 _gameCode;
-      u32 _crc32;
-      u64 _offset;
-    };
+    // Names, notes and codes stay in _arena, and are referred to by their offset in it
     class cParsedItem
     {
       public:
-        std::string _title;
-        std::string _comment;
-        std::vector<u32> _cheat;
+        u32 _title;
+        u32 _comment;
+        u32 _cheat;  // The code words, or for a folder, its first cheat
+        u32 _cheatCount;
         u32 _flags;
         u32 _offset;
-        cParsedItem(const std::string& title,const std::string& comment,u32 flags,u32 offset=0):_title(title),_comment(comment),_flags(flags),_offset(offset) {};
+        cParsedItem(u32 title,u32 comment,u32 flags,u32 offset=0):_title(title),_comment(comment),_cheat(0),_cheatCount(0),_flags(flags),_offset(offset) {};
         enum
         {
           EFolder=1,
           EInFolder=2,
           EOne=4,
           ESelected=8,
-          EOpen=16
+          EOpen=16,
+          EParsed=32,  // A folder whose cheats have been added after it
+          ECleared=64  // A folder not yet parsed, whose cheats have all been deselected
         };
     };
   private:
+    char* _arena;  // The game's whole block from usrcheat.dat
+    u32 _arenaSize;
+    u32 _arenaPos;
     std::vector<cParsedItem> _data;
     std::vector<size_t> _indexes;
+
+    u32 word(u32 aPos) const { return *(const u32*)(_arena+aPos); }
+    const char* title(const cParsedItem& anItem) const { return _arena+anItem._title; }
+    const char* comment(const cParsedItem& anItem) const { return _arena+anItem._comment; }
+
+    u32 parseCheats(u32 aPos,u32 aCount,u32 aFlags,std::vector<cParsedItem>& aCheats);
+    u32 skipCheats(u32 aPos,u32 aCount);
+    void folderCheats(const cParsedItem& aFolder,std::vector<cParsedItem>& aCheats);
   public:
-    std::vector<u32> getCheats();
+    void openFolder(size_t anIndex);
     void writeCheatsToFile(const char* path);
 
 private:
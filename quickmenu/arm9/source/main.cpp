@@ -4,6 +4,10 @@
 #include "io_g6_common.h"
 #include "io_sc_common.h"
 #include "exptools.h"
+#include "gbaNorFlash.h"
+#include "gbapatch/romScan.h"
+#include "gbapatch/romStream.h"
+#include "gbapatch/Save.h"
 
 #include <stdio.h>
 #include <fat.h>
@@ -25,6 +29,7 @@
 #include "myDSiMode.h"
 #include "common/bootstrapsettings.h"
 #include "common/fatHeader.h"
+#include "common/fileType.h"
 #include "common/flashcard.h"
 #include "common/inifile.h"
 #include "common/nds_loader_arm9.h"
@@ -45,15 +50,13 @@
 #include "language.h"
 
 #include "cheat.h"
-#include "crc.h"
+#include "common/crc32.h"
 
 #include "soundbank.h"
 #include "soundbank_bin.h"
 
 #include "defaultSettings.h"
-#include "twlClockExcludeMap.h"
-#include "dmaExcludeMap.h"
-#include "asyncReadExcludeMap.h"
+#include "gameRules.h"
 #include "donorMap.h"
 #include "saveMap.h"
 #include "ROMList.h"
@@ -174,13 +177,9 @@ void stop (void) {
  */
 bool setClockSpeed() {
 	if (!ms().ignoreBlacklists) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(twlClockExcludeList)/sizeof(twlClockExcludeList[0]); i++) {
-			if (memcmp(gameTid[ms().secondaryDevice], twlClockExcludeList[i], 3) == 0) {
-				// Found match
-				dsModeForced = true;
-				return false;
-			}
+		if (getGameRules(gameTid[ms().secondaryDevice]) & GAMERULE_NO_TWL_CLOCK) {
+			dsModeForced = true;
+			return false;
 		}
 	}
 
@@ -192,12 +191,8 @@ bool setClockSpeed() {
  */
 bool setCardReadDMA() {
 	if (!ms().ignoreBlacklists) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(cardReadDMAExcludeList)/sizeof(cardReadDMAExcludeList[0]); i++) {
-			if (memcmp(gameTid[ms().secondaryDevice], cardReadDMAExcludeList[i], 3) == 0) {
-				// Found match
-				return false;
-			}
+		if (getGameRules(gameTid[ms().secondaryDevice]) & GAMERULE_NO_CARD_DMA) {
+			return false;
 		}
 	}
 
@@ -209,12 +204,8 @@ bool setCardReadDMA() {
  */
 bool setAsyncCardRead() {
 	if (!ms().ignoreBlacklists) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(asyncReadExcludeList)/sizeof(asyncReadExcludeList[0]); i++) {
-			if (memcmp(gameTid[ms().secondaryDevice], asyncReadExcludeList[i], 3) == 0) {
-				// Found match
-				return false;
-			}
+		if (getGameRules(gameTid[ms().secondaryDevice]) & GAMERULE_NO_ASYNC_READ) {
+			return false;
 		}
 	}
 
@@ -1373,80 +1364,9 @@ int main(int argc, char **argv) {
 		getGameInfo(0, false, filename[0].c_str());
 		iconUpdate (0, false, filename[0].c_str());
 
-		if (extension(filename[0], ".nds") || extension(filename[0], ".dsi") || extension(filename[0], ".ids") || extension(filename[0], ".app") || extension(filename[0], ".srl") || extension(filename[0], ".argv")) {
-			bnrRomType[0] = 0;
-			boxArtType[0] = 0;
-		} else if (extension(filename[0], ".xex") || extension(filename[0], ".atr")
-				 || extension(filename[0], ".a26") || extension(filename[0], ".a52") || extension(filename[0], ".a78")) {
-			bnrRomType[0] = 10;
-			boxArtType[0] = 0;
-		} else if (extension(filename[0], ".col")) {
-			bnrRomType[0] = 13;
-			boxArtType[0] = 0;
-		} else if (extension(filename[0], ".m5")) {
-			bnrRomType[0] = 14;
-			boxArtType[0] = 0;
-		} else if (extension(filename[0], ".int")) {
-			bnrRomType[0] = 12;
-			boxArtType[0] = 0;
-		} else if (extension(filename[0], ".plg")) {
-			bnrRomType[0] = 9;
-			boxArtType[0] = 0;
-		} else if (extension(filename[0], ".avi") || extension(filename[0], ".rvid") || extension(filename[0], ".fv")) {
-			bnrRomType[0] = 19;
-			boxArtType[0] = 2;
-		} else if (extension(filename[0], ".gif") || extension(filename[0], ".bmp") || extension(filename[0], ".png")) {
-			bnrRomType[0] = 20;
-			boxArtType[0] = -1;
-		} else if (extension(filename[0], ".agb") || extension(filename[0], ".gba") || extension(filename[0], ".mb")) {
-			bnrRomType[0] = 1;
-			boxArtType[0] = 1;
-		} else if (extension(filename[0], ".gb") || extension(filename[0], ".sgb")) {
-			bnrRomType[0] = 2;
-			boxArtType[0] = 1;
-		} else if (extension(filename[0], ".gbc")) {
-			bnrRomType[0] = 3;
-			boxArtType[0] = 1;
-		} else if (extension(filename[0], ".nes")) {
-			bnrRomType[0] = 4;
-			boxArtType[0] = 2;
-		} else if (extension(filename[0], ".fds")) {
-			bnrRomType[0] = 4;
-			boxArtType[0] = 1;
-		} else if (extension(filename[0], ".sg")) {
-			bnrRomType[0] = 15;
-			boxArtType[0] = 2;
-		} else if (extension(filename[0], ".sms")) {
-			bnrRomType[0] = 5;
-			boxArtType[0] = 2;
-		} else if (extension(filename[0], ".gg")) {
-			bnrRomType[0] = 6;
-			boxArtType[0] = 2;
-		} else if (extension(filename[0], ".gen")) {
-			bnrRomType[0] = 7;
-			boxArtType[0] = 2;
-		} else if (extension(filename[0], ".smc")) {
-			bnrRomType[0] = 8;
-			boxArtType[0] = 3;
-		} else if (extension(filename[0], ".sfc")) {
-			bnrRomType[0] = 8;
-			boxArtType[0] = 2;
-		} else if (extension(filename[0], ".pce")) {
-			bnrRomType[0] = 11;
-			boxArtType[0] = 0;
-		} else if (extension(filename[0], ".ws") || extension(filename[0], ".wsc")) {
-			bnrRomType[0] = 16;
-			boxArtType[0] = 0;
-		} else if (extension(filename[0], ".ngp") || extension(filename[0], ".ngc")) {
-			bnrRomType[0] = 17;
-			boxArtType[0] = 0;
-		} else if (extension(filename[0], ".dsk")) {
-			bnrRomType[0] = 18;
-			boxArtType[0] = 0;
-		} else {
-			bnrRomType[0] = 9;
-			boxArtType[0] = -1;
-		}
+		const FileType &fileType = fileTypeOf(filename[0].c_str());
+		bnrRomType[0] = fileType.romType;
+		boxArtType[0] = fileType.boxArtType;
 
 		if (ms().showBoxArt) {
 			// Store box art path
@@ -1508,80 +1428,9 @@ int main(int argc, char **argv) {
 		getGameInfo(1, false, filename[1].c_str());
 		iconUpdate (1, false, filename[1].c_str());
 
-		if (extension(filename[1], ".nds") || extension(filename[1], ".dsi") || extension(filename[1], ".ids") || extension(filename[1], ".app") || extension(filename[1], ".srl") || extension(filename[1], ".argv")) {
-			bnrRomType[1] = 0;
-			boxArtType[1] = 0;
-		} else if (extension(filename[1], ".xex") || extension(filename[1], ".atr")
-				 || extension(filename[1], ".a26") || extension(filename[1], ".a52") || extension(filename[1], ".a78")) {
-			bnrRomType[1] = 10;
-			boxArtType[1] = 0;
-		} else if (extension(filename[1], ".col")) {
-			bnrRomType[1] = 13;
-			boxArtType[1] = 0;
-		} else if (extension(filename[1], ".m5")) {
-			bnrRomType[1] = 14;
-			boxArtType[1] = 0;
-		} else if (extension(filename[1], ".int")) {
-			bnrRomType[1] = 12;
-			boxArtType[1] = 0;
-		} else if (extension(filename[1], ".plg")) {
-			bnrRomType[1] = 9;
-			boxArtType[1] = 0;
-		} else if (extension(filename[1], ".avi") || extension(filename[1], ".rvid") || extension(filename[1], ".fv")) {
-			bnrRomType[1] = 19;
-			boxArtType[1] = 2;
-		} else if (extension(filename[1], ".gif") || extension(filename[1], ".bmp") || extension(filename[1], ".png")) {
-			bnrRomType[1] = 20;
-			boxArtType[1] = -1;
-		} else if (extension(filename[1], ".agb") || extension(filename[1], ".gba") || extension(filename[1], ".mb")) {
-			bnrRomType[1] = 1;
-			boxArtType[1] = 1;
-		} else if (extension(filename[1], ".gb") || extension(filename[1], ".sgb")) {
-			bnrRomType[1] = 2;
-			boxArtType[1] = 1;
-		} else if (extension(filename[1], ".gbc")) {
-			bnrRomType[1] = 3;
-			boxArtType[1] = 1;
-		} else if (extension(filename[1], ".nes")) {
-			bnrRomType[1] = 4;
-			boxArtType[1] = 2;
-		} else if (extension(filename[1], ".fds")) {
-			bnrRomType[1] = 4;
-			boxArtType[1] = 1;
-		} else if (extension(filename[1], ".sg")) {
-			bnrRomType[1] = 15;
-			boxArtType[1] = 2;
-		} else if (extension(filename[1], ".sms")) {
-			bnrRomType[1] = 5;
-			boxArtType[1] = 2;
-		} else if (extension(filename[1], ".gg")) {
-			bnrRomType[1] = 6;
-			boxArtType[1] = 2;
-		} else if (extension(filename[1], ".gen")) {
-			bnrRomType[1] = 7;
-			boxArtType[1] = 2;
-		} else if (extension(filename[1], ".smc")) {
-			bnrRomType[1] = 8;
-			boxArtType[1] = 3;
-		} else if (extension(filename[1], ".sfc")) {
-			bnrRomType[1] = 8;
-			boxArtType[1] = 2;
-		} else if (extension(filename[1], ".pce")) {
-			bnrRomType[1] = 11;
-			boxArtType[1] = 0;
-		} else if (extension(filename[1], ".ws") || extension(filename[1], ".wsc")) {
-			bnrRomType[1] = 16;
-			boxArtType[1] = 0;
-		} else if (extension(filename[1], ".ngp") || extension(filename[1], ".ngc")) {
-			bnrRomType[1] = 17;
-			boxArtType[1] = 0;
-		} else if (extension(filename[1], ".dsk")) {
-			bnrRomType[1] = 18;
-			boxArtType[1] = 0;
-		} else {
-			bnrRomType[1] = 9;
-			boxArtType[1] = -1;
-		}
+		const FileType &fileType = fileTypeOf(filename[1].c_str());
+		bnrRomType[1] = fileType.romType;
+		boxArtType[1] = fileType.boxArtType;
 
 		if (ms().showBoxArt) {
 			// Store box art path
@@ -2538,13 +2387,8 @@ int main(int argc, char **argv) {
 							u32 gameTidHex = 0;
 							tonccpy(&gameTidHex, &gameTid[ms().secondaryDevice], 4);
 
-							for (int i = 0; i < (int)sizeof(ROMList)/12; i++) {
-								ROMListEntry* curentry = &ROMList[i];
-								if (gameTidHex == curentry->GameCode) {
-									if (curentry->SaveMemType != 0xFFFFFFFF) savesize = sramlen[curentry->SaveMemType];
-									break;
-								}
-							}
+							int saveMemType = lookupSaveInfo(gameTidHex);
+							if (saveMemType != -1) savesize = sramlen[saveMemType];
 
 							if ((orgsavesize == 0 && savesize > 0) || (orgsavesize < savesize)) {
 								while (!screenFadedOut()) {
@@ -2940,7 +2784,6 @@ int main(int argc, char **argv) {
 						if (strncmp(titleID, "AGBJ", 4) == 0 && romSize <= 0x40000) {
 							ptr += 0x400;
 						}
-						u32 curPtr = ptr;
 						fseek(gbaFile, 0, SEEK_SET);
 
 						extern char copyBuf[0x8000];
@@ -2950,13 +2793,6 @@ int main(int argc, char **argv) {
 						if (*(u16*)(0x020000C0) == 0x5A45 && strncmp(titleID, "AGBJ", 4) != 0) {
 							cExpansion::SetRompage(0);
 							expansion().SetRampage(cExpansion::ENorPage);
-							cExpansion::OpenNorWrite();
-							cExpansion::SetSerialMode();
-							for (u32 address=0;address<romSize&&address<0x2000000;address+=0x40000) {
-								expansion().Block_Erase(address);
-								progressBarLength = (address+0x40000)/(romSize/192);
-								if (progressBarLength > 192) progressBarLength = 192;
-							}
 							nor = true;
 						} else if (*(u16*)(0x020000C0) == 0x4353 && romSize > 0x1FFFFFE) {
 							romSize = 0x1FFFFFE;
@@ -2965,21 +2801,20 @@ int main(int argc, char **argv) {
 						clearText();
 						printSmall(false, 0, 88, STR_NOW_LOADING, Alignment::center);
 
-						for (u32 len = romSize; len > 0; len -= 0x8000) {
-							if (fread(&copyBuf, 1, (len>0x8000 ? 0x8000 : len), gbaFile) > 0) {
-								s2RamAccess(true);
-								if (nor) {
-									expansion().WriteNorFlash(curPtr-ptr, (u8*)copyBuf, (len>0x8000 ? 0x8000 : len));
-								} else {
-									tonccpy((u16*)curPtr, &copyBuf, (len>0x8000 ? 0x8000 : len));
-								}
-								s2RamAccess(false);
-								curPtr += 0x8000;
-								progressBarLength = ((curPtr-ptr)+0x8000)/(romSize/192);
+						if (nor) {
+							// Only writes what isn't already in the NOR
+							gbaNorFlash(gbaFile, filename[ms().secondaryDevice].c_str(), romSize, (u8*)copyBuf, [](u32 done, u32 total) {
+								progressBarLength = done/(total/192);
 								if (progressBarLength > 192) progressBarLength = 192;
-							} else {
-								break;
-							}
+							});
+						} else {
+							// Scanned and patched as it's loaded, so gbapatcher needn't read it all back
+							save_addScanPatterns();
+							romStream_load(gbaFile, ptr, romSize, strncmp(titleID, "MB2G", 4) != 0, (u8*)copyBuf, [](u32 done, u32 total) {
+								progressBarLength = done/(total/192);
+								if (progressBarLength > 192) progressBarLength = 192;
+							});
+							romScan_save(filename[ms().secondaryDevice].c_str());
 						}
 						fclose(gbaFile);
 
@@ -58,13 +58,9 @@ BootstrapConfig &BootstrapConfig::saveSize()
 	u32 gameTidHex = 0;
 	tonccpy(&gameTidHex, &_gametid, 4);
 
-	for (int i = 0; i < (int)sizeof(ROMList)/12; i++) {
-		ROMListEntry* curentry = &ROMList[i];
-		if (gameTidHex == curentry->GameCode) {
-			if (curentry->SaveMemType == 0xFFFFFFFF) break;
-			return saveSize(sramlen[curentry->SaveMemType]);
-		}
-	}
+	int saveMemType = lookupSaveInfo(gameTidHex);
+	if (saveMemType != -1)
+		return saveSize(sramlen[saveMemType]);
 
 	return saveSize(0x80000);
 }
@@ -26,8 +26,6 @@
 #define DSIMENUPP_SETTINGS_SRL "/_nds/TWiLightMenu/settings.srldr"
 #define TWLMENUPP_MANUAL_SRL "/_nds/TWiLightMenu/manual.srldr"
 
-#define PERGAMESETTINGS_PATH "%s/_nds/TWiLightMenu/gamesettings/%s.ini"
-
 #define SLOT1_SRL "/_nds/TWiLightMenu/slot1launch.srldr"
 #define BOOTPLG_SRL "fat:/_nds/TWiLightMenu/bootplg.srldr"
 
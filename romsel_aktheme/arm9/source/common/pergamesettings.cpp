@@ -1,6 +1,6 @@
 #include "pergamesettings.h"
 #include "dsimenusettings.h"
-#include "common/inifile.h"
+#include "gamesettings/gameSettingsDb.h"
 #include "tool/stringtool.h"
 #include "tool/dbgtool.h"
 #include "bootstrappaths.h"
@@ -12,7 +12,8 @@ extern bool sdFound(void);
 
 PerGameSettings::PerGameSettings(const std::string &romFileName)
 {
-    _iniPath = formatString(PERGAMESETTINGS_PATH, (ms().secondaryDevice ? "fat:" : "sd:"), romFileName.c_str());
+    _drive = (ms().secondaryDevice ? "fat:" : "sd:");
+    _romFileName = romFileName;
     language = ELangDefault;
 	saveNo = 0;
 	ramDiskNo = -1;
@@ -28,58 +29,58 @@ PerGameSettings::PerGameSettings(const std::string &romFileName)
 
 void PerGameSettings::loadSettings()
 {
-    CIniFile pergameini(_iniPath);
-    dbg_printf("CINI LOAD %s", _iniPath.c_str());
-    directBoot = (TDefaultBool)pergameini.GetInt("GAMESETTINGS", "DIRECT_BOOT", ms().secondaryDevice);	// Homebrew only
-    dsiMode = (TDefaultBool)pergameini.GetInt("GAMESETTINGS", "DSI_MODE", dsiMode);
-	language = (TLanguage)pergameini.GetInt("GAMESETTINGS", "LANGUAGE", language);
-	saveNo = pergameini.GetInt("GAMESETTINGS", "SAVE_NUMBER", 0);
-	ramDiskNo = pergameini.GetInt("GAMESETTINGS", "RAM_DISK", -1);
-	boostCpu = (TDefaultBool)pergameini.GetInt("GAMESETTINGS", "BOOST_CPU", boostCpu);
-	boostVram = (TDefaultBool)pergameini.GetInt("GAMESETTINGS", "BOOST_VRAM", boostVram);
-    heapShrink = (TDefaultBool)pergameini.GetInt("GAMESETTINGS", "HEAP_SHRINK", heapShrink);
-    bootstrapFile = (TDefaultBool)pergameini.GetInt("GAMESETTINGS", "BOOTSTRAP_FILE", bootstrapFile);
-    wideScreen = (TDefaultBool)pergameini.GetInt("GAMESETTINGS", "WIDESCREEN", wideScreen);
+    GameSettings pergameini(_drive, _romFileName);
+    dbg_printf("GAMESETTINGS LOAD %s", _romFileName.c_str());
+    directBoot = (TDefaultBool)pergameini.GetInt(GAMESETTINGS_DIRECT_BOOT, ms().secondaryDevice);	// Homebrew only
+    dsiMode = (TDefaultBool)pergameini.GetInt(GAMESETTINGS_DSI_MODE, dsiMode);
+	language = (TLanguage)pergameini.GetInt(GAMESETTINGS_LANGUAGE, language);
+	saveNo = pergameini.GetInt(GAMESETTINGS_SAVE_NUMBER, 0);
+	ramDiskNo = pergameini.GetInt(GAMESETTINGS_RAM_DISK, -1);
+	boostCpu = (TDefaultBool)pergameini.GetInt(GAMESETTINGS_BOOST_CPU, boostCpu);
+	boostVram = (TDefaultBool)pergameini.GetInt(GAMESETTINGS_BOOST_VRAM, boostVram);
+    heapShrink = (TDefaultBool)pergameini.GetInt(GAMESETTINGS_HEAP_SHRINK, heapShrink);
+    bootstrapFile = (TDefaultBool)pergameini.GetInt(GAMESETTINGS_BOOTSTRAP_FILE, bootstrapFile);
+    wideScreen = (TDefaultBool)pergameini.GetInt(GAMESETTINGS_WIDESCREEN, wideScreen);
 }
 
 void PerGameSettings::saveSettings()
 {
-    CIniFile pergameini(_iniPath);
-    pergameini.SetInt("GAMESETTINGS", "DIRECT_BOOT", directBoot);	// Homebrew only
+    GameSettings pergameini(_drive, _romFileName);
+    pergameini.SetInt(GAMESETTINGS_DIRECT_BOOT, directBoot);	// Homebrew only
     if (ms().useBootstrap || !ms().secondaryDevice) {
-		pergameini.SetInt("GAMESETTINGS", "LANGUAGE", language);
-		pergameini.SetInt("GAMESETTINGS", "SAVE_NUMBER", saveNo);
+		pergameini.SetInt(GAMESETTINGS_LANGUAGE, language);
+		pergameini.SetInt(GAMESETTINGS_SAVE_NUMBER, saveNo);
 	}
-	if (!ms().secondaryDevice) pergameini.SetInt("GAMESETTINGS", "RAM_DISK", ramDiskNo);
+	if (!ms().secondaryDevice) pergameini.SetInt(GAMESETTINGS_RAM_DISK, ramDiskNo);
 	if ((isDSiMode() && ms().useBootstrap) || !ms().secondaryDevice) {
-		pergameini.SetInt("GAMESETTINGS", "DSI_MODE", dsiMode);
+		pergameini.SetInt(GAMESETTINGS_DSI_MODE, dsiMode);
 	}
 	if (REG_SCFG_EXT != 0) {
-		pergameini.SetInt("GAMESETTINGS", "BOOST_CPU", boostCpu);
-		pergameini.SetInt("GAMESETTINGS", "BOOST_VRAM", boostVram);
+		pergameini.SetInt(GAMESETTINGS_BOOST_CPU, boostCpu);
+		pergameini.SetInt(GAMESETTINGS_BOOST_VRAM, boostVram);
 	}
     if (ms().useBootstrap || !ms().secondaryDevice) {
-		pergameini.SetInt("GAMESETTINGS", "HEAP_SHRINK", heapShrink);
-		pergameini.SetInt("GAMESETTINGS", "BOOTSTRAP_FILE", bootstrapFile);
+		pergameini.SetInt(GAMESETTINGS_HEAP_SHRINK, heapShrink);
+		pergameini.SetInt(GAMESETTINGS_BOOTSTRAP_FILE, bootstrapFile);
 	}
 	if (isDSiMode() && ms().consoleModel >= 2 && sdFound()) {
-		pergameini.SetInt("GAMESETTINGS", "WIDESCREEN", wideScreen);
+		pergameini.SetInt(GAMESETTINGS_WIDESCREEN, wideScreen);
 	}
-    pergameini.SaveIniFile(_iniPath);
+    pergameini.Save();
 }
 
 bool PerGameSettings::checkIfShowAPMsg() {
-    CIniFile pergameini(_iniPath);
-	if (pergameini.GetInt("GAMESETTINGS", "NO_SHOW_AP_MSG", 0) == 0) {
+    GameSettings pergameini(_drive, _romFileName);
+	if (pergameini.GetInt(GAMESETTINGS_NO_SHOW_AP_MSG, 0) == 0) {
 		return true;	// Show AP message
 	}
 	return false;	// Don't show AP message
 }
 
 void PerGameSettings::dontShowAPMsgAgain() {
-    CIniFile pergameini(_iniPath);
-	pergameini.SetInt("GAMESETTINGS", "NO_SHOW_AP_MSG", 1);
-	pergameini.SaveIniFile(_iniPath);
+    GameSettings pergameini(_drive, _romFileName);
+	pergameini.SetInt(GAMESETTINGS_NO_SHOW_AP_MSG, 1);
+	pergameini.Save();
 }
 
 std::string getSavExtension(int number) {
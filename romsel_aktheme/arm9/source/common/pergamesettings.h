@@ -50,7 +50,8 @@ class PerGameSettings
     TDefaultBool wideScreen;
 
   private:
-    std::string _iniPath;
+    const char *_drive;
+    std::string _romFileName;
 };
 
 #endif
\ No newline at end of file
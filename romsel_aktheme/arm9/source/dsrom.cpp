@@ -29,6 +29,7 @@
 #include "common/module_params.h"
 #include "common/ndsheader.h"
 #include "common/dsargv.h"
+#include "rominfo/romInfoCache.h"
 
 #include "nds_banner_bin.h"
 #include "unknown_nds_banner_bin.h"
@@ -39,7 +40,48 @@
 #include "common/tonccpy.h"
 #include <memory>
 
-static u32 arm9Sig[3][4];
+// Bump the low half when CachedDSRomInfo changes, so older caches are
+// thrown away. "AK" keeps this theme's layout apart from the DSi theme's.
+#define ROMINFO_CACHE_VERSION 0x414B0001
+
+// The header fields and signatures loadDSRomInfo() looks at, as kept in the ROM info cache
+struct CachedDSRomInfo {
+	char gameTitle[12];
+	char gameCode[4];
+	char makercode[2];
+	u8 unitCode;
+	u8 romversion;
+	u16 headerCRC16;
+	u16 hasBanner;
+	u32 arm9destination;
+	u32 arm9binarySize;
+	u32 arm7destination;
+	u32 arm7executeAddress;
+	u32 arm7binarySize;
+	u32 arm9iromOffset;
+	u32 arm7iromOffset;
+	u32 pubSavSize;
+	u32 prvSavSize;
+	u32 dsi_tid;
+	u32 dsi_tid2;
+	u32 sdkVersion;
+	u32 startSig[4];
+	u32 twlSig[3][4];
+};
+
+static u32 bannerSizeForVersion(u16 version)
+{
+	switch (version) {
+		case NDS_BANNER_VER_ZH:
+			return NDS_BANNER_SIZE_ZH;
+		case NDS_BANNER_VER_ZH_KO:
+			return NDS_BANNER_SIZE_ZH_KO;
+		case NDS_BANNER_VER_DSi:
+			return NDS_BANNER_SIZE_DSi;
+		default:
+			return NDS_BANNER_SIZE_ORIGINAL;
+	}
+}
 
 DSRomInfo &DSRomInfo::operator=(const DSRomInfo &src)
 {
@@ -93,183 +135,285 @@ DSRomInfo::DSRomInfo(const DSRomInfo &src)
 	_requiresDonorRom = src._requiresDonorRom;
 }
 
+/**
+ * Matches the homebrew checks in loadDSRomInfo(), for deciding what else
+ * to read from the ROM.
+ */
+static bool isHomebrewRom(const CachedDSRomInfo &info)
+{
+	return (info.startSig[0] == 0xE3A00301
+	 && info.startSig[1] == 0xE5800208
+	 && info.startSig[2] == 0xE3A00013
+	 && info.startSig[3] == 0xE129F000)
+	 || memcmp(info.gameTitle, "NDS.TinyFB", 10) == 0
+	 || memcmp(info.gameTitle, "UNLAUNCH.DSI", 12) == 0
+	 || memcmp(info.gameTitle, "NMP4BOOT", 8) == 0
+	 || (info.arm7destination >= 0x037F0000 && info.arm7executeAddress >= 0x037F0000);
+}
+
+/**
+ * Read the header fields, signatures and banner loadDSRomInfo() needs from a ROM.
+ * @param bannerSize Set to the size of the banner that was read, or 0.
+ * @return false if the ROM's header could not be read.
+ */
+static bool readDSRomInfo(FILE *f, CachedDSRomInfo &info, sNDSBannerExt &banner, u32 &bannerSize)
+{
+	static sNDSHeaderExt header;
+	bannerSize = 0;
+
+	if (fread(&header, sizeof(header), 1, f) != 1) {
+		fseek(f, 0, SEEK_SET);
+		if (fread(&header, 0x160, 1, f) != 1) {
+			return false;
+		}
+	}
+
+	toncset(&info, 0, sizeof(info));
+	tonccpy(info.gameTitle, header.gameTitle, sizeof(info.gameTitle));
+	tonccpy(info.gameCode, header.gameCode, sizeof(info.gameCode));
+	tonccpy(info.makercode, header.makercode, sizeof(info.makercode));
+	info.unitCode = header.unitCode;
+	info.romversion = header.romversion;
+	info.headerCRC16 = header.headerCRC16;
+	info.hasBanner = (header.bannerOffset != 0);
+	info.arm9destination = header.arm9destination;
+	info.arm9binarySize = header.arm9binarySize;
+	info.arm7destination = header.arm7destination;
+	info.arm7executeAddress = header.arm7executeAddress;
+	info.arm7binarySize = header.arm7binarySize;
+	info.arm9iromOffset = header.arm9iromOffset;
+	info.arm7iromOffset = header.arm7iromOffset;
+	info.pubSavSize = header.pubSavSize;
+	info.prvSavSize = header.prvSavSize;
+	info.dsi_tid = header.dsi_tid;
+	info.dsi_tid2 = header.dsi_tid2;
+
+	fseek(f, (header.arm9romOffset <= 0x200 ? header.arm9romOffset : header.arm9romOffset+0x800), SEEK_SET);
+	fread(info.startSig, sizeof(u32), 4, f);
+	if (header.arm9romOffset <= 0x200 && info.startSig[0] == 0 && info.startSig[1] == 0 && info.startSig[2] == 0 && info.startSig[3] == 0)
+	{
+		fseek(f, header.arm9romOffset+0x800, SEEK_SET);
+		fread(info.startSig, sizeof(u32), 4, f);
+	}
+
+	const bool homebrew = isHomebrewRom(info);
+	if (!homebrew && header.unitCode != 0)
+	{
+		fseek(f, 0x8000, SEEK_SET);
+		fread(info.twlSig[0], sizeof(u32), 4, f);
+		fseek(f, header.arm9iromOffset, SEEK_SET);
+		fread(info.twlSig[1], sizeof(u32), 4, f);
+		fseek(f, header.arm7iromOffset, SEEK_SET);
+		fread(info.twlSig[2], sizeof(u32), 4, f);
+	}
+
+	if (!homebrew)
+	{
+		module_params_t *moduleParams = getModuleParams(&header, f);
+		info.sdkVersion = moduleParams ? moduleParams->sdk_version : 0;
+	}
+
+	if (header.bannerOffset != 0)
+	{
+		// If we get a full size banner, then continue as so, setting bannerSize appropriately.
+		// Otherwise, if we read an invalid amount of bytes, read a DS size header.
+		if (fseek(f, header.bannerOffset, SEEK_SET) == 0 && fread(&banner, 1, sizeof(banner), f) == sizeof(banner))
+		{
+			bannerSize = sizeof(banner);
+		}
+		else if (fseek(f, header.bannerOffset, SEEK_SET) == 0 && fread(&banner, 1, NDS_BANNER_SIZE_ORIGINAL, f) == NDS_BANNER_SIZE_ORIGINAL)
+		{
+			bannerSize = NDS_BANNER_SIZE_ORIGINAL;
+		}
+
+		// Anything past the banner's own version is not part of it
+		if (bannerSize > bannerSizeForVersion(banner.version))
+			bannerSize = bannerSizeForVersion(banner.version);
+	}
+
+	return true;
+}
+
+void DSRomInfo::readCachedInfo(const char *const *filenames, int count)
+{
+	if (count == 0)
+		return;
+
+	// The directory loadDSRomInfo() opens the cache for
+	const std::string filename(filenames[0]);
+	size_t lastSlashPos = filename.find_last_of('/');
+	if (filename.npos == lastSlashPos)
+		return;
+	romInfoCache().openDir(filename.substr(0, lastSlashPos).c_str(), ROMINFO_CACHE_VERSION);
+	romInfoCache().readPage(filenames, count);
+}
+
 bool DSRomInfo::loadDSRomInfo(const std::string &filename, bool loadBanner)
 {
 	_isDSRom = EFalse;
 	_isHomebrew = EFalse;
-	FILE *f = fopen(filename.c_str(), "rb");
-	if (NULL == f) {
-		return false;
-	}
 
-	sNDSHeaderExt header;
-	if (fread(&header, sizeof(header), 1, f) != 1) {
-		if (fread(&header, 0x160, 1, f) != 1) {
+	static CachedDSRomInfo info;
+	static sNDSBannerExt banner;
+	u32 bannerSize = 0;
+
+	size_t lastSlashPos = filename.find_last_of('/');
+	if (filename.npos != lastSlashPos)
+		romInfoCache().openDir(filename.substr(0, lastSlashPos).c_str(), ROMINFO_CACHE_VERSION);
+	else
+		romInfoCache().closeDir();
+
+	if (!romInfoCache().get(filename.c_str(), &info, sizeof(info), &banner, sizeof(banner), &bannerSize)) {
+		FILE *f = fopen(filename.c_str(), "rb");
+		if (NULL == f) {
+			return false;
+		}
+		const bool read = readDSRomInfo(f, info, banner, bannerSize);
+		fclose(f);
+
+		if (!read) {
 			dbg_printf("read rom header fail\n");
 			_banner.crc = ((tNDSBanner*)unknown_nds_banner_bin)->crc;
 			tonccpy(_banner.icon,((tNDSBanner*)unknown_nds_banner_bin)->icon, sizeof(_banner.icon));
 			tonccpy(_banner.palette,((tNDSBanner*)unknown_nds_banner_bin)->palette, sizeof(_banner.palette));
 			tonccpy(_banner.title, ((tNDSBanner*)unknown_nds_banner_bin)->titles[setTitleLanguage], sizeof(_banner.title));
-			fclose(f);
 			return false;
 		}
+		romInfoCache().put(filename.c_str(), &info, sizeof(info), &banner, bannerSize);
 	}
+	toncset((u8 *)&banner + bannerSize, 0, sizeof(banner) - bannerSize);
 
 	///////// ROM Header /////////
-	u16 crc = header.headerCRC16;
-	if (crc != header.headerCRC16) {
-		dbg_printf("%s rom header crc error\n", filename.c_str());
-		
-		_banner.crc = ((tNDSBanner*)unknown_nds_banner_bin)->crc;
-		tonccpy(_banner.icon,((tNDSBanner*)unknown_nds_banner_bin)->icon, sizeof(_banner.icon));
-		tonccpy(_banner.palette,((tNDSBanner*)unknown_nds_banner_bin)->palette, sizeof(_banner.palette));
-		tonccpy(_banner.title, ((tNDSBanner*)unknown_nds_banner_bin)->titles[setTitleLanguage], sizeof(_banner.title));		fclose(f);
-		return true;
-	} else {
-		_isDSRom = ETrue;
-		_isDSiWare = EFalse;
-		_hasExtendedBinaries = ETrue;
-		_requiresDonorRom = 0;
-		bool usingFlashcard = (!isDSiMode() && ms().secondaryDevice);
-		bool hasCycloDSi = (memcmp(io_dldi_data->friendlyName, "CycloDS iEvolution", 18) == 0);
-		switch (header.arm7binarySize) {
-			case 0x22B40:
-			case 0x22BCC:
-				if (usingFlashcard || hasCycloDSi) _requiresDonorRom = 51;
-				break;
-			case 0x23708:
-			case 0x2378C:
-			case 0x237F0:
-				if (usingFlashcard || hasCycloDSi) _requiresDonorRom = 5;
-				break;
-			case 0x23CAC:
-				if (usingFlashcard || hasCycloDSi) _requiresDonorRom = 20;
-				break;
-			case 0x24DA8:
-			case 0x24F50:
-				_requiresDonorRom = 2;
-				break;
-			case 0x2434C:
-			case 0x2484C:
-			case 0x249DC:
-			case 0x25D04:
-			case 0x25D94:
-			case 0x25FFC:
-				if (usingFlashcard || hasCycloDSi) _requiresDonorRom = 3;
-				break;
-			case 0x27618:
-			case 0x2762C:
-			case 0x29CEC:
-				_requiresDonorRom = 5;
-				break;
-			default:
-				break;
-		}
+	_isDSRom = ETrue;
+	_isDSiWare = EFalse;
+	_hasExtendedBinaries = ETrue;
+	_requiresDonorRom = 0;
+	bool usingFlashcard = (!isDSiMode() && ms().secondaryDevice);
+	bool hasCycloDSi = (memcmp(io_dldi_data->friendlyName, "CycloDS iEvolution", 18) == 0);
+	switch (info.arm7binarySize) {
+		case 0x22B40:
+		case 0x22BCC:
+			if (usingFlashcard || hasCycloDSi) _requiresDonorRom = 51;
+			break;
+		case 0x23708:
+		case 0x2378C:
+		case 0x237F0:
+			if (usingFlashcard || hasCycloDSi) _requiresDonorRom = 5;
+			break;
+		case 0x23CAC:
+			if (usingFlashcard || hasCycloDSi) _requiresDonorRom = 20;
+			break;
+		case 0x24DA8:
+		case 0x24F50:
+			_requiresDonorRom = 2;
+			break;
+		case 0x2434C:
+		case 0x2484C:
+		case 0x249DC:
+		case 0x25D04:
+		case 0x25D94:
+		case 0x25FFC:
+			if (usingFlashcard || hasCycloDSi) _requiresDonorRom = 3;
+			break;
+		case 0x27618:
+		case 0x2762C:
+		case 0x29CEC:
+			_requiresDonorRom = 5;
+			break;
+		default:
+			break;
+	}
 
-		fseek(f, (header.arm9romOffset <= 0x200 ? header.arm9romOffset : header.arm9romOffset+0x800), SEEK_SET);
-		fread(arm9Sig[0], sizeof(u32), 4, f);
-		if (header.arm9romOffset <= 0x200 && arm9Sig[0] == 0 && arm9Sig[1] == 0 && arm9Sig[2] == 0 && arm9Sig[3] == 0)
-		{
-			fseek(f, header.arm9romOffset+0x800, SEEK_SET);
-			fread(arm9Sig[0], sizeof(u32), 4, f);
-		}
-		if (arm9Sig[0][0] == 0xE3A00301
-		 && arm9Sig[0][1] == 0xE5800208
-		 && arm9Sig[0][2] == 0xE3A00013
-		 && arm9Sig[0][3] == 0xE129F000)
+	if (info.startSig[0] == 0xE3A00301
+	 && info.startSig[1] == 0xE5800208
+	 && info.startSig[2] == 0xE3A00013
+	 && info.startSig[3] == 0xE129F000)
+	{
+		_isDSiWare = ETrue;
+		_isHomebrew = ETrue;
+		if (info.arm7destination >= 0x037F0000 && info.arm7executeAddress >= 0x037F0000)
 		{
-			_isDSiWare = ETrue;
-			_isHomebrew = ETrue;
-			if ((u32)header.arm7destination >= 0x037F0000 && (u32)header.arm7executeAddress >= 0x037F0000)
+			if ((info.arm9binarySize == 0xC9F68 && info.arm7binarySize == 0x12814)	// Colors! v1.1
+			|| (info.arm9binarySize == 0x1B0864 && info.arm7binarySize == 0xDB50)	// Mario Paint Composer DS v2 (Bullet Bill)
+			|| (info.arm9binarySize == 0xD45C0 && info.arm7binarySize == 0x2B7C)	// ikuReader v0.058
+			|| (info.arm9binarySize == 0x7A124 && info.arm7binarySize == 0xEED0)	// PPSEDS r11
+			|| (info.arm9binarySize == 0x54620 && info.arm7binarySize == 0x1538)	// XRoar 0.24fp3
+			|| (info.arm9binarySize == 0x2C9A8 && info.arm7binarySize == 0xFB98)	// NitroGrafx v0.7
+			|| (info.arm9binarySize == 0x22AE4 && info.arm7binarySize == 0xA764))	// It's 1975 and this man is about to show you the future
 			{
-				if ((header.arm9binarySize == 0xC9F68 && header.arm7binarySize == 0x12814)	// Colors! v1.1
-				|| (header.arm9binarySize == 0x1B0864 && header.arm7binarySize == 0xDB50)	// Mario Paint Composer DS v2 (Bullet Bill)
-				|| (header.arm9binarySize == 0xD45C0 && header.arm7binarySize == 0x2B7C)	// ikuReader v0.058
-				|| (header.arm9binarySize == 0x7A124 && header.arm7binarySize == 0xEED0)	// PPSEDS r11
-				|| (header.arm9binarySize == 0x54620 && header.arm7binarySize == 0x1538)	// XRoar 0.24fp3
-				|| (header.arm9binarySize == 0x2C9A8 && header.arm7binarySize == 0xFB98)	// NitroGrafx v0.7
-				|| (header.arm9binarySize == 0x22AE4 && header.arm7binarySize == 0xA764))	// It's 1975 and this man is about to show you the future
-				{
-					_isDSiWare = EFalse; // Have nds-bootstrap load it
-				}
+				_isDSiWare = EFalse; // Have nds-bootstrap load it
 			}
 		}
-		else if ((memcmp(header.gameTitle, "NDS.TinyFB", 10) == 0)
-			   || (memcmp(header.gameTitle, "UNLAUNCH.DSI", 12) == 0))
-		{
-			_isDSiWare = ETrue;
-			_isHomebrew = ETrue;
-		}
-		else if ((memcmp(header.gameTitle, "NMP4BOOT", 8) == 0)
-		 || ((u32)header.arm7destination >= 0x037F0000 && (u32)header.arm7executeAddress >= 0x037F0000))
-		{
-			_isHomebrew = ETrue;
-		}
-		else if ((header.gameCode[0] == 0x48 && header.makercode[0] != 0 && header.makercode[1] != 0)
-		 || (header.gameCode[0] == 0x4B && header.makercode[0] != 0 && header.makercode[1] != 0)
-		 || (header.gameCode[0] == 0x5A && header.makercode[0] != 0 && header.makercode[1] != 0)
-		 || (header.gameCode[0] == 0x42 && header.gameCode[1] == 0x38 && header.gameCode[2] == 0x38))
-		{ if (header.unitCode != 0)
-		  {
-			dbg_printf("DSIWAREFOUND Is DSiWare!\n");
-			_isDSiWare = ETrue;
-
-			_saveInfo.dsiPrvSavSize = header.prvSavSize;
-			_saveInfo.dsiPubSavSize = header.pubSavSize;
-			_saveInfo.dsiTid[0] = header.dsi_tid;
-			_saveInfo.dsiTid[1] = header.dsi_tid2;
-		  }
-		}
-		if ((memcmp(header.gameCode, "KPP", 3) == 0
-		  || memcmp(header.gameCode, "KPF", 3) == 0)
-		&& (!isDSiMode() || ms().dsiWareBooter || ms().consoleModel > 0)) {
-			_isDSiWare = EFalse;
-		}
+	}
+	else if ((memcmp(info.gameTitle, "NDS.TinyFB", 10) == 0)
+		   || (memcmp(info.gameTitle, "UNLAUNCH.DSI", 12) == 0))
+	{
+		_isDSiWare = ETrue;
+		_isHomebrew = ETrue;
+	}
+	else if ((memcmp(info.gameTitle, "NMP4BOOT", 8) == 0)
+	 || (info.arm7destination >= 0x037F0000 && info.arm7executeAddress >= 0x037F0000))
+	{
+		_isHomebrew = ETrue;
+	}
+	else if ((info.gameCode[0] == 0x48 && info.makercode[0] != 0 && info.makercode[1] != 0)
+	 || (info.gameCode[0] == 0x4B && info.makercode[0] != 0 && info.makercode[1] != 0)
+	 || (info.gameCode[0] == 0x5A && info.makercode[0] != 0 && info.makercode[1] != 0)
+	 || (info.gameCode[0] == 0x42 && info.gameCode[1] == 0x38 && info.gameCode[2] == 0x38))
+	{ if (info.unitCode != 0)
+	  {
+		dbg_printf("DSIWAREFOUND Is DSiWare!\n");
+		_isDSiWare = ETrue;
+
+		_saveInfo.dsiPrvSavSize = info.prvSavSize;
+		_saveInfo.dsiPubSavSize = info.pubSavSize;
+		_saveInfo.dsiTid[0] = info.dsi_tid;
+		_saveInfo.dsiTid[1] = info.dsi_tid2;
+	  }
+	}
+	if ((memcmp(info.gameCode, "KPP", 3) == 0
+	  || memcmp(info.gameCode, "KPF", 3) == 0)
+	&& (!isDSiMode() || ms().dsiWareBooter || ms().consoleModel > 0)) {
+		_isDSiWare = EFalse;
 	}
 
-	if (_isHomebrew == EFalse && header.unitCode != 0)
+	if (_isHomebrew == EFalse && info.unitCode != 0)
 	{
-		fseek(f, 0x8000, SEEK_SET);
-		fread(arm9Sig[0], sizeof(u32), 4, f);
-		fseek(f, header.arm9iromOffset, SEEK_SET);
-		fread(arm9Sig[1], sizeof(u32), 4, f);
-		fseek(f, header.arm7iromOffset, SEEK_SET);
-		fread(arm9Sig[2], sizeof(u32), 4, f);
 		for (int i = 1; i < 3; i++) {
-			if (arm9Sig[i][0] == arm9Sig[0][0]
-			 && arm9Sig[i][1] == arm9Sig[0][1]
-			 && arm9Sig[i][2] == arm9Sig[0][2]
-			 && arm9Sig[i][3] == arm9Sig[0][3]) {
+			if (info.twlSig[i][0] == info.twlSig[0][0]
+			 && info.twlSig[i][1] == info.twlSig[0][1]
+			 && info.twlSig[i][2] == info.twlSig[0][2]
+			 && info.twlSig[i][3] == info.twlSig[0][3]) {
 				_hasExtendedBinaries = EFalse;
 			}
-			if (arm9Sig[i][0] == 0
-			 && arm9Sig[i][1] == 0
-			 && arm9Sig[i][2] == 0
-			 && arm9Sig[i][3] == 0) {
+			if (info.twlSig[i][0] == 0
+			 && info.twlSig[i][1] == 0
+			 && info.twlSig[i][2] == 0
+			 && info.twlSig[i][3] == 0) {
 				_hasExtendedBinaries = EFalse;
 			}
-			if (arm9Sig[i][0] == 0xFFFFFFFF
-			 && arm9Sig[i][1] == 0xFFFFFFFF
-			 && arm9Sig[i][2] == 0xFFFFFFFF
-			 && arm9Sig[i][3] == 0xFFFFFFFF) {
+			if (info.twlSig[i][0] == 0xFFFFFFFF
+			 && info.twlSig[i][1] == 0xFFFFFFFF
+			 && info.twlSig[i][2] == 0xFFFFFFFF
+			 && info.twlSig[i][3] == 0xFFFFFFFF) {
 				_hasExtendedBinaries = EFalse;
 			}
 		}
-		if (header.arm9iromOffset == 0 || header.arm7iromOffset == 0)
+		if (info.arm9iromOffset == 0 || info.arm7iromOffset == 0)
 		{
 			_hasExtendedBinaries = EFalse;
 		}
 	}
 
 	///////// saveInfo /////////
-	tonccpy(_saveInfo.gameTitle, header.gameTitle, 12);
-	tonccpy(_saveInfo.gameCode, header.gameCode, 4);
-	_saveInfo.arm9destination = header.arm9destination;
+	tonccpy(_saveInfo.gameTitle, info.gameTitle, 12);
+	tonccpy(_saveInfo.gameCode, info.gameCode, 4);
+	_saveInfo.arm9destination = info.arm9destination;
 	///// SDK Version /////
 
 	if (_isHomebrew == EFalse)
 	{
-		_saveInfo.gameSdkVersion = getModuleParams(&header, f)->sdk_version;
+		_saveInfo.gameSdkVersion = info.sdkVersion;
 		dbg_printf("SDK: %X\n", _saveInfo.gameSdkVersion);
 	}
 	else
@@ -277,22 +421,15 @@ bool DSRomInfo::loadDSRomInfo(const std::string &filename, bool loadBanner)
 		_saveInfo.gameSdkVersion = 0;
 	}
 
-	_saveInfo.gameCRC = header.headerCRC16;
-	_romVersion = header.romversion;
+	_saveInfo.gameCRC = info.headerCRC16;
+	_romVersion = info.romversion;
 
 	///////// banner /////////
-	if (header.bannerOffset != 0)
+	if (info.hasBanner)
 	{
-		fseek(f, header.bannerOffset, SEEK_SET);
-		sNDSBannerExt banner;
-		int bannerSize;
 		int currentLang = 0;
 
-		// Rely on short-circuiting to get a clean if statement.
-
-		// If we get a full size banner, then continue as so, setting bannerSize appropriately.
-		// Otherwise, if we read an invalid amount of bytes, read a DS size header.
-		if ((fseek(f, header.bannerOffset, SEEK_SET) == 0 && (bannerSize = fread(&banner, 1, sizeof(banner), f)) == sizeof(banner)) || (fseek(f, header.bannerOffset, SEEK_SET) == 0 && (bannerSize = fread(&banner, 1, NDS_BANNER_SIZE_ORIGINAL, f)) == NDS_BANNER_SIZE_ORIGINAL))
+		if (bannerSize > 0)
 		{
 			u16 dsiCrc16 = swiCRC16(0xFFFF, banner.dsi_icon, 0x1180);
 			// Check for DSi Banner.
@@ -355,8 +492,6 @@ bool DSRomInfo::loadDSRomInfo(const std::string &filename, bool loadBanner)
 		tonccpy(_banner.title, ((tNDSBanner*)nds_banner_bin)->titles[ms().getGuiLanguage()], sizeof(_banner.title));
 	}
 
-	fclose(f);
-
 	return true;
 }
 
@@ -119,6 +119,10 @@ public:
   bool isArgv(void);
   int requiresDonorRom(void);
 
+  // Read what the ROM info cache has for ROMs in one directory, in one go,
+  // before they're loaded
+  static void readCachedInfo(const char *const *filenames, int count);
+
   DSRomInfo &operator=(const DSRomInfo &src);
   void MayBeArgv(const std::string &filename)
   {
@@ -22,6 +22,8 @@
 
 #include <nds/arm9/dldi.h>
 #include <sys/dirent.h>
+#include <strings.h>
+#include <fat.h>
 #define ATTRIB_HID 0x02
 #include "mainlist.h"
 //#include "files.h"
@@ -35,6 +37,7 @@
 #include "tool/memtool.h"
 #include "tool/dbgtool.h"
 #include "common/inifile.h"
+#include "rominfo/romInfoCache.h"
 #include "unknown_banner_bin.h"
 #include "nds_save_banner_bin.h"
 #include "nand_banner_bin.h"
@@ -62,7 +65,7 @@
 using namespace akui;
 
 MainList::MainList(s32 x, s32 y, u32 w, u32 h, Window *parent, const std::string &text)
-    : ListView(x, y, w, h, parent, text, ms().ak_scrollSpeed), _showAllFiles(false)
+    : ListView(x, y, w, h, parent, text, ms().ak_scrollSpeed), _nextRomInfo(0), _showAllFiles(false)
 {
     _viewMode = VM_LIST;
     _activeIconScale = 1;
@@ -238,6 +241,7 @@ bool MainList::enterDir(const std::string &dirName)
     {
         removeAllRows();
         _romInfoList.clear();
+        _romInfoPrepared.clear();
         cwl();
 
         if (sdFound())
@@ -303,11 +307,9 @@ bool MainList::enterDir(const std::string &dirName)
     cwl();
     removeAllRows();
     _romInfoList.clear();
- 
-    struct stat st;
-    dirent *direntry;
-    std::string extName;
-    char lfnBuf[dirName.length() + 256 + 2];
+    _romInfoPrepared.clear();
+    romInfoCache().clearListing();
+
     // list dir
 
     cwl();
@@ -319,46 +321,51 @@ bool MainList::enterDir(const std::string &dirName)
         extern void RemoveTrailingSlashes(std::string &path);
         RemoveTrailingSlashes(_currentDir);
 
-        while ((direntry = readdir(dir)) != NULL)
+        std::string extName;
+        while (true)
         {
-            toncset(lfnBuf, 0, sizeof(lfnBuf));
-            snprintf(lfnBuf, sizeof(lfnBuf), "%s/%s", _currentDir.c_str(), direntry->d_name);
-            stat(lfnBuf, &st);
-            std::string lfn(direntry->d_name);
-            nocashMessage("mainlist:319");
-
-            // st.st_mode & S_IFDIR indicates a directory
-            size_t lastDotPos = lfn.find_last_of('.');
-            if (lfn.npos != lastDotPos) {
-                extName = lfn.substr(lastDotPos);
-            } else {
-                extName = "";
-            }
-            nocashMessage("mainlist:328");
+            // Copy the FAT directory entry before readdir moves on to the next
+            // one, for the attributes and for the ROM info cache's key. This
+            // is the same as FAT_getAttr() and stat() on the entry's path,
+            // without searching the directory for it again, but relies on
+            // libfat's internal structs, as in the dsimenu theme's file browser.
+            static_assert(_LIBFAT_MAJOR_ == 1 && _LIBFAT_MINOR_ == 1 && _LIBFAT_PATCH_ == 5, "libfat updated! Check that this is still correct");
+
+            // state->currentEntry.entryData
+            u8 entryData[32];
+            memcpy(entryData, (u8 *)dir->dirData->dirStruct + 4, sizeof(entryData));
+            const int attrs = ms().showHidden ? 0 : entryData[0xB];
+
+            dirent *direntry = readdir(dir);
+            if (direntry == NULL)
+                break;
+
+            const char *lfn = direntry->d_name;
+            const bool isDirectory = (direntry->d_type == DT_DIR);
 
+            const char *lastDot = strrchr(lfn, '.');
+            extName = lastDot ? lastDot : "";
 
-            dbg_printf("%s: %s %s\n", (st.st_mode & S_IFDIR ? " DIR" : "FILE"), lfnBuf, extName.c_str());
+            dbg_printf("%s: %s/%s %s\n", (isDirectory ? " DIR" : "FILE"), _currentDir.c_str(), lfn, extName.c_str());
             cwl();
-            bool showThis = (st.st_mode & S_IFDIR) ? ((lfn != "." && lfn != ".." && lfn != "_nds" && lfn != "saves" && lfn != "ramdisks") && ms().showDirectories)  // directory filter
-                                                   : extnameFilter(_showAllFiles ? std::vector<std::string>() : _extnameFilter, extName);                           // extension name filter
-            showThis = showThis && (ms().showHidden || (strncmp(".", direntry->d_name, 1)));                                                                        // Hide dotfiles
-            showThis = showThis && (ms().showHidden || !(FAT_getAttr((dirName + lfn).c_str()) & ATTR_HIDDEN));                                                      // Hide if the hidden FAT attribute is true
+            bool showThis = isDirectory ? (strcmp(lfn, ".") != 0 && strcmp(lfn, "..") != 0 && strcmp(lfn, "_nds") != 0 && strcmp(lfn, "saves") != 0 && strcmp(lfn, "ramdisks") != 0 && ms().showDirectories)  // directory filter
+                                        : extnameFilter(_showAllFiles ? std::vector<std::string>() : _extnameFilter, extName);                                                                           // extension name filter
+            showThis = showThis && (ms().showHidden || lfn[0] != '.');                  // Hide dotfiles
+            showThis = showThis && (ms().showHidden || !(attrs & ATTR_HIDDEN));         // Hide if the hidden FAT attribute is true
             cwl();
-            nocashMessage("mainlist:338");
 
             if (showThis)
             {
-                nocashMessage("mainlist:342");
                 std::string real_name = dirName + lfn;
-                if (st.st_mode & S_IFDIR)
+                if (isDirectory)
                 {
                     real_name += "/";
                 }
-                nocashMessage("mainlist:348");
-                nocashMessage(lfn.c_str());
-                nocashMessage(real_name.c_str());
+                else
+                {
+                    romInfoCache().listFile(real_name.c_str(), entryData);
+                }
                 addDirEntry(lfn, "", real_name, "", unknown_banner_bin);
-                nocashMessage("mainlist:352");
             }
         }
         nocashMessage("mainlist:355");
@@ -367,80 +374,10 @@ bool MainList::enterDir(const std::string &dirName)
 
         std::sort(_rows.begin(), _rows.end(), itemSortComp);
 
-        for (size_t ii = 0; ii < _rows.size(); ii++)
-        {
-            DSRomInfo &rominfo = _romInfoList[ii];
-            std::string filename = _rows[ii][REALNAME_COLUMN].text();
-            size_t lastDotPos = filename.find_last_of('.');
-            if (filename.npos != lastDotPos)
-                extName = filename.substr(lastDotPos);
-            else
-                extName = "";
-            for (size_t jj = 0; jj < extName.size(); jj++)
-                extName[jj] = tolower(extName[jj]);
-
-            if ('/' == filename[filename.size() - 1])
-            {
-                rominfo.setBanner("folder", folder_banner_bin);
-            }
-            else
-            {
-                bool allowExt = true, allowUnknown = false;
-                if (".gba" == extName)
-                {
-                    rominfo.MayBeGbaRom(filename);
-                }
-                //else if (".launcharg" == extName || ".argv" == extName)
-                else if (".argv" == extName)
-                {
-                    rominfo.MayBeArgv(filename);
-                    allowUnknown = true;
-                }
-                else if (".plg" == extName || ".rvid" == extName || ".mp4" == extName || ".a26" == extName || ".pce" == extName)
-                {
-                    rominfo.setBanner("plg", ds2plg_banner_bin);
-                }
-                else if (".gb" == extName)
-                {
-                    rominfo.setBanner("gb", gbrom_banner_bin);
-                }
-                else if (".gbc" == extName)
-                {
-                    rominfo.setBanner("gbc", gbcrom_banner_bin);
-                }
-                else if (".nes" == extName)
-                {
-                    rominfo.setBanner("nes", nesrom_banner_bin);
-                }
-                else if (".sms" == extName || ".gg" == extName)
-                {
-                    rominfo.setBanner("sms", s8ds_banner_bin);
-                }
-                else if (".gen" == extName)
-                {
-                    rominfo.setBanner("sms", smdrom_banner_bin);
-                }
-                else if (".smc" == extName || ".sfc" == extName)
-                {
-                    rominfo.setBanner("sms", snemulds_banner_bin);
-                }
-                else if (".nds" != extName && ".ids" != extName && ".dsi" != extName && ".srl" != extName && ".app" != extName)
-                {
-                    rominfo.setBanner("", unknown_banner_bin);
-                    allowUnknown = true;
-                }
-                else
-                {
-                    rominfo.MayBeDSRom(filename);
-                    allowExt = false;
-                }
-                rominfo.setExtIcon(_rows[ii][SHOWNAME_COLUMN].text());
-                if (allowExt && extName.length() && !rominfo.isExtIcon())
-                    rominfo.setExtIcon(extName.substr(1));
-                if (allowUnknown && !rominfo.isExtIcon())
-                    rominfo.setExtIcon("unknown");
-            }
-        }
+        // Each row's icon is set up when it's first drawn, or in the
+        // frames after, so the first screen is shown right away.
+        _romInfoPrepared.assign(_rows.size(), false);
+        _nextRomInfo = 0;
     }
     nocashMessage("mainlist:415");
     directoryChanged();
@@ -449,6 +386,125 @@ bool MainList::enterDir(const std::string &dirName)
     return true;
 }
 
+void MainList::prepareRomInfo(size_t index)
+{
+    if (index >= _romInfoPrepared.size() || _romInfoPrepared[index])
+        return;
+    _romInfoPrepared[index] = true;
+
+    DSRomInfo &rominfo = _romInfoList[index];
+    const std::string &filename = _rows[index][REALNAME_COLUMN].text();
+    std::string extName;
+    size_t lastDotPos = filename.find_last_of('.');
+    if (filename.npos != lastDotPos)
+        extName = filename.substr(lastDotPos);
+    for (size_t jj = 0; jj < extName.size(); jj++)
+        extName[jj] = tolower(extName[jj]);
+
+    if ('/' == filename[filename.size() - 1])
+    {
+        rominfo.setBanner("folder", folder_banner_bin);
+    }
+    else
+    {
+        bool allowExt = true, allowUnknown = false;
+        if (".gba" == extName)
+        {
+            rominfo.MayBeGbaRom(filename);
+        }
+        //else if (".launcharg" == extName || ".argv" == extName)
+        else if (".argv" == extName)
+        {
+            rominfo.MayBeArgv(filename);
+            allowUnknown = true;
+        }
+        else if (".plg" == extName || ".rvid" == extName || ".mp4" == extName || ".a26" == extName || ".pce" == extName)
+        {
+            rominfo.setBanner("plg", ds2plg_banner_bin);
+        }
+        else if (".gb" == extName)
+        {
+            rominfo.setBanner("gb", gbrom_banner_bin);
+        }
+        else if (".gbc" == extName)
+        {
+            rominfo.setBanner("gbc", gbcrom_banner_bin);
+        }
+        else if (".nes" == extName)
+        {
+            rominfo.setBanner("nes", nesrom_banner_bin);
+        }
+        else if (".sms" == extName || ".gg" == extName)
+        {
+            rominfo.setBanner("sms", s8ds_banner_bin);
+        }
+        else if (".gen" == extName)
+        {
+            rominfo.setBanner("sms", smdrom_banner_bin);
+        }
+        else if (".smc" == extName || ".sfc" == extName)
+        {
+            rominfo.setBanner("sms", snemulds_banner_bin);
+        }
+        else if (".nds" != extName && ".ids" != extName && ".dsi" != extName && ".srl" != extName && ".app" != extName)
+        {
+            rominfo.setBanner("", unknown_banner_bin);
+            allowUnknown = true;
+        }
+        else
+        {
+            rominfo.MayBeDSRom(filename);
+            allowExt = false;
+        }
+        rominfo.setExtIcon(_rows[index][SHOWNAME_COLUMN].text());
+        if (allowExt && extName.length() && !rominfo.isExtIcon())
+            rominfo.setExtIcon(extName.substr(1));
+        if (allowUnknown && !rominfo.isExtIcon())
+            rominfo.setExtIcon("unknown");
+    }
+}
+
+static bool isDSRomFile(const std::string &filename)
+{
+    size_t lastDotPos = filename.find_last_of('.');
+    if (filename.npos == lastDotPos)
+        return false;
+    const char *extName = filename.c_str() + lastDotPos;
+    return strcasecmp(extName, ".nds") == 0 || strcasecmp(extName, ".ids") == 0 || strcasecmp(extName, ".dsi") == 0
+        || strcasecmp(extName, ".srl") == 0 || strcasecmp(extName, ".app") == 0;
+}
+
+void MainList::prepareRomInfos(void)
+{
+    // Rows on screen first, then a few more each frame until all are done
+    size_t total = _visibleRowCount;
+    if (total > _rows.size() - _firstVisibleRowId)
+        total = _rows.size() - _firstVisibleRowId;
+
+    // The cached info of the DS ROMs coming on screen is read in one go
+    std::vector<const char *> romNames;
+    for (size_t i = 0; i < total; ++i)
+    {
+        const size_t index = _firstVisibleRowId + i;
+        const std::string &filename = _rows[index][REALNAME_COLUMN].text();
+        if (index < _romInfoPrepared.size() && !_romInfoPrepared[index] && isDSRomFile(filename))
+            romNames.push_back(filename.c_str());
+    }
+    DSRomInfo::readCachedInfo(romNames.data(), romNames.size());
+
+    for (size_t i = 0; i < total; ++i)
+        prepareRomInfo(_firstVisibleRowId + i);
+
+    for (size_t i = 0; i < 16 && _nextRomInfo < _romInfoPrepared.size(); ++_nextRomInfo)
+    {
+        if (!_romInfoPrepared[_nextRomInfo])
+        {
+            prepareRomInfo(_nextRomInfo);
+            ++i;
+        }
+    }
+}
+
 void MainList::onSelectChanged(u32 index)
 {
     if (index >= 0) dbg_printf("%s\n", _rows[index][3].text().c_str());
@@ -517,10 +573,11 @@ std::string MainList::getSelectedShowName()
     return _rows[_selectedRowId][SHOWNAME_COLUMN].text();
 }
 
-bool MainList::getRomInfo(u32 rowIndex, DSRomInfo &info) const
+bool MainList::getRomInfo(u32 rowIndex, DSRomInfo &info)
 {
     if (rowIndex < _romInfoList.size())
     {
+        prepareRomInfo(rowIndex);
         info = _romInfoList[rowIndex];
         return true;
     }
@@ -543,6 +600,7 @@ void MainList::setRomInfo(u32 rowIndex, const DSRomInfo &info)
 
 void MainList::draw()
 {
+    prepareRomInfos();
     updateInternalNames();
     ListView::draw();
     updateActiveIcon(POSITION);
@@ -81,7 +81,7 @@ public:
 
   std::string getCurrentDir();
 
-  bool getRomInfo(u32 rowIndex, DSRomInfo &info) const;
+  bool getRomInfo(u32 rowIndex, DSRomInfo &info);
 
   void setRomInfo(u32 rowIndex, const DSRomInfo &info);
 
@@ -118,6 +118,9 @@ protected:
   void updateActiveIcon(bool updateContent);
   void updateInternalNames(void);
 
+  void prepareRomInfo(size_t index);
+  void prepareRomInfos(void);
+
 protected:
   void onSelectChanged(u32 index);
 
@@ -130,6 +133,10 @@ protected:
 
   std::vector<DSRomInfo> _romInfoList;
 
+  std::vector<bool> _romInfoPrepared; // Rows from a directory are set up as they're needed
+
+  size_t _nextRomInfo;
+
   ZoomingIcon _activeIcon;
 
   float _activeIconScale;
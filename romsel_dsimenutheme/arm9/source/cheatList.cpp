@@ -0,0 +1,289 @@
+/*
+    cheatList.cpp
+    Portions copyright (C) 2008 Normmatt, www.normmatt.com, Smiths (www.emuholic.com)
+    Portions copyright (C) 2008 bliss (bliss@hanirc.org)
+    Copyright (C) 2009 yellow wood goblin
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cheat.h"
+#include "common/cheatIndex.h"
+#include "common/crc32.h"
+#include "common/tonccpy.h"
+#include <stdlib.h>
+#include <string.h>
+
+CheatCodelist::~CheatCodelist(void)
+{
+  free(_arena);
+}
+
+inline u32 gamecode(const char *aGameCode)
+{
+  u32 gameCode;
+  tonccpy(&gameCode, aGameCode, sizeof(gameCode));
+  return gameCode;
+}
+
+bool CheatCodelist::searchCheatData(FILE* aDat,u32 gamecode,u32 crc32,long& aPos,size_t& aSize)
+{
+  aPos=0;
+  aSize=0;
+  const char* KHeader="R4 CheatCode";
+  char header[12];
+  fread(header,12,1,aDat);
+  if (strncmp(KHeader,header,12)) return false;
+
+  u32 offset,size;
+  if (!cheatIndexFind(aDat,gamecode,crc32,offset,size)) return false;
+  aPos=offset;
+  aSize=size;
+  return (aPos&&aSize);
+}
+
+bool CheatCodelist::parseInternal(FILE* aDat,u32 gamecode,u32 crc32)
+{
+  // dbg_printf("%x, %x\n",gamecode,crc32);
+
+  _data.clear();
+  free(_arena);
+  _arena=NULL;
+  _arenaSize=0;
+
+  long dataPos; size_t dataSize;
+  if (!searchCheatData(aDat,gamecode,crc32,dataPos,dataSize)) return false;
+  fseek(aDat,dataPos,SEEK_SET);
+
+  // dbg_printf("record found: %d\n",dataSize);
+
+  // Kept for as long as the list, with a zeroed word after it to end any name left unterminated
+  _arena=(char*)malloc(dataSize+4);
+  if (!_arena) return false;
+  fread(_arena,dataSize,1,aDat);
+  memset(_arena+dataSize,0,4);
+  _arenaSize=dataSize;
+  _arenaPos=dataPos;
+
+  u32 pos=(strlen(_arena)+4)&~3;
+  u32 cheatCount=word(pos);
+  cheatCount&=0x0fffffff;
+  pos+=9*4;
+
+  u32 cc=0;
+  while (cc<cheatCount&&pos+4<=_arenaSize)
+  {
+    u32 entry=word(pos);
+    if ((entry>>28)&1)
+    {
+      // Only the folder itself, its cheats are parsed when it's opened
+      u32 folderName=pos+4;
+      u32 folderNote=folderName+strlen(_arena+folderName)+1;
+      _data.push_back(cParsedItem(folderName,folderNote,cParsedItem::EFolder|(((entry>>24)==0x11)?cParsedItem::EOne:0)));
+      _data.back()._cheat=(folderNote+strlen(_arena+folderNote)+1+3)&~3;
+      _data.back()._cheatCount=entry&0x00ffffff;
+      cc+=1+_data.back()._cheatCount;
+      pos=skipCheats(_data.back()._cheat,_data.back()._cheatCount);
+    }
+    else
+    {
+      cc++;
+      pos=parseCheats(pos,1,0,_data);
+    }
+  }
+  generateList();
+  return true;
+}
+
+// Add the cheats with code words from aPos to aCheats, and return where they end
+u32 CheatCodelist::parseCheats(u32 aPos,u32 aCount,u32 aFlags,std::vector<cParsedItem>& aCheats)
+{
+  u32 selectValue=cParsedItem::ESelected;
+  for (u32 ii=0;ii<aCount&&aPos+4<=_arenaSize;++ii)
+  {
+    u32 entry=word(aPos);
+    u32 cheatName=aPos+4;
+    u32 cheatNote=cheatName+strlen(_arena+cheatName)+1;
+    u32 cheatData=(cheatNote+strlen(_arena+cheatNote)+1+3)&~3;
+    u32 cheatDataLen=(cheatData+4<=_arenaSize)?word(cheatData):0;
+
+    if (cheatDataLen&&cheatData+4+cheatDataLen*4<=_arenaSize)
+    {
+      aCheats.push_back(cParsedItem(cheatName,cheatNote,aFlags|((entry&0xff000000)?selectValue:0),_arenaPos+aPos+3));
+      aCheats.back()._cheat=cheatData+4;
+      aCheats.back()._cheatCount=cheatDataLen;
+      if ((entry&0xff000000)&&(aFlags&cParsedItem::EOne)) selectValue=0;
+    }
+    aPos+=((entry&0x00ffffff)+1)*4;
+  }
+  return aPos;
+}
+
+u32 CheatCodelist::skipCheats(u32 aPos,u32 aCount)
+{
+  for (u32 ii=0;ii<aCount&&aPos+4<=_arenaSize;++ii)
+    aPos+=((word(aPos)&0x00ffffff)+1)*4;
+  return aPos;
+}
+
+void CheatCodelist::folderCheats(const cParsedItem& aFolder,std::vector<cParsedItem>& aCheats)
+{
+  size_t first=aCheats.size();
+  parseCheats(aFolder._cheat,aFolder._cheatCount,cParsedItem::EInFolder|(aFolder._flags&cParsedItem::EOne),aCheats);
+  if (aFolder._flags&cParsedItem::ECleared)
+  {
+    for (size_t ii=first;ii<aCheats.size();++ii) aCheats[ii]._flags&=~cParsedItem::ESelected;
+  }
+}
+
+void CheatCodelist::openFolder(size_t anIndex)
+{
+  if (_data[anIndex]._flags&cParsedItem::EParsed) return;
+
+  std::vector<cParsedItem> cheats;
+  folderCheats(_data[anIndex],cheats);
+  _data[anIndex]._flags=(_data[anIndex]._flags|cParsedItem::EParsed)&~cParsedItem::ECleared;
+  _data.insert(_data.begin()+anIndex+1,cheats.begin(),cheats.end());
+  generateList();
+}
+
+void CheatCodelist::generateList(void)
+{
+  _indexes.clear();
+  // _List.removeAllRows();
+
+  std::vector<cParsedItem>::iterator itr=_data.begin();
+  while (itr!=_data.end())
+  {
+    std::vector<std::string> row;
+    row.push_back("");
+    row.push_back(title(*itr));
+    // _List.insertRow(_List.getRowCount(),row);
+    _indexes.push_back(itr-_data.begin());
+    u32 flags=(*itr)._flags;
+    ++itr;
+    if ((flags&cParsedItem::EFolder)&&(flags&cParsedItem::EOpen)==0)
+    {
+      while (itr!=_data.end()&&((*itr)._flags&cParsedItem::EInFolder)) ++itr;
+    }
+  }
+}
+
+void CheatCodelist::deselectFolder(size_t anIndex)
+{
+  std::vector<cParsedItem>::iterator itr=_data.begin()+anIndex;
+  while (--itr>=_data.begin())
+  {
+    if ((*itr)._flags&cParsedItem::EFolder)
+    {
+      ++itr;
+      break;
+    }
+  }
+  while (itr!=_data.end()&&((*itr)._flags&cParsedItem::EInFolder))
+  {
+    (*itr)._flags&=~cParsedItem::ESelected;
+    ++itr;
+  }
+}
+
+void CheatCodelist::deselectAll(void)
+{
+  std::vector<cParsedItem>::iterator itr=_data.begin();
+  while (itr!=_data.end())
+  {
+    (*itr)._flags&=~cParsedItem::ESelected;
+    // The cheats of folders not yet parsed are deselected when they are
+    if (((*itr)._flags&cParsedItem::EFolder)&&!((*itr)._flags&cParsedItem::EParsed))
+      (*itr)._flags|=cParsedItem::ECleared;
+    ++itr;
+  }
+}
+
+bool CheatCodelist::romData(const std::string& aFileName,u32& aGameCode,u32& aCrc32)
+{
+  bool res=false;
+  FILE* rom=fopen(aFileName.c_str(),"rb");
+  if (rom)
+  {
+    u8 header[512];
+    if (1==fread(header,sizeof(header),1,rom))
+    {
+      // usrcheat.dat keeps the CRC without the final inversion
+      aCrc32=crc32Update(0xFFFFFFFF,header,sizeof(header));
+      aGameCode=gamecode((const char*)(header+12));
+      res=true;
+    }
+    fclose(rom);
+  }
+  return res;
+}
+
+static void updateDB(u8 value,u32 offset,FILE* db)
+{
+  u8 oldvalue;
+  if (!db) return;
+  if (!offset) return;
+  if (fseek(db,offset,SEEK_SET)) return;
+  if (fread(&oldvalue,sizeof(oldvalue),1,db)!=1) return;
+  if (oldvalue!=value)
+  {
+    if (fseek(db,offset,SEEK_SET)) return;
+    fwrite(&value,sizeof(value),1,db);
+  }
+}
+
+void CheatCodelist::writeSelection(FILE* aDat)
+{
+  std::vector<cParsedItem>::iterator itr=_data.begin();
+  while (itr!=_data.end())
+  {
+    updateDB(((*itr)._flags&cParsedItem::ESelected)?1:0,(*itr)._offset,aDat);
+    // Cheats in folders never opened as they'd be listed: only the first selected where only one can be,
+    // and none once they've all been deselected
+    if (((*itr)._flags&cParsedItem::EFolder)&&!((*itr)._flags&cParsedItem::EParsed))
+    {
+      std::vector<cParsedItem> cheats;
+      folderCheats(*itr,cheats);
+      for (size_t ii=0;ii<cheats.size();++ii) updateDB((cheats[ii]._flags&cParsedItem::ESelected)?1:0,cheats[ii]._offset,aDat);
+    }
+    ++itr;
+  }
+}
+
+void CheatCodelist::writeCheatsToFile(const char *path) {
+  FILE *file = fopen(path, "wb");
+  if (file) {
+    // Straight from the arena, with the cheats of folders never opened as usrcheat.dat has them
+    std::vector<cParsedItem> cheats;
+    for (uint i=0;i<_data.size();i++)
+    {
+      if ((_data[i]._flags&cParsedItem::EFolder)&&!(_data[i]._flags&cParsedItem::EParsed))
+      {
+        cheats.clear();
+        folderCheats(_data[i],cheats);
+        for (uint j=0;j<cheats.size();j++)
+        {
+          if (cheats[j]._flags&cParsedItem::ESelected) fwrite(_arena+cheats[j]._cheat,4,cheats[j]._cheatCount,file);
+        }
+      }
+      else if (_data[i]._flags&cParsedItem::ESelected)
+      {
+        fwrite(_arena+_data[i]._cheat,4,_data[i]._cheatCount,file);
+      }
+    }
+    fwrite("\0\0\0\xCF",4,1,file);
+    fclose(file);
+  }
+}
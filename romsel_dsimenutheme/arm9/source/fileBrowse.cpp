@@ -25,16 +25,20 @@
 #include "iconTitle.h"
 #include "ndsheaderbanner.h"
 #include "perGameSettings.h"
-#include "incompatibleGameMap.h"
-#include "compatibleDSiWareMap.h"
+#include "gameRules.h"
 #include "gbaswitch.h"
 
 #include "common/twlmenusettings.h"
 #include "common/bootstrapsettings.h"
 #include "common/flashcard.h"
+#include "common/directoryModel.h"
+#include "common/fileType.h"
 #include "common/inifile.h"
 #include "common/nds_loader_arm9.h"
+#include "common/playStats.h"
 #include "common/systemdetails.h"
+#include "common/titleIndex.h"
+#include "rominfo/romInfoCache.h"
 #include "defaultSettings.h"
 #include "myDSiMode.h"
 #include "language.h"
@@ -112,6 +116,32 @@ std::string dirContName;
 
 char boxArtPath[256];
 
+// The page's box art is read into memory while the menu is idle, rather than
+// all of it before the page is shown
+static bool boxArtPending[40] = {false};
+static u32 boxArtPreloadToken = 0;
+
+// The page the user is likely to go to next, whose ROM info and box art are
+// read while the menu is idle, so it's shown without reading the ROMs
+static int prefetchPage = -1;
+static bool prefetchDone = false;
+static u32 prefetchToken = 0;
+static int shownPage = -1;		// -1 until getFileInfo() shows a page of this listing
+static int lastPageStep = 1;	// The way the user last went a page
+static bool lastCursorLeft = false;
+
+// Log how long page flips take, with and without the page prefetched
+// #define PAGE_FLIP_DEBUG
+
+#ifdef PAGE_FLIP_DEBUG
+static struct {
+	u32 flips;
+	u32 prefetchedFlips;
+	u64 ticks;
+	u64 prefetchedTicks;
+} pageFlipStats;
+#endif
+
 bool boxArtLoaded = false;
 bool shouldersRendered = false;
 bool settingsChanged = false;
@@ -134,19 +164,12 @@ extern bool rocketVideo_playVideo;
 
 extern void bgOperations(bool waitFrame);
 
-std::string gameOrderIniPath, recentlyPlayedIniPath, timesPlayedIniPath;
+std::string gameOrderIniPath;
+static PlayStats playStats;
 
 static bool inSelectMenu = false;
 
-struct DirEntry {
-	DirEntry(std::string name, bool isDirectory, int position, int customPos) : name(name), isDirectory(isDirectory), position(position), customPos(customPos) {}
-	DirEntry() {}
-
-	std::string name;
-	bool isDirectory;
-	int position;
-	bool customPos;
-};
+typedef DirectoryModel::Entry DirEntry;
 
 char path[PATH_MAX] = {0};
 
@@ -176,24 +199,20 @@ bool extension(const std::string_view filename, const std::vector<std::string_vi
 	return false;
 }
 
-bool nameEndsWith(const std::string_view name, const std::vector<std::string_view> extensionList) {
-	if (name.size() == 0)
+bool nameEndsWith(const char *name, const FileExtensionSet &extensions) {
+	if (name[0] == '\0')
 		return false;
 
-	if (extensionList.size() == 0)
+	if (extensions.empty())
 		return true;
 
-	if (name.substr(0, 2) == "._")
+	if (strncmp(name, "._", 2) == 0)
 		return false; // Don't show macOS's index files
 
-	for (const std::string_view &ext : extensionList) {
-		if (name.length() > ext.length() && strcasecmp(name.substr(name.length() - ext.length()).data(), ext.data()) == 0)
-			return true;
-	}
-	return false;
+	return extensions.matches(name);
 }
 
-bool dirEntryPredicate(const DirEntry &lhs, const DirEntry &rhs) {
+bool dirEntryPredicate(const DirectoryModel &dirContents, const DirEntry &lhs, const DirEntry &rhs) {
 	if (lhs.isDirectory && !lhs.customPos && !rhs.isDirectory) {
 		return true;
 	}
@@ -207,16 +226,16 @@ bool dirEntryPredicate(const DirEntry &lhs, const DirEntry &rhs) {
 		if (lhs.position < rhs.position)	return true;
 		else return false;
 	}
-	return strcasecmp(lhs.name.c_str(), rhs.name.c_str()) < 0;
+	return dirContents.compareNames(lhs, rhs) < 0;
 }
 
-void updateDirectoryContents(vector<DirEntry> &dirContents) {
+void updateDirectoryContents(DirectoryModel &dirContents) {
 	if (!dirInfoIniFound || pageLoaded[PAGENUM]) return;
 
 	if ((PAGENUM > 0) && !lockOutDirContentBlankFilling) {
 		for (int p = 0; p < PAGENUM; p++) {
 			for (int i = 0; i < 40; i++) {
-				dirContents.insert(dirContents.begin() + i + (p * 40), {"", false, i + (p * 40), false});
+				dirContents.insert(i + (p * 40), "", false, i + (p * 40));
 			}
 			dirContentBlankFilled[p] = true;
 		}
@@ -232,9 +251,9 @@ void updateDirectoryContents(vector<DirEntry> &dirContents) {
 
 		if (filename != "") {
 			if (dirContentBlankFilled[PAGENUM]) {
-				dirContents.erase(dirContents.begin() + i + (PAGENUM * 40));
+				dirContents.erase(i + (PAGENUM * 40));
 			}
-			dirContents.insert(dirContents.begin() + i + (PAGENUM * 40), {filename, false, currentPos, false});
+			dirContents.insert(i + (PAGENUM * 40), filename.c_str(), false, currentPos);
 			currentPos++;
 		} else {
 			break;
@@ -243,7 +262,101 @@ void updateDirectoryContents(vector<DirEntry> &dirContents) {
 	pageLoaded[PAGENUM] = true;
 }
 
-void getDirectoryContents(std::vector<DirEntry> &dirContents, const std::vector<std::string_view> extensionList = {}) {
+static void cancelBoxArtPreload(void) {
+	idleTasks().cancel(boxArtPreloadToken);
+	boxArtPreloadToken = 0;
+	for (int i = 0; i < 40; i++) {
+		boxArtPending[i] = false;
+	}
+}
+
+static void preloadBoxArt(const DirectoryModel &dirContents, int num) {
+	if (!boxArtPending[num]) return;
+	boxArtPending[num] = false;
+
+	char boxArtFile[256];
+	snprintf(boxArtFile, sizeof(boxArtFile), "%s:/_nds/TWiLightMenu/boxart/%s.png",
+			 sdFound() ? "sd" : "fat",
+			 dirContents.name(num + PAGENUM * 40));
+	if ((bnrRomType[num] == 0) && (access(boxArtFile, F_OK) != 0)) {
+		snprintf(boxArtFile, sizeof(boxArtFile), "%s:/_nds/TWiLightMenu/boxart/%s.png",
+				 (sdFound() ? "sd" : "fat"),
+				 gameTid[num]);
+	}
+	tex().loadBoxArtToMem(boxArtFile, num);
+}
+
+static void cancelPagePrefetch(void) {
+	idleTasks().cancel(prefetchToken);
+	prefetchToken = 0;
+	prefetchPage = -1;
+	prefetchDone = false;
+}
+
+/**
+ * The page the cursor is close to the edge of, or otherwise the next one the
+ * way the user's been going, or -1 if there isn't one.
+ */
+static int predictPage(int fileCount) {
+	int page = PAGENUM + lastPageStep;
+	if (CURPOS >= 30) {
+		page = PAGENUM + 1;
+	} else if (CURPOS < 10 && lastCursorLeft) {
+		page = PAGENUM - 1;
+	}
+	if (page < 0 || page * 40 >= fileCount) return -1;
+	return page;
+}
+
+static void prefetchEntry(const DirectoryModel &dirContents, int index) {
+	if (dirContents.isDirectory(index)) return;
+
+	const char *name = dirContents.name(index);
+	char gameCode[5] = {0};
+	const bool isRom = prefetchGameInfo(name, gameCode);
+
+	if (dsiFeatures() && !ms().macroMode && ms().showBoxArt == 2 && ms().theme != TWLSettings::EThemeHBL) {
+		char boxArtFile[256];
+		snprintf(boxArtFile, sizeof(boxArtFile), "%s:/_nds/TWiLightMenu/boxart/%s.png", sdFound() ? "sd" : "fat", name);
+		if (isRom && (access(boxArtFile, F_OK) != 0)) {
+			snprintf(boxArtFile, sizeof(boxArtFile), "%s:/_nds/TWiLightMenu/boxart/%s.png", sdFound() ? "sd" : "fat", gameCode);
+		}
+		tex().prefetchBoxArt(boxArtFile);
+	}
+}
+
+/**
+ * Start prefetching the page the user's likely to go to, if it isn't already,
+ * dropping one for the other way.
+ */
+static void updatePagePrefetch(const DirectoryModel &dirContents) {
+	// Pages listed in dirInfo.twlm.ini are only read once they're gone to
+	if (dirInfoIniFound) return;
+
+	const int page = predictPage(dirContents.size());
+	if (page == prefetchPage) return;
+
+	cancelPagePrefetch();
+	if (page < 0) return;
+
+	prefetchPage = page;
+	prefetchToken = idleTasks().newToken();
+	const DirectoryModel *contents = &dirContents;
+	int index = page * 40;
+	idleTasks().add([contents, page, index]() mutable {
+		if (index < (page + 1) * 40 && index < (int)contents->size()) {
+			prefetchEntry(*contents, index++);
+			return false;
+		}
+		prefetchDone = true;
+		return true;
+	}, TaskScheduler::PRIORITY_LOW, prefetchToken);
+}
+
+void getDirectoryContents(DirectoryModel &dirContents, const std::vector<std::string_view> extensionList = {}) {
+	cancelBoxArtPreload();
+	cancelPagePrefetch();
+	shownPage = -1;
 	dirContents.clear();
 
 	file_count = 0;
@@ -262,6 +375,8 @@ void getDirectoryContents(std::vector<DirEntry> &dirContents, const std::vector<
 		dirInfoIniFound = false;
 	}
 
+	const FileExtensionSet extensions(extensionList);
+	romInfoCache().clearListing();
 	DIR *pdir = opendir(".");
 
 	if (pdir == nullptr) {
@@ -272,22 +387,21 @@ void getDirectoryContents(std::vector<DirEntry> &dirContents, const std::vector<
 
 			// This has to be done *before* readdir, since readdir increments
 			// the internal state's DIR_ENTRY for the next time
-			int attrs = 0;
-			if (!ms().showHidden) {
-				// Get FAT attrs, this is equivalent to FAT_getAttr(pent->d_name)
-				// but much quicker since we don't have to search the filesystem
-				// for the name.
-				// It's also *very* heavily dependant on internal libfat structs
-				// being exactly as they are now.
-				static_assert(_LIBFAT_MAJOR_ == 1 && _LIBFAT_MINOR_ == 1 && _LIBFAT_PATCH_ == 5, "libfat updated! Check that this is still correct");
-
-				// state->currentEntry.entryData[DIR_ENTRY_attributes]
-				u8 *state = (u8 *)pdir->dirData->dirStruct;
-				attrs = state[4 + 0xB];
-			}
+			// Copy the FAT directory entry, for the attrs and for the size,
+			// cluster and modification time the ROM info cache keys on. This
+			// is equivalent to FAT_getAttr(pent->d_name) and stat(), but much
+			// quicker since we don't have to search the filesystem for the name.
+			// It's also *very* heavily dependant on internal libfat structs
+			// being exactly as they are now.
+			static_assert(_LIBFAT_MAJOR_ == 1 && _LIBFAT_MINOR_ == 1 && _LIBFAT_PATCH_ == 5, "libfat updated! Check that this is still correct");
+
+			// state->currentEntry.entryData
+			u8 entryData[32];
+			memcpy(entryData, (u8 *)pdir->dirData->dirStruct + 4, sizeof(entryData));
+			const int attrs = ms().showHidden ? 0 : entryData[0xB];
 
 			dirent *pent = readdir(pdir);
-			if (pent == nullptr || file_count > 320)
+			if (pent == nullptr)
 				break;
 
 			// Now that we've got the attrs and the name, skip if we should be hiding this
@@ -297,46 +411,47 @@ void getDirectoryContents(std::vector<DirEntry> &dirContents, const std::vector<
 			if (ms().showDirectories) {
 				if ((pent->d_type == DT_DIR && strcmp(pent->d_name, ".") != 0 && strcmp(pent->d_name, "_nds") != 0
 					&& strcmp(pent->d_name, "saves") != 0 && strcmp(pent->d_name, "ramdisks") != 0)
-					|| nameEndsWith(pent->d_name, extensionList)) {
-					dirContents.emplace_back(pent->d_name, pent->d_type == DT_DIR, file_count, false);
+					|| nameEndsWith(pent->d_name, extensions)) {
+					dirContents.add(pent->d_name, pent->d_type == DT_DIR, file_count);
 					file_count++;
+					if (pent->d_type != DT_DIR)
+						romInfoCache().listFile(pent->d_name, entryData);
 				}
 			} else {
-				if (pent->d_type != DT_DIR && nameEndsWith(pent->d_name, extensionList)) {
-					dirContents.emplace_back(pent->d_name, false, file_count, false);
+				if (pent->d_type != DT_DIR && nameEndsWith(pent->d_name, extensions)) {
+					dirContents.add(pent->d_name, false, file_count);
 					file_count++;
+					romInfoCache().listFile(pent->d_name, entryData);
 				}
 			}
 		}
 
+		auto sortPredicate = [&dirContents](const DirEntry &lhs, const DirEntry &rhs) {
+			return dirEntryPredicate(dirContents, lhs, rhs);
+		};
+
 		if (ms().sortMethod == TWLSettings::ESortAlphabetical) { // Alphabetical
-			std::sort(dirContents.begin(), dirContents.end(), dirEntryPredicate);
+			std::sort(dirContents.begin(), dirContents.end(), sortPredicate);
 		} else if (ms().sortMethod == TWLSettings::ESortRecent) { // Recent
-			CIniFile recentlyPlayedIni(recentlyPlayedIniPath);
-			std::vector<std::string> recentlyPlayed;
 			getcwd(path, PATH_MAX);
-			recentlyPlayedIni.GetStringVector("RECENT", path, recentlyPlayed, ':');
+			playStats.openDir(path);
 
-			int i = 0;
-			for (const std::string &recentlyPlayedName : recentlyPlayed) {
-				for (DirEntry &dirEntry : dirContents) {
-					if (recentlyPlayedName == dirEntry.name) {
-						dirEntry.position = i++;
-						dirEntry.customPos = true;
-						break;
-					}
+			for (DirEntry &dirEntry : dirContents) {
+				int rank = playStats.recentRank(dirContents.name(dirEntry));
+				if (rank >= 0) {
+					dirEntry.position = rank;
+					dirEntry.customPos = true;
 				}
 			}
-			sort(dirContents.begin(), dirContents.end(), dirEntryPredicate);
+			sort(dirContents.begin(), dirContents.end(), sortPredicate);
 		} else if (ms().sortMethod == TWLSettings::ESortMostPlayed) { // Most Played
-			CIniFile timesPlayedIni(timesPlayedIniPath);
-
 			getcwd(path, PATH_MAX);
+			playStats.openDir(path);
 			for (DirEntry &dirEntry : dirContents) {
-				dirEntry.position = timesPlayedIni.GetInt(path, dirEntry.name, 0);
+				dirEntry.position = playStats.timesPlayed(dirContents.name(dirEntry));
 			}
 
-			std::sort(dirContents.begin(), dirContents.end(), [](const DirEntry &lhs, const DirEntry &rhs) {
+			std::sort(dirContents.begin(), dirContents.end(), [&dirContents](const DirEntry &lhs, const DirEntry &rhs) {
 					if (!lhs.isDirectory && rhs.isDirectory)
 						return false;
 					else if (lhs.isDirectory && !rhs.isDirectory)
@@ -347,18 +462,18 @@ void getDirectoryContents(std::vector<DirEntry> &dirContents, const std::vector<
 					else if (lhs.position < rhs.position)
 						return false;
 					else
-						return strcasecmp(lhs.name.c_str(), rhs.name.c_str()) < 0;
+						return dirContents.compareNames(lhs, rhs) < 0;
 				});
 		} else if (ms().sortMethod == TWLSettings::ESortFileType) { // File type
-			sort(dirContents.begin(), dirContents.end(), [](const DirEntry &lhs, const DirEntry &rhs) {
+			sort(dirContents.begin(), dirContents.end(), [&dirContents](const DirEntry &lhs, const DirEntry &rhs) {
 					if (!lhs.isDirectory && rhs.isDirectory)
 						return false;
 					else if (lhs.isDirectory && !rhs.isDirectory)
 						return true;
 
-					int extCmp = strcasecmp(lhs.name.substr(lhs.name.find_last_of('.') + 1).c_str(), rhs.name.substr(rhs.name.find_last_of('.') + 1).c_str());
+					int extCmp = dirContents.compareExtensions(lhs, rhs);
 					if (extCmp == 0)
-						return strcasecmp(lhs.name.c_str(), rhs.name.c_str()) < 0;
+						return dirContents.compareNames(lhs, rhs) < 0;
 					else
 						return extCmp < 0;
 				});
@@ -370,14 +485,14 @@ void getDirectoryContents(std::vector<DirEntry> &dirContents, const std::vector<
 
 			for (uint i = 0; i < gameOrder.size(); i++) {
 				for (DirEntry &dirEntry : dirContents) {
-					if (gameOrder[i] == dirEntry.name) {
+					if (gameOrder[i] == dirContents.name(dirEntry)) {
 						dirEntry.position = i;
 						dirEntry.customPos = true;
 						break;
 					}
 				}
 			}
-			sort(dirContents.begin(), dirContents.end(), dirEntryPredicate);
+			sort(dirContents.begin(), dirContents.end(), sortPredicate);
 		}
 		closedir(pdir);
 	}
@@ -424,7 +539,7 @@ void displayNowLoading(void) {
 	showProgressIcon = true;
 }
 
-void moveCursor(bool right, const std::vector<DirEntry> dirContents, int maxEntry = 0xFFFF) {
+void moveCursor(bool right, const DirectoryModel &dirContents, int maxEntry = 0xFFFF) {
 	if ((right && CURPOS >= 39) || (!right && CURPOS <= 0)) {
 		if (!edgeBumpSoundPlayed)
 			snd().playWrong();
@@ -455,8 +570,8 @@ void moveCursor(bool right, const std::vector<DirEntry> dirContents, int maxEntr
 			if (CURPOS + PAGENUM * 40 < (int)dirContents.size()) {
 				if (ms().theme != TWLSettings::EThemeSaturn)
 					currentBg = 1;
-				titleUpdate(dirContents[CURPOS + PAGENUM * 40].isDirectory,
-							dirContents[CURPOS + PAGENUM * 40].name,
+				titleUpdate(dirContents.isDirectory(CURPOS + PAGENUM * 40),
+							dirContents.name(CURPOS + PAGENUM * 40),
 							CURPOS);
 			} else {
 				if (ms().theme != TWLSettings::EThemeSaturn)
@@ -475,8 +590,8 @@ void moveCursor(bool right, const std::vector<DirEntry> dirContents, int maxEntr
 
 		int pos = CURPOS + (right ? 2 : -2);
 		if ((bnrRomType[pos] == 0 || customIcon[pos]) && pos >= 0 && pos + PAGENUM * 40 < (int)dirContents.size()) {
-			iconUpdate(dirContents[pos + PAGENUM * 40].isDirectory,
-						dirContents[pos + PAGENUM * 40].name.c_str(),
+			iconUpdate(dirContents.isDirectory(pos + PAGENUM * 40),
+						dirContents.name(pos + PAGENUM * 40),
 						pos);
 		}
 
@@ -538,6 +653,9 @@ void moveCursor(bool right, const std::vector<DirEntry> dirContents, int maxEntr
 	while (titleboxXdest[ms().secondaryDevice] != titleboxXpos[ms().secondaryDevice] && !(keysHeld() & KEY_TOUCH))
 		swiWaitForVBlank();
 
+	lastCursorLeft = !right;
+	updatePagePrefetch(dirContents);
+
 	if (movingApp == -1 && CURPOS + PAGENUM * 40 < (int)dirContents.size())
 		showSTARTborder = true;
 	edgeBumpSoundPlayed = false;
@@ -545,7 +663,7 @@ void moveCursor(bool right, const std::vector<DirEntry> dirContents, int maxEntr
 	startBorderZoomOut = true;
 }
 
-void updateBoxArt(const std::vector<DirEntry> dirContents) {
+void updateBoxArt(const DirectoryModel &dirContents) {
 	if (CURPOS + PAGENUM * 40 >= ((int)dirContents.size())) return;
 	showSTARTborder = true;
 	if (ms().theme == TWLSettings::EThemeHBL || ms().macroMode || !ms().showBoxArt || boxArtLoaded) return;
@@ -562,9 +680,10 @@ void updateBoxArt(const std::vector<DirEntry> dirContents) {
 		}
 		clearBoxArt();
 		if (dsiFeatures() && ms().showBoxArt == 2) {
+			preloadBoxArt(dirContents, CURPOS); // If it hasn't been yet
 			tex().drawBoxArtFromMem(CURPOS); // Load box art
 		} else {
-			sprintf(boxArtPath, "%s:/_nds/TWiLightMenu/boxart/%s.png", sdFound() ? "sd" : "fat", dirContents.at(CURPOS + PAGENUM * 40).name.c_str());
+			sprintf(boxArtPath, "%s:/_nds/TWiLightMenu/boxart/%s.png", sdFound() ? "sd" : "fat", dirContents.name(CURPOS + PAGENUM * 40));
 			if ((bnrRomType[CURPOS] == 0) && (access(boxArtPath, F_OK) != 0)) {
 				sprintf(boxArtPath, "%s:/_nds/TWiLightMenu/boxart/%s.png", sdFound() ? "sd" : "fat", gameTid[CURPOS]);
 			}
@@ -1170,38 +1289,18 @@ bool donorRomMsg(const char *filename) {
 
 bool checkForCompatibleGame(const char *filename) {
 	bool proceedToLaunch = true;
+	const u32 gameRules = getGameRules(gameTid[CURPOS]);
 
-	if (!dsiFeatures() && ms().secondaryDevice) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(incompatibleGameListB4DS)/sizeof(incompatibleGameListB4DS[0]); i++) {
-			if (memcmp(gameTid[CURPOS], incompatibleGameListB4DS[i], 3) == 0) {
-				// Found match
-				proceedToLaunch = false;
-				break;
-			}
-		}
+	if (!dsiFeatures() && ms().secondaryDevice && (gameRules & GAMERULE_INCOMPATIBLE_B4DS)) {
+		proceedToLaunch = false;
 	}
 
-	if (proceedToLaunch && ms().secondaryDevice) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(incompatibleGameListFC)/sizeof(incompatibleGameListFC[0]); i++) {
-			if (memcmp(gameTid[CURPOS], incompatibleGameListFC[i], 3) == 0) {
-				// Found match
-				proceedToLaunch = false;
-				break;
-			}
-		}
+	if (ms().secondaryDevice && (gameRules & GAMERULE_INCOMPATIBLE_FC)) {
+		proceedToLaunch = false;
 	}
 
-	if (proceedToLaunch) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(incompatibleGameList)/sizeof(incompatibleGameList[0]); i++) {
-			if (memcmp(gameTid[CURPOS], incompatibleGameList[i], 3) == 0) {
-				// Found match
-				proceedToLaunch = false;
-				break;
-			}
-		}
+	if (gameRules & GAMERULE_INCOMPATIBLE) {
+		proceedToLaunch = false;
 	}
 
 	if (proceedToLaunch) return true;	// Game is compatible
@@ -1278,12 +1377,8 @@ bool checkForCompatibleGame(const char *filename) {
 }
 
 bool gameCompatibleMemoryPit(void) {
-	// TODO: If the list gets large enough, switch to bsearch().
-	for (unsigned int i = 0; i < sizeof(incompatibleGameListMemoryPit)/sizeof(incompatibleGameListMemoryPit[0]); i++) {
-		if (memcmp(gameTid[CURPOS], incompatibleGameListMemoryPit[i], 3) == 0) {
-			// Found match
-			return false;
-		}
+	if (getGameRules(gameTid[CURPOS]) & GAMERULE_INCOMPATIBLE_MEMORYPIT) {
+		return false;
 	}
 	return true;
 }
@@ -1401,37 +1496,19 @@ bool dsiWareRAMLimitMsg(std::string filename) {
 	bool showMsg = false;
 	int msgId = 0;
 
+	const u32 gameRules = getGameRules(gameTid[CURPOS]);
 	if (sys().dsDebugRam() || (dsiFeatures() && bs().b4dsMode == 2)) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(compatibleGameListB4DSDebugRAMLimited)/sizeof(compatibleGameListB4DSDebugRAMLimited[0]); i++) {
-			if (memcmp(gameTid[CURPOS], compatibleGameListB4DSDebugRAMLimited[i], 3) == 0) {
-				// Found match
-				showMsg = true;
-				msgId = compatibleGameListB4DSDebugRAMLimitedID[i];
-				break;
-			}
-		}
-	} else {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(compatibleGameListB4DSRAMLimited)/sizeof(compatibleGameListB4DSRAMLimited[0]); i++) {
-			if (memcmp(gameTid[CURPOS], compatibleGameListB4DSRAMLimited[i], 3) == 0) {
-				// Found match
-				showMsg = true;
-				msgId = compatibleGameListB4DSRAMLimitedID[i];
-				break;
-			}
+		if (gameRules & GAMERULE_RAM_LIMITED_B4DS_DEBUG) {
+			showMsg = true;
+			msgId = GAMERULE_RAM_LIMITED_B4DS_DEBUG_MSG(gameRules);
 		}
+	} else if (gameRules & GAMERULE_RAM_LIMITED_B4DS) {
+		showMsg = true;
+		msgId = GAMERULE_RAM_LIMITED_B4DS_MSG(gameRules);
 	}
-	if (!showMsg) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(compatibleGameListB4DSAllRAMLimited)/sizeof(compatibleGameListB4DSAllRAMLimited[0]); i++) {
-			if (memcmp(gameTid[CURPOS], compatibleGameListB4DSAllRAMLimited[i], 3) == 0) {
-				// Found match
-				showMsg = true;
-				msgId = compatibleGameListB4DSAllRAMLimitedID[i];
-				break;
-			}
-		}
+	if (!showMsg && (gameRules & GAMERULE_RAM_LIMITED_ALL)) {
+		showMsg = true;
+		msgId = GAMERULE_RAM_LIMITED_ALL_MSG(gameRules);
 	}
 
 	if (!showMsg || !checkIfShowRAMLimitMsg(filename)) {
@@ -1531,26 +1608,11 @@ bool dsiWareRAMLimitMsg(std::string filename) {
 }
 
 bool dsiWareCompatibleB4DS(void) {
-	bool res = false;
-
-	// TODO: If the list gets large enough, switch to bsearch().
-	for (unsigned int i = 0; i < sizeof(compatibleGameListB4DS)/sizeof(compatibleGameListB4DS[0]); i++) {
-		if (memcmp(gameTid[CURPOS], compatibleGameListB4DS[i], (compatibleGameListB4DS[i][3] != 0 ? 4 : 3)) == 0) {
-			// Found match
-			res = true;
-			break;
-		}
-	}
-	if (!res && (sys().dsDebugRam() || bs().b4dsMode == 2)) {
-		for (unsigned int i = 0; i < sizeof(compatibleGameListB4DSDebug)/sizeof(compatibleGameListB4DSDebug[0]); i++) {
-			if (memcmp(gameTid[CURPOS], compatibleGameListB4DSDebug[i], 3) == 0) {
-				// Found match
-				res = true;
-				break;
-			}
-		}
+	const u32 gameRules = getGameRules(gameTid[CURPOS]);
+	if (gameRules & GAMERULE_DSIWARE_B4DS) {
+		return true;
 	}
-	return res;
+	return (sys().dsDebugRam() || bs().b4dsMode == 2) && (gameRules & GAMERULE_DSIWARE_B4DS_DEBUG);
 }
 
 void cannotLaunchMsg(const char *filename) {
@@ -1776,7 +1838,16 @@ bool selectMenu(void) {
 	return false;
 }
 
-void getFileInfo(SwitchState scrn, vector<vector<DirEntry>> dirContents, bool reSpawnBoxes) {
+void getFileInfo(SwitchState scrn, const vector<DirectoryModel> &dirContents, bool reSpawnBoxes) {
+	const bool pageFlip = (shownPage >= 0 && shownPage != PAGENUM);
+#ifdef PAGE_FLIP_DEBUG
+	const u32 startTime = taskTime();
+	const bool prefetched = (pageFlip && prefetchPage == PAGENUM && prefetchDone);
+#endif
+	if (pageFlip)
+		lastPageStep = (PAGENUM > shownPage) ? 1 : -1;
+	cancelPagePrefetch();
+
 	if (nowLoadingDisplaying) {
 		clearText();
 		showProgressBar = true;
@@ -1785,88 +1856,39 @@ void getFileInfo(SwitchState scrn, vector<vector<DirEntry>> dirContents, bool re
 	}
 	if (reSpawnBoxes)
 		spawnedtitleboxes = 0;
+	getcwd(path, PATH_MAX);
+	openRomInfoCache(path);
+	cancelBoxArtPreload();
+	// Read what's cached for the page's ROMs in one go, not a read for each
+	const char *pageNames[40];
+	int pagePositions[40];
+	int pageNameCount = 0;
+	for (int i = 0; i < 40 && i + PAGENUM * 40 < file_count; i++) {
+		if (!dirContents[scrn].isDirectory(i + PAGENUM * 40)) {
+			pagePositions[pageNameCount] = i;
+			pageNames[pageNameCount++] = dirContents[scrn].name(i + PAGENUM * 40);
+		}
+	}
+	romInfoCache().readPage(pageNames, pageNameCount);
+	// And their per-game settings, in one pass over gamesettings.db
+	GameSettingsRecord pageRecords[GAMESETTINGS_BATCH_MAX];
+	bool pageRecordsFound[GAMESETTINGS_BATCH_MAX];
+	gameSettingsFindBatch((ms().secondaryDevice ? "fat:" : "sd:"), pageNames, pageNameCount, pageRecords, pageRecordsFound);
+	memset(pageGameSettings, 0, sizeof(pageGameSettings));	// Matches no name
+	for (int i = 0; i < pageNameCount; i++)
+		pageGameSettings[pagePositions[i]] = pageRecords[i];
 	for (int i = 0; i < 40; i++) {
 		if (i + PAGENUM * 40 < file_count) {
-			isDirectory[i] = dirContents[scrn][i + PAGENUM * 40].isDirectory;
-			const std::string &std_romsel_filename = dirContents[scrn][i + PAGENUM * 40].name;
-			getGameInfo(isDirectory[i], std_romsel_filename.c_str(), i);
+			isDirectory[i] = dirContents[scrn].isDirectory(i + PAGENUM * 40);
+			const char *std_romsel_filename = dirContents[scrn].name(i + PAGENUM * 40);
+			getGameInfo(isDirectory[i], std_romsel_filename, i);
 
 			if (isDirectory[i]) {
 				bnrWirelessIcon[i] = 0;
 			} else {
-				if (extension(std_romsel_filename, {".nds", ".dsi", ".ids", ".srl", ".app", ".argv"})) {
-					bnrRomType[i] = 0;
-					boxArtType[i] = 0;
-				} else if (extension(std_romsel_filename, {".xex", ".atr", ".a26", ".a52", ".a78"})) {
-					bnrRomType[i] = 10;
-					boxArtType[i] = 0;
-				} else if (extension(std_romsel_filename, {".col"})) {
-					bnrRomType[i] = 13;
-					boxArtType[i] = 0;
-				} else if (extension(std_romsel_filename, {".m5"})) {
-					bnrRomType[i] = 14;
-					boxArtType[i] = 0;
-				} else if (extension(std_romsel_filename, {".int"})) {
-					bnrRomType[i] = 12;
-					boxArtType[i] = 0;
-				} else if (extension(std_romsel_filename, {".plg"})) {
-					bnrRomType[i] = 9;
-					boxArtType[i] = 0;
-				} else if (extension(std_romsel_filename, {".avi", ".rvid", ".fv"})) {
-					bnrRomType[i] = 19;
-					boxArtType[i] = 2;
-				} else if (extension(std_romsel_filename, {".gif", ".bmp", ".png"})) {
-					bnrRomType[i] = 20;
-					boxArtType[i] = -1;
-				} else if (extension(std_romsel_filename, {".agb", ".gba", ".mb"})) {
-					bnrRomType[i] = 1;
-					boxArtType[i] = 1;
-				} else if (extension(std_romsel_filename, {".gb", ".sgb"})) {
-					bnrRomType[i] = 2;
-					boxArtType[i] = 1;
-				} else if (extension(std_romsel_filename, {".gbc"})) {
-					bnrRomType[i] = 3;
-					boxArtType[i] = 1;
-				} else if (extension(std_romsel_filename, {".nes"})) {
-					bnrRomType[i] = 4;
-					boxArtType[i] = 2;
-				} else if (extension(std_romsel_filename, {".fds"})) {
-					bnrRomType[i] = 4;
-					boxArtType[i] = 1;
-				} else if (extension(std_romsel_filename, {".sg"})) {
-					bnrRomType[i] = 15;
-					boxArtType[i] = 2;
-				} else if (extension(std_romsel_filename, {".sms"})) {
-					bnrRomType[i] = 5;
-					boxArtType[i] = 2;
-				} else if (extension(std_romsel_filename, {".gg"})) {
-					bnrRomType[i] = 6;
-					boxArtType[i] = 2;
-				} else if (extension(std_romsel_filename, {".gen"})) {
-					bnrRomType[i] = 7;
-					boxArtType[i] = 2;
-				} else if (extension(std_romsel_filename, {".smc"})) {
-					bnrRomType[i] = 8;
-					boxArtType[i] = 3;
-				} else if (extension(std_romsel_filename, {".sfc"})) {
-					bnrRomType[i] = 8;
-					boxArtType[i] = 2;
-				} else if (extension(std_romsel_filename, {".pce"})) {
-					bnrRomType[i] = 11;
-					boxArtType[i] = 0;
-				} else if (extension(std_romsel_filename, {".ws", ".wsc"})) {
-					bnrRomType[i] = 16;
-					boxArtType[i] = 0;
-				} else if (extension(std_romsel_filename, {".ngp", ".ngc"})) {
-					bnrRomType[i] = 17;
-					boxArtType[i] = 0;
-				} else if (extension(std_romsel_filename, {".dsk"})) {
-					bnrRomType[i] = 18;
-					boxArtType[i] = 0;
-				} else {
-					bnrRomType[i] = 9;
-					boxArtType[i] = -1;
-				}
+				const FileType &fileType = fileTypeOf(std_romsel_filename);
+				bnrRomType[i] = fileType.romType;
+				boxArtType[i] = fileType.boxArtType;
 
 				if (bnrRomType[i] != 0) {
 					bnrWirelessIcon[i] = 0;
@@ -1877,15 +1899,7 @@ void getFileInfo(SwitchState scrn, vector<vector<DirEntry>> dirContents, bool re
 				}
 
 				if (dsiFeatures() && !ms().macroMode && ms().showBoxArt == 2 && ms().theme != TWLSettings::EThemeHBL && !isDirectory[i]) {
-					snprintf(boxArtPath, sizeof(boxArtPath), "%s:/_nds/TWiLightMenu/boxart/%s.png",
-							 sdFound() ? "sd" : "fat",
-							 dirContents[scrn][i + PAGENUM * 40].name.c_str());
-					if ((bnrRomType[i] == 0) && (access(boxArtPath, F_OK) != 0)) {
-						snprintf(boxArtPath, sizeof(boxArtPath), "%s:/_nds/TWiLightMenu/boxart/%s.png",
-								 (sdFound() ? "sd" : "fat"),
-								 gameTid[i]);
-					}
-					tex().loadBoxArtToMem(boxArtPath, i);
+					boxArtPending[i] = true;
 				}
 			}
 			if (reSpawnBoxes)
@@ -1896,6 +1910,22 @@ void getFileInfo(SwitchState scrn, vector<vector<DirEntry>> dirContents, bool re
 			bgOperations(false);
 		}
 	}
+
+	// Nearest the cursor first, one each step, until the page changes
+	boxArtPreloadToken = idleTasks().newToken();
+	const DirectoryModel *pageContents = &dirContents[scrn];
+	idleTasks().add([pageContents]() {
+		for (int distance = 0; distance < 40; distance++) {
+			for (int num : {CURPOS - distance, CURPOS + distance}) {
+				if (num >= 0 && num < 40 && boxArtPending[num]) {
+					preloadBoxArt(*pageContents, num);
+					return false;
+				}
+			}
+		}
+		return true;
+	}, TaskScheduler::PRIORITY_NORMAL, boxArtPreloadToken);
+
 	if (nowLoadingDisplaying) {
 		snd().updateStream();
 		showProgressIcon = false;
@@ -1908,16 +1938,16 @@ void getFileInfo(SwitchState scrn, vector<vector<DirEntry>> dirContents, bool re
 		for (int i = 0; i < 5; i++) {
 			if ((bnrRomType[i] == 0 || customIcon[i]) && i + PAGENUM * 40 < file_count) {
 				bgOperations(true);
-				iconUpdate(dirContents[scrn].at(i + PAGENUM * 40).isDirectory,
-					   dirContents[scrn].at(i + PAGENUM * 40).name.c_str(), i);
+				iconUpdate(dirContents[scrn].isDirectory(i + PAGENUM * 40),
+					   dirContents[scrn].name(i + PAGENUM * 40), i);
 			}
 		}
 	} else if (CURPOS >= 2 && CURPOS <= 36) {
 		for (int i = 0; i < 6; i++) {
 			if ((bnrRomType[i] == 0 || customIcon[CURPOS - 2 + i]) && (CURPOS - 2 + i) + PAGENUM * 40 < file_count) {
 				bgOperations(true);
-				iconUpdate(dirContents[scrn].at((CURPOS - 2 + i) + PAGENUM * 40).isDirectory,
-					   dirContents[scrn].at((CURPOS - 2 + i) + PAGENUM * 40).name.c_str(),
+				iconUpdate(dirContents[scrn].isDirectory((CURPOS - 2 + i) + PAGENUM * 40),
+					   dirContents[scrn].name((CURPOS - 2 + i) + PAGENUM * 40),
 					   CURPOS - 2 + i);
 			}
 		}
@@ -1925,14 +1955,37 @@ void getFileInfo(SwitchState scrn, vector<vector<DirEntry>> dirContents, bool re
 		for (int i = 0; i < 5; i++) {
 			if ((bnrRomType[i] == 0 || customIcon[35 + i]) && (35 + i) + PAGENUM * 40 < file_count) {
 				bgOperations(true);
-				iconUpdate(dirContents[scrn].at((35 + i) + PAGENUM * 40).isDirectory,
-					   dirContents[scrn].at((35 + i) + PAGENUM * 40).name.c_str(), 35 + i);
+				iconUpdate(dirContents[scrn].isDirectory((35 + i) + PAGENUM * 40),
+					   dirContents[scrn].name((35 + i) + PAGENUM * 40), 35 + i);
 			}
 		}
 	}
+
+	shownPage = PAGENUM;
+#ifdef PAGE_FLIP_DEBUG
+	if (pageFlip) {
+		const u32 ticks = taskTime() - startTime;
+		pageFlipStats.flips++;
+		pageFlipStats.ticks += ticks;
+		if (prefetched) {
+			pageFlipStats.prefetchedFlips++;
+			pageFlipStats.prefetchedTicks += ticks;
+		}
+
+		const u32 otherFlips = pageFlipStats.flips - pageFlipStats.prefetchedFlips;
+		char message[128];
+		snprintf(message, sizeof(message), "Page flip: %luus%s. %lu of %lu prefetched, avg %luus, others avg %luus",
+				 ticks / (BUS_CLOCK / 1000000), (prefetched ? " (prefetched)" : ""),
+				 pageFlipStats.prefetchedFlips, pageFlipStats.flips,
+				 (u32)(pageFlipStats.prefetchedFlips ? pageFlipStats.prefetchedTicks / pageFlipStats.prefetchedFlips / (BUS_CLOCK / 1000000) : 0),
+				 (u32)(otherFlips ? (pageFlipStats.ticks - pageFlipStats.prefetchedTicks) / otherFlips / (BUS_CLOCK / 1000000) : 0));
+		nocashMessage(message);
+	}
+#endif
+	updatePagePrefetch(dirContents[scrn]);
 }
 
-static bool previousPage(SwitchState scrn, vector<vector<DirEntry>> dirContents) {
+static bool previousPage(SwitchState scrn, const vector<DirectoryModel> &dirContents) {
 	if (CURPOS == 0 && !showLshoulder) {
 		snd().playWrong();
 		return false;
@@ -1972,16 +2025,16 @@ static bool previousPage(SwitchState scrn, vector<vector<DirEntry>> dirContents)
 			for (int i = 0; i < 5; i++) {
 				if ((bnrRomType[i] == 0 || customIcon[i]) && i + PAGENUM * 40 < file_count) {
 					bgOperations(true);
-					iconUpdate(dirContents[scrn].at(i + PAGENUM * 40).isDirectory,
-						   dirContents[scrn].at(i + PAGENUM * 40).name.c_str(), i);
+					iconUpdate(dirContents[scrn].isDirectory(i + PAGENUM * 40),
+						   dirContents[scrn].name(i + PAGENUM * 40), i);
 				}
 			}
 		} else if (CURPOS >= 2 && CURPOS <= 36) {
 			for (int i = 0; i < 6; i++) {
 				if ((bnrRomType[i] == 0 || customIcon[CURPOS - 2 + i]) && (CURPOS - 2 + i) + PAGENUM * 40 < file_count) {
 					bgOperations(true);
-					iconUpdate(dirContents[scrn].at((CURPOS - 2 + i) + PAGENUM * 40).isDirectory,
-						   dirContents[scrn].at((CURPOS - 2 + i) + PAGENUM * 40).name.c_str(),
+					iconUpdate(dirContents[scrn].isDirectory((CURPOS - 2 + i) + PAGENUM * 40),
+						   dirContents[scrn].name((CURPOS - 2 + i) + PAGENUM * 40),
 						   CURPOS - 2 + i);
 				}
 			}
@@ -1989,8 +2042,8 @@ static bool previousPage(SwitchState scrn, vector<vector<DirEntry>> dirContents)
 			for (int i = 0; i < 5; i++) {
 				if ((bnrRomType[i] == 0 || customIcon[35 + i]) && (35 + i) + PAGENUM * 40 < file_count) {
 					bgOperations(true);
-					iconUpdate(dirContents[scrn].at((35 + i) + PAGENUM * 40).isDirectory,
-						   dirContents[scrn].at((35 + i) + PAGENUM * 40).name.c_str(), 35 + i);
+					iconUpdate(dirContents[scrn].isDirectory((35 + i) + PAGENUM * 40),
+						   dirContents[scrn].name((35 + i) + PAGENUM * 40), 35 + i);
 				}
 			}
 		}
@@ -2000,7 +2053,7 @@ static bool previousPage(SwitchState scrn, vector<vector<DirEntry>> dirContents)
 	return showLshoulder;
 }
 
-static bool nextPage(SwitchState scrn, vector<vector<DirEntry>> dirContents) {
+static bool nextPage(SwitchState scrn, const vector<DirectoryModel> &dirContents) {
 	if (CURPOS == (file_count - 1) - PAGENUM * 40 && !showRshoulder) {
 		snd().playWrong();
 		return false;
@@ -2046,16 +2099,16 @@ static bool nextPage(SwitchState scrn, vector<vector<DirEntry>> dirContents) {
 			for (int i = 0; i < 5; i++) {
 				if ((bnrRomType[i] == 0 || customIcon[i]) && i + PAGENUM * 40 < file_count) {
 					bgOperations(true);
-					iconUpdate(dirContents[scrn].at(i + PAGENUM * 40).isDirectory,
-						   dirContents[scrn].at(i + PAGENUM * 40).name.c_str(), i);
+					iconUpdate(dirContents[scrn].isDirectory(i + PAGENUM * 40),
+						   dirContents[scrn].name(i + PAGENUM * 40), i);
 				}
 			}
 		} else if (CURPOS >= 2 && CURPOS <= 36) {
 			for (int i = 0; i < 6; i++) {
 				if ((bnrRomType[i] == 0 || customIcon[CURPOS - 2 + i]) && (CURPOS - 2 + i) + PAGENUM * 40 < file_count) {
 					bgOperations(true);
-					iconUpdate(dirContents[scrn].at((CURPOS - 2 + i) + PAGENUM * 40).isDirectory,
-						   dirContents[scrn].at((CURPOS - 2 + i) + PAGENUM * 40).name.c_str(),
+					iconUpdate(dirContents[scrn].isDirectory((CURPOS - 2 + i) + PAGENUM * 40),
+						   dirContents[scrn].name((CURPOS - 2 + i) + PAGENUM * 40),
 						   CURPOS - 2 + i);
 				}
 			}
@@ -2063,8 +2116,8 @@ static bool nextPage(SwitchState scrn, vector<vector<DirEntry>> dirContents) {
 			for (int i = 0; i < 5; i++) {
 				if ((bnrRomType[i] == 0 || customIcon[35 + i]) && (35 + i) + PAGENUM * 40 < file_count) {
 					bgOperations(true);
-					iconUpdate(dirContents[scrn].at((35 + i) + PAGENUM * 40).isDirectory,
-						   dirContents[scrn].at((35 + i) + PAGENUM * 40).name.c_str(), 35 + i);
+					iconUpdate(dirContents[scrn].isDirectory((35 + i) + PAGENUM * 40),
+						   dirContents[scrn].name((35 + i) + PAGENUM * 40), 35 + i);
 				}
 			}
 		}
@@ -2074,20 +2127,150 @@ static bool nextPage(SwitchState scrn, vector<vector<DirEntry>> dirContents) {
 	return showRshoulder;
 }
 
+/**
+ * Find a file by part of its name or banner title, narrowing the results as
+ * each letter is entered, and move the cursor to the one chosen.
+ * @return true if a file was chosen, so its page has to be loaded.
+ */
+static bool searchFiles(SwitchState scrn, const vector<DirectoryModel> &dirContents) {
+	// Accented letters are found by typing them without the accent, as the index keeps them that way
+	static const char letters[] = " abcdefghijklmnopqrstuvwxyz0123456789";
+	const int letterCount = sizeof(letters) - 1;
+	const int maxResults = 4;
+
+	titleIndex().sync(dirContents[scrn]);
+
+	snd().playSelect();
+	bannerTextShown = false;
+	clearText();
+	updateText(false);
+	if (ms().theme != TWLSettings::EThemeSaturn) {
+		dbox_showIcon = false;
+		showdialogbox = true;
+		while (!dboxStopped) { bgOperations(true); }
+	}
+
+	std::string query;
+	std::vector<int> results;
+	size_t found = 0;
+	int selected = 0;
+	int pressed = 0;
+	int textYpos = (ms().theme == TWLSettings::EThemeSaturn ? 8 : 16);
+	while (1) {
+		clearText();
+		printSmall(false, 0, textYpos, STR_SEARCH, Alignment::center, FontPalette::dialog);
+		printSmall(false, 0, textYpos + 18, query + "_", Alignment::center, FontPalette::dialog);
+		if (!query.empty()) {
+			char text[32];
+			snprintf(text, sizeof(text), STR_SEARCH_FOUND.c_str(), (int)found);
+			printSmall(false, 0, textYpos + 34, text, Alignment::center, FontPalette::dialog);
+		}
+		for (int i = 0; i < (int)results.size(); i++) {
+			std::string name = dirContents[scrn].name(results[i]);
+			while (calcSmallFontWidth(name) > 200) {
+				// Not leaving part of a UTF-8 character
+				do {
+					name.pop_back();
+				} while ((name.back() & 0xC0) == 0x80);
+				if ((u8)name.back() >= 0xC0)
+					name.pop_back();
+			}
+			printSmall(false, 0, textYpos + 54 + (i * 16), (i == selected) ? ("> " + name + " <") : name, Alignment::center, FontPalette::dialog);
+		}
+		printSmall(false, 0, (ms().theme == TWLSettings::EThemeSaturn ? 150 : 144), STR_SEARCH_CONTROLS, Alignment::center, FontPalette::dialog);
+		updateText(false);
+
+		do {
+			scanKeys();
+			pressed = keysDownRepeat();
+			bgOperations(true);
+		} while (!pressed);
+
+		bool queryChanged = false;
+		if (pressed & (KEY_UP | KEY_DOWN)) {
+			// Cycle the last letter, starting from a space if there isn't one
+			if (query.empty())
+				query += ' ';
+			int letter = strchr(letters, query.back()) - letters;
+			letter = (letter + ((pressed & KEY_UP) ? 1 : letterCount - 1)) % letterCount;
+			query.back() = letters[letter];
+			queryChanged = true;
+		} else if ((pressed & KEY_RIGHT) && !query.empty() && query.length() < 24) {
+			query += 'a';
+			queryChanged = true;
+		} else if (pressed & (KEY_B | KEY_LEFT)) {
+			if (query.empty()) {
+				snd().playBack();
+				break;
+			}
+			query.pop_back();
+			queryChanged = true;
+		} else if ((pressed & KEY_L) && selected > 0) {
+			snd().playSelect();
+			selected--;
+		} else if ((pressed & KEY_R) && selected < (int)results.size() - 1) {
+			snd().playSelect();
+			selected++;
+		} else if (pressed & KEY_A) {
+			if (results.empty()) {
+				snd().playWrong();
+				continue;
+			}
+
+			snd().playSwitch();
+			clearText();
+			updateText(false);
+			showdialogbox = false;
+			if (ms().theme != TWLSettings::EThemeSaturn && ms().theme != TWLSettings::EThemeHBL) {
+				fadeType = false; // Fade to white
+				for (int i = 0; i < 6; i++) {
+					bgOperations(true);
+				}
+				whiteScreen = true;
+			}
+			PAGENUM = results[selected] / 40;
+			CURPOS = results[selected] % 40;
+			titleboxXdest[ms().secondaryDevice] = CURPOS * titleboxXspacing;
+			titlewindowXdest[ms().secondaryDevice] = CURPOS * 5;
+			if (ms().showBoxArt)
+				clearBoxArt(); // Clear box art
+			boxArtLoaded = false;
+			rocketVideo_playVideo = true;
+			shouldersRendered = false;
+			currentBg = 0;
+			showSTARTborder = false;
+			stopSoundPlayed = false;
+			ms().saveSettings();
+			settingsChanged = false;
+			displayNowLoading();
+			return true;
+		}
+
+		if (queryChanged) {
+			snd().playSelect();
+			found = titleIndex().search(query.c_str(), results, maxResults);
+			selected = 0;
+		}
+	}
+
+	clearText();
+	updateText(false);
+	showdialogbox = false;
+	return false;
+}
+
 std::string browseForFile(const std::vector<std::string_view> extensionList) {
 	snd().updateStream();
 	displayNowLoading();
 	snd().updateStream();
 	gameOrderIniPath = std::string(sdFound() ? "sd" : "fat") + ":/_nds/TWiLightMenu/extras/gameorder.ini";
-	recentlyPlayedIniPath = std::string(sdFound() ? "sd" : "fat") + ":/_nds/TWiLightMenu/extras/recentlyplayed.ini";
-	timesPlayedIniPath = std::string(sdFound() ? "sd" : "fat") + ":/_nds/TWiLightMenu/extras/timesplayed.ini";
 
 	bool displayBoxArt = ms().showBoxArt;
 
 	int pressed = 0;
 	int held = 0;
 	SwitchState scrn(3);
-	vector<vector<DirEntry>> dirContents(scrn.SIZE);
+	vector<DirectoryModel> dirContents(scrn.SIZE);
 
 	getDirectoryContents(dirContents[scrn], extensionList);
 
@@ -2163,8 +2346,8 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 					currentBg = (ms().theme == TWLSettings::EThemeSaturn ? 0 : 1), displayBoxArt = ms().showBoxArt;
 					if (!bannerTextShown) {
 						clearText();
-						titleUpdate(dirContents[scrn].at(CURPOS + PAGENUM * 40).isDirectory,
-								dirContents[scrn].at(CURPOS + PAGENUM * 40).name, CURPOS);
+						titleUpdate(dirContents[scrn].isDirectory(CURPOS + PAGENUM * 40),
+								dirContents[scrn].name(CURPOS + PAGENUM * 40), CURPOS);
 						bannerTextShown = true;
 					}
 				} else {
@@ -2212,15 +2395,15 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 				titleboxXspacing = 76;
 				titleboxXdest[ms().secondaryDevice] = titleboxXpos[ms().secondaryDevice] = CURPOS * titleboxXspacing;
 
-				if (dirContents[scrn][movingApp].isDirectory)
+				if (dirContents[scrn].isDirectory(movingApp))
 					movingAppIsDir = true;
 				else
 					movingAppIsDir = false;
 
-				getGameInfo(dirContents[scrn][movingApp].isDirectory,
-							dirContents[scrn][movingApp].name.c_str(), -1);
-				iconUpdate(dirContents[scrn][movingApp].isDirectory,
-						   dirContents[scrn][movingApp].name.c_str(), -1);
+				getGameInfo(dirContents[scrn].isDirectory(movingApp),
+							dirContents[scrn].name(movingApp), -1);
+				iconUpdate(dirContents[scrn].isDirectory(movingApp),
+						   dirContents[scrn].name(movingApp), -1);
 
 				int movingAppYmax = ms().theme == TWLSettings::ETheme3DS ? 64 : 82;
 				while (movingAppYpos < movingAppYmax) {
@@ -2340,13 +2523,11 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 
 					int dest = CURPOS + (PAGENUM * 40);
 
-					DirEntry entry = dirContents[scrn][movingApp];
-					dirContents[scrn].erase(dirContents[scrn].begin() + movingApp);
-					dirContents[scrn].insert(dirContents[scrn].begin() + dest, entry);
+					dirContents[scrn].move(movingApp, dest);
 
 					std::vector<std::string> dirNames(dirContents[scrn].size());
 					for (uint i=0;i<dirContents[scrn].size();i++) {
-						dirNames[i] = dirContents[scrn][i].name;
+						dirNames[i] = dirContents[scrn].name(i);
 					}
 
 					CIniFile gameOrderIni(gameOrderIniPath);
@@ -2395,8 +2576,8 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 						for (int i = 0; i < 6; i++) {
 							int pos = (CURPOS - 2 + i);
 							if ((bnrRomType[pos] == 0 || customIcon[pos]) && pos >= 0 && pos + PAGENUM * 40 < file_count) {
-								iconUpdate(dirContents[scrn][pos + PAGENUM * 40].isDirectory,
-										dirContents[scrn][pos + PAGENUM * 40].name.c_str(),
+								iconUpdate(dirContents[scrn].isDirectory(pos + PAGENUM * 40),
+										dirContents[scrn].name(pos + PAGENUM * 40),
 										pos);
 							}
 						}
@@ -2405,8 +2586,8 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 					if (CURPOS + PAGENUM * 40 < ((int)dirContents[scrn].size())) {
 						currentBg = 1;
 						clearText();
-						titleUpdate(dirContents[scrn][CURPOS + PAGENUM * 40].isDirectory,
-									dirContents[scrn][CURPOS + PAGENUM * 40].name,
+						titleUpdate(dirContents[scrn].isDirectory(CURPOS + PAGENUM * 40),
+									dirContents[scrn].name(CURPOS + PAGENUM * 40),
 									CURPOS);
 						bannerTextShown = true;
 						updateText(false);
@@ -2471,8 +2652,8 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 						for (int i = 0; i < 6; i++) {
 							int pos = (CURPOS - 2 + i);
 							if ((bnrRomType[pos] == 0 || customIcon[pos]) && pos >= 0 && pos + PAGENUM * 40 < file_count) {
-								iconUpdate(dirContents[scrn][pos + PAGENUM * 40].isDirectory,
-										dirContents[scrn][pos + PAGENUM * 40].name.c_str(),
+								iconUpdate(dirContents[scrn].isDirectory(pos + PAGENUM * 40),
+										dirContents[scrn].name(pos + PAGENUM * 40),
 										pos);
 							}
 						}
@@ -2515,8 +2696,8 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 									for (int i = 0; i < 6; i++) {
 										int pos = (CURPOS - 2 + i);
 										if ((bnrRomType[pos] == 0 || customIcon[pos]) && pos >= 0 && pos + PAGENUM * 40 < file_count) {
-											iconUpdate(dirContents[scrn][pos + PAGENUM * 40].isDirectory,
-													dirContents[scrn][pos + PAGENUM * 40].name.c_str(),
+											iconUpdate(dirContents[scrn].isDirectory(pos + PAGENUM * 40),
+													dirContents[scrn].name(pos + PAGENUM * 40),
 													pos);
 										}
 									}
@@ -2524,8 +2705,8 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 									clearText();
 									if (CURPOS + PAGENUM * 40 < ((int)dirContents[scrn].size()) && boxDest > -28 && boxDest < titleboxXspacing * 39 + 28) {
 										currentBg = 1;
-										titleUpdate(dirContents[scrn][CURPOS + PAGENUM * 40].isDirectory,
-													dirContents[scrn][CURPOS + PAGENUM * 40].name,
+										titleUpdate(dirContents[scrn].isDirectory(CURPOS + PAGENUM * 40),
+													dirContents[scrn].name(CURPOS + PAGENUM * 40),
 													CURPOS);
 									} else {
 										currentBg = 0;
@@ -2567,8 +2748,8 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 							for (int i = 0; i < 6; i++) {
 								int pos = (CURPOS - 2 + i);
 								if ((bnrRomType[pos] == 0 || customIcon[pos]) && pos >= 0 && pos + PAGENUM * 40 < file_count) {
-									iconUpdate(dirContents[scrn][pos + PAGENUM * 40].isDirectory,
-											dirContents[scrn][pos + PAGENUM * 40].name.c_str(),
+									iconUpdate(dirContents[scrn].isDirectory(pos + PAGENUM * 40),
+											dirContents[scrn].name(pos + PAGENUM * 40),
 											pos);
 								}
 							}
@@ -2577,8 +2758,8 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 						clearText();
 						if (CURPOS + PAGENUM * 40 < ((int)dirContents[scrn].size()) && titleboxXdest[ms().secondaryDevice] > -28 && titleboxXdest[ms().secondaryDevice] < titleboxXspacing * 39 + 28) {
 							currentBg = 1;
-							titleUpdate(dirContents[scrn][CURPOS + PAGENUM * 40].isDirectory,
-										dirContents[scrn][CURPOS + PAGENUM * 40].name,
+							titleUpdate(dirContents[scrn].isDirectory(CURPOS + PAGENUM * 40),
+										dirContents[scrn].name(CURPOS + PAGENUM * 40),
 										CURPOS);
 						} else {
 							currentBg = 0;
@@ -2619,8 +2800,8 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 			// Startup...
 			if ((((pressed & KEY_A) || (pressed & KEY_START)) && bannerTextShown && showSTARTborder) || (gameTapped)) {
 				bannerTextShown = false; // Redraw title when done
-				DirEntry *entry = &dirContents[scrn].at(CURPOS + PAGENUM * 40);
-				if (entry->isDirectory) {
+				const std::string entryName = dirContents[scrn].name(CURPOS + PAGENUM * 40);
+				if (dirContents[scrn].isDirectory(CURPOS + PAGENUM * 40)) {
 					// Enter selected directory
 					(ms().theme == TWLSettings::EThemeSaturn) ? snd().playLaunch() : snd().playSelect();
 					if (ms().theme != TWLSettings::EThemeSaturn && ms().theme != TWLSettings::EThemeHBL) {
@@ -2643,7 +2824,7 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 					stopSoundPlayed = false;
 					clearText();
 					updateText(false);
-					chdir(entry->name.c_str());
+					chdir(entryName.c_str());
 					char buf[256];
 					ms().romfolder[ms().secondaryDevice] = std::string(getcwd(buf, 256));
 					ms().saveSettings();
@@ -2651,29 +2832,29 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 					return "null";
 				} else if (isTwlm[CURPOS] || (isDSiWare[CURPOS] && ((((!dsiFeatures() && (!sdFound() || !ms().dsiWareToSD)) || bs().b4dsMode) && ms().secondaryDevice && !dsiWareCompatibleB4DS())
 				|| (isDSiMode() && memcmp(io_dldi_data->friendlyName, "CycloDS iEvolution", 18) != 0 && sys().arm7SCFGLocked() && !sys().dsiWramAccess() && !gameCompatibleMemoryPit())))) {
-					cannotLaunchMsg(dirContents[scrn].at(CURPOS + PAGENUM * 40).name.c_str());
+					cannotLaunchMsg(dirContents[scrn].name(CURPOS + PAGENUM * 40));
 				} else {
-					loadPerGameSettings(dirContents[scrn].at(CURPOS + PAGENUM * 40).name);
+					loadPerGameSettings(dirContents[scrn].name(CURPOS + PAGENUM * 40));
 					int hasAP = 0;
 					bool proceedToLaunch = true;
 					bool useBootstrapAnyway = ((perGameSettings_useBootstrap == -1 ? ms().useBootstrap : perGameSettings_useBootstrap) || !ms().secondaryDevice);
 					if (useBootstrapAnyway && bnrRomType[CURPOS] == 0 && !isDSiWare[CURPOS]
 					 && isHomebrew[CURPOS] == 0
-					 && checkIfDSiMode(dirContents[scrn].at(CURPOS + PAGENUM * 40).name)) {
+					 && checkIfDSiMode(dirContents[scrn].name(CURPOS + PAGENUM * 40))) {
 						bool hasDsiBinaries = true;
 						if (dsiFeatures() && (!ms().secondaryDevice || !bs().b4dsMode)) {
 							FILE *f_nds_file = fopen(
-								dirContents[scrn].at(CURPOS + PAGENUM * 40).name.c_str(), "rb");
+								dirContents[scrn].name(CURPOS + PAGENUM * 40), "rb");
 							hasDsiBinaries = checkDsiBinaries(f_nds_file);
 							fclose(f_nds_file);
 						}
 
 						if (!hasDsiBinaries) {
-							proceedToLaunch = dsiBinariesMissingMsg(dirContents[scrn].at(CURPOS + PAGENUM * 40).name.c_str());
+							proceedToLaunch = dsiBinariesMissingMsg(dirContents[scrn].name(CURPOS + PAGENUM * 40));
 						}
 					}
 					if (proceedToLaunch && (useBootstrapAnyway || ((!dsiFeatures() || bs().b4dsMode) && isDSiWare[CURPOS])) && bnrRomType[CURPOS] == 0 && !dsModeForced && isHomebrew[CURPOS] == 0) {
-						proceedToLaunch = checkForCompatibleGame(dirContents[scrn].at(CURPOS + PAGENUM * 40).name.c_str());
+						proceedToLaunch = checkForCompatibleGame(dirContents[scrn].name(CURPOS + PAGENUM * 40));
 						if (proceedToLaunch && requiresDonorRom[CURPOS]) {
 							const char* pathDefine = "DONORTWL_NDS_PATH"; // SDK5.x
 							if (requiresDonorRom[CURPOS] == 52) {
@@ -2702,32 +2883,32 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 							&& (requiresDonorRom[CURPOS] == 51 || requiresDonorRom[CURPOS] == 151
 							|| (requiresDonorRom[CURPOS] == 52 && (isDSiWare[CURPOS] || bstrap_dsiMode > 0)) || requiresDonorRom[CURPOS] == 152)
 							) {
-								proceedToLaunch = donorRomMsg(dirContents[scrn].at(CURPOS + PAGENUM * 40).name.c_str());
+								proceedToLaunch = donorRomMsg(dirContents[scrn].name(CURPOS + PAGENUM * 40));
 							}
 						}
-						if (proceedToLaunch && !isDSiWare[CURPOS] && checkIfShowAPMsg(dirContents[scrn].at(CURPOS + PAGENUM * 40).name)) {
+						if (proceedToLaunch && !isDSiWare[CURPOS] && checkIfShowAPMsg(dirContents[scrn].name(CURPOS + PAGENUM * 40))) {
 							FILE *f_nds_file = fopen(
-								dirContents[scrn].at(CURPOS + PAGENUM * 40).name.c_str(), "rb");
+								dirContents[scrn].name(CURPOS + PAGENUM * 40), "rb");
 							hasAP = checkRomAP(f_nds_file, CURPOS);
 							fclose(f_nds_file);
 						}
 						if (proceedToLaunch && isDSiWare[CURPOS] && (!dsiFeatures() || bs().b4dsMode) && ms().secondaryDevice) {
 							if (!dsiFeatures() && !sys().isRegularDS()) {
-								proceedToLaunch = dsiWareInDSModeMsg(dirContents[scrn].at(CURPOS + PAGENUM * 40).name);
+								proceedToLaunch = dsiWareInDSModeMsg(dirContents[scrn].name(CURPOS + PAGENUM * 40));
 							}
 							if (proceedToLaunch) {
-								proceedToLaunch = dsiWareRAMLimitMsg(dirContents[scrn].at(CURPOS + PAGENUM * 40).name);
+								proceedToLaunch = dsiWareRAMLimitMsg(dirContents[scrn].name(CURPOS + PAGENUM * 40));
 							}
 						}
 					} else if (isHomebrew[CURPOS] == 1) {
-						loadPerGameSettings(dirContents[scrn].at(CURPOS + PAGENUM * 40).name);
+						loadPerGameSettings(dirContents[scrn].name(CURPOS + PAGENUM * 40));
 						if (requiresRamDisk[CURPOS] && perGameSettings_ramDiskNo == -1) {
 							proceedToLaunch = false;
-							ramDiskMsg(dirContents[scrn].at(CURPOS + PAGENUM * 40).name.c_str());
+							ramDiskMsg(dirContents[scrn].name(CURPOS + PAGENUM * 40));
 						}
 					} else if (bnrRomType[CURPOS] == 7) {
 						if (ms().mdEmulator == TWLSettings::EMegaDriveJenesis && getFileSize(
-							dirContents[scrn].at(CURPOS + PAGENUM * 40).name.c_str()) >
+							dirContents[scrn].name(CURPOS + PAGENUM * 40)) >
 							0x300000) {
 							proceedToLaunch = false;
 							mdRomTooBig();
@@ -2735,7 +2916,7 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 					} else if ((bnrRomType[CURPOS] == 8 || (bnrRomType[CURPOS] == 11 && ms().smsGgInRam))
 							&& isDSiMode() && memcmp(io_dldi_data->friendlyName, "CycloDS iEvolution", 18) != 0 && sys().arm7SCFGLocked()) {
 						proceedToLaunch = false;
-						cannotLaunchMsg(dirContents[scrn].at(CURPOS + PAGENUM * 40).name.c_str());
+						cannotLaunchMsg(dirContents[scrn].name(CURPOS + PAGENUM * 40));
 					}
 					if (hasAP > 0) {
 						if (ms().theme == TWLSettings::EThemeSaturn) {
@@ -2760,8 +2941,8 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 						} else {
 							for (int i = 0; i < 30; i++) { snd().updateStream(); swiWaitForVBlank(); }
 						}
-						titleUpdate(dirContents[scrn].at(CURPOS + PAGENUM * 40).isDirectory,
-								dirContents[scrn].at(CURPOS + PAGENUM * 40).name,
+						titleUpdate(dirContents[scrn].isDirectory(CURPOS + PAGENUM * 40),
+								dirContents[scrn].name(CURPOS + PAGENUM * 40),
 								CURPOS);
 						if (hasAP == 2) {
 							printSmall(false, 0, 80, STR_AP_PATCH_RGF, Alignment::center, FontPalette::dialog);
@@ -2785,7 +2966,7 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 								break;
 							} else if (pressed & KEY_X) {
 								dontShowAPMsgAgain(
-									dirContents[scrn].at(CURPOS + PAGENUM * 40).name);
+									dirContents[scrn].name(CURPOS + PAGENUM * 40));
 								pressed = 0;
 								break;
 							}
@@ -2938,28 +3119,10 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 							printSmall(false, 0, 20, STR_IF_CRASH_DISABLE_RECENT, Alignment::center);
 							updateText(false);
 
-							mkdir(sdFound() ? "sd:/_nds/TWiLightMenu/extras" : "fat:/_nds/TWiLightMenu/extras",
-						  0777);
-
-							CIniFile recentlyPlayedIni(recentlyPlayedIniPath);
-							std::vector<std::string> recentlyPlayed;
-
 							getcwd(path, PATH_MAX);
-							recentlyPlayedIni.GetStringVector("RECENT", path, recentlyPlayed, ':'); // : isn't allowed in FAT-32 names, so its a good deliminator
-
-							std::vector<std::string>::iterator it = std::find(recentlyPlayed.begin(), recentlyPlayed.end(), entry->name);
-							if (it != recentlyPlayed.end()) {
-								recentlyPlayed.erase(it);
-							}
-
-							recentlyPlayed.insert(recentlyPlayed.begin(), entry->name);
-
-							recentlyPlayedIni.SetStringVector("RECENT", path, recentlyPlayed, ':');
-							recentlyPlayedIni.SaveIniFile(recentlyPlayedIniPath);
-
-							CIniFile timesPlayedIni(timesPlayedIniPath);
-							timesPlayedIni.SetInt(path, entry->name, (timesPlayedIni.GetInt(path, entry->name, 0) + 1));
-							timesPlayedIni.SaveIniFile(timesPlayedIniPath);
+							playStats.openDir(path);
+							playStats.addPlay(entryName.c_str());
+							titleIndex().flush();
 
 							if (ms().theme == TWLSettings::EThemeHBL) {
 								displayGameIcons = true;
@@ -2970,7 +3133,7 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 						}
 
 						// Return the chosen file
-						return entry->name;
+						return entryName;
 					}
 				}
 			}
@@ -3091,9 +3254,9 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 			}
 
 			if ((pressed & KEY_X) && !ms().preventDeletion && bannerTextShown && showSTARTborder
-			&& dirContents[scrn].at(CURPOS + PAGENUM * 40).name != "..") {
-				DirEntry *entry = &dirContents[scrn].at((PAGENUM * 40) + (CURPOS));
-				bool unHide = (FAT_getAttr(entry->name.c_str()) & ATTR_HIDDEN || (strncmp(entry->name.c_str(), ".", 1) == 0 && entry->name != ".."));
+			&& strcmp(dirContents[scrn].name(CURPOS + PAGENUM * 40), "..") != 0) {
+				const std::string entryName = dirContents[scrn].name((PAGENUM * 40) + (CURPOS));
+				bool unHide = (FAT_getAttr(entryName.c_str()) & ATTR_HIDDEN || (strncmp(entryName.c_str(), ".", 1) == 0 && entryName != ".."));
 				if (ms().theme == TWLSettings::EThemeSaturn) {
 					snd().playStartup();
 					fadeType = false;	   // Fade to black
@@ -3117,9 +3280,9 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 				}
 				snprintf(fileCounter, sizeof(fileCounter), "%i/%i", (CURPOS + 1) + PAGENUM * 40,
 					 file_count);
-				titleUpdate(dirContents[scrn].at(CURPOS + PAGENUM * 40).isDirectory,
-						dirContents[scrn].at(CURPOS + PAGENUM * 40).name, CURPOS);
-				dirContName = dirContents[scrn].at(CURPOS + PAGENUM * 40).name;
+				titleUpdate(dirContents[scrn].isDirectory(CURPOS + PAGENUM * 40),
+						dirContents[scrn].name(CURPOS + PAGENUM * 40), CURPOS);
+				dirContName = dirContents[scrn].name(CURPOS + PAGENUM * 40);
 				// About 38 characters fit in the box.
 				if (strlen(dirContName.c_str()) > 38) {
 					// Truncate to 35, 35 + 3 = 38 (because we append "...").
@@ -3173,9 +3336,7 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 							}
 							whiteScreen = true;
 						}
-						remove(dirContents[scrn]
-							   .at(CURPOS + PAGENUM * 40)
-							   .name.c_str()); // Remove game/folder
+						remove(dirContents[scrn].name(CURPOS + PAGENUM * 40)); // Remove game/folder
 						if (ms().showBoxArt)
 							clearBoxArt(); // Clear box art
 						boxArtLoaded = false;
@@ -3210,10 +3371,10 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 						}
 
 						// Remove leading . if it exists
-						if ((strncmp(entry->name.c_str(), ".", 1) == 0 && entry->name != "..")) {
-							rename(entry->name.c_str(), entry->name.substr(1).c_str());
+						if ((strncmp(entryName.c_str(), ".", 1) == 0 && entryName != "..")) {
+							rename(entryName.c_str(), entryName.substr(1).c_str());
 						} else { // Otherwise toggle the hidden attribute bit
-							FAT_setAttr(entry->name.c_str(), FAT_getAttr(entry->name.c_str()) ^ ATTR_HIDDEN);
+							FAT_setAttr(entryName.c_str(), FAT_getAttr(entryName.c_str()) ^ ATTR_HIDDEN);
 						}
 
 						if (ms().showBoxArt)
@@ -3259,7 +3420,7 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 
 			if ((pressed & KEY_Y) && !isTwlm[CURPOS] && !isDirectory[CURPOS] &&
 				(bnrRomType[CURPOS] == 0) && bannerTextShown && showSTARTborder) {
-				perGameSettings(dirContents[scrn].at(CURPOS + PAGENUM * 40).name);
+				perGameSettings(dirContents[scrn].name(CURPOS + PAGENUM * 40));
 				bannerTextShown = false;
 			}
 
@@ -3286,6 +3447,13 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 							break2 = true;
 							break;
 						}
+					} else if ((pressed & KEY_Y) && !dirInfoIniFound) {
+						runSelectMenu = false;
+						if (searchFiles(scrn, dirContents)) {
+							break2 = true;
+							break;
+						}
+						held = keysHeld();
 					}
 
 					if (ms().theme == TWLSettings::EThemeDSi || ms().theme == TWLSettings::EThemeSaturn || ms().theme == TWLSettings::EThemeHBL) {
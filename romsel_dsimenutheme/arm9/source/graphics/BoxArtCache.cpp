@@ -0,0 +1,93 @@
+#include "BoxArtCache.h"
+#include <string.h>
+
+BoxArtCache::BoxArtCache()
+	: _memory(NULL), _capacity(0), _used(0), _clock(0), _hits(0), _misses(0), _evictions(0) {
+}
+
+void BoxArtCache::init(u8 *memory, u32 capacity) {
+	_memory = memory;
+	_capacity = capacity;
+	_used = 0;
+	_entries.clear();
+}
+
+int BoxArtCache::indexOf(u32 key) const {
+	for (int i = 0; i < (int)_entries.size(); i++) {
+		if (_entries[i].key == key)
+			return i;
+	}
+	return -1;
+}
+
+const BoxArtCache::Entry *BoxArtCache::find(u32 key) {
+	int index = indexOf(key);
+	if (index < 0) {
+		_misses++;
+		return NULL;
+	}
+
+	_hits++;
+	_entries[index].lastUsed = ++_clock;
+	return &_entries[index];
+}
+
+void BoxArtCache::erase(int index) {
+	_used -= _entries[index].size;
+	_entries.erase(_entries.begin() + index);
+}
+
+void BoxArtCache::evictLeastRecentlyUsed(void) {
+	int oldest = 0;
+	for (int i = 1; i < (int)_entries.size(); i++) {
+		if (_entries[i].lastUsed < _entries[oldest].lastUsed)
+			oldest = i;
+	}
+	erase(oldest);
+	_evictions++;
+}
+
+void BoxArtCache::compact(void) {
+	u32 offset = 0;
+	for (Entry &entry : _entries) {
+		if (entry.offset != offset) {
+			memmove(_memory + offset, _memory + entry.offset, entry.size);
+			entry.offset = offset;
+		}
+		offset += entry.size;
+	}
+}
+
+u8 *BoxArtCache::insert(u32 key, u32 size, bool converted, u16 width, u16 height, bool evict) {
+	size = (size + 3) & ~3; // Keep every entry word aligned
+
+	if (!_memory || size > _capacity)
+		return NULL;
+
+	int index = indexOf(key);
+	if (!evict && _capacity - _used + (index >= 0 ? _entries[index].size : 0) < size)
+		return NULL; // Leave the old entry in place
+
+	if (index >= 0)
+		erase(index);
+	while (_capacity - _used < size)
+		evictLeastRecentlyUsed();
+
+	// Use the first gap that's big enough, otherwise close all gaps up
+	u32 offset = 0;
+	size_t pos = 0;
+	for (; pos < _entries.size(); pos++) {
+		if (_entries[pos].offset - offset >= size)
+			break;
+		offset = _entries[pos].offset + _entries[pos].size;
+	}
+	if (pos == _entries.size() && _capacity - offset < size) {
+		compact();
+		offset = _used;
+	}
+
+	Entry entry = {key, offset, size, ++_clock, width, height, converted};
+	_entries.insert(_entries.begin() + pos, entry);
+	_used += size;
+	return _memory + offset;
+}
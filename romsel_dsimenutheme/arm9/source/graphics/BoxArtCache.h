@@ -0,0 +1,81 @@
+#pragma once
+#ifndef __TWILIGHTMENU_BOXART_CACHE__
+#define __TWILIGHTMENU_BOXART_CACHE__
+
+#include <nds.h>
+#include <vector>
+
+/**
+ * Least recently used cache of box art, kept in one fixed block of memory.
+ *
+ * Entries are keyed by the hash of the box art's path and can be of any
+ * size. Each holds either the PNG as read from the SD card, or the image
+ * already converted to BGR555, which is only kept when there is room for
+ * it without evicting anything.
+ */
+class BoxArtCache
+{
+	public:
+		struct Entry {
+			u32 key;
+			u32 offset;
+			u32 size;
+			u32 lastUsed;
+			u16 width;		// Only set for converted images
+			u16 height;
+			bool converted;
+		};
+
+	private:
+		u8 *_memory;
+		u32 _capacity;
+		u32 _used;
+		u32 _clock;
+		std::vector<Entry> _entries; // Sorted by offset
+
+		u32 _hits;
+		u32 _misses;
+		u32 _evictions;
+
+		int indexOf(u32 key) const;
+		void erase(int index);
+		void evictLeastRecentlyUsed(void);
+		void compact(void);
+
+	public:
+		BoxArtCache();
+
+		/**
+		 * Set the block of memory to keep the cache in, dropping all entries.
+		 */
+		void init(u8 *memory, u32 capacity);
+
+		bool enabled(void) const { return _memory != NULL; }
+
+		/**
+		 * Find an entry, and mark it as the most recently used one.
+		 * @return NULL if not cached. Only valid until the next insert().
+		 */
+		const Entry *find(u32 key);
+
+		/**
+		 * Whether an entry is cached, without marking it as used.
+		 */
+		bool contains(u32 key) const { return indexOf(key) >= 0; }
+
+		u8 *data(const Entry *entry) const { return _memory + entry->offset; }
+
+		/**
+		 * Make room for an entry, replacing any with the same key.
+		 * @param evict If false, fail instead of evicting other entries.
+		 * @return Where to write the entry's data, or NULL if it doesn't fit.
+		 */
+		u8 *insert(u32 key, u32 size, bool converted, u16 width, u16 height, bool evict);
+
+		u32 hits(void) const { return _hits; }
+		u32 misses(void) const { return _misses; }
+		u32 evictions(void) const { return _evictions; }
+		u32 used(void) const { return _used; }
+};
+
+#endif
@@ -0,0 +1,236 @@
+#include "RvidStream.h"
+#include "common/tonccpy.h"
+#include "tool/colortool.h"
+
+#include <string.h>
+
+#define RVID_V1_HEADER_SIZE 0x200
+
+static const char rvidMagic[4] = {'R', 'V', 'D', '2'};
+
+RvidStream::RvidStream()
+	: _file(NULL), _memory(NULL), _grayscale(false), _frames(0), _pixels(0), _slotSize(0),
+	  _slots(NULL), _frame(NULL), _shownFrame(NULL), _frameValid(false), _readFrame(0), _readCount(0), _playCount(0) {
+}
+
+RvidStream::~RvidStream() {
+	close();
+}
+
+bool RvidStream::open(const char *path, bool grayscale) {
+	close();
+
+	FILE *file = fopen(path, "rb");
+	if (!file)
+		return false;
+
+	fseek(file, 0, SEEK_END);
+	const u32 fileSize = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	// The frame table has to fit in the file, as well as in memory
+	RvidHeader header;
+	if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, rvidMagic, sizeof(rvidMagic)) != 0
+	 || header.width != 256 || header.height == 0 || header.height > 192
+	 || header.frames == 0 || header.frames > RVID_MAX_FRAMES
+	 || header.frames > (fileSize - sizeof(header)) / sizeof(RvidFrameInfo)
+	 || header.maxFrameSize == 0 || header.maxFrameSize > 256 * 192 * sizeof(u16) * 2) {
+		fclose(file);
+		return false;
+	}
+
+	_frames = header.frames;
+	_frameInfo.resize(_frames);
+	if (fread(_frameInfo.data(), sizeof(RvidFrameInfo), _frames, file) != _frames
+	 || !(_frameInfo[0].size & RVID_FRAME_INTRA)) {
+		_frameInfo.clear();
+		fclose(file);
+		return false;
+	}
+
+	_pixels = 256 * header.height;
+	_slotSize = (header.maxFrameSize + 3) & ~3;
+	_slots = new u8[_slotSize * RVID_STREAM_SLOTS];
+	_frame = new u16[_pixels];
+	_shownFrame = _frame;
+	_grayscale = grayscale;
+	_frameValid = false;
+	_readFrame = 0;
+	_readCount = 0;
+	_playCount = 0;
+	_file = file;
+
+	update();
+	return true;
+}
+
+bool RvidStream::load(const char *path, u32 height, u8 *memory, u32 memorySize, bool grayscale) {
+	close();
+
+	FILE *file = fopen(path, "rb");
+	if (!file)
+		return false;
+
+	fseek(file, 0, SEEK_END);
+	const u32 fileSize = ftell(file);
+
+	// Get the frame count from the file size
+	char magic[sizeof(rvidMagic)];
+	const u32 size = 256 * height * sizeof(u16);
+	const u32 frames = (fileSize > RVID_V1_HEADER_SIZE) ? (fileSize - RVID_V1_HEADER_SIZE) / size : 0;
+	fseek(file, 0, SEEK_SET);
+	if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) || memcmp(magic, rvidMagic, sizeof(rvidMagic)) == 0
+	 || frames == 0 || frames > memorySize / size) {
+		fclose(file);
+		return false;
+	}
+
+	fseek(file, RVID_V1_HEADER_SIZE, SEEK_SET);
+	const bool read = (fread(memory, size, frames, file) == frames);
+	fclose(file);
+	if (!read)
+		return false;
+
+	if (grayscale) {
+		u16 *memory16 = (u16 *)memory;
+		for (u32 i = 0; i < frames * size / sizeof(u16); i++) {
+			if (memory16[i] != 0)
+				memory16[i] = convertVramColorToGrayscale(memory16[i]);
+		}
+	}
+
+	_frames = frames;
+	_pixels = 256 * height;
+	_shownFrame = (const u16 *)memory;
+	_readFrame = 0;
+	_memory = memory;
+	return true;
+}
+
+void RvidStream::close(void) {
+	// Stop nextFrame() first, in case vblank hits while freeing
+	FILE *file = _file;
+	_file = NULL;
+	_memory = NULL;
+	_shownFrame = NULL;
+	if (!file)
+		return;
+
+	fclose(file);
+
+	delete[] _slots;
+	delete[] _frame;
+	_slots = NULL;
+	_frame = NULL;
+	_frameInfo.clear();
+}
+
+bool RvidStream::readFrame(u32 slot) {
+	const u32 offset = _frameInfo[_readFrame].offset;
+	const u32 size = _frameInfo[_readFrame].size & ~RVID_FRAME_INTRA;
+	if (size > _slotSize)
+		return false;
+
+	u8 *data = _slots + slot * _slotSize;
+	fseek(_file, offset, SEEK_SET);
+	if (fread(data, 1, size, _file) != size)
+		return false;
+
+	// Done here rather than in vblank, as it goes over every new pixel
+	if (_grayscale)
+		convertToGrayscale(data, size);
+
+	_slotFrameSize[slot] = size;
+	_slotIntra[slot] = _frameInfo[_readFrame].size & RVID_FRAME_INTRA;
+	_readFrame = (_readFrame + 1) % _frames;
+	return true;
+}
+
+void RvidStream::update(void) {
+	if (!_file)
+		return;
+
+	while (_readCount - _playCount < RVID_STREAM_SLOTS) {
+		if (!readFrame(_readCount % RVID_STREAM_SLOTS))
+			return; // Try again next time
+		_readCount++;
+	}
+}
+
+bool RvidStream::nextFrame(void) {
+	// Loaded whole, so every frame is there already
+	if (_memory) {
+		_shownFrame = (const u16 *)_memory + _readFrame * _pixels;
+		_readFrame = (_readFrame + 1) % _frames;
+		return true;
+	}
+
+	if (!_file || _playCount == _readCount)
+		return false;
+
+	const u32 slot = _playCount % RVID_STREAM_SLOTS;
+
+	// A delta frame can only be applied on top of the one before it
+	if (_slotIntra[slot] || _frameValid) {
+		decode(_slots + slot * _slotSize, _slotFrameSize[slot]);
+		_frameValid = true;
+	}
+
+	_playCount++;
+	return _frameValid;
+}
+
+void RvidStream::convertToGrayscale(u8 *data, u32 size) {
+	u16 *src = (u16 *)data;
+	u16 *end = src + size / sizeof(u16);
+
+	// Only the pixels following COPY and FILL ops
+	while (src < end) {
+		const u16 op = *src++;
+		u32 count = (op & 0x3FFF) + 1;
+		switch (op >> 14) {
+			case RVID_OP_COPY:
+				break;
+			case RVID_OP_FILL:
+				count = 1;
+				break;
+			default:
+				continue;
+		}
+		for (; count > 0 && src < end; count--, src++) {
+			if (*src != 0)
+				*src = convertVramColorToGrayscale(*src);
+		}
+	}
+}
+
+void RvidStream::decode(const u8 *data, u32 size) {
+	const u16 *src = (const u16 *)data;
+	const u16 *end = src + size / sizeof(u16);
+	u32 pos = 0;
+	while (pos < _pixels && src < end) {
+		const u16 op = *src++;
+		u32 count = (op & 0x3FFF) + 1;
+		if (count > _pixels - pos)
+			count = _pixels - pos;
+
+		switch (op >> 14) {
+			case RVID_OP_SKIP:
+				break;
+			case RVID_OP_COPY:
+				if (count > (u32)(end - src))
+					return;
+				tonccpy(_frame + pos, src, count * sizeof(u16));
+				src += count;
+				break;
+			case RVID_OP_FILL:
+				if (src >= end)
+					return;
+				toncset16(_frame + pos, *src++, count);
+				break;
+			default:
+				return;
+		}
+		pos += count;
+	}
+}
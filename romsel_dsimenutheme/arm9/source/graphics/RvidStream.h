@@ -0,0 +1,132 @@
+#pragma once
+#ifndef __TWILIGHTMENU_RVID_STREAM__
+#define __TWILIGHTMENU_RVID_STREAM__
+
+#include <nds.h>
+#include <stdio.h>
+#include <vector>
+#include "common/singleton.h"
+
+/*
+ * rvid v2, as written by vid2rvid/rvidv2.py:
+ *
+ * RvidHeader, then one RvidFrameInfo per frame, then the frame data. Each
+ * frame is a list of little-endian u16 ops, each followed by its pixels:
+ *
+ *   bits 14-15: RVID_OP_SKIP (keep the pixels of the last frame),
+ *               RVID_OP_COPY (count pixels follow), or
+ *               RVID_OP_FILL (one pixel follows, repeated count times)
+ *   bits 0-13:  count - 1
+ *
+ * Intra frames never skip, so playback can start from them. The first
+ * frame is always one.
+ *
+ * Older, uncompressed rvid files (0x200 byte header, then the raw frames)
+ * are too large to stream, so they're played from memory, where there's
+ * room for them.
+ */
+#define RVID_OP_SKIP 0
+#define RVID_OP_COPY 1
+#define RVID_OP_FILL 2
+
+#define RVID_FRAME_INTRA BIT(31)	// Set in RvidFrameInfo::size
+
+// Number of compressed frames read ahead of the one being shown
+#define RVID_STREAM_SLOTS 2
+
+// Longest rvid v2 accepted, so a bad header can't make the frame table
+// take all of memory (256KB at most)
+#define RVID_MAX_FRAMES 0x8000
+
+struct RvidHeader {
+	char magic[4];		// "RVD2"
+	u32 frames;
+	u16 width;
+	u16 height;
+	u8 fps;
+	u8 reserved[3];
+	u32 maxFrameSize;	// Largest frame, in bytes
+	u32 reserved2[3];
+};
+
+struct RvidFrameInfo {
+	u32 offset;
+	u32 size;			// Plus RVID_FRAME_INTRA
+};
+
+/*
+ * Plays an rvid v2 from the SD card with only a few frames in memory, or an
+ * uncompressed one that's been loaded whole.
+ *
+ * update() reads the frames ahead into a ring of RVID_STREAM_SLOTS
+ * buffers, from the main loop, as the file system can't be used from an
+ * interrupt. nextFrame() is then called from the vblank handler, and
+ * applies the next buffered frame to the one being shown.
+ */
+class RvidStream
+{
+	private:
+		FILE *_file;
+		const u8 *_memory;
+		bool _grayscale;
+		u32 _frames;
+		u32 _pixels;
+		u32 _slotSize;
+		std::vector<RvidFrameInfo> _frameInfo;
+		u8 *_slots;
+		u32 _slotFrameSize[RVID_STREAM_SLOTS];
+		bool _slotIntra[RVID_STREAM_SLOTS];
+		u16 *_frame;
+		const u16 *_shownFrame;
+		bool _frameValid;
+		u32 _readFrame;
+
+		// Only ever increased, by update() and nextFrame() respectively
+		volatile u32 _readCount;
+		volatile u32 _playCount;
+
+		bool readFrame(u32 slot);
+		void convertToGrayscale(u8 *data, u32 size);
+		void decode(const u8 *data, u32 size);
+
+	public:
+		RvidStream();
+		~RvidStream();
+
+		/**
+		 * Open an rvid v2 to stream, and buffer its first frames.
+		 * @return false if it isn't one.
+		 */
+		bool open(const char *path, bool grayscale);
+
+		/**
+		 * Read a whole uncompressed rvid into memory, to play from there.
+		 * @param height Height of its frames, in pixels.
+		 * @param memory Where to hold it, which is kept until close().
+		 * @return false if it isn't one, or doesn't fit in memorySize bytes.
+		 */
+		bool load(const char *path, u32 height, u8 *memory, u32 memorySize, bool grayscale);
+		void close(void);
+
+		bool isOpen(void) const { return _file != NULL || _memory != NULL; }
+		bool isStreamed(void) const { return _file != NULL; }
+
+		/**
+		 * Read frames into any free buffers. Call from the main loop.
+		 */
+		void update(void);
+
+		/**
+		 * Decode the next buffered frame into frame(). Call from vblank.
+		 * @return false if the next frame hasn't been read yet.
+		 */
+		bool nextFrame(void);
+
+		const u16 *frame(void) const { return _shownFrame; }
+		u32 frameSize(void) const { return _pixels * sizeof(u16); }
+};
+
+typedef singleton<RvidStream> rotatingCubes_s;
+inline RvidStream &rotatingCubes() { return rotatingCubes_s::instance(); }
+
+#endif
@@ -6,7 +6,10 @@
 #include <nds/arm9/dldi.h>
 #include "common/twlmenusettings.h"
 #include "common/systemdetails.h"
+#include "common/flashcard.h"
+#include "common/fnv1a.h"
 #include "myDSiMode.h"
+#include <sys/stat.h>
 
 #include "paletteEffects.h"
 #include "themefilenames.h"
@@ -20,8 +23,11 @@
 #include "common/lzss.h"
 #include "common/tonccpy.h"
 #include "common/lodepng.h"
+#include "common/colorConvert.h"
 #include "ndsheaderbanner.h"
 #include "ndma.h"
+#include "BoxArtCache.h"
+#include "RvidStream.h"
 
 
 extern bool useTwlCfg;
@@ -30,7 +36,6 @@ extern bool useTwlCfg;
 
 extern u32 rotatingCubesLoaded;
 extern bool rocketVideo_playVideo;
-extern u8 *rotatingCubesLocation;
 
 // #include <nds/arm9/decompress.h>
 // extern u16 bmpImageBuffer[256*192];
@@ -51,8 +56,11 @@ static u16* _frameBufferBot[2] = {(u16*)_bmpImageBuffer, (u16*)_bmpImageBuffer};
 static bool topBorderBufferLoaded = false;
 bool boxArtColorDeband = false;
 
-static u8* boxArtCache = (u8*)NULL;	// Size: 0x1B8000
+#define BOXART_CACHE_SIZE 0x1B8000
+
+static BoxArtCache boxArtCache;
 static bool boxArtFound[40] = {false};
+static std::string boxArtMemPath[40];
 int boxArtType[40] = {0};	// 0: NDS, 1: FDS/GBA/GBC/GB, 2: NES/GEN/MD/SFC, 3: SNES
 
 ThemeTextures::ThemeTextures()
@@ -799,10 +807,19 @@ void ThemeTextures::loadBoxArtToMem(const char *filename, int num) {
 		return;
 	}
 
+	boxArtMemPath[num] = filename;
+
+	// Still cached from an earlier page?
+	const u32 key = fnv1aHash(filename);
+	if (boxArtCache.find(key)) {
+		boxArtFound[num] = true;
+		return;
+	}
+
 	extern off_t getFileSize(const char *fileName);
 	off_t filesize = getFileSize(filename);
 
-	if (filesize == 0 || filesize > 0xB000) {
+	if (filesize == 0) {
 		boxArtFound[num] = false;
 		//filename = "nitro:/graphics/boxart_unknown.bmp";
 		//file = fopen(filename, "rb");
@@ -811,11 +828,165 @@ void ThemeTextures::loadBoxArtToMem(const char *filename, int num) {
 
 	boxArtFound[num] = true;
 
+	u8 *data = boxArtCache.insert(key, filesize, false, 0, 0, true);
+	if (!data) {
+		// Too big to keep in memory, drawBoxArtFromMem() reads it from the SD card instead
+		return;
+	}
+
 	FILE *file = fopen(filename, "rb");
-	fread(boxArtCache+(num*0xB000), 1, 0xB000, file);
+	fread(data, 1, filesize, file);
 	fclose(file);
 }
 
+/**
+ * Read box art into memory for a page that isn't shown yet, so
+ * loadBoxArtToMem() finds it already cached. Only free space is used, so
+ * nothing cached for the page that's shown is evicted for it.
+ * @return Whether it's now in memory.
+ */
+bool ThemeTextures::prefetchBoxArt(const char *filename) {
+	const u32 key = fnv1aHash(filename);
+	if (boxArtCache.contains(key)) {
+		return true;
+	}
+
+	extern off_t getFileSize(const char *fileName);
+	off_t filesize = getFileSize(filename);
+	if (filesize == 0) {
+		return false;
+	}
+
+	u8 *data = boxArtCache.insert(key, filesize, false, 0, 0, false);
+	if (!data) {
+		return false;
+	}
+
+	FILE *file = fopen(filename, "rb");
+	fread(data, 1, filesize, file);
+	fclose(file);
+	return true;
+}
+
+// Bump when the box art conversion changes, so older cached images are redone
+#define BOXART_CACHE_VERSION 2
+
+// Header of an already converted box art image, kept in _nds/TWiLightMenu/cache/boxart.
+// It's followed by the image, then the debanded second frame if boxArtDeband is set.
+struct BoxArtCacheHeader {
+	char magic[4];
+	u32 version;
+	u32 srcSize;
+	u32 srcModified;
+	u16 width;
+	u16 height;
+	u8 boxArtDeband;
+	u8 grayscale;
+	u8 reserved[2];
+};
+
+static const char boxArtCacheMagic[4] = {'B', 'X', 'C', '1'};
+
+/**
+ * Fill in the cache header expected for a box art PNG, with the current settings.
+ * @return false if the PNG could not be found.
+ */
+static bool boxArtCacheHeader(const char *filename, char *cachePath, size_t cachePathSize, BoxArtCacheHeader &header) {
+	struct stat st;
+	if (stat(filename, &st) != 0)
+		return false;
+
+	toncset(&header, 0, sizeof(header));
+	tonccpy(header.magic, boxArtCacheMagic, sizeof(header.magic));
+	header.version = BOXART_CACHE_VERSION;
+	header.srcSize = st.st_size;
+	header.srcModified = st.st_mtime;
+	header.boxArtDeband = boxArtColorDeband;
+	header.grayscale = (ms().colorMode == 1);
+
+	snprintf(cachePath, cachePathSize, "%s:/_nds/TWiLightMenu/cache/boxart/%08lX.bin", sdFound() ? "sd" : "fat", (unsigned long)fnv1aHash(filename));
+	return true;
+}
+
+bool ThemeTextures::loadBoxArtFromCache(const char *filename, uint &imageWidth, uint &imageHeight) {
+	char cachePath[64];
+	BoxArtCacheHeader expected;
+	if (!boxArtCacheHeader(filename, cachePath, sizeof(cachePath), expected))
+		return false;
+
+	FILE *file = fopen(cachePath, "rb");
+	if (!file)
+		return false;
+
+	BoxArtCacheHeader header;
+	bool good = (fread(&header, sizeof(header), 1, file) == 1);
+	// Everything but the size must match
+	good = good && header.width <= 256 && header.height <= 192;
+	if (good) {
+		expected.width = header.width;
+		expected.height = header.height;
+		good = (memcmp(&header, &expected, sizeof(header)) == 0);
+	}
+
+	const uint pixelCount = header.width * header.height;
+	good = good && (fread(_bmpImageBuffer, sizeof(u16), pixelCount, file) == pixelCount);
+	if (good && boxArtColorDeband) {
+		good = (fread(_bmpImageBuffer2, sizeof(u16), pixelCount, file) == pixelCount);
+	}
+	fclose(file);
+
+	if (good) {
+		imageWidth = header.width;
+		imageHeight = header.height;
+	}
+	return good;
+}
+
+void ThemeTextures::saveBoxArtToCache(const char *filename, uint imageWidth, uint imageHeight) {
+	char cachePath[64];
+	BoxArtCacheHeader header;
+	if (!boxArtCacheHeader(filename, cachePath, sizeof(cachePath), header))
+		return;
+
+	header.width = imageWidth;
+	header.height = imageHeight;
+
+	FILE *file = fopen(cachePath, "wb");
+	if (!file) {
+		mkdir(sdFound() ? "sd:/_nds/TWiLightMenu/cache" : "fat:/_nds/TWiLightMenu/cache", 0777);
+		mkdir(sdFound() ? "sd:/_nds/TWiLightMenu/cache/boxart" : "fat:/_nds/TWiLightMenu/cache/boxart", 0777);
+		file = fopen(cachePath, "wb");
+		if (!file)
+			return;
+	}
+
+	const uint pixelCount = imageWidth * imageHeight;
+	bool good = (fwrite(&header, sizeof(header), 1, file) == 1);
+	good = good && (fwrite(_bmpImageBuffer, sizeof(u16), pixelCount, file) == pixelCount);
+	if (good && boxArtColorDeband) {
+		good = (fwrite(_bmpImageBuffer2, sizeof(u16), pixelCount, file) == pixelCount);
+	}
+	fclose(file);
+
+	if (!good) {
+		// Don't leave a partial image behind
+		remove(cachePath);
+	}
+}
+
+void ThemeTextures::drawBoxArtImage(const u16 *src, const u16 *src2, uint imageWidth, uint imageHeight) {
+	uint imageXpos = (256-imageWidth)/2;
+	uint imageYpos = (192-imageHeight)/2;
+	for (uint y = 0; y < imageHeight; y++) {
+		tonccpy(&_bgSubBuffer[(y+imageYpos) * 256 + imageXpos], src, imageWidth * sizeof(u16));
+		src += imageWidth;
+		if (boxArtColorDeband) {
+			tonccpy(&_bgSubBuffer2[(y+imageYpos) * 256 + imageXpos], src2, imageWidth * sizeof(u16));
+			src2 += imageWidth;
+		}
+	}
+}
+
 void ThemeTextures::drawBoxArt(const char *filename) {
 	bool found = true;
 
@@ -842,10 +1013,15 @@ void ThemeTextures::drawBoxArt(const char *filename) {
 
 	beginBgSubModify();
 
-	std::vector<unsigned char> image;
 	uint imageXpos, imageYpos, imageWidth, imageHeight;
+	if (found && loadBoxArtFromCache(filename, imageWidth, imageHeight)) {
+		drawBoxArtImage(_bmpImageBuffer, _bmpImageBuffer2, imageWidth, imageHeight);
+		commitBgSubModify();
+		return;
+	}
+
+	std::vector<unsigned char> image;
 	lodepng::decode(image, imageWidth, imageHeight, filename);
-	bool alternatePixel = false;
 	if (imageWidth > 256 || imageHeight > 192)	return;
 
 	imageXpos = (256-imageWidth)/2;
@@ -882,70 +1058,14 @@ void ThemeTextures::drawBoxArt(const char *filename) {
 				photoY++;
 			}
 		}
-	} else
-	for (uint i=0;i<image.size()/4;i++) {
-		if (boxArtColorDeband) {
-			image[(i*4)+3] = 0;
-			if (alternatePixel) {
-				if (image[(i*4)] >= 0x4) {
-					image[(i*4)] -= 0x4;
-					image[(i*4)+3] |= BIT(0);
-				}
-				if (image[(i*4)+1] >= 0x4) {
-					image[(i*4)+1] -= 0x4;
-					image[(i*4)+3] |= BIT(1);
-				}
-				if (image[(i*4)+2] >= 0x4) {
-					image[(i*4)+2] -= 0x4;
-					image[(i*4)+3] |= BIT(2);
-				}
-			}
-		}
-		_bmpImageBuffer[i] = image[i*4]>>3 | (image[(i*4)+1]>>3)<<5 | (image[(i*4)+2]>>3)<<10 | BIT(15);
-		if (ms().colorMode == 1) {
-			_bmpImageBuffer[i] = convertVramColorToGrayscale(_bmpImageBuffer[i]);
-		}
-		if (boxArtColorDeband) {
-			if (alternatePixel) {
-				if (image[(i*4)+3] & BIT(0)) {
-					image[(i*4)] += 0x4;
-				}
-				if (image[(i*4)+3] & BIT(1)) {
-					image[(i*4)+1] += 0x4;
-				}
-				if (image[(i*4)+3] & BIT(2)) {
-					image[(i*4)+2] += 0x4;
-				}
-			} else {
-				if (image[(i*4)] >= 0x4) {
-					image[(i*4)] -= 0x4;
-				}
-				if (image[(i*4)+1] >= 0x4) {
-					image[(i*4)+1] -= 0x4;
-				}
-				if (image[(i*4)+2] >= 0x4) {
-					image[(i*4)+2] -= 0x4;
-				}
-			}
-			_bmpImageBuffer2[i] = image[i*4]>>3 | (image[(i*4)+1]>>3)<<5 | (image[(i*4)+2]>>3)<<10 | BIT(15);
-			if (ms().colorMode == 1) {
-				_bmpImageBuffer2[i] = convertVramColorToGrayscale(_bmpImageBuffer[i]);
-			}
-			if ((i % imageWidth) == imageWidth-1) alternatePixel = !alternatePixel;
-			alternatePixel = !alternatePixel;
-		}
+	} else {
+		rgbaToBgr555(_bmpImageBuffer, boxArtColorDeband ? _bmpImageBuffer2 : NULL, imageWidth, image.data(), imageWidth, imageHeight, 4, (ms().colorMode == 1) ? COLORCONVERT_GRAYSCALE : 0);
 	}
 
-	u16 *src = _bmpImageBuffer;
-	u16 *src2 = _bmpImageBuffer2;
-	for (uint y = 0; y < imageHeight; y++) {
-		for (uint x = 0; x < imageWidth; x++) {
-			_bgSubBuffer[(y+imageYpos) * 256 + imageXpos + x] = *(src++);
-			if (boxArtColorDeband) {
-				_bgSubBuffer2[(y+imageYpos) * 256 + imageXpos + x] = *(src2++);
-			}
-		}
+	if (found) {
+		saveBoxArtToCache(filename, imageWidth, imageHeight);
 	}
+	drawBoxArtImage(_bmpImageBuffer, _bmpImageBuffer2, imageWidth, imageHeight);
 	commitBgSubModify();
 }
 
@@ -961,83 +1081,57 @@ void ThemeTextures::drawBoxArtFromMem(int num) {
 		return;
 	}
 
-	uint imageXpos, imageYpos, imageWidth, imageHeight;
+	const char *filename = boxArtMemPath[num].c_str();
+	const u32 key = fnv1aHash(filename);
+	const BoxArtCache::Entry *entry = boxArtCache.find(key);
+	if (!entry) {
+		// Evicted, or too big to keep in memory
+		drawBoxArt(filename);
+		return;
+	}
+
+	uint imageWidth, imageHeight;
 
 	// Start loading
 	beginBgSubModify();
-	std::vector<unsigned char> image;
-	lodepng::decode(image, imageWidth, imageHeight, (unsigned char*)boxArtCache+(num*0xB000), 0xB000);
-	bool alternatePixel = false;
+	if (entry->converted) {
+		const u16 *src = (u16*)boxArtCache.data(entry);
+		const u16 *src2 = src + entry->width * entry->height;
+		drawBoxArtImage(src, src2, entry->width, entry->height);
+		commitBgSubModify();
+		return;
+	}
+
+	if (!loadBoxArtFromCache(filename, imageWidth, imageHeight)) {
+		convertBoxArtFromMem(boxArtCache.data(entry), entry->size, filename, imageWidth, imageHeight);
+	}
 	if (imageWidth > 256 || imageHeight > 192)	return;
 
-	for (uint i=0;i<image.size()/4;i++) {
+	// Swap the PNG for the converted image, if there's room for it without evicting anything
+	const u32 pixelCount = imageWidth * imageHeight;
+	const u32 frameCount = boxArtColorDeband ? 2 : 1;
+	u16 *converted = (u16*)boxArtCache.insert(key, pixelCount * frameCount * sizeof(u16), true, imageWidth, imageHeight, false);
+	if (converted) {
+		tonccpy(converted, _bmpImageBuffer, pixelCount * sizeof(u16));
 		if (boxArtColorDeband) {
-			image[(i*4)+3] = 0;
-			if (alternatePixel) {
-				if (image[(i*4)] >= 0x4) {
-					image[(i*4)] -= 0x4;
-					image[(i*4)+3] |= BIT(0);
-				}
-				if (image[(i*4)+1] >= 0x4) {
-					image[(i*4)+1] -= 0x4;
-					image[(i*4)+3] |= BIT(1);
-				}
-				if (image[(i*4)+2] >= 0x4) {
-					image[(i*4)+2] -= 0x4;
-					image[(i*4)+3] |= BIT(2);
-				}
-			}
-		}
-		_bmpImageBuffer[i] = image[i*4]>>3 | (image[(i*4)+1]>>3)<<5 | (image[(i*4)+2]>>3)<<10 | BIT(15);
-		if (ms().colorMode == 1) {
-			_bmpImageBuffer[i] = convertVramColorToGrayscale(_bmpImageBuffer[i]);
-		}
-		if (boxArtColorDeband) {
-			if (alternatePixel) {
-				if (image[(i*4)+3] & BIT(0)) {
-					image[(i*4)] += 0x4;
-				}
-				if (image[(i*4)+3] & BIT(1)) {
-					image[(i*4)+1] += 0x4;
-				}
-				if (image[(i*4)+3] & BIT(2)) {
-					image[(i*4)+2] += 0x4;
-				}
-			} else {
-				if (image[(i*4)] >= 0x4) {
-					image[(i*4)] -= 0x4;
-				}
-				if (image[(i*4)+1] >= 0x4) {
-					image[(i*4)+1] -= 0x4;
-				}
-				if (image[(i*4)+2] >= 0x4) {
-					image[(i*4)+2] -= 0x4;
-				}
-			}
-			_bmpImageBuffer2[i] = image[i*4]>>3 | (image[(i*4)+1]>>3)<<5 | (image[(i*4)+2]>>3)<<10 | BIT(15);
-			if (ms().colorMode == 1) {
-				_bmpImageBuffer2[i] = convertVramColorToGrayscale(_bmpImageBuffer[i]);
-			}
-			if ((i % imageWidth) == imageWidth-1) alternatePixel = !alternatePixel;
-			alternatePixel = !alternatePixel;
+			tonccpy(converted + pixelCount, _bmpImageBuffer2, pixelCount * sizeof(u16));
 		}
 	}
 
-	imageXpos = (256-imageWidth)/2;
-	imageYpos = (192-imageHeight)/2;
-	u16 *src = _bmpImageBuffer;
-	u16 *src2 = _bmpImageBuffer2;
-	for (uint y = 0; y < imageHeight;y++) {
-		for (uint x = 0; x < imageWidth; x++) {
-			_bgSubBuffer[(y+imageYpos) * 256 + imageXpos + x] = *(src++);
-			if (boxArtColorDeband) {
-				_bgSubBuffer2[(y+imageYpos) * 256 + imageXpos + x] = *(src2++);
-			}
-		}
-	}
+	drawBoxArtImage(_bmpImageBuffer, _bmpImageBuffer2, imageWidth, imageHeight);
 	commitBgSubModify();
 }
 
+void ThemeTextures::convertBoxArtFromMem(const u8 *png, u32 pngSize, const char *filename, uint &imageWidth, uint &imageHeight) {
+	std::vector<unsigned char> image;
+	lodepng::decode(image, imageWidth, imageHeight, png, pngSize);
+	if (imageWidth > 256 || imageHeight > 192)	return;
+
+	rgbaToBgr555(_bmpImageBuffer, boxArtColorDeband ? _bmpImageBuffer2 : NULL, imageWidth, image.data(), imageWidth, imageHeight, 4, (ms().colorMode == 1) ? COLORCONVERT_GRAYSCALE : 0);
+
+	saveBoxArtToCache(filename, imageWidth, imageHeight);
+}
+
 ITCM_CODE void ThemeTextures::drawVolumeImage(int volumeLevel) {
 	if (!dsiFeatures())
 		return;
@@ -1472,95 +1566,46 @@ u16 *ThemeTextures::photoBuffer2() { return _photoBuffer2; }
 u16 *ThemeTextures::frameBufferBot(bool secondBuffer) { return _frameBufferBot[secondBuffer]; }
 
 void loadRotatingCubes() {
-	bool rvidCompressed = false;
 	std::string cubes = TFN_RVID_CUBES;
-	FILE *videoFrameFile = fopen(cubes.c_str(), "rb");
-
-	/*if (!videoFrameFile && isDSiMode()) {
-		// Fallback to uncompressed RVID
-		rvidCompressed = false;
-		cubes = TFN_RVID_CUBES;
-		if (ms().colorMode == 1) {
-			cubes = TFN_RVID_CUBES_BW;
-		}
-		videoFrameFile = fopen(cubes.c_str(), "rb");
-	}*/
+	const bool grayscale = (ms().colorMode == 1);
 
-	// if (!videoFrameFile) {
-	// 	videoFrameFile = fopen(std::string(TFN_FALLBACK_RVID_CUBES).c_str(), "rb");
-	// }
-	// FILE* videoFrameFile;
+	// rvid v2 is streamed from the SD card as it plays, so only a few frames are ever in memory
+	if (rotatingCubes().open(cubes.c_str(), grayscale)) {
+		rotatingCubesLoaded = true;
+		rocketVideo_playVideo = true;
+		return;
+	}
 
-	/*for (u8 selectedFrame = 0; selectedFrame <= rocketVideo_videoFrames; selectedFrame++) {
-		if (selectedFrame < 0x10) {
-			snprintf(videoFrameFilename, sizeof(videoFrameFilename),
-	"nitro:/video/3dsRotatingCubes/0x0%x.bmp", (int)selectedFrame); } else { snprintf(videoFrameFilename,
-	sizeof(videoFrameFilename), "nitro:/video/3dsRotatingCubes/0x%x.bmp", (int)selectedFrame);
+	// An uncompressed rvid is played from memory, so only where it can be held
+	u8 *rotatingCubesLocation = NULL;
+	bool allocated = false;
+	if (dsiFeatures()) {
+		if (ms().consoleModel > 0) {
+			rotatingCubesLocation = (u8*)0x0D700000;
+		} else {
+			rotatingCubesLocation = new u8[0x700000];
+			allocated = true;
 		}
-		videoFrameFile = fopen(videoFrameFilename, "rb");
-
-		if (videoFrameFile) {
-			// Start loading
-			fseek(videoFrameFile, 0xe, SEEK_SET);
-			u8 pixelStart = (u8)fgetc(videoFrameFile) + 0xe;
-			fseek(videoFrameFile, pixelStart, SEEK_SET);
-			fread(bmpImageBuffer, 2, 0x7000, videoFrameFile);
-			u16* src = bmpImageBuffer;
-			int x = 0;
-			int y = 55;
-			for (int i=0; i<256*56; i++) {
-				if (x >= 256) {
-					x = 0;
-					y--;
-				}
-				u16 val = *(src++);
-				renderedImageBuffer[y*256+x] = Texture::bmpToDS(val);
-				x++;
-			}
+	} else if (sys().isRegularDS() && (io_dldi_data->ioInterface.features & FEATURE_SLOT_NDS)) {
+		sysSetCartOwner(BUS_OWNER_ARM9); // Allow arm9 to access GBA ROM (or in this case, the DS Memory
+						 // Expansion Pak)
+		if (*(u16*)(0x020000C0) == 0) {
+			*(vu16*)(0x08240000) = 1;
 		}
-		fclose(videoFrameFile);
-		memcpy(rotatingCubesLocation+(selectedFrame*0x7000), renderedImageBuffer, 0x7000);
-	}*/
-
-	if (videoFrameFile) {
-		bool doRead = false;
-		if (!rvidCompressed) {
-			fseek(videoFrameFile, 0x200, SEEK_SET);
+		if ((*(u16*)(0x020000C0) != 0 && *(u16*)(0x020000C0) != 0x5A45) || *(vu16*)(0x08240000) == 1) {
+			// Set to load video into DS Memory Expansion Pak
+			rotatingCubesLocation = (u8*)0x09000000;
 		}
+	}
 
-		if (dsiFeatures()) {
-			doRead = true;
-		} else if (sys().isRegularDS() && (io_dldi_data->ioInterface.features & FEATURE_SLOT_NDS)) {
-			sysSetCartOwner(BUS_OWNER_ARM9); // Allow arm9 to access GBA ROM (or in this case, the DS Memory
-							 // Expansion Pak)
-			if (*(u16*)(0x020000C0) == 0) {
-				*(vu16*)(0x08240000) = 1;
-			}
-			if ((*(u16*)(0x020000C0) != 0 && *(u16*)(0x020000C0) != 0x5A45) || *(vu16*)(0x08240000) == 1) {
-				// Set to load video into DS Memory Expansion Pak
-				rotatingCubesLocation = (u8*)0x09000000;
-				doRead = true;
-			}
-		}
+	if (!rotatingCubesLocation)
+		return;
 
-		if (doRead) {
-			if (rvidCompressed) {
-				fread((void*)0x02D80000, 1, 0x200000, videoFrameFile);
-				LZ77_Decompress((u8*)0x02D80000, (u8*)rotatingCubesLocation);
-			} else {
-				fread(rotatingCubesLocation, 1, 0x700000, videoFrameFile);
-			}
-			if (ms().colorMode == 1) {
-				u16* rotatingCubesLocation16 = (u16*)rotatingCubesLocation;
-				for (int i = 0; i < 0x700000/2; i++) {
-					if (rotatingCubesLocation16[i] != 0) {
-						rotatingCubesLocation16[i] = convertVramColorToGrayscale(rotatingCubesLocation16[i]);
-					}
-				}
-			}
-			rotatingCubesLoaded = true;
-			rocketVideo_playVideo = true;
-		}
+	if (rotatingCubes().load(cubes.c_str(), 56, rotatingCubesLocation, 0x700000, grayscale)) {
+		rotatingCubesLoaded = true;
+		rocketVideo_playVideo = true;
+	} else if (allocated) {
+		delete[] rotatingCubesLocation;
 	}
 }
 void ThemeTextures::videoSetup() {
@@ -1625,15 +1670,9 @@ void ThemeTextures::videoSetup() {
 
 	if (dsiFeatures() && !ms().macroMode && ms().theme != TWLSettings::EThemeHBL) {
 		if (ms().consoleModel > 0) {
-			rotatingCubesLocation = (u8*)0x0D700000;
-			boxArtCache = (u8*)0x0D540000;
-		} else {
-			if (ms().theme == TWLSettings::ETheme3DS) {
-				rotatingCubesLocation = new u8[0x700000];
-			}
-			if (ms().showBoxArt == 2) {
-				boxArtCache = new u8[0x1B8000];
-			}
+			boxArtCache.init((u8*)0x0D540000, BOXART_CACHE_SIZE);
+		} else if (ms().showBoxArt == 2) {
+			boxArtCache.init(new u8[BOXART_CACHE_SIZE], BOXART_CACHE_SIZE);
 		}
 	}
 
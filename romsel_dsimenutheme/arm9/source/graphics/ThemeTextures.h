@@ -58,6 +58,7 @@ public:
 	void drawBottomBg(int bg);
 
 	void loadBoxArtToMem(const char *filename, int num);
+	bool prefetchBoxArt(const char *filename);
 	void drawBoxArt(const char* filename);
 	void drawBoxArtFromMem(int num);
 
@@ -103,6 +104,11 @@ private:
 
 	void loadBackgrounds();
 
+	bool loadBoxArtFromCache(const char *filename, uint &imageWidth, uint &imageHeight);
+	void saveBoxArtToCache(const char *filename, uint imageWidth, uint imageHeight);
+	void convertBoxArtFromMem(const u8 *png, u32 pngSize, const char *filename, uint &imageWidth, uint &imageHeight);
+	void drawBoxArtImage(const u16 *src, const u16 *src2, uint imageWidth, uint imageHeight);
+
 	static int getVolumeLevel();
 	static int getBatteryLevel();
 
@@ -8,6 +8,7 @@
 #include "common/systemdetails.h"
 #include "common/tonccpy.h"
 #include "myDSiMode.h"
+#include "RvidStream.h"
 #include "startborderpal.h"
 #include "TextEntry.h"
 #include "ThemeConfig.h"
@@ -34,7 +35,8 @@ bool fileExists(std::vector<std::string_view> paths) {
 
 void fontInit() {
 	extern u32 rotatingCubesLoaded;
-	bool useExpansionPak = (sys().isRegularDS() && ((*(u16*)(0x020000C0) != 0 && *(u16*)(0x020000C0) != 0x5A45) || *(vu16*)(0x08240000) == 1) && (*(u16*)(0x020000C0) != 0 || !rotatingCubesLoaded)
+	// The pak is left to the rotating cubes if they've been loaded into it, rather than streamed
+	bool useExpansionPak = (sys().isRegularDS() && ((*(u16*)(0x020000C0) != 0 && *(u16*)(0x020000C0) != 0x5A45) || *(vu16*)(0x08240000) == 1) && (*(u16*)(0x020000C0) != 0 || !rotatingCubesLoaded || rotatingCubes().isStreamed())
 							&& (io_dldi_data->ioInterface.features & FEATURE_SLOT_NDS));
 
 	// Unload fonts if already loaded
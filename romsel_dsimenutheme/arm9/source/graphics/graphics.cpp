@@ -41,8 +41,10 @@
 #include "fontHandler.h"
 #include "graphics/ThemeTextures.h"
 #include "common/lodepng.h"
+#include "common/colorConvert.h"
 #include "launchDots.h"
 #include "queueControl.h"
+#include "RvidStream.h"
 #include "sound.h"
 //#include "ndma.h"
 #include "ThemeConfig.h"
@@ -173,8 +175,6 @@ u32 rotatingCubesLoaded = false;	// u32 used instead of bool, to fix a weird bug
 bool rocketVideo_playVideo = false;
 int rocketVideo_videoYpos = 78;
 int frameOf60fps = 60;
-int rocketVideo_videoFrames = 249;
-int rocketVideo_currentFrame = -1;
 //int rocketVideo_frameDelay = 0;
 int frameDelay = 0;
 bool frameDelayEven = true; // For 24FPS
@@ -292,8 +292,6 @@ void drawDbox() {
 
 void reloadDboxPalette() { tex().reloadPalDialogBox(); }
 
-u8 *rotatingCubesLocation = (u8*)NULL;
-
 void frameRateHandler(void) {
 	frameOf60fps++;
 	if (frameOf60fps > 60) frameOf60fps = 1;
@@ -377,15 +375,13 @@ void playRotatingCubesVideo(void) {
 		return;
 
 	if (rocketVideo_loadFrame) {
-		//if (renderFrame) {
-			//DC_FlushRange((void*)(rotatingCubesLocation + (rocketVideo_currentFrame * 0x7000)), 0x7000);
-			dmaCopyWordsAsynch(1, rotatingCubesLocation+(rocketVideo_currentFrame*(0x200*56)), (u16*)BG_GFX_SUB+(256*rocketVideo_videoYpos), 0x200*56);
-		//}
+		// If the frame hasn't been read in time, try again next vblank
+		if (!rotatingCubes().nextFrame())
+			return;
+
+		DC_FlushRange(rotatingCubes().frame(), rotatingCubes().frameSize());
+		dmaCopyWordsAsynch(1, rotatingCubes().frame(), (u16*)BG_GFX_SUB+(256*rocketVideo_videoYpos), rotatingCubes().frameSize());
 
-		rocketVideo_currentFrame++;
-		if (rocketVideo_currentFrame > rocketVideo_videoFrames) {
-			rocketVideo_currentFrame = 0;
-		}
 		//rocketVideo_frameDelay = 0;
 		//rocketVideo_frameDelayEven = !rocketVideo_frameDelayEven;
 		rocketVideo_loadFrame = false;
@@ -393,8 +389,7 @@ void playRotatingCubesVideo(void) {
 }
 
 void vBlankHandler() {
-	execQueue();		   // Execute any actions queued during last vblank.
-	execDeferredIconUpdates(); // Update any icons queued during last vblank.
+	execQueue();		   // Execute any actions and icon updates queued during last vblank.
 
 	if (waitForNeedToPlayStopSound > 0) {
 		waitForNeedToPlayStopSound++;
@@ -1187,7 +1182,6 @@ void loadPhotoList() {
 
 void loadPhoto(const std::string &path) {
 	std::vector<unsigned char> image;
-	bool alternatePixel = false;
 
 	lodepng::decode(image, photoWidth, photoHeight, path);
 
@@ -1197,58 +1191,7 @@ void loadPhoto(const std::string &path) {
 		lodepng::decode(image, photoWidth, photoHeight, "nitro:/graphics/photo_default.png");
 	}
 
-	for (uint i=0;i<image.size()/4;i++) {
-		if (boxArtColorDeband) {
-			image[(i*4)+3] = 0;
-			if (alternatePixel) {
-				if (image[(i*4)] >= 0x4) {
-					image[(i*4)] -= 0x4;
-					image[(i*4)+3] |= BIT(0);
-				}
-				if (image[(i*4)+1] >= 0x4) {
-					image[(i*4)+1] -= 0x4;
-					image[(i*4)+3] |= BIT(1);
-				}
-				if (image[(i*4)+2] >= 0x4) {
-					image[(i*4)+2] -= 0x4;
-					image[(i*4)+3] |= BIT(2);
-				}
-			}
-		}
-		tex().photoBuffer()[i] = image[i*4]>>3 | (image[(i*4)+1]>>3)<<5 | (image[(i*4)+2]>>3)<<10 | BIT(15);
-		if (ms().colorMode == 1) {
-			tex().photoBuffer()[i] = convertVramColorToGrayscale(tex().photoBuffer()[i]);
-		}
-		if (boxArtColorDeband) {
-			if (alternatePixel) {
-				if (image[(i*4)+3] & BIT(0)) {
-					image[(i*4)] += 0x4;
-				}
-				if (image[(i*4)+3] & BIT(1)) {
-					image[(i*4)+1] += 0x4;
-				}
-				if (image[(i*4)+3] & BIT(2)) {
-					image[(i*4)+2] += 0x4;
-				}
-			} else {
-				if (image[(i*4)] >= 0x4) {
-					image[(i*4)] -= 0x4;
-				}
-				if (image[(i*4)+1] >= 0x4) {
-					image[(i*4)+1] -= 0x4;
-				}
-				if (image[(i*4)+2] >= 0x4) {
-					image[(i*4)+2] -= 0x4;
-				}
-			}
-			tex().photoBuffer2()[i] = image[i*4]>>3 | (image[(i*4)+1]>>3)<<5 | (image[(i*4)+2]>>3)<<10 | BIT(15);
-			if (ms().colorMode == 1) {
-				tex().photoBuffer2()[i] = convertVramColorToGrayscale(tex().photoBuffer2()[i]);
-			}
-			if ((i % photoWidth) == photoWidth-1) alternatePixel = !alternatePixel;
-			alternatePixel = !alternatePixel;
-		}
-	}
+	rgbaToBgr555(tex().photoBuffer(), boxArtColorDeband ? tex().photoBuffer2() : NULL, photoWidth, image.data(), photoWidth, photoHeight, 4, (ms().colorMode == 1) ? COLORCONVERT_GRAYSCALE : 0);
 
 	u16 *bgSubBuffer = tex().beginBgSubModify();
 	u16* bgSubBuffer2 = tex().bgSubBuffer2();
@@ -1,21 +1,86 @@
 #include "queueControl.h"
 
 #include <nds.h>
-#include <vector>
-#include <functional>
 
+// Timers 2 and 3, cascaded for cpuGetTiming(). Restarted if anything else
+// stops them, which only throws off the budget it happens in, as only
+// differences are taken.
+#define TASK_TIMER	2
 
-std::vector<graphics_callback> queuedFunctors;
+// Out of about 4.5ms of vblank, leaving time for the rest of the handler
+#define VBLANK_TASK_BUDGET	(BUS_CLOCK / 1000)	// 1ms
+// Out of about 16.7ms of a frame
+#define IDLE_TASK_BUDGET	(BUS_CLOCK / 250)	// 4ms
 
+// Tasks waiting for the VBlank Handler, a power of 2
+#define VBLANK_QUEUE_SIZE	64
+
+struct DeferredEntry {
+	deferred_task task;
+	graphics_callback function;	// Called instead, if task is NULL
+	DeferredArgs args;
+};
+
+// A ring, as nothing can be allocated or freed in the VBlank Handler. Only
+// the main loop adds to it, and only the handler takes from it.
+static DeferredEntry vblankQueue[VBLANK_QUEUE_SIZE];
+static vu32 vblankQueueHead = 0;	// Next to run
+static vu32 vblankQueueTail = 0;	// Next to fill
+
+
+static u32 taskClock(void) {
+	if (!(TIMER_CR(TASK_TIMER) & TIMER_ENABLE))
+		cpuStartTiming(TASK_TIMER);
+	return cpuGetTiming();
+}
+
+TaskScheduler &idleTasks() {
+	static TaskScheduler scheduler(taskClock);
+	return scheduler;
+}
+
+
+static void enqueue(const DeferredEntry &entry) {
+	// Not while the VBlank Handler is running its tasks
+	int oldIME = enterCriticalSection();
+	while (vblankQueueTail - vblankQueueHead >= VBLANK_QUEUE_SIZE) {
+		// Full, so let the handler take some first
+		leaveCriticalSection(oldIME);
+		swiWaitForVBlank();
+		oldIME = enterCriticalSection();
+	}
+	vblankQueue[vblankQueueTail % VBLANK_QUEUE_SIZE] = entry;
+	vblankQueueTail++;
+	leaveCriticalSection(oldIME);
+}
 
 void defer(graphics_callback function) {
-	queuedFunctors.push_back(function);
+	enqueue({NULL, function, {}});
+}
+
+void deferTask(deferred_task task, const DeferredArgs &args) {
+	enqueue({task, NULL, args});
 }
 
 
 void execQueue() {
-	for (auto functor : queuedFunctors) {
-		functor();
+	const u32 start = taskClock();
+	while (vblankQueueHead != vblankQueueTail && taskClock() - start < VBLANK_TASK_BUDGET) {
+		const DeferredEntry &entry = vblankQueue[vblankQueueHead % VBLANK_QUEUE_SIZE];
+		bool done = true;
+		if (entry.task)
+			done = entry.task(entry.args);
+		else
+			entry.function();
+		if (done)
+			vblankQueueHead++;
 	}
-	queuedFunctors.clear();
-}
\ No newline at end of file
+}
+
+void execIdleTasks() {
+	idleTasks().run(IDLE_TASK_BUDGET);
+}
+
+u32 taskTime() {
+	return taskClock();
+}
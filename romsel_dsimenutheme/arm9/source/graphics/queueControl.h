@@ -1,9 +1,24 @@
-#include <vector>
-#include <functional>
 #pragma once
 
+#include "common/taskScheduler.h"
+
 typedef void (*graphics_callback)();
 
+/**
+ * Arguments of a deferred task, copied into the queue with it.
+ */
+struct DeferredArgs {
+	void *ptr[2];
+	int num;
+	bool flag;
+};
+
+/**
+ * A step of a deferred task, returning true once it's done. It's run in the
+ * VBlank Handler, so it mustn't allocate memory.
+ */
+typedef bool (*deferred_task)(const DeferredArgs &args);
+
 
 /**
  * Defer the execution of a lambda until the end of the VBlank Handler.
@@ -11,6 +26,29 @@ typedef void (*graphics_callback)();
 void defer(graphics_callback function);
 
 /**
- * Executes all the functions in the queue, and clears it.
+ * Defer a task to the end of the VBlank Handler, resumed each vblank until it's done.
+ * If the queue is full, waits for the VBlank Handler to make room.
+ */
+void deferTask(deferred_task task, const DeferredArgs &args);
+
+/**
+ * Executes the deferred functions and tasks, for as long as the vblank budget
+ * allows. Any left are run after the next vblank.
+ */
+void execQueue();
+
+/**
+ * Tasks run while the menu waits for the next frame, such as reading the
+ * page's box art.
+ */
+TaskScheduler &idleTasks();
+
+/**
+ * Runs idle tasks for as long as the per-frame budget allows.
+ */
+void execIdleTasks();
+
+/**
+ * The time on the clock tasks are timed with, in BUS_CLOCK ticks per second.
  */
-void execQueue();
\ No newline at end of file
+u32 taskTime();
@@ -26,6 +26,9 @@
 #include "common/bootstrapsettings.h"
 #include "common/systemdetails.h"
 #include "common/flashcard.h"
+#include "common/fileType.h"
+#include "rominfo/romInfoCache.h"
+#include "common/titleIndex.h"
 #include <gl2d.h>
 #include "common/tonccpy.h"
 #include "fileBrowse.h"
@@ -66,8 +69,6 @@ static u32 arm9StartSig[4];
 
 u8 tilesModified[(32 * 256) / 2] = {0};
 
-std::vector<std::tuple<u8 *, u16 *, int, bool>> queuedIconUpdateCache;
-
 static void convertIconTilesToRaw(u8 *tilesSrc, u8 *tilesNew, bool twl) {
 	int PY = 32;
 	if (twl)
@@ -84,28 +85,18 @@ static void convertIconTilesToRaw(u8 *tilesSrc, u8 *tilesNew, bool twl) {
 	}
 }
 
-/**
- * Queue the icon update.
- */
-void deferLoadIcon(u8 *tilesSrc, u16 *palSrc, int num, bool twl) {
-	queuedIconUpdateCache.emplace_back(std::move(std::make_tuple(tilesSrc, palSrc, num, twl)));
+static bool loadDeferredIcon(const DeferredArgs &args) {
+	const bool twl = args.flag;
+	convertIconTilesToRaw((u8 *)args.ptr[0], tilesModified, twl);
+	glLoadIcon(args.num, (u16 *)args.ptr[1], (u8 *)tilesModified, twl ? TWL_TEX_HEIGHT : 32);
+	return true;
 }
 
 /**
- * This is called in graphics/vblank handler to process
- * any deferred updates.
+ * Queue the icon update, to be done in the vblank handler.
  */
-void execDeferredIconUpdates() {
-	for (auto arg : queuedIconUpdateCache) {
-		u8 *tilesSrc;
-		u16 *palSrc;
-		int num;
-		bool twl;
-		std::tie(tilesSrc, palSrc, num, twl) = arg;
-		convertIconTilesToRaw(tilesSrc, tilesModified, twl);
-		glLoadIcon(num, (u16 *)palSrc, (u8 *)tilesModified, twl ? TWL_TEX_HEIGHT : 32);
-	}
-	queuedIconUpdateCache.clear();
+void deferLoadIcon(u8 *tilesSrc, u16 *palSrc, int num, bool twl) {
+	deferTask(loadDeferredIcon, {{tilesSrc, palSrc}, num, twl});
 }
 
 //(u8(*tilesSrc)[(32 * 32) / 2], u16(*palSrc)[16])
@@ -212,6 +203,210 @@ void clearTitle(int num) {
 	cachedTitle[num] = blankTitle;
 }
 
+// Bump when CachedRomInfo changes, so older caches are thrown away
+#define ROMINFO_CACHE_VERSION 1
+
+// The header fields getGameInfo() looks at, as kept in the ROM info cache
+struct CachedRomInfo {
+	char gameCode[4];
+	char gameTitle[12];
+	u32 arm9binarySize;
+	u32 arm7binarySize;
+	u32 arm7executeAddress;
+	u32 arm7destination;
+	u32 arm7idestination;
+	u32 accessControl;
+	u32 a7mbk6;
+	u32 arm9StartSig[4];
+	u16 headerCRC16;
+	u8 romversion;
+	u8 unitCode;
+	u8 dsi_flags;
+	u8 reserved[3];
+};
+
+static void packRomInfo(const sNDSHeaderExt &ndsHeader, CachedRomInfo &romInfo) {
+	toncset(&romInfo, 0, sizeof(romInfo));
+	tonccpy(romInfo.gameCode, ndsHeader.gameCode, sizeof(romInfo.gameCode));
+	tonccpy(romInfo.gameTitle, ndsHeader.gameTitle, sizeof(romInfo.gameTitle));
+	romInfo.arm9binarySize = ndsHeader.arm9binarySize;
+	romInfo.arm7binarySize = ndsHeader.arm7binarySize;
+	romInfo.arm7executeAddress = ndsHeader.arm7executeAddress;
+	romInfo.arm7destination = ndsHeader.arm7destination;
+	romInfo.arm7idestination = ndsHeader.arm7idestination;
+	romInfo.accessControl = ndsHeader.accessControl;
+	romInfo.a7mbk6 = ndsHeader.a7mbk6;
+	tonccpy(romInfo.arm9StartSig, arm9StartSig, sizeof(romInfo.arm9StartSig));
+	romInfo.headerCRC16 = ndsHeader.headerCRC16;
+	romInfo.romversion = ndsHeader.romversion;
+	romInfo.unitCode = ndsHeader.unitCode;
+	romInfo.dsi_flags = ndsHeader.dsi_flags;
+}
+
+static void unpackRomInfo(const CachedRomInfo &romInfo, sNDSHeaderExt &ndsHeader) {
+	toncset(&ndsHeader, 0, sizeof(ndsHeader));
+	tonccpy(ndsHeader.gameCode, romInfo.gameCode, sizeof(romInfo.gameCode));
+	tonccpy(ndsHeader.gameTitle, romInfo.gameTitle, sizeof(romInfo.gameTitle));
+	ndsHeader.arm9binarySize = romInfo.arm9binarySize;
+	ndsHeader.arm7binarySize = romInfo.arm7binarySize;
+	ndsHeader.arm7executeAddress = romInfo.arm7executeAddress;
+	ndsHeader.arm7destination = romInfo.arm7destination;
+	ndsHeader.arm7idestination = romInfo.arm7idestination;
+	ndsHeader.accessControl = romInfo.accessControl;
+	ndsHeader.a7mbk6 = romInfo.a7mbk6;
+	tonccpy(arm9StartSig, romInfo.arm9StartSig, sizeof(romInfo.arm9StartSig));
+	ndsHeader.headerCRC16 = romInfo.headerCRC16;
+	ndsHeader.romversion = romInfo.romversion;
+	ndsHeader.unitCode = romInfo.unitCode;
+	ndsHeader.dsi_flags = romInfo.dsi_flags;
+}
+
+static u32 bannerSizeForVersion(u16 version) {
+	switch (version) {
+		case NDS_BANNER_VER_ZH:
+			return NDS_BANNER_SIZE_ZH;
+		case NDS_BANNER_VER_ZH_KO:
+			return NDS_BANNER_SIZE_ZH_KO;
+		case NDS_BANNER_VER_DSi:
+			return NDS_BANNER_SIZE_DSi;
+		default:
+			return NDS_BANNER_SIZE_ORIGINAL;
+	}
+}
+
+void openRomInfoCache(const char *dirPath) {
+	romInfoCache().openDir(dirPath, ROMINFO_CACHE_VERSION);
+	titleIndex().openDir(dirPath);
+}
+
+/**
+ * Index a banner's titles in each language it has, so the file can be
+ * searched for by them.
+ */
+static void indexBannerTitles(const char *name, const sNDSBannerExt &banner) {
+	int languages = 6;
+	if (banner.version == NDS_BANNER_VER_ZH)
+		languages = 7;
+	else if (banner.version == NDS_BANNER_VER_ZH_KO || banner.version == NDS_BANNER_VER_DSi)
+		languages = 8;
+	titleIndex().setTitles(name, banner.titles, languages);
+}
+
+/**
+ * Read the header, ARM9 start signature and banner from a ROM.
+ * @param banner If NULL, the banner is not read.
+ * @param bannerSize Set to the size of the banner that was read, or 0.
+ * @return false if the ROM could not be opened or its header read.
+ */
+static bool readRomInfo(const char *name, sNDSHeaderExt &ndsHeader, sNDSBannerExt *banner, u32 &bannerSize) {
+	FILE *fp;
+	int ret;
+
+	bannerSize = 0;
+
+	// open file for reading info
+	fp = fopen(name, "rb");
+	if (fp == NULL) {
+		return false;
+	}
+
+	ret = fseek(fp, 0, SEEK_SET);
+	if (ret == 0)
+		ret = fread(&ndsHeader, sizeof(ndsHeader), 1, fp); // read if seek succeed
+	else
+		ret = 0; // if seek fails set to !=1
+
+	if (ret != 1) {
+		// try again, but using regular header size
+		ret = fseek(fp, 0, SEEK_SET);
+		if (ret == 0)
+			ret = fread(&ndsHeader, 0x160, 1, fp); // read if seek succeed
+		else
+			ret = 0; // if seek fails set to !=1
+
+		if (ret != 1) {
+			fclose(fp);
+			return false;
+		}
+	}
+
+	fseek(fp, ndsHeader.arm9romOffset + ndsHeader.arm9executeAddress - ndsHeader.arm9destination, SEEK_SET);
+	fread(arm9StartSig, sizeof(u32), 4, fp);
+
+	if (banner == NULL || ndsHeader.bannerOffset == 0) {
+		fclose(fp);
+		return true;
+	}
+
+	ret = fseek(fp, ndsHeader.bannerOffset, SEEK_SET);
+	if (ret == 0)
+		ret = fread(banner, sizeof(sNDSBannerExt), 1, fp); // read if seek succeed
+	else
+		ret = 0; // if seek fails set to !=1
+
+	if (ret == 1) {
+		bannerSize = sizeof(sNDSBannerExt);
+	} else {
+		// try again, but using regular banner size
+		ret = fseek(fp, ndsHeader.bannerOffset, SEEK_SET);
+		if (ret == 0)
+			ret = fread(banner, NDS_BANNER_SIZE_ORIGINAL, 1, fp); // read if seek succeed
+		else
+			ret = 0; // if seek fails set to !=1
+
+		if (ret == 1)
+			bannerSize = NDS_BANNER_SIZE_ORIGINAL;
+	}
+
+	// close file!
+	fclose(fp);
+
+	// Anything past the banner's own version is not part of it
+	if (bannerSize > bannerSizeForVersion(banner->version))
+		bannerSize = bannerSizeForVersion(banner->version);
+
+	return true;
+}
+
+/**
+ * Read a ROM's header and banner into the ROM info cache, for a page that
+ * isn't shown yet, so getGameInfo() doesn't have to read the ROM itself.
+ * @param gameCode If not NULL, set to the ROM's game code.
+ * @return false if it isn't a DS ROM, or it couldn't be read.
+ */
+bool prefetchGameInfo(const char *name, char *gameCode) {
+	// .argv files share the DS ROM type, but aren't ROMs themselves
+	if (fileTypeOf(name).romType != 0 || extension(name, {".argv"}))
+		return false;
+
+	CachedRomInfo romInfo;
+	u32 bannerSize = 0;
+	if (!romInfoCache().get(name, &romInfo, sizeof(romInfo), NULL, 0, &bannerSize)) {
+		static sNDSHeaderExt ndsHeader;
+		static sNDSBannerExt banner;
+
+		// The signature read here isn't the one getGameInfo() last read
+		u32 arm9StartSigShown[4];
+		tonccpy(arm9StartSigShown, arm9StartSig, sizeof(arm9StartSig));
+		const bool read = readRomInfo(name, ndsHeader, &banner, bannerSize);
+		if (read) {
+			packRomInfo(ndsHeader, romInfo);
+			romInfoCache().put(name, &romInfo, sizeof(romInfo), &banner, bannerSize);
+			if (bannerSize > 0)
+				indexBannerTitles(name, banner);
+		}
+		tonccpy(arm9StartSig, arm9StartSigShown, sizeof(arm9StartSig));
+		if (!read)
+			return false;
+	}
+
+	if (gameCode) {
+		tonccpy(gameCode, romInfo.gameCode, sizeof(romInfo.gameCode));
+		gameCode[sizeof(romInfo.gameCode)] = '\0';
+	}
+	return true;
+}
+
 void getGameInfo(bool isDir, const char *name, int num) {
 	if (num == -1)
 		num = 40;
@@ -268,6 +463,7 @@ void getGameInfo(bool isDir, const char *name, int num) {
 					}
 					cachedTitle[num] = (char16_t*)&banner.titles[currentLang];
 					infoFound[num] = true;
+					indexBannerTitles(name, banner);
 				}
 			}
 		} else {
@@ -402,40 +598,39 @@ void getGameInfo(bool isDir, const char *name, int num) {
 		free(line);
 	} else if (extension(name, {".nds", ".dsi", ".ids", ".srl", ".app"})) {
 		// this is an nds/app file!
-		FILE *fp;
-		int ret;
+		sNDSHeaderExt ndsHeader;
+		sNDSBannerExt &ndsBanner = bnriconTile[num];
 
-		// open file for reading info
-		fp = fopen(name, "rb");
-		if (fp == NULL) {
-			clearTitle(num);
-			clearBannerSequence(num); // banner sequence
-			fclose(fp);
-			return;
+		u8 iconCopy[512];
+		u16 paletteCopy[16];
+		if (customIcon[num] == 1) { // custom png icon
+			// copy the icon and palette before they get overwritten
+			memcpy(iconCopy, ndsBanner.icon, sizeof(iconCopy));
+			memcpy(paletteCopy, ndsBanner.palette, sizeof(paletteCopy));
 		}
 
-		sNDSHeaderExt ndsHeader;
-
-		ret = fseek(fp, 0, SEEK_SET);
-		if (ret == 0)
-			ret = fread(&ndsHeader, sizeof(ndsHeader), 1, fp); // read if seek succeed
-		else
-			ret = 0; // if seek fails set to !=1
+		// A custom banner bin takes the place of the ROM's banner
+		sNDSBannerExt *banner = (customIcon[num] == 2) ? NULL : &ndsBanner;
+		u32 bannerSize = 0;
 
-		if (ret != 1) {
-			// try again, but using regular header size
-			ret = fseek(fp, 0, SEEK_SET);
-			if (ret == 0)
-				ret = fread(&ndsHeader, 0x160, 1, fp); // read if seek succeed
-			else
-				ret = 0; // if seek fails set to !=1
-
-			if (ret != 1) {
+		CachedRomInfo romInfo;
+		if (romInfoCache().get(name, &romInfo, sizeof(romInfo), banner, sizeof(sNDSBannerExt), &bannerSize)) {
+			unpackRomInfo(romInfo, ndsHeader);
+		} else {
+			if (!readRomInfo(name, ndsHeader, banner, bannerSize)) {
 				clearTitle(num);
 				clearBannerSequence(num);
-				fclose(fp);
 				return;
 			}
+			// Only remember ROMs whose banner was read as well
+			if (banner) {
+				packRomInfo(ndsHeader, romInfo);
+				romInfoCache().put(name, &romInfo, sizeof(romInfo), banner, bannerSize);
+			}
+		}
+		if (banner && bannerSize > 0) {
+			// Clear whatever is past the banner's own version, as that isn't kept in the cache
+			toncset((u8 *)banner + bannerSize, 0, sizeof(sNDSBannerExt) - bannerSize);
 		}
 
 		if (num < 40) {
@@ -447,8 +642,6 @@ void getGameInfo(bool isDir, const char *name, int num) {
 			a7mbk6[num] = ndsHeader.a7mbk6;
 		}
 
-		fseek(fp, ndsHeader.arm9romOffset + ndsHeader.arm9executeAddress - ndsHeader.arm9destination, SEEK_SET);
-		fread(arm9StartSig, sizeof(u32), 4, fp);
 		if (arm9StartSig[0] == 0xE3A00301
 		 && arm9StartSig[1] == 0xE5800208
 		 && arm9StartSig[2] == 0xE3A00013
@@ -508,23 +701,15 @@ void getGameInfo(bool isDir, const char *name, int num) {
 			bnrWirelessIcon[num] = 2;
 		
 		if (customIcon[num] == 2) { // custom banner bin
-			// we're done early, close the file
-			fclose(fp);
+			// we're done early
 			return;
 		}
 
-		sNDSBannerExt &ndsBanner = bnriconTile[num];
-
-		u8 iconCopy[512];
-		u16 paletteCopy[16];
-		if (customIcon[num] == 1) { // custom png icon
-			// copy the icon and palette before they get overwritten
-			memcpy(iconCopy, ndsBanner.icon, sizeof(iconCopy));
-			memcpy(paletteCopy, ndsBanner.palette, sizeof(paletteCopy));
-		}
-
-		if (ndsHeader.bannerOffset == 0) {
-			fclose(fp);
+		if (bannerSize == 0) {
+			if (customIcon[num] == 1) {
+				memcpy(ndsBanner.icon, iconCopy, sizeof(iconCopy));
+				memcpy(ndsBanner.palette, paletteCopy, sizeof(paletteCopy));
+			}
 
 			// If no custom icon, display as unknown
 			if (customIcon[num] == 0)
@@ -532,33 +717,6 @@ void getGameInfo(bool isDir, const char *name, int num) {
 
 			return;
 		}
-		ret = fseek(fp, ndsHeader.bannerOffset, SEEK_SET);
-		if (ret == 0)
-			ret = fread(&ndsBanner, sizeof(ndsBanner), 1, fp); // read if seek succeed
-		else
-			ret = 0; // if seek fails set to !=1
-
-		if (ret != 1) {
-			// try again, but using regular banner size
-			ret = fseek(fp, ndsHeader.bannerOffset, SEEK_SET);
-			if (ret == 0)
-				ret = fread(&ndsBanner, NDS_BANNER_SIZE_ORIGINAL, 1, fp); // read if seek succeed
-			else
-				ret = 0; // if seek fails set to !=1
-
-			if (ret != 1) {
-				fclose(fp);
-
-				// If no custom icon, display as unknown
-				if (customIcon[num] == 0)
-					customIcon[num] = -1;
-
-				return;
-			}
-		}
-
-		// close file!
-		fclose(fp);
 
 		int currentLang = 0;
 		if (ndsBanner.version == NDS_BANNER_VER_ZH || ndsBanner.version == NDS_BANNER_VER_ZH_KO || ndsBanner.version == NDS_BANNER_VER_DSi) {
@@ -574,6 +732,7 @@ void getGameInfo(bool isDir, const char *name, int num) {
 		cachedTitle[num] = (char16_t*)&ndsBanner.titles[currentLang];
 
 		infoFound[num] = true;
+		indexBannerTitles(name, ndsBanner);
 
 		// restore png icon
 		if (customIcon[num] == 1) {
@@ -23,7 +23,9 @@
 
 #include <string_view>
 
+void openRomInfoCache(const char* dirPath);
 void getGameInfo(bool isDir, const char* name, int num);
+bool prefetchGameInfo(const char* name, char* gameCode);
 void iconUpdate(bool isDir, const char* name, int num);
 void titleUpdate(bool isDir, std::string_view name, int num);
 void drawRomIcon(int Xpos, int Ypos, int num, int romType);
@@ -49,6 +51,5 @@ void drawIconNGP(int Xpos, int Ypos);
 void drawIconCPC(int Xpos, int Ypos);
 void drawIconVID(int Xpos, int Ypos);
 void drawIconIMG(int Xpos, int Ypos);
-void execDeferredIconUpdates();
 void writeBannerText(std::string_view text);
 void writeBannerText(std::u16string text);
@@ -8,6 +8,8 @@
 
 #include "common/twlmenusettings.h"
 #include "common/inifile.h"
+#include "common/fnv1a.h"
+#include "common/langPack.h"
 
 #define STRING(what,def) std::string STR_##what;
 #include "language.inl"
@@ -103,10 +105,30 @@ std::string getString(CIniFile &ini, const std::string &item, const std::string
  */
 void langInit(void)
 {
-	char languageIniPath[64];
-	snprintf(languageIniPath, sizeof(languageIniPath), "nitro:/languages/%s/language.ini", ms().getGuiLanguageString().c_str());
+	const std::string languageName = ms().getGuiLanguageString();
 
-	CIniFile languageini(languageIniPath);
+	// Use the pack built from language.ini, if it was built from this language.inl
+	u32 idsHash = FNV1A_OFFSET_BASIS;
+	u32 count = 0;
+#define STRING(what,def) idsHash = fnv1aHash(#what "\n", idsHash); count++;
+#include "language.inl"
+#undef STRING
+
+	char languagePath[64];
+	snprintf(languagePath, sizeof(languagePath), "nitro:/languages/%s/language.bin", languageName.c_str());
+
+	LangPack pack;
+	if (pack.load(languagePath, idsHash, count)) {
+		u32 id = 0;
+#define STRING(what,def) STR_##what = pack.get(id++);
+#include "language.inl"
+#undef STRING
+		return;
+	}
+
+	snprintf(languagePath, sizeof(languagePath), "nitro:/languages/%s/language.ini", languageName.c_str());
+
+	CIniFile languageini(languagePath);
 
 #define STRING(what,def) STR_##what = getString(languageini, ""#what, def);
 #include "language.inl"
@@ -97,6 +97,11 @@ STRING(LAUNCH_SLOT_1, "Launch Slot-1 card")
 STRING(OPEN_MANUAL, "Open Manual")
 STRING(SELECT_B_BACK_A_SELECT, "SELECT/\\B Back, \\A Select")
 
+// Search
+STRING(SEARCH, "Search")
+STRING(SEARCH_FOUND, "%d found")
+STRING(SEARCH_CONTROLS, "\\D Type  \\B Delete\n\\L/\\R Choose  \\A Go")
+
 // AP
 STRING(AP_PATCH_RGF, "This game has AP (Anti-Piracy)\nand MUST be patched using the\nRGF TWiLight Menu AP patcher.")
 STRING(AP_USE_LATEST, "This game has AP (Anti-Piracy).\nPlease make sure you're\nusing the latest version of\nTWiLight Menu++.")
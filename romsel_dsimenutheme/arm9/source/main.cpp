@@ -4,6 +4,10 @@
 #include "io_g6_common.h"
 #include "io_sc_common.h"
 #include "exptools.h"
+#include "gbaNorFlash.h"
+#include "gbapatch/romScan.h"
+#include "gbapatch/romStream.h"
+#include "gbapatch/Save.h"
 
 #include <fat.h>
 #include "fat_ext.h"
@@ -32,6 +36,8 @@
 #include "myDSiMode.h"
 #include "graphics/ThemeConfig.h"
 #include "graphics/ThemeTextures.h"
+#include "graphics/RvidStream.h"
+#include "graphics/queueControl.h"
 #include "graphics/themefilenames.h"
 
 #include "defaultSettings.h"
@@ -54,11 +60,9 @@
 #include "language.h"
 
 #include "cheat.h"
-#include "crc.h"
+#include "common/crc32.h"
 
-#include "twlClockExcludeMap.h"
-#include "dmaExcludeMap.h"
-#include "asyncReadExcludeMap.h"
+#include "gameRules.h"
 #include "donorMap.h"
 #include "saveMap.h"
 #include "ROMList.h"
@@ -175,13 +179,9 @@ int SetDonorSDK() {
  */
 bool setClockSpeed() {
 	if (!ms().ignoreBlacklists) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(twlClockExcludeList)/sizeof(twlClockExcludeList[0]); i++) {
-			if (memcmp(gameTid[CURPOS], twlClockExcludeList[i], 3) == 0) {
-				// Found match
-				dsModeForced = true;
-				return false;
-			}
+		if (getGameRules(gameTid[CURPOS]) & GAMERULE_NO_TWL_CLOCK) {
+			dsModeForced = true;
+			return false;
 		}
 	}
 
@@ -193,12 +193,8 @@ bool setClockSpeed() {
  */
 bool setCardReadDMA() {
 	if (!ms().ignoreBlacklists) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(cardReadDMAExcludeList)/sizeof(cardReadDMAExcludeList[0]); i++) {
-			if (memcmp(gameTid[CURPOS], cardReadDMAExcludeList[i], 3) == 0) {
-				// Found match
-				return false;
-			}
+		if (getGameRules(gameTid[CURPOS]) & GAMERULE_NO_CARD_DMA) {
+			return false;
 		}
 	}
 
@@ -210,12 +206,8 @@ bool setCardReadDMA() {
  */
 bool setAsyncCardRead() {
 	if (!ms().ignoreBlacklists) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(asyncReadExcludeList)/sizeof(asyncReadExcludeList[0]); i++) {
-			if (memcmp(gameTid[CURPOS], asyncReadExcludeList[i], 3) == 0) {
-				// Found match
-				return false;
-			}
+		if (getGameRules(gameTid[CURPOS]) & GAMERULE_NO_ASYNC_READ) {
+			return false;
 		}
 	}
 
@@ -918,7 +910,9 @@ void bgOperations(bool waitFrame) {
 	drawCurrentTime();
 	drawCurrentDate();
 	snd().updateStream();
+	rotatingCubes().update();
 	if (waitFrame) {
+		execIdleTasks();
 		swiWaitForVBlank();
 	}
 }
@@ -1607,13 +1601,8 @@ int main(int argc, char **argv) {
 							u32 gameTidHex = 0;
 							tonccpy(&gameTidHex, &gameTid[CURPOS], 4);
 
-							for (int i = 0; i < (int)sizeof(ROMList)/12; i++) {
-								ROMListEntry* curentry = &ROMList[i];
-								if (gameTidHex == curentry->GameCode) {
-									if (curentry->SaveMemType != 0xFFFFFFFF) savesize = sramlen[curentry->SaveMemType];
-									break;
-								}
-							}
+							int saveMemType = lookupSaveInfo(gameTidHex);
+							if (saveMemType != -1) savesize = sramlen[saveMemType];
 
 							if ((orgsavesize == 0 && savesize > 0) || (orgsavesize < savesize)) {
 								if (ms().theme == TWLSettings::EThemeHBL) {
@@ -2110,7 +2099,6 @@ int main(int argc, char **argv) {
 						if (strncmp(titleID, "AGBJ", 4) == 0 && romSize <= 0x40000) {
 							ptr += 0x400;
 						}
-						u32 curPtr = ptr;
 						fseek(gbaFile, 0, SEEK_SET);
 
 						extern char copyBuf[0x8000];
@@ -2120,13 +2108,6 @@ int main(int argc, char **argv) {
 						if (*(u16*)(0x020000C0) == 0x5A45 && strncmp(titleID, "AGBJ", 4) != 0) {
 							cExpansion::SetRompage(0);
 							expansion().SetRampage(cExpansion::ENorPage);
-							cExpansion::OpenNorWrite();
-							cExpansion::SetSerialMode();
-							for (u32 address=0;address<romSize&&address<0x2000000;address+=0x40000) {
-								expansion().Block_Erase(address);
-								progressBarLength = (address+0x40000)/(romSize/192);
-								if (progressBarLength > 192) progressBarLength = 192;
-							}
 							nor = true;
 						} else if (*(u16*)(0x020000C0) == 0x4353 && romSize > 0x1FFFFFE) {
 							romSize = 0x1FFFFFE;
@@ -2136,21 +2117,20 @@ int main(int argc, char **argv) {
 						printLarge(false, 0, (ms().theme == TWLSettings::EThemeSaturn ? 80 : 88), STR_NOW_LOADING, Alignment::center);
 						updateText(false);
 
-						for (u32 len = romSize; len > 0; len -= 0x8000) {
-							if (fread(&copyBuf, 1, (len>0x8000 ? 0x8000 : len), gbaFile) > 0) {
-								s2RamAccess(true);
-								if (nor) {
-									expansion().WriteNorFlash(curPtr-ptr, (u8*)copyBuf, (len>0x8000 ? 0x8000 : len));
-								} else {
-									tonccpy((u16*)curPtr, &copyBuf, (len>0x8000 ? 0x8000 : len));
-								}
-								s2RamAccess(false);
-								curPtr += 0x8000;
-								progressBarLength = ((curPtr-ptr)+0x8000)/(romSize/192);
+						if (nor) {
+							// Only writes what isn't already in the NOR
+							gbaNorFlash(gbaFile, filename.c_str(), romSize, (u8*)copyBuf, [](u32 done, u32 total) {
+								progressBarLength = done/(total/192);
 								if (progressBarLength > 192) progressBarLength = 192;
-							} else {
-								break;
-							}
+							});
+						} else {
+							// Scanned and patched as it's loaded, so gbapatcher needn't read it all back
+							save_addScanPatterns();
+							romStream_load(gbaFile, ptr, romSize, strncmp(titleID, "MB2G", 4) != 0, (u8*)copyBuf, [](u32 done, u32 total) {
+								progressBarLength = done/(total/192);
+								if (progressBarLength > 192) progressBarLength = 192;
+							});
+							romScan_save(filename.c_str());
 						}
 						fclose(gbaFile);
 
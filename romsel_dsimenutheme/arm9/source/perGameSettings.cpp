@@ -29,6 +29,7 @@
 #include "gbaswitch.h"
 
 #include "common/inifile.h"
+#include "gamesettings/gameSettingsDb.h"
 #include "common/flashcard.h"
 #include "common/nds_loader_arm9.h"
 #include "common/twlmenusettings.h"
@@ -37,9 +38,7 @@
 #include "defaultSettings.h"
 #include "myDSiMode.h"
 
-#include "twlClockExcludeMap.h"
-#include "dmaExcludeMap.h"
-#include "asyncReadExcludeMap.h"
+#include "gameRules.h"
 
 #define SCREEN_COLS 32
 #define ENTRIES_PER_SCREEN 15
@@ -83,8 +82,6 @@ std::string setAsDonorRom = "";
 
 extern int file_count;
 
-char pergamefilepath[256];
-
 extern void RemoveTrailingSlashes(std::string &path);
 
 extern std::string dirContName;
@@ -102,6 +99,8 @@ char fileCounter[8];
 char gameTIDText[16];
 char saveNoDisplay[8];
 
+GameSettingsRecord pageGameSettings[40];
+
 int firstPerGameOpShown = 0;
 int perGameOps = -1;
 int perGameOp[10] = {-1};
@@ -113,140 +112,119 @@ bool blacklisted_asyncCardRead = false;
 bool extension(const std::string_view filename, const std::vector<std::string_view> extensions);
 
 void loadPerGameSettings (std::string filename) {
-	snprintf(pergamefilepath, sizeof(pergamefilepath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", (ms().secondaryDevice ? "fat:" : "sd:"), filename.c_str());
-	CIniFile pergameini( pergamefilepath );
-	perGameSettings_directBoot = pergameini.GetInt("GAMESETTINGS", "DIRECT_BOOT", (isModernHomebrew[CURPOS] || ms().secondaryDevice));	// Homebrew only
+	GameSettings pergameini((ms().secondaryDevice ? "fat:" : "sd:"), filename, 0, &pageGameSettings[CURPOS]);
+	perGameSettings_directBoot = pergameini.GetInt(GAMESETTINGS_DIRECT_BOOT, (isModernHomebrew[CURPOS] || ms().secondaryDevice));	// Homebrew only
 	if (isHomebrew[CURPOS]) {
-		perGameSettings_dsiMode = pergameini.GetInt("GAMESETTINGS", "DSI_MODE", (isModernHomebrew[CURPOS] ? true : false));
+		perGameSettings_dsiMode = pergameini.GetInt(GAMESETTINGS_DSI_MODE, (isModernHomebrew[CURPOS] ? true : false));
 	} else {
-		perGameSettings_dsiMode = pergameini.GetInt("GAMESETTINGS", "DSI_MODE", -1);
+		perGameSettings_dsiMode = pergameini.GetInt(GAMESETTINGS_DSI_MODE, -1);
 	}
-	perGameSettings_language = pergameini.GetInt("GAMESETTINGS", "LANGUAGE", -2);
-	perGameSettings_region = pergameini.GetInt("GAMESETTINGS", "REGION", -2);
+	perGameSettings_language = pergameini.GetInt(GAMESETTINGS_LANGUAGE, -2);
+	perGameSettings_region = pergameini.GetInt(GAMESETTINGS_REGION, -2);
 	if (perGameSettings_region < -2 || (!dsiFeatures() && perGameSettings_region == -1)) perGameSettings_region = -2;
-	perGameSettings_saveNo = pergameini.GetInt("GAMESETTINGS", "SAVE_NUMBER", 0);
-	perGameSettings_ramDiskNo = pergameini.GetInt("GAMESETTINGS", "RAM_DISK", -1);
-	perGameSettings_boostCpu = pergameini.GetInt("GAMESETTINGS", "BOOST_CPU", -1);
-	perGameSettings_boostVram = pergameini.GetInt("GAMESETTINGS", "BOOST_VRAM", -1);
-	perGameSettings_cardReadDMA = pergameini.GetInt("GAMESETTINGS", "CARD_READ_DMA", -1);
-	perGameSettings_asyncCardRead = pergameini.GetInt("GAMESETTINGS", "ASYNC_CARD_READ", -1);
-	perGameSettings_bootstrapFile = pergameini.GetInt("GAMESETTINGS", "BOOTSTRAP_FILE", -1);
-	perGameSettings_wideScreen = pergameini.GetInt("GAMESETTINGS", "WIDESCREEN", -1);
-	perGameSettings_expandRomSpace = pergameini.GetInt("GAMESETTINGS", "EXTENDED_MEMORY", -1);
-	perGameSettings_dsiwareBooter = pergameini.GetInt("GAMESETTINGS", "DSIWARE_BOOTER", -1);
-	perGameSettings_useBootstrap = pergameini.GetInt("GAMESETTINGS", "USE_BOOTSTRAP", -1);
+	perGameSettings_saveNo = pergameini.GetInt(GAMESETTINGS_SAVE_NUMBER, 0);
+	perGameSettings_ramDiskNo = pergameini.GetInt(GAMESETTINGS_RAM_DISK, -1);
+	perGameSettings_boostCpu = pergameini.GetInt(GAMESETTINGS_BOOST_CPU, -1);
+	perGameSettings_boostVram = pergameini.GetInt(GAMESETTINGS_BOOST_VRAM, -1);
+	perGameSettings_cardReadDMA = pergameini.GetInt(GAMESETTINGS_CARD_READ_DMA, -1);
+	perGameSettings_asyncCardRead = pergameini.GetInt(GAMESETTINGS_ASYNC_CARD_READ, -1);
+	perGameSettings_bootstrapFile = pergameini.GetInt(GAMESETTINGS_BOOTSTRAP_FILE, -1);
+	perGameSettings_wideScreen = pergameini.GetInt(GAMESETTINGS_WIDESCREEN, -1);
+	perGameSettings_expandRomSpace = pergameini.GetInt(GAMESETTINGS_EXTENDED_MEMORY, -1);
+	perGameSettings_dsiwareBooter = pergameini.GetInt(GAMESETTINGS_DSIWARE_BOOTER, -1);
+	perGameSettings_useBootstrap = pergameini.GetInt(GAMESETTINGS_USE_BOOTSTRAP, -1);
 
 	// Check if blacklisted
 	blacklisted_boostCpu = false;
 	blacklisted_cardReadDma = false;
 	blacklisted_asyncCardRead = false;
 	if (!ms().ignoreBlacklists) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(twlClockExcludeList)/sizeof(twlClockExcludeList[0]); i++) {
-			if (memcmp(gameTid[CURPOS], twlClockExcludeList[i], 3) == 0) {
-				// Found match
-				blacklisted_boostCpu = true;
-			}
-		}
-
-		for (unsigned int i = 0; i < sizeof(cardReadDMAExcludeList)/sizeof(cardReadDMAExcludeList[0]); i++) {
-			if (memcmp(gameTid[CURPOS], cardReadDMAExcludeList[i], 3) == 0) {
-				// Found match
-				blacklisted_cardReadDma = true;
-			}
-		}
-
-		for (unsigned int i = 0; i < sizeof(asyncReadExcludeList)/sizeof(asyncReadExcludeList[0]); i++) {
-			if (memcmp(gameTid[CURPOS], asyncReadExcludeList[i], 3) == 0) {
-				// Found match
-				blacklisted_asyncCardRead = true;
-			}
-		}
+		const u32 gameRules = getGameRules(gameTid[CURPOS]);
+		blacklisted_boostCpu = (gameRules & GAMERULE_NO_TWL_CLOCK);
+		blacklisted_cardReadDma = (gameRules & GAMERULE_NO_CARD_DMA);
+		blacklisted_asyncCardRead = (gameRules & GAMERULE_NO_ASYNC_READ);
 	}
 }
 
 void savePerGameSettings (std::string filename) {
-	snprintf(pergamefilepath, sizeof(pergamefilepath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", (ms().secondaryDevice ? "fat:" : "sd:"), filename.c_str());
-	CIniFile pergameini( pergamefilepath );
+	u32 tid;
+	tonccpy(&tid, gameTid[CURPOS], sizeof(tid));
+	GameSettings pergameini((ms().secondaryDevice ? "fat:" : "sd:"), filename, tid, &pageGameSettings[CURPOS]);
 	if (isHomebrew[CURPOS]) {
-		pergameini.SetInt("GAMESETTINGS", "LANGUAGE", perGameSettings_language);
+		pergameini.SetInt(GAMESETTINGS_LANGUAGE, perGameSettings_language);
 		if (isModernHomebrew[CURPOS]) {
-			pergameini.SetInt("GAMESETTINGS", "REGION", perGameSettings_region);
+			pergameini.SetInt(GAMESETTINGS_REGION, perGameSettings_region);
 		}
-		if (!ms().secondaryDevice) pergameini.SetInt("GAMESETTINGS", "RAM_DISK", perGameSettings_ramDiskNo);
-		pergameini.SetInt("GAMESETTINGS", "DIRECT_BOOT", perGameSettings_directBoot);
+		if (!ms().secondaryDevice) pergameini.SetInt(GAMESETTINGS_RAM_DISK, perGameSettings_ramDiskNo);
+		pergameini.SetInt(GAMESETTINGS_DIRECT_BOOT, perGameSettings_directBoot);
 		if (isDSiMode() || !ms().secondaryDevice) {
-			pergameini.SetInt("GAMESETTINGS", "DSI_MODE", perGameSettings_dsiMode);
+			pergameini.SetInt(GAMESETTINGS_DSI_MODE, perGameSettings_dsiMode);
 		}
 		if (dsiFeatures()) {
-			if (!blacklisted_boostCpu) pergameini.SetInt("GAMESETTINGS", "BOOST_CPU", perGameSettings_boostCpu);
-			pergameini.SetInt("GAMESETTINGS", "BOOST_VRAM", perGameSettings_boostVram);
+			if (!blacklisted_boostCpu) pergameini.SetInt(GAMESETTINGS_BOOST_CPU, perGameSettings_boostCpu);
+			pergameini.SetInt(GAMESETTINGS_BOOST_VRAM, perGameSettings_boostVram);
 		}
 		if (!ms().secondaryDevice) {
-			pergameini.SetInt("GAMESETTINGS", "BOOTSTRAP_FILE", perGameSettings_bootstrapFile);
+			pergameini.SetInt(GAMESETTINGS_BOOTSTRAP_FILE, perGameSettings_bootstrapFile);
 		}
 		if (dsiFeatures() && ms().consoleModel >= 2 && sdFound()) {
-			pergameini.SetInt("GAMESETTINGS", "WIDESCREEN", perGameSettings_wideScreen);
+			pergameini.SetInt(GAMESETTINGS_WIDESCREEN, perGameSettings_wideScreen);
 		}
 	} else {
-		if ((perGameSettings_useBootstrap == -1 ? ms().useBootstrap : perGameSettings_useBootstrap) || (dsiFeatures() && unitCode[CURPOS] > 0) || isDSiWare[CURPOS] || !ms().secondaryDevice) pergameini.SetInt("GAMESETTINGS", "LANGUAGE", perGameSettings_language);
+		if ((perGameSettings_useBootstrap == -1 ? ms().useBootstrap : perGameSettings_useBootstrap) || (dsiFeatures() && unitCode[CURPOS] > 0) || isDSiWare[CURPOS] || !ms().secondaryDevice) pergameini.SetInt(GAMESETTINGS_LANGUAGE, perGameSettings_language);
 		if (!isDSiWare[CURPOS] && ((perGameSettings_useBootstrap == -1 ? (perGameSettings_useBootstrap == -1 ? ms().useBootstrap : perGameSettings_useBootstrap) : perGameSettings_useBootstrap) || (dsiFeatures() && unitCode[CURPOS] > 0) || !ms().secondaryDevice)) {
-			pergameini.SetInt("GAMESETTINGS", "REGION", perGameSettings_region);
-			pergameini.SetInt("GAMESETTINGS", "DSI_MODE", perGameSettings_dsiMode);
+			pergameini.SetInt(GAMESETTINGS_REGION, perGameSettings_region);
+			pergameini.SetInt(GAMESETTINGS_DSI_MODE, perGameSettings_dsiMode);
 		} else if (isDSiWare[CURPOS]) {
-			pergameini.SetInt("GAMESETTINGS", "REGION", perGameSettings_region);
+			pergameini.SetInt(GAMESETTINGS_REGION, perGameSettings_region);
 		}
-		pergameini.SetInt("GAMESETTINGS", "SAVE_NUMBER", perGameSettings_saveNo);
+		pergameini.SetInt(GAMESETTINGS_SAVE_NUMBER, perGameSettings_saveNo);
 		if (dsiFeatures()) {
-			if (!blacklisted_boostCpu) pergameini.SetInt("GAMESETTINGS", "BOOST_CPU", perGameSettings_boostCpu);
-			pergameini.SetInt("GAMESETTINGS", "BOOST_VRAM", perGameSettings_boostVram);
-			if (!blacklisted_cardReadDma) pergameini.SetInt("GAMESETTINGS", "CARD_READ_DMA", perGameSettings_cardReadDMA);
+			if (!blacklisted_boostCpu) pergameini.SetInt(GAMESETTINGS_BOOST_CPU, perGameSettings_boostCpu);
+			pergameini.SetInt(GAMESETTINGS_BOOST_VRAM, perGameSettings_boostVram);
+			if (!blacklisted_cardReadDma) pergameini.SetInt(GAMESETTINGS_CARD_READ_DMA, perGameSettings_cardReadDMA);
 		}
 		if (!ms().secondaryDevice) {
-			if (!blacklisted_asyncCardRead) pergameini.SetInt("GAMESETTINGS", "ASYNC_CARD_READ", perGameSettings_asyncCardRead);
+			if (!blacklisted_asyncCardRead) pergameini.SetInt(GAMESETTINGS_ASYNC_CARD_READ, perGameSettings_asyncCardRead);
 		} else {
-			pergameini.SetInt("GAMESETTINGS", "USE_BOOTSTRAP", perGameSettings_useBootstrap);
+			pergameini.SetInt(GAMESETTINGS_USE_BOOTSTRAP, perGameSettings_useBootstrap);
 		}
 		if ((perGameSettings_useBootstrap == -1 ? ms().useBootstrap : perGameSettings_useBootstrap) || (dsiFeatures() && unitCode[CURPOS] > 0) || isDSiWare[CURPOS] || !ms().secondaryDevice) {
-			pergameini.SetInt("GAMESETTINGS", "BOOTSTRAP_FILE", perGameSettings_bootstrapFile);
+			pergameini.SetInt(GAMESETTINGS_BOOTSTRAP_FILE, perGameSettings_bootstrapFile);
 		}
 		if (dsiFeatures() && ms().consoleModel >= 2 && sdFound()) {
-			pergameini.SetInt("GAMESETTINGS", "WIDESCREEN", perGameSettings_wideScreen);
+			pergameini.SetInt(GAMESETTINGS_WIDESCREEN, perGameSettings_wideScreen);
 		}
 		if ((dsiFeatures() && (perGameSettings_useBootstrap ? ms().useBootstrap : perGameSettings_useBootstrap)) || !ms().secondaryDevice) {
-			pergameini.SetInt("GAMESETTINGS", "EXTENDED_MEMORY", perGameSettings_expandRomSpace);
+			pergameini.SetInt(GAMESETTINGS_EXTENDED_MEMORY, perGameSettings_expandRomSpace);
 		}
 		if (isDSiWare[CURPOS] && !sys().arm7SCFGLocked() && ms().consoleModel == TWLSettings::EDSiRetail) {
-			pergameini.SetInt("GAMESETTINGS", "DSIWARE_BOOTER", perGameSettings_dsiwareBooter);
+			pergameini.SetInt(GAMESETTINGS_DSIWARE_BOOTER, perGameSettings_dsiwareBooter);
 		}
 	}
-	pergameini.SaveIniFile( pergamefilepath );
+	pergameini.Save();
 }
 
 bool checkIfShowAPMsg (std::string filename) {
-	snprintf(pergamefilepath, sizeof(pergamefilepath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", (ms().secondaryDevice ? "fat:" : "sd:"), filename.c_str());
-	CIniFile pergameini( pergamefilepath );
-	return (pergameini.GetInt("GAMESETTINGS", "NO_SHOW_AP_MSG", 0) == 0);
+	GameSettings pergameini((ms().secondaryDevice ? "fat:" : "sd:"), filename, 0, &pageGameSettings[CURPOS]);
+	return (pergameini.GetInt(GAMESETTINGS_NO_SHOW_AP_MSG, 0) == 0);
 }
 
 void dontShowAPMsgAgain (std::string filename) {
-	snprintf(pergamefilepath, sizeof(pergamefilepath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", (ms().secondaryDevice ? "fat:" : "sd:"), filename.c_str());
-	CIniFile pergameini( pergamefilepath );
-	pergameini.SetInt("GAMESETTINGS", "NO_SHOW_AP_MSG", 1);
-	pergameini.SaveIniFile( pergamefilepath );
+	GameSettings pergameini((ms().secondaryDevice ? "fat:" : "sd:"), filename, 0, &pageGameSettings[CURPOS]);
+	pergameini.SetInt(GAMESETTINGS_NO_SHOW_AP_MSG, 1);
+	pergameini.Save();
 }
 
 bool checkIfShowRAMLimitMsg (std::string filename) {
-	snprintf(pergamefilepath, sizeof(pergamefilepath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", (ms().secondaryDevice ? "fat:" : "sd:"), filename.c_str());
-	CIniFile pergameini( pergamefilepath );
-	return (pergameini.GetInt("GAMESETTINGS", "NO_SHOW_RAM_LIMIT", 0) == 0);
+	GameSettings pergameini((ms().secondaryDevice ? "fat:" : "sd:"), filename, 0, &pageGameSettings[CURPOS]);
+	return (pergameini.GetInt(GAMESETTINGS_NO_SHOW_RAM_LIMIT_MSG, 0) == 0);
 }
 
 void dontShowRAMLimitMsgAgain (std::string filename) {
-	snprintf(pergamefilepath, sizeof(pergamefilepath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", (ms().secondaryDevice ? "fat:" : "sd:"), filename.c_str());
-	CIniFile pergameini( pergamefilepath );
-	pergameini.SetInt("GAMESETTINGS", "NO_SHOW_RAM_LIMIT_MSG", 1);
-	pergameini.SaveIniFile( pergamefilepath );
+	GameSettings pergameini((ms().secondaryDevice ? "fat:" : "sd:"), filename, 0, &pageGameSettings[CURPOS]);
+	pergameini.SetInt(GAMESETTINGS_NO_SHOW_RAM_LIMIT_MSG, 1);
+	pergameini.Save();
 }
 
 bool checkIfDSiMode (std::string filename) {
@@ -254,9 +232,8 @@ bool checkIfDSiMode (std::string filename) {
 		return false;
 	}
 
-	snprintf(pergamefilepath, sizeof(pergamefilepath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", (ms().secondaryDevice ? "fat:" : "sd:"), filename.c_str());
-	CIniFile pergameini( pergamefilepath );
-	perGameSettings_dsiMode = pergameini.GetInt("GAMESETTINGS", "DSI_MODE", (isModernHomebrew[CURPOS] ? true : -1));
+	GameSettings pergameini((ms().secondaryDevice ? "fat:" : "sd:"), filename, 0, &pageGameSettings[CURPOS]);
+	perGameSettings_dsiMode = pergameini.GetInt(GAMESETTINGS_DSI_MODE, (isModernHomebrew[CURPOS] ? true : -1));
 	if (perGameSettings_dsiMode == -1) {
 		return DEFAULT_DSI_MODE;
 	} else {
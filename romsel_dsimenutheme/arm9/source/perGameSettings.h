@@ -2,6 +2,7 @@
 #define PERGAMESETTINGS_H
 
 #include <string>
+#include "gamesettings/gameSettingsDb.h"
 
 extern bool perGameSettingsButtons;
 
@@ -22,6 +23,9 @@ extern int perGameSettings_useBootstrap;
 
 extern char fileCounter[8];
 
+// The settings of each game on the page shown, as getFileInfo() looked them up
+extern GameSettingsRecord pageGameSettings[40];
+
 void loadPerGameSettings(std::string filename);
 void savePerGameSettings(std::string filename);
 bool checkIfShowAPMsg (std::string filename);
@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+# -*- coding: utf8 -*-
+# Convert an uncompressed rvid (such as 3dsRotatingCubes.rvid) to rvid v2
+#
+# Each frame is stored as a list of SKIP/COPY/FILL ops against the frame
+# before it, with an intra frame (one that doesn't depend on the last) every
+# so often. See romsel_dsimenutheme/arm9/source/graphics/RvidStream.h for
+# the layout, which this must be kept in sync with.
+
+import argparse
+import struct
+import sys
+
+V1_HEADER_SIZE = 0x200
+WIDTH = 256
+
+OP_SKIP = 0
+OP_COPY = 1
+OP_FILL = 2
+MAX_COUNT = 0x4000
+
+FRAME_INTRA = 1 << 31
+
+HEADER = struct.Struct('<4sIHHB3xI12x')
+FRAME_INFO = struct.Struct('<II')
+
+
+def op(kind, count):
+	return struct.pack('<H', (kind << 14) | (count - 1))
+
+
+def encodeFrame(frame, prev):
+	"""Encode one frame, as an intra frame if prev is None."""
+	out = bytearray()
+	literal = []
+	pixels = len(frame)
+
+	def flushLiteral():
+		while literal:
+			chunk = literal[:MAX_COUNT]
+			del literal[:MAX_COUNT]
+			out.extend(op(OP_COPY, len(chunk)))
+			out.extend(struct.pack('<%dH' % len(chunk), *chunk))
+
+	def emitRun(kind, count, value=None):
+		flushLiteral()
+		while count > 0:
+			n = min(count, MAX_COUNT)
+			out.extend(op(kind, n))
+			if value is not None:
+				out.extend(struct.pack('<H', value))
+			count -= n
+
+	i = 0
+	while i < pixels:
+		# Pixels the same as the last frame (a single one costs as much as copying it)
+		if prev is not None:
+			j = i
+			while j < pixels and frame[j] == prev[j]:
+				j += 1
+			if j - i >= 2:
+				emitRun(OP_SKIP, j - i)
+				i = j
+				continue
+
+		# Pixels of the same color
+		j = i + 1
+		while j < pixels and frame[j] == frame[i]:
+			j += 1
+		if j - i >= 3:
+			emitRun(OP_FILL, j - i, frame[i])
+			i = j
+			continue
+
+		literal.append(frame[i])
+		i += 1
+
+	flushLiteral()
+	return bytes(out)
+
+
+def main():
+	parser = argparse.ArgumentParser(description='Convert an uncompressed rvid to rvid v2, for streaming in the 3DS theme')
+	parser.add_argument('input', help='uncompressed rvid file')
+	parser.add_argument('output', help='rvid v2 file to write')
+	parser.add_argument('--height', type=int, default=56, help='frame height in pixels (default: 56)')
+	parser.add_argument('--fps', type=int, default=25, help='frames per second (default: 25)')
+	parser.add_argument('--keyframe-interval', type=int, default=50, help='frames between intra frames, 0 for only the first (default: 50)')
+	args = parser.parse_args()
+
+	with open(args.input, 'rb') as f:
+		data = f.read()
+
+	if data[:4] == b'RVD2':
+		sys.exit('%s: already rvid v2' % args.input)
+
+	frameBytes = WIDTH * args.height * 2
+	count = (len(data) - V1_HEADER_SIZE) // frameBytes
+	if count <= 0:
+		sys.exit('%s: no frames found' % args.input)
+
+	frames = []
+	prev = None
+	for n in range(count):
+		start = V1_HEADER_SIZE + n * frameBytes
+		frame = struct.unpack_from('<%dH' % (WIDTH * args.height), data, start)
+
+		intra = encodeFrame(frame, None)
+		if n == 0 or (args.keyframe_interval > 0 and n % args.keyframe_interval == 0):
+			frames.append((intra, True))
+		else:
+			# Fall back to intra if a delta would be no smaller
+			delta = encodeFrame(frame, prev)
+			frames.append((delta, False) if len(delta) < len(intra) else (intra, True))
+		prev = frame
+
+	maxFrameSize = max(len(frame) for frame, _ in frames)
+	offset = HEADER.size + FRAME_INFO.size * count
+
+	with open(args.output, 'wb') as f:
+		f.write(HEADER.pack(b'RVD2', count, WIDTH, args.height, args.fps, maxFrameSize))
+		for frame, intra in frames:
+			f.write(FRAME_INFO.pack(offset, len(frame) | (FRAME_INTRA if intra else 0)))
+			offset += len(frame)
+		for frame, _ in frames:
+			f.write(frame)
+
+	total = sum(len(frame) for frame, _ in frames)
+	print('%s: %d frames, %d bytes -> %d bytes, largest frame %d bytes' % (args.output, count, count * frameBytes, HEADER.size + FRAME_INFO.size * count + total, maxFrameSize))
+
+
+if __name__ == '__main__':
+	main()
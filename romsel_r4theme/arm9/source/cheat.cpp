@@ -29,7 +29,6 @@
 #include "iconTitle.h"
 #include "graphics/fontHandler.h"
 #include "errorScreen.h"
-#include "common/tonccpy.h"
 #include "common/twlmenusettings.h"
 #include "perGameSettings.h"
 
@@ -37,27 +36,6 @@ extern int dialogboxHeight;
 
 extern void bgOperations(bool waitFrame);
 
-CheatCodelist::~CheatCodelist(void) {}
-
-inline u32 gamecode(const char *aGameCode)
-{
-  u32 gameCode;
-  memcpy(&gameCode, aGameCode, sizeof(gameCode));
-  return gameCode;
-}
-
-#define CRCPOLY 0xedb88320
-static u32 crc32(const u8* p,size_t len)
-{
-  u32 crc=-1;
-  while (len--)
-  {
-    crc^=*p++;
-    for (int ii=0;ii<8;++ii) crc=(crc>>1)^((crc&1)?CRCPOLY:0);
-  }
-  return crc;
-}
-
 bool CheatCodelist::parse(const std::string& aFileName)
 {
   bool res=false;
@@ -85,185 +63,15 @@ bool CheatCodelist::parse(const std::string& aFileName)
   return res;
 }
 
-bool CheatCodelist::searchCheatData(FILE* aDat,u32 gamecode,u32 crc32,long& aPos,size_t& aSize)
-{
-  aPos=0;
-  aSize=0;
-  const char* KHeader="R4 CheatCode";
-  char header[12];
-  fread(header,12,1,aDat);
-  if (strncmp(KHeader,header,12)) return false;
-
-  sDatIndex idx,nidx;
-
-  fseek(aDat,0,SEEK_END);
-  long fileSize=ftell(aDat);
-
-  fseek(aDat,0x100,SEEK_SET);
-  fread(&nidx,sizeof(nidx),1,aDat);
-
-  bool done=false;
-
-  while (!done)
-  {
-    tonccpy(&idx,&nidx,sizeof(idx));
-    fread(&nidx,sizeof(nidx),1,aDat);
-    if (gamecode==idx._gameCode&&crc32==idx._crc32)
-    {
-      aSize=((nidx._offset)?nidx._offset:fileSize)-idx._offset;
-      aPos=idx._offset;
-      done=true;
-    }
-    if (!nidx._offset) done=true;
-  }
-  return (aPos&&aSize);
-}
-
-bool CheatCodelist::parseInternal(FILE* aDat,u32 gamecode,u32 crc32)
-{
-  // dbg_printf("%x, %x\n",gamecode,crc32);
-
-  _data.clear();
-
-  long dataPos; size_t dataSize;
-  if (!searchCheatData(aDat,gamecode,crc32,dataPos,dataSize)) return false;
-  fseek(aDat,dataPos,SEEK_SET);
-
-  // dbg_printf("record found: %d\n",dataSize);
-
-  char* buffer=(char*)malloc(dataSize);
-  if (!buffer) return false;
-  fread(buffer,dataSize,1,aDat);
-  char* gameTitle=buffer;
-
-  u32* ccode=(u32*)(((u32)gameTitle+strlen(gameTitle)+4)&~3);
-  u32 cheatCount=*ccode;
-  cheatCount&=0x0fffffff;
-  ccode+=9;
-
-  u32 cc=0;
-  while (cc<cheatCount)
-  {
-    u32 folderCount=1;
-    char* folderName=NULL;
-    char* folderNote=NULL;
-    u32 flagItem=0;
-    if ((*ccode>>28)&1)
-    {
-      flagItem|=cParsedItem::EInFolder;
-      if ((*ccode>>24)==0x11) flagItem|=cParsedItem::EOne;
-      folderCount=*ccode&0x00ffffff;
-      folderName=(char*)((u32)ccode+4);
-      folderNote=(char*)((u32)folderName+strlen(folderName)+1);
-      _data.push_back(cParsedItem(folderName,folderNote,cParsedItem::EFolder));
-      cc++;
-      ccode=(u32*)(((u32)folderName+strlen(folderName)+1+strlen(folderNote)+1+3)&~3);
-    }
-
-    u32 selectValue=cParsedItem::ESelected;
-    for (size_t ii=0;ii<folderCount;++ii)
-    {
-      char* cheatName=(char*)((u32)ccode+4);
-      char* cheatNote=(char*)((u32)cheatName+strlen(cheatName)+1);
-      u32* cheatData=(u32*)(((u32)cheatNote+strlen(cheatNote)+1+3)&~3);
-      u32 cheatDataLen=*cheatData++;
-
-      if (cheatDataLen)
-      {
-        _data.push_back(cParsedItem(cheatName,cheatNote,flagItem|((*ccode&0xff000000)?selectValue:0),dataPos+(((char*)ccode+3)-buffer)));
-        if ((*ccode&0xff000000)&&(flagItem&cParsedItem::EOne)) selectValue=0;
-        _data.back()._cheat.resize(cheatDataLen);
-        tonccpy(_data.back()._cheat.data(),cheatData,cheatDataLen*4);
-      }
-      cc++;
-      ccode=(u32*)((u32)ccode+(((*ccode&0x00ffffff)+1)*4));
-    }
-  }
-  free(buffer);
-  generateList();
-  return true;
-}
-
-void CheatCodelist::generateList(void)
-{
-  _indexes.clear();
-  // _List.removeAllRows();
-
-  std::vector<cParsedItem>::iterator itr=_data.begin();
-  while (itr!=_data.end())
-  {
-    std::vector<std::string> row;
-    row.push_back("");
-    row.push_back((*itr)._title);
-    // _List.insertRow(_List.getRowCount(),row);
-    _indexes.push_back(itr-_data.begin());
-    u32 flags=(*itr)._flags;
-    ++itr;
-    if ((flags&cParsedItem::EFolder)&&(flags&cParsedItem::EOpen)==0)
-    {
-      while (((*itr)._flags&cParsedItem::EInFolder)&&itr!=_data.end()) ++itr;
-    }
-  }
-}
-
-void CheatCodelist::deselectFolder(size_t anIndex)
-{
-  std::vector<cParsedItem>::iterator itr=_data.begin()+anIndex;
-  while (--itr>=_data.begin())
-  {
-    if ((*itr)._flags&cParsedItem::EFolder)
-    {
-      ++itr;
-      break;
-    }
-  }
-  while (((*itr)._flags&cParsedItem::EInFolder)&&itr!=_data.end())
-  {
-    (*itr)._flags&=~cParsedItem::ESelected;
-    ++itr;
-  }
-}
-
-bool CheatCodelist::romData(const std::string& aFileName,u32& aGameCode,u32& aCrc32)
-{
-  bool res=false;
-  FILE* rom=fopen(aFileName.c_str(),"rb");
-  if (rom)
-  {
-    u8 header[512];
-    if (1==fread(header,sizeof(header),1,rom))
-    {
-      aCrc32=crc32(header,sizeof(header));
-      aGameCode=gamecode((const char*)(header+12));
-      res=true;
-    }
-    fclose(rom);
-  }
-  return res;
-}
-
-std::vector<u32> CheatCodelist::getCheats()
-{
-  std::vector<u32> cheats;
-  for (uint i=0;i<_data.size();i++)
-  {
-    if (_data[i]._flags&cParsedItem::ESelected)
-    {
-      cheats.insert(cheats.end(),_data[i]._cheat.begin(),_data[i]._cheat.end());
-    }
-  }
-  return cheats;
-}
-
 void CheatCodelist::drawCheatList(std::vector<CheatCodelist::cParsedItem *>& list, uint curPos, uint screenPos, uint scrollPos) {
   for (uint i=0;(int)i<(dialogboxHeight+2) && i<list.size();i++) {
     if (list[screenPos+i]->_flags&cParsedItem::EFolder) {
       if (screenPos+i == curPos) {
         printSmall(false, 27, 90+(i*10), ">");
-        printSmall(false, 35, 90+(i*10), list[screenPos+i]->_title.c_str() + scrollPos);
+        printSmall(false, 35, 90+(i*10), title(*list[screenPos+i]) + scrollPos);
       } else {
         printSmall(false, 22, 90+(i*10), ">");
-        printSmall(false, 30, 90+(i*10), list[screenPos+i]->_title.c_str());
+        printSmall(false, 30, 90+(i*10), title(*list[screenPos+i]));
       }
     } else {
       if (list[screenPos+i]->_flags&cParsedItem::ESelected) {
@@ -271,10 +79,10 @@ void CheatCodelist::drawCheatList(std::vector<CheatCodelist::cParsedItem *>& lis
       }
       if (screenPos+i == curPos) {
         printSmall(false, 25, 90+(i*10), "-");
-        printSmall(false, 32, 90+(i*10), list[screenPos+i]->_title.c_str() + scrollPos);
+        printSmall(false, 32, 90+(i*10), title(*list[screenPos+i]) + scrollPos);
       } else {
         printSmall(false, 21, 90+(i*10), "-");
-        printSmall(false, 28, 90+(i*10), list[screenPos+i]->_title.c_str());
+        printSmall(false, 28, 90+(i*10), title(*list[screenPos+i]));
       }
     }
   }
@@ -335,7 +143,7 @@ void CheatCodelist::selectCheats(std::string filename)
     printLargeCentered(false, 74, "Cheats");
 
     // Print bottom text
-    if (currentList[cheatWnd_cursorPosition]->_comment != "") {
+    if (*comment(*currentList[cheatWnd_cursorPosition])) {
       if (currentList[cheatWnd_cursorPosition]->_flags&cParsedItem::EFolder) {
         printSmallCentered(false, 167, "A: Open Y: Info X: Save B: Cancel");
       } else if (currentList[cheatWnd_cursorPosition]->_flags&cParsedItem::ESelected) {
@@ -370,7 +178,7 @@ void CheatCodelist::selectCheats(std::string filename)
       if (cheatWnd_scrollTimer > 0) {
         cheatWnd_scrollTimer--;
       } else {
-        if ((cheatWnd_scrollDirection == 1 && cheatWnd_scrollPosition < (int)currentList[cheatWnd_cursorPosition]->_title.length() - 40)
+        if ((cheatWnd_scrollDirection == 1 && cheatWnd_scrollPosition < (int)strlen(title(*currentList[cheatWnd_cursorPosition])) - 40)
         || (cheatWnd_scrollDirection == -1 && cheatWnd_scrollPosition > 0)) {
           cheatWnd_scrollPosition += cheatWnd_scrollDirection;
           cheatWnd_scrollTimer = 6;
@@ -405,11 +213,21 @@ void CheatCodelist::selectCheats(std::string filename)
         cheatWnd_scrollPosition = 0;
     } else if (pressed & KEY_A) {
       if (currentList[cheatWnd_cursorPosition]->_flags&cParsedItem::EFolder) {
-        uint i = std::distance(&_data[0], currentList[cheatWnd_cursorPosition]) + 1;
+        // Parsing the folder's cheats moves everything after it, so the list is made again
+        uint i = std::distance(&_data[0], currentList[cheatWnd_cursorPosition]);
+        openFolder(i);
         currentList.clear();
-        for (; !(_data[i]._flags & cParsedItem::EFolder) && i < _data.size(); i++) {
+        for (i++; i < _data.size() && (_data[i]._flags & cParsedItem::EInFolder); i++) {
           currentList.push_back(&_data[i]);
         }
+        if (currentList.empty()) {
+          for (uint j=0;j<_data.size();j++) {
+            if (!(_data[j]._flags&cParsedItem::EInFolder)) {
+              currentList.push_back(&_data[j]);
+            }
+          }
+          continue;
+        }
         mainListCurPos = cheatWnd_cursorPosition;
         mainListScreenPos = cheatWnd_screenPosition;
         cheatWnd_cursorPosition = 0;
@@ -448,13 +266,13 @@ void CheatCodelist::selectCheats(std::string filename)
       break;
     }
     if (pressed & KEY_Y) {
-      if (currentList[cheatWnd_cursorPosition]->_comment != "") {
+      if (*comment(*currentList[cheatWnd_cursorPosition])) {
         clearText();
         titleUpdate(isDirectory, filename.c_str());
         printLargeCentered(false, 74, "Cheats");
 
         std::vector<std::string> _topText;
-        std::string _topTextStr(currentList[cheatWnd_cursorPosition]->_comment);
+        std::string _topTextStr(comment(*currentList[cheatWnd_cursorPosition]));
         std::vector<std::string> words;
         std::size_t pos;
 
@@ -509,9 +327,7 @@ void CheatCodelist::selectCheats(std::string filename)
     }
     if (pressed & KEY_L) {
       // Delect all in the actual data so it doesn't just get the folder
-      for (auto itr = _data.begin(); itr != _data.end(); itr++) {
-        (*itr)._flags &= ~cParsedItem::ESelected;
-      }
+      deselectAll();
       // Also deselect them in the current list so that it updates the display
       for (auto itr = currentList.begin(); itr != currentList.end(); itr++) {
         (*itr)->_flags &= ~cParsedItem::ESelected;
@@ -521,20 +337,6 @@ void CheatCodelist::selectCheats(std::string filename)
   dialogboxHeight = oldDialogboxHeight;
 }
 
-static void updateDB(u8 value,u32 offset,FILE* db)
-{
-  u8 oldvalue;
-  if (!db) return;
-  if (!offset) return;
-  if (fseek(db,offset,SEEK_SET)) return;
-  if (fread(&oldvalue,sizeof(oldvalue),1,db)!=1) return;
-  if (oldvalue!=value)
-  {
-    if (fseek(db,offset,SEEK_SET)) return;
-    fwrite(&value,sizeof(value),1,db);
-  }
-}
-
 void CheatCodelist::onGenerate(void)
 {
   const char* usrcheatPath = (sdFound() || !ms().secondaryDevice) ? "sd:/_nds/TWiLightMenu/extras/usrcheat.dat" : "fat:/_nds/TWiLightMenu/extras/usrcheat.dat";
@@ -550,22 +352,7 @@ void CheatCodelist::onGenerate(void)
   FILE* db=fopen(usrcheatPath,"r+b");
   if (db)
   {
-    std::vector<cParsedItem>::iterator itr=_data.begin();
-    while (itr!=_data.end())
-    {
-      updateDB(((*itr)._flags&cParsedItem::ESelected)?1:0,(*itr)._offset,db);
-      ++itr;
-    }
+    writeSelection(db);
     fclose(db);
   }
 }
-
-void CheatCodelist::writeCheatsToFile(const char *path) {
-  FILE *file = fopen(path, "wb");
-  if (file) {
-    std::vector<u32> cheats(getCheats());
-    fwrite(cheats.data(),4,cheats.size(),file);
-    fwrite("\0\0\0\xCF",4,1,file);
-    fclose(file);
-  }
-}
@@ -50,13 +50,16 @@
 #include "SwitchState.h"
 #include "perGameSettings.h"
 #include "errorScreen.h"
-#include "incompatibleGameMap.h"
-#include "compatibleDSiWareMap.h"
+#include "gameRules.h"
 
 #include "gbaswitch.h"
 #include "myDSiMode.h"
 
+#include "common/directoryModel.h"
+#include "common/fileType.h"
 #include "common/inifile.h"
+#include "common/playStats.h"
+#include "common/titleIndex.h"
 
 #include "sound.h"
 #include "fileCopy.h"
@@ -84,7 +87,8 @@ extern bool startMenu;
 
 extern void bgOperations(bool waitFrame);
 
-std::string gameOrderIniPath, recentlyPlayedIniPath, timesPlayedIniPath;
+std::string gameOrderIniPath;
+static PlayStats playStats;
 
 char path[PATH_MAX] = {0};
 
@@ -103,15 +107,7 @@ static void gbnpBottomInfo(void) {
 
 extern std::string ReplaceAll(std::string str, const std::string& from, const std::string& to);
 
-struct DirEntry {
-	DirEntry(std::string name, bool isDirectory, int position, int customPos) : name(name), isDirectory(isDirectory), position(position), customPos(customPos) {}
-	DirEntry() {}
-
-	std::string name;
-	bool isDirectory;
-	int position;
-	bool customPos;
-};
+typedef DirectoryModel::Entry DirEntry;
 
 bool extension(const std::string_view filename, const std::vector<std::string_view> extensions) {
 	for (std::string_view extension : extensions) {
@@ -123,24 +119,20 @@ bool extension(const std::string_view filename, const std::vector<std::string_vi
 	return false;
 }
 
-bool nameEndsWith(const std::string_view name, const std::vector<std::string_view> extensionList) {
-	if (name.size() == 0)
+bool nameEndsWith(const char *name, const FileExtensionSet &extensions) {
+	if (name[0] == '\0')
 		return false;
 
-	if (extensionList.size() == 0)
+	if (extensions.empty())
 		return true;
 
-	if (name.substr(0, 2) == "._")
+	if (strncmp(name, "._", 2) == 0)
 		return false; // Don't show macOS's index files
 
-	for (const std::string_view &ext : extensionList) {
-		if (name.length() > ext.length() && strcasecmp(name.substr(name.length() - ext.length()).data(), ext.data()) == 0)
-			return true;
-	}
-	return false;
+	return extensions.matches(name);
 }
 
-bool dirEntryPredicate(const DirEntry &lhs, const DirEntry &rhs) {
+bool dirEntryPredicate(const DirectoryModel &dirContents, const DirEntry &lhs, const DirEntry &rhs) {
 	if (lhs.isDirectory && !lhs.customPos && !rhs.isDirectory) {
 		return true;
 	}
@@ -154,12 +146,13 @@ bool dirEntryPredicate(const DirEntry &lhs, const DirEntry &rhs) {
 		if (lhs.position < rhs.position)	return true;
 		else return false;
 	}
-	return strcasecmp(lhs.name.c_str(), rhs.name.c_str()) < 0;
+	return dirContents.compareNames(lhs, rhs) < 0;
 }
 
-void getDirectoryContents(std::vector<DirEntry> &dirContents, const std::vector<std::string_view> extensionList = {}) {
+void getDirectoryContents(DirectoryModel &dirContents, const std::vector<std::string_view> extensionList = {}) {
 	dirContents.clear();
 
+	const FileExtensionSet extensions(extensionList);
 	DIR *pdir = opendir(".");
 
 	if (pdir == nullptr) {
@@ -186,7 +179,7 @@ void getDirectoryContents(std::vector<DirEntry> &dirContents, const std::vector<
 			}
 
 			dirent *pent = readdir(pdir);
-			if (pent == nullptr || file_count > 320)
+			if (pent == nullptr)
 				break;
 
 			// Now that we've got the attrs and the name, skip if we should be hiding this
@@ -196,46 +189,44 @@ void getDirectoryContents(std::vector<DirEntry> &dirContents, const std::vector<
 			if (ms().showDirectories) {
 				if ((pent->d_type == DT_DIR && strcmp(pent->d_name, ".") != 0 && strcmp(pent->d_name, "_nds") != 0
 					&& strcmp(pent->d_name, "saves") != 0 && strcmp(pent->d_name, "ramdisks") != 0)
-					|| nameEndsWith(pent->d_name, extensionList)) {
-					dirContents.emplace_back(pent->d_name, pent->d_type == DT_DIR, file_count, false);
+					|| nameEndsWith(pent->d_name, extensions)) {
+					dirContents.add(pent->d_name, pent->d_type == DT_DIR, file_count);
 					file_count++;
 				}
 			} else {
-				if (pent->d_type != DT_DIR && nameEndsWith(pent->d_name, extensionList)) {
-					dirContents.emplace_back(pent->d_name, false, file_count, false);
+				if (pent->d_type != DT_DIR && nameEndsWith(pent->d_name, extensions)) {
+					dirContents.add(pent->d_name, false, file_count);
 					file_count++;
 				}
 			}
 		}
 
+		auto sortPredicate = [&dirContents](const DirEntry &lhs, const DirEntry &rhs) {
+			return dirEntryPredicate(dirContents, lhs, rhs);
+		};
+
 		if (ms().sortMethod == TWLSettings::ESortAlphabetical) { // Alphabetical
-			std::sort(dirContents.begin(), dirContents.end(), dirEntryPredicate);
+			std::sort(dirContents.begin(), dirContents.end(), sortPredicate);
 		} else if (ms().sortMethod == TWLSettings::ESortRecent) { // Recent
-			CIniFile recentlyPlayedIni(recentlyPlayedIniPath);
-			std::vector<std::string> recentlyPlayed;
 			getcwd(path, PATH_MAX);
-			recentlyPlayedIni.GetStringVector("RECENT", path, recentlyPlayed, ':');
+			playStats.openDir(path);
 
-			int i = 0;
-			for (const std::string &recentlyPlayedName : recentlyPlayed) {
-				for (DirEntry &dirEntry : dirContents) {
-					if (recentlyPlayedName == dirEntry.name) {
-						dirEntry.position = i++;
-						dirEntry.customPos = true;
-						break;
-					}
+			for (DirEntry &dirEntry : dirContents) {
+				int rank = playStats.recentRank(dirContents.name(dirEntry));
+				if (rank >= 0) {
+					dirEntry.position = rank;
+					dirEntry.customPos = true;
 				}
 			}
-			sort(dirContents.begin(), dirContents.end(), dirEntryPredicate);
+			sort(dirContents.begin(), dirContents.end(), sortPredicate);
 		} else if (ms().sortMethod == TWLSettings::ESortMostPlayed) { // Most Played
-			CIniFile timesPlayedIni(timesPlayedIniPath);
-
 			getcwd(path, PATH_MAX);
+			playStats.openDir(path);
 			for (DirEntry &dirEntry : dirContents) {
-				dirEntry.position = timesPlayedIni.GetInt(path, dirEntry.name, 0);
+				dirEntry.position = playStats.timesPlayed(dirContents.name(dirEntry));
 			}
 
-			std::sort(dirContents.begin(), dirContents.end(), [](const DirEntry &lhs, const DirEntry &rhs) {
+			std::sort(dirContents.begin(), dirContents.end(), [&dirContents](const DirEntry &lhs, const DirEntry &rhs) {
 					if (!lhs.isDirectory && rhs.isDirectory)
 						return false;
 					else if (lhs.isDirectory && !rhs.isDirectory)
@@ -246,18 +237,18 @@ void getDirectoryContents(std::vector<DirEntry> &dirContents, const std::vector<
 					else if (lhs.position < rhs.position)
 						return false;
 					else
-						return strcasecmp(lhs.name.c_str(), rhs.name.c_str()) < 0;
+						return dirContents.compareNames(lhs, rhs) < 0;
 				});
 		} else if (ms().sortMethod == TWLSettings::ESortFileType) { // File type
-			sort(dirContents.begin(), dirContents.end(), [](const DirEntry &lhs, const DirEntry &rhs) {
+			sort(dirContents.begin(), dirContents.end(), [&dirContents](const DirEntry &lhs, const DirEntry &rhs) {
 					if (!lhs.isDirectory && rhs.isDirectory)
 						return false;
 					else if (lhs.isDirectory && !rhs.isDirectory)
 						return true;
 
-					int extCmp = strcasecmp(lhs.name.substr(lhs.name.find_last_of('.') + 1).c_str(), rhs.name.substr(rhs.name.find_last_of('.') + 1).c_str());
+					int extCmp = dirContents.compareExtensions(lhs, rhs);
 					if (extCmp == 0)
-						return strcasecmp(lhs.name.c_str(), rhs.name.c_str()) < 0;
+						return dirContents.compareNames(lhs, rhs) < 0;
 					else
 						return extCmp < 0;
 				});
@@ -269,20 +260,20 @@ void getDirectoryContents(std::vector<DirEntry> &dirContents, const std::vector<
 
 			for (uint i = 0; i < gameOrder.size(); i++) {
 				for (DirEntry &dirEntry : dirContents) {
-					if (gameOrder[i] == dirEntry.name) {
+					if (gameOrder[i] == dirContents.name(dirEntry)) {
 						dirEntry.position = i;
 						dirEntry.customPos = true;
 						break;
 					}
 				}
 			}
-			sort(dirContents.begin(), dirContents.end(), dirEntryPredicate);
+			sort(dirContents.begin(), dirContents.end(), sortPredicate);
 		}
 		closedir(pdir);
 	}
 }
 
-void showDirectoryContents (const std::vector<DirEntry>& dirContents, int startRow) {
+void showDirectoryContents (const DirectoryModel& dirContents, int startRow) {
 	getcwd(path, PATH_MAX);
 
 	// Clear the screen
@@ -308,18 +299,18 @@ void showDirectoryContents (const std::vector<DirEntry>& dirContents, int startR
 
 	// Print directory listing
 	for (int i = 0; i < ((int)dirContents.size() - startRow) && i < (ms().theme==6 ? ENTRIES_PER_SCREEN_GBNP : ENTRIES_PER_SCREEN); i++) {
-		const DirEntry* entry = &dirContents.at(i + startRow);
+		const char *name = dirContents.name(i + startRow);
 		char entryName[screenCols + 1];
 		
 		// Set row
 		iprintf ("\x1b[%d;%dH", i + (ms().theme==6 ? ENTRIES_START_ROW_GBNP : ENTRIES_START_ROW), (ms().theme==6 ? 7 : 0));
 		
-		if (entry->isDirectory) {
-			strncpy (entryName, entry->name.c_str(), screenCols);
+		if (dirContents.isDirectory(i + startRow)) {
+			strncpy (entryName, name, screenCols);
 			entryName[screenCols - 3] = '\0';
 			iprintf (" [%s]", entryName);
 		} else {
-			strncpy (entryName, entry->name.c_str(), screenCols);
+			strncpy (entryName, name, screenCols);
 			entryName[screenCols - 1] = '\0';
 			iprintf (" %s", entryName);
 		}
@@ -541,38 +532,18 @@ void showLocation(void) {
 
 bool checkForCompatibleGame(char gameTid[5], const char *filename) {
 	bool proceedToLaunch = true;
+	const u32 gameRules = getGameRules(gameTid);
 
-	if (!dsiFeatures() && ms().secondaryDevice) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(incompatibleGameListB4DS)/sizeof(incompatibleGameListB4DS[0]); i++) {
-			if (memcmp(gameTid, incompatibleGameListB4DS[i], 3) == 0) {
-				// Found match
-				proceedToLaunch = false;
-				break;
-			}
-		}
+	if (!dsiFeatures() && ms().secondaryDevice && (gameRules & GAMERULE_INCOMPATIBLE_B4DS)) {
+		proceedToLaunch = false;
 	}
 
-	if (proceedToLaunch && ms().secondaryDevice) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(incompatibleGameListFC)/sizeof(incompatibleGameListFC[0]); i++) {
-			if (memcmp(gameTid, incompatibleGameListFC[i], 3) == 0) {
-				// Found match
-				proceedToLaunch = false;
-				break;
-			}
-		}
+	if (ms().secondaryDevice && (gameRules & GAMERULE_INCOMPATIBLE_FC)) {
+		proceedToLaunch = false;
 	}
 
-	if (proceedToLaunch) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(incompatibleGameList)/sizeof(incompatibleGameList[0]); i++) {
-			if (memcmp(gameTid, incompatibleGameList[i], 3) == 0) {
-				// Found match
-				proceedToLaunch = false;
-				break;
-			}
-		}
+	if (gameRules & GAMERULE_INCOMPATIBLE) {
+		proceedToLaunch = false;
 	}
 
 	if (proceedToLaunch) return true;	// Game is compatible
@@ -627,12 +598,8 @@ bool gameCompatibleMemoryPit(const char* filename) {
 	grabTID(f_nds_file, game_TID);
 	fclose(f_nds_file);
 
-	// TODO: If the list gets large enough, switch to bsearch().
-	for (unsigned int i = 0; i < sizeof(incompatibleGameListMemoryPit)/sizeof(incompatibleGameListMemoryPit[0]); i++) {
-		if (memcmp(game_TID, incompatibleGameListMemoryPit[i], 3) == 0) {
-			// Found match
-			return false;
-		}
+	if (getGameRules(game_TID) & GAMERULE_INCOMPATIBLE_MEMORYPIT) {
+		return false;
 	}
 	return true;
 }
@@ -696,37 +663,19 @@ bool dsiWareRAMLimitMsg(char gameTid[5], std::string filename) {
 	bool showMsg = false;
 	int msgId = 0;
 
+	const u32 gameRules = getGameRules(gameTid);
 	if (sys().dsDebugRam() || (dsiFeatures() && bs().b4dsMode == 2)) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(compatibleGameListB4DSDebugRAMLimited)/sizeof(compatibleGameListB4DSDebugRAMLimited[0]); i++) {
-			if (memcmp(gameTid, compatibleGameListB4DSDebugRAMLimited[i], 3) == 0) {
-				// Found match
-				showMsg = true;
-				msgId = compatibleGameListB4DSDebugRAMLimitedID[i];
-				break;
-			}
-		}
-	} else {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(compatibleGameListB4DSRAMLimited)/sizeof(compatibleGameListB4DSRAMLimited[0]); i++) {
-			if (memcmp(gameTid, compatibleGameListB4DSRAMLimited[i], 3) == 0) {
-				// Found match
-				showMsg = true;
-				msgId = compatibleGameListB4DSRAMLimitedID[i];
-				break;
-			}
+		if (gameRules & GAMERULE_RAM_LIMITED_B4DS_DEBUG) {
+			showMsg = true;
+			msgId = GAMERULE_RAM_LIMITED_B4DS_DEBUG_MSG(gameRules);
 		}
+	} else if (gameRules & GAMERULE_RAM_LIMITED_B4DS) {
+		showMsg = true;
+		msgId = GAMERULE_RAM_LIMITED_B4DS_MSG(gameRules);
 	}
-	if (!showMsg) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(compatibleGameListB4DSAllRAMLimited)/sizeof(compatibleGameListB4DSAllRAMLimited[0]); i++) {
-			if (memcmp(gameTid, compatibleGameListB4DSAllRAMLimited[i], 3) == 0) {
-				// Found match
-				showMsg = true;
-				msgId = compatibleGameListB4DSAllRAMLimitedID[i];
-				break;
-			}
-		}
+	if (!showMsg && (gameRules & GAMERULE_RAM_LIMITED_ALL)) {
+		showMsg = true;
+		msgId = GAMERULE_RAM_LIMITED_ALL_MSG(gameRules);
 	}
 
 	if (!showMsg || !checkIfShowRAMLimitMsg(filename)) {
@@ -804,30 +753,16 @@ bool dsiWareRAMLimitMsg(char gameTid[5], std::string filename) {
 }
 
 bool dsiWareCompatibleB4DS(const char* filename) {
-	bool res = false;
 	FILE *f_nds_file = fopen(filename, "rb");
 	char game_TID[5];
 	grabTID(f_nds_file, game_TID);
 	fclose(f_nds_file);
 
-	// TODO: If the list gets large enough, switch to bsearch().
-	for (unsigned int i = 0; i < sizeof(compatibleGameListB4DS)/sizeof(compatibleGameListB4DS[0]); i++) {
-		if (memcmp(game_TID, compatibleGameListB4DS[i], (compatibleGameListB4DS[i][3] != 0 ? 4 : 3)) == 0) {
-			// Found match
-			res = true;
-			break;
-		}
-	}
-	if (!res && (sys().dsDebugRam() || bs().b4dsMode == 2)) {
-		for (unsigned int i = 0; i < sizeof(compatibleGameListB4DSDebug)/sizeof(compatibleGameListB4DSDebug[0]); i++) {
-			if (memcmp(game_TID, compatibleGameListB4DSDebug[i], 3) == 0) {
-				// Found match
-				res = true;
-				break;
-			}
-		}
+	const u32 gameRules = getGameRules(game_TID);
+	if (gameRules & GAMERULE_DSIWARE_B4DS) {
+		return true;
 	}
-	return res;
+	return (sys().dsDebugRam() || bs().b4dsMode == 2) && (gameRules & GAMERULE_DSIWARE_B4DS_DEBUG);
 }
 
 void cannotLaunchMsg(void) {
@@ -853,6 +788,106 @@ void cannotLaunchMsg(void) {
 	for (int i = 0; i < 25; i++) swiWaitForVBlank();
 }
 
+/**
+ * Find a file by part of its name or banner title, narrowing the results as
+ * each letter is entered.
+ * @return The index of the file chosen, or -1.
+ */
+static int searchFiles(const DirectoryModel &dirContents) {
+	// Accented letters are found by typing them without the accent, as the index keeps them that way
+	static const char letters[] = " abcdefghijklmnopqrstuvwxyz0123456789";
+	const int letterCount = sizeof(letters) - 1;
+	const int maxResults = 3;
+
+	titleIndex().sync(dirContents);
+
+	if (ms().macroMode) {
+		lcdMainOnBottom();
+		lcdSwapped = true;
+	}
+	dialogboxHeight = 5;
+	showdialogbox = true;
+
+	std::string query;
+	std::vector<int> results;
+	size_t found = 0;
+	int selected = 0;
+	int chosen = -1;
+	int pressed = 0;
+	while (1) {
+		clearText();
+		printLargeCentered(false, 74, "Search");
+		printSmallCentered(false, 98, (query + "_").c_str());
+		if (!query.empty()) {
+			char text[32];
+			snprintf(text, sizeof(text), "%d found", (int)found);
+			printSmallCentered(false, 110, text);
+		}
+		for (int i = 0; i < (int)results.size(); i++) {
+			std::string name = dirContents.name(results[i]);
+			while (calcSmallFontWidth(name.c_str()) > 200) {
+				// Not leaving part of a UTF-8 character
+				do {
+					name.pop_back();
+				} while ((name.back() & 0xC0) == 0x80);
+				if ((u8)name.back() >= 0xC0)
+					name.pop_back();
+			}
+			printSmallCentered(false, 128 + (i * 12), ((i == selected) ? ("> " + name + " <") : name).c_str());
+		}
+		printSmallCentered(false, 166, "\u2191\u2193\u2192 Type  \u2428 Delete  L/R Pick  \u2427 Go");
+
+		do {
+			scanKeys();
+			pressed = keysDownRepeat();
+			bgOperations(true);
+		} while (!pressed);
+
+		bool queryChanged = false;
+		if (pressed & (KEY_UP | KEY_DOWN)) {
+			// Cycle the last letter, starting from a space if there isn't one
+			if (query.empty())
+				query += ' ';
+			int letter = strchr(letters, query.back()) - letters;
+			letter = (letter + ((pressed & KEY_UP) ? 1 : letterCount - 1)) % letterCount;
+			query.back() = letters[letter];
+			queryChanged = true;
+		} else if ((pressed & KEY_RIGHT) && !query.empty() && query.length() < 24) {
+			query += 'a';
+			queryChanged = true;
+		} else if (pressed & (KEY_B | KEY_LEFT)) {
+			if (query.empty())
+				break;
+			query.pop_back();
+			queryChanged = true;
+		} else if ((pressed & KEY_L) && selected > 0) {
+			selected--;
+		} else if ((pressed & KEY_R) && selected < (int)results.size() - 1) {
+			selected++;
+		} else if ((pressed & KEY_A) && !results.empty()) {
+			chosen = results[selected];
+			break;
+		}
+
+		if (queryChanged) {
+			found = titleIndex().search(query.c_str(), results, maxResults);
+			selected = 0;
+		}
+	}
+	clearText();
+	showdialogbox = false;
+	dialogboxHeight = 0;
+
+	if (ms().theme == TWLSettings::EThemeGBC) {
+		gbnpBottomInfo();
+	}
+	if (ms().macroMode) {
+		lcdMainOnTop();
+		lcdSwapped = false;
+	}
+	return chosen;
+}
+
 std::string browseForFile(const std::vector<std::string_view> extensionList) {
 	if (ms().macroMode) {
 		lcdMainOnTop();
@@ -860,16 +895,17 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 	}
 
 	gameOrderIniPath = std::string(sdFound() ? "sd" : "fat") + ":/_nds/TWiLightMenu/extras/gameorder.ini";
-	recentlyPlayedIniPath = std::string(sdFound() ? "sd" : "fat") + ":/_nds/TWiLightMenu/extras/recentlyplayed.ini";
-	timesPlayedIniPath = std::string(sdFound() ? "sd" : "fat") + ":/_nds/TWiLightMenu/extras/timesplayed.ini";
 
 	int pressed = 0;
 	int screenOffset = 0;
 	int fileOffset = 0;
-	std::vector<DirEntry> dirContents;
+	DirectoryModel dirContents;
 	
 	getDirectoryContents (dirContents, extensionList);
 	showDirectoryContents (dirContents, screenOffset);
+
+	getcwd(path, PATH_MAX);
+	titleIndex().openDir(path);
 	
 	whiteScreen = false;
 	fadeType = true;	// Fade in from white
@@ -904,59 +940,14 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 			iprintf ("\x1B[47m");		// Print foreground white color
 		}
 
-		if (dirContents.at(fileOffset).isDirectory) {
+		if (dirContents.isDirectory(fileOffset)) {
 			isDirectory = true;
 			bnrWirelessIcon = 0;
 		} else {
 			isDirectory = false;
-			std::string std_romsel_filename = dirContents.at(fileOffset).name.c_str();
-			getGameInfo(isDirectory, dirContents.at(fileOffset).name.c_str());
-
-			if (extension(std_romsel_filename, {".nds", ".dsi", ".ids", ".srl", ".app", ".argv"})) {
-				bnrRomType = 0;
-			} else if (extension(std_romsel_filename, {".xex", ".atr", ".a26", ".a52", ".a78"})) {
-				bnrRomType = 10;
-			} else if (extension(std_romsel_filename, {".col"})) {
-				bnrRomType = 13;
-			} else if (extension(std_romsel_filename, {".m5"})) {
-				bnrRomType = 14;
-			} else if (extension(std_romsel_filename, {".int"})) {
-				bnrRomType = 12;
-			} else if (extension(std_romsel_filename, {".plg"})) {
-				bnrRomType = 9;
-			} else if (extension(std_romsel_filename, {".avi", ".rvid", ".fv"})) {
-				bnrRomType = 19;
-			} else if (extension(std_romsel_filename, {".gif", ".bmp", ".png"})) {
-				bnrRomType = 20;
-			} else if (extension(std_romsel_filename, {".agb", ".gba", ".mb"})) {
-				bnrRomType = 1;
-			} else if (extension(std_romsel_filename, {".gb", ".sgb"})) {
-				bnrRomType = 2;
-			} else if (extension(std_romsel_filename,{ ".gbc"})) {
-				bnrRomType = 3;
-			} else if (extension(std_romsel_filename, {".nes", ".fds"})) {
-				bnrRomType = 4;
-			} else if (extension(std_romsel_filename, {".sg"})) {
-				bnrRomType = 15;
-			} else if (extension(std_romsel_filename, {".sms"})) {
-				bnrRomType = 5;
-			} else if (extension(std_romsel_filename, {".gg"})) {
-				bnrRomType = 6;
-			} else if (extension(std_romsel_filename, {".gen"})) {
-				bnrRomType = 7;
-			} else if (extension(std_romsel_filename, {".smc", ".sfc"})) {
-				bnrRomType = 8;
-			} else if (extension(std_romsel_filename, {".pce"})) {
-				bnrRomType = 11;
-			} else if (extension(std_romsel_filename, {".ws", ".wsc"})) {
-				bnrRomType = 16;
-			} else if (extension(std_romsel_filename, {".ngp", ".ngc"})) {
-				bnrRomType = 17;
-			} else if (extension(std_romsel_filename, {".dsk"})) {
-				bnrRomType = 18;
-			} else {
-				bnrRomType = 9;
-			}
+			getGameInfo(isDirectory, dirContents.name(fileOffset));
+
+			bnrRomType = fileTypeOf(dirContents.name(fileOffset)).romType;
 		}
 
 		if (bnrRomType != 0) {
@@ -966,8 +957,8 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 			isHomebrew = 0;
 		}
 
-		iconUpdate (dirContents.at(fileOffset).isDirectory,dirContents.at(fileOffset).name.c_str());
-		titleUpdate (dirContents.at(fileOffset).isDirectory,dirContents.at(fileOffset).name.c_str());
+		iconUpdate (dirContents.isDirectory(fileOffset),dirContents.name(fileOffset));
+		titleUpdate (dirContents.isDirectory(fileOffset),dirContents.name(fileOffset));
 
 		showLocation();
 
@@ -1002,6 +993,13 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 				snd().playSelect();
 			}
 		}
+		if (pressed & KEY_L) {
+			const int chosen = searchFiles(dirContents);
+			if (chosen >= 0) {
+				fileOffset = chosen;
+			}
+			pressed = 0;
+		}
 
 		if (fileOffset < 0) 	fileOffset = dirContents.size() - 1;		// Wrap around to bottom of list
 		if (fileOffset > ((int)dirContents.size() - 1))		fileOffset = 0;		// Wrap around to top of list
@@ -1017,8 +1015,8 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 		}
 
 		if (pressed & KEY_A) {
-			DirEntry* entry = &dirContents.at(fileOffset);
-			if (entry->isDirectory) {
+			const std::string entryName = dirContents.name(fileOffset);
+			if (dirContents.isDirectory(fileOffset)) {
 				if (ms().theme == TWLSettings::EThemeGBC) {
 					snd().playSelect();
 
@@ -1029,7 +1027,7 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 				}
 				iprintf("Entering directory\n");
 				// Enter selected directory
-				chdir (entry->name.c_str());
+				chdir (entryName.c_str());
 				char buf[256];
 				ms().romfolder[ms().secondaryDevice] = getcwd(buf, 256);
 				ms().cursorPosition[ms().secondaryDevice] = 0;
@@ -1037,20 +1035,20 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 				ms().saveSettings();
 
 				return "null";
-			} else if (isTwlm || (isDSiWare && ((((!dsiFeatures() && (!sdFound() || !ms().dsiWareToSD)) || bs().b4dsMode) && ms().secondaryDevice && !dsiWareCompatibleB4DS(dirContents.at(fileOffset).name.c_str()))
-			|| (isDSiMode() && memcmp(io_dldi_data->friendlyName, "CycloDS iEvolution", 18) != 0 && sys().arm7SCFGLocked() && !sys().dsiWramAccess() && !gameCompatibleMemoryPit(dirContents.at(fileOffset).name.c_str()))))) {
+			} else if (isTwlm || (isDSiWare && ((((!dsiFeatures() && (!sdFound() || !ms().dsiWareToSD)) || bs().b4dsMode) && ms().secondaryDevice && !dsiWareCompatibleB4DS(dirContents.name(fileOffset)))
+			|| (isDSiMode() && memcmp(io_dldi_data->friendlyName, "CycloDS iEvolution", 18) != 0 && sys().arm7SCFGLocked() && !sys().dsiWramAccess() && !gameCompatibleMemoryPit(dirContents.name(fileOffset)))))) {
 				cannotLaunchMsg();
 			} else {
-				loadPerGameSettings(dirContents.at(fileOffset).name);
+				loadPerGameSettings(dirContents.name(fileOffset));
 				int hasAP = 0;
 				bool proceedToLaunch = true;
 				bool useBootstrapAnyway = ((perGameSettings_useBootstrap == -1 ? ms().useBootstrap : perGameSettings_useBootstrap) || !ms().secondaryDevice);
 				if (useBootstrapAnyway && bnrRomType == 0 && !isDSiWare
 				 && isHomebrew == 0
-				 && checkIfDSiMode(dirContents.at(fileOffset).name)) {
+				 && checkIfDSiMode(dirContents.name(fileOffset))) {
 					bool hasDsiBinaries = true;
 					if (dsiFeatures() && (!ms().secondaryDevice || !bs().b4dsMode)) {
-						FILE *f_nds_file = fopen(dirContents.at(fileOffset).name.c_str(), "rb");
+						FILE *f_nds_file = fopen(dirContents.name(fileOffset), "rb");
 						hasDsiBinaries = checkDsiBinaries(f_nds_file);
 						fclose(f_nds_file);
 					}
@@ -1060,13 +1058,13 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 					}
 				}
 				if (proceedToLaunch && (useBootstrapAnyway || ((!dsiFeatures() || bs().b4dsMode) && isDSiWare)) && bnrRomType == 0 && !dsModeForced && isHomebrew == 0) {
-					FILE *f_nds_file = fopen(dirContents.at(fileOffset).name.c_str(), "rb");
+					FILE *f_nds_file = fopen(dirContents.name(fileOffset), "rb");
 					char game_TID[5];
 					grabTID(f_nds_file, game_TID);
 					game_TID[4] = 0;
 					fclose(f_nds_file);
 
-					proceedToLaunch = checkForCompatibleGame(game_TID, dirContents.at(fileOffset).name.c_str());
+					proceedToLaunch = checkForCompatibleGame(game_TID, dirContents.name(fileOffset));
 					if (proceedToLaunch && requiresDonorRom) {
 						const char* pathDefine = "DONORTWL_NDS_PATH"; // SDK5.x
 						if (requiresDonorRom == 52) {
@@ -1098,8 +1096,8 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 							proceedToLaunch = donorRomMsg();
 						}
 					}
-					if (proceedToLaunch && !isDSiWare && checkIfShowAPMsg(dirContents.at(fileOffset).name)) {
-						FILE *f_nds_file = fopen(dirContents.at(fileOffset).name.c_str(), "rb");
+					if (proceedToLaunch && !isDSiWare && checkIfShowAPMsg(dirContents.name(fileOffset))) {
+						FILE *f_nds_file = fopen(dirContents.name(fileOffset), "rb");
 						hasAP = checkRomAP(f_nds_file);
 						fclose(f_nds_file);
 					}
@@ -1108,17 +1106,17 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 							proceedToLaunch = dsiWareInDSModeMsg();
 						}
 						if (proceedToLaunch) {
-							proceedToLaunch = dsiWareRAMLimitMsg(game_TID, dirContents.at(fileOffset).name);
+							proceedToLaunch = dsiWareRAMLimitMsg(game_TID, dirContents.name(fileOffset));
 						}
 					}
 				} else if (isHomebrew == 1) {
-					loadPerGameSettings(dirContents.at(fileOffset).name);
+					loadPerGameSettings(dirContents.name(fileOffset));
 					if (requiresRamDisk && perGameSettings_ramDiskNo == -1) {
 						proceedToLaunch = false;
 						ramDiskMsg();
 					}
 				} else if (bnrRomType == 7) {
-					if (ms().mdEmulator==1 && getFileSize(dirContents.at(fileOffset).name.c_str()) > 0x300000) {
+					if (ms().mdEmulator==1 && getFileSize(dirContents.name(fileOffset)) > 0x300000) {
 						proceedToLaunch = false;
 						mdRomTooBig();
 					}
@@ -1163,7 +1161,7 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 							break;
 						}
 						if (pressed & KEY_X) {
-							dontShowAPMsgAgain(dirContents.at(fileOffset).name);
+							dontShowAPMsgAgain(dirContents.name(fileOffset));
 							pressed = 0;
 							break;
 						}
@@ -1173,7 +1171,7 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 					dialogboxHeight = 0;
 
 					if (proceedToLaunch) {
-						titleUpdate (dirContents.at(fileOffset).isDirectory,dirContents.at(fileOffset).name.c_str());
+						titleUpdate (dirContents.isDirectory(fileOffset),dirContents.name(fileOffset));
 						showLocation();
 					} else if (ms().macroMode) {
 						lcdMainOnTop();
@@ -1194,7 +1192,7 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 					showdialogbox = true;
 					// Clear location text
 					clearText();
-					titleUpdate(dirContents.at(fileOffset).isDirectory,dirContents.at(fileOffset).name.c_str());
+					titleUpdate(dirContents.isDirectory(fileOffset),dirContents.name(fileOffset));
 
 					printLargeCentered(false, 74, "Cluster Size Warning");
 					printSmallCentered(false, 98, "Your SD card is not formatted");
@@ -1229,7 +1227,7 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 					dialogboxHeight = 0;
 
 					if (proceedToLaunch) {
-						titleUpdate(dirContents.at(fileOffset).isDirectory,dirContents.at(fileOffset).name.c_str());
+						titleUpdate(dirContents.isDirectory(fileOffset),dirContents.name(fileOffset));
 						showLocation();
 					} else if (ms().macroMode) {
 						lcdMainOnTop();
@@ -1265,31 +1263,14 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 						printSmallCentered(false, 0, 98, "If this crashes with an error, please");
 						printSmallCentered(false, 0, 110, "disable \"Update recently played list\".");
 
-						mkdir(sdFound() ? "sd:/_nds/TWiLightMenu/extras" : "fat:/_nds/TWiLightMenu/extras", 0777);
-
-						CIniFile recentlyPlayedIni(recentlyPlayedIniPath);
-						std::vector<std::string> recentlyPlayed;
-
 						getcwd(path, PATH_MAX);
-						recentlyPlayedIni.GetStringVector("RECENT", path, recentlyPlayed, ':'); // : isn't allowed in FAT-32 names, so its a good deliminator
-
-						std::vector<std::string>::iterator it = std::find(recentlyPlayed.begin(), recentlyPlayed.end(), entry->name);
-						if (it != recentlyPlayed.end()) {
-							recentlyPlayed.erase(it);
-						}
-
-						recentlyPlayed.insert(recentlyPlayed.begin(), entry->name);
-
-						recentlyPlayedIni.SetStringVector("RECENT", path, recentlyPlayed, ':');
-						recentlyPlayedIni.SaveIniFile(recentlyPlayedIniPath);
-
-						CIniFile timesPlayedIni(timesPlayedIniPath);
-						timesPlayedIni.SetInt(path, entry->name, (timesPlayedIni.GetInt(path, entry->name, 0) + 1));
-						timesPlayedIni.SaveIniFile(timesPlayedIniPath);
+						playStats.openDir(path);
+						playStats.addPlay(entryName.c_str());
 					}
+					titleIndex().flush();
 
 					// Return the chosen file
-					return entry->name;
+					return entryName;
 				} else {
 					if (ms().theme == TWLSettings::EThemeGBC) {
 						gbnpBottomInfo();
@@ -1330,14 +1311,14 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 			return "null";
 		}
 
-		if ((pressed & KEY_X) && !ms().preventDeletion && dirContents.at(fileOffset).name != "..") {
+		if ((pressed & KEY_X) && !ms().preventDeletion && strcmp(dirContents.name(fileOffset), "..") != 0) {
 			if (ms().macroMode) {
 				lcdMainOnBottom();
 				lcdSwapped = true;
 			}
 
-			DirEntry *entry = &dirContents.at(fileOffset);
-			bool unHide = (FAT_getAttr(entry->name.c_str()) & ATTR_HIDDEN || (strncmp(entry->name.c_str(), ".", 1) == 0 && entry->name != ".."));
+			const std::string entryName = dirContents.name(fileOffset);
+			bool unHide = (FAT_getAttr(entryName.c_str()) & ATTR_HIDDEN || (strncmp(entryName.c_str(), ".", 1) == 0 && entryName != ".."));
 
 			showdialogbox = true;
 			dialogboxHeight = 3;
@@ -1379,13 +1360,13 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 					printf("Please wait...\n");
 
 					if (pressed & KEY_A && !isDirectory) {
-						remove(dirContents.at(fileOffset).name.c_str());
+						remove(dirContents.name(fileOffset));
 					} else if (pressed & KEY_Y) {
 						// Remove leading . if it exists
-						if ((strncmp(entry->name.c_str(), ".", 1) == 0 && entry->name != "..")) {
-							rename(entry->name.c_str(), entry->name.substr(1).c_str());
+						if ((strncmp(entryName.c_str(), ".", 1) == 0 && entryName != "..")) {
+							rename(entryName.c_str(), entryName.substr(1).c_str());
 						} else { // Otherwise toggle the hidden attribute bit
-							FAT_setAttr(entry->name.c_str(), FAT_getAttr(entry->name.c_str()) ^ ATTR_HIDDEN);
+							FAT_setAttr(entryName.c_str(), FAT_getAttr(entryName.c_str()) ^ ATTR_HIDDEN);
 						}
 					}
 					
@@ -1444,7 +1425,7 @@ std::string browseForFile(const std::vector<std::string_view> extensionList) {
 
 		if ((pressed & KEY_Y) && !isTwlm && !isDirectory && (bnrRomType == 0)) {
 			ms().cursorPosition[ms().secondaryDevice] = fileOffset;
-			perGameSettings(dirContents.at(fileOffset).name);
+			perGameSettings(dirContents.name(fileOffset));
 			if (ms().theme == TWLSettings::EThemeGBC) {
 				gbnpBottomInfo();
 			}
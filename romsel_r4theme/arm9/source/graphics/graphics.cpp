@@ -22,6 +22,7 @@
 #include <maxmod9.h>
 #include <gl2d.h>
 #include "common/lodepng.h"
+#include "common/colorConvert.h"
 #include "bios_decompress_callback.h"
 #include "FontGraphic.h"
 #include "common/inifile.h"
@@ -449,7 +450,6 @@ void graphicsLoad()
 
 	uint imageWidth, imageHeight;
 	std::vector<unsigned char> image;
-	bool alternatePixel = false;
 
 	if (ms().theme == TWLSettings::EThemeGBC) {
 		lodepng::decode(image, imageWidth, imageHeight, "nitro:/graphics/gbcborder.png");
@@ -529,106 +529,12 @@ void graphicsLoad()
 
 		lodepng::decode(image, imageWidth, imageHeight, pathTop);
 
-		for (unsigned i=0;i<image.size()/4;i++) {
-			image[(i*4)+3] = 0;
-			if (alternatePixel) {
-				if (image[(i*4)] >= 0x4) {
-					image[(i*4)] -= 0x4;
-					image[(i*4)+3] |= BIT(0);
-				}
-				if (image[(i*4)+1] >= 0x4) {
-					image[(i*4)+1] -= 0x4;
-					image[(i*4)+3] |= BIT(1);
-				}
-				if (image[(i*4)+2] >= 0x4) {
-					image[(i*4)+2] -= 0x4;
-					image[(i*4)+3] |= BIT(2);
-				}
-			}
-			topImage[startMenu][0][i] = image[i*4]>>3 | (image[(i*4)+1]>>3)<<5 | (image[(i*4)+2]>>3)<<10 | BIT(15);
-			if (ms().colorMode == 1) {
-				topImage[startMenu][0][i] = convertVramColorToGrayscale(topImage[startMenu][0][i]);
-			}
-			if (alternatePixel) {
-				if (image[(i*4)+3] & BIT(0)) {
-					image[(i*4)] += 0x4;
-				}
-				if (image[(i*4)+3] & BIT(1)) {
-					image[(i*4)+1] += 0x4;
-				}
-				if (image[(i*4)+3] & BIT(2)) {
-					image[(i*4)+2] += 0x4;
-				}
-			} else {
-				if (image[(i*4)] >= 0x4) {
-					image[(i*4)] -= 0x4;
-				}
-				if (image[(i*4)+1] >= 0x4) {
-					image[(i*4)+1] -= 0x4;
-				}
-				if (image[(i*4)+2] >= 0x4) {
-					image[(i*4)+2] -= 0x4;
-				}
-			}
-			topImage[startMenu][1][i] = image[i*4]>>3 | (image[(i*4)+1]>>3)<<5 | (image[(i*4)+2]>>3)<<10 | BIT(15);
-			if (ms().colorMode == 1) {
-				topImage[startMenu][1][i] = convertVramColorToGrayscale(topImage[startMenu][1][i]);
-			}
-			if ((i % 256) == 255) alternatePixel = !alternatePixel;
-			alternatePixel = !alternatePixel;
-		}
+		rgbaToBgr555(topImage[startMenu][0], topImage[startMenu][1], imageWidth, image.data(), imageWidth, imageHeight, 4, (ms().colorMode == 1) ? COLORCONVERT_GRAYSCALE : 0);
 
 		image.clear();
 		lodepng::decode(image, imageWidth, imageHeight, pathBottom);
 
-		for (unsigned i=0;i<image.size()/4;i++) {
-			image[(i*4)+3] = 0;
-			if (alternatePixel) {
-				if (image[(i*4)] >= 0x4) {
-					image[(i*4)] -= 0x4;
-					image[(i*4)+3] |= BIT(0);
-				}
-				if (image[(i*4)+1] >= 0x4) {
-					image[(i*4)+1] -= 0x4;
-					image[(i*4)+3] |= BIT(1);
-				}
-				if (image[(i*4)+2] >= 0x4) {
-					image[(i*4)+2] -= 0x4;
-					image[(i*4)+3] |= BIT(2);
-				}
-			}
-			bottomImage[startMenu][0][i] = image[i*4]>>3 | (image[(i*4)+1]>>3)<<5 | (image[(i*4)+2]>>3)<<10 | BIT(15);
-			if (ms().colorMode == 1) {
-				bottomImage[startMenu][0][i] = convertVramColorToGrayscale(bottomImage[startMenu][0][i]);
-			}
-			if (alternatePixel) {
-				if (image[(i*4)+3] & BIT(0)) {
-					image[(i*4)] += 0x4;
-				}
-				if (image[(i*4)+3] & BIT(1)) {
-					image[(i*4)+1] += 0x4;
-				}
-				if (image[(i*4)+3] & BIT(2)) {
-					image[(i*4)+2] += 0x4;
-				}
-			} else {
-				if (image[(i*4)] >= 0x4) {
-					image[(i*4)] -= 0x4;
-				}
-				if (image[(i*4)+1] >= 0x4) {
-					image[(i*4)+1] -= 0x4;
-				}
-				if (image[(i*4)+2] >= 0x4) {
-					image[(i*4)+2] -= 0x4;
-				}
-			}
-			bottomImage[startMenu][1][i] = image[i*4]>>3 | (image[(i*4)+1]>>3)<<5 | (image[(i*4)+2]>>3)<<10 | BIT(15);
-			if (ms().colorMode == 1) {
-				bottomImage[startMenu][1][i] = convertVramColorToGrayscale(bottomImage[startMenu][1][i]);
-			}
-			if ((i % 256) == 255) alternatePixel = !alternatePixel;
-			alternatePixel = !alternatePixel;
-		}
+		rgbaToBgr555(bottomImage[startMenu][0], bottomImage[startMenu][1], imageWidth, image.data(), imageWidth, imageHeight, 4, (ms().colorMode == 1) ? COLORCONVERT_GRAYSCALE : 0);
 	}
 
 	// Initialize the bottom background
@@ -30,6 +30,7 @@
 #include "common/bootstrapsettings.h"
 #include "common/flashcard.h"
 #include "common/systemdetails.h"
+#include "common/titleIndex.h"
 #include "common/tonccpy.h"
 #include "common/twlmenusettings.h"
 #include "fileBrowse.h"
@@ -781,6 +782,20 @@ void drawIconWS(int Xpos, int Ypos) { glSprite(Xpos, Ypos, GL_FLIP_NONE, wsIcon)
 void drawIconNGP(int Xpos, int Ypos) { glSprite(Xpos, Ypos, GL_FLIP_NONE, ngpIcon); }
 void drawIconCPC(int Xpos, int Ypos) { glSprite(Xpos, Ypos, GL_FLIP_NONE, cpcIcon); }
 
+/**
+ * Index a banner's titles in each language it has, so the file can be
+ * searched for by them.
+ */
+static void indexBannerTitles(const char* name)
+{
+	int languages = 6;
+	if (ndsBanner.version == NDS_BANNER_VER_ZH)
+		languages = 7;
+	else if (ndsBanner.version == NDS_BANNER_VER_ZH_KO || ndsBanner.version == NDS_BANNER_VER_DSi)
+		languages = 8;
+	titleIndex().setTitles(name, ndsBanner.titles, languages);
+}
+
 void getGameInfo(bool isDir, const char* name)
 {
 	bnriconPalLine = 0;
@@ -811,6 +826,7 @@ void getGameInfo(bool isDir, const char* name)
 
 				if (read >= NDS_BANNER_SIZE_ORIGINAL) {
 					customIconGood = true;
+					indexBannerTitles(name);
 
 					if (ms().animateDsiIcons && read == NDS_BANNER_SIZE_DSi) {
 						u16 crc16 = swiCRC16(0xFFFF, ndsBanner.dsi_icon, 0x1180);
@@ -1077,6 +1093,8 @@ void getGameInfo(bool isDir, const char* name)
 		// close file!
 		fclose(fp);
 
+		indexBannerTitles(name);
+
 		// restore png icon
 		if (customIcon == 1) {
 			memcpy(ndsBanner.icon, iconCopy, sizeof(iconCopy));
@@ -4,6 +4,10 @@
 #include "io_g6_common.h"
 #include "io_sc_common.h"
 #include "exptools.h"
+#include "gbaNorFlash.h"
+#include "gbapatch/romScan.h"
+#include "gbapatch/romStream.h"
+#include "gbapatch/Save.h"
 
 #include <stdio.h>
 #include <fat.h>
@@ -44,11 +48,9 @@
 #include "language.h"
 
 #include "cheat.h"
-#include "crc.h"
+#include "common/crc32.h"
 
-#include "twlClockExcludeMap.h"
-#include "dmaExcludeMap.h"
-#include "asyncReadExcludeMap.h"
+#include "gameRules.h"
 #include "donorMap.h"
 #include "saveMap.h"
 #include "ROMList.h"
@@ -235,13 +237,9 @@ bool setClockSpeed(const char* filename) {
 		fclose(f_nds_file);
 		game_TID[4] = 0;
 
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(twlClockExcludeList)/sizeof(twlClockExcludeList[0]); i++) {
-			if (memcmp(game_TID, twlClockExcludeList[i], 3) == 0) {
-				// Found match
-				dsModeForced = true;
-				return false;
-			}
+		if (getGameRules(game_TID) & GAMERULE_NO_TWL_CLOCK) {
+			dsModeForced = true;
+			return false;
 		}
 	}
 
@@ -260,12 +258,8 @@ bool setCardReadDMA(const char* filename) {
 		fclose(f_nds_file);
 		game_TID[4] = 0;
 
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(cardReadDMAExcludeList)/sizeof(cardReadDMAExcludeList[0]); i++) {
-			if (memcmp(game_TID, cardReadDMAExcludeList[i], 3) == 0) {
-				// Found match
-				return false;
-			}
+		if (getGameRules(game_TID) & GAMERULE_NO_CARD_DMA) {
+			return false;
 		}
 	}
 
@@ -284,12 +278,8 @@ bool setAsyncCardRead(const char* filename) {
 		fclose(f_nds_file);
 		game_TID[4] = 0;
 
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(asyncReadExcludeList)/sizeof(asyncReadExcludeList[0]); i++) {
-			if (memcmp(game_TID, asyncReadExcludeList[i], 3) == 0) {
-				// Found match
-				return false;
-			}
+		if (getGameRules(game_TID) & GAMERULE_NO_ASYNC_READ) {
+			return false;
 		}
 	}
 
@@ -1852,13 +1842,8 @@ int main(int argc, char **argv) {
 							u32 gameTidHex = 0;
 							tonccpy(&gameTidHex, &game_TID, 4);
 
-							for (int i = 0; i < (int)sizeof(ROMList)/12; i++) {
-								ROMListEntry* curentry = &ROMList[i];
-								if (gameTidHex == curentry->GameCode) {
-									if (curentry->SaveMemType != 0xFFFFFFFF) savesize = sramlen[curentry->SaveMemType];
-									break;
-								}
-							}
+							int saveMemType = lookupSaveInfo(gameTidHex);
+							if (saveMemType != -1) savesize = sramlen[saveMemType];
 
 							if ((orgsavesize == 0 && savesize > 0) || (orgsavesize < savesize)) {
 								clearText();
@@ -2226,29 +2211,19 @@ int main(int argc, char **argv) {
 						if (*(u16*)(0x020000C0) == 0x5A45 && strncmp(titleID, "AGBJ", 4) != 0) {
 							cExpansion::SetRompage(0);
 							expansion().SetRampage(cExpansion::ENorPage);
-							cExpansion::OpenNorWrite();
-							cExpansion::SetSerialMode();
-							for (u32 address=0;address<romSize&&address<0x2000000;address+=0x40000) {
-								expansion().Block_Erase(address);
-							}
 							nor = true;
 						} else if (*(u16*)(0x020000C0) == 0x4353 && romSize > 0x1FFFFFE) {
 							romSize = 0x1FFFFFE;
 						}
 
-						for (u32 len = romSize; len > 0; len -= 0x8000) {
-							if (fread(&copyBuf, 1, (len>0x8000 ? 0x8000 : len), gbaFile) > 0) {
-								s2RamAccess(true);
-								if (nor) {
-									expansion().WriteNorFlash(ptr-0x08000000, (u8*)copyBuf, (len>0x8000 ? 0x8000 : len));
-								} else {
-									tonccpy((u16*)ptr, &copyBuf, (len>0x8000 ? 0x8000 : len));
-								}
-								s2RamAccess(false);
-								ptr += 0x8000;
-							} else {
-								break;
-							}
+						if (nor) {
+							// Only writes what isn't already in the NOR
+							gbaNorFlash(gbaFile, filename.c_str(), romSize, (u8*)copyBuf, NULL);
+						} else {
+							// Scanned and patched as it's loaded, so gbapatcher needn't read it all back
+							save_addScanPatterns();
+							romStream_load(gbaFile, ptr, romSize, strncmp(titleID, "MB2G", 4) != 0, (u8*)copyBuf, NULL);
+							romScan_save(filename.c_str());
 						}
 						fclose(gbaFile);
 
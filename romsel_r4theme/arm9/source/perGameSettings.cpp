@@ -29,14 +29,13 @@
 #include "myDSiMode.h"
 #include "common/bootstrapsettings.h"
 #include "common/inifile.h"
+#include "gamesettings/gameSettingsDb.h"
 #include "common/flashcard.h"
 #include "common/nds_loader_arm9.h"
 #include "common/systemdetails.h"
 #include "common/twlmenusettings.h"
 
-#include "twlClockExcludeMap.h"
-#include "dmaExcludeMap.h"
-#include "asyncReadExcludeMap.h"
+#include "gameRules.h"
 
 #define SCREEN_COLS 32
 #define ENTRIES_PER_SCREEN 15
@@ -74,8 +73,6 @@ int perGameSettings_useBootstrap = -1;
 
 static char SET_AS_DONOR_ROM[32];
 
-char pergamefilepath[256];
-
 extern void RemoveTrailingSlashes(std::string &path);
 bool extension(const std::string_view filename, const std::vector<std::string_view> extensions);
 
@@ -96,112 +93,106 @@ bool blacklisted_cardReadDma = false;
 bool blacklisted_asyncCardRead = false;
 
 void loadPerGameSettings (std::string filename) {
-	snprintf(pergamefilepath, sizeof(pergamefilepath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", (ms().secondaryDevice ? "fat:" : "sd:"), filename.c_str());
-	CIniFile pergameini( pergamefilepath );
-	perGameSettings_directBoot = pergameini.GetInt("GAMESETTINGS", "DIRECT_BOOT", (isModernHomebrew || ms().previousUsedDevice));	// Homebrew only
+	GameSettings pergameini((ms().secondaryDevice ? "fat:" : "sd:"), filename);
+	perGameSettings_directBoot = pergameini.GetInt(GAMESETTINGS_DIRECT_BOOT, (isModernHomebrew || ms().previousUsedDevice));	// Homebrew only
 	if (isHomebrew) {
-		perGameSettings_dsiMode = pergameini.GetInt("GAMESETTINGS", "DSI_MODE", (isModernHomebrew ? true : false));
+		perGameSettings_dsiMode = pergameini.GetInt(GAMESETTINGS_DSI_MODE, (isModernHomebrew ? true : false));
 	} else {
-		perGameSettings_dsiMode = pergameini.GetInt("GAMESETTINGS", "DSI_MODE", -1);
+		perGameSettings_dsiMode = pergameini.GetInt(GAMESETTINGS_DSI_MODE, -1);
 	}
-	perGameSettings_language = pergameini.GetInt("GAMESETTINGS", "LANGUAGE", -2);
-	perGameSettings_region = pergameini.GetInt("GAMESETTINGS", "REGION", -2);
+	perGameSettings_language = pergameini.GetInt(GAMESETTINGS_LANGUAGE, -2);
+	perGameSettings_region = pergameini.GetInt(GAMESETTINGS_REGION, -2);
 	if (perGameSettings_region < -2 || (!dsiFeatures() && perGameSettings_region == -1)) perGameSettings_region = -2;
-	perGameSettings_saveNo = pergameini.GetInt("GAMESETTINGS", "SAVE_NUMBER", 0);
-	perGameSettings_ramDiskNo = pergameini.GetInt("GAMESETTINGS", "RAM_DISK", -1);
-	perGameSettings_boostCpu = pergameini.GetInt("GAMESETTINGS", "BOOST_CPU", -1);
-	perGameSettings_boostVram = pergameini.GetInt("GAMESETTINGS", "BOOST_VRAM", -1);
-	perGameSettings_cardReadDMA = pergameini.GetInt("GAMESETTINGS", "CARD_READ_DMA", -1);
-	perGameSettings_asyncCardRead = pergameini.GetInt("GAMESETTINGS", "ASYNC_CARD_READ", -1);
-	perGameSettings_bootstrapFile = pergameini.GetInt("GAMESETTINGS", "BOOTSTRAP_FILE", -1);
-	perGameSettings_wideScreen = pergameini.GetInt("GAMESETTINGS", "WIDESCREEN", -1);
-	perGameSettings_expandRomSpace = pergameini.GetInt("GAMESETTINGS", "EXTENDED_MEMORY", -1);
-	perGameSettings_dsiwareBooter = pergameini.GetInt("GAMESETTINGS", "DSIWARE_BOOTER", -1);
-	perGameSettings_useBootstrap = pergameini.GetInt("GAMESETTINGS", "USE_BOOTSTRAP", -1);
+	perGameSettings_saveNo = pergameini.GetInt(GAMESETTINGS_SAVE_NUMBER, 0);
+	perGameSettings_ramDiskNo = pergameini.GetInt(GAMESETTINGS_RAM_DISK, -1);
+	perGameSettings_boostCpu = pergameini.GetInt(GAMESETTINGS_BOOST_CPU, -1);
+	perGameSettings_boostVram = pergameini.GetInt(GAMESETTINGS_BOOST_VRAM, -1);
+	perGameSettings_cardReadDMA = pergameini.GetInt(GAMESETTINGS_CARD_READ_DMA, -1);
+	perGameSettings_asyncCardRead = pergameini.GetInt(GAMESETTINGS_ASYNC_CARD_READ, -1);
+	perGameSettings_bootstrapFile = pergameini.GetInt(GAMESETTINGS_BOOTSTRAP_FILE, -1);
+	perGameSettings_wideScreen = pergameini.GetInt(GAMESETTINGS_WIDESCREEN, -1);
+	perGameSettings_expandRomSpace = pergameini.GetInt(GAMESETTINGS_EXTENDED_MEMORY, -1);
+	perGameSettings_dsiwareBooter = pergameini.GetInt(GAMESETTINGS_DSIWARE_BOOTER, -1);
+	perGameSettings_useBootstrap = pergameini.GetInt(GAMESETTINGS_USE_BOOTSTRAP, -1);
 }
 
 void savePerGameSettings (std::string filename) {
-	snprintf(pergamefilepath, sizeof(pergamefilepath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", (ms().secondaryDevice ? "fat:" : "sd:"), filename.c_str());
-	CIniFile pergameini( pergamefilepath);
+	GameSettings pergameini((ms().secondaryDevice ? "fat:" : "sd:"), filename);
 	if (isHomebrew) {
-		if (!ms().secondaryDevice) pergameini.SetInt("GAMESETTINGS", "LANGUAGE", perGameSettings_language);
+		if (!ms().secondaryDevice) pergameini.SetInt(GAMESETTINGS_LANGUAGE, perGameSettings_language);
 		if (isModernHomebrew) {
-			pergameini.SetInt("GAMESETTINGS", "REGION", perGameSettings_region);
+			pergameini.SetInt(GAMESETTINGS_REGION, perGameSettings_region);
 		}
-		if (!ms().secondaryDevice) pergameini.SetInt("GAMESETTINGS", "RAM_DISK", perGameSettings_ramDiskNo);
-		pergameini.SetInt("GAMESETTINGS", "DIRECT_BOOT", perGameSettings_directBoot);
+		if (!ms().secondaryDevice) pergameini.SetInt(GAMESETTINGS_RAM_DISK, perGameSettings_ramDiskNo);
+		pergameini.SetInt(GAMESETTINGS_DIRECT_BOOT, perGameSettings_directBoot);
 		if (isDSiMode() || !ms().secondaryDevice) {
-			pergameini.SetInt("GAMESETTINGS", "DSI_MODE", perGameSettings_dsiMode);
+			pergameini.SetInt(GAMESETTINGS_DSI_MODE, perGameSettings_dsiMode);
 		}
 		if (dsiFeatures()) {
-			pergameini.SetInt("GAMESETTINGS", "BOOST_CPU", perGameSettings_boostCpu);
-			pergameini.SetInt("GAMESETTINGS", "BOOST_VRAM", perGameSettings_boostVram);
+			pergameini.SetInt(GAMESETTINGS_BOOST_CPU, perGameSettings_boostCpu);
+			pergameini.SetInt(GAMESETTINGS_BOOST_VRAM, perGameSettings_boostVram);
 		}
 		if (!ms().secondaryDevice) {
-			pergameini.SetInt("GAMESETTINGS", "BOOTSTRAP_FILE", perGameSettings_bootstrapFile);
+			pergameini.SetInt(GAMESETTINGS_BOOTSTRAP_FILE, perGameSettings_bootstrapFile);
 		}
 		if (dsiFeatures() && ms().consoleModel >= 2 && sdFound()) {
-			pergameini.SetInt("GAMESETTINGS", "WIDESCREEN", perGameSettings_wideScreen);
+			pergameini.SetInt(GAMESETTINGS_WIDESCREEN, perGameSettings_wideScreen);
 		}
 	} else {
-		if ((perGameSettings_useBootstrap == -1 ? ms().useBootstrap : perGameSettings_useBootstrap) || (dsiFeatures() && romUnitCode > 0) || isDSiWare || !ms().secondaryDevice) pergameini.SetInt("GAMESETTINGS", "LANGUAGE", perGameSettings_language);
+		if ((perGameSettings_useBootstrap == -1 ? ms().useBootstrap : perGameSettings_useBootstrap) || (dsiFeatures() && romUnitCode > 0) || isDSiWare || !ms().secondaryDevice) pergameini.SetInt(GAMESETTINGS_LANGUAGE, perGameSettings_language);
 		if (!isDSiWare && ((perGameSettings_useBootstrap == -1 ? ms().useBootstrap : perGameSettings_useBootstrap) || (dsiFeatures() && romUnitCode > 0) || !ms().secondaryDevice)) {
-			pergameini.SetInt("GAMESETTINGS", "REGION", perGameSettings_region);
-			pergameini.SetInt("GAMESETTINGS", "DSI_MODE", perGameSettings_dsiMode);
+			pergameini.SetInt(GAMESETTINGS_REGION, perGameSettings_region);
+			pergameini.SetInt(GAMESETTINGS_DSI_MODE, perGameSettings_dsiMode);
 		} else if (isDSiWare) {
-			pergameini.SetInt("GAMESETTINGS", "REGION", perGameSettings_region);
+			pergameini.SetInt(GAMESETTINGS_REGION, perGameSettings_region);
 		}
-		pergameini.SetInt("GAMESETTINGS", "SAVE_NUMBER", perGameSettings_saveNo);
+		pergameini.SetInt(GAMESETTINGS_SAVE_NUMBER, perGameSettings_saveNo);
 		if (dsiFeatures()) {
-			if (!blacklisted_boostCpu) pergameini.SetInt("GAMESETTINGS", "BOOST_CPU", perGameSettings_boostCpu);
-			pergameini.SetInt("GAMESETTINGS", "BOOST_VRAM", perGameSettings_boostVram);
-			if (!blacklisted_cardReadDma) pergameini.SetInt("GAMESETTINGS", "CARD_READ_DMA", perGameSettings_cardReadDMA);
+			if (!blacklisted_boostCpu) pergameini.SetInt(GAMESETTINGS_BOOST_CPU, perGameSettings_boostCpu);
+			pergameini.SetInt(GAMESETTINGS_BOOST_VRAM, perGameSettings_boostVram);
+			if (!blacklisted_cardReadDma) pergameini.SetInt(GAMESETTINGS_CARD_READ_DMA, perGameSettings_cardReadDMA);
 		}
 		if (!ms().secondaryDevice) {
-			if (!blacklisted_asyncCardRead) pergameini.SetInt("GAMESETTINGS", "ASYNC_CARD_READ", perGameSettings_asyncCardRead);
+			if (!blacklisted_asyncCardRead) pergameini.SetInt(GAMESETTINGS_ASYNC_CARD_READ, perGameSettings_asyncCardRead);
 		} else {
-			pergameini.SetInt("GAMESETTINGS", "USE_BOOTSTRAP", perGameSettings_useBootstrap);
+			pergameini.SetInt(GAMESETTINGS_USE_BOOTSTRAP, perGameSettings_useBootstrap);
 		}
 		if ((perGameSettings_useBootstrap == -1 ? ms().useBootstrap : perGameSettings_useBootstrap) || (dsiFeatures() && romUnitCode > 0) || isDSiWare || !ms().secondaryDevice) {
-			pergameini.SetInt("GAMESETTINGS", "BOOTSTRAP_FILE", perGameSettings_bootstrapFile);
+			pergameini.SetInt(GAMESETTINGS_BOOTSTRAP_FILE, perGameSettings_bootstrapFile);
 		}
 		if (dsiFeatures() && ms().consoleModel >= 2 && sdFound()) {
-			pergameini.SetInt("GAMESETTINGS", "WIDESCREEN", perGameSettings_wideScreen);
+			pergameini.SetInt(GAMESETTINGS_WIDESCREEN, perGameSettings_wideScreen);
 		}
 		if ((dsiFeatures() && (perGameSettings_useBootstrap == -1 ? ms().useBootstrap : perGameSettings_useBootstrap)) || !ms().secondaryDevice) {
-			pergameini.SetInt("GAMESETTINGS", "EXTENDED_MEMORY", perGameSettings_expandRomSpace);
+			pergameini.SetInt(GAMESETTINGS_EXTENDED_MEMORY, perGameSettings_expandRomSpace);
 		}
 		if (isDSiWare && !sys().arm7SCFGLocked() && ms().consoleModel == TWLSettings::EDSiRetail) {
-			pergameini.SetInt("GAMESETTINGS", "DSIWARE_BOOTER", perGameSettings_dsiwareBooter);
+			pergameini.SetInt(GAMESETTINGS_DSIWARE_BOOTER, perGameSettings_dsiwareBooter);
 		}
 	}
-	pergameini.SaveIniFile( pergamefilepath );
+	pergameini.Save();
 }
 
 bool checkIfShowAPMsg (std::string filename) {
-	snprintf(pergamefilepath, sizeof(pergamefilepath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", (ms().secondaryDevice ? "fat:" : "sd:"), filename.c_str());
-	CIniFile pergameini(pergamefilepath);
-	return (pergameini.GetInt("GAMESETTINGS", "NO_SHOW_AP_MSG", 0) == 0);
+	GameSettings pergameini((ms().secondaryDevice ? "fat:" : "sd:"), filename);
+	return (pergameini.GetInt(GAMESETTINGS_NO_SHOW_AP_MSG, 0) == 0);
 }
 
 void dontShowAPMsgAgain (std::string filename) {
-	snprintf(pergamefilepath, sizeof(pergamefilepath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", (ms().secondaryDevice ? "fat:" : "sd:"), filename.c_str());
-	CIniFile pergameini(pergamefilepath);
-	pergameini.SetInt("GAMESETTINGS", "NO_SHOW_AP_MSG", 1);
-	pergameini.SaveIniFile(pergamefilepath);
+	GameSettings pergameini((ms().secondaryDevice ? "fat:" : "sd:"), filename);
+	pergameini.SetInt(GAMESETTINGS_NO_SHOW_AP_MSG, 1);
+	pergameini.Save();
 }
 
 bool checkIfShowRAMLimitMsg (std::string filename) {
-	snprintf(pergamefilepath, sizeof(pergamefilepath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", (ms().secondaryDevice ? "fat:" : "sd:"), filename.c_str());
-	CIniFile pergameini( pergamefilepath );
-	return (pergameini.GetInt("GAMESETTINGS", "NO_SHOW_RAM_LIMIT", 0) == 0);
+	GameSettings pergameini((ms().secondaryDevice ? "fat:" : "sd:"), filename);
+	return (pergameini.GetInt(GAMESETTINGS_NO_SHOW_RAM_LIMIT_MSG, 0) == 0);
 }
 
 void dontShowRAMLimitMsgAgain (std::string filename) {
-	snprintf(pergamefilepath, sizeof(pergamefilepath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", (ms().secondaryDevice ? "fat:" : "sd:"), filename.c_str());
-	CIniFile pergameini(pergamefilepath);
-	pergameini.SetInt("GAMESETTINGS", "NO_SHOW_RAM_LIMIT_MSG", 1);
-	pergameini.SaveIniFile(pergamefilepath);
+	GameSettings pergameini((ms().secondaryDevice ? "fat:" : "sd:"), filename);
+	pergameini.SetInt(GAMESETTINGS_NO_SHOW_RAM_LIMIT_MSG, 1);
+	pergameini.Save();
 }
 
 bool checkIfDSiMode (std::string filename) {
@@ -209,9 +200,8 @@ bool checkIfDSiMode (std::string filename) {
 		return false;
 	}
 
-	snprintf(pergamefilepath, sizeof(pergamefilepath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", (ms().secondaryDevice ? "fat:" : "sd:"), filename.c_str());
-	CIniFile pergameini( pergamefilepath );
-	perGameSettings_dsiMode = pergameini.GetInt("GAMESETTINGS", "DSI_MODE", (isModernHomebrew ? true : -1));
+	GameSettings pergameini((ms().secondaryDevice ? "fat:" : "sd:"), filename);
+	perGameSettings_dsiMode = pergameini.GetInt(GAMESETTINGS_DSI_MODE, (isModernHomebrew ? true : -1));
 	if (perGameSettings_dsiMode == -1) {
 		return DEFAULT_DSI_MODE;
 	} else {
@@ -372,27 +362,10 @@ void perGameSettings (std::string filename) {
 	blacklisted_cardReadDma = false;
 	blacklisted_asyncCardRead = false;
 	if (!ms().ignoreBlacklists) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(twlClockExcludeList)/sizeof(twlClockExcludeList[0]); i++) {
-			if (memcmp(game_TID, twlClockExcludeList[i], 3) == 0) {
-				// Found match
-				blacklisted_boostCpu = true;
-			}
-		}
-
-		for (unsigned int i = 0; i < sizeof(cardReadDMAExcludeList)/sizeof(cardReadDMAExcludeList[0]); i++) {
-			if (memcmp(game_TID, cardReadDMAExcludeList[i], 3) == 0) {
-				// Found match
-				blacklisted_cardReadDma = true;
-			}
-		}
-
-		for (unsigned int i = 0; i < sizeof(asyncReadExcludeList)/sizeof(asyncReadExcludeList[0]); i++) {
-			if (memcmp(game_TID, asyncReadExcludeList[i], 3) == 0) {
-				// Found match
-				blacklisted_asyncCardRead = true;
-			}
-		}
+		const u32 gameRules = getGameRules(game_TID);
+		blacklisted_boostCpu = (gameRules & GAMERULE_NO_TWL_CLOCK);
+		blacklisted_cardReadDma = (gameRules & GAMERULE_NO_CARD_DMA);
+		blacklisted_asyncCardRead = (gameRules & GAMERULE_NO_ASYNC_READ);
 	}
 
 	bool showSDKVersion = false;
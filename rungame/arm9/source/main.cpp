@@ -22,7 +22,7 @@
 #include "myDSiMode.h"
 #include "twlFlashcard.h"
 
-#include "twlClockExcludeMap.h"
+#include "gameRules.h"
 #include "saveMap.h"
 #include "ROMList.h"
 
@@ -62,13 +62,9 @@ void stop (void) {
  */
 bool setClockSpeed(char gameTid[]) {
 	if (!ms().ignoreBlacklists) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(twlClockExcludeList)/sizeof(twlClockExcludeList[0]); i++) {
-			if (memcmp(gameTid, twlClockExcludeList[i], 3) == 0) {
-				// Found match	
-				dsModeForced = true;
-				return false;
-			}
+		if (getGameRules(gameTid) & GAMERULE_NO_TWL_CLOCK) {
+			dsModeForced = true;
+			return false;
 		}
 	}
 
@@ -278,13 +274,8 @@ int lastRunROM() {
 					u32 gameTidHex = 0;
 					tonccpy(&gameTidHex, &game_TID, 4);
 
-					for (int i = 0; i < (int)sizeof(ROMList)/12; i++) {
-						ROMListEntry* curentry = &ROMList[i];
-						if (gameTidHex == curentry->GameCode) {
-							if (curentry->SaveMemType != 0xFFFFFFFF) savesize = sramlen[curentry->SaveMemType];
-							break;
-						}
-					}
+					int saveMemType = lookupSaveInfo(gameTidHex);
+					if (saveMemType != -1) savesize = sramlen[saveMemType];
 
 					if ((orgsavesize == 0 && savesize > 0) || (orgsavesize < savesize)) {
 						consoleDemoInit();
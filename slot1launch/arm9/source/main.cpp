@@ -25,13 +25,14 @@
 #include <string.h>
 #include <list>
 
-#include "twlClockExcludeMap.h"
+#include "gameRules.h"
 #include "defaultSettings.h"
 #include "common/inifile.h"
+#include "gamesettings/gameSettingsDb.h"
 #include "common/tonccpy.h"
 #include "nds_card.h"
 #include "launch_engine.h"
-#include "crc.h"
+#include "common/crc32.h"
 
 sNDSHeader ndsHeader;
 
@@ -52,12 +53,8 @@ int language = -1;
  */
 bool setClockSpeed(int setting, char gameTid[], bool ignoreBlacklists) {
 	if (!ignoreBlacklists) {
-		// TODO: If the list gets large enough, switch to bsearch().
-		for (unsigned int i = 0; i < sizeof(twlClockExcludeList)/sizeof(twlClockExcludeList[0]); i++) {
-			if (memcmp(gameTid, twlClockExcludeList[i], 3) == 0) {
-				// Found match
-				return false;
-			}
+		if (getGameRules(gameTid) & GAMERULE_NO_TWL_CLOCK) {
+			return false;
 		}
 	}
 
@@ -112,13 +109,10 @@ int main() {
 
 			char gameTid[5];
 			tonccpy(gameTid, ndsHeader.gameCode, 4);
-			char pergamefilepath[256];
-			sprintf(pergamefilepath, "/_nds/TWiLightMenu/gamesettings/slot1/%s.ini", gameTid);
-
-			CIniFile pergameini(pergamefilepath);
-			TWLMODE = pergameini.GetInt("GAMESETTINGS","DSI_MODE",-1);
-			TWLCLK = setClockSpeed(pergameini.GetInt("GAMESETTINGS","BOOST_CPU",-1), gameTid, ignoreBlacklists);
-			TWLVRAM = pergameini.GetInt("GAMESETTINGS","BOOST_VRAM",-1);
+			GameSettings pergameini("", "slot1/" + std::string(gameTid, 4));
+			TWLMODE = pergameini.GetInt(GAMESETTINGS_DSI_MODE,-1);
+			TWLCLK = setClockSpeed(pergameini.GetInt(GAMESETTINGS_BOOST_CPU,-1), gameTid, ignoreBlacklists);
+			TWLVRAM = pergameini.GetInt(GAMESETTINGS_BOOST_VRAM,-1);
 
 			if (TWLMODE == -1) {
 				TWLMODE = DEFAULT_DSI_MODE;
@@ -0,0 +1,656 @@
+// The cheat list: parsed in place from usrcheat.dat's block, folders only
+// once opened, against the parser that copied every cheat out before
+
+#include <nds.h>
+#include <string>
+#include <vector>
+// To get at the list's items, as the menu does
+#define private public
+#include "cheat.h"
+#undef private
+#include "common/cheatIndex.h"
+#include "hostTest.h"
+
+#include <stdlib.h>
+#include <sys/stat.h>
+
+// tonccpy.c casts pointers to u32, so the copies are plain ones on a host
+extern "C" void tonccpy(void *dst, const void *src, uint size) { memcpy(dst, src, size); }
+extern "C" void __toncset(void *dst, u32 fill, uint size) {
+	for (uint i = 0; i < size; i++)
+		((u8 *)dst)[i] = fill >> ((i % 4) * 8);
+}
+
+// cheatIndexFind() keeps its index on "sd:", which on a host is a directory in the working directory
+bool sdFound(void) { return true; }
+
+#ifndef __SANITIZE_ADDRESS__
+/*
+ * Count what's allocated, for the peak memory of a parse. ASan has its own
+ * allocator, so a sanitized build only times the parsers.
+ */
+#include <malloc.h>
+#define COUNT_MEMORY
+
+static long long liveBytes = 0, peakBytes = 0;
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void __libc_free(void *ptr);
+
+static void *counted(void *ptr) {
+	if (ptr) {
+		liveBytes += malloc_usable_size(ptr);
+		if (liveBytes > peakBytes)
+			peakBytes = liveBytes;
+	}
+	return ptr;
+}
+
+void *malloc(size_t size) { return counted(__libc_malloc(size)); }
+void *calloc(size_t count, size_t size) { return counted(__libc_calloc(count, size)); }
+void free(void *ptr) {
+	if (ptr)
+		liveBytes -= malloc_usable_size(ptr);
+	__libc_free(ptr);
+}
+void *realloc(void *ptr, size_t size) {
+	const long long oldSize = ptr ? malloc_usable_size(ptr) : 0;
+	void *moved = __libc_realloc(ptr, size);
+	if (moved || size == 0)
+		liveBytes -= oldSize;
+	return counted(moved);
+}
+}
+#endif
+
+/*
+ * The list as it was: each cheat's name, note and code words copied out of
+ * the block, folders' cheats and all. Its pointer casts are widened for a
+ * 64-bit host. It doesn't fwrite() from an empty vector's NULL, nor look
+ * past the end for a folder's last cheat, which the sanitizers stop on. The menu's L and saving are as selectCheats() and
+ * onGenerate() had them.
+ */
+class OldCheatCodelist
+{
+public:
+  class cParsedItem
+  {
+    public:
+      std::string _title;
+      std::string _comment;
+      std::vector<u32> _cheat;
+      u32 _flags;
+      u32 _offset;
+      cParsedItem(const std::string& title,const std::string& comment,u32 flags,u32 offset=0):_title(title),_comment(comment),_flags(flags),_offset(offset) {};
+      enum
+      {
+        EFolder=1,
+        EInFolder=2,
+        EOne=4,
+        ESelected=8,
+        EOpen=16
+      };
+  };
+  std::vector<cParsedItem> _data;
+
+  bool searchCheatData(FILE* aDat,u32 gamecode,u32 crc32,long& aPos,size_t& aSize)
+  {
+    aPos=0;
+    aSize=0;
+    const char* KHeader="R4 CheatCode";
+    char header[12];
+    fread(header,12,1,aDat);
+    if (strncmp(KHeader,header,12)) return false;
+
+    u32 offset,size;
+    if (!cheatIndexFind(aDat,gamecode,crc32,offset,size)) return false;
+    aPos=offset;
+    aSize=size;
+    return (aPos&&aSize);
+  }
+
+  bool parseInternal(FILE* aDat,u32 gamecode,u32 crc32)
+  {
+    _data.clear();
+
+    long dataPos; size_t dataSize;
+    if (!searchCheatData(aDat,gamecode,crc32,dataPos,dataSize)) return false;
+    fseek(aDat,dataPos,SEEK_SET);
+
+    char* buffer=(char*)malloc(dataSize);
+    if (!buffer) return false;
+    fread(buffer,dataSize,1,aDat);
+    char* gameTitle=buffer;
+
+    u32* ccode=(u32*)(((uintptr_t)gameTitle+strlen(gameTitle)+4)&~3);
+    u32 cheatCount=*ccode;
+    cheatCount&=0x0fffffff;
+    ccode+=9;
+
+    u32 cc=0;
+    while (cc<cheatCount)
+    {
+      u32 folderCount=1;
+      char* folderName=NULL;
+      char* folderNote=NULL;
+      u32 flagItem=0;
+      if ((*ccode>>28)&1)
+      {
+        flagItem|=cParsedItem::EInFolder;
+        if ((*ccode>>24)==0x11) flagItem|=cParsedItem::EOne;
+        folderCount=*ccode&0x00ffffff;
+        folderName=(char*)((uintptr_t)ccode+4);
+        folderNote=(char*)((uintptr_t)folderName+strlen(folderName)+1);
+        _data.push_back(cParsedItem(folderName,folderNote,cParsedItem::EFolder));
+        cc++;
+        ccode=(u32*)(((uintptr_t)folderName+strlen(folderName)+1+strlen(folderNote)+1+3)&~3);
+      }
+
+      u32 selectValue=cParsedItem::ESelected;
+      for (size_t ii=0;ii<folderCount;++ii)
+      {
+        char* cheatName=(char*)((uintptr_t)ccode+4);
+        char* cheatNote=(char*)((uintptr_t)cheatName+strlen(cheatName)+1);
+        u32* cheatData=(u32*)(((uintptr_t)cheatNote+strlen(cheatNote)+1+3)&~3);
+        u32 cheatDataLen=*cheatData++;
+
+        if (cheatDataLen)
+        {
+          _data.push_back(cParsedItem(cheatName,cheatNote,flagItem|((*ccode&0xff000000)?selectValue:0),dataPos+(((char*)ccode+3)-buffer)));
+          if ((*ccode&0xff000000)&&(flagItem&cParsedItem::EOne)) selectValue=0;
+          _data.back()._cheat.resize(cheatDataLen);
+          tonccpy(_data.back()._cheat.data(),cheatData,cheatDataLen*4);
+        }
+        cc++;
+        ccode=(u32*)((uintptr_t)ccode+(((*ccode&0x00ffffff)+1)*4));
+      }
+    }
+    free(buffer);
+    return true;
+  }
+
+  void deselectFolder(size_t anIndex)
+  {
+    std::vector<cParsedItem>::iterator itr=_data.begin()+anIndex;
+    while (--itr>=_data.begin())
+    {
+      if ((*itr)._flags&cParsedItem::EFolder)
+      {
+        ++itr;
+        break;
+      }
+    }
+    while (itr!=_data.end()&&((*itr)._flags&cParsedItem::EInFolder))
+    {
+      (*itr)._flags&=~cParsedItem::ESelected;
+      ++itr;
+    }
+  }
+
+  void deselectAll(void)
+  {
+    for (auto itr = _data.begin(); itr != _data.end(); itr++) {
+      (*itr)._flags &= ~cParsedItem::ESelected;
+    }
+  }
+
+  void writeSelection(FILE* db)
+  {
+    for (size_t i=0;i<_data.size();i++)
+    {
+      if (!_data[i]._offset) continue;
+      const u8 value=(_data[i]._flags&cParsedItem::ESelected)?1:0;
+      fseek(db,_data[i]._offset,SEEK_SET);
+      fwrite(&value,sizeof(value),1,db);
+    }
+  }
+
+  std::vector<u32> getCheats()
+  {
+    std::vector<u32> cheats;
+    for (uint i=0;i<_data.size();i++)
+    {
+      if (_data[i]._flags&cParsedItem::ESelected)
+      {
+        cheats.insert(cheats.end(),_data[i]._cheat.begin(),_data[i]._cheat.end());
+      }
+    }
+    return cheats;
+  }
+
+  void writeCheatsToFile(const char *path) {
+    FILE *file = fopen(path, "wb");
+    if (file) {
+      std::vector<u32> cheats(getCheats());
+      if (!cheats.empty()) fwrite(cheats.data(),4,cheats.size(),file);
+      fwrite("\0\0\0\xCF",4,1,file);
+      fclose(file);
+    }
+  }
+};
+
+typedef CheatCodelist::cParsedItem NewItem;
+typedef OldCheatCodelist::cParsedItem OldItem;
+
+static u32 seed = 1;
+
+static u32 nextRandom(u32 range) {
+	seed = seed * 1103515245 + 12345;
+	return (seed >> 8) % range;
+}
+
+static void putWord(std::vector<u8> &block, u32 word) {
+	for (int i = 0; i < 4; i++)
+		block.push_back(word >> (i * 8));
+}
+
+static void putText(std::vector<u8> &block, const char *prefix, u32 maxLength) {
+	const std::string text = maxLength ? prefix + std::string(nextRandom(maxLength), 'a' + nextRandom(26)) : "";
+	block.insert(block.end(), text.begin(), text.end());
+	block.push_back(0);
+}
+
+static void alignBlock(std::vector<u8> &block) {
+	while (block.size() % 4)
+		block.push_back(0);
+}
+
+/**
+ * A cheat as usrcheat.dat has it: a word with whether it's selected and how
+ * many words follow, its name and note, then its code words. Some have no
+ * code words, which neither parser lists.
+ */
+static void putCheat(std::vector<u8> &block, u32 maxCodes, u32 maxNote) {
+	std::vector<u8> cheat;
+	putText(cheat, "Cheat ", 40);
+	putText(cheat, "", nextRandom(4) ? 0 : maxNote);
+	alignBlock(cheat);
+	const u32 codes = (nextRandom(20) == 0) ? 0 : (1 + nextRandom(maxCodes)) * 2;
+	putWord(cheat, codes);
+	for (u32 i = 0; i < codes; i++)
+		putWord(cheat, (i % 2) ? nextRandom(0x10000) : (0x02000000 + nextRandom(0x400000)));
+	putWord(block, (nextRandom(3) == 0 ? 0x01000000 : 0) | (cheat.size() / 4));
+	block.insert(block.end(), cheat.begin(), cheat.end());
+}
+
+/**
+ * A game's block: its name, its count of folders and cheats, then those, with
+ * some folders where only one cheat can be selected. usrcheat.dat can have
+ * more than one of those selected, of which the first is used.
+ */
+static std::vector<u8> makeBlock(u32 folders, u32 cheatsPerFolder, u32 cheatsOutside, u32 maxCodes, u32 maxNote) {
+	std::vector<u8> items;
+	u32 count = 0;
+	u32 folder = 0, outside = 0;
+	while (folder < folders || outside < cheatsOutside) {
+		if (folder < folders && (outside == cheatsOutside || nextRandom(2))) {
+			const u32 cheats = nextRandom(cheatsPerFolder * 2 + 1);
+			putWord(items, (nextRandom(3) == 0 ? 0x11000000 : 0x10000000) | cheats);
+			putText(items, "Folder ", 30);
+			putText(items, "", nextRandom(2) ? 0 : maxNote);
+			alignBlock(items);
+			for (u32 i = 0; i < cheats; i++)
+				putCheat(items, maxCodes, maxNote);
+			count += 1 + cheats;
+			folder++;
+		} else {
+			putCheat(items, maxCodes, maxNote);
+			count++;
+			outside++;
+		}
+	}
+
+	std::vector<u8> block;
+	putText(block, "Game ", 30);
+	alignBlock(block);
+	putWord(block, count | 0xF0000000);
+	for (int i = 0; i < 8; i++)
+		putWord(block, 0);
+	block.insert(block.end(), items.begin(), items.end());
+	return block;
+}
+
+struct Game {
+	u32 gameCode;
+	u32 crc32;
+	u32 offset;
+	u32 size;
+};
+
+// usrcheat.dat: its header, its index, then each game's block
+static std::vector<Game> writeDat(const char *path, const std::vector<std::vector<u8>> &blocks) {
+	std::vector<Game> games;
+	u32 offset = 0x100 + (blocks.size() + 1) * 16;
+	for (size_t i = 0; i < blocks.size(); i++) {
+		const Game game = {0x41414141 + (u32)i, 0x01000193 * (u32)(i + 1), offset, (u32)blocks[i].size()};
+		games.push_back(game);
+		offset += blocks[i].size();
+	}
+
+	std::vector<u8> dat(0x100, 0);
+	memcpy(dat.data(), "R4 CheatCode", 12);
+	for (const Game &game : games) {
+		putWord(dat, game.gameCode);
+		putWord(dat, game.crc32);
+		putWord(dat, game.offset);
+		putWord(dat, 0);
+	}
+	dat.resize(dat.size() + 16, 0);
+	for (const std::vector<u8> &block : blocks)
+		dat.insert(dat.end(), block.begin(), block.end());
+
+	FILE *file = fopen(path, "wb");
+	fwrite(dat.data(), 1, dat.size(), file);
+	fclose(file);
+	return games;
+}
+
+template <class List>
+static bool parseGame(List &list, const char *datPath, const Game &game) {
+	FILE *dat = fopen(datPath, "rb");
+	const bool parsed = list.parseInternal(dat, game.gameCode, game.crc32);
+	fclose(dat);
+	return parsed;
+}
+
+static std::vector<u8> readFile(const char *path, long offset = 0, long size = -1) {
+	FILE *file = fopen(path, "rb");
+	if (size < 0) {
+		fseek(file, 0, SEEK_END);
+		size = ftell(file) - offset;
+	}
+	std::vector<u8> data(size);
+	fseek(file, offset, SEEK_SET);
+	data.resize(fread(data.data(), 1, size, file));
+	fclose(file);
+	return data;
+}
+
+static void writeRange(const char *path, long offset, const std::vector<u8> &data) {
+	FILE *file = fopen(path, "r+b");
+	fseek(file, offset, SEEK_SET);
+	fwrite(data.data(), 1, data.size(), file);
+	fclose(file);
+}
+
+/**
+ * Whether both lists write the same codes for the game, and store the same
+ * selection in usrcheat.dat. Each saves into its own copy of the .dat, put
+ * back as it was after.
+ */
+static bool sameOutput(CheatCodelist &list, OldCheatCodelist &oldList, const Game &game) {
+	list.writeCheatsToFile("cheats.bin");
+	oldList.writeCheatsToFile("oldCheats.bin");
+	bool same = readFile("cheats.bin") == readFile("oldCheats.bin");
+
+	FILE *dat = fopen("saved.dat", "r+b");
+	list.writeSelection(dat);
+	fclose(dat);
+	dat = fopen("oldSaved.dat", "r+b");
+	oldList.writeSelection(dat);
+	fclose(dat);
+	same = same && readFile("saved.dat", game.offset, game.size) == readFile("oldSaved.dat", game.offset, game.size);
+
+	const std::vector<u8> original = readFile("usrcheat.dat", game.offset, game.size);
+	writeRange("saved.dat", game.offset, original);
+	writeRange("oldSaved.dat", game.offset, original);
+	return same;
+}
+
+static std::string text(const char *str) {
+	return std::string(str);
+}
+
+// Whether the folders and cheats outside them are listed the same, as the menu first shows them
+static bool sameTopList(const CheatCodelist &list, const OldCheatCodelist &oldList) {
+	std::vector<const NewItem *> items;
+	for (const NewItem &item : list._data) {
+		if (!(item._flags & NewItem::EInFolder))
+			items.push_back(&item);
+	}
+	std::vector<const OldItem *> oldItems;
+	for (const OldItem &item : oldList._data) {
+		if (!(item._flags & OldItem::EInFolder))
+			oldItems.push_back(&item);
+	}
+	if (items.size() != oldItems.size())
+		return false;
+	for (size_t i = 0; i < items.size(); i++) {
+		if (text(list.title(*items[i])) != oldItems[i]->_title || text(list.comment(*items[i])) != oldItems[i]->_comment
+		 || (items[i]->_flags & (NewItem::EFolder | NewItem::ESelected)) != (oldItems[i]->_flags & (OldItem::EFolder | OldItem::ESelected)))
+			return false;
+	}
+	return true;
+}
+
+// Whether, with every folder open, each item is the same
+static bool sameFullList(const CheatCodelist &list, const OldCheatCodelist &oldList) {
+	if (list._data.size() != oldList._data.size())
+		return false;
+	for (size_t i = 0; i < list._data.size(); i++) {
+		const NewItem &item = list._data[i];
+		const OldItem &oldItem = oldList._data[i];
+		const u32 flags = (item._flags & NewItem::EFolder) ? NewItem::EFolder : (item._flags & (NewItem::EInFolder | NewItem::EOne | NewItem::ESelected));
+		const std::vector<u32> codes((const u32 *)(list._arena + item._cheat), (const u32 *)(list._arena + item._cheat) + item._cheatCount);
+		if (text(list.title(item)) != oldItem._title || text(list.comment(item)) != oldItem._comment || flags != oldItem._flags
+		 || item._offset != oldItem._offset || (!(flags & NewItem::EFolder) && codes != oldItem._cheat))
+			return false;
+	}
+	return true;
+}
+
+template <class List>
+static int findOffset(const List &list, u32 offset) {
+	for (size_t i = 0; i < list._data.size(); i++) {
+		if (list._data[i]._offset == offset)
+			return i;
+	}
+	return -1;
+}
+
+template <class List>
+static int findFolder(const List &list, u32 folder) {
+	for (size_t i = 0; i < list._data.size(); i++) {
+		if ((list._data[i]._flags & 1) && folder-- == 0)
+			return i;
+	}
+	return -1;
+}
+
+// A press on a cheat, as selectCheats() handles it
+template <class List, class Item>
+static void pressA(List &list, size_t index) {
+	Item &cheat = list._data[index];
+	bool select = !(cheat._flags & Item::ESelected);
+	if (cheat._flags & Item::EOne)
+		list.deselectFolder(index);
+	if (select || !(cheat._flags & Item::EOne))
+		cheat._flags ^= Item::ESelected;
+}
+
+// Press A on some of the cheats the new list shows, and the same ones in the old
+static void toggleShown(CheatCodelist &list, OldCheatCodelist &oldList, bool inFolders) {
+	for (size_t i = 0; i < list._data.size(); i++) {
+		const NewItem &item = list._data[i];
+		if ((item._flags & NewItem::EFolder) || !(item._flags & NewItem::EInFolder) == inFolders || nextRandom(3))
+			continue;
+		const int oldIndex = findOffset(oldList, item._offset);
+		if (oldIndex < 0)
+			continue;
+		pressA<CheatCodelist, NewItem>(list, i);
+		pressA<OldCheatCodelist, OldItem>(oldList, oldIndex);
+	}
+}
+
+static u32 folderCount(const CheatCodelist &list) {
+	u32 folders = 0;
+	for (const NewItem &item : list._data)
+		folders += (item._flags & NewItem::EFolder) ? 1 : 0;
+	return folders;
+}
+
+static void openAll(CheatCodelist &list) {
+	for (u32 folder = 0; folder < folderCount(list); folder++)
+		list.openFolder(findFolder(list, folder));
+}
+
+static void openSome(CheatCodelist &list) {
+	for (u32 folder = 0; folder < folderCount(list); folder++) {
+		if (nextRandom(2))
+			list.openFolder(findFolder(list, folder));
+	}
+}
+
+/**
+ * For generated games, the codes written and the selection saved match the
+ * old parser's: as parsed, with cheats selected outside folders, with some
+ * folders opened and cheats in them selected, and with every folder open.
+ */
+static int changedGames(const char *datPath, const std::vector<Game> &games) {
+	int failed = 0;
+	for (const Game &game : games) {
+		CheatCodelist list;
+		OldCheatCodelist oldList;
+		bool same = parseGame(list, datPath, game) && parseGame(oldList, datPath, game);
+		same = same && sameTopList(list, oldList) && sameOutput(list, oldList, game);
+
+		toggleShown(list, oldList, false);
+		same = same && sameTopList(list, oldList) && sameOutput(list, oldList, game);
+
+		openSome(list);
+		toggleShown(list, oldList, true);
+		same = same && sameOutput(list, oldList, game);
+
+		openAll(list);
+		toggleShown(list, oldList, true);
+		same = same && sameFullList(list, oldList) && sameOutput(list, oldList, game);
+		if (!same)
+			failed++;
+	}
+	return failed;
+}
+
+/**
+ * Deselecting all with L, with only some folders opened: the cheats of the
+ * others are saved deselected, aren't written, and are shown deselected once
+ * opened, as the old list had them.
+ */
+static int changedGamesAfterL(const char *datPath, const std::vector<Game> &games) {
+	int failed = 0;
+	for (const Game &game : games) {
+		CheatCodelist list;
+		OldCheatCodelist oldList;
+		bool same = parseGame(list, datPath, game) && parseGame(oldList, datPath, game);
+
+		openSome(list);
+		toggleShown(list, oldList, true);
+		list.deselectAll();
+		oldList.deselectAll();
+		same = same && sameOutput(list, oldList, game);
+
+		// Select again after L, then open the rest
+		toggleShown(list, oldList, false);
+		openSome(list);
+		toggleShown(list, oldList, true);
+		same = same && sameOutput(list, oldList, game);
+
+		openAll(list);
+		same = same && sameFullList(list, oldList) && sameOutput(list, oldList, game);
+		if (!same)
+			failed++;
+	}
+	return failed;
+}
+
+static void copyFile(const char *from, const char *to) {
+	const std::vector<u8> data = readFile(from);
+	FILE *file = fopen(to, "wb");
+	fwrite(data.data(), 1, data.size(), file);
+	fclose(file);
+}
+
+static void testParsers(void) {
+	std::vector<std::vector<u8>> blocks;
+	for (int i = 0; i < 150; i++)
+		blocks.push_back(makeBlock(nextRandom(12), 1 + nextRandom(10), nextRandom(20), 8, 60));
+	// No folders, only folders, and an empty game
+	blocks.push_back(makeBlock(0, 0, 30, 8, 60));
+	blocks.push_back(makeBlock(10, 5, 0, 8, 60));
+	blocks.push_back(makeBlock(0, 0, 0, 8, 60));
+	const std::vector<Game> games = writeDat("usrcheat.dat", blocks);
+	copyFile("usrcheat.dat", "saved.dat");
+	copyFile("usrcheat.dat", "oldSaved.dat");
+
+	CHECK(changedGames("usrcheat.dat", games) == 0);
+	CHECK(changedGamesAfterL("usrcheat.dat", games) == 0);
+
+	// A game that isn't in the .dat
+	CheatCodelist list;
+	Game missing = games[0];
+	missing.crc32++;
+	CHECK(!parseGame(list, "usrcheat.dat", missing));
+	CHECK(list._data.empty());
+}
+
+/**
+ * One large game, as in the sizes of the largest in usrcheat.dat, parsed with
+ * each. Each time is the best of 50, and what's allocated at once at most
+ * is measured from before the parse to when its list is freed.
+ */
+template <class List>
+static void benchParse(const char *name, const char *datPath, const Game &game) {
+	double best = 1e9;
+	long long peak = 0;
+	for (int i = 0; i < 50; i++) {
+#ifdef COUNT_MEMORY
+		const long long before = liveBytes;
+		peakBytes = liveBytes;
+#endif
+		List *list = new List;
+		const double start = hostMillis();
+		parseGame(*list, datPath, game);
+		const double time = hostMillis() - start;
+		delete list;
+		if (time < best)
+			best = time;
+#ifdef COUNT_MEMORY
+		peak = peakBytes - before;
+#endif
+	}
+#ifdef COUNT_MEMORY
+	printf("cheatTest: %s parser %.0f us, peak memory %.2f MB\n", name, best * 1000, peak / 1048576.0);
+#else
+	(void)peak;
+	printf("cheatTest: %s parser %.0f us\n", name, best * 1000);
+#endif
+}
+
+static void benchParsers(void) {
+	std::vector<std::vector<u8>> blocks;
+	blocks.push_back(makeBlock(300, 19, 300, 36, 300));
+	const std::vector<Game> games = writeDat("bench.dat", blocks);
+
+	CheatCodelist list;
+	parseGame(list, "bench.dat", games[0]);
+	openAll(list);
+	printf("cheatTest: a %.2f MB game, with %u folders and %u cheats\n", games[0].size / 1048576.0, folderCount(list), (u32)list._data.size() - folderCount(list));
+
+	benchParse<OldCheatCodelist>("old", "bench.dat", games[0]);
+	benchParse<CheatCodelist>("arena", "bench.dat", games[0]);
+}
+
+int main(int argc, char **argv) {
+	mkdir("sd:", 0777);
+	mkdir("sd:/_nds", 0777);
+	mkdir("sd:/_nds/TWiLightMenu", 0777);
+
+	testParsers();
+
+	if (benchRequested(argc, argv))
+		benchParsers();
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,172 @@
+// rgbaToBgr555() against the per-pixel loops it replaced, bit for bit
+
+#include "common/colorConvert.h"
+#include "hostTest.h"
+
+#include <stdlib.h>
+#include <vector>
+
+static u16 convertVramColorToGrayscale(u16 val) {
+	u8 b,g,r,max,min;
+	b = ((val)>>10)&31;
+	g = ((val)>>5)&31;
+	r = (val)&31;
+	max = (b > g) ? b : g;
+	max = (max > r) ? max : r;
+	min = (b < g) ? b : g;
+	min = (min < r) ? min : r;
+	max = (max + min) / 2;
+	return BIT(15)|(max<<10)|(max<<5)|(max);
+}
+
+static u16 alphablend(const u16 fg, const u16 bg, const u8 alpha) {
+	u16 fg_b, fg_g, fg_r, bg_b, bg_g, bg_r;
+	fg_b = ((fg) >> 10) & 31;
+	fg_g = ((fg) >> 5) & 31;
+	fg_r = (fg)&31;
+	bg_b = ((bg) >> 10) & 31;
+	bg_g = ((bg) >> 5) & 31;
+	bg_r = (bg)&31;
+	u16 out_r = fg_r * alpha + bg_r * (255 - alpha);
+	u16 out_g = fg_g * alpha + bg_g * (255 - alpha);
+	u16 out_b = fg_b * alpha + bg_b * (255 - alpha);
+	out_r = std::min((out_r + 1 + (out_r >> 8)) >> 8, 255);
+	out_g = std::min((out_g + 1 + (out_g >> 8)) >> 8, 255);
+	out_b = std::min((out_b + 1 + (out_b >> 8)) >> 8, 255);
+	return (u16) (BIT(15) | (out_b << 10) | (out_g << 5) | out_r);
+}
+
+static u16 referencePixel(const u8 *p, u32 flags) {
+	const bool swap = (flags & COLORCONVERT_SWAP_RB);
+	u16 color = p[swap ? 2 : 0]>>3 | (p[1]>>3)<<5 | (p[swap ? 0 : 2]>>3)<<10 | BIT(15);
+	if (flags & COLORCONVERT_GRAYSCALE) {
+		color = convertVramColorToGrayscale(color);
+	}
+	if (flags & COLORCONVERT_ALPHA) {
+		color = (p[3] > 0) ? alphablend(color, 0, p[3]) : 0;
+	}
+	return color;
+}
+
+// The loop the photo, box art, splash and imageview code each had a copy of, writing packed top-down rows
+static void referenceConvert(std::vector<u8> image, u32 width, u32 height, u32 bytesPerPixel, u32 flags, bool deband, u16 *out, u16 *out2) {
+	bool alternatePixel = false;
+	for (u32 i = 0; i < width*height; i++) {
+		u8 *p = &image[i*bytesPerPixel];
+		u8 pixelAdjustInfo = 0;
+		if (deband && alternatePixel) {
+			for (int c = 0; c < 3; c++) {
+				if (p[c] >= 0x4) {
+					p[c] -= 0x4;
+					pixelAdjustInfo |= BIT(c);
+				}
+			}
+		}
+		out[i] = referencePixel(p, flags);
+		if (deband) {
+			for (int c = 0; c < 3; c++) {
+				if (alternatePixel) {
+					if (pixelAdjustInfo & BIT(c)) p[c] += 0x4;
+				} else {
+					if (p[c] >= 0x4) p[c] -= 0x4;
+				}
+			}
+			out2[i] = referencePixel(p, flags);
+			if ((i % width) == width-1) alternatePixel = !alternatePixel;
+			alternatePixel = !alternatePixel;
+		}
+	}
+}
+
+static std::vector<u8> randomImage(u32 width, u32 height, u32 bytesPerPixel) {
+	std::vector<u8> image(width * height * bytesPerPixel);
+	for (u8 &byte : image) {
+		// Plenty of values under 4 and of 0 alpha, where the edge cases are
+		const int r = rand();
+		byte = (r & 3) == 0 ? (r >> 2) & 7 : (r >> 2);
+	}
+	return image;
+}
+
+// One random image through both, with the rows placed as the flags ask
+static bool matchesReference(u32 flags, u32 bytesPerPixel, bool deband, bool bottomUp) {
+	const u32 width = 1 + rand() % 40;
+	const u32 height = 1 + rand() % 12;
+	const std::vector<u8> image = randomImage(width, height, bytesPerPixel);
+
+	std::vector<u16> expected(width * height), expected2(width * height);
+	referenceConvert(image, width, height, bytesPerPixel, flags, deband, expected.data(), expected2.data());
+
+	// Offsets of 0 or 1 pixel put each frame on or off a word boundary
+	const int stride = width + rand() % 3;
+	std::vector<u16> frame(stride * height + 2, 0xDEAD), frame2(stride * height + 2, 0xDEAD);
+	u16 *first = frame.data() + rand() % 2;
+	u16 *second = frame2.data() + rand() % 2;
+	if (bottomUp) {
+		rgbaToBgr555(first + (height - 1) * stride, deband ? second + (height - 1) * stride : NULL, -stride, image.data(), width, height, bytesPerPixel, flags);
+	} else {
+		rgbaToBgr555(first, deband ? second : NULL, stride, image.data(), width, height, bytesPerPixel, flags);
+	}
+
+	for (u32 y = 0; y < height; y++) {
+		const u32 row = bottomUp ? height - 1 - y : y;
+		for (u32 x = 0; x < width; x++) {
+			if (first[row * stride + x] != expected[y * width + x])
+				return false;
+			if (deband && second[row * stride + x] != expected2[y * width + x])
+				return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char **argv) {
+	srand(1);
+
+	// PNG box art and photos, imageview's PNGs blended by alpha, and imageview's BMPs
+	const struct {
+		u32 flags;
+		u32 bytesPerPixel;
+		bool bottomUp;
+	} variants[] = {
+		{0, 4, false},
+		{COLORCONVERT_GRAYSCALE, 4, false},
+		{COLORCONVERT_ALPHA, 4, false},
+		{COLORCONVERT_ALPHA | COLORCONVERT_GRAYSCALE, 4, false},
+		{COLORCONVERT_SWAP_RB, 3, true},
+		{COLORCONVERT_SWAP_RB | COLORCONVERT_GRAYSCALE, 4, true},
+	};
+	for (const auto &variant : variants) {
+		for (int deband = 0; deband < 2; deband++) {
+			int mismatches = 0;
+			for (int i = 0; i < 400; i++) {
+				if (!matchesReference(variant.flags, variant.bytesPerPixel, deband, variant.bottomUp))
+					mismatches++;
+			}
+			if (mismatches)
+				printf("flags %lX, %lu bytes per pixel, deband %d: %d of 400 images differ\n", (unsigned long)variant.flags, (unsigned long)variant.bytesPerPixel, deband, mismatches);
+			CHECK(mismatches == 0);
+		}
+	}
+
+	if (benchRequested(argc, argv)) {
+		// A full screen box art with deband and grayscale, the heaviest case the menus have
+		const u32 width = 256, height = 192, rounds = 200;
+		const std::vector<u8> image = randomImage(width, height, 4);
+		std::vector<u16> frame(width * height), frame2(width * height);
+
+		double start = hostMillis();
+		for (u32 i = 0; i < rounds; i++)
+			referenceConvert(image, width, height, 4, COLORCONVERT_GRAYSCALE, true, frame.data(), frame2.data());
+		const double reference = hostMillis() - start;
+
+		start = hostMillis();
+		for (u32 i = 0; i < rounds; i++)
+			rgbaToBgr555(frame.data(), frame2.data(), width, image.data(), width, height, 4, COLORCONVERT_GRAYSCALE);
+		const double kernel = hostMillis() - start;
+
+		printf("rgbaToBgr555, 256x192 with deband and grayscale: old loop %.3fms, kernel %.3fms per image\n", reference / rounds, kernel / rounds);
+	}
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,273 @@
+// DirectoryModel against the vector of strings the file browsers used to list into
+
+#include "common/directoryModel.h"
+#include "hostTest.h"
+
+#include <algorithm>
+#include <stdlib.h>
+#include <string>
+#include <strings.h>
+#include <vector>
+
+// What a listing used to be made of
+struct OldDirEntry {
+	std::string name;
+	bool isDirectory;
+	int position;
+};
+
+// Names like a ROM folder's, in mixed case, some with no extension or a longer one
+static std::string randomRomName(int serial) {
+	static const char *const words[] = {"Super", "mario", "KART", "Pokemon", "Zelda", "Legend", "of", "the", "Castle", "Advance", "DS", "Racing", "Puzzle", "League", "world", "Tour"};
+	static const char *const regions[] = {" (USA)", " (Europe)", " (Japan)", " (En,Fr,De,Es,It)", "", " (Rev 1)"};
+	static const char *const extensions[] = {".nds", ".NDS", ".dsi", ".gba", ".argv", ".gb", ".sfc", "", ".nds.bak"};
+
+	std::string name;
+	if (rand() % 3 == 0) {
+		char number[16];
+		snprintf(number, sizeof(number), "%04d - ", rand() % 10000);
+		name += number;
+	}
+	const int wordCount = 1 + rand() % 4;
+	for (int i = 0; i < wordCount; i++) {
+		if (i > 0) name += ' ';
+		name += words[rand() % 16];
+	}
+	name += " " + std::to_string(serial);
+	name += regions[rand() % 6];
+	name += extensions[rand() % 9];
+	return name;
+}
+
+static bool sameListing(const DirectoryModel &model, const std::vector<OldDirEntry> &entries) {
+	if (model.size() != entries.size())
+		return false;
+	for (size_t i = 0; i < entries.size(); i++) {
+		if (entries[i].name != model.name(i) || entries[i].isDirectory != model.isDirectory(i))
+			return false;
+	}
+	return true;
+}
+
+static void testStorage(void) {
+	DirectoryModel model;
+	std::vector<OldDirEntry> entries;
+
+	// Enough names to fill many chunks, with some long enough to start a new one early
+	for (int i = 0; i < 10000; i++) {
+		std::string name = randomRomName(i);
+		if (i % 1000 == 0)
+			name = std::string(6000 + i, 'x') + name;
+		const bool isDirectory = (rand() % 10 == 0);
+		model.add(name.c_str(), isDirectory, i);
+		entries.push_back({name, isDirectory, i});
+	}
+	CHECK(sameListing(model, entries));
+
+	// The browsers insert, remove and move entries as files are copied, deleted and reordered
+	for (int i = 0; i < 2000; i++) {
+		const int op = rand() % 3;
+		if (op == 0) {
+			const size_t index = rand() % (entries.size() + 1);
+			const std::string name = randomRomName(10000 + i);
+			model.insert(index, name.c_str(), false, -1);
+			entries.insert(entries.begin() + index, {name, false, -1});
+		} else if (op == 1) {
+			const size_t index = rand() % entries.size();
+			model.erase(index);
+			entries.erase(entries.begin() + index);
+		} else {
+			const size_t from = rand() % entries.size(), to = rand() % entries.size();
+			model.move(from, to);
+			const OldDirEntry entry = entries[from];
+			entries.erase(entries.begin() + from);
+			entries.insert(entries.begin() + to, entry);
+		}
+	}
+	CHECK(sameListing(model, entries));
+
+	model.clear();
+	CHECK(model.size() == 0);
+	model.add("after clear.nds", false, 0);
+	CHECK(model.size() == 1 && strcmp(model.name(0), "after clear.nds") == 0);
+}
+
+static int sign(int value) {
+	return (value > 0) - (value < 0);
+}
+
+// Extensions the way the file type sort used to take them, the whole name if there's no '.'
+static std::string oldExtension(const std::string &name) {
+	return name.substr(name.find_last_of('.') + 1);
+}
+
+// The alphabetical and file type sorts' comparisons, before the collation keys
+static bool oldAlphabetical(const OldDirEntry &lhs, const OldDirEntry &rhs) {
+	if (lhs.isDirectory && !rhs.isDirectory)
+		return true;
+	if (!lhs.isDirectory && rhs.isDirectory)
+		return false;
+	return strcasecmp(lhs.name.c_str(), rhs.name.c_str()) < 0;
+}
+
+static bool oldFileType(const OldDirEntry &lhs, const OldDirEntry &rhs) {
+	if (!lhs.isDirectory && rhs.isDirectory)
+		return false;
+	else if (lhs.isDirectory && !rhs.isDirectory)
+		return true;
+
+	int extCmp = strcasecmp(oldExtension(lhs.name).c_str(), oldExtension(rhs.name).c_str());
+	if (extCmp == 0)
+		return strcasecmp(lhs.name.c_str(), rhs.name.c_str()) < 0;
+	else
+		return extCmp < 0;
+}
+
+struct SortPredicates {
+	const DirectoryModel &model;
+
+	bool alphabetical(const DirectoryModel::Entry &lhs, const DirectoryModel::Entry &rhs) const {
+		if (lhs.isDirectory && !rhs.isDirectory)
+			return true;
+		if (!lhs.isDirectory && rhs.isDirectory)
+			return false;
+		return model.compareNames(lhs, rhs) < 0;
+	}
+
+	bool fileType(const DirectoryModel::Entry &lhs, const DirectoryModel::Entry &rhs) const {
+		if (!lhs.isDirectory && rhs.isDirectory)
+			return false;
+		else if (lhs.isDirectory && !rhs.isDirectory)
+			return true;
+
+		int extCmp = model.compareExtensions(lhs, rhs);
+		if (extCmp == 0)
+			return model.compareNames(lhs, rhs) < 0;
+		else
+			return extCmp < 0;
+	}
+};
+
+static void testCollation(void) {
+	// Pairs that differ only in case, end inside the 4-character keys, or
+	// share them, plus bytes past ASCII
+	static const char *const names[] = {"", "a", "A", "ab", "aB.nds", "abc", "abcd", "ABCD", "abcde", "abcd.nds", "abcD.NDS",
+		"abce", "b.gba", "B.GBA", "game.nds", "game.ndsx", "game.argv", "Game 10.nds", "Game 2.nds", "no extension", "NO EXTENSION",
+		"x.", ".nds", "..", "zz[1].nds", "zz_1.nds", "zz~1.nds", "\xC3\xA9t\xC3\xA9.nds", "\xC3\x89T\xC3\x89.nds", "\xFF\xFE.nds", "name.tar.gz", "NAME.TAR.GZ"};
+	const size_t count = sizeof(names) / sizeof(names[0]);
+
+	DirectoryModel model;
+	for (size_t i = 0; i < count; i++)
+		model.add(names[i], false, i);
+	const DirectoryModel::Entry *entries = &*model.begin();
+	for (size_t i = 0; i < count; i++) {
+		for (size_t j = 0; j < count; j++) {
+			CHECK(sign(model.compareNames(entries[i], entries[j])) == sign(strcasecmp(names[i], names[j])));
+			CHECK(sign(model.compareExtensions(entries[i], entries[j])) == sign(strcasecmp(oldExtension(names[i]).c_str(), oldExtension(names[j]).c_str())));
+		}
+	}
+
+	// Whole listings sorted both ways. The names are all different, ignoring
+	// case, so both sorts have only one right order.
+	for (int listing = 0; listing < 10; listing++) {
+		model.clear();
+		std::vector<OldDirEntry> oldEntries;
+		for (int i = 0; i < 5000; i++) {
+			const std::string name = randomRomName(i);
+			const bool isDirectory = (rand() % 20 == 0);
+			model.add(name.c_str(), isDirectory, i);
+			oldEntries.push_back({name, isDirectory, i});
+		}
+
+		const SortPredicates predicates = {model};
+		std::vector<OldDirEntry> expected = oldEntries;
+		std::sort(expected.begin(), expected.end(), oldAlphabetical);
+		std::sort(model.begin(), model.end(), [&predicates](const DirectoryModel::Entry &lhs, const DirectoryModel::Entry &rhs) { return predicates.alphabetical(lhs, rhs); });
+		CHECK(sameListing(model, expected));
+
+		expected = oldEntries;
+		std::sort(expected.begin(), expected.end(), oldFileType);
+		std::sort(model.begin(), model.end(), [&predicates](const DirectoryModel::Entry &lhs, const DirectoryModel::Entry &rhs) { return predicates.fileType(lhs, rhs); });
+		CHECK(sameListing(model, expected));
+	}
+}
+
+// Sorting 5,000 names by the old comparisons and by the collation keys
+static void benchCollation(void) {
+	const int count = 5000, rounds = 50;
+	DirectoryModel model;
+	std::vector<OldDirEntry> oldEntries;
+	for (int i = 0; i < count; i++) {
+		const std::string name = randomRomName(i);
+		model.add(name.c_str(), false, i);
+		oldEntries.push_back({name, false, i});
+	}
+	const std::vector<DirectoryModel::Entry> entries(model.begin(), model.end());
+	const SortPredicates predicates = {model};
+
+	for (int fileType = 0; fileType < 2; fileType++) {
+		double start = hostMillis();
+		for (int round = 0; round < rounds; round++) {
+			std::vector<OldDirEntry> sorted = oldEntries;
+			std::sort(sorted.begin(), sorted.end(), fileType ? oldFileType : oldAlphabetical);
+		}
+		const double old = (hostMillis() - start) / rounds;
+
+		start = hostMillis();
+		for (int round = 0; round < rounds; round++) {
+			std::copy(entries.begin(), entries.end(), model.begin());
+			std::sort(model.begin(), model.end(), [&predicates, fileType](const DirectoryModel::Entry &lhs, const DirectoryModel::Entry &rhs) {
+				return fileType ? predicates.fileType(lhs, rhs) : predicates.alphabetical(lhs, rhs);
+			});
+		}
+		const double current = (hostMillis() - start) / rounds;
+
+		printf("Collation keys, %d names by %s: old comparisons %.2fms, keys %.2fms per sort\n", count, fileType ? "file type" : "name", old, current);
+	}
+}
+
+// Listing and sorting 10,000 entries each way
+static void benchListing(void) {
+	const int count = 10000, rounds = 20;
+	std::vector<std::string> names;
+	for (int i = 0; i < count; i++)
+		names.push_back(randomRomName(i));
+
+	double start = hostMillis();
+	for (int round = 0; round < rounds; round++) {
+		std::vector<OldDirEntry> entries;
+		for (int i = 0; i < count; i++)
+			entries.push_back({names[i], false, i});
+		std::sort(entries.begin(), entries.end(), [](const OldDirEntry &lhs, const OldDirEntry &rhs) { return strcasecmp(lhs.name.c_str(), rhs.name.c_str()) < 0; });
+	}
+	const double old = (hostMillis() - start) / rounds;
+
+	DirectoryModel model;
+	start = hostMillis();
+	for (int round = 0; round < rounds; round++) {
+		model.clear();
+		for (int i = 0; i < count; i++)
+			model.add(names[i].c_str(), false, i);
+		std::sort(model.begin(), model.end(), [&model](const DirectoryModel::Entry &lhs, const DirectoryModel::Entry &rhs) { return model.compareNames(lhs, rhs) < 0; });
+	}
+	const double current = (hostMillis() - start) / rounds;
+
+	size_t nameBytes = 0;
+	for (const std::string &name : names)
+		nameBytes += name.size() + 1;
+	printf("DirectoryModel, %d entries: vector of strings %.2fms, model %.2fms to list and sort; %d-byte entries plus %luKB of names\n",
+		count, old, current, (int)sizeof(DirectoryModel::Entry), (unsigned long)(nameBytes / 1024));
+}
+
+int main(int argc, char **argv) {
+	srand(1);
+	testStorage();
+	testCollation();
+
+	if (benchRequested(argc, argv)) {
+		benchListing();
+		benchCollation();
+	}
+
+	return TEST_RESULT();
+}
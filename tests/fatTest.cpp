@@ -0,0 +1,272 @@
+// The bootloaders' FAT driver on generated FAT12, FAT16 and FAT32 images, counting card reads
+
+extern "C" {
+#include "fat.h"
+}
+#include "card.h"
+#include "hostTest.h"
+
+#include <algorithm>
+#include <stdlib.h>
+#include <vector>
+
+// An image in memory, with one fragmented file to boot, BOOT.NDS
+struct FatImage {
+	std::vector<u8> data;
+	int bits;
+	u32 partitionStart;
+	u32 fatStart;
+	u32 sectorsPerFat;
+	u32 dataStart;
+	u32 sectorsPerCluster;
+	u32 nextFree;	// Clusters are handed out from here up
+
+	u8 *sector(u32 sector) { return &data[sector * BYTES_PER_SECTOR]; }
+	u8 *cluster(u32 cluster) { return sector(dataStart + (cluster - 2) * sectorsPerCluster); }
+	u32 clusterSize(void) const { return sectorsPerCluster * BYTES_PER_SECTOR; }
+
+	void setFat(u32 cluster, u32 value) {
+		for (int copy = 0; copy < 2; copy++) {
+			u8 *fat = sector(fatStart + copy * sectorsPerFat);
+			if (bits == 12) {
+				u8 *entry = fat + cluster * 3 / 2;
+				if (cluster & 1) {
+					entry[0] = (entry[0] & 0x0F) | (value << 4);
+					entry[1] = value >> 4;
+				} else {
+					entry[0] = value;
+					entry[1] = (entry[1] & 0xF0) | ((value >> 8) & 0x0F);
+				}
+			} else if (bits == 16) {
+				fat[cluster * 2] = value;
+				fat[cluster * 2 + 1] = value >> 8;
+			} else {
+				for (int i = 0; i < 4; i++)
+					fat[cluster * 4 + i] = value >> (i * 8);
+			}
+		}
+	}
+
+	u32 endOfChain(void) const { return (bits == 12) ? 0xFFF : (bits == 16) ? 0xFFFF : 0x0FFFFFFF; }
+
+	// A chain of clusters in runs of random length, with gaps between them
+	// and some runs placed after the ones that follow them
+	std::vector<u32> allocate(u32 count) {
+		std::vector<std::vector<u32>> runs;
+		while (count > 0) {
+			nextFree += rand() % 3;
+			const u32 length = std::min(count, 1 + (u32)rand() % 24);
+			std::vector<u32> run;
+			for (u32 i = 0; i < length; i++)
+				run.push_back(nextFree++);
+			runs.push_back(run);
+			count -= length;
+		}
+		for (size_t i = 0; i + 1 < runs.size(); i++) {
+			if (rand() % 5 == 0)
+				std::swap(runs[i], runs[i + 1]);
+		}
+
+		std::vector<u32> chain;
+		for (const std::vector<u32> &run : runs)
+			chain.insert(chain.end(), run.begin(), run.end());
+		for (size_t i = 0; i < chain.size(); i++)
+			setFat(chain[i], (i + 1 < chain.size()) ? chain[i + 1] : endOfChain());
+		return chain;
+	}
+};
+
+static void put16(u8 *p, u32 value) { p[0] = value; p[1] = value >> 8; }
+static void put32(u8 *p, u32 value) { put16(p, value); put16(p + 2, value >> 16); }
+
+static void putDirEntry(u8 *entry, const char *name, u8 attrib, u32 cluster, u32 size) {
+	memcpy(entry, name, 11);
+	entry[11] = attrib;
+	put16(entry + 20, cluster >> 16);
+	put16(entry + 26, cluster);
+	put32(entry + 28, size);
+}
+
+/**
+ * Build an image holding BOOT.NDS after a few other directory entries.
+ * FAT32's root directory spans several clusters, so the driver has to
+ * follow its chain to find the file.
+ */
+static FatImage makeImage(int bits, u32 sectorsPerCluster, u32 clusterCount, bool mbr, const std::vector<u8> &file, u32 &fileCluster) {
+	FatImage image;
+	image.bits = bits;
+	image.sectorsPerCluster = sectorsPerCluster;
+	image.partitionStart = mbr ? 63 : 0;
+
+	const u32 reservedSectors = (bits == 32) ? 32 : 1;
+	const u32 rootEntries = (bits == 32) ? 0 : 512;
+	image.sectorsPerFat = ((clusterCount + 2) * bits / 8 + BYTES_PER_SECTOR) / BYTES_PER_SECTOR;
+	image.fatStart = image.partitionStart + reservedSectors;
+	const u32 rootDirStart = image.fatStart + 2 * image.sectorsPerFat;
+	image.dataStart = rootDirStart + rootEntries * 32 / BYTES_PER_SECTOR;
+	const u32 numSectors = image.dataStart - image.partitionStart + clusterCount * sectorsPerCluster;
+	image.data.assign((image.partitionStart + numSectors) * BYTES_PER_SECTOR, 0);
+	image.nextFree = 2;
+
+	if (mbr) {
+		u8 *partition = image.sector(0) + 0x1BE;
+		partition[0] = 0x80;
+		partition[4] = (bits == 32) ? 0x0C : 0x06;
+		put32(partition + 8, image.partitionStart);
+		put32(partition + 12, numSectors);
+		put16(image.sector(0) + 0x1FE, 0xAA55);
+	}
+
+	u8 *boot = image.sector(image.partitionStart);
+	boot[0] = 0xEB;
+	put16(boot + 0x0B, BYTES_PER_SECTOR);
+	boot[0x0D] = sectorsPerCluster;
+	put16(boot + 0x0E, reservedSectors);
+	boot[0x10] = 2;
+	put16(boot + 0x11, rootEntries);
+	if (numSectors < 0x10000)
+		put16(boot + 0x13, numSectors);
+	else
+		put32(boot + 0x20, numSectors);
+	boot[0x15] = 0xF8;
+	if (bits == 32) {
+		put32(boot + 0x24, image.sectorsPerFat);
+		put32(boot + 0x2C, 2);
+		memcpy(boot + 0x52, "FAT32   ", 8);
+	} else {
+		put16(boot + 0x16, image.sectorsPerFat);
+		memcpy(boot + 0x36, (bits == 12) ? "FAT12   " : "FAT16   ", 8);
+	}
+	put16(boot + 0x1FE, 0xAA55);
+	image.setFat(0, 0x0FFFFFF8 & image.endOfChain());
+	image.setFat(1, image.endOfChain());
+
+	// Where the root directory's entries go
+	std::vector<u8 *> rootSectors;
+	if (bits == 32) {
+		// The driver takes the root directory to start at cluster 2, as formatting leaves it
+		std::vector<u32> rootChain = {image.nextFree++};
+		const std::vector<u32> rest = image.allocate(2);
+		image.setFat(rootChain[0], rest[0]);
+		rootChain.insert(rootChain.end(), rest.begin(), rest.end());
+		for (u32 cluster : rootChain) {
+			for (u32 i = 0; i < sectorsPerCluster; i++)
+				rootSectors.push_back(image.cluster(cluster) + i * BYTES_PER_SECTOR);
+		}
+	} else {
+		for (u32 i = 0; i < rootEntries * 32 / BYTES_PER_SECTOR; i++)
+			rootSectors.push_back(image.sector(rootDirStart + i));
+	}
+	const u32 entriesPerSector = BYTES_PER_SECTOR / 32;
+	u32 entryCount = 0;
+	auto nextEntry = [&]() { const u32 i = entryCount++; return rootSectors[i / entriesPerSector] + (i % entriesPerSector) * 32; };
+
+	putDirEntry(nextEntry(), "TESTVOLUME ", 0x08, 0, 0);
+	putDirEntry(nextEntry(), "BOOT    NDS", 0x10, 0, 0);	// A directory with the file's name
+	putDirEntry(nextEntry(), "BOOT    ND ", 0x20, 0, 0);
+	putDirEntry(nextEntry(), "\xE5OOT    NDS", 0x20, 0, 0);
+	const u32 fillers = (bits == 32) ? entriesPerSector * sectorsPerCluster * 2 : 40;
+	for (u32 i = 0; i < fillers; i++) {
+		char name[16];
+		snprintf(name, sizeof(name), "FILE%04uBIN", (unsigned)(i % 10000));
+		putDirEntry(nextEntry(), name, 0x20, 0, 0);
+	}
+
+	const std::vector<u32> chain = image.allocate((file.size() + image.clusterSize() - 1) / image.clusterSize());
+	for (size_t i = 0; i < chain.size(); i++) {
+		const size_t offset = i * image.clusterSize();
+		memcpy(image.cluster(chain[i]), &file[offset], std::min((size_t)image.clusterSize(), file.size() - offset));
+	}
+	fileCluster = chain[0];
+	putDirEntry(nextEntry(), "BOOT    NDS", 0x20, fileCluster, file.size());
+	return image;
+}
+
+static FatImage *card;
+static u32 cardCommands;
+static u32 cardSectors;
+
+extern "C" bool CARD_StartUp (void) { return card != NULL; }
+extern "C" bool CARD_IsInserted (void) { return card != NULL; }
+
+extern "C" bool CARD_ReadSectors (u32 sector, int count, void *buffer) {
+	cardCommands++;
+	cardSectors += count;
+	if (count <= 0 || (sector + count) * BYTES_PER_SECTOR > card->data.size())
+		return false;
+	memcpy(buffer, card->sector(sector), count * BYTES_PER_SECTOR);
+	return true;
+}
+
+extern "C" bool CARD_ReadSector (u32 sector, void *buffer) {
+	return CARD_ReadSectors(sector, 1, buffer);
+}
+
+static bool readMatches(u32 cluster, const std::vector<u8> &file, u32 offset, u32 length) {
+	std::vector<u8> buffer(length + 1, 0xA5);
+	if (fileRead((char *)buffer.data(), cluster, offset, length) != length)
+		return false;
+	return memcmp(buffer.data(), &file[offset], length) == 0 && buffer[length] == 0xA5;
+}
+
+int main(int argc, char **argv) {
+	srand(1);
+
+	const struct {
+		const char *name;
+		int bits;
+		u32 sectorsPerCluster;
+		u32 clusterCount;
+		bool mbr;
+		u32 fileSize;
+	} layouts[] = {
+		{"FAT12", 12, 1, 4000, false, 1200 * 1024 + 77},
+		{"FAT16", 16, 2, 8000, false, 3 * 1024 * 1024 + 300},
+		{"FAT32", 32, 1, 70000, true, 3 * 1024 * 1024 + 4000},
+	};
+
+	for (const auto &layout : layouts) {
+		std::vector<u8> file(layout.fileSize);
+		for (u8 &byte : file)
+			byte = rand();
+
+		u32 fileCluster;
+		FatImage image = makeImage(layout.bits, layout.sectorsPerCluster, layout.clusterCount, layout.mbr, file, fileCluster);
+		card = &image;
+
+		CHECK(FAT_InitFiles(true));
+		CHECK(getBootFileCluster("BOOT.NDS") == fileCluster);
+		CHECK(getBootFileCluster("MISSING.NDS") == CLUSTER_FREE);
+
+		// The way the bootloaders load a ROM: the header, then the ARM9 and ARM7 binaries
+		const u32 arm9Offset = 0x4000;
+		const u32 arm9Size = layout.fileSize * 2 / 3 + 123;
+		const u32 arm7Offset = (arm9Offset + arm9Size + 0x1FF) & ~0x1FF;
+		const u32 arm7Size = layout.fileSize - arm7Offset - 1000;
+		cardCommands = 0;
+		cardSectors = 0;
+		CHECK(readMatches(fileCluster, file, 0, 0x170));
+		CHECK(readMatches(fileCluster, file, arm9Offset, arm9Size));
+		CHECK(readMatches(fileCluster, file, arm7Offset, arm7Size));
+		const u32 bootCommands = cardCommands, bootSectors = cardSectors;
+
+		// Anywhere in the file, forwards from the last read, backwards, and up to the end
+		int mismatches = 0;
+		for (int i = 0; i < 2000; i++) {
+			const u32 offset = rand() % layout.fileSize;
+			const u32 length = (rand() % 4 == 0) ? layout.fileSize - offset : rand() % std::min(layout.fileSize - offset, 40000u);
+			if (!readMatches(fileCluster, file, offset, length))
+				mismatches++;
+		}
+		if (mismatches)
+			printf("%s: %d of 2000 reads differ\n", layout.name, mismatches);
+		CHECK(mismatches == 0);
+
+		if (benchRequested(argc, argv)) {
+			printf("%s, fragmented %lu KB file: boot-like load took %lu card commands for %lu sectors\n",
+				layout.name, (unsigned long)(layout.fileSize / 1024), (unsigned long)bootCommands, (unsigned long)bootSectors);
+		}
+	}
+
+	return TEST_RESULT();
+}
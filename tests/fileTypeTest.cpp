@@ -0,0 +1,246 @@
+// fileTypeOf() and FileExtensionSet against the extension chains and
+// nameEndsWith() they replaced, for every extension in any case
+
+#include "common/fileType.h"
+#include "hostTest.h"
+
+#include <ctype.h>
+#include <string>
+#include <string_view>
+#include <strings.h>
+#include <vector>
+
+// The old extension(). Its substr() threw for a name shorter than the
+// extension, and the quick menu's read before the name, so here those names
+// never match.
+static bool extension(const std::string_view filename, const std::vector<std::string_view> extensions) {
+	for (std::string_view extension : extensions) {
+		if (filename.size() >= extension.size() && strcasecmp(filename.substr(filename.size() - extension.size()).data(), extension.data()) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// The dsimenu theme's chain. The R4 theme's and the quick menu's gave the same types.
+static FileType oldFileTypeOf(const std::string_view filename) {
+	if (extension(filename, {".nds", ".dsi", ".ids", ".srl", ".app", ".argv"})) {
+		return {0, 0};
+	} else if (extension(filename, {".xex", ".atr", ".a26", ".a52", ".a78"})) {
+		return {10, 0};
+	} else if (extension(filename, {".col"})) {
+		return {13, 0};
+	} else if (extension(filename, {".m5"})) {
+		return {14, 0};
+	} else if (extension(filename, {".int"})) {
+		return {12, 0};
+	} else if (extension(filename, {".plg"})) {
+		return {9, 0};
+	} else if (extension(filename, {".avi", ".rvid", ".fv"})) {
+		return {19, 2};
+	} else if (extension(filename, {".gif", ".bmp", ".png"})) {
+		return {20, -1};
+	} else if (extension(filename, {".agb", ".gba", ".mb"})) {
+		return {1, 1};
+	} else if (extension(filename, {".gb", ".sgb"})) {
+		return {2, 1};
+	} else if (extension(filename, {".gbc"})) {
+		return {3, 1};
+	} else if (extension(filename, {".nes"})) {
+		return {4, 2};
+	} else if (extension(filename, {".fds"})) {
+		return {4, 1};
+	} else if (extension(filename, {".sg"})) {
+		return {15, 2};
+	} else if (extension(filename, {".sms"})) {
+		return {5, 2};
+	} else if (extension(filename, {".gg"})) {
+		return {6, 2};
+	} else if (extension(filename, {".gen"})) {
+		return {7, 2};
+	} else if (extension(filename, {".smc"})) {
+		return {8, 3};
+	} else if (extension(filename, {".sfc"})) {
+		return {8, 2};
+	} else if (extension(filename, {".pce"})) {
+		return {11, 0};
+	} else if (extension(filename, {".ws", ".wsc"})) {
+		return {16, 0};
+	} else if (extension(filename, {".ngp", ".ngc"})) {
+		return {17, 0};
+	} else if (extension(filename, {".dsk"})) {
+		return {18, 0};
+	}
+	return {9, -1};
+}
+
+// The old nameEndsWith(), the same in both browsers
+static bool oldNameEndsWith(const std::string_view name, const std::vector<std::string_view> extensionList) {
+	if (name.size() == 0)
+		return false;
+
+	if (extensionList.size() == 0)
+		return true;
+
+	if (name.substr(0, 2) == "._")
+		return false; // Don't show macOS's index files
+
+	for (const std::string_view &ext : extensionList) {
+		if (name.length() > ext.length() && strcasecmp(name.substr(name.length() - ext.length()).data(), ext.data()) == 0)
+			return true;
+	}
+	return false;
+}
+
+// The browsers' nameEndsWith() now
+static bool nameEndsWith(const char *name, const FileExtensionSet &extensions) {
+	if (name[0] == '\0')
+		return false;
+
+	if (extensions.empty())
+		return true;
+
+	if (strncmp(name, "._", 2) == 0)
+		return false; // Don't show macOS's index files
+
+	return extensions.matches(name);
+}
+
+// The dsimenu theme's list, with the DSTWO's plugins
+static const std::vector<std::string_view> browserExtensions = {
+	".nds", ".dsi", ".ids", ".srl", ".app", ".argv", ".agb", ".gba", ".mb", ".a26", ".a52", ".a78", ".xex", ".atr",
+	".col", ".int", ".m5", ".gb", ".sgb", ".gbc", ".nes", ".fds", ".sg", ".sms", ".gg", ".gen", ".smc", ".sfc",
+	".ws", ".wsc", ".ngp", ".ngc", ".pce", ".dsk", ".avi", ".rvid", ".fv", ".gif", ".bmp", ".png", ".plg",
+};
+
+// Lists as other callers pass: one, longer extensions, more than one dot, and none
+static const std::vector<std::vector<std::string_view>> extensionLists = {
+	browserExtensions,
+	{".nds"},
+	{".gba", ".abcde", ".nds.bak", "nds", ".rvidx"},
+	{},
+};
+
+static int mismatches(const std::string &name) {
+	int failed = 0;
+	const FileType &type = fileTypeOf(name.c_str());
+	const FileType oldType = oldFileTypeOf(name);
+	if (type.romType != oldType.romType || type.boxArtType != oldType.boxArtType)
+		failed++;
+
+	for (const std::vector<std::string_view> &list : extensionLists) {
+		if (nameEndsWith(name.c_str(), FileExtensionSet(list)) != oldNameEndsWith(name, list))
+			failed++;
+	}
+	return failed;
+}
+
+// Every case of each letter of the extension
+static std::vector<std::string> casesOf(std::string_view extension) {
+	std::vector<std::string> cases;
+	for (u32 mask = 0; mask < (1u << extension.size()); mask++) {
+		std::string name(extension);
+		for (size_t i = 0; i < name.size(); i++) {
+			if (mask & (1 << i))
+				name[i] = toupper(name[i]);
+		}
+		cases.push_back(name);
+	}
+	return cases;
+}
+
+// Each listed extension in every case, after a name, after another extension, alone and on a macOS index file
+static void testListedExtensions(void) {
+	int failed = 0;
+	int checked = 0;
+	for (const std::string_view &extension : browserExtensions) {
+		for (const std::string &ext : casesOf(extension)) {
+			for (const char *stem : {"Game", "Game.zip", "a", "", "._Game", "._"}) {
+				failed += mismatches(stem + ext);
+				checked++;
+			}
+		}
+	}
+	CHECK(failed == 0);
+	CHECK(checked > 1000);
+
+	// Which the table has, not only agrees with the old chain on
+	CHECK(fileTypeOf("Game.NdS").romType == 0 && fileTypeOf("Game.RVID").boxArtType == 2);
+	CHECK(fileTypeOf("Game.Smc").boxArtType == 3 && fileTypeOf("Game.sfc").boxArtType == 2);
+}
+
+/**
+ * Names whose type is unknown, or that only look like they have an extension:
+ * more than 4 characters after the dot, starting with one that's listed or
+ * not, and dot-only names.
+ */
+static void testOtherNames(void) {
+	static const char *const names[] = {
+		"Game.txt", "Game.nds.bak", "Game.ndsx", "Game.xnds", "Gamends", "nds", "Game.", "Game..", ".", "..", "",
+		"Game.abcde", "Game.rvidx", "Game.argva", "Game.RVIDr", "Game.ABCDE", ".abcde", ".argvA", "x.nds.bak", ".nds.bak", "._", "._.nds",
+		"._nds", "Game.g", "Game.b", "G.gb", ".gb", "gb", "Game.a2", "Game.\xE9nds", "Game.nd\xC3\xA9",
+	};
+	int failed = 0;
+	for (const char *name : names)
+		failed += mismatches(name);
+	CHECK(failed == 0);
+
+	CHECK(fileTypeOf("Game.abcde").romType == 9 && fileTypeOf("Game.abcde").boxArtType == -1);
+	CHECK(!nameEndsWith("._Game.nds", FileExtensionSet(browserExtensions)));
+	CHECK(!nameEndsWith(".nds", FileExtensionSet(browserExtensions)));
+}
+
+// Names made of the letters of the extensions, dots and underscores
+static void testRandomNames(void) {
+	static const char letters[] = "._.nNdDsSgGbBaAvViIrRpPlLmM5026x";
+	u32 seed = 1;
+	int failed = 0;
+	for (int i = 0; i < 100000; i++) {
+		seed = seed * 1103515245 + 12345;
+		std::string name((seed >> 8) % 9, ' ');
+		for (char &c : name) {
+			seed = seed * 1103515245 + 12345;
+			c = letters[(seed >> 8) % (sizeof(letters) - 1)];
+		}
+		failed += mismatches(name);
+	}
+	CHECK(failed == 0);
+}
+
+// A listing's worth of names, matched and typed the old way and the new
+static void benchListing(void) {
+	std::vector<std::string> names;
+	for (int i = 0; i < 2000; i++)
+		names.push_back("Game " + std::to_string(i) + std::string(browserExtensions[i % browserExtensions.size()]));
+
+	int matched = 0;
+	double start = hostMillis();
+	for (int run = 0; run < 50; run++) {
+		for (const std::string &name : names) {
+			matched += oldNameEndsWith(name, browserExtensions);
+			matched += oldFileTypeOf(name).romType;
+		}
+	}
+	const double oldTime = hostMillis() - start;
+
+	start = hostMillis();
+	for (int run = 0; run < 50; run++) {
+		const FileExtensionSet extensions(browserExtensions);
+		for (const std::string &name : names) {
+			matched += nameEndsWith(name.c_str(), extensions);
+			matched += fileTypeOf(name.c_str()).romType;
+		}
+	}
+	const double newTime = hostMillis() - start;
+	printf("fileType: %zu names, old %.0fus, table %.0fus per listing (%d)\n", names.size(), oldTime * 1000 / 50, newTime * 1000 / 50, matched);
+}
+
+int main(int argc, char **argv) {
+	testListedExtensions();
+	testOtherNames();
+	testRandomNames();
+	if (benchRequested(argc, argv))
+		benchListing();
+	return TEST_RESULT();
+}
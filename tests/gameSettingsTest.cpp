@@ -0,0 +1,199 @@
+// gamesettings.db: migration from the .ini files, saves as the table grows,
+// and a page's lookups at once against looking up each game
+
+#include "gamesettings/gameSettingsDb.h"
+#include "hostTest.h"
+
+#include <map>
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+static u32 seed = 1;
+
+static u32 nextRandom(u32 range) {
+	seed = seed * 1103515245 + 12345;
+	return (seed >> 8) % range;
+}
+
+static std::string romName(int i) {
+	return "Game " + std::to_string(i) + ".nds";
+}
+
+static void writeFile(const std::string &path, const std::string &text) {
+	FILE *file = fopen(path.c_str(), "wb");
+	fwrite(text.data(), 1, text.size(), file);
+	fclose(file);
+}
+
+typedef std::map<std::string, std::map<int, int>> Expected;
+
+// Whether a game reads as expected, with every setting not saved read as its default
+static bool matches(const GameSettings &settings, const std::map<int, int> &expected) {
+	for (int key = 0; key < GAMESETTINGS_KEYS; key++) {
+		const auto value = expected.find(key);
+		if (settings.GetInt((GameSettingsKey)key, -99) != (value == expected.end() ? -99 : value->second))
+			return false;
+	}
+	return true;
+}
+
+static int mismatches(const Expected &expected) {
+	int failed = 0;
+	for (const auto &game : expected) {
+		if (!matches(GameSettings("sd:", game.first), game.second))
+			failed++;
+	}
+	return failed;
+}
+
+// The .ini files, including game cards' in slot1, hex values and a key written twice, are copied in once
+static void testMigration(Expected &expected) {
+	mkdir("sd:/_nds/TWiLightMenu/gamesettings", 0777);
+	mkdir("sd:/_nds/TWiLightMenu/gamesettings/slot1", 0777);
+	writeFile("sd:/_nds/TWiLightMenu/gamesettings/Game 1.nds.ini",
+		"[GAMESETTINGS]\nLANGUAGE = 2\nDSI_MODE = 1\nLANGUAGE = 5\nBOOST_CPU=0x1\n[OTHER]\nREGION = 1\n");
+	writeFile("sd:/_nds/TWiLightMenu/gamesettings/Game 2.nds.ini", "[GAMESETTINGS]\nNO_SHOW_RAM_LIMIT = 1\nSAVE_NUMBER = 300\n");
+	writeFile("sd:/_nds/TWiLightMenu/gamesettings/slot1/ABCD.ini", "[GAMESETTINGS]\nREGION = -1\n");
+	expected[romName(1)] = {{GAMESETTINGS_LANGUAGE, 2}, {GAMESETTINGS_DSI_MODE, 1}, {GAMESETTINGS_BOOST_CPU, 1}};
+	expected[romName(2)] = {{GAMESETTINGS_NO_SHOW_RAM_LIMIT_MSG, 1}, {GAMESETTINGS_SAVE_NUMBER, 127}};
+	expected["slot1/ABCD"] = {{GAMESETTINGS_REGION, -1}};
+	expected[romName(3)] = {};
+	CHECK(mismatches(expected) == 0);
+
+	// Not read again once copied, and names are found ignoring case, as FAT opens them
+	writeFile("sd:/_nds/TWiLightMenu/gamesettings/Game 1.nds.ini", "[GAMESETTINGS]\nLANGUAGE = 3\n");
+	CHECK(matches(GameSettings("sd:", "GAME 1.NDS"), expected[romName(1)]));
+}
+
+// Enough saves across enough games for the table to grow twice
+static void testSaves(Expected &expected) {
+	for (int i = 0; i < 6000; i++) {
+		const std::string name = romName(nextRandom(3000));
+		const int key = nextRandom(GAMESETTINGS_KEYS);
+		const int value = (int)nextRandom(7) - 3;
+		GameSettings settings("sd:", name, 0x45454141 + i);
+		settings.SetInt((GameSettingsKey)key, value);
+		CHECK(settings.Save());
+		expected[name][key] = value;
+	}
+	CHECK(mismatches(expected) == 0);
+}
+
+/**
+ * A page looked up at once gives what each game looked up alone does, with
+ * games that have no settings among them, and past GAMESETTINGS_BATCH_MAX
+ * nothing's looked up.
+ */
+static void testBatch(const Expected &expected) {
+	int failed = 0;
+	for (int page = 0; page < 100; page++) {
+		std::vector<std::string> names;
+		for (int i = 0; i < GAMESETTINGS_BATCH_MAX + 2; i++)
+			names.push_back(romName(nextRandom(4000)));
+		std::vector<const char *> nameList;
+		for (const std::string &name : names)
+			nameList.push_back(name.c_str());
+
+		std::vector<GameSettingsRecord> records(names.size());
+		bool found[GAMESETTINGS_BATCH_MAX + 2];
+		memset(found, 0, sizeof(found));
+		records[GAMESETTINGS_BATCH_MAX].nameHash2 = 0x5A5A5A5A;
+		gameSettingsFindBatch("sd:", nameList.data(), names.size(), records.data(), found);
+		if (records[GAMESETTINGS_BATCH_MAX].nameHash2 != 0x5A5A5A5A || found[GAMESETTINGS_BATCH_MAX])
+			failed++;
+
+		for (int i = 0; i < GAMESETTINGS_BATCH_MAX; i++) {
+			const auto game = expected.find(names[i]);
+			const bool saved = (game != expected.end() && !game->second.empty());
+			if (found[i] != saved || !matches(GameSettings("sd:", names[i], 0, &records[i]), saved ? game->second : std::map<int, int>()))
+				failed++;
+		}
+	}
+	CHECK(failed == 0);
+}
+
+// A page's record is used in place of reading the table, is kept up to date by a save, and is only used for its own name
+static void testPageRecord(void) {
+	const char *names[] = {"Page 1.nds", "Page 2.nds"};
+	GameSettingsRecord records[2];
+	bool found[2];
+	gameSettingsFindBatch("sd:", names, 2, records, found);
+	CHECK(!found[0] && !found[1]);
+
+	// Saved without the page's record, so the page's is now behind
+	GameSettings other("sd:", names[0]);
+	other.SetInt(GAMESETTINGS_REGION, 2);
+	CHECK(other.Save());
+	CHECK(GameSettings("sd:", names[0], 0, &records[0]).GetInt(GAMESETTINGS_REGION, -99) == -99);
+	CHECK(GameSettings("sd:", names[0], 0, &records[1]).GetInt(GAMESETTINGS_REGION, -99) == 2);
+
+	GameSettings settings("sd:", names[1], 0, &records[1]);
+	settings.SetInt(GAMESETTINGS_LANGUAGE, 4);
+	CHECK(settings.Save());
+	CHECK(GameSettings("sd:", names[1], 0, &records[1]).GetInt(GAMESETTINGS_LANGUAGE, -99) == 4);
+	CHECK(GameSettings("sd:", names[1]).GetInt(GAMESETTINGS_LANGUAGE, -99) == 4);
+
+	// A record for no name, as a page's folders have, is never used
+	GameSettingsRecord none;
+	memset(&none, 0, sizeof(none));
+	CHECK(GameSettings("sd:", names[1], 0, &none).GetInt(GAMESETTINGS_LANGUAGE, -99) == 4);
+}
+
+// A torn record reads as none, and a table that isn't one is made again from the .ini files
+static void testDamaged(void) {
+	FILE *file = fopen("sd:/_nds/TWiLightMenu/gamesettings.db", "r+b");
+	CHECK(file != NULL);
+	if (!file)
+		return;
+	fseek(file, 0, SEEK_END);
+	const long size = ftell(file);
+	std::vector<u8> table(size);
+	fseek(file, 0, SEEK_SET);
+	fread(table.data(), 1, size, file);
+
+	// Game 2's record, with a setting changed and its check not
+	const GameSettingsRecord *records = (const GameSettingsRecord *)(table.data() + 0x200);
+	GameSettingsRecord key;
+	const char *name = "Game 2.nds";
+	bool found;
+	gameSettingsFindBatch("sd:", &name, 1, &key, &found);
+	long offset = -1;
+	for (long i = 0; i < (size - 0x200) / (long)sizeof(GameSettingsRecord); i++) {
+		if (records[i].nameHash == key.nameHash && records[i].nameHash2 == key.nameHash2)
+			offset = 0x200 + i * sizeof(GameSettingsRecord);
+	}
+	CHECK(offset > 0);
+	if (offset > 0) {
+		fseek(file, offset + offsetof(GameSettingsRecord, value), SEEK_SET);
+		fputc(42, file);
+	}
+	fclose(file);
+	CHECK(matches(GameSettings("sd:", name), {}));
+
+	// What's been saved since is lost, but not what was in the .ini files
+	writeFile("sd:/_nds/TWiLightMenu/gamesettings.db", "not a table");
+	Expected migrated;
+	migrated[romName(1)] = {{GAMESETTINGS_LANGUAGE, 3}};
+	migrated[romName(2)] = {{GAMESETTINGS_NO_SHOW_RAM_LIMIT_MSG, 1}, {GAMESETTINGS_SAVE_NUMBER, 127}};
+	migrated["slot1/ABCD"] = {{GAMESETTINGS_REGION, -1}};
+	migrated["Page 1.nds"] = {};
+	CHECK(mismatches(migrated) == 0);
+}
+
+int main(int argc, char **argv) {
+	mkdir("sd:", 0777);
+	mkdir("sd:/_nds", 0777);
+	mkdir("sd:/_nds/TWiLightMenu", 0777);
+	// Start from no table, nor .ini files
+	system("rm -rf sd:/_nds/TWiLightMenu/gamesettings sd:/_nds/TWiLightMenu/gamesettings.db*");
+
+	Expected expected;
+	testMigration(expected);
+	testSaves(expected);
+	testBatch(expected);
+	testPageRecord();
+	testDamaged();
+	return TEST_RESULT();
+}
@@ -0,0 +1,38 @@
+#pragma once
+#ifndef _HOST_TEST_H_
+#define _HOST_TEST_H_
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * Checks for the host tests. A failed CHECK is printed and counted, and
+ * TEST_RESULT() returns non-zero from main() if any failed.
+ */
+
+static int testFailures = 0;
+
+#define CHECK(cond) \
+	do { \
+		if (!(cond)) { \
+			printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+			testFailures++; \
+		} \
+	} while (0)
+
+#define TEST_RESULT() (testFailures == 0 ? 0 : (printf("%d check(s) failed\n", testFailures), 1))
+
+/** Whether the benchmarks were asked for, by "make bench" */
+static inline bool benchRequested(int argc, char **argv)
+{
+	return argc > 1 && strcmp(argv[1], "bench") == 0;
+}
+
+/** Milliseconds since some fixed point, for timing the benchmarks */
+static inline double hostMillis(void)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif // _HOST_TEST_H_
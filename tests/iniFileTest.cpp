@@ -0,0 +1,416 @@
+// CIniFile against the per-line reader and writer it replaced, and the settings.ini load benchmark
+
+#include "common/inifile.h"
+#include "hostTest.h"
+
+#include <set>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+// The old CIniFile's reading, lookups, inserts and writing, which rescanned the lines each time
+class OldIniFile {
+public:
+	std::vector<std::string> lines;
+	bool lastResult = false;
+
+	static bool freadLine(FILE *f, std::string &str) {
+		str.clear();
+	__read:
+		char p = 0;
+
+		size_t readed = fread(&p, 1, 1, f);
+		if (0 == readed) {
+			str = "";
+			return false;
+		}
+		if ('\n' == p || '\r' == p) {
+			str = "";
+			return true;
+		}
+
+		while (p != '\n' && p != '\r' && readed) {
+			str += p;
+			readed = fread(&p, 1, 1, f);
+		}
+
+		if (str.empty() || "" == str) {
+			goto __read;
+		}
+
+		return true;
+	}
+
+	static void trimString(std::string &str) {
+		size_t first = str.find_first_not_of(" \t"), last;
+		if (first == str.npos) {
+			str = "";
+		} else {
+			last = str.find_last_not_of(" \t");
+			if (first > 0 || (last + 1) < str.length())
+				str = str.substr(first, last - first + 1);
+		}
+	}
+
+	bool load(const std::string &fileName) {
+		FILE *f = fopen(fileName.c_str(), "rb");
+		if (NULL == f)
+			return false;
+
+		std::string strline("");
+		lines.clear();
+		while (freadLine(f, strline)) {
+			trimString(strline);
+			if (strline != "" && ';' != strline[0] && '/' != strline[0] && '!' != strline[0])
+				lines.push_back(strline);
+		}
+		fclose(f);
+		return true;
+	}
+
+	bool save(const std::string &fileName) {
+		FILE *f = fopen(fileName.c_str(), "wb");
+		if (NULL == f)
+			return false;
+
+		for (size_t ii = 0; ii < lines.size(); ii++) {
+			std::string &strline = lines[ii];
+			size_t notSpace = strline.find_first_not_of(' ');
+			strline = strline.substr(notSpace);
+			if (strline.find('[') == 0 && ii > 0) {
+				if (!lines[ii - 1].empty() && lines[ii - 1] != "")
+					fwrite((gbar2Fix ? "\n" : "\r\n"), 1, 2-gbar2Fix, f);
+			}
+			if (!strline.empty() && strline != "") {
+				fwrite(strline.c_str(), 1, strline.length(), f);
+				fwrite((gbar2Fix ? "\n" : "\r\n"), 1, 2-gbar2Fix, f);
+			}
+		}
+		fclose(f);
+		return true;
+	}
+
+	std::string get(const std::string &Section, const std::string &Item) {
+		std::string strline, strSection, strItem, strValue;
+		size_t ii = 0;
+		size_t iFileLines = lines.size();
+		lastResult = false;
+
+		while (ii < iFileLines) {
+			strline = lines[ii++];
+
+			size_t rBracketPos = 0;
+			if ('[' == strline[0])
+				rBracketPos = strline.find(']');
+			if (rBracketPos > 0 && rBracketPos != std::string::npos) {
+				strSection = strline.substr(1, rBracketPos - 1);
+				if (strSection == Section) {
+					while (ii < iFileLines) {
+						strline = lines[ii++];
+						size_t equalsignPos = strline.find('=');
+						if (equalsignPos != strline.npos) {
+							size_t last = equalsignPos ? strline.find_last_not_of(" \t", equalsignPos - 1) : strline.npos;
+							if (last == strline.npos)
+								strItem = "";
+							else
+								strItem = strline.substr(0, last + 1);
+
+							if (strItem == Item) {
+								size_t first = strline.find_first_not_of(" \t", equalsignPos + 1);
+								if (first == strline.npos)
+									strValue = "";
+								else
+									strValue = strline.substr(first);
+								lastResult = true;
+								return strValue;
+							}
+						} else if ('[' == strline[0]) {
+							break;
+						}
+					}
+					break;
+				}
+			}
+		}
+		return std::string("");
+	}
+
+	void set(const std::string &Section, const std::string &Item, const std::string &Value) {
+		if (get(Section, Item) == Value)
+			return;
+
+		std::string strline, strSection, strItem;
+		size_t ii = 0;
+		size_t iFileLines = lines.size();
+
+		while (ii < iFileLines) {
+			strline = lines[ii++];
+
+			size_t rBracketPos = 0;
+			if ('[' == strline[0])
+				rBracketPos = strline.find(']');
+			if (rBracketPos > 0 && rBracketPos != std::string::npos) {
+				strSection = strline.substr(1, rBracketPos - 1);
+				if (strSection == Section) {
+					while (ii < iFileLines) {
+						strline = lines[ii++];
+						size_t equalsignPos = strline.find('=');
+						if (equalsignPos != strline.npos) {
+							size_t last = equalsignPos ? strline.find_last_not_of(" \t", equalsignPos - 1) : strline.npos;
+							if (last == strline.npos)
+								strItem = "";
+							else
+								strItem = strline.substr(0, last + 1);
+
+							if (Item == strItem) {
+								lines[ii - 1] = Item + (gbar2Fix ? "=" : " = ") + Value;
+								return;
+							}
+						} else if ('[' == strline[0]) {
+							lines.insert(lines.begin() + ii - 1, Item + (gbar2Fix ? "=" : " = ") + Value);
+							return;
+						}
+					}
+					lines.insert(lines.begin() + ii, Item + (gbar2Fix ? "=" : " = ") + Value);
+					return;
+				}
+			}
+		}
+
+		lines.insert(lines.begin() + ii, "[" + Section + "]");
+		lines.insert(lines.begin() + ii + 1, Item + (gbar2Fix ? "=" : " = ") + Value);
+	}
+};
+
+static std::string readFile(const char *path) {
+	std::string data;
+	FILE *f = fopen(path, "rb");
+	if (!f)
+		return data;
+	char buffer[4096];
+	size_t read;
+	while ((read = fread(buffer, 1, sizeof(buffer), f)) > 0)
+		data.append(buffer, read);
+	fclose(f);
+	return data;
+}
+
+static void writeFile(const char *path, const std::string &data) {
+	FILE *f = fopen(path, "wb");
+	fwrite(data.data(), 1, data.size(), f);
+	fclose(f);
+}
+
+static const char *const sectionNames[] = {"SRLOADER", "NDS-BOOTSTRAP", "TWL_FIRM", "GAME", "", "A", "a", "Sound Settings"};
+static const char *const itemNames[] = {"ROM_FOLDER", "LANGUAGE", "SOUND_FREQ", "DEBUG", "Key With Spaces", "", "x", "X", "THEME", "MACRO_MODE"};
+
+static std::string randomItem(void) {
+	return itemNames[rand() % 10] + std::string(rand() % 4 == 0 ? std::to_string(rand() % 50) : "");
+}
+
+static std::string randomSpaces(void) {
+	static const char *const spaces[] = {"", "", " ", "  ", "\t", " \t "};
+	return spaces[rand() % 6];
+}
+
+static std::string randomNewLine(void) {
+	static const char *const newLines[] = {"\r\n", "\r\n", "\n", "\r", "\r\n\r\n", "\n\n\n"};
+	return newLines[rand() % 6];
+}
+
+/**
+ * An .ini as edited by hand: uneven spacing and line ends, comments, lines
+ * before the first section, repeated sections and items, and lines that
+ * only look like sections or items.
+ */
+static std::string randomIni(void) {
+	std::string ini;
+	const int lineCount = rand() % 200;
+	for (int i = 0; i < lineCount; i++) {
+		ini += randomSpaces();
+		switch (rand() % 12) {
+		case 0:
+		case 1:
+			ini += "[" + std::string(sectionNames[rand() % 8]) + "]";
+			break;
+		case 2:
+			ini += (rand() % 2) ? "[unclosed" : "[]";
+			break;
+		case 3:
+			ini += std::string(1, ";/!"[rand() % 3]) + " comment = " + randomItem();
+			break;
+		case 4:
+			ini += "no equals sign here";
+			break;
+		case 5:
+			ini += "[" + randomItem() + "=value]";
+			break;
+		default:
+			ini += randomItem() + randomSpaces() + "=" + randomSpaces() + ((rand() % 5) ? std::to_string(rand()) : "") + randomSpaces();
+			break;
+		}
+		ini += randomSpaces() + randomNewLine();
+	}
+	return ini;
+}
+
+static bool sameLookups(CIniFile &ini, OldIniFile &old) {
+	for (const char *section : sectionNames) {
+		for (int i = 0; i < 60; i++) {
+			const std::string item = i < 10 ? itemNames[i] : randomItem();
+			std::string value;
+			const bool found = ini.GetFileValue(section, item, value);
+			const std::string oldValue = old.get(section, item);
+			if (found != old.lastResult || value != oldValue)
+				return false;
+		}
+	}
+	return true;
+}
+
+static bool sameSave(CIniFile &ini, OldIniFile &old) {
+	ini.SaveIniFile("new.ini");
+	old.save("old.ini");
+	return readFile("new.ini") == readFile("old.ini");
+}
+
+static void testRoundTrip(void) {
+	int lookupMismatches = 0, saveMismatches = 0;
+	for (int i = 0; i < 300; i++) {
+		gbar2Fix = (i % 2);
+		writeFile("test.ini", randomIni());
+		CIniFile ini("test.ini");
+		OldIniFile old;
+		old.load("test.ini");
+
+		if (!sameLookups(ini, old))
+			lookupMismatches++;
+		if (!sameSave(ini, old))
+			saveMismatches++;
+	}
+	gbar2Fix = false;
+	if (lookupMismatches || saveMismatches)
+		printf("Round trip: %d of 300 files looked up differently, %d saved differently\n", lookupMismatches, saveMismatches);
+	CHECK(lookupMismatches == 0);
+	CHECK(saveMismatches == 0);
+
+	// A UTF-8 byte order mark is skipped, where it used to end up in the first line
+	writeFile("test.ini", "\xEF\xBB\xBF[SRLOADER]\r\nTHEME = 1\r\n");
+	CIniFile ini("test.ini");
+	CHECK(ini.GetString("SRLOADER", "THEME", "") == "1");
+
+	// Missing files load nothing
+	CHECK(!ini.LoadIniFile("missing.ini"));
+}
+
+// Items added to sections throughout the file shift the indexed lines of every section after them
+static void testInsertLine(void) {
+	int mismatches = 0;
+	for (int i = 0; i < 100; i++) {
+		writeFile("test.ini", randomIni());
+		CIniFile ini("test.ini");
+		OldIniFile old;
+		old.load("test.ini");
+
+		for (int round = 0; round < 10; round++) {
+			for (int set = 0; set < 30; set++) {
+				const std::string section = (rand() % 10 == 0) ? "NEW" + std::to_string(rand() % 5) : sectionNames[rand() % 8];
+				const std::string item = randomItem() + ((rand() % 2) ? "_NEW" + std::to_string(rand() % 100) : "");
+				const std::string value = std::to_string(rand() % 1000);
+				ini.SetString(section, item, value);
+				old.set(section, item, value);
+			}
+			if (!sameLookups(ini, old) || !sameSave(ini, old))
+				mismatches++;
+		}
+	}
+	if (mismatches)
+		printf("InsertLine: %d of 1000 rounds of SetString differ\n", mismatches);
+	CHECK(mismatches == 0);
+}
+
+struct IniKey {
+	std::string section;
+	std::string item;
+};
+
+// The keys the settings code reads, taken from its source so they stay the real ones
+static std::vector<IniKey> keysReadBy(const char *sourcePath, const char *object) {
+	std::vector<IniKey> keys;
+	const std::string source = readFile(sourcePath);
+	const std::string call = std::string(object) + ".Get";
+	for (size_t pos = source.find(call); pos != source.npos; pos = source.find(call, pos + 1)) {
+		// Skip the commented out reads
+		const size_t lineStart = source.rfind('\n', pos) + 1;
+		if (source.compare(source.find_first_not_of(" \t", lineStart), 2, "//") == 0)
+			continue;
+		const size_t sectionStart = source.find('"', pos) + 1;
+		const size_t sectionEnd = source.find('"', sectionStart);
+		const size_t itemStart = source.find('"', sectionEnd + 1) + 1;
+		const size_t itemEnd = source.find('"', itemStart);
+		if (source.find(')', pos) < itemEnd)
+			continue;
+		keys.push_back({source.substr(sectionStart, sectionEnd - sectionStart), source.substr(itemStart, itemEnd - itemStart)});
+	}
+	return keys;
+}
+
+// An .ini with every key the code reads, in the order it reads them, as the menus write it
+static std::string iniFor(const std::vector<IniKey> &keys) {
+	CIniFile ini;
+	for (const IniKey &key : keys)
+		ini.SetString(key.section, key.item, (rand() % 4) ? std::to_string(rand() % 256) : "sd:/roms/nds/Some Game Folder");
+	ini.SaveIniFile("generated.ini");
+	return readFile("generated.ini");
+}
+
+// Loading settings.ini and nds-bootstrap.ini and reading every setting, each way
+static void benchSettingsLoad(void) {
+	const struct {
+		const char *name;
+		const char *source;
+		const char *object;
+	} files[] = {
+		{"settings.ini", "../../universal/source/common/twlmenusettings.cpp", "settingsini"},
+		{"nds-bootstrap.ini", "../../universal/source/common/bootstrapsettings.cpp", "bootstrapini"},
+	};
+
+	for (const auto &file : files) {
+		const std::vector<IniKey> keys = keysReadBy(file.source, file.object);
+		CHECK(keys.size() >= 10);
+		writeFile(file.name, iniFor(keys));
+		const int rounds = 200;
+
+		double start = hostMillis();
+		for (int round = 0; round < rounds; round++) {
+			OldIniFile old;
+			old.load(file.name);
+			for (const IniKey &key : keys)
+				old.get(key.section, key.item);
+		}
+		const double oldMillis = (hostMillis() - start) / rounds;
+
+		start = hostMillis();
+		for (int round = 0; round < rounds; round++) {
+			CIniFile ini(file.name);
+			std::string value;
+			for (const IniKey &key : keys)
+				ini.GetFileValue(key.section, key.item, value);
+		}
+		const double newMillis = (hostMillis() - start) / rounds;
+
+		printf("CIniFile, %s with %d settings: per-line reader %.3fms, indexed %.3fms to load and read them all\n",
+			file.name, (int)keys.size(), oldMillis, newMillis);
+	}
+}
+
+int main(int argc, char **argv) {
+	srand(1);
+	testRoundTrip();
+	testInsertLine();
+
+	if (benchRequested(argc, argv))
+		benchSettingsLoad();
+
+	return TEST_RESULT();
+}
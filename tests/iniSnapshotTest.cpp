@@ -0,0 +1,189 @@
+// IniSnapshot against CIniFile: snapshots kept and reused, stale, just written
+// and left for FAT's 2 seconds, and damaged
+
+#include "common/iniSnapshot.h"
+#include "common/inifile.h"
+#include "hostTest.h"
+
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+#include <time.h>
+#include <utime.h>
+
+#define INI_PATH		"sd:/_nds/TWiLightMenu/test.ini"
+#define SNAPSHOT_PATH	"sd:/_nds/TWiLightMenu/cache/test.bin"
+
+// Items in the .ini, missing from it, empty, in hex and in a section that isn't there
+static const char *const items[][2] = {
+	{"SRLOADER", "ROM_FOLDER"},
+	{"SRLOADER", "THEME"},
+	{"SRLOADER", "EMPTY"},
+	{"SRLOADER", "MISSING"},
+	{"NDS-BOOTSTRAP", "LANGUAGE"},
+	{"NDS-BOOTSTRAP", "SOUND_FREQ"},
+	{"NOT-A-SECTION", "THEME"},
+};
+
+static void writeIni(const std::string &text, time_t modified) {
+	FILE *file = fopen(INI_PATH, "wb");
+	fwrite(text.data(), 1, text.size(), file);
+	fclose(file);
+	struct utimbuf times = {modified, modified};
+	utime(INI_PATH, &times);
+}
+
+static bool snapshotExists(void) {
+	struct stat st;
+	return stat(SNAPSHOT_PATH, &st) == 0;
+}
+
+/**
+ * Read every item through a snapshot, as loadSettings() does, and count those
+ * that differ from what CIniFile reads from the .ini now.
+ */
+static int mismatches(bool *readFromIni) {
+	IniSnapshot snapshot(INI_PATH, "test");
+	// CIniFile keeps the default of an item it didn't find, so each is read once
+	CIniFile stringIni(INI_PATH);
+	CIniFile intIni(INI_PATH);
+	int failed = 0;
+	for (const auto &item : items) {
+		if (snapshot.GetString(item[0], item[1], "default") != stringIni.GetString(item[0], item[1], "default"))
+			failed++;
+		if (snapshot.GetInt(item[0], item[1], -7) != intIni.GetInt(item[0], item[1], -7))
+			failed++;
+	}
+	*readFromIni = snapshot.ReadFromIni();
+	snapshot.SaveSnapshot();
+	return failed;
+}
+
+static const std::string iniText(const char *theme, const char *language) {
+	return std::string("[SRLOADER]\nROM_FOLDER = sd:/roms\nTHEME = ") + theme + "\nEMPTY = \n[NDS-BOOTSTRAP]\nLANGUAGE = " + language + "\nSOUND_FREQ = 0x1\n";
+}
+
+// An .ini left alone for longer than FAT's 2 seconds gets a snapshot, which the next load reads everything from
+static void testSettled(void) {
+	const time_t settled = time(NULL) - 60;
+	writeIni(iniText("1", "2"), settled);
+	bool readFromIni;
+	CHECK(mismatches(&readFromIni) == 0);
+	CHECK(readFromIni);
+	CHECK(snapshotExists());
+
+	CHECK(mismatches(&readFromIni) == 0);
+	CHECK(!readFromIni);
+
+	// What's read is the snapshot's: an .ini changed to the same size, first
+	// cluster and time, as FAT can't tell apart, isn't read
+	writeIni(iniText("3", "2"), settled);
+	IniSnapshot snapshot(INI_PATH, "test");
+	CHECK(snapshot.GetInt("SRLOADER", "THEME", -7) == 1);
+	CHECK(!snapshot.ReadFromIni());
+
+	// An item not in the snapshot is read from the .ini, and added
+	CHECK(snapshot.GetString("SRLOADER", "EMPTY_2", "default") == "default");
+	CHECK(snapshot.ReadFromIni());
+	snapshot.SaveSnapshot();
+	IniSnapshot added(INI_PATH, "test");
+	CHECK(added.GetString("SRLOADER", "EMPTY_2", "other") == "other");
+	CHECK(added.GetInt("SRLOADER", "THEME", -7) == 1);
+	CHECK(!added.ReadFromIni());
+}
+
+// A snapshot of an .ini that's since been saved again, to another size or time, isn't used
+static void testStale(void) {
+	bool readFromIni;
+	writeIni(iniText("10", "2"), time(NULL) - 50);
+	CHECK(mismatches(&readFromIni) == 0);
+	CHECK(readFromIni);
+
+	// The same size, 2 seconds later
+	writeIni(iniText("11", "2"), time(NULL) - 48);
+	CHECK(mismatches(&readFromIni) == 0);
+	CHECK(readFromIni);
+	CHECK(mismatches(&readFromIni) == 0);
+	CHECK(!readFromIni);
+
+	// Another size, at the same time
+	writeIni(iniText("100", "2"), time(NULL) - 48);
+	CHECK(mismatches(&readFromIni) == 0);
+	CHECK(readFromIni);
+}
+
+/**
+ * An .ini saved within the last 2 seconds gets no snapshot: saved again
+ * within them, to the same size, it would have the same time. Once it's
+ * been left for that long, it does.
+ */
+static void testJustWritten(void) {
+	remove(SNAPSHOT_PATH);
+	const time_t now = time(NULL);
+	bool readFromIni;
+	writeIni(iniText("20", "2"), now);
+	CHECK(mismatches(&readFromIni) == 0);
+	CHECK(readFromIni);
+	CHECK(!snapshotExists());
+
+	writeIni(iniText("21", "3"), now);
+	CHECK(mismatches(&readFromIni) == 0);
+	CHECK(readFromIni);
+	CHECK(!snapshotExists());
+
+	// Still within them, as the time is to the second
+	writeIni(iniText("22", "3"), now - 1);
+	CHECK(mismatches(&readFromIni) == 0);
+	CHECK(!snapshotExists());
+
+	writeIni(iniText("23", "3"), now - 2);
+	CHECK(mismatches(&readFromIni) == 0);
+	CHECK(readFromIni);
+	CHECK(snapshotExists());
+	CHECK(mismatches(&readFromIni) == 0);
+	CHECK(!readFromIni);
+}
+
+// A damaged snapshot reads as none, and a missing .ini as every default
+static void testDamaged(void) {
+	bool readFromIni;
+	writeIni(iniText("30", "4"), time(NULL) - 40);
+	CHECK(mismatches(&readFromIni) == 0);
+
+	FILE *file = fopen(SNAPSHOT_PATH, "rb");
+	std::string data(0x1000, 0);
+	data.resize(fread(&data[0], 1, data.size(), file));
+	fclose(file);
+
+	for (size_t i = 0; i < data.size(); i += 3) {
+		std::string damaged = data;
+		damaged[i] ^= 0x41;
+		if (i % 2)
+			damaged.resize(i + 1);
+		file = fopen(SNAPSHOT_PATH, "wb");
+		fwrite(damaged.data(), 1, damaged.size(), file);
+		fclose(file);
+		IniSnapshot snapshot(INI_PATH, "test");
+		CHECK(snapshot.GetInt("SRLOADER", "THEME", -7) == 30);
+		CHECK(snapshot.ReadFromIni());
+	}
+
+	remove(INI_PATH);
+	IniSnapshot missing(INI_PATH, "test");
+	CHECK(missing.GetString("SRLOADER", "THEME", "default") == "default");
+	CHECK(missing.GetInt("NDS-BOOTSTRAP", "LANGUAGE", -7) == -7);
+	missing.SaveSnapshot();
+}
+
+int main(int argc, char **argv) {
+	mkdir("sd:", 0777);
+	mkdir("sd:/_nds", 0777);
+	mkdir("sd:/_nds/TWiLightMenu", 0777);
+	remove(SNAPSHOT_PATH);
+
+	testSettled();
+	testStale();
+	testJustWritten();
+	testDamaged();
+	return TEST_RESULT();
+}
@@ -0,0 +1,235 @@
+// RomInfoCache's lookups by listed and stat() keys, and reads of a page at once
+
+#include "rominfo/romInfoCache.h"
+#include "common/fnv1a.h"
+#include "hostTest.h"
+
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+// The cache is kept on "sd:", which on a host is a directory in the working directory
+bool sdFound(void) { return true; }
+
+#define TEST_VERSION 7
+
+struct TestInfo {
+	char gameCode[4];
+	u32 serial;
+	u32 fill[6];
+};
+
+static std::string romName(int i) {
+	return "Game " + std::to_string(i) + ".nds";
+}
+
+static TestInfo infoFor(int i, u32 generation) {
+	TestInfo info;
+	memcpy(info.gameCode, "ABCD", 4);
+	info.serial = i;
+	for (int j = 0; j < 6; j++)
+		info.fill[j] = i * 31 + j + generation;
+	return info;
+}
+
+// Banners of the sizes each banner version has
+static std::vector<u8> bannerFor(int i, u32 generation) {
+	static const u32 sizes[] = {0x840, 0x940, 0x1240, 0x23C0, 0};
+	std::vector<u8> banner(sizes[i % 5]);
+	for (size_t j = 0; j < banner.size(); j++)
+		banner[j] = (u8)(i + j * 7 + generation);
+	return banner;
+}
+
+// A FAT directory entry for a file of a size, first cluster and modification time
+static void makeDirEntry(u8 *entry, u32 size, u32 cluster, u16 time, u16 date) {
+	memset(entry, 0, 32);
+	entry[0x14] = cluster >> 16;
+	entry[0x15] = cluster >> 24;
+	entry[0x16] = time;
+	entry[0x17] = time >> 8;
+	entry[0x18] = date;
+	entry[0x19] = date >> 8;
+	entry[0x1A] = cluster;
+	entry[0x1B] = cluster >> 8;
+	for (int i = 0; i < 4; i++)
+		entry[0x1C + i] = size >> (i * 8);
+}
+
+static void listFiles(int count, u32 generation) {
+	romInfoCache().clearListing();
+	for (int i = 0; i < count; i++) {
+		u8 entry[32];
+		// 2016-03-14 12:34:56, and a second generation of the same files saved later
+		makeDirEntry(entry, 0x100000 + i, 1000 + i * 17 + (i << 20), (12 << 11) | (34 << 5) | (56 / 2), ((2016 - 1980) << 9) | (3 << 5) | (14 + generation));
+		romInfoCache().listFile(romName(i).c_str(), entry);
+	}
+}
+
+static bool matches(int i, u32 generation) {
+	TestInfo info;
+	std::vector<u8> banner(0x23C0 + 16, 0xA5);
+	u32 bannerSize = 0xFFFF;
+	if (!romInfoCache().get(romName(i).c_str(), &info, sizeof(info), banner.data(), 0x23C0, &bannerSize))
+		return false;
+	const TestInfo expected = infoFor(i, generation);
+	const std::vector<u8> expectedBanner = bannerFor(i, generation);
+	return memcmp(&info, &expected, sizeof(info)) == 0 && bannerSize == expectedBanner.size()
+		&& (bannerSize == 0 || memcmp(banner.data(), expectedBanner.data(), bannerSize) == 0) && banner[bannerSize] == 0xA5;
+}
+
+static int mismatches(int count, u32 generation) {
+	int failed = 0;
+	for (int i = 0; i < count; i++) {
+		if (!matches(i, generation))
+			failed++;
+	}
+	return failed;
+}
+
+// Files that were listed are found by the names they were listed under, without being on disk
+static void testListedFiles(void) {
+	// As many as fit twice in the 4 MiB data area
+	const int count = 500;
+	listFiles(count, 0);
+	romInfoCache().openDir("sd:/roms/nds", TEST_VERSION);
+	for (int i = 0; i < count; i++) {
+		const TestInfo info = infoFor(i, 0);
+		const std::vector<u8> banner = bannerFor(i, 0);
+		romInfoCache().put(romName(i).c_str(), &info, sizeof(info), banner.data(), banner.size());
+	}
+	CHECK(mismatches(count, 0) == 0);
+
+	// And again once reopened, which rebuilds the index from the file
+	romInfoCache().closeDir();
+	romInfoCache().openDir("sd:/roms/nds", TEST_VERSION);
+	CHECK(mismatches(count, 0) == 0);
+
+	// A ROM that isn't listed, and isn't on disk, isn't found
+	TestInfo info;
+	u32 bannerSize;
+	CHECK(!romInfoCache().get("Not Listed.nds", &info, sizeof(info), NULL, 0, &bannerSize));
+
+	// Another layout version doesn't see these
+	romInfoCache().openDir("sd:/roms/nds", TEST_VERSION + 1);
+	CHECK(mismatches(count, 0) == count);
+
+	// Files saved again are read again, and replaced
+	romInfoCache().openDir("sd:/roms/nds", TEST_VERSION);
+	listFiles(count, 1);
+	CHECK(mismatches(count, 0) == count);
+	for (int i = 0; i < count; i += 2) {
+		const TestInfo info = infoFor(i, 1);
+		const std::vector<u8> banner = bannerFor(i, 1);
+		romInfoCache().put(romName(i).c_str(), &info, sizeof(info), banner.data(), banner.size());
+	}
+	CHECK(mismatches(count, 1) == count / 2);
+	romInfoCache().closeDir();
+}
+
+// Files that weren't listed, like those an .argv points to, are looked up with stat()
+static void testUnlistedFiles(void) {
+	romInfoCache().clearListing();
+	mkdir("sd:/unlisted", 0777);
+	FILE *rom = fopen("sd:/unlisted/Game 3.nds", "wb");
+	fwrite("ROM", 1, 3, rom);
+	fclose(rom);
+
+	romInfoCache().openDir("sd:/unlisted", TEST_VERSION);
+	const TestInfo info = infoFor(3, 0);
+	const std::vector<u8> banner = bannerFor(3, 0);
+	romInfoCache().put("sd:/unlisted/Game 3.nds", &info, sizeof(info), banner.data(), banner.size());
+
+	TestInfo cached;
+	u32 bannerSize;
+	CHECK(romInfoCache().get("sd:/unlisted/Game 3.nds", &cached, sizeof(cached), NULL, 0, &bannerSize));
+	CHECK(memcmp(&cached, &info, sizeof(info)) == 0 && bannerSize == banner.size());
+
+	rom = fopen("sd:/unlisted/Game 3.nds", "ab");
+	fwrite("more", 1, 4, rom);
+	fclose(rom);
+	CHECK(!romInfoCache().get("sd:/unlisted/Game 3.nds", &cached, sizeof(cached), NULL, 0, &bannerSize));
+	romInfoCache().closeDir();
+}
+
+/**
+ * A page read in one go gives what reading each file would, also past what
+ * readPage() holds. What's read for a page is used: the cache file is
+ * overwritten under it after.
+ */
+static void testReadPage(void) {
+	const int count = 200;
+	listFiles(count, 0);
+	romInfoCache().openDir("sd:/roms/page", TEST_VERSION);
+	for (int i = 0; i < count; i++) {
+		const TestInfo info = infoFor(i, 0);
+		const std::vector<u8> banner = bannerFor(i, 0);
+		romInfoCache().put(romName(i).c_str(), &info, sizeof(info), banner.data(), banner.size());
+	}
+	romInfoCache().closeDir();
+
+	std::vector<std::string> names;
+	for (int i = 0; i < count; i++)
+		names.push_back(romName(i));
+	std::vector<const char *> allNames;
+	for (const std::string &name : names)
+		allNames.push_back(name.c_str());
+	romInfoCache().openDir("sd:/roms/page", TEST_VERSION);
+	romInfoCache().readPage(allNames.data(), allNames.size());
+	CHECK(mismatches(count, 0) == 0);
+
+	// The second page, with the names in another order and some not cached.
+	// DS ROMs, as the DSi's larger banners don't all fit in what's held.
+	std::vector<const char *> pageNames;
+	for (int i = 79; i >= 40; i--) {
+		if (bannerFor(i, 0).size() < 0x23C0)
+			pageNames.push_back(allNames[i]);
+	}
+	pageNames.push_back("Not Listed.nds");
+	romInfoCache().readPage(pageNames.data(), pageNames.size());
+
+	// Put garbage where the cached data of the first pages is, through another handle
+	char path[64];
+	const u32 version = TEST_VERSION;
+	snprintf(path, sizeof(path), "sd:/_nds/TWiLightMenu/cache/rominfo/%08lX.bin", (unsigned long)fnv1aHash(&version, sizeof(version), fnv1aHash("sd:/roms/page")));
+	FILE *cacheFile = fopen(path, "r+b");
+	CHECK(cacheFile != NULL);
+	if (cacheFile) {
+		fseek(cacheFile, 0, SEEK_END);
+		const long size = ftell(cacheFile);
+		// Past the 16-byte header and the 24-byte index slots
+		const long dataStart = 16 + ROMINFO_CACHE_MAX_ENTRIES * 24;
+		std::vector<u8> garbage(size - dataStart, 0x5A);
+		fseek(cacheFile, dataStart, SEEK_SET);
+		fwrite(garbage.data(), 1, garbage.size(), cacheFile);
+		fclose(cacheFile);
+	}
+
+	int failed = 0;
+	for (int i = 40; i < 80; i++) {
+		if (bannerFor(i, 0).size() < 0x23C0 && !matches(i, 0))
+			failed++;
+	}
+	CHECK(failed == 0);
+	// Outside the page, what's read is what's now in the file
+	CHECK(!matches(0, 0) && !matches(150, 0));
+
+	// A new page replaces the last one
+	romInfoCache().readPage(pageNames.data(), 0);
+	CHECK(!matches(45, 0));
+	romInfoCache().closeDir();
+}
+
+int main(int argc, char **argv) {
+	mkdir("sd:", 0777);
+	mkdir("sd:/_nds", 0777);
+	mkdir("sd:/_nds/TWiLightMenu", 0777);
+	// Start from no caches
+	system("rm -rf sd:/_nds/TWiLightMenu/cache/rominfo");
+
+	testListedFiles();
+	testUnlistedFiles();
+	testReadPage();
+	return TEST_RESULT();
+}
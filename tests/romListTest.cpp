@@ -0,0 +1,61 @@
+// lookupSaveInfo() against the linear scan it replaced, for every listed code
+
+#include <nds/ndstypes.h>
+#include "ROMList.h"
+#include "hostTest.h"
+
+#include <stdlib.h>
+
+// The scan the launchers used to do, first match wins
+static int linearSaveInfo(u32 gameCode)
+{
+	for (int i = 0; i < ROMListCount; i++) {
+		if (ROMList[i].GameCode == gameCode)
+			return (ROMList[i].SaveMemType == ROMLIST_SAVE_UNKNOWN) ? -1 : ROMList[i].SaveMemType;
+	}
+	return -1;
+}
+
+int main(int argc, char **argv)
+{
+	CHECK(sizeof(ROMListEntry) == 5);
+
+	for (int i = 0; i < ROMListCount; i++) {
+		const u32 gameCode = ROMList[i].GameCode;
+		CHECK(lookupSaveInfo(gameCode) == linearSaveInfo(gameCode));
+		CHECK(lookupSaveInfo(gameCode - 1) == linearSaveInfo(gameCode - 1));
+		CHECK(lookupSaveInfo(gameCode + 1) == linearSaveInfo(gameCode + 1));
+	}
+	CHECK(lookupSaveInfo(0) == -1);
+	CHECK(lookupSaveInfo(0xFFFFFFFF) == -1);
+
+	srand(1);
+	for (int i = 0; i < 100000; i++) {
+		const u32 gameCode = ((u32)rand() << 16) ^ (u32)rand();
+		CHECK(lookupSaveInfo(gameCode) == linearSaveInfo(gameCode));
+	}
+
+	if (benchRequested(argc, argv)) {
+		const int rounds = 20;
+		int sum = 0;
+		double start = hostMillis();
+		for (int round = 0; round < rounds; round++) {
+			for (int i = 0; i < ROMListCount; i++)
+				sum += linearSaveInfo(ROMList[i].GameCode);
+		}
+		const double linear = hostMillis() - start;
+
+		start = hostMillis();
+		for (int round = 0; round < rounds; round++) {
+			for (int i = 0; i < ROMListCount; i++)
+				sum -= lookupSaveInfo(ROMList[i].GameCode);
+		}
+		const double binary = hostMillis() - start;
+
+		const double lookups = (double)rounds * ROMListCount;
+		printf("ROMList, %d entries of %d bytes: linear scan %.1fns, binary search %.1fns per lookup%s\n",
+			ROMListCount, (int)sizeof(ROMListEntry), linear * 1e6 / lookups, binary * 1e6 / lookups, sum ? " (mismatch)" : "");
+	}
+
+	return TEST_RESULT();
+}
@@ -0,0 +1,443 @@
+// romScan: the one-pass scan for wait states, save tags and save patch
+// signatures, against the separate searches the GBA patcher made before it
+
+#include <nds.h>
+#include "common/tonccpy.h"
+#include "gbapatch/find.h"
+#include "gbapatch/romScan.h"
+#include "gbapatch/EepromSave.h"
+#include "gbapatch/FlashSave.h"
+#include "gbapatch/Save.h"
+#include "hostTest.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <vector>
+
+/*
+ * The save code as it was: every signature searched for with memsearch8(),
+ * and the tag found by save_findTag()'s word by word search below.
+ */
+namespace oldSave {
+#define romScan_find(start, dataSize, find, findSize) memsearch8(start, dataSize, find, findSize, true)
+#include "../universal/source/gbapatch/EepromSave.cpp"
+#include "../universal/source/gbapatch/FlashSave.cpp"
+#include "../universal/source/gbapatch/Save.cpp"
+#undef romScan_find
+
+u32 romSize = 0;
+
+const save_type_t* findTag()
+{
+	u32  curAddr = 0x080000C0;
+	char saveTag[16];
+	while (curAddr < 0x08000000+romSize) {
+		u32 fst = *(u32*)(uintptr_t)curAddr;
+		tonccpy(&saveTag, (u8*)(uintptr_t)curAddr, 16);
+		SaveType type = SAVE_TYPE_NONE;
+		if (fst == 0x53414C46 && (saveTag[5] == '_' || saveTag[5] == '5' || saveTag[5] == '1')) {
+			//FLAS
+			type = SAVE_TYPE_FLASH;
+		} else if (fst == 0x4D415253) {
+			//SRAM
+			type = SAVE_TYPE_SRAM;
+		} else if (fst == 0x52504545 && saveTag[6] == '_') {
+			//EEPR
+			type = SAVE_TYPE_EEPROM;
+		}
+
+		if (type != SAVE_TYPE_NONE) {
+			for (int i = 0; i < SAVE_TYPE_COUNT; i++) {
+				if (strncmp(saveTag, sSaveTypes[i].tag, sSaveTypes[i].tagLength) != 0)
+					continue;
+				return &sSaveTypes[i];
+			}
+		}
+		curAddr += 4;
+	}
+	return NULL;
+}
+}
+
+// tonccpy.c casts pointers to u32, so the copies are plain ones on a host
+extern "C" void tonccpy(void *dst, const void *src, uint size) { memcpy(dst, src, size); }
+extern "C" void __toncset(void *dst, u32 fill, uint size) {
+	for (uint i = 0; i < size; i++)
+		((u8 *)dst)[i] = fill >> ((i % 4) * 8);
+}
+
+// romScan_save() keeps its results on "sd:", which on a host is a directory in the working directory
+bool sdFound(void) { return true; }
+
+#define ROM ((u8*)0x08000000)
+#define ROM_MAX_SIZE 0x02000000
+
+// Mapped at the address of slot-2, and past where a ROM can end, as looking for the ROMs of a
+// 2-3 in 1 pack reads past the end of a ROM
+#define ROM_SPACE 0x08000000
+
+// The wait state patch, as gptc_patchWait() made it
+static void oldPatchWait(u32 romSize)
+{
+	u32 searchRange = 0x08000000+romSize;
+	if (romSize > 0x01FFFFDC) searchRange = 0x09FFFFDC;
+
+	for (u32 addr = 0x080000C0; addr < searchRange; addr+=4) {
+		if ((*(u8*)(uintptr_t)(addr-1) == 0x00 || *(u8*)(uintptr_t)(addr-1) == 0x03 || *(u8*)(uintptr_t)(addr-1) == 0x04 || *(u8*)(uintptr_t)(addr+7) == 0x04
+		  || *(u8*)(uintptr_t)(addr-1) == 0x08 || *(u8*)(uintptr_t)(addr-1) == 0x09
+		  || *(u8*)(uintptr_t)(addr-1) == 0x47 || *(u8*)(uintptr_t)(addr-1) == 0x81 || *(u8*)(uintptr_t)(addr-1) == 0x85
+		  || *(u8*)(uintptr_t)(addr-1) == 0xE0 || *(u8*)(uintptr_t)(addr-1) == 0xE7 || *(u16*)(uintptr_t)(addr-2) == 0xFFFE)
+		&& *(u32*)(uintptr_t)addr == 0x04000204) {
+			toncset((u16*)(uintptr_t)addr, 0, sizeof(u32));
+		}
+	}
+
+	if (*(u32*)0x08000410 == 0x04000204) {
+		toncset((u16*)0x08000410, 0, sizeof(u32));
+	}
+}
+
+// And as it's made now
+static void newPatchWait(void)
+{
+	u32 searchRange = romSize;
+	if (romSize > 0x01FFFFDC) searchRange = 0x01FFFFDC;
+	romScan_run(searchRange);
+
+	if (*(u32*)0x08000410 == 0x04000204) {
+		toncset((u16*)0x08000410, 0, sizeof(u32));
+	}
+}
+
+struct Signature
+{
+	const u8* find;
+	u32 size;
+};
+
+#define SIG(sig) {oldSave::sig, sizeof(oldSave::sig)}
+
+// The signatures each save type's patch looks for
+static std::vector<Signature> signaturesFor(SaveType type)
+{
+	switch (type) {
+		case SAVE_TYPE_EEPROM_V111:
+			return {SIG(sReadEepromDwordV111Sig), SIG(sProgramEepromDwordV111Sig)};
+		case SAVE_TYPE_EEPROM_V120:
+		case SAVE_TYPE_EEPROM_V121:
+		case SAVE_TYPE_EEPROM_V122:
+			return {SIG(sReadEepromDwordV120Sig), SIG(sProgramEepromDwordV120Sig)};
+		case SAVE_TYPE_EEPROM_V124:
+		case SAVE_TYPE_EEPROM_V125:
+			return {SIG(sReadEepromDwordV120Sig), SIG(sProgramEepromDwordV124Sig)};
+		case SAVE_TYPE_EEPROM_V126:
+			return {SIG(sReadEepromDwordV120Sig), SIG(sProgramEepromDwordV126Sig)};
+		case SAVE_TYPE_FLASH_V120:
+		case SAVE_TYPE_FLASH_V121:
+			return {SIG(flash_V12X_find1), SIG(flash_V12X_find2), SIG(flash_V12X_find3)};
+		case SAVE_TYPE_FLASH_V123:
+		case SAVE_TYPE_FLASH_V124:
+		case SAVE_TYPE_FLASH_V125:
+		case SAVE_TYPE_FLASH_V126:
+			return {SIG(flash_V12Y_find1), SIG(flash_V12Y_find2), SIG(flash_V12Y_find3), SIG(flash_V12Y_find4)};
+		case SAVE_TYPE_FLASH512_V130:
+		case SAVE_TYPE_FLASH512_V131:
+		case SAVE_TYPE_FLASH512_V133:
+			return {SIG(flash512_V13X_find1), SIG(flash512_V13X_find2), SIG(flash512_V13X_find3), SIG(flash512_V13X_find4), SIG(flash512_V13X_find5)};
+		case SAVE_TYPE_FLASH1M_V102:
+			return {SIG(flash1M_V102_find1), SIG(flash1M_V102_find2), SIG(flash1M_V102_find3), SIG(flash1M_V102_find4)};
+		case SAVE_TYPE_FLASH1M_V103:
+			return {SIG(flash1M_V103_find1), SIG(flash1M_V103_find2), SIG(flash1M_V103_find3), SIG(flash1M_V103_find4), SIG(flash1M_V103_find5)};
+		default:
+			return {};
+	}
+}
+
+// The patches that also look for the other ROMs of a 2-3 in 1 pack, 4 MB apart
+static bool patchesPacks(SaveType type)
+{
+	return (type >= SAVE_TYPE_EEPROM_V120 && type <= SAVE_TYPE_EEPROM_V125)
+	 || (type >= SAVE_TYPE_FLASH512_V130 && type <= SAVE_TYPE_FLASH512_V133);
+}
+
+static u32 seed = 1;
+
+static u32 nextRandom(u32 range)
+{
+	seed = seed * 1103515245 + 12345;
+	return ((seed >> 8) ^ (seed << 13)) % range;
+}
+
+static void put32(std::vector<u8>& rom, u32 offset, u32 value)
+{
+	if (offset + 4 <= rom.size())
+		memcpy(&rom[offset], &value, 4);
+}
+
+static void putBytes(std::vector<u8>& rom, u32 offset, const void* data, u32 size)
+{
+	if (offset + size <= rom.size())
+		memcpy(&rom[offset], data, size);
+}
+
+// A wait state access, with one of the bytes around it that gets it patched out (or not)
+static void putWaitState(std::vector<u8>& rom, u32 offset)
+{
+	static const u8 prevBytes[] = {0x00, 0x03, 0x04, 0x08, 0x09, 0x47, 0x81, 0x85, 0xE0, 0xE7, 0x12, 0xFF};
+	if (offset < 2 || offset + 8 > rom.size())
+		return;
+	put32(rom, offset, 0x04000204);
+	switch (nextRandom(4)) {
+		case 0:
+			rom[offset - 1] = prevBytes[nextRandom(sizeof(prevBytes))];
+			break;
+		case 1:
+			rom[offset + 7] = 0x04;
+			break;
+		case 2:
+			rom[offset - 2] = 0xFE;
+			rom[offset - 1] = 0xFF;
+			break;
+		default:
+			break;
+	}
+}
+
+// Somewhere a signature or tag may be: anywhere, or across where romScan_run() reads a new chunk
+static u32 somewhere(u32 romSize, u32 size)
+{
+	u32 offset = nextRandom(romSize - size);
+	if (nextRandom(4) == 0)
+		offset = (offset & ~0x3FFF) + 0x4000 - nextRandom(size + 8);
+	return (offset + size <= romSize) ? offset : romSize - size;
+}
+
+static void plantSignatures(std::vector<u8>& rom, u32 start, u32 end, SaveType type)
+{
+	for (const Signature& sig : signaturesFor(type)) {
+		// Sometimes missing, so the patch fails, and sometimes found more times than is kept
+		int copies = 1 + nextRandom(2) + (nextRandom(8) == 0 ? ROMSCAN_MAX_HITS + 2 : 0);
+		if (nextRandom(20) == 0)
+			copies = 0;
+		for (int i = 0; i < copies; i++)
+			putBytes(rom, start + somewhere(end - start, sig.size), sig.find, sig.size);
+
+		// One that a wait state is patched out of, after which it's no longer a match
+		if (nextRandom(6) == 0) {
+			const u32 at = (start + somewhere(end - start, sig.size + 8) + 3) & ~3;
+			putBytes(rom, at, sig.find, sig.size);
+			putWaitState(rom, at + 4);
+		}
+	}
+}
+
+/**
+ * A ROM of random bytes, with wait states, the save tag of type (if any),
+ * tags where they don't count, and save patch signatures, both for its own
+ * save type and for others.
+ */
+static std::vector<u8> makeRom(u32 size, int tag, bool pack)
+{
+	std::vector<u8> rom(size);
+	for (u32 i = 0; i < size; i += 4)
+		put32(rom, i, seed = seed * 1664525 + 1013904223);
+
+	// Wait states, some at and around 0x410
+	const u32 waitStates = 20 + size / 0x4000;
+	for (u32 i = 0; i < waitStates; i++)
+		putWaitState(rom, 0xB8 + nextRandom((size - 0xC0) / 4) * 4 + (nextRandom(8) == 0 ? nextRandom(4) : 0));
+	putWaitState(rom, 0x410 + nextRandom(2) * 4);
+	if (nextRandom(2))
+		put32(rom, 0x410, 0x04000204);
+
+	// Tags before 0xC0, not word-aligned, or not terminated, which aren't the save tag
+	const save_type_t& decoy = oldSave::sSaveTypes[nextRandom(SAVE_TYPE_COUNT)];
+	putBytes(rom, 0xA0 + nextRandom(8) * 4, decoy.tag, decoy.tagLength);
+	putBytes(rom, somewhere(size, 16) | 1, decoy.tag, decoy.tagLength);
+	const u32 unterminated = somewhere(size, 16) & ~3;
+	putBytes(rom, unterminated, decoy.tag, decoy.tagLength);
+	rom[unterminated + decoy.tagLength - 1] = 'X';
+
+	if (tag >= 0) {
+		const save_type_t& saveType = oldSave::sSaveTypes[tag];
+		putBytes(rom, (0xC0 + somewhere(size - 0xC0, 16)) & ~3, saveType.tag, saveType.tagLength);
+		// Sometimes another after it, which is never the one used
+		if (nextRandom(4) == 0) {
+			const save_type_t& later = oldSave::sSaveTypes[nextRandom(SAVE_TYPE_COUNT)];
+			putBytes(rom, (size - 16 - nextRandom(0x100)) & ~3, later.tag, later.tagLength);
+		}
+
+		plantSignatures(rom, 0, size, saveType.type);
+		if (pack) {
+			// Each ROM of the pack starts with the same header as the first
+			for (u32 start = 0x400000; start + 0x400000 <= size; start += 0x400000) {
+				putBytes(rom, start, &rom[0], 16);
+				plantSignatures(rom, start + 0xC0, start + 0x400000, saveType.type);
+			}
+		}
+	}
+
+	// Signatures of other save types
+	plantSignatures(rom, 0, size, oldSave::sSaveTypes[nextRandom(SAVE_TYPE_COUNT)].type);
+	return rom;
+}
+
+// How many ROMs the old way patched the save of, so there's enough compared
+static int savesPatched = 0;
+
+struct PatchResult
+{
+	SaveType type;
+	bool patched;
+};
+
+static PatchResult patchSave(const save_type_t* saveType)
+{
+	PatchResult result = {SAVE_TYPE_NONE, false};
+	if (saveType) {
+		result.type = saveType->type;
+		result.patched = (saveType->patchFunc && saveType->patchFunc(saveType));
+	}
+	return result;
+}
+
+static void loadRom(const std::vector<u8>& rom)
+{
+	memcpy(ROM, rom.data(), rom.size());
+	memset(ROM + rom.size(), 0, ROM_MAX_SIZE - rom.size());
+}
+
+/**
+ * Patch rom the old way and the new, and count where they differ. The new
+ * way's results are sometimes also passed through romScan_save() and
+ * romScan_load(), as the menus pass them to the patcher.
+ */
+static int mismatches(const std::vector<u8>& rom, bool waitStates, bool saveScan)
+{
+	int failed = 0;
+
+	loadRom(rom);
+	oldSave::romSize = rom.size();
+	if (waitStates)
+		oldPatchWait(rom.size());
+	const std::vector<u8> oldWaitPatched(ROM, ROM + rom.size());
+	const PatchResult oldResult = patchSave(oldSave::findTag());
+	const std::vector<u8> oldPatched(ROM, ROM + rom.size());
+	if (oldResult.patched)
+		savesPatched++;
+
+	loadRom(rom);
+	romSize = rom.size();
+	if (waitStates)
+		newPatchWait();
+	else
+		romScan_run(0);
+	if (memcmp(ROM, oldWaitPatched.data(), rom.size()) != 0)
+		failed++;
+
+	if (saveScan) {
+		romScan_save("rom.gba");
+		romScan_begin(0);
+		if (!romScan_load("rom.gba"))
+			failed++;
+	}
+
+	const PatchResult newResult = patchSave(save_findTag());
+	if (newResult.type != oldResult.type || newResult.patched != oldResult.patched)
+		failed++;
+	if (memcmp(ROM, oldPatched.data(), rom.size()) != 0)
+		failed++;
+	return failed;
+}
+
+static void testSynthetic(void)
+{
+	static const u32 smallSizes[] = {0x1000, 0x8000, 0x40000, 0xC0000};
+	static const u32 sizes[] = {0x100000, 0x200000, 0x400000, 0x800000, 0x1000000};
+
+	int failed = 0;
+	for (int n = 0; n < 120; n++) {
+		int tag = (n % 8 == 7) ? -1 : nextRandom(SAVE_TYPE_COUNT);
+		u32 size = sizes[nextRandom(sizeof(sizes) / sizeof(sizes[0]))];
+		// The pack search only stops at the end of a ROM of whole megabytes
+		if (n % 3 == 0 && (tag < 0 || !patchesPacks(oldSave::sSaveTypes[tag].type)))
+			size = smallSizes[nextRandom(sizeof(smallSizes) / sizeof(smallSizes[0]))];
+		if (n == 40 || n == 80)
+			size = ROM_MAX_SIZE;
+
+		const std::vector<u8> rom = makeRom(size, tag, size >= 0x800000 && nextRandom(2));
+		failed += mismatches(rom, n % 2 == 0, n % 4 == 1);
+	}
+	CHECK(failed == 0);
+	CHECK(savesPatched > 30);
+}
+
+/**
+ * A 2 in 1 pack whose first ROM has each signature more times than the scan
+ * keeps, so the second ROM's are only found by searching again.
+ */
+static void testPackWithManyHits(void)
+{
+	const int tag = 13;	// FLASH512_V130
+	std::vector<u8> rom = makeRom(0x800000, -1, false);
+	putBytes(rom, 0x1000, oldSave::sSaveTypes[tag].tag, oldSave::sSaveTypes[tag].tagLength);
+	putBytes(rom, 0x400000, &rom[0], 16);
+	u32 offset = 0x2000;
+	for (const Signature& sig : signaturesFor(oldSave::sSaveTypes[tag].type)) {
+		for (int i = 0; i < ROMSCAN_MAX_HITS + 1; i++, offset += 0x1000)
+			putBytes(rom, offset, sig.find, sig.size);
+		putBytes(rom, 0x400000 + offset, sig.find, sig.size);
+	}
+
+	const int patched = savesPatched;
+	CHECK(mismatches(rom, false, false) == 0);
+	CHECK(savesPatched == patched + 1);
+}
+
+// The results kept for the patcher are only taken for the same, unchanged ROM, and only once
+static void testSavedScan(void)
+{
+	const std::vector<u8> rom = makeRom(0x100000, 0, false);
+	loadRom(rom);
+	romSize = rom.size();
+	romScan_run(0);
+	romScan_save("rom.gba");
+	romScan_begin(0);
+	CHECK(!romScan_load("other.gba"));
+	CHECK(!romScan_load("rom.gba"));
+
+	romScan_run(0);
+	romScan_save("rom.gba");
+	romSize = 0x80000;
+	CHECK(!romScan_load("rom.gba"));
+
+	romSize = rom.size();
+	romScan_run(0);
+	romScan_save("rom.gba");
+	CHECK(romScan_load("rom.gba"));
+	CHECK(!romScan_load("rom.gba"));
+}
+
+int main(int argc, char **argv)
+{
+	if (mmap(ROM, ROM_SPACE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE | MAP_NORESERVE, -1, 0) != ROM) {
+		printf("Can't map the ROM at %p\n", ROM);
+		return 1;
+	}
+	mkdir("sd:", 0777);
+	mkdir("sd:/_nds", 0777);
+	mkdir("sd:/_nds/TWiLightMenu", 0777);
+	FILE* file = fopen("rom.gba", "wb");
+	fclose(file);
+	file = fopen("other.gba", "wb");
+	fputs("other", file);
+	fclose(file);
+
+	save_addScanPatterns();
+	testSynthetic();
+	testPackWithManyHits();
+	testSavedScan();
+	return TEST_RESULT();
+}
@@ -0,0 +1,193 @@
+// The rotating cubes video: rvid v2 written by vid2rvid/rvidv2.py and played
+// back by RvidStream, and uncompressed rvids played from memory
+
+#include "RvidStream.h"
+#include "common/tonccpy.h"
+#include "tool/colortool.h"
+#include "hostTest.h"
+
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+// tonccpy.c casts pointers to u32, so the copies are plain ones on a host
+extern "C" void tonccpy(void *dst, const void *src, uint size) { memcpy(dst, src, size); }
+extern "C" void __toncset(void *dst, u32 fill, uint size) {
+	for (uint i = 0; i < size; i++)
+		((u8 *)dst)[i] = fill >> ((i % 4) * 8);
+}
+
+#define ENCODER "python3 ../../romsel_dsimenutheme/vid2rvid/rvidv2.py"
+
+typedef std::vector<u16> Frame;
+
+/**
+ * Frames with what the encoder has to handle: a still background with a
+ * gradient, black (which grayscale leaves alone), a block that moves over
+ * it, noise that changes every frame, and a cut to a new scene halfway.
+ */
+static std::vector<Frame> makeFrames(u32 count, u32 height) {
+	std::vector<Frame> frames;
+	u32 seed = 12345;
+	for (u32 n = 0; n < count; n++) {
+		Frame frame(256 * height);
+		const bool cut = (n >= count / 2);
+		for (u32 y = 0; y < height; y++) {
+			for (u32 x = 0; x < 256; x++) {
+				u16 &pixel = frame[y * 256 + x];
+				if (x < 16)
+					pixel = 0;
+				else
+					pixel = cut ? (0x8000 | (x / 8) << 5 | (y % 32)) : (0x8000 | (x / 8) | (y % 32) << 10);
+
+				if (x >= (n * 5) % 200 + 16 && x < (n * 5) % 200 + 56 && y >= height / 4 && y < height / 2)
+					pixel = 0x83E0 + (n % 31);
+				if (x >= 224 && y < 8) {
+					seed = seed * 1103515245 + 12345;
+					pixel = (seed >> 16) & 0xFFFF;
+				}
+			}
+		}
+		frames.push_back(frame);
+	}
+	return frames;
+}
+
+static void writeV1(const char *path, const std::vector<Frame> &frames) {
+	FILE *file = fopen(path, "wb");
+	std::vector<u8> header(0x200, 0);
+	header[0] = 'R'; header[1] = 'V'; header[2] = 'I'; header[3] = 'D';
+	fwrite(header.data(), 1, header.size(), file);
+	for (const Frame &frame : frames)
+		fwrite(frame.data(), sizeof(u16), frame.size(), file);
+	fclose(file);
+}
+
+static Frame grayscaleOf(const Frame &frame) {
+	Frame gray(frame);
+	for (u16 &pixel : gray) {
+		if (pixel != 0)
+			pixel = convertVramColorToGrayscale(pixel);
+	}
+	return gray;
+}
+
+static bool shows(const RvidStream &stream, const Frame &expected) {
+	return stream.frame() != NULL && memcmp(stream.frame(), expected.data(), expected.size() * sizeof(u16)) == 0;
+}
+
+/**
+ * Play more than twice through, reading ahead as the main loop would, and
+ * count the frames that differ from the ones encoded. Every so often the
+ * main loop falls behind, and vblank has to wait for the frame.
+ */
+static int playbackMismatches(RvidStream &stream, const std::vector<Frame> &frames, bool grayscale) {
+	int failed = 0;
+	u32 shown = 0;
+	for (u32 vblank = 0; shown < frames.size() * 2 + 7; vblank++) {
+		if (vblank % 5 != 4)
+			stream.update();
+		if (!stream.nextFrame())
+			continue;
+		const Frame &frame = frames[shown++ % frames.size()];
+		if (!shows(stream, grayscale ? grayscaleOf(frame) : frame))
+			failed++;
+	}
+	return failed;
+}
+
+static bool encode(const char *in, const char *out, const char *options) {
+	const std::string command = std::string(ENCODER " ") + in + " " + out + " " + options + " > /dev/null";
+	return system(command.c_str()) == 0;
+}
+
+static void testRoundTrip(void) {
+	const std::vector<Frame> frames = makeFrames(120, 56);
+	writeV1("cubes.rvid", frames);
+	CHECK(encode("cubes.rvid", "cubes2.rvid", ""));
+	CHECK(encode("cubes.rvid", "cubes2-nokey.rvid", "--keyframe-interval 0"));
+
+	RvidStream stream;
+	for (const char *path : {"cubes2.rvid", "cubes2-nokey.rvid"}) {
+		for (bool grayscale : {false, true}) {
+			CHECK(stream.open(path, grayscale));
+			CHECK(stream.isStreamed());
+			CHECK(stream.frameSize() == 256 * 56 * sizeof(u16));
+			CHECK(playbackMismatches(stream, frames, grayscale) == 0);
+		}
+	}
+
+	// Full-screen frames of noise, of one colour, and unchanged, which take
+	// more than one COPY, FILL or SKIP op
+	std::vector<Frame> large = makeFrames(6, 192);
+	u32 seed = 1;
+	for (u16 &pixel : large[1]) {
+		seed = seed * 1103515245 + 12345;
+		pixel = seed >> 16;
+	}
+	large[3].assign(large[3].size(), 0x801F);
+	large[5] = large[4];
+	writeV1("large.rvid", large);
+	CHECK(encode("large.rvid", "large2.rvid", "--height 192"));
+	CHECK(stream.open("large2.rvid", false));
+	CHECK(playbackMismatches(stream, large, false) == 0);
+	stream.close();
+	CHECK(!stream.isOpen() && !stream.nextFrame());
+}
+
+// Uncompressed rvids are only played from memory, and only if they fit
+static void testLoad(void) {
+	const std::vector<Frame> frames = makeFrames(40, 56);
+	writeV1("cubes.rvid", frames);
+	const u32 size = frames.size() * 256 * 56 * sizeof(u16);
+	std::vector<u8> memory(size);
+
+	RvidStream stream;
+	CHECK(!stream.open("cubes.rvid", false));
+	CHECK(!stream.isOpen());
+	CHECK(!stream.load("cubes.rvid", 56, memory.data(), size - 1, false));
+
+	for (bool grayscale : {false, true}) {
+		CHECK(stream.load("cubes.rvid", 56, memory.data(), size, grayscale));
+		CHECK(stream.isOpen() && !stream.isStreamed());
+		CHECK(playbackMismatches(stream, frames, grayscale) == 0);
+	}
+
+	// v2 is never loaded whole
+	CHECK(encode("cubes.rvid", "cubes2.rvid", ""));
+	CHECK(!stream.load("cubes2.rvid", 56, memory.data(), size, false));
+	CHECK(!stream.isOpen());
+}
+
+// Damaged files are refused, not played
+static void testDamaged(void) {
+	RvidStream stream;
+	CHECK(!stream.open("missing.rvid", false));
+
+	FILE *file = fopen("cubes2.rvid", "rb");
+	std::vector<u8> data(0x10000);
+	data.resize(fread(data.data(), 1, data.size(), file));
+	fclose(file);
+
+	// More frames than the file has room to list
+	std::vector<u8> damaged(data.begin(), data.begin() + 0x40);
+	file = fopen("damaged.rvid", "wb");
+	fwrite(damaged.data(), 1, damaged.size(), file);
+	fclose(file);
+	CHECK(!stream.open("damaged.rvid", false));
+
+	// A first frame that isn't intra
+	damaged = data;
+	damaged[sizeof(RvidHeader) + 7] &= 0x7F;
+	file = fopen("damaged.rvid", "wb");
+	fwrite(damaged.data(), 1, damaged.size(), file);
+	fclose(file);
+	CHECK(!stream.open("damaged.rvid", false));
+}
+
+int main(int argc, char **argv) {
+	testRoundTrip();
+	testLoad();
+	testDamaged();
+	return TEST_RESULT();
+}
@@ -0,0 +1,24 @@
+#ifndef CARD_H
+#define CARD_H
+
+// The bootloaders' card.h, for the FAT driver on a host: the test provides
+// the reads, from an image in memory
+
+#include <nds/ndstypes.h>
+
+#define BYTES_PER_SECTOR 512
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool CARD_StartUp (void);
+bool CARD_IsInserted (void);
+bool CARD_ReadSector (u32 sector, void *buffer);
+bool CARD_ReadSectors (u32 sector, int count, void *buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CARD_H
@@ -0,0 +1,24 @@
+#pragma once
+#ifndef _HOST_NDS_H_
+#define _HOST_NDS_H_
+
+// The few libnds calls the host-tested code makes. The tests define them,
+// with a simulated clock and vblank.
+
+#include <nds/ndstypes.h>
+#include <stddef.h>
+
+#define BUS_CLOCK 33513982
+
+#define TIMER_ENABLE BIT(7)
+extern vu16 hostTimerControl[4];
+#define TIMER_CR(n) hostTimerControl[n]
+
+void cpuStartTiming(int timer);
+u32 cpuGetTiming(void);
+
+int enterCriticalSection(void);
+void leaveCriticalSection(int oldIME);
+void swiWaitForVBlank(void);
+
+#endif // _HOST_NDS_H_
@@ -0,0 +1,31 @@
+#pragma once
+#ifndef _HOST_NDSTYPES_H_
+#define _HOST_NDSTYPES_H_
+
+// Just enough of libnds' ndstypes.h for the shared code to build on a host
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef int64_t s64;
+
+typedef volatile u8 vu8;
+typedef volatile u16 vu16;
+typedef volatile u32 vu32;
+typedef volatile s32 vs32;
+
+#define BIT(n) (1 << (n))
+
+#define ITCM_CODE
+#define ITCM_DATA
+#define DTCM_DATA
+#define DTCM_BSS
+
+#endif // _HOST_NDSTYPES_H_
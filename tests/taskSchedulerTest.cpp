@@ -0,0 +1,194 @@
+// TaskScheduler and the DSi theme's vblank queue, on a simulated clock
+
+#include <nds.h>
+#include "queueControl.h"
+#include "hostTest.h"
+
+#include <string>
+#include <vector>
+
+// The simulated hardware: a tick counter that only moves when a task says it
+// took time, and a vblank that runs the queue the way the handler does
+static u32 hostTicks;
+vu16 hostTimerControl[4];
+static int criticalDepth;
+static int vblanksWaited;
+static bool waitedInCriticalSection;
+
+void cpuStartTiming(int timer) { hostTimerControl[timer] |= TIMER_ENABLE; }
+u32 cpuGetTiming(void) { return hostTicks; }
+int enterCriticalSection(void) { return criticalDepth++; }
+void leaveCriticalSection(int oldIME) { criticalDepth = oldIME; }
+
+void swiWaitForVBlank(void) {
+	if (criticalDepth > 0)
+		waitedInCriticalSection = true;
+	vblanksWaited++;
+	execQueue();
+}
+
+static u32 simulatedClock(void) { return hostTicks; }
+
+static std::string runLog;
+
+// A task of a number of steps, each taking a number of ticks, logging its name
+static TaskScheduler::Task loggedTask(char name, int steps, u32 ticks) {
+	return [name, steps, ticks]() mutable {
+		runLog += name;
+		hostTicks += ticks;
+		return --steps == 0;
+	};
+}
+
+static void testPriorities(void) {
+	TaskScheduler scheduler(simulatedClock);
+	runLog.clear();
+	scheduler.add(loggedTask('l', 1, 1), TaskScheduler::PRIORITY_LOW);
+	scheduler.add(loggedTask('n', 1, 1), TaskScheduler::PRIORITY_NORMAL);
+	scheduler.add(loggedTask('H', 1, 1), TaskScheduler::PRIORITY_HIGH);
+	scheduler.add(loggedTask('N', 1, 1), TaskScheduler::PRIORITY_NORMAL);
+	scheduler.add(loggedTask('h', 1, 1), TaskScheduler::PRIORITY_HIGH);
+	CHECK(!scheduler.run(1000));
+	CHECK(runLog == "HhnNl");
+	CHECK(scheduler.empty());
+
+	// A task that isn't done is resumed before the rest of its priority, even what it added
+	runLog.clear();
+	int steps = 3;
+	scheduler.add([&]() {
+		runLog += 'a';
+		if (steps == 3)
+			scheduler.add(loggedTask('c', 1, 1), TaskScheduler::PRIORITY_NORMAL);
+		return --steps == 0;
+	}, TaskScheduler::PRIORITY_NORMAL);
+	scheduler.add(loggedTask('b', 1, 1), TaskScheduler::PRIORITY_NORMAL);
+	CHECK(!scheduler.run(1000));
+	CHECK(runLog == "aaabc");
+}
+
+static void testBudget(void) {
+	// Starting just before the clock wraps, which mustn't cut the budget short
+	for (u32 startTicks : {0u, 0xFFFFFFC0u}) {
+		TaskScheduler scheduler(simulatedClock);
+		hostTicks = startTicks;
+		runLog.clear();
+		for (int i = 0; i < 10; i++)
+			scheduler.add(loggedTask('t', 1, 30), TaskScheduler::PRIORITY_NORMAL);
+
+		// Steps start at 0, 30, 60 and 90 ticks, and the last one runs 20 over
+		CHECK(scheduler.run(100));
+		CHECK(runLog.size() == 4);
+		CHECK(hostTicks - startTicks == 120);
+
+		CHECK(scheduler.run(100));
+		CHECK(runLog.size() == 8);
+		CHECK(!scheduler.run(100));
+		CHECK(runLog.size() == 10);
+	}
+
+	// Nothing runs on no budget
+	TaskScheduler scheduler(simulatedClock);
+	scheduler.add(loggedTask('t', 1, 1), TaskScheduler::PRIORITY_HIGH);
+	CHECK(scheduler.run(0));
+}
+
+static void testCancel(void) {
+	TaskScheduler scheduler(simulatedClock);
+	const u32 page = scheduler.newToken();
+	const u32 otherPage = scheduler.newToken();
+	CHECK(page != 0 && otherPage != 0 && page != otherPage);
+
+	runLog.clear();
+	scheduler.add(loggedTask('p', 1, 1), TaskScheduler::PRIORITY_HIGH, page);
+	scheduler.add(loggedTask('o', 1, 1), TaskScheduler::PRIORITY_NORMAL, otherPage);
+	scheduler.add(loggedTask('P', 1, 1), TaskScheduler::PRIORITY_LOW, page);
+	scheduler.add(loggedTask('z', 1, 1), TaskScheduler::PRIORITY_LOW);
+	scheduler.cancel(page);
+	scheduler.cancel(0);	// Tasks without a token are never cancelled
+	CHECK(!scheduler.run(1000));
+	CHECK(runLog == "oz");
+
+	// A task that cancels its own token isn't resumed
+	runLog.clear();
+	scheduler.add([&]() {
+		runLog += 'r';
+		scheduler.cancel(page);
+		return false;
+	}, TaskScheduler::PRIORITY_NORMAL, page);
+	scheduler.add(loggedTask('s', 1, 1), TaskScheduler::PRIORITY_NORMAL);
+	CHECK(!scheduler.run(1000));
+	CHECK(runLog == "rs");
+}
+
+// What a deferred task took, per step
+static u32 deferredTicks;
+
+static bool loggedDeferred(const DeferredArgs &args) {
+	runLog += (char)args.num;
+	hostTicks += deferredTicks;
+	return --*(int *)args.ptr[0] == 0;
+}
+
+static void loggedFunction(void) {
+	runLog += '!';
+	hostTicks += deferredTicks;
+}
+
+static void testVblankQueue(void) {
+	const u32 budget = BUS_CLOCK / 1000;
+
+	// Tasks and functions run in the order they were deferred, a task until it's done
+	runLog.clear();
+	deferredTicks = 1;
+	int stepsA = 3, stepsB = 1;
+	deferTask(loggedDeferred, {{&stepsA, NULL}, 'a', false});
+	defer(loggedFunction);
+	deferTask(loggedDeferred, {{&stepsB, NULL}, 'b', false});
+	execQueue();
+	CHECK(runLog == "aaa!b");
+
+	// No more than the budget each vblank, plus the step that ran over it
+	runLog.clear();
+	deferredTicks = budget / 4 + 1;
+	int steps = 10;
+	deferTask(loggedDeferred, {{&steps, NULL}, 's', false});
+	const u32 start = hostTicks;
+	execQueue();
+	CHECK(runLog.size() == 4);
+	CHECK(hostTicks - start < budget + deferredTicks);
+	execQueue();
+	execQueue();
+	CHECK(runLog.size() == 10);
+
+	// The timer is restarted if something else stopped it
+	hostTimerControl[2] = 0;
+	execQueue();
+	CHECK(hostTimerControl[2] & TIMER_ENABLE);
+
+	// Deferring past what the ring holds waits for vblanks to make room,
+	// outside the critical section, and loses nothing
+	runLog.clear();
+	vblanksWaited = 0;
+	waitedInCriticalSection = false;
+	deferredTicks = budget / 10;
+	std::string expected;
+	std::vector<int> oneStep(300, 1);
+	for (int i = 0; i < 300; i++) {
+		expected += (char)('A' + i % 26);
+		deferTask(loggedDeferred, {{&oneStep[i], NULL}, expected.back(), false});
+	}
+	while (runLog.size() < 300 && vblanksWaited < 1000)
+		swiWaitForVBlank();
+	CHECK(runLog == expected);
+	CHECK(vblanksWaited > 0);
+	CHECK(!waitedInCriticalSection);
+	CHECK(criticalDepth == 0);
+}
+
+int main(int argc, char **argv) {
+	testPriorities();
+	testBudget();
+	testCancel();
+	testVblankQueue();
+	return TEST_RESULT();
+}
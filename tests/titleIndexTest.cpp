@@ -0,0 +1,432 @@
+// TitleIndex search against a scan of every name and title, and the 5,000-title benchmark
+
+#include "common/titleIndex.h"
+#include "common/directoryModel.h"
+#include "common/fnv1a.h"
+#include "hostTest.h"
+
+#include <algorithm>
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+// Heap in use and its peak, for the benchmark. Each block is prefixed with its size.
+static size_t heapNow, heapPeak;
+
+void *operator new(size_t size) {
+	size_t *block = (size_t *)malloc(size + sizeof(max_align_t));
+	if (!block)
+		throw std::bad_alloc();
+	*block = size;
+	heapNow += size;
+	heapPeak = std::max(heapPeak, heapNow);
+	return (char *)block + sizeof(max_align_t);
+}
+
+void operator delete(void *p) noexcept {
+	if (!p)
+		return;
+	size_t *block = (size_t *)((uintptr_t)p - sizeof(max_align_t));
+	heapNow -= *block;
+	free(block);
+}
+
+void operator delete(void *p, size_t) noexcept { operator delete(p); }
+
+// std::stable_sort() takes its buffer this way
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+	try {
+		return operator new(size);
+	} catch (const std::bad_alloc &) {
+		return NULL;
+	}
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept { operator delete(p); }
+
+// The index is kept on "sd:", which on a host is a directory in the working directory
+bool sdFound(void) { return true; }
+
+static std::string indexPath(const char *dirPath) {
+	char path[64];
+	snprintf(path, sizeof(path), "sd:/_nds/TWiLightMenu/cache/titleindex/%08lX.bin", (unsigned long)fnv1aHash(dirPath));
+	return path;
+}
+
+static const char *const englishWords[] = {"Super", "Mario", "Kart", "Legend", "Phantom", "Hourglass", "Brain", "Training", "Animal", "Crossing",
+	"Wild", "World", "Dragon", "Quest", "Final", "Fantasy", "Advance", "Wars", "Strike", "Metroid", "Hunters", "Castlevania", "Dawn", "Sorrow",
+	"Professor", "Layton", "Curious", "Village", "Tetris", "Picross", "Star", "Command", "Racing", "Party", "Island", "Kingdom", "Hearts", "Days"};
+static const char *const frenchWords[] = {"Légende", "Île", "Château", "Épée", "Mystère", "Étoile", "Forêt", "Royaume", "Cœur", "Aventure", "Dragon",
+	"Être", "Fée", "Énigme", "Village", "Course"};
+static const char *const germanWords[] = {"Schwert", "Drachen", "Königreich", "Abenteuer", "Straße", "Rätsel", "Dorf", "Größe", "Grüne", "Insel", "Sterne", "Prüfung"};
+static const char *const spanishWords[] = {"Leyenda", "Espada", "Corazón", "Aventura", "Misión", "Niño", "Reino", "Isla", "Estrella", "Dragón"};
+static const char *const japaneseWords[] = {"スーパー", "マリオ", "カート", "ドラゴン", "クエスト", "ゼルダ", "伝説", "夢幻", "砂時計", "脳", "トレーニング", "どうぶつ", "の森",
+	"レイトン", "教授", "不思議", "な町", "ポケモン", "ダンジョン"};
+static const char *const chineseWords[] = {"超级", "马力欧", "赛车", "传说", "大脑", "训练", "动物", "森林", "龙", "任务"};
+static const char *const koreanWords[] = {"슈퍼", "마리오", "카트", "전설", "두뇌", "트레이닝", "동물", "의숲", "드래곤", "퀘스트"};
+static const char *const publishers[] = {"Nintendo", "Square Enix", "Konami", "Capcom", "Level-5", "SEGA", "Namco Bandai", "Ubisoft"};
+
+struct Language {
+	const char *const *words;
+	int count;
+	const char *separator;
+};
+
+// In banner order: Japanese, English, French, German, Italian (as Spanish here), Spanish, Chinese, Korean
+static const Language languages[8] = {
+	{japaneseWords, 19, ""}, {englishWords, 38, " "}, {frenchWords, 16, " "}, {germanWords, 12, " "},
+	{spanishWords, 10, " "}, {spanishWords, 10, " "}, {chineseWords, 10, ""}, {koreanWords, 10, " "},
+};
+
+static u32 decodeUtf8(const u8 *&p) {
+	u32 c = *p++;
+	if (c >= 0xE0) {
+		c = ((c & 0x0F) << 12) | ((p[0] & 0x3F) << 6) | (p[1] & 0x3F);
+		p += 2;
+	} else if (c >= 0xC0) {
+		c = ((c & 0x1F) << 6) | (p[0] & 0x3F);
+		p++;
+	}
+	return c;
+}
+
+static void encodeUtf8(std::string &text, u32 c) {
+	if (c < 0x80) {
+		text += (char)c;
+	} else if (c < 0x800) {
+		text += (char)(0xC0 | (c >> 6));
+		text += (char)(0x80 | (c & 0x3F));
+	} else {
+		text += (char)(0xE0 | (c >> 12));
+		text += (char)(0x80 | ((c >> 6) & 0x3F));
+		text += (char)(0x80 | (c & 0x3F));
+	}
+}
+
+/**
+ * What a title, name or query should be searched as, written out by hand for
+ * the characters these tests use: letters and digits lowercased, the accented
+ * letters as their base letters, other ASCII as one space between words.
+ */
+static std::string referenceNormalize(const std::string &utf8) {
+	static const struct {
+		u32 c;
+		const char *fold;
+	} folds[] = {
+		{0xE9, "e"}, {0xC9, "e"}, {0xE8, "e"}, {0xEA, "e"}, {0xCA, "e"}, {0xEE, "i"}, {0xCE, "i"}, {0xE2, "a"}, {0xE4, "a"}, {0xF6, "o"},
+		{0xFC, "u"}, {0xF3, "o"}, {0xF1, "n"}, {0xDF, "ss"}, {0x153, "oe"}, {0x152, "oe"},
+	};
+
+	std::string text;
+	for (const u8 *p = (const u8 *)utf8.c_str(); *p;) {
+		const u32 c = decodeUtf8(p);
+		const char *fold = NULL;
+		for (const auto &entry : folds) {
+			if (entry.c == c)
+				fold = entry.fold;
+		}
+		if (fold) {
+			text += fold;
+		} else if (c < 0x80 && isalnum(c)) {
+			text += (char)tolower(c);
+		} else if (c < 0x80) {
+			if (!text.empty() && text.back() != ' ')
+				text += ' ';
+		} else {
+			encodeUtf8(text, c);
+		}
+	}
+	if (!text.empty() && text.back() == ' ')
+		text.pop_back();
+	return text;
+}
+
+static void toBanner(const std::string &utf8, u16 *title) {
+	memset(title, 0, 128 * sizeof(u16));
+	int i = 0;
+	for (const u8 *p = (const u8 *)utf8.c_str(); *p && i < 127;)
+		title[i++] = decodeUtf8(p);
+}
+
+// A directory of ROMs, each with a name, and banner titles if it's been seen
+struct TestDirectory {
+	DirectoryModel listing;
+	std::vector<std::vector<std::string>> fields;	// Normalized name, then titles, for each file
+	std::vector<std::vector<std::string>> titles;	// As in the banner, empty if not read yet
+};
+
+static void addFile(TestDirectory &dir, int serial, bool withTitles, bool isDirectory) {
+	const int wordCount = 2 + rand() % 4;
+	int picks[6];
+	for (int i = 0; i < wordCount; i++)
+		picks[i] = rand();
+
+	// Some names have accents too
+	const Language &nameLanguage = languages[(rand() % 4 == 0) ? 2 : 1];
+	std::string name;
+	for (int i = 0; i < wordCount; i++) {
+		if (i > 0) name += ' ';
+		name += nameLanguage.words[picks[i] % nameLanguage.count];
+	}
+	name += " (" + std::to_string(serial) + ")";
+	if (!isDirectory)
+		name += ".nds";
+	else if (rand() % 2)
+		name += ".v2";	// Kept, as directories have no extension
+
+	std::string nameField = name;
+	if (!isDirectory)
+		nameField.resize(name.size() - 4);
+	std::vector<std::string> fields = {referenceNormalize(nameField)};
+
+	// Only ROMs have banners
+	std::vector<std::string> bannerTitles;
+	if (withTitles && !isDirectory) {
+		for (const Language &language : languages) {
+			std::string title;
+			for (int i = 0; i < wordCount; i++) {
+				if (i > 0) title += language.separator;
+				title += language.words[picks[i] % language.count];
+			}
+			title += "\n";
+			title += publishers[picks[0] % 8];
+			bannerTitles.push_back(title);
+			fields.push_back(referenceNormalize(title));
+		}
+	}
+
+	dir.listing.add(name.c_str(), isDirectory, -1);
+	dir.fields.push_back(fields);
+	dir.titles.push_back(bannerTitles);
+}
+
+static void setAllTitles(TitleIndex &index, const TestDirectory &dir) {
+	static u16 banner[8][128];
+	for (size_t i = 0; i < dir.titles.size(); i++) {
+		if (dir.titles[i].empty())
+			continue;
+		for (size_t j = 0; j < dir.titles[i].size(); j++)
+			toBanner(dir.titles[i][j], banner[j]);
+		index.setTitles(dir.listing.name(i), banner, dir.titles[i].size());
+	}
+}
+
+// The files a query should find, by looking through every field of every file
+static std::vector<int> referenceSearch(const TestDirectory &dir, const char *query) {
+	const std::string normalized = referenceNormalize(query);
+	std::vector<int> results;
+	if (normalized.empty())
+		return results;
+
+	for (size_t i = 0; i < dir.fields.size(); i++) {
+		bool found = false;
+		for (const std::string &field : dir.fields[i]) {
+			if (normalized.size() >= 3) {
+				found = (field.find(normalized) != std::string::npos);
+			} else {
+				// Short queries only match the start of a word
+				for (size_t pos = 0; pos < field.size() && !found; pos++)
+					found = (pos == 0 || field[pos - 1] == ' ') && field.compare(pos, normalized.size(), normalized) == 0;
+			}
+			if (found)
+				break;
+		}
+		if (found)
+			results.push_back(i);
+	}
+	return results;
+}
+
+static std::vector<std::string> testQueries(const TestDirectory &dir) {
+	std::vector<std::string> queries = {"a", "ma", "mario kart", "légende", "legende", "LEGENDE", "königreich", "konigreich", "strasse", "coeur",
+		"pokemon", "マリオ", "伝説", "슈퍼", "nintendo", "level 5", "level-5", "(12)", "xyzzy", "", " ", "..", "île", "ile", "corazon", "nino"};
+	for (const Language &language : languages) {
+		for (int i = 0; i < language.count; i++)
+			queries.push_back(language.words[i]);
+	}
+
+	// Pieces of the text, cut between characters
+	for (int i = 0; i < 200; i++) {
+		const std::vector<std::string> &fields = dir.fields[rand() % dir.fields.size()];
+		const std::string &field = fields[rand() % fields.size()];
+		size_t start = rand() % (field.size() + 1), end = start + 1 + rand() % 12;
+		while (start > 0 && start < field.size() && ((u8)field[start] & 0xC0) == 0x80) start--;
+		while (end < field.size() && ((u8)field[end] & 0xC0) == 0x80) end++;
+		queries.push_back(field.substr(start, end - start));
+	}
+	return queries;
+}
+
+static int searchMismatches(TitleIndex &index, const TestDirectory &dir, const std::vector<std::string> &queries) {
+	int mismatches = 0;
+	std::vector<int> results;
+	for (const std::string &query : queries) {
+		const std::vector<int> expected = referenceSearch(dir, query.c_str());
+		const size_t total = index.search(query.c_str(), results, 20);
+		const std::vector<int> firstExpected(expected.begin(), expected.begin() + std::min(expected.size(), (size_t)20));
+		if (total != expected.size() || results != firstExpected) {
+			if (mismatches++ < 5)
+				printf("\"%s\": %lu found, %lu expected\n", query.c_str(), (unsigned long)total, (unsigned long)expected.size());
+		}
+	}
+	return mismatches;
+}
+
+static void testSearch(void) {
+	TestDirectory dir;
+	for (int i = 0; i < 1500; i++)
+		addFile(dir, i, rand() % 3 != 0, rand() % 30 == 0);
+	const std::vector<std::string> queries = testQueries(dir);
+
+	const char *dirPath = "sd:/roms/search/";
+	remove(indexPath(dirPath).c_str());
+	TitleIndex &index = titleIndex();
+	index.openDir(dirPath);
+	index.sync(dir.listing);
+	setAllTitles(index, dir);
+	CHECK(searchMismatches(index, dir, queries) == 0);
+
+	// The same from the file, after the search wrote the postings with it
+	index.openDir("sd:/roms/other/");
+	index.openDir(dirPath);
+	index.sync(dir.listing);
+	CHECK(searchMismatches(index, dir, queries) == 0);
+
+	// Files removed and added since, and titles read for some of them
+	TestDirectory changed;
+	for (size_t i = 0; i < dir.listing.size(); i++) {
+		if (rand() % 10 == 0)
+			continue;
+		changed.listing.add(dir.listing.name(i), dir.listing.isDirectory(i), -1);
+		changed.fields.push_back(dir.fields[i]);
+		changed.titles.push_back(dir.titles[i]);
+	}
+	for (int i = 0; i < 100; i++)
+		addFile(changed, 1500 + i, rand() % 2, false);
+	index.sync(changed.listing);
+	setAllTitles(index, changed);
+	CHECK(searchMismatches(index, changed, queries) == 0);
+}
+
+// Damaged index files are read as empty or rebuilt, and never read past.
+// "make SANITIZE=1" makes any stray read fail the test.
+static void testDamagedFiles(void) {
+	TestDirectory dir;
+	for (int i = 0; i < 50; i++)
+		addFile(dir, i, true, false);
+
+	const char *dirPath = "sd:/roms/damaged/";
+	const std::string path = indexPath(dirPath);
+	remove(path.c_str());
+	TitleIndex &index = titleIndex();
+	std::vector<int> results;
+	index.openDir(dirPath);
+	index.sync(dir.listing);
+	setAllTitles(index, dir);
+	index.search("mario", results, 10);
+	index.openDir("sd:/roms/other/");
+
+	std::vector<u8> good;
+	FILE *file = fopen(path.c_str(), "rb");
+	for (int c; file && (c = fgetc(file)) != EOF;)
+		good.push_back(c);
+	if (file)
+		fclose(file);
+	CHECK(good.size() > sizeof(TitleIndex::Header));
+	if (good.size() <= sizeof(TitleIndex::Header))
+		return;
+
+	static const char *const queries[] = {"mario", "le", "1", "ende", "g", "伝説"};
+	for (int i = 0; i < 1000; i++) {
+		std::vector<u8> damaged = good;
+		const int changes = 1 + rand() % 4;
+		for (int j = 0; j < changes; j++) {
+			// The header often, as that's where the sizes are
+			const size_t at = (rand() % 3 == 0) ? rand() % sizeof(TitleIndex::Header) : rand() % damaged.size();
+			damaged[at] = (rand() % 2) ? rand() : damaged[at] ^ (1 << (rand() % 8));
+		}
+		if (rand() % 10 == 0)
+			damaged.resize(rand() % damaged.size());
+
+		file = fopen(path.c_str(), "wb");
+		fwrite(damaged.data(), 1, damaged.size(), file);
+		fclose(file);
+
+		index.openDir(dirPath);
+		index.sync(dir.listing);
+		for (const char *query : queries) {
+			const size_t total = index.search(query, results, 10);
+			CHECK(total <= dir.listing.size());
+			for (int result : results)
+				CHECK(result >= 0 && result < (int)dir.listing.size());
+		}
+		index.openDir("sd:/roms/other/");
+	}
+
+	// Whatever was read, a rebuild from the listing still finds everything it should
+	remove(path.c_str());
+	index.openDir(dirPath);
+	index.sync(dir.listing);
+	setAllTitles(index, dir);
+	const std::vector<std::string> checkQueries(queries, queries + sizeof(queries) / sizeof(queries[0]));
+	CHECK(searchMismatches(index, dir, checkQueries) == 0);
+}
+
+// A directory of 5,000 ROMs with banner titles in 8 languages, as the request has it
+static void benchSearch(void) {
+	TestDirectory dir;
+	for (int i = 0; i < 5000; i++)
+		addFile(dir, i, true, false);
+
+	const char *dirPath = "sd:/roms/bench/";
+	remove(indexPath(dirPath).c_str());
+	TitleIndex &index = titleIndex();
+	index.openDir(dirPath);
+	index.sync(dir.listing);
+	setAllTitles(index, dir);
+
+	std::vector<int> results;
+	results.reserve(100);
+	const size_t heapBefore = heapNow;
+	heapPeak = heapNow;
+	double start = hostMillis();
+	index.search("xyzzy", results, 100);	// Builds the postings
+	const double rebuild = hostMillis() - start;
+	printf("TitleIndex, 5000 files with 8 titles each: rebuild %.1fms, heap +%luKB at peak, +%luKB after\n", rebuild,
+		(unsigned long)((heapPeak - heapBefore) / 1024), (unsigned long)((heapNow - heapBefore) / 1024));
+
+	const char *const queries[] = {"ma", "mario kart", "legende", "königreich", "マリオ", "伝説", "슈퍼", "nintendo", "xyzzy"};
+	const int rounds = 100;
+	double slowest = 0;
+	for (const char *query : queries) {
+		size_t total = 0;
+		start = hostMillis();
+		for (int i = 0; i < rounds; i++)
+			total = index.search(query, results, 100);
+		const double perQuery = (hostMillis() - start) / rounds;
+		slowest = std::max(slowest, perQuery);
+		printf("  %-16s %5lu files, %.3fms\n", query, (unsigned long)total, perQuery);
+	}
+	printf("  slowest query %.3fms, against 16.7ms for a frame\n", slowest);
+	index.openDir("sd:/roms/other/");
+}
+
+int main(int argc, char **argv) {
+	mkdir("sd:", 0777);
+	mkdir("sd:/_nds", 0777);
+	mkdir("sd:/_nds/TWiLightMenu", 0777);
+	mkdir("sd:/_nds/TWiLightMenu/cache", 0777);
+	srand(1);
+
+	testSearch();
+	testDamagedFiles();
+
+	if (benchRequested(argc, argv)) {
+		benchSearch();
+	}
+
+	return TEST_RESULT();
+}
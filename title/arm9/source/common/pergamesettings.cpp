@@ -11,7 +11,7 @@
 #include <nds.h>
 
 #include "myDSiMode.h"
-#include "common/inifile.h"
+#include "gamesettings/gameSettingsDb.h"
 
 bool perGameSettings_directBoot = false;	// Homebrew only
 int perGameSettings_dsiMode = -1;
@@ -29,25 +29,22 @@ int perGameSettings_expandRomSpace = -1;
 int perGameSettings_dsiwareBooter = -1;
 int perGameSettings_useBootstrap = -1;
 
-char pergamefilepath[256];
-
 void loadPerGameSettings (std::string filename) {
-	snprintf(pergamefilepath, sizeof(pergamefilepath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", (ms().previousUsedDevice ? "fat:" : "sd:"), filename.c_str());
-	CIniFile pergameini( pergamefilepath );
-	perGameSettings_dsiMode = pergameini.GetInt("GAMESETTINGS", "DSI_MODE", -1);
-	perGameSettings_language = pergameini.GetInt("GAMESETTINGS", "LANGUAGE", -2);
-	perGameSettings_region = pergameini.GetInt("GAMESETTINGS", "REGION", -3);
+	GameSettings pergameini((ms().previousUsedDevice ? "fat:" : "sd:"), filename);
+	perGameSettings_dsiMode = pergameini.GetInt(GAMESETTINGS_DSI_MODE, -1);
+	perGameSettings_language = pergameini.GetInt(GAMESETTINGS_LANGUAGE, -2);
+	perGameSettings_region = pergameini.GetInt(GAMESETTINGS_REGION, -3);
 	if (perGameSettings_region < -2 || (!dsiFeatures() && perGameSettings_region == -1)) perGameSettings_region = -2;
-	perGameSettings_saveNo = pergameini.GetInt("GAMESETTINGS", "SAVE_NUMBER", 0);
-	perGameSettings_boostCpu = pergameini.GetInt("GAMESETTINGS", "BOOST_CPU", -1);
-	perGameSettings_boostVram = pergameini.GetInt("GAMESETTINGS", "BOOST_VRAM", -1);
-	perGameSettings_cardReadDMA = pergameini.GetInt("GAMESETTINGS", "CARD_READ_DMA", -1);
-	perGameSettings_asyncCardRead = pergameini.GetInt("GAMESETTINGS", "ASYNC_CARD_READ", -1);
-	perGameSettings_bootstrapFile = pergameini.GetInt("GAMESETTINGS", "BOOTSTRAP_FILE", -1);
-	perGameSettings_wideScreen = pergameini.GetInt("GAMESETTINGS", "WIDESCREEN", -1);
-	perGameSettings_expandRomSpace = pergameini.GetInt("GAMESETTINGS", "EXTENDED_MEMORY", -1);
-	perGameSettings_dsiwareBooter = pergameini.GetInt("GAMESETTINGS", "DSIWARE_BOOTER", -1);
-	perGameSettings_useBootstrap = pergameini.GetInt("GAMESETTINGS", "USE_BOOTSTRAP", -1);
+	perGameSettings_saveNo = pergameini.GetInt(GAMESETTINGS_SAVE_NUMBER, 0);
+	perGameSettings_boostCpu = pergameini.GetInt(GAMESETTINGS_BOOST_CPU, -1);
+	perGameSettings_boostVram = pergameini.GetInt(GAMESETTINGS_BOOST_VRAM, -1);
+	perGameSettings_cardReadDMA = pergameini.GetInt(GAMESETTINGS_CARD_READ_DMA, -1);
+	perGameSettings_asyncCardRead = pergameini.GetInt(GAMESETTINGS_ASYNC_CARD_READ, -1);
+	perGameSettings_bootstrapFile = pergameini.GetInt(GAMESETTINGS_BOOTSTRAP_FILE, -1);
+	perGameSettings_wideScreen = pergameini.GetInt(GAMESETTINGS_WIDESCREEN, -1);
+	perGameSettings_expandRomSpace = pergameini.GetInt(GAMESETTINGS_EXTENDED_MEMORY, -1);
+	perGameSettings_dsiwareBooter = pergameini.GetInt(GAMESETTINGS_DSIWARE_BOOTER, -1);
+	perGameSettings_useBootstrap = pergameini.GetInt(GAMESETTINGS_USE_BOOTSTRAP, -1);
 }
 
 std::string getSavExtension(void) {
@@ -33,9 +33,7 @@
 
 #include "autoboot.h"
 
-#include "twlClockExcludeMap.h"
-#include "dmaExcludeMap.h"
-#include "asyncReadExcludeMap.h"
+#include "gameRules.h"
 #include "saveMap.h"
 #include "ROMList.h"
 
@@ -526,13 +524,8 @@ void lastRunROM()
 				u32 gameTidHex = 0;
 				tonccpy(&gameTidHex, &game_TID, 4);
 
-				for (int i = 0; i < (int)sizeof(ROMList)/12; i++) {
-					ROMListEntry* curentry = &ROMList[i];
-					if (gameTidHex == curentry->GameCode) {
-						if (curentry->SaveMemType != 0xFFFFFFFF) savesize = sramlen[curentry->SaveMemType];
-						break;
-					}
-				}
+				int saveMemType = lookupSaveInfo(gameTidHex);
+				if (saveMemType != -1) savesize = sramlen[saveMemType];
 
 				if ((orgsavesize == 0 && savesize > 0) || (orgsavesize < savesize)) {
 					consoleDemoInit();
@@ -558,30 +551,17 @@ void lastRunROM()
 				}
 
 				if (!ms().ignoreBlacklists) {
-					// TODO: If the list gets large enough, switch to bsearch().
-					for (unsigned int i = 0; i < sizeof(twlClockExcludeList)/sizeof(twlClockExcludeList[0]); i++) {
-						if (memcmp(game_TID, twlClockExcludeList[i], 3) == 0) {
-							// Found match
-							boostCpu = false;
-							dsModeForced = true;
-							break;
-						}
+					if (getGameRules(game_TID) & GAMERULE_NO_TWL_CLOCK) {
+						boostCpu = false;
+						dsModeForced = true;
 					}
 
-					for (unsigned int i = 0; i < sizeof(cardReadDMAExcludeList)/sizeof(cardReadDMAExcludeList[0]); i++) {
-						if (memcmp(game_TID, cardReadDMAExcludeList[i], 3) == 0) {
-							// Found match
-							cardReadDMA = false;
-							break;
-						}
+					if (getGameRules(game_TID) & GAMERULE_NO_CARD_DMA) {
+						cardReadDMA = false;
 					}
 
-					for (unsigned int i = 0; i < sizeof(asyncReadExcludeList)/sizeof(asyncReadExcludeList[0]); i++) {
-						if (memcmp(game_TID, asyncReadExcludeList[i], 3) == 0) {
-							// Found match
-							asyncCardRead = false;
-							break;
-						}
+					if (getGameRules(game_TID) & GAMERULE_NO_ASYNC_READ) {
+						asyncCardRead = false;
 					}
 				}
 
@@ -888,13 +868,8 @@ void lastRunROM()
 				}
 
 				if (!ms().ignoreBlacklists) {
-					// TODO: If the list gets large enough, switch to bsearch().
-					for (unsigned int i = 0; i < sizeof(cardReadDMAExcludeList)/sizeof(cardReadDMAExcludeList[0]); i++) {
-						if (memcmp(NDSHeader.gameCode, cardReadDMAExcludeList[i], 3) == 0) {
-							// Found match
-							cardReadDMA = false;
-							break;
-						}
+					if (getGameRules(NDSHeader.gameCode) & GAMERULE_NO_CARD_DMA) {
+						cardReadDMA = false;
 					}
 				}
 
@@ -9,6 +9,7 @@
 #include "common/flashcard.h"
 #include "common/tonccpy.h"
 #include "common/lodepng.h"
+#include "common/colorConvert.h"
 #include "graphics/graphics.h"
 #include "graphics/color.h"
 #include "sound.h"
@@ -606,49 +607,7 @@ void twlMenuVideo(void) {
 
 	// Load TWLMenu++ logo
 	lodepng::decode(image, width, height, logoPath);
-	bool alternatePixel = false;
-	for (unsigned i=0;i<image.size()/4;i++) {
-		image[(i*4)+3] = 0;
-		if (alternatePixel) {
-			if (image[(i*4)] >= 0x4) {
-				image[(i*4)] -= 0x4;
-				image[(i*4)+3] |= BIT(0);
-			}
-			if (image[(i*4)+1] >= 0x4) {
-				image[(i*4)+1] -= 0x4;
-				image[(i*4)+3] |= BIT(1);
-			}
-			if (image[(i*4)+2] >= 0x4) {
-				image[(i*4)+2] -= 0x4;
-				image[(i*4)+3] |= BIT(2);
-			}
-		}
-		frameBuffer[0][i] = image[i*4]>>3 | (image[(i*4)+1]>>3)<<5 | (image[(i*4)+2]>>3)<<10 | BIT(15);
-		if (alternatePixel) {
-			if (image[(i*4)+3] & BIT(0)) {
-				image[(i*4)] += 0x4;
-			}
-			if (image[(i*4)+3] & BIT(1)) {
-				image[(i*4)+1] += 0x4;
-			}
-			if (image[(i*4)+3] & BIT(2)) {
-				image[(i*4)+2] += 0x4;
-			}
-		} else {
-			if (image[(i*4)] >= 0x4) {
-				image[(i*4)] -= 0x4;
-			}
-			if (image[(i*4)+1] >= 0x4) {
-				image[(i*4)+1] -= 0x4;
-			}
-			if (image[(i*4)+2] >= 0x4) {
-				image[(i*4)+2] -= 0x4;
-			}
-		}
-		frameBuffer[1][i] = image[i*4]>>3 | (image[(i*4)+1]>>3)<<5 | (image[(i*4)+2]>>3)<<10 | BIT(15);
-		if ((i % 256) == 255) alternatePixel = !alternatePixel;
-		alternatePixel = !alternatePixel;
-	}
+	rgbaToBgr555(frameBuffer[0], frameBuffer[1], width, image.data(), width, height, 4, 0);
 	image.clear();
 
 	doubleBuffer = true;
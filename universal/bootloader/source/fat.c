@@ -31,6 +31,7 @@ License:
 
 #include "fat.h"
 #include "card.h"
+#include <stddef.h>
 
 
 //---------------------------------------------------------------
@@ -202,6 +203,19 @@ enum {FS_UNKNOWN, FS_FAT12, FS_FAT16, FS_FAT32} discFileSystem;
 // Global sector buffer to save on stack space
 unsigned char globalBuffer[BYTES_PER_SECTOR];
 
+// FAT sectors are read a few at a time, as cluster chains are mostly in
+// order, so walking one only needs a new read every few hundred clusters
+#define FAT_CACHE_SECTORS 4
+static unsigned char fatCache[FAT_CACHE_SECTORS * BYTES_PER_SECTOR] __attribute__ ((aligned (4)));
+static u32 fatCacheStart;	// First sector in the cache, relative to the FAT
+static u32 fatCacheCount;	// Number of sectors in the cache, 0 if empty
+
+// Where the last fileRead() left off, so reading on from there doesn't
+// need to walk the cluster chain from the start of the file again
+static u32 seekFirstCluster = CLUSTER_FREE;
+static u32 seekClusterIndex;
+static u32 seekCluster;
+
 
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 //FAT routines
@@ -210,6 +224,36 @@ u32 FAT_ClustToSect (u32 cluster) {
 	return (((cluster-2) * discSecPerClus) + discData);
 }
 
+/*-----------------------------------------------------------------
+FAT_CachedEntry
+Internal function - gets a pointer to a byte of the FAT, reading the
+sectors around it into the cache if needed
+-----------------------------------------------------------------*/
+static const u8* FAT_CachedEntry(u32 offset)
+{
+	u32 sector = offset / BYTES_PER_SECTOR;
+
+	if (sector >= (u32)discSecPerFAT) {
+		return NULL;
+	}
+
+	if (fatCacheCount == 0 || sector < fatCacheStart || sector >= fatCacheStart + fatCacheCount) {
+		u32 count = FAT_CACHE_SECTORS;
+		if (sector + count > (u32)discSecPerFAT) {
+			count = discSecPerFAT - sector;
+		}
+
+		if (!CARD_ReadSectors(discFAT + sector, count, fatCache)) {
+			fatCacheCount = 0;
+			return NULL;
+		}
+		fatCacheStart = sector;
+		fatCacheCount = count;
+	}
+
+	return fatCache + (offset - (fatCacheStart * BYTES_PER_SECTOR));
+}
+
 /*-----------------------------------------------------------------
 FAT_NextCluster
 Internal function - gets the cluster linked from input cluster
@@ -217,9 +261,8 @@ Internal function - gets the cluster linked from input cluster
 u32 FAT_NextCluster(u32 cluster)
 {
 	u32 nextCluster = CLUSTER_FREE;
-	u32 sector;
-	int offset;
-	
+	const u8* entry;
+	const u8* entryHigh;
 	
 	switch (discFileSystem) 
 	{
@@ -228,19 +271,19 @@ u32 FAT_NextCluster(u32 cluster)
 			break;
 			
 		case FS_FAT12:
-			sector = discFAT + (((cluster * 3) / 2) / BYTES_PER_SECTOR);
-			offset = ((cluster * 3) / 2) % BYTES_PER_SECTOR;
-			CARD_ReadSector(sector, globalBuffer);
-			nextCluster = ((u8*) globalBuffer)[offset];
-			offset++;
-			
-			if (offset >= BYTES_PER_SECTOR) {
-				offset = 0;
-				sector++;
+			// Entries are 12 bits, so may be split across sectors
+			entry = FAT_CachedEntry((cluster * 3) / 2);
+			if (!entry) {
+				break;
 			}
+			nextCluster = *entry;
 			
-			CARD_ReadSector(sector, globalBuffer);
-			nextCluster |= (((u8*) globalBuffer)[offset]) << 8;
+			entryHigh = FAT_CachedEntry(((cluster * 3) / 2) + 1);
+			if (!entryHigh) {
+				nextCluster = CLUSTER_FREE;
+				break;
+			}
+			nextCluster |= *entryHigh << 8;
 			
 			if (cluster & 0x01) {
 				nextCluster = nextCluster >> 4;
@@ -248,15 +291,18 @@ u32 FAT_NextCluster(u32 cluster)
 				nextCluster &= 0x0FFF;
 			}
 			
+			if (nextCluster >= 0x0FF7) {
+				nextCluster = CLUSTER_EOF;
+			}
 			break;
 			
 		case FS_FAT16:
-			sector = discFAT + ((cluster << 1) / BYTES_PER_SECTOR);
-			offset = cluster % (BYTES_PER_SECTOR >> 1);
-			
-			CARD_ReadSector(sector, globalBuffer);
+			entry = FAT_CachedEntry(cluster << 1);
+			if (!entry) {
+				break;
+			}
 			// read the nextCluster value
-			nextCluster = ((u16*)globalBuffer)[offset];
+			nextCluster = *(const u16*)entry;
 			
 			if (nextCluster >= 0xFFF7) {
 				nextCluster = CLUSTER_EOF;
@@ -264,12 +310,12 @@ u32 FAT_NextCluster(u32 cluster)
 			break;
 			
 		case FS_FAT32:
-			sector = discFAT + ((cluster << 2) / BYTES_PER_SECTOR);
-			offset = cluster % (BYTES_PER_SECTOR >> 2);
-			
-			CARD_ReadSector(sector, globalBuffer);
+			entry = FAT_CachedEntry(cluster << 2);
+			if (!entry) {
+				break;
+			}
 			// read the nextCluster value
-			nextCluster = (((u32*)globalBuffer)[offset]) & 0x0FFFFFFF;
+			nextCluster = (*(const u32*)entry) & 0x0FFFFFFF;
 			
 			if (nextCluster >= 0x0FFFFFF7) {
 				nextCluster = CLUSTER_EOF;
@@ -312,6 +358,10 @@ bool FAT_InitFiles (bool initCard)
 	if (initCard && !CARD_StartUp()) {
 		return (false);
 	}
+
+	// Forget anything cached from a previous card
+	fatCacheCount = 0;
+	seekFirstCluster = CLUSTER_FREE;
 	
 	// Read first sector of card
 	if (!CARD_ReadSector (0, globalBuffer)) 
@@ -469,23 +519,32 @@ u32 getBootFileCluster (const char* bootName)
 
 /*-----------------------------------------------------------------
 fileRead(buffer, cluster, startOffset, length)
+Whole sectors are read straight into the buffer, in one read for each
+run of clusters that are next to each other on the card.
 -----------------------------------------------------------------*/
 u32 fileRead (char* buffer, u32 cluster, u32 startOffset, u32 length)
 {
 	int curByte;
 	int curSect;
 	
-	int dataPos = 0;
-	int chunks;
-	int beginBytes;
+	u32 dataPos = 0;
+	u32 firstCluster = cluster;
+	u32 clusterIndex;
+	u32 chunks;
 
 	if (cluster == CLUSTER_FREE || cluster == CLUSTER_EOF) 
 	{
 		return 0;
 	}
 	
-	// Follow cluster list until desired one is found
-	for (chunks = startOffset / discBytePerClus; chunks > 0; chunks--) {
+	// Follow cluster list until desired one is found, from where the last read
+	// left off if that was in the same file, and not past this position
+	clusterIndex = 0;
+	if (seekFirstCluster == firstCluster && seekClusterIndex <= startOffset / discBytePerClus) {
+		clusterIndex = seekClusterIndex;
+		cluster = seekCluster;
+	}
+	for (; clusterIndex < startOffset / discBytePerClus; clusterIndex++) {
 		cluster = FAT_NextCluster (cluster);
 	}
 	
@@ -494,37 +553,50 @@ u32 fileRead (char* buffer, u32 cluster, u32 startOffset, u32 length)
 	curSect = (startOffset % discBytePerClus) / BYTES_PER_SECTOR;
 	curByte = startOffset % BYTES_PER_SECTOR;
 
-	// Load sector buffer for new position in file
-	CARD_ReadSector( curSect + FAT_ClustToSect(cluster), globalBuffer);
-	curSect++;
-
-	// Number of bytes needed to read to align with a sector
-	beginBytes = (BYTES_PER_SECTOR < length + curByte ? (BYTES_PER_SECTOR - curByte) : length);
-
 	// Read first part from buffer, to align with sector boundary
-	for (dataPos = 0 ; dataPos < beginBytes; dataPos++) {
-		buffer[dataPos] = globalBuffer[curByte++];
+	if (curByte != 0) {
+		CARD_ReadSector( curSect + FAT_ClustToSect(cluster), globalBuffer);
+		curSect++;
+
+		for (; dataPos < length && curByte < BYTES_PER_SECTOR; dataPos++) {
+			buffer[dataPos] = globalBuffer[curByte++];
+		}
 	}
 
 	// Read in all the 512 byte chunks of the file directly, saving time
-	for (chunks = ((int)length - beginBytes) / BYTES_PER_SECTOR; chunks > 0;) {
-		int sectorsToRead;
+	for (chunks = (length - dataPos) / BYTES_PER_SECTOR; chunks > 0;) {
+		u32 sectorsToRead;
+		u32 runClusters = 0;
+		u32 firstSector;
 
 		// Move to the next cluster if necessary
 		if (curSect >= discSecPerClus) {
 			curSect = 0;
 			cluster = FAT_NextCluster (cluster);
+			clusterIndex++;
 		}
 
-		// Calculate how many sectors to read (read a maximum of discSecPerClus at a time)
+		// Read the rest of this cluster, and the following clusters for as
+		// long as the file carries on into them without a break
+		firstSector = curSect + FAT_ClustToSect(cluster);
 		sectorsToRead = discSecPerClus - curSect;
+		while (sectorsToRead < chunks) {
+			u32 nextCluster = FAT_NextCluster (cluster);
+			if (nextCluster != cluster + 1) {
+				break;
+			}
+			cluster = nextCluster;
+			clusterIndex++;
+			runClusters++;
+			sectorsToRead += discSecPerClus;
+		}
 		if (chunks < sectorsToRead)
 			sectorsToRead = chunks;
 
 		// Read the sectors
-		CARD_ReadSectors(curSect + FAT_ClustToSect(cluster), sectorsToRead, buffer + dataPos);
+		CARD_ReadSectors(firstSector, sectorsToRead, buffer + dataPos);
 		chunks  -= sectorsToRead;
-		curSect += sectorsToRead;
+		curSect += sectorsToRead - (runClusters * discSecPerClus);
 		dataPos += BYTES_PER_SECTOR * sectorsToRead;
 	}
 
@@ -536,6 +608,7 @@ u32 fileRead (char* buffer, u32 cluster, u32 startOffset, u32 length)
 		if (curSect >= discSecPerClus) {
 			curSect = 0;
 			cluster = FAT_NextCluster (cluster);
+			clusterIndex++;
 		}
 		CARD_ReadSector( curSect + FAT_ClustToSect( cluster), globalBuffer);
 		
@@ -545,6 +618,10 @@ u32 fileRead (char* buffer, u32 cluster, u32 startOffset, u32 length)
 			curByte++;
 		}
 	}
+
+	seekFirstCluster = firstCluster;
+	seekClusterIndex = clusterIndex;
+	seekCluster = cluster;
 	
 	return dataPos;
 }
@@ -0,0 +1,174 @@
+# -*- coding: utf8 -*-
+# Compile gameRules.txt into universal/include/gameRules.h
+#
+# Every game ID from every [section] is merged into one table, sorted by ID,
+# holding a bitmask of the rules that apply to it. The table is searched at
+# runtime with getGameRules() instead of scanning one list per rule.
+
+import argparse
+import os
+import sys
+
+# Section name -> flag name, in bit order
+RULES = [
+	('ap_none', 'GAMERULE_AP_NONE'),
+	('ap', 'GAMERULE_AP'),
+	('ap_alt', 'GAMERULE_AP_ALT'),
+	('incompatible_b4ds', 'GAMERULE_INCOMPATIBLE_B4DS'),
+	('incompatible_fc', 'GAMERULE_INCOMPATIBLE_FC'),
+	('incompatible', 'GAMERULE_INCOMPATIBLE'),
+	('incompatible_memorypit', 'GAMERULE_INCOMPATIBLE_MEMORYPIT'),
+	('no_async_read', 'GAMERULE_NO_ASYNC_READ'),
+	('no_card_dma', 'GAMERULE_NO_CARD_DMA'),
+	('no_twl_clock', 'GAMERULE_NO_TWL_CLOCK'),
+	('dsiware_b4ds', 'GAMERULE_DSIWARE_B4DS'),
+	('dsiware_b4ds_debug', 'GAMERULE_DSIWARE_B4DS_DEBUG'),
+	('ram_limited_b4ds', 'GAMERULE_RAM_LIMITED_B4DS'),
+	('ram_limited_b4ds_debug', 'GAMERULE_RAM_LIMITED_B4DS_DEBUG'),
+	('ram_limited_all', 'GAMERULE_RAM_LIMITED_ALL'),
+]
+
+# Sections taking a message ID, and the bit position it is stored at
+MESSAGE_SHIFT = {
+	'ram_limited_b4ds': 16,
+	'ram_limited_b4ds_debug': 20,
+	'ram_limited_all': 24,
+}
+
+
+def error(path, lineNo, msg):
+	sys.exit('%s:%d: %s' % (path, lineNo, msg))
+
+
+def parse(path):
+	ruleNames = [name for name, _ in RULES]
+	games = {}  # ID -> [set of sections, {section: message ID}, first comment]
+	section = None
+
+	with open(path, encoding='utf-8') as f:
+		for lineNo, line in enumerate(f, 1):
+			comment = ''
+			if '#' in line:
+				line, comment = line.split('#', 1)
+			line = line.strip()
+			comment = comment.strip()
+			if not line:
+				continue
+
+			if line.startswith('['):
+				section = line.strip('[]')
+				if section not in ruleNames:
+					error(path, lineNo, 'unknown section [%s]' % section)
+				continue
+
+			if section is None:
+				error(path, lineNo, 'game ID outside of a section')
+
+			gameId, _, msgId = line.partition(':')
+			if len(gameId) not in (3, 4):
+				error(path, lineNo, 'game ID "%s" must be 3 or 4 characters' % gameId)
+			if (section in MESSAGE_SHIFT) != (msgId != ''):
+				error(path, lineNo, 'message ID is required in [%s] and only allowed there' % ', '.join(MESSAGE_SHIFT))
+
+			entry = games.setdefault(gameId, [set(), {}, comment])
+			entry[0].add(section)
+			if msgId:
+				if not msgId.isdigit() or int(msgId) > 15:
+					error(path, lineNo, 'message ID must be between 0 and 15')
+				entry[1][section] = int(msgId)
+
+	return games
+
+
+def write(games, path):
+	out = []
+	out.append('// Generated by universal/gamerules/gameRules.py from gameRules.txt.')
+	out.append('// Do not edit this file directly.')
+	out.append('')
+	out.append('#ifndef GAMERULES_H')
+	out.append('#define GAMERULES_H')
+	out.append('')
+	out.append('#include <string.h>')
+	out.append('')
+	for bit, (_, flag) in enumerate(RULES):
+		out.append('#define %s (1 << %d)' % (flag, bit))
+	out.append('')
+	out.append('// RAM limitation message IDs')
+	for section, shift in MESSAGE_SHIFT.items():
+		flag = dict(RULES)[section]
+		out.append('#define %s_MSG(rules) (((rules) >> %d) & 0xF)' % (flag, shift))
+	out.append('')
+	out.append('struct GameRule')
+	out.append('{')
+	out.append('\tchar gameTid[4]; // 3-character IDs are padded with 0, so they sort before their regions')
+	out.append('\tu32 rules;')
+	out.append('};')
+	out.append('')
+	out.append('static const GameRule gameRuleList[] = {')
+
+	for gameId in sorted(games, key=lambda k: k.encode('ascii').ljust(4, b'\0')):
+		sections, msgIds, comment = games[gameId]
+		chars = ', '.join("'%s'" % c for c in gameId)
+		if len(gameId) == 3:
+			chars += ', 0'
+		flags = [flag for name, flag in RULES if name in sections]
+		for section, shift in MESSAGE_SHIFT.items():
+			if msgIds.get(section):
+				flags.append('(%d << %d)' % (msgIds[section], shift))
+		out.append('\t{{%s}, %s}, // %s' % (chars, ' | '.join(flags), comment))
+
+	out.append('};')
+	out.append('')
+	out.append('static inline const GameRule* findGameRule(const char* key)')
+	out.append('{')
+	out.append('\tint low = 0;')
+	out.append('\tint high = (int)(sizeof(gameRuleList)/sizeof(gameRuleList[0])) - 1;')
+	out.append('\twhile (low <= high) {')
+	out.append('\t\tint mid = (low + high) / 2;')
+	out.append('\t\tint cmp = memcmp(gameRuleList[mid].gameTid, key, 4);')
+	out.append('\t\tif (cmp < 0) {')
+	out.append('\t\t\tlow = mid + 1;')
+	out.append('\t\t} else if (cmp > 0) {')
+	out.append('\t\t\thigh = mid - 1;')
+	out.append('\t\t} else {')
+	out.append('\t\t\treturn &gameRuleList[mid];')
+	out.append('\t\t}')
+	out.append('\t}')
+	out.append('\treturn NULL;')
+	out.append('}')
+	out.append('')
+	out.append('/**')
+	out.append(' * Get the compatibility rules for a game.')
+	out.append(' * @param gameTid The game\'s 4-character ID.')
+	out.append(' * @return GAMERULE_* flags from both the 3-character and exact ID entries.')
+	out.append(' */')
+	out.append('static inline u32 getGameRules(const char* gameTid)')
+	out.append('{')
+	out.append('\tconst char prefix[4] = {gameTid[0], gameTid[1], gameTid[2], 0};')
+	out.append('\tu32 rules = 0;')
+	out.append('')
+	out.append('\tconst GameRule* rule = findGameRule(prefix);')
+	out.append('\tif (rule) rules |= rule->rules;')
+	out.append('\trule = findGameRule(gameTid);')
+	out.append('\tif (rule) rules |= rule->rules;')
+	out.append('')
+	out.append('\tif (rules & GAMERULE_AP_NONE) {')
+	out.append('\t\trules &= ~(GAMERULE_AP | GAMERULE_AP_ALT);')
+	out.append('\t}')
+	out.append('\treturn rules;')
+	out.append('}')
+	out.append('')
+	out.append('#endif // GAMERULES_H')
+
+	with open(path, 'w', encoding='utf-8', newline='\n') as f:
+		f.write('\n'.join(out) + '\n')
+
+
+if __name__ == '__main__':
+	here = os.path.dirname(os.path.abspath(__file__))
+	parser = argparse.ArgumentParser(description='Compile the game compatibility rules into a C header.')
+	parser.add_argument('--input', default=os.path.join(here, 'gameRules.txt'), help='rules text file')
+	parser.add_argument('--output', default=os.path.join(here, '..', 'include', 'gameRules.h'), help='header to write')
+	args = parser.parse_args()
+
+	write(parse(args.input), args.output)
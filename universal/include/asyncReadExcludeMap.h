@@ -1,72 +0,0 @@
-#ifndef ASYNCHREADEXCLUDEMAP_H
-#define ASYNCHREADEXCLUDEMAP_H
-
-static const char asyncReadExcludeList[][4] = {
-	"CD6", // 7th Dragon
-	"ADM", // Animal Crossing: Wild World
-	"VAA", // Art Academy
-	"CBB", // Big Bang Mini
-	"CVZ", // Blazer Drive
-	"ABX", // Bomberman Land Touch!
-	"ACB", // Castlevania: Portrait of Ruin
-	"VCW", // Classic Word Games
-	"ADK", // Daikoukai Jidai IV: Rota Nova
-	"YDQ", // Dragon Quest IX: Sentinels of the Starry Skies
-	"DMD", // DSi XL Demo Video Volume 1
-	"DME", // DSi XL Demo Video Volume 2
-	"BJ3", // Etrian Odyssey 3
-	"USK", // Face Training
-	"BGT", // Ghost Trick: Phantom Detective
-	"YEE", // Inazuma Eleven
-	"BEE", // Inazuma Eleven 2: Firestorm
-	"BEB", // Inazuma Eleven 2: Blizzard
-	"BEZ", // Inazuma Eleven 3: Bomb Blast
-	"BE8", // Inazuma Eleven 3: Lightning Bolt
-	"BOE", // Inazuma Eleven 3: Team Ogre Attacks!
-	"YLU", // Last Window: The Secret of Cape West
-	"BSD", // Lufia: Curse of the Sinistrals
-	"AY9", // Mario & Sonic at the Olympic Games
-	"V2G", // Mario vs. Donkey Kong: Mini-Land Mayhem!
-	"YZX", // Rockman ZX Advent/MegaMan ZX Advent
-	"CNS", // Naruto Shippuden: Naruto vs Sasuke
-	"DMP", // NOE Movie Player Volume 1
-	"BKI", // The Legend of Zelda: Spirit Tracks (Keeps AP-fix in effect)
-	"Y7S", // The Legend of Zelda: Spirit Tracks (Demo)
-	"B6F", // LEGO Batman 2: DC Super Heroes
-	"TLJ", // LEGO Friends
-	"BLH", // LEGO Harry Potter: Years 1-4
-	"B83", // LEGO Harry Potter: Years 5-7
-	"BLJ", // LEGO Indiana Jones 2: The Adventure Continues
-	"TCB", // LEGO Legends of Chima: Laval's Journey
-	"TLR", // LEGO The Lord of the Rings
-	"TLM", // LEGO Marvel Super Heroes: Universe in Peril
-	"BVY", // LEGO Ninjago: The Videogame
-	"BZD", // LEGO Pirates of the Caribbean: The Video Game
-	"BL9", // LEGO Star Wars III: The Clone Wars
-	"YL2", // Luminous Arc 2
-	"AWV", // Nervous Brickdown
-	"B2K", // Ni no Kuni: The Jet Black Mage
-	"IRB", // Pokemon Black Version (Keeps AP-fix in effect)
-	"IRA", // Pokemon White Version (Keeps AP-fix in effect)
-	"IRE", // Pokemon Black Version 2 (Keeps AP-fix in effect)
-	"IRD", // Pokemon White Version 2 (Keeps AP-fix in effect)
-	"VPY", // Pokemon Conquest (Keeps AP-fix in effect in DSi mode)
-	"B3R", // Pokemon Ranger: Guardian Signs (Keeps AP-fix in effect)
-	"A5F", // Professor Layton and the Curious Village
-	"Y49", // Professor Layton and the Curious Village (Demo)
-	"YLT", // Professor Layton and the Diabolical/Pandora's Box
-	"Y6Z", // Professor Layton and the Diabolical/Pandora's Box (Demo)
-	"C3J", // Professor Layton and the Unwound/Lost Future
-	"BLF", // Professor Layton and the Last Specter/Spectre's Call
-	"Y9B", // Professor Layton and the Last Specter/Spectre's Call (Demo)
-	"TDV", // Shin Megami Tensei: Devil Survivor 2
-	"BMT", // Shin Megami Tensei: Strange Journey
-	"YSL", // Sands of Destruction
-	"CS3", // Sonic & Sega All-Stars Racing
-	"VSO", // Sonic Classic Collection
-	"AFZ", // Transformers: Autobots
-	"AFY", // Transformers: Decepticons
-	"AYG", // Yu-Gi-Oh! Nightmare Trabadour
-};
-
-#endif // ASYNCHREADEXCLUDEMAP_H
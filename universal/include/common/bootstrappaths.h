@@ -16,8 +16,6 @@
 #define DSIMENUPP_INI_FC "fat:/_nds/TWiLightMenu/settings.ini"
 #define DSIMENUPP_SETTINGS_SRL "/_nds/TWiLightMenu/main.srldr"
 
-#define PERGAMESETTINGS_PATH "/_nds/TWiLightMenu/gamesettings/%s.ini"
-
 #define SLOT1_SRL "/_nds/TWiLightMenu/slot1launch.srldr"
 
 #define GBARUNNER2_INI "/_gba/gbarunner2.ini"
@@ -0,0 +1,26 @@
+#pragma once
+#ifndef _CHEATINDEX_H_
+#define _CHEATINDEX_H_
+
+#include <nds/ndstypes.h>
+#include <stdio.h>
+
+/**
+ * Find a game's cheats in usrcheat.dat.
+ *
+ * usrcheat.dat's own index is unsorted, so the first time a .dat is used a
+ * sorted copy of it is made in _nds/TWiLightMenu/cache, bucketed by the top
+ * byte of the CRC. Each lookup after is then a read of the header and a read
+ * of one bucket. The copy is made again whenever the .dat's size, first
+ * cluster or modification time changes.
+ *
+ * @param dat usrcheat.dat, already checked to be one.
+ * @param gameCode The game code, as in the ROM's header.
+ * @param crc32 The .dat's CRC of the ROM's header, as CheatCodelist::romData() gives.
+ * @param offset Set to where the game's cheats are in the .dat.
+ * @param size Set to their size.
+ * @return true if the game was found.
+ */
+bool cheatIndexFind(FILE *dat, u32 gameCode, u32 crc32, u32 &offset, u32 &size);
+
+#endif // _CHEATINDEX_H_
@@ -0,0 +1,32 @@
+#pragma once
+#ifndef _COLORCONVERT_H_
+#define _COLORCONVERT_H_
+
+#include <nds/ndstypes.h>
+
+// Flags for rgbaToBgr555()
+#define COLORCONVERT_GRAYSCALE	BIT(0)	// Desaturate, the same way as convertVramColorToGrayscale()
+#define COLORCONVERT_ALPHA	BIT(1)	// Blend onto black by alpha, and leave fully transparent pixels as 0
+#define COLORCONVERT_SWAP_RB	BIT(2)	// Source is in B, G, R order, as in BMP files
+
+/**
+ * Convert 8-bit RGB(A) pixels, as decoded by lodepng, to BGR555.
+ *
+ * If dst2 is given, two frames are written for color debanding: on
+ * alternating pixels, each channel is lowered by 4 in one of the two
+ * frames, so that flipping between them each frame shows the in-between
+ * shades. The pattern is a checkerboard for even widths, the same one the
+ * menus have always used.
+ *
+ * @param dst First frame.
+ * @param dst2 Second frame for debanding, or NULL for no debanding.
+ * @param dstStride Distance between rows in dst and dst2, in pixels. May be negative for bottom-up images.
+ * @param src Source pixels, rows packed with no padding.
+ * @param width Width of the image, in pixels.
+ * @param height Height of the image, in pixels.
+ * @param bytesPerPixel 3 or 4.
+ * @param flags COLORCONVERT_* flags.
+ */
+void rgbaToBgr555(u16 *dst, u16 *dst2, int dstStride, const u8 *src, u32 width, u32 height, u32 bytesPerPixel, u32 flags);
+
+#endif // _COLORCONVERT_H_
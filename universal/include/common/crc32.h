@@ -0,0 +1,28 @@
+#pragma once
+#ifndef _CRC32_H_
+#define _CRC32_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Continue a CRC-32 (the AUTODIN II polynomial, as used by zlib) over
+ * size more bytes, without the inversion at either end. Start from
+ * 0xFFFFFFFF.
+ */
+uint32_t crc32Update(uint32_t crc, const void *buf, size_t size);
+
+/**
+ * @return The CRC-32 of size bytes at buf.
+ */
+uint32_t crc32(const char *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CRC32_H_
@@ -0,0 +1,76 @@
+#pragma once
+#ifndef _DIRECTORYMODEL_H_
+#define _DIRECTORYMODEL_H_
+
+#include <nds/ndstypes.h>
+#include <memory>
+#include <vector>
+
+/**
+ * A directory's listing, as the file browsers show it.
+ *
+ * Names are stored one after another in 16KB chunks, which are added as the
+ * directory is read and never moved. Each entry only holds where its name
+ * starts, two flags, and keys for sorting. A listing of thousands of files
+ * takes little more memory than its names, and sorting it only moves 16-byte
+ * entries.
+ *
+ * The keys are the first 4 characters of the name and of its extension,
+ * lowercased, so most comparisons are of two integers, and only names that
+ * start the same are compared further.
+ */
+class DirectoryModel
+{
+public:
+	struct Entry
+	{
+		u32 nameOffset : 30;
+		u32 isDirectory : 1;
+		u32 customPos : 1;	// Placed by position, ahead of everything else
+		int position;
+		u32 nameKey;
+		u32 extensionKey;	// Of the whole name, if it has no '.'
+	};
+
+	void clear(void);
+
+	void add(const char *name, bool isDirectory, int position);
+	void insert(size_t index, const char *name, bool isDirectory, int position);
+	void erase(size_t index);
+
+	/**
+	 * Move an entry to another index, and the ones in between along by one.
+	 */
+	void move(size_t from, size_t to);
+
+	size_t size(void) const { return _entries.size(); }
+
+	const char *name(const Entry &entry) const { return _chunks[entry.nameOffset / CHUNK_SIZE].get() + (entry.nameOffset % CHUNK_SIZE); }
+	const char *name(size_t index) const { return name(_entries[index]); }
+	bool isDirectory(size_t index) const { return _entries[index].isDirectory; }
+
+	/**
+	 * Compare two entries' names, ignoring case, the same as strcasecmp().
+	 */
+	int compareNames(const Entry &lhs, const Entry &rhs) const;
+
+	/**
+	 * Compare the extensions after the last '.' in two entries' names, or the
+	 * whole name if there isn't one, ignoring case.
+	 */
+	int compareExtensions(const Entry &lhs, const Entry &rhs) const;
+
+	std::vector<Entry>::iterator begin(void) { return _entries.begin(); }
+	std::vector<Entry>::iterator end(void) { return _entries.end(); }
+
+private:
+	static const u32 CHUNK_SIZE = 0x4000;
+
+	Entry newEntry(const char *name, bool isDirectory, int position);
+
+	std::vector<std::unique_ptr<char[]>> _chunks;
+	u32 _chunkUsed = CHUNK_SIZE;
+	std::vector<Entry> _entries;
+};
+
+#endif // _DIRECTORYMODEL_H_
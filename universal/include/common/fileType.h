@@ -0,0 +1,51 @@
+#pragma once
+#ifndef _FILETYPE_H_
+#define _FILETYPE_H_
+
+#include <nds/ndstypes.h>
+#include <string_view>
+#include <vector>
+
+/**
+ * How the menus show a file, going by its extension.
+ */
+struct FileType
+{
+	s8 romType;	// The bnrRomType, which picks the icon and the emulator it's launched with
+	s8 boxArtType;	// The box art's size, or -1 for none
+};
+
+/**
+ * @return The extension after the last '.', lowercased and packed into a u32,
+ *         or 0 if there's no extension, or it's longer than 4 characters.
+ */
+u32 fileExtensionKey(const char *name);
+
+/**
+ * @return The type of the file, from a table made at compile time, or that of
+ *         an unknown file (romType 9, boxArtType -1).
+ */
+const FileType &fileTypeOf(const char *name);
+
+/**
+ * A list of extensions, such as the file browsers show, that each name is
+ * matched against with one lookup instead of comparing it with each one.
+ */
+class FileExtensionSet
+{
+public:
+	FileExtensionSet(const std::vector<std::string_view> &extensions);
+
+	bool empty(void) const { return _keys.empty() && _longExtensions.empty(); }
+
+	/**
+	 * @return Whether the name ends with one of the extensions.
+	 */
+	bool matches(const char *name) const;
+
+private:
+	std::vector<u32> _keys;	// Sorted
+	std::vector<std::string_view> _longExtensions;	// Those too long to have a key
+};
+
+#endif // _FILETYPE_H_
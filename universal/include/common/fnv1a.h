@@ -0,0 +1,32 @@
+#pragma once
+#ifndef _FNV1A_H_
+#define _FNV1A_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 32-bit FNV-1a, used to key on-disk caches by file name or path.
+
+#define FNV1A_OFFSET_BASIS 0x811C9DC5
+#define FNV1A_PRIME 0x01000193
+
+static inline uint32_t fnv1aHash(const void *data, size_t len, uint32_t hash = FNV1A_OFFSET_BASIS)
+{
+	const uint8_t *bytes = (const uint8_t *)data;
+	for (size_t i = 0; i < len; i++) {
+		hash ^= bytes[i];
+		hash *= FNV1A_PRIME;
+	}
+	return hash;
+}
+
+static inline uint32_t fnv1aHash(const char *str, uint32_t hash = FNV1A_OFFSET_BASIS)
+{
+	for (; *str; str++) {
+		hash ^= (uint8_t)*str;
+		hash *= FNV1A_PRIME;
+	}
+	return hash;
+}
+
+#endif // _FNV1A_H_
@@ -0,0 +1,71 @@
+#pragma once
+#ifndef _INISNAPSHOT_H_
+#define _INISNAPSHOT_H_
+
+#include <nds/ndstypes.h>
+#include <string>
+#include <vector>
+
+class CIniFile;
+
+/**
+ * Stands in for a CIniFile that's only read from, for the settings every
+ * module loads again as it boots.
+ *
+ * Each item read is kept, as it is in the .ini, in a snapshot in
+ * _nds/TWiLightMenu/cache. While the .ini's size, first cluster and
+ * modification time still match, the next module to boot reads its items
+ * from the snapshot with one fread, instead of parsing the .ini again.
+ * Items not in the snapshot are read from the .ini, and added to it.
+ */
+class IniSnapshot
+{
+public:
+	/**
+	 * @param name The snapshot's name in the cache, without its extension.
+	 */
+	IniSnapshot(const char *iniPath, const char *name);
+	~IniSnapshot();
+
+	std::string GetString(const std::string &Section, const std::string &Item, const std::string &DefaultValue);
+	int GetInt(const std::string &Section, const std::string &Item, int DefaultValue);
+
+	/**
+	 * Write the snapshot back, if anything had to be read from the .ini.
+	 */
+	void SaveSnapshot(void);
+
+	/**
+	 * @return Whether any item read so far had to be read from the .ini.
+	 */
+	bool ReadFromIni(void) const { return _ini != NULL; }
+
+private:
+	// An item read from the .ini, not yet in the snapshot
+	struct NewItem
+	{
+		u32 hash;
+		bool found;
+		std::string key;
+		std::string value;
+	};
+
+	/**
+	 * @return The item's value, or NULL if it isn't in the .ini.
+	 */
+	const char *find(const std::string &Section, const std::string &Item);
+
+	std::string _iniPath;
+	std::string _snapshotPath;
+	bool _iniFound;
+	u32 _iniSize;
+	u32 _iniCluster;
+	u32 _iniModified;
+
+	u8 *_snapshot;	// The whole snapshot, as read, or NULL
+	u32 _count;
+	CIniFile *_ini;	// Only opened for an item not in the snapshot
+	std::vector<NewItem> _newItems;
+};
+
+#endif // _INISNAPSHOT_H_
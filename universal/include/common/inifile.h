@@ -24,6 +24,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 extern bool gbar2Fix;
 
@@ -43,6 +44,8 @@ class CIniFile
     void SetString(const std::string& Section,const std::string& Item,const std::string& Value);
     int GetInt(const std::string& Section,const std::string& Item,int DefaultValue);
     void SetInt(const std::string& Section,const std::string& Item,int Value);
+    // Get an item's value as it is in the file, or return false if it isn't there
+    bool GetFileValue(const std::string& Section,const std::string& Item,std::string& Value);
     void GetStringVector(const std::string& Section,const std::string& Item,std::vector<std::string>& strings,char delimiter=',');
     void SetStringVector(const std::string& Section,const std::string& Item,std::vector<std::string>& strings,char delimiter=',');
   protected:
@@ -52,8 +55,18 @@ class CIniFile
     bool m_bLastResult;
     bool m_bModified;
     bool m_bReadOnly;
-    typedef std::map<std::string,size_t> SectionCache;
+    struct SectionInfo
+    {
+      size_t header; // line of the "[Section]" header
+      size_t end;    // one past the last line belonging to the section
+    };
+    typedef std::unordered_map<std::string,SectionInfo> SectionCache;
+    typedef std::unordered_map<std::string,size_t> ItemCache;
     SectionCache m_Cache;
+    ItemCache m_Items; // keyed by ItemKey(Section,Item)
+
+    static std::string ItemKey(const std::string& Section,const std::string& Item);
+    void BuildIndex(void);
 
     bool InsertLine(size_t line,const std::string& str);
     bool ReplaceLine(size_t line,const std::string& str);
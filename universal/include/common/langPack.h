@@ -0,0 +1,38 @@
+#pragma once
+#ifndef _LANGPACK_H_
+#define _LANGPACK_H_
+
+#include <nds/ndstypes.h>
+#include <stddef.h>
+
+/**
+ * A module's strings for one language, precompiled from its language.ini by
+ * universal/langpack/langPack.py into a language.bin beside it.
+ *
+ * The whole pack is read with one fread into one allocation, and each string
+ * is already as getString() would give it, so langInit() has no INI to parse
+ * and no escapes to replace.
+ */
+class LangPack
+{
+public:
+	LangPack() : _data(NULL) {}
+	~LangPack();
+
+	/**
+	 * @param idsHash FNV-1a of each name in language.inl followed by '\n', in order.
+	 * @param count How many names there are.
+	 * @return false if the pack is missing, damaged, or built from another language.inl.
+	 */
+	bool load(const char *path, u32 idsHash, u32 count);
+
+	/**
+	 * @param id The string's position in language.inl.
+	 */
+	const char *get(u32 id) const;
+
+private:
+	u8 *_data;
+};
+
+#endif // _LANGPACK_H_
@@ -0,0 +1,74 @@
+#pragma once
+#ifndef _PLAYSTATS_H_
+#define _PLAYSTATS_H_
+
+#include <nds/ndstypes.h>
+#include <string>
+#include <vector>
+
+/**
+ * When each file in a directory was last played and how many times, for the
+ * "Recent" and "Most played" sort methods.
+ *
+ * Each directory's stats are a hash table of the file names in a file of its
+ * own in _nds/TWiLightMenu/extras/playstats, read in one go when the
+ * directory is opened, so a file's stats are found without searching. A play
+ * only writes the file's record and the header back, unless the table has to
+ * grow.
+ *
+ * The first time the folder is made, recentlyplayed.ini and timesplayed.ini
+ * in _nds/TWiLightMenu/extras are copied into it. They're left where they
+ * are, but not read or written again.
+ */
+class PlayStats
+{
+public:
+	PlayStats();
+
+	/**
+	 * Read a directory's stats, if it isn't the one already open.
+	 * @param dirPath Full path of the directory, as getcwd() gives.
+	 */
+	void openDir(const char *dirPath);
+
+	/**
+	 * @return How many plays in the directory ago the file was last played,
+	 *         0 for the last one, or -1 if it's never been played.
+	 */
+	int recentRank(const char *name) const;
+
+	int timesPlayed(const char *name) const;
+
+	/**
+	 * Count a play of a file in the directory that's open, and write it back.
+	 */
+	void addPlay(const char *name);
+
+	struct Header
+	{
+		char magic[4];
+		u32 dirHash2;	// A second hash of the directory's path, so two directories are never taken for one
+		u32 clock;		// Counted up by each play
+		u32 count;
+		u32 capacity;	// A power of 2
+		u32 reserved[3];
+	};
+
+	struct Record
+	{
+		u32 nameHash;
+		u32 nameHash2;	// Never 0, which marks an empty slot
+		u32 lastPlayed;	// The clock at the last play, or 0 if it's not among those played recently
+		u32 timesPlayed;
+	};
+
+private:
+	const Record *find(const char *name) const;
+
+	std::string _dirPath;
+	std::string _statsPath;
+	Header _header;
+	std::vector<Record> _records;
+};
+
+#endif // _PLAYSTATS_H_
@@ -0,0 +1,80 @@
+#pragma once
+#ifndef _TASKSCHEDULER_H_
+#define _TASKSCHEDULER_H_
+
+#include <nds/ndstypes.h>
+#include <deque>
+#include <functional>
+
+/**
+ * Cooperative scheduler for work that doesn't have to be done right away,
+ * run a step at a time for no longer than it's given each time.
+ *
+ * A task returns true once it's done, or false to be resumed where it left
+ * off the next time. Tasks run highest priority first, and in the order they
+ * were added within a priority. Tasks added under a token can all be dropped
+ * at once, such as those for a page the user has left.
+ *
+ * Time is read from the clock the scheduler is made with, so the same code
+ * can be run on a host with a simulated one.
+ */
+class TaskScheduler
+{
+public:
+	enum Priority
+	{
+		PRIORITY_HIGH = 0,
+		PRIORITY_NORMAL,
+		PRIORITY_LOW,
+		PRIORITY_COUNT
+	};
+
+	typedef std::function<bool(void)> Task;
+
+	/**
+	 * Returns the time in ticks, wrapping around at 2^32.
+	 */
+	typedef u32 (*Clock)(void);
+
+	TaskScheduler(Clock clock);
+
+	/**
+	 * @return A token no other tasks have been added under.
+	 */
+	u32 newToken(void);
+
+	/**
+	 * @param token 0 if the task is never cancelled.
+	 */
+	void add(const Task &task, Priority priority, u32 token = 0);
+
+	/**
+	 * Drop all tasks added under a token. One that's running is dropped
+	 * once its step returns.
+	 */
+	void cancel(u32 token);
+
+	/**
+	 * Run tasks until there are none left, or budget ticks have passed.
+	 * Steps aren't interrupted, so the last one may run over.
+	 * @return Whether any tasks are left.
+	 */
+	bool run(u32 budget);
+
+	bool empty(void) const;
+
+private:
+	struct QueuedTask
+	{
+		Task task;
+		u32 token;
+	};
+
+	Clock _clock;
+	std::deque<QueuedTask> _queues[PRIORITY_COUNT];
+	u32 _lastToken;
+	u32 _runningToken;	// 0 if no task is running
+	bool _runningCancelled;
+};
+
+#endif // _TASKSCHEDULER_H_
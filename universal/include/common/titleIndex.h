@@ -0,0 +1,128 @@
+#pragma once
+#ifndef _TITLEINDEX_H_
+#define _TITLEINDEX_H_
+
+#include "common/singleton.h"
+#include <nds/ndstypes.h>
+#include <string>
+#include <vector>
+
+class DirectoryModel;
+
+// Most files an index is kept for, as entries are numbered with a u16
+#define TITLE_INDEX_MAX_ENTRIES 0xFFFF
+
+/**
+ * Search index of a directory's file names and the banner titles the menus
+ * have read, so files can be found by name or title without opening a ROM.
+ *
+ * Each directory's index is a file of its own in
+ * _nds/TWiLightMenu/cache/titleindex, beside the ROM info cache. It holds the
+ * text of each entry, normalized to lowercase with accents dropped from Latin
+ * letters and punctuation as spaces, the entries containing each trigram of
+ * that text, and where each word of it starts, sorted, for queries too short
+ * to have a trigram.
+ *
+ * Files that have been added, removed or given titles since are only taken
+ * in as they're seen. The trigrams and words are only rebuilt by the next
+ * search after that, and are written back with the rest by flush().
+ */
+class TitleIndex
+{
+public:
+	TitleIndex();
+
+	/**
+	 * Read a directory's index, if it isn't the one already open, flushing
+	 * the previous one.
+	 * @param dirPath Full path of the directory, as getcwd() gives.
+	 */
+	void openDir(const char *dirPath);
+
+	/**
+	 * Add the files in a listing that aren't indexed, and drop those no
+	 * longer in it. search() gives results as indices in this listing.
+	 */
+	void sync(const DirectoryModel &dirContents);
+
+	/**
+	 * Index a file's banner titles along with its name.
+	 * @param titles The banner's titles, in each of count languages.
+	 */
+	void setTitles(const char *name, const u16 (*titles)[128], int count);
+
+	/**
+	 * Write the index back, if anything has changed.
+	 */
+	void flush(void);
+
+	/**
+	 * Find the files whose name or a title contains the query, ignoring case,
+	 * accents and punctuation. A query of 1 or 2 characters only matches the start of
+	 * a word.
+	 * @param results Set to the indices of the files in the listing given to
+	 *                sync(), in order, at most maxResults of them.
+	 * @return How many files match in all.
+	 */
+	size_t search(const char *query, std::vector<int> &results, size_t maxResults);
+
+	struct Header
+	{
+		char magic[4];
+		u32 dirHash2;	// A second hash of the directory's path, so two directories are never taken for one
+		u32 count;
+		u32 textSize;
+		u32 trigramCount;
+		u32 postingCount;
+		u32 wordCount;
+		u32 reserved;
+	};
+
+	struct Entry
+	{
+		u32 nameHash;	// Entries are sorted by this
+		u32 textOffset;
+		u16 textLength;
+		u16 hasTitles;
+	};
+
+	struct Trigram
+	{
+		u32 key;	// The 3 characters, the first in the top byte
+		u32 firstPosting;
+	};
+
+private:
+	int find(u32 nameHash) const;
+	void addEntry(u32 nameHash, const std::string &text, bool hasTitles, int position);
+	void sortEntries(void);
+	bool loadPostings(void);
+	bool entriesValid(void) const;	// Whether what was read from the file can be used as it is
+	bool postingsValid(void) const;
+	void compactText(void);
+	void rebuild(void);
+	u32 entryAt(u32 textOffset) const;
+	void clear(void);
+
+	std::string _dirPath;
+	std::string _indexPath;
+	Header _header;	// As read or last written
+
+	std::vector<Entry> _entries;
+	std::vector<int> _positions;	// Each entry's index in the listing, or -1
+	std::vector<char> _text;
+
+	// Only read or built once there's a search
+	std::vector<Trigram> _trigrams;
+	std::vector<u16> _postings;	// For each trigram, the entries with it, in order
+	std::vector<u32> _words;	// Offsets of word starts in _text, in order of the words
+	bool _postingsReady;
+
+	bool _changed;	// Since the index was read or last written
+};
+
+typedef singleton<TitleIndex> titleIndex_s;
+
+inline TitleIndex &titleIndex() { return titleIndex_s::instance(); }
+
+#endif // _TITLEINDEX_H_
@@ -1,17 +0,0 @@
-#ifndef DMAEXCLUDEMAP_H
-#define DMAEXCLUDEMAP_H
-
-static const char cardReadDMAExcludeList[][4] = {
-	"TAM", // The Amazing Spider-Man
-	"CBX", // Black Sigil: Blade of the Exiled
-	"AWD", // Diddy Kong Racing
-	"BO5", // Golden Sun: Dark Dawn
-	"Y8L", // Golden Sun: Dark Dawn (Demo)
-	"AJS", // Jump! Super Stars
-	"AJU", // Jump! Ultimate Stars
-	"B8I", // Spider-Man: Edge of Time
-	"CTX", // Tropix
-	"CP3", // Viva Pinata
-};
-
-#endif // DMAEXCLUDEMAP_H
@@ -0,0 +1,637 @@
+// Generated by universal/gamerules/gameRules.py from gameRules.txt.
+// Do not edit this file directly.
+
+#ifndef GAMERULES_H
+#define GAMERULES_H
+
+#include <string.h>
+
+#define GAMERULE_AP_NONE (1 << 0)
+#define GAMERULE_AP (1 << 1)
+#define GAMERULE_AP_ALT (1 << 2)
+#define GAMERULE_INCOMPATIBLE_B4DS (1 << 3)
+#define GAMERULE_INCOMPATIBLE_FC (1 << 4)
+#define GAMERULE_INCOMPATIBLE (1 << 5)
+#define GAMERULE_INCOMPATIBLE_MEMORYPIT (1 << 6)
+#define GAMERULE_NO_ASYNC_READ (1 << 7)
+#define GAMERULE_NO_CARD_DMA (1 << 8)
+#define GAMERULE_NO_TWL_CLOCK (1 << 9)
+#define GAMERULE_DSIWARE_B4DS (1 << 10)
+#define GAMERULE_DSIWARE_B4DS_DEBUG (1 << 11)
+#define GAMERULE_RAM_LIMITED_B4DS (1 << 12)
+#define GAMERULE_RAM_LIMITED_B4DS_DEBUG (1 << 13)
+#define GAMERULE_RAM_LIMITED_ALL (1 << 14)
+
+// RAM limitation message IDs
+#define GAMERULE_RAM_LIMITED_B4DS_MSG(rules) (((rules) >> 16) & 0xF)
+#define GAMERULE_RAM_LIMITED_B4DS_DEBUG_MSG(rules) (((rules) >> 20) & 0xF)
+#define GAMERULE_RAM_LIMITED_ALL_MSG(rules) (((rules) >> 24) & 0xF)
+
+struct GameRule
+{
+	char gameTid[4]; // 3-character IDs are padded with 0, so they sort before their regions
+	u32 rules;
+};
+
+static const GameRule gameRuleList[] = {
+	{{'A', '3', 'P', 'J'}, GAMERULE_AP}, // Anpanman to Touch de Waku Waku Training (Japan)
+	{{'A', '3', 'Y', 'K'}, GAMERULE_AP}, // Sonic Rush Adventure (Korea)
+	{{'A', '5', 'F', 0}, GAMERULE_NO_ASYNC_READ}, // Professor Layton and the Curious Village
+	{{'A', 'B', 'X', 0}, GAMERULE_NO_ASYNC_READ}, // Bomberman Land Touch!
+	{{'A', 'C', 'B', 0}, GAMERULE_NO_ASYNC_READ}, // Castlevania: Portrait of Ruin
+	{{'A', 'D', 'K', 0}, GAMERULE_NO_ASYNC_READ}, // Daikoukai Jidai IV: Rota Nova
+	{{'A', 'D', 'M', 0}, GAMERULE_INCOMPATIBLE_B4DS | GAMERULE_NO_ASYNC_READ}, // Animal Crossing: Wild World
+	{{'A', 'E', 'Y', 'K'}, GAMERULE_AP}, // TOEIC Test DS Training (Korea)
+	{{'A', 'F', 'Y', 0}, GAMERULE_NO_ASYNC_READ}, // Transformers: Decepticons
+	{{'A', 'F', 'Z', 0}, GAMERULE_NO_ASYNC_READ}, // Transformers: Autobots
+	{{'A', 'H', '9', 0}, GAMERULE_INCOMPATIBLE_B4DS}, // Tony Hawk's American Sk8land
+	{{'A', 'J', 'S', 0}, GAMERULE_NO_CARD_DMA}, // Jump! Super Stars
+	{{'A', 'J', 'U', 0}, GAMERULE_NO_CARD_DMA}, // Jump! Ultimate Stars
+	{{'A', 'K', '4', 0}, GAMERULE_INCOMPATIBLE_B4DS}, // Kabu Trader Shun
+	{{'A', 'M', 'M', 0}, GAMERULE_INCOMPATIBLE_B4DS}, // Minna no Mahjong DS
+	{{'A', 'N', '6', 0}, GAMERULE_NO_TWL_CLOCK}, // Rune Factory 2: A Fantasy Harvest Moon
+	{{'A', 'N', 'M', 'K'}, GAMERULE_AP}, // Maeilmaeil Deoukdeo!: DS Dunoe Training (Korea)
+	{{'A', 'Q', 'C', 0}, GAMERULE_INCOMPATIBLE_B4DS}, // Crayon Shin-chan DS - Arashi o Yobu Nutte Crayoon Daisakusen!
+	{{'A', 'R', 'F', 0}, GAMERULE_NO_TWL_CLOCK}, // Rune Factory: A Fantasy Harvest Moon
+	{{'A', 'R', 'F', 'K'}, GAMERULE_AP}, // Rune Factory: Sinmokjjangiyagi (Korea)
+	{{'A', 'R', 'M', 0}, GAMERULE_INCOMPATIBLE_B4DS}, // Mario & Luigi: Partners in Time
+	{{'A', 'R', 'Z', 0}, GAMERULE_INCOMPATIBLE_B4DS}, // Rockman ZX/MegaMan ZX
+	{{'A', 'S', 'C', 0}, GAMERULE_NO_TWL_CLOCK}, // Sonic Rush
+	{{'A', 'W', 'D', 0}, GAMERULE_INCOMPATIBLE_B4DS | GAMERULE_NO_CARD_DMA}, // Diddy Kong Racing
+	{{'A', 'W', 'I', 'K'}, GAMERULE_AP}, // Hotel Duskui Bimil (Korea)
+	{{'A', 'W', 'V', 0}, GAMERULE_NO_ASYNC_READ}, // Nervous Brickdown
+	{{'A', 'Y', '9', 0}, GAMERULE_NO_ASYNC_READ | GAMERULE_NO_TWL_CLOCK}, // Mario & Sonic at the Olympic Games
+	{{'A', 'Y', 'G', 0}, GAMERULE_NO_ASYNC_READ}, // Yu-Gi-Oh! Nightmare Trabadour
+	{{'A', 'Z', 'L', 0}, GAMERULE_AP}, // Style Savvy
+	{{'A', 'Z', 'L', 'J'}, GAMERULE_AP_NONE}, // Girls Mode (JAP version of Style Savvy)
+	{{'B', '2', '2', 'J'}, GAMERULE_AP}, // Strike Witches 2: Iyasu, Naosu, Punipuni Suru (Japan)
+	{{'B', '2', 'A', 'K'}, GAMERULE_AP}, // Aranuri: Badachingudeulkkwa hamkke Mandeuneun Sesang (Korea)
+	{{'B', '2', 'B', 0}, GAMERULE_AP}, // Captain Tsubasa
+	{{'B', '2', 'J', 'J'}, GAMERULE_AP}, // Dragon Quest Monsters: Joker 2: Professional (Japan)
+	{{'B', '2', 'K', 0}, GAMERULE_NO_ASYNC_READ}, // Ni no Kuni: The Jet Black Mage
+	{{'B', '2', 'K', 'J'}, GAMERULE_AP}, // Ni no Kuni: Shikkoku no Madoushi (Japan)
+	{{'B', '2', 'O', 'K'}, GAMERULE_AP}, // Jeongukmin Model Audition Superstar DS (Korea)
+	{{'B', '2', 'Q', 'J'}, GAMERULE_AP}, // Sloane to MacHale no Nazo no Story 2 (Japan)
+	{{'B', '2', 'U', 0}, GAMERULE_AP}, // Sports Collection
+	{{'B', '2', 'W', 'J'}, GAMERULE_AP}, // Moe Moe 2-ji Taisen(ryaku) Two: Yamato Nadeshiko (Japan)
+	{{'B', '2', 'Y', 'K'}, GAMERULE_AP}, // Ppiyodamari DS (Korea)
+	{{'B', '3', '5', 'J'}, GAMERULE_AP}, // Rekishi Simulation Game: Sangokushi DS 3 (Japan)
+	{{'B', '3', 'C', 'J'}, GAMERULE_AP}, // Cooking Mama 3 (Japan)
+	{{'B', '3', 'D', 'J'}, GAMERULE_AP}, // Taiko no Tatsujin DS: Dororon! Yookai Daikessen!! (Japan)
+	{{'B', '3', 'G', 'J'}, GAMERULE_AP}, // SD Gundam Sangoku Den: Brave Battle Warriors: Shin Militia Taisen (Japan)
+	{{'B', '3', 'I', 'J'}, GAMERULE_AP}, // Motto! Stitch! DS: Rhythm de Rakugaki Daisakusen (Japan)
+	{{'B', '3', 'L', 'J'}, GAMERULE_AP}, // Eigo de Tabisuru: Little Charo (Japan)
+	{{'B', '3', 'R', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Pokemon Ranger: Guardian Signs
+	{{'B', '3', 'U', 0}, GAMERULE_AP}, // Petz: Nursery 2
+	{{'B', '3', 'V', 0}, GAMERULE_AP}, // Vampire Moon: The Mystery of the Hidden Sun
+	{{'B', '3', 'X', 0}, GAMERULE_AP}, // River City: Soccer Hooligans
+	{{'B', '4', '2', 'J'}, GAMERULE_AP}, // Pet Shop Monogatari DS 2 (Japan)
+	{{'B', '4', 'F', 'J'}, GAMERULE_AP}, // Fushigi no Dungeon: Fuurai no Shiren 4: Kami no Hitomi to Akuma no Heso (Japan)
+	{{'B', '4', 'N', 'K'}, GAMERULE_AP}, // Princess Angel: Baeguiui Cheonsa (Korea)
+	{{'B', '4', 'T', 0}, GAMERULE_AP}, // Tetris Party Deluxe
+	{{'B', '5', '9', 'J'}, GAMERULE_AP}, // Sakusaku Jinkou Kokyuu Care Training DS (Japan)
+	{{'B', '5', 'D', 'J'}, GAMERULE_AP}, // Yamanote-sen Meimei 100 Shuunen Kinen: Densha de Go!: Tokubetsu Hen: Fukkatsu! Shouwa no Yamanote-sen (Japan)
+	{{'B', '5', 'F', 'J'}, GAMERULE_AP}, // Fushigi no Dungeon: Fuurai no Shiren 5: Fortune Tower to Unmei no Dice (Japan)
+	{{'B', '5', 'G', 'J'}, GAMERULE_AP}, // Shin Sengoku Tenka Touitsu: Gunyuu-tachi no Souran (Japan)
+	{{'B', '5', 'K', 'J'}, GAMERULE_AP}, // Tenkaichi: Sengoku Lovers DS (Japan)
+	{{'B', '5', 'V', 'E'}, GAMERULE_AP}, // Phineas and Ferb: Across the 2nd Dimension (USA)
+	{{'B', '6', '2', 'J'}, GAMERULE_AP}, // Okaeri! Chibi-Robo!: Happy Rich Oosouji! (Japan)
+	{{'B', '6', 'F', 0}, GAMERULE_NO_ASYNC_READ}, // LEGO Batman 2: DC Super Heroes
+	{{'B', '6', 'K', 'P'}, GAMERULE_AP}, // Tinker Bell + Tinker Bell and the Lost Treasure (Europe)
+	{{'B', '6', 'T', 0}, GAMERULE_AP}, // Tangled
+	{{'B', '6', 'X', 'J'}, GAMERULE_AP}, // Rockman EXE: Operate Shooting Star (Japan)
+	{{'B', '6', 'Z', 0}, GAMERULE_AP | GAMERULE_INCOMPATIBLE_B4DS}, // Mega Man Zero Collection
+	{{'B', '7', '4', 'J'}, GAMERULE_AP}, // Nanashi no Geemu Me (Japan)
+	{{'B', '7', 'F', 0}, GAMERULE_INCOMPATIBLE_B4DS}, // The Magic School Bus: Oceans
+	{{'B', '7', 'H', 0}, GAMERULE_AP}, // Harry Potter and the Deathly Hallows: Part 1
+	{{'B', '7', 'K', 'J'}, GAMERULE_AP}, // Tamagotch no Narikiri Challenge (Japan)
+	{{'B', '7', 'X', 'J'}, GAMERULE_AP}, // Seitokai no Ichizon: DS Suru Seitokai (Japan)
+	{{'B', '8', '3', 0}, GAMERULE_NO_ASYNC_READ}, // LEGO Harry Potter: Years 5-7
+	{{'B', '8', '6', 0}, GAMERULE_AP}, // Jewels of the Ages
+	{{'B', '8', '8', 0}, GAMERULE_DSIWARE_B4DS}, // DS WiFi Settings
+	{{'B', '8', '9', 'J'}, GAMERULE_AP}, // Pro Yakyuu Team o Tsukurou! 2 (Japan)
+	{{'B', '8', 'I', 0}, GAMERULE_NO_CARD_DMA}, // Spider-Man: Edge of Time
+	{{'B', '8', 'R', 'J'}, GAMERULE_AP}, // Kamen Rider Battle: GanbaRide: Card Battle Taisen (Japan)
+	{{'B', 'A', '5', 'K'}, GAMERULE_AP}, // Mario & Luigi RPG: Siganui Partner (Korea)
+	{{'B', 'A', '7', 'J'}, GAMERULE_AP}, // Kaibou Seirigaku DS: Touch de Hirogaru! Jintai no Kouzou to Kinou (Japan)
+	{{'B', 'B', '4', 'J'}, GAMERULE_AP}, // Battle Spirits Digital Starter (Japan)
+	{{'B', 'B', 'J', 'J'}, GAMERULE_AP}, // Metal Fight Beyblade: Baku Shin Susanoo Shuurai! (Japan)
+	{{'B', 'B', 'U', 0}, GAMERULE_AP}, // Beyblade: Metal Fusion
+	{{'B', 'C', 'D', 'K'}, GAMERULE_AP}, // Live-On Card Live-R DS (Korea)
+	{{'B', 'C', 'J', 'K'}, GAMERULE_AP}, // Mabeopcheonjamun DS 2 (Korea)
+	{{'B', 'C', 'K', 'J'}, GAMERULE_AP}, // Kochira Katsushika Ku Kameari Kouen Mae Hashutsujo: Kateba Tengoku! Makereba Jigoku!: Ryoutsu-ryuu Ikkakusenkin Daisakusen! (Japan)
+	{{'B', 'C', 'X', 'J'}, GAMERULE_AP}, // Kodawari Saihai Simulation: Ochanoma Pro Yakyuu DS: 2010 Nendo Ban (Japan)
+	{{'B', 'D', '2', 0}, GAMERULE_AP}, // Deca Sports DS
+	{{'B', 'D', 'B', 0}, GAMERULE_AP}, // Dragon Ball: Origins 2
+	{{'B', 'D', 'E', 0}, GAMERULE_AP}, // Dementium II
+	{{'B', 'D', 'N', 'J'}, GAMERULE_AP}, // Cross Treasures (Japan)
+	{{'B', 'D', 'U', 0}, GAMERULE_AP}, // C.O.P.: The Recruit
+	{{'B', 'D', 'Y', 0}, GAMERULE_AP}, // Call of Duty: Black Ops
+	{{'B', 'E', '8', 0}, GAMERULE_NO_ASYNC_READ}, // Inazuma Eleven 3: Lightning Bolt
+	{{'B', 'E', '8', 'J'}, GAMERULE_AP}, // Inazuma Eleven 3: Sekai e no Chousen!!: Spark (Japan)
+	{{'B', 'E', 'B', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Inazuma Eleven 2: Firestorm
+	{{'B', 'E', 'E', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Inazuma Eleven 2: Blizzard
+	{{'B', 'E', 'K', 'J'}, GAMERULE_AP}, // Kanzen Taiou Saishin Kako Mondai: Nijishiken Taisaku: Eiken Kanzenban (Japan)
+	{{'B', 'E', 'L', 0}, GAMERULE_AP}, // Element Hunters
+	{{'B', 'E', 'T', 'J'}, GAMERULE_AP}, // Nihon Keizai Shinbunsha Kanshuu: Shiranai Mama dewa Son wo Suru: 'Mono ya Okane no Shikumi' DS (Japan)
+	{{'B', 'E', 'Z', 0}, GAMERULE_NO_ASYNC_READ}, // Inazuma Eleven 3: Bomb Blast
+	{{'B', 'E', 'Z', 'J'}, GAMERULE_AP}, // Inazuma Eleven 3: Sekai e no Chousen!!: Bomber (Japan)
+	{{'B', 'F', '2', 'J'}, GAMERULE_AP}, // Pro Yakyuu Famista DS 2010 (Japan)
+	{{'B', 'F', 'L', 0}, GAMERULE_AP}, // MySims: Sky Heroes
+	{{'B', 'F', 'P', 'J'}, GAMERULE_AP}, // Fresh PreCure!: Asobi Collection (Japan)
+	{{'B', 'F', 'X', 0}, GAMERULE_AP}, // Final Fantasy: The 4 Heroes of Light
+	{{'B', 'G', '3', 'J'}, GAMERULE_AP}, // G.G Series Collection+ (Japan)
+	{{'B', 'G', '5', 'J'}, GAMERULE_AP}, // Tamagotch no Pichi Pichi Omisetchi (Japan)
+	{{'B', 'G', 'T', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Ghost Trick: Phantom Detective
+	{{'B', 'G', 'V', 'J'}, GAMERULE_AP}, // Tamagotch no Narikiri Channel (Japan)
+	{{'B', 'H', '2', 0}, GAMERULE_AP}, // Super Scribblenauts
+	{{'B', 'H', '2', 'J'}, GAMERULE_AP_NONE}, // Super Scribblenauts (Japan)
+	{{'B', 'H', '6', 'J'}, GAMERULE_AP}, // TV Anime Fairy Tail: Gekitou! Madoushi Kessen (Japan)
+	{{'B', 'H', 'Q', 'J'}, GAMERULE_AP}, // Otona no Renai Shousetsu: DS Harlequin Selection (Japan)
+	{{'B', 'H', 'X', 'J'}, GAMERULE_AP}, // Quiz! Hexagon II (Japan)
+	{{'B', 'I', 'G', 0}, GAMERULE_AP}, // Battle of Giants: Mutant Insects
+	{{'B', 'I', 'M', 'J'}, GAMERULE_AP}, // Iron Master: The Legendary Blacksmith (Japan)
+	{{'B', 'I', 'P', 'J'}, GAMERULE_AP}, // Pen1 Grand Prix: Penguin no Mondai Special (Japan)
+	{{'B', 'J', '3', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Etrian Odyssey III: The Drowned City
+	{{'B', 'J', '8', 'P'}, GAMERULE_AP}, // Cooking Mama World: Hobbies & Fun (Europe)
+	{{'B', 'J', 'C', 0}, GAMERULE_AP}, // GoldenEye 007
+	{{'B', 'J', 'K', 'J'}, GAMERULE_AP}, // Ippan Zaidan Houjin Nihon Kanji Shuujukudo Kentei Kikou Kounin: Kanjukuken DS (Japan)
+	{{'B', 'K', '9', 0}, GAMERULE_AP}, // Kindgom Hearts: Re-coded
+	{{'B', 'K', 'C', 'E'}, GAMERULE_AP}, // America's Test Kitchen: Let's Get Cooking (USA)
+	{{'B', 'K', 'H', 'J'}, GAMERULE_AP}, // Kamonohashikamo.: Aimai Seikatsu no Susume (Japan)
+	{{'B', 'K', 'I', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // The Legend of Zelda: Spirit Tracks
+	{{'B', 'K', 'J', 'J'}, GAMERULE_AP}, // Nazotte Oboeru: Otona no Kanji Renshuu: Kaiteiban (Japan)
+	{{'B', 'K', 'K', 'J'}, GAMERULE_AP}, // Keroro RPG: Kishi to Musha to Densetsu no Kaizoku (Japan)
+	{{'B', 'K', 'M', 'J'}, GAMERULE_AP}, // Rilakkuma Rhythm: Mattari Kibun de Dararan Ran (Japan)
+	{{'B', 'K', 'P', 'J'}, GAMERULE_AP}, // Kanshuu: Shuukan Pro Wrestling: Pro Wrestling Kentei DS (Japan)
+	{{'B', 'K', 'Q', 0}, GAMERULE_AP}, // Pucca: Power Up
+	{{'B', 'K', 'S', 'J'}, GAMERULE_AP}, // Keshikasu-kun: Battle Kasu-tival (Japan)
+	{{'B', 'K', 'T', 'J'}, GAMERULE_AP}, // Kimi ni Todoke: Sodateru Omoi (Japan)
+	{{'B', 'K', 'U', 0}, GAMERULE_AP}, // Harvest Moon DS: The Tale of Two Towns
+	{{'B', 'K', 'X', 'J'}, GAMERULE_AP}, // Kaijuu Busters (Japan)
+	{{'B', 'L', '3', 'J'}, GAMERULE_AP}, // Lupin Sansei: Shijou Saidai no Zunousen (Japan)
+	{{'B', 'L', '9', 0}, GAMERULE_NO_ASYNC_READ}, // LEGO Star Wars III: The Clone Wars
+	{{'B', 'L', 'E', 'J'}, GAMERULE_AP}, // Digimon Story: Lost Evolution (Japan)
+	{{'B', 'L', 'F', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Professor Layton and the Last Specter
+	{{'B', 'L', 'H', 0}, GAMERULE_NO_ASYNC_READ | GAMERULE_NO_TWL_CLOCK}, // LEGO Harry Potter: Years 1-4
+	{{'B', 'L', 'J', 0}, GAMERULE_NO_ASYNC_READ}, // LEGO Indiana Jones 2: The Adventure Continues
+	{{'B', 'L', 'L', 'E'}, GAMERULE_AP}, // Petz: Catz Playground (USA)
+	{{'B', 'M', '7', 'J'}, GAMERULE_AP}, // Gokujou!! Mecha Mote Iinchou: MM Town de Miracle Change! (Japan)
+	{{'B', 'M', 'T', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Shin Megami Tensei: Strange Journey
+	{{'B', 'N', 'C', 'J'}, GAMERULE_AP}, // Nodame Cantabile: Tanoshii Ongaku no Jikan Desu (Japan)
+	{{'B', 'N', 'Q', 0}, GAMERULE_AP}, // Murder in Venice
+	{{'B', 'N', 'R', 0}, GAMERULE_AP}, // Petz: Nursery
+	{{'B', 'O', '4', 'J'}, GAMERULE_AP}, // Ochaken no Heya DS 4 (Japan)
+	{{'B', 'O', '5', 0}, GAMERULE_AP | GAMERULE_INCOMPATIBLE | GAMERULE_NO_CARD_DMA}, // Golden Sun: Dark Dawn
+	{{'B', 'O', '9', 'J'}, GAMERULE_AP}, // Penguin no Mondai: The World (Japan)
+	{{'B', 'O', 'B', 'J'}, GAMERULE_AP}, // Kaidan Restaurant: Ura Menu 100-sen (Japan)
+	{{'B', 'O', 'E', 0}, GAMERULE_NO_ASYNC_READ}, // Inazuma Eleven 3: Team Ogre Attacks!
+	{{'B', 'O', 'E', 'J'}, GAMERULE_AP}, // Inazuma Eleven 3: Sekai e no Chousen!!: The Ogre (Japan)
+	{{'B', 'O', 'J', 0}, GAMERULE_AP}, // One Piece: Gigant Battle!
+	{{'B', 'O', 'K', 'J'}, GAMERULE_AP}, // Ookami to Koushinryou: Umi o Wataru Kaze (Japan)
+	{{'B', 'O', 'N', 'J'}, GAMERULE_AP}, // Powerful Golf (Japan)
+	{{'B', 'O', 'O', 0}, GAMERULE_AP}, // Ookami Den
+	{{'B', 'O', 'X', 'J'}, GAMERULE_AP}, // Love Plus+ (Japan)
+	{{'B', 'O', 'Y', 'J'}, GAMERULE_AP}, // Odoru Daisousa-sen: The Game: Sensuikan ni Sennyuu Seyo! (Japan)
+	{{'B', 'P', 'O', 'J'}, GAMERULE_AP}, // Utacchi (Japan)
+	{{'B', 'P', 'P', 'J'}, GAMERULE_AP}, // PostPet DS: Yumemiru Momo to Fushigi no Pen (Japan)
+	{{'B', 'P', 'U', 'J'}, GAMERULE_AP}, // Nettou! Powerful Koushien (Japan)
+	{{'B', 'Q', '2', 'J'}, GAMERULE_AP}, // Quiz Magic Academy DS: Futatsu no Jikuuseki (Japan)
+	{{'B', 'Q', '3', 'J'}, GAMERULE_AP}, // Tago Akira no Atama no Taisou: Dai-3-shuu: Fushigi no Kuni no Nazotoki Otogibanashi (Japan)
+	{{'B', 'Q', '4', 'J'}, GAMERULE_AP}, // Tago Akira no Atama no Taisou: Dai-4-shuu: Time Machine no Nazotoki Daibouken (Japan)
+	{{'B', 'Q', '6', 'J'}, GAMERULE_AP}, // Cocoro no Cocoron (Japan)
+	{{'B', 'Q', '8', 0}, GAMERULE_AP}, // Crafting Mama
+	{{'B', 'Q', '9', 'J'}, GAMERULE_AP}, // Tekipaki Kyuukyuu Kyuuhen Training DS (Japan)
+	{{'B', 'Q', 'B', 0}, GAMERULE_INCOMPATIBLE_B4DS}, // Crayon Shin-chan - Obaka Dainin Den - Susume! Kasukabe Ninja Tai!
+	{{'B', 'Q', 'B', 'J'}, GAMERULE_AP}, // Crayon Shin-chan: Obaka Dainin Den: Susume! Kasukabe Ninja Tai! (Japan)
+	{{'B', 'Q', 'F', 'J'}, GAMERULE_AP}, // HeartCatch PreCure!: Oshare Collection (Japan)
+	{{'B', 'Q', 'I', 'J'}, GAMERULE_AP}, // Cookin' Idol I! My! Mine!: Game de Hirameki! Kirameki! Cooking (Japan)
+	{{'B', 'Q', 'J', 'J'}, GAMERULE_AP}, // Kawaii Koneko DS 3 (Japan)
+	{{'B', 'Q', 'N', 0}, GAMERULE_AP}, // Captain America: Super Soldier
+	{{'B', 'Q', 'P', 0}, GAMERULE_AP}, // KuruKuru Princess: Tokimeki Figure
+	{{'B', 'Q', 'U', 'J'}, GAMERULE_AP}, // Minna no Suizokukan (Japan)
+	{{'B', 'Q', 'V', 'J'}, GAMERULE_AP}, // Minna to Kimi no Piramekino! (Japan)
+	{{'B', 'Q', 'W', 'J'}, GAMERULE_AP}, // Medarot DS: Kuwagata Ver. (Japan)
+	{{'B', 'R', 'F', 0}, GAMERULE_NO_TWL_CLOCK}, // Rune Factory 3: A Fantasy Harvest Moon
+	{{'B', 'R', 'G', 'J'}, GAMERULE_AP}, // Ishin no Arashi: Shippuu Ryouma Den (Japan)
+	{{'B', 'R', 'J', 0}, GAMERULE_AP}, // Radiant Hostoria
+	{{'B', 'R', 'M', 0}, GAMERULE_AP}, // Rooms: The Main Building
+	{{'B', 'R', 'O', 'J'}, GAMERULE_AP}, // Super Robot Taisen OG Saga: Masou Kishin: The Lord of Elemental (Japan)
+	{{'B', 'R', 'Q', 'J'}, GAMERULE_AP}, // Gendai Daisenryaku DS: Isshoku Sokuhatsu, Gunji Balance Houkai (Japan)
+	{{'B', 'R', 'W', 'J'}, GAMERULE_AP}, // Super Robot Taisen L (Japan)
+	{{'B', 'R', 'Y', 'J'}, GAMERULE_AP}, // Hudson x GReeeeN: Live! DeeeeS! (Japan)
+	{{'B', 'R', 'Z', 0}, GAMERULE_AP}, // Beyblade: Metal Masters
+	{{'B', 'S', '8', 0}, GAMERULE_AP}, // The Sorcerer's Apprentice
+	{{'B', 'S', 'D', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Lufia: Curse of the Sinistrals
+	{{'B', 'S', 'K', 0}, GAMERULE_AP}, // Nine Hours: Nine Persons: Nine Doors
+	{{'B', 'S', 'W', 'J'}, GAMERULE_AP}, // Saka Tsuku DS: World Challenge 2010 (Japan)
+	{{'B', 'T', '5', 'J'}, GAMERULE_AP}, // TOEIC Test Super Coach@DS (Japan)
+	{{'B', 'T', 'A', 'J'}, GAMERULE_AP}, // Lina no Atelier: Strahl no Renkinjutsushi (Japan)
+	{{'B', 'T', 'G', 'J'}, GAMERULE_AP}, // Tennis no Ouji-sama: Motto Gakuensai no Ouji-sama: More Sweet Edition (Japan)
+	{{'B', 'T', 'U', 0}, GAMERULE_AP}, // Tinker Bell and the Great Fairy Rescue
+	{{'B', 'U', '8', 0}, GAMERULE_AP}, // Harry Potter and the Deathly Hallows: Part 2
+	{{'B', 'U', '9', 'J'}, GAMERULE_AP}, // Pucca: Power Up (Europe)
+	{{'B', 'U', 'C', 'J'}, GAMERULE_AP}, // Crayon Shin-chan: Shock Gahn!: Densetsu o Yobu Omake Daiketsusen!! (Japan)
+	{{'B', 'U', 'F', 'E'}, GAMERULE_AP}, // Petz: Puppyz & Kittenz (USA)
+	{{'B', 'U', 'K', 'J'}, GAMERULE_AP}, // Rekishi Taisen: Gettenka: Tenkaichi Battle Royale (Japan)
+	{{'B', 'U', 'Q', 'J'}, GAMERULE_AP}, // Treasure Report: Kikai Jikake no Isan (Japan)
+	{{'B', 'V', 'G', 'E'}, GAMERULE_AP}, // Petz: Bunnyz Bunch (USA)
+	{{'B', 'V', 'I', 'J'}, GAMERULE_AP}, // Dokonjou Shougakusei Bon Biita: Hadaka no Choujou Ketsusen!!: Biita vs Dokuro Dei! (Japan)
+	{{'B', 'V', 'N', 0}, GAMERULE_AP}, // Michael Jackson: The Experience
+	{{'B', 'V', 'Y', 0}, GAMERULE_NO_ASYNC_READ}, // LEGO Ninjago: The Videogame
+	{{'B', 'W', '4', 0}, GAMERULE_AP}, // Wizards of Waverly Place: Spellbound
+	{{'B', 'W', 'C', 'J'}, GAMERULE_AP}, // Minna no Conveni (Japan)
+	{{'B', 'W', 'R', 'J'}, GAMERULE_AP}, // Momotarou Dentetsu: World (Japan)
+	{{'B', 'W', 'W', 'J'}, GAMERULE_AP}, // WiZmans World (Japan)
+	{{'B', 'W', 'Y', 'J'}, GAMERULE_AP}, // Wizardry: Boukyaku no Isan (Japan)
+	{{'B', 'W', 'Z', 'J'}, GAMERULE_AP}, // Wizardry: Inochi no Kusabi (Japan)
+	{{'B', 'X', 'O', 'J'}, GAMERULE_AP}, // Gyakuten Kenji 2 (Japan)
+	{{'B', 'X', 'P', 'J'}, GAMERULE_AP}, // Winnie the Pooh: Kuma no Puu-san: 100 Acre no Mori no Cooking Book (Japan)
+	{{'B', 'X', 'S', 0}, GAMERULE_AP}, // Sonic Colors
+	{{'B', 'Y', 'M', 'J'}, GAMERULE_AP}, // Yumeiro Patissiere: My Sweets Cooking (Japan)
+	{{'B', 'Y', 'N', 'J'}, GAMERULE_AP}, // Yamakawa Shuppansha Kanshuu: Shousetsu Nihonshi B: Shin Sougou Training Plus (Japan)
+	{{'B', 'Y', 'O', 'J'}, GAMERULE_AP}, // Puyo Puyo 7 (Japan)
+	{{'B', 'Y', 'Q', 'J'}, GAMERULE_AP}, // Suisui Physical Assessment Training DS (Japan)
+	{{'B', 'Y', 'S', 'J'}, GAMERULE_AP}, // Yamakawa Shuppansha Kanshuu: Shousetsu Sekaishi B: Shin Sougou Training Plus (Japan)
+	{{'B', 'Y', 'V', 'J'}, GAMERULE_AP}, // Kaijuu Busters Powered (Japan)
+	{{'B', 'Y', 'X', 0}, GAMERULE_AP}, // Yu-Gi-Oh! 5D's: World Championship 2010: Reverse of Arcadia
+	{{'B', 'Y', 'Y', 0}, GAMERULE_AP}, // Yu-Gi-Oh! 5D's: World Championship 2011: Over the Nexus
+	{{'B', 'Z', '2', 'J'}, GAMERULE_AP}, // Imasugu Tsukaeru Mamechishiki: Quiz Zatsugaku-ou DS (Japan)
+	{{'B', 'Z', '3', 'J'}, GAMERULE_AP}, // SaGa 3: Jikuu no Hasha: Shadow or Light (Japan)
+	{{'B', 'Z', 'B', 'J'}, GAMERULE_AP}, // Zombie Daisuki (Japan)
+	{{'B', 'Z', 'D', 0}, GAMERULE_NO_ASYNC_READ}, // LEGO Pirates of the Caribbean: The Video Game
+	{{'B', 'Z', 'F', 0}, GAMERULE_AP}, // Phineas and Ferb: Across the 2nd Dimension
+	{{'B', 'Z', 'M', 'J'}, GAMERULE_AP}, // Korg M01 Music Workstation (Japan)
+	{{'B', 'Z', 'P', 0}, GAMERULE_NO_TWL_CLOCK}, // Peppa Pig: Theme Park Fun
+	{{'B', 'Z', 'Q', 'J'}, GAMERULE_AP}, // Zac to Ombra: Maboroshi no Yuuenchi (Japan)
+	{{'B', 'Z', 'U', 0}, GAMERULE_AP}, // The Smurfs
+	{{'C', '2', '4', 0}, GAMERULE_AP}, // Phantasy Star 0
+	{{'C', '2', '9', 'J'}, GAMERULE_AP}, // Pro Yakyuu Famista DS 2009 (Japan)
+	{{'C', '2', 'V', 'J'}, GAMERULE_AP}, // Tsukibito (Japan)
+	{{'C', '2', 'Y', 'J'}, GAMERULE_AP}, // Supa Robo Gakuen (Japan) Nazotoki Adventure (Japan)
+	{{'C', '3', '4', 'J'}, GAMERULE_AP}, // Mini Yonku DS (Japan)
+	{{'C', '3', '6', 'J'}, GAMERULE_AP}, // Sloane to MacHale no Nazo no Story (Japan)
+	{{'C', '3', 'J', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Professor Layton and the Unwound Future
+	{{'C', '4', 'W', 'K'}, GAMERULE_AP}, // Princess Bakery (Korea)
+	{{'C', '5', '2', 'J'}, GAMERULE_AP}, // Tago Akira no Atama no Taisou: Dai-2-shuu: Ginga Oudan (Japan)
+	{{'C', '5', 'I', 'J'}, GAMERULE_AP}, // Tago Akira no Atama no Taisou: Dai-1-shuu: Nazotoki Sekai Isshuu Ryokou (Japan)
+	{{'C', '5', 'Y', 'J'}, GAMERULE_AP}, // Chocobo to Mahou no Ehon: Majo to Shoujo to 5-nin no Yuusha (Japan)
+	{{'C', '6', 'C', 0}, GAMERULE_NO_TWL_CLOCK}, // Infinite Space
+	{{'C', '6', 'F', 'J'}, GAMERULE_AP}, // Mugen no Frontier Exceed: Super Robot Taisen OG Saga (Japan)
+	{{'C', '6', 'H', 'K'}, GAMERULE_AP}, // Chuldong! Rescue Force DS (Korea)
+	{{'C', '6', 'O', 'J'}, GAMERULE_AP}, // Medarot DS: Kabuto Ver. (Japan)
+	{{'C', '7', 'U', 0}, GAMERULE_AP}, // Battle of Giants: Dragons
+	{{'C', 'A', '5', 'E'}, GAMERULE_AP}, // Again: Interactive Crime Novel (USA)
+	{{'C', 'A', 'Y', 0}, GAMERULE_INCOMPATIBLE_FC}, // Army Men: Soldiers of Misfortune
+	{{'C', 'B', 'B', 0}, GAMERULE_NO_ASYNC_READ}, // Big Bang Mini
+	{{'C', 'B', 'E', 'J'}, GAMERULE_AP}, // Saibanin Suiri Game: Yuuzai x Muzai (Japan)
+	{{'C', 'B', 'X', 0}, GAMERULE_NO_CARD_DMA}, // Black Sigil: Blade of the Exiled
+	{{'C', 'C', 'T', 'J'}, GAMERULE_AP}, // Cid to Chocobo no Fushigi na Dungeon: Toki Wasure no Meikyuu DS+ (Japan)
+	{{'C', 'C', 'U', 0}, GAMERULE_AP}, // Tomodachi Collection
+	{{'C', 'D', '6', 0}, GAMERULE_NO_ASYNC_READ}, // 7th Dragon
+	{{'C', 'D', 'O', 'K'}, GAMERULE_AP}, // Iron Master: Wanggugui Yusangwa Segaeui Yeolsoe (Korea)
+	{{'C', 'F', 'I', 0}, GAMERULE_AP}, // Final Fantasy Crystal Chronicles: Echoes of Time
+	{{'C', 'H', 'N', 0}, GAMERULE_AP}, // Might & Magic: Clash of Heroes
+	{{'C', 'J', 'R', 0}, GAMERULE_AP}, // Dragon Quest Monsters: Joker 2
+	{{'C', 'K', 'D', 'J'}, GAMERULE_AP}, // Kindaichi Shounen no Jikenbo: Akuma no Satsujin Koukai (Japan)
+	{{'C', 'L', '4', 0}, GAMERULE_INCOMPATIBLE_B4DS}, // Crayon Shin-Chan - Arashi o Yobu Nendororoon Daihenshin!
+	{{'C', 'L', '4', 'K'}, GAMERULE_AP}, // Jjangguneun Monmallyeo: Mallangmallang Gomuchalheuk Daebyeonsin! (Korea)
+	{{'C', 'L', 'J', 0}, GAMERULE_AP | GAMERULE_INCOMPATIBLE_B4DS}, // Mario & Luigi: Bowser's Inside Story
+	{{'C', 'L', 'P', 'D'}, GAMERULE_AP}, // Club Penguin: Elite Penguin Force (Germany)
+	{{'C', 'L', 'W', 0}, GAMERULE_AP}, // Star Wars: The Clone Wars: Jedi Alliance
+	{{'C', 'N', 'S', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Naruto Shippuden: Naruto vs Sasuke
+	{{'C', 'N', 'S', 'X'}, GAMERULE_AP_NONE}, // Naruto Shippuden: Naruto vs Sasuke (Europe)
+	{{'C', 'O', 'L', 0}, GAMERULE_AP | GAMERULE_INCOMPATIBLE_B4DS}, // Mario & Sonic at the Olympic Winter Games
+	{{'C', 'P', '3', 0}, GAMERULE_NO_CARD_DMA}, // Viva Pinata
+	{{'C', 'P', '4', 'K'}, GAMERULE_AP}, // Princess Maker 4: Special Edition (Korea)
+	{{'C', 'Q', '2', 'J'}, GAMERULE_AP}, // Sengoku Spirits: Gunshi Den (Japan)
+	{{'C', 'Q', '3', 'J'}, GAMERULE_AP}, // Sengoku Spirits: Moushou Den (Japan)
+	{{'C', 'Q', 'K', 'P'}, GAMERULE_AP}, // NRL Mascot Mania (Australia)
+	{{'C', 'Q', 'Q', 'P'}, GAMERULE_AP}, // AFL Mascot Manor (Australia)
+	{{'C', 'R', 'L', 0}, GAMERULE_NO_TWL_CLOCK}, // Coraline
+	{{'C', 'S', '3', 0}, GAMERULE_INCOMPATIBLE_B4DS | GAMERULE_NO_ASYNC_READ}, // Sonic & Sega All-Stars Racing
+	{{'C', 'S', '7', 'J'}, GAMERULE_AP}, // Summon Night X: Tears Crown (Japan)
+	{{'C', 'S', 'G', 'J'}, GAMERULE_AP}, // SaGa 2: Hihou Densetsu: Goddess of Destiny (Japan)
+	{{'C', 'T', '5', 'K'}, GAMERULE_AP}, // TOEIC DS: Haru 10-bun Yakjeomgeukbok +200 (Korea)
+	{{'C', 'T', 'X', 0}, GAMERULE_INCOMPATIBLE_B4DS | GAMERULE_NO_CARD_DMA}, // Tropix
+	{{'C', 'U', 'H', 'J'}, GAMERULE_AP}, // Umihara Kawase Shun: Second Edition Kanzen Ban (Japan)
+	{{'C', 'V', 'A', 'J'}, GAMERULE_AP}, // Tokyo Twilight Busters: Kindan no Ikenie Teito Jigokuhen (Japan)
+	{{'C', 'V', 'Z', 0}, GAMERULE_NO_ASYNC_READ}, // Blazer Drive
+	{{'C', 'Y', '8', 0}, GAMERULE_NO_TWL_CLOCK}, // Yu-Gi-Oh! 5D's Stardust Accelerator: World Championship 2009
+	{{'C', 'Y', '9', 0}, GAMERULE_AP}, // Club Penguin: EPF: Herbert's Revenge
+	{{'C', 'Y', 'J', 'J'}, GAMERULE_AP}, // Blood of Bahamut (Japan)
+	{{'C', 'Z', 'X', 'K'}, GAMERULE_AP}, // Touch Man to Man: Gichoyeongeo (Korea)
+	{{'C', 'Z', 'Z', 'K'}, GAMERULE_AP}, // Monmallineun 3-gongjuwa Hamkkehaneun: Geurimyeonsang Yeongdaneo Amgibeop (Korea)
+	{{'D', 'M', 'D', 0}, GAMERULE_NO_ASYNC_READ}, // DSi XL Demo Video Volume 1
+	{{'D', 'M', 'E', 0}, GAMERULE_NO_ASYNC_READ}, // DSi XL Demo Video Volume 2
+	{{'D', 'M', 'P', 0}, GAMERULE_NO_ASYNC_READ}, // NOE Movie Player Volume 1
+	{{'H', 'N', 'G', 0}, GAMERULE_INCOMPATIBLE_MEMORYPIT}, // Nintendo DSi Browser
+	{{'I', 'P', 'G', 0}, GAMERULE_AP}, // Pokemon SoulSilver Version
+	{{'I', 'P', 'K', 0}, GAMERULE_AP}, // Pokemon HeartGold Version
+	{{'I', 'R', 'A', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Pokemon Black Version
+	{{'I', 'R', 'B', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Pokemon White Version
+	{{'I', 'R', 'D', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Pokemon White Version 2
+	{{'I', 'R', 'E', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Pokemon Black Version 2
+	{{'K', '2', '7', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // G.G. Series: All Breaker
+	{{'K', '2', 'D', 0}, GAMERULE_DSIWARE_B4DS}, // Nintendo DSi + Internet
+	{{'K', '2', 'J', 0}, GAMERULE_DSIWARE_B4DS}, // Cake Ninja
+	{{'K', '2', 'N', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Cake Ninja 2
+	{{'K', '3', '2', 0}, GAMERULE_DSIWARE_B4DS}, // CuteWitch! runner
+	{{'K', '3', 'G', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Go! Go! Kokopolo
+	{{'K', '4', '5', 0}, GAMERULE_DSIWARE_B4DS}, // 40-in-1: Explosive Megamix
+	{{'K', '4', 'D', 0}, GAMERULE_DSIWARE_B4DS}, // Sudoku
+	{{'K', '4', 'F', 0}, GAMERULE_DSIWARE_B4DS}, // Sudoku 4Pockets
+	{{'K', '5', '9', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Metal Torrent
+	{{'K', '5', 'H', 0}, GAMERULE_DSIWARE_B4DS}, // Ah! Heaven
+	{{'K', '6', 'P', 0}, GAMERULE_DSIWARE_B4DS}, // Unou to Sanougaren Sasuru: Uranoura
+	{{'K', '6', 'S', 0}, GAMERULE_DSIWARE_B4DS}, // Heathcliff: Spot On
+	{{'K', '6', 'T', 0}, GAMERULE_DSIWARE_B4DS | GAMERULE_RAM_LIMITED_B4DS | (4 << 16)}, // Orion's Odyssey
+	{{'K', '8', 'B', 0}, GAMERULE_DSIWARE_B4DS}, // Beauty Academy
+	{{'K', '8', 'M', 0}, GAMERULE_DSIWARE_B4DS}, // Model Academy
+	{{'K', '9', '5', 0}, GAMERULE_DSIWARE_B4DS}, // 1950s Lawn Mower Kids
+	{{'K', '9', '9', 0}, GAMERULE_DSIWARE_B4DS}, // 99Bullets
+	{{'K', '9', 'W', 0}, GAMERULE_DSIWARE_B4DS}, // 99Moves
+	{{'K', 'A', '6', 0}, GAMERULE_DSIWARE_B4DS}, // Space Ace
+	{{'K', 'A', 'A', 0}, GAMERULE_DSIWARE_B4DS | GAMERULE_RAM_LIMITED_B4DS | (1 << 16)}, // Art Style: Aquia
+	{{'K', 'A', 'B', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // G.G. Series: Assault Buster
+	{{'K', 'A', 'C', 0}, GAMERULE_DSIWARE_B4DS}, // Advanced Circuits
+	{{'K', 'A', 'D', 0}, GAMERULE_DSIWARE_B4DS}, // Art Style: BASE 10
+	{{'K', 'A', 'H', 0}, GAMERULE_DSIWARE_B4DS}, // Art Style: Boxlife
+	{{'K', 'A', 'K', 0}, GAMERULE_DSIWARE_B4DS}, // Art Style: precipice
+	{{'K', 'A', 'P', 0}, GAMERULE_DSIWARE_B4DS}, // Art Style: PiCTOBiTS
+	{{'K', 'A', 'S', 0}, GAMERULE_DSIWARE_B4DS}, // Art Style: ZENGAGE
+	{{'K', 'A', 'Y', 0}, GAMERULE_DSIWARE_B4DS}, // Army Defender
+	{{'K', 'A', 'Z', 0}, GAMERULE_DSIWARE_B4DS}, // ARC Style: Soccer!
+	{{'K', 'B', '8', 0}, GAMERULE_DSIWARE_B4DS}, // GO Series: Earth Saver
+	{{'K', 'B', 'B', 0}, GAMERULE_DSIWARE_B4DS}, // Bomberman Blitz
+	{{'K', 'B', 'Z', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // BlayzBloo: Super Melee Brawlers Battle Royale
+	{{'K', 'C', '5', 0}, GAMERULE_DSIWARE_B4DS}, // Castle Conqueror: Heroes
+	{{'K', 'C', 'N', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Castle Conqueror
+	{{'K', 'C', 'V', 0}, GAMERULE_DSIWARE_B4DS}, // Cave Story
+	{{'K', 'C', 'Y', 0}, GAMERULE_DSIWARE_B4DS}, // Calculator
+	{{'K', 'D', '6', 0}, GAMERULE_DSIWARE_B4DS}, // Rock-n-Roll Domo
+	{{'K', 'D', '9', 0}, GAMERULE_DSIWARE_B4DS}, // Dr. Mario Express
+	{{'K', 'D', 'C', 0}, GAMERULE_DSIWARE_B4DS}, // Crash-Course Domo
+	{{'K', 'D', 'H', 0}, GAMERULE_DSIWARE_B4DS}, // Hard-Hat Domo
+	{{'K', 'D', 'L', 0}, GAMERULE_DSIWARE_B4DS}, // Dragon's Lair
+	{{'K', 'D', 'P', 0}, GAMERULE_DSIWARE_B4DS}, // Pro-Putt Domo
+	{{'K', 'D', 'Q', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Dragon Quest Wars
+	{{'K', 'D', 'R', 0}, GAMERULE_DSIWARE_B4DS}, // Mr. Driller: Drill Till You Drop
+	{{'K', 'D', 'V', 0}, GAMERULE_DSIWARE_B4DS}, // Dark Void Zero
+	{{'K', 'D', 'W', 0}, GAMERULE_DSIWARE_B4DS}, // White-Water Domo
+	{{'K', 'D', 'X', 0}, GAMERULE_INCOMPATIBLE_MEMORYPIT}, // X-Scape
+	{{'K', 'D', 'Y', 0}, GAMERULE_INCOMPATIBLE_MEMORYPIT}, // Starship Defense
+	{{'K', 'D', 'Z', 0}, GAMERULE_INCOMPATIBLE_MEMORYPIT}, // Trajectile
+	{{'K', 'E', 'V', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Space Invaders Extreme Z
+	{{'K', 'F', '2', 0}, GAMERULE_DSIWARE_B4DS}, // Amakuchi! Dairoujou
+	{{'K', 'F', '3', 0}, GAMERULE_DSIWARE_B4DS}, // Dairojo! Samurai Defenders
+	{{'K', 'F', 'D', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Fieldrunners
+	{{'K', 'F', 'G', 0}, GAMERULE_DSIWARE_B4DS}, // Frogger Returns
+	{{'K', 'F', 'P', 0}, GAMERULE_DSIWARE_B4DS | GAMERULE_RAM_LIMITED_B4DS | (2 << 16)}, // Flipper
+	{{'K', 'F', 'S', 0}, GAMERULE_DSIWARE_B4DS}, // Flashlight
+	{{'K', 'F', 'Z', 0}, GAMERULE_INCOMPATIBLE_MEMORYPIT}, // Faceez
+	{{'K', 'G', 'B', 0}, GAMERULE_DSIWARE_B4DS}, // Game & Watch: Ball
+	{{'K', 'G', 'C', 0}, GAMERULE_DSIWARE_B4DS}, // Game & Watch: Chef
+	{{'K', 'G', 'D', 0}, GAMERULE_DSIWARE_B4DS}, // Game & Watch: Donkey Kong Jr.
+	{{'K', 'G', 'F', 0}, GAMERULE_DSIWARE_B4DS}, // Game & Watch: Mario's Cement Factory
+	{{'K', 'G', 'G', 0}, GAMERULE_DSIWARE_B4DS}, // Game & Watch: Flagman
+	{{'K', 'G', 'H', 0}, GAMERULE_DSIWARE_B4DS}, // Game & Watch: Helmet
+	{{'K', 'G', 'J', 0}, GAMERULE_DSIWARE_B4DS}, // Game & Watch: Judge
+	{{'K', 'G', 'K', 0}, GAMERULE_DSIWARE_B4DS}, // Glory Days: Tactical Defense
+	{{'K', 'G', 'M', 0}, GAMERULE_DSIWARE_B4DS}, // Game & Watch: Manhole
+	{{'K', 'G', 'U', 0}, GAMERULE_INCOMPATIBLE_MEMORYPIT}, // Flipnote Studio
+	{{'K', 'G', 'V', 0}, GAMERULE_DSIWARE_B4DS}, // Game & Watch: Vermin
+	{{'K', 'H', 'D', 0}, GAMERULE_INCOMPATIBLE_MEMORYPIT}, // Sparkle Snapshots
+	{{'K', 'H', 'E', 0}, GAMERULE_DSIWARE_B4DS}, // DotMan
+	{{'K', 'H', 'J', 0}, GAMERULE_INCOMPATIBLE_MEMORYPIT}, // Hidden Photo (DSiWare)
+	{{'K', 'H', 'R', 0}, GAMERULE_DSIWARE_B4DS | GAMERULE_RAM_LIMITED_B4DS}, // Picture Perfect: Pocket Stylist
+	{{'K', 'I', 'I', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // 101 Pinball World
+	{{'K', 'J', 'O', 0}, GAMERULE_DSIWARE_B4DS}, // Magnetic Joe
+	{{'K', 'J', 'U', 0}, GAMERULE_DSIWARE_B4DS}, // GO Series: 10 Second Run
+	{{'K', 'J', 'Y', 0}, GAMERULE_DSIWARE_B4DS}, // JellyCar 2
+	{{'K', 'K', '4', 0}, GAMERULE_DSIWARE_B4DS}, // Wakugumi: Monochrome Puzzle
+	{{'K', 'K', 'N', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Flipper 2: Flush the Goldfish
+	{{'K', 'K', 'Q', 0}, GAMERULE_DSIWARE_B4DS}, // Bugs'N'Balls
+	{{'K', 'L', 'B', 0}, GAMERULE_DSIWARE_B4DS}, // Rabi Laby
+	{{'K', 'L', 'K', 0}, GAMERULE_DSIWARE_B4DS}, // Lola's Alphabet Train
+	{{'K', 'L', 'V', 0}, GAMERULE_DSIWARE_B4DS}, // Rabi Laby 2
+	{{'K', 'L', 'Y', 'E'}, GAMERULE_DSIWARE_B4DS}, // Dragon's Lair II: Time Warp (USA)
+	{{'K', 'M', 'B', 0}, GAMERULE_DSIWARE_B4DS}, // Mr. Brain
+	{{'K', 'M', 'G', 0}, GAMERULE_DSIWARE_B4DS}, // Mighty Flip Champs!
+	{{'K', 'M', 'M', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Mixed Messages
+	{{'K', 'N', 'P', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Need for Speed: Nitro-X
+	{{'K', 'N', 'V', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Neko Reversi
+	{{'K', 'O', 'Q', 0}, GAMERULE_DSIWARE_B4DS}, // GO Series: Portable Shrine Wars
+	{{'K', 'P', '9', 0}, GAMERULE_DSIWARE_B4DS}, // Paul's Monster Adventure
+	{{'K', 'P', 'F', 0}, GAMERULE_DSIWARE_B4DS}, // Pop Island: Paperfield
+	{{'K', 'P', 'J', 0}, GAMERULE_DSIWARE_B4DS}, // Paul's Shooting Adventure
+	{{'K', 'P', 'N', 0}, GAMERULE_DSIWARE_B4DS}, // Puzzle League: Express
+	{{'K', 'P', 'P', 0}, GAMERULE_DSIWARE_B4DS}, // Pop Island
+	{{'K', 'P', 'Q', 0}, GAMERULE_DSIWARE_B4DS}, // GO Series: Picdun
+	{{'K', 'P', 'S', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Phantasy Star 0 Mini
+	{{'K', 'Q', '9', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // The Legend of Zelda: Four Swords: Anniversary Edition
+	{{'K', 'Q', 'K', 0}, GAMERULE_DSIWARE_B4DS}, // Ace Mathician
+	{{'K', 'Q', 'L', 0}, GAMERULE_DSIWARE_B4DS}, // Chuukara! Dairoujou
+	{{'K', 'Q', 'N', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Castle Conqueror: Against
+	{{'K', 'R', 'R', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Robot Rescue 2
+	{{'K', 'R', 'T', 0}, GAMERULE_DSIWARE_B4DS}, // Robot Rescue
+	{{'K', 'S', '3', 0}, GAMERULE_DSIWARE_B4DS | GAMERULE_RAM_LIMITED_B4DS | GAMERULE_RAM_LIMITED_B4DS_DEBUG | (3 << 16) | (2 << 20)}, // Shantae: Risky's Revenge
+	{{'K', 'S', 'L', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Touch Solitaire
+	{{'K', 'S', 'R', 0}, GAMERULE_DSIWARE_B4DS}, // Aura-Aura Climber
+	{{'K', 'S', 'U', 'E'}, GAMERULE_DSIWARE_B4DS}, // Number Battle
+	{{'K', 'T', '9', 0}, GAMERULE_DSIWARE_B4DS}, // Kung Fu Dragon
+	{{'K', 'U', '7', 'E'}, GAMERULE_DSIWARE_B4DS}, // Fashion Tycoon (USA)
+	{{'K', 'U', 'C', 0}, GAMERULE_DSIWARE_B4DS}, // Chuck E. Cheese's Arcade Room
+	{{'K', 'U', 'M', 0}, GAMERULE_DSIWARE_B4DS}, // Quick Fill Q
+	{{'K', 'U', 'Q', 0}, GAMERULE_DSIWARE_B4DS}, // Chuck E. Cheese's Alien Defense Force
+	{{'K', 'U', 'S', 0}, GAMERULE_DSIWARE_B4DS}, // Paul's Shooting Adventure 2
+	{{'K', 'U', 'W', 0}, GAMERULE_INCOMPATIBLE_MEMORYPIT}, // WarioWare: Snapped!
+	{{'K', 'V', '2', 0}, GAMERULE_DSIWARE_B4DS}, // Anonymous Notes 2: From The Abyss
+	{{'K', 'V', '3', 0}, GAMERULE_DSIWARE_B4DS}, // Anonymous Notes 3: From The Abyss
+	{{'K', 'V', '4', 0}, GAMERULE_DSIWARE_B4DS}, // Anonymous Notes 4: From The Abyss
+	{{'K', 'V', 'I', 0}, GAMERULE_DSIWARE_B4DS}, // Anonymous Notes 1: From The Abyss
+	{{'K', 'V', 'T', 0}, GAMERULE_DSIWARE_B4DS}, // VT Tennis
+	{{'K', 'W', 'M', 0}, GAMERULE_DSIWARE_B4DS}, // Magical Whip
+	{{'K', 'W', 'T', 0}, GAMERULE_DSIWARE_B4DS}, // GO Series: Defense Wars
+	{{'K', 'W', 'Y', 0}, GAMERULE_DSIWARE_B4DS | GAMERULE_RAM_LIMITED_B4DS | (2 << 16)}, // Mighty Milky Way
+	{{'K', 'X', '5', 0}, GAMERULE_DSIWARE_B4DS}, // SnowBoard Xtreme
+	{{'K', 'X', 'B', 0}, GAMERULE_DSIWARE_B4DS}, // Monster Buster Club
+	{{'K', 'X', 'C', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Castle Conqueror: Heroes 2
+	{{'K', 'X', 'F', 0}, GAMERULE_DSIWARE_B4DS}, // Color Commando
+	{{'K', 'X', 'T', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // 99Seconds
+	{{'K', 'Y', 'L', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Make Up & Style
+	{{'K', 'Y', 'N', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Cake Ninja: XMAS
+	{{'K', 'Z', 'L', 0}, GAMERULE_DSIWARE_B4DS_DEBUG}, // Plants vs. Zombies
+	{{'T', 'A', 'D', 0}, GAMERULE_AP_ALT}, // Kirby: Mass Attack
+	{{'T', 'A', 'K', 'J'}, GAMERULE_AP}, // All Kamen Rider: Rider Generation (Japan)
+	{{'T', 'A', 'M', 0}, GAMERULE_NO_CARD_DMA}, // The Amazing Spider-Man
+	{{'T', 'B', 'C', 'J'}, GAMERULE_AP}, // Usavich: Game no Jikan (Japan)
+	{{'T', 'B', 'F', 'J'}, GAMERULE_AP}, // Digimon Story: Super Xros Wars: Blue (Japan)
+	{{'T', 'B', 'S', 'J'}, GAMERULE_AP}, // Byoutai Seiri DS: Image Dekiru! Shikkan, Shoujou to Care (Japan)
+	{{'T', 'C', 'B', 0}, GAMERULE_NO_ASYNC_READ}, // LEGO Legends of Chima: Laval's Journey
+	{{'T', 'C', 'M', 0}, GAMERULE_AP}, // Camping Mama: Outdoor Adventures
+	{{'T', 'C', 'Y', 'E'}, GAMERULE_AP}, // Mama's Combo Pack: Volume 1 (USA)
+	{{'T', 'C', 'Z', 'E'}, GAMERULE_AP}, // Mama's Combo Pack: Volume 2 (USA)
+	{{'T', 'D', 'B', 'J'}, GAMERULE_AP}, // Dragon Ball Kai: Ultimate Butou Den (Japan)
+	{{'T', 'D', 'V', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Shin Megami Tensei: Devil Survivor 2
+	{{'T', 'E', 'D', 'J'}, GAMERULE_AP}, // Red Stone DS: Akaki Ishi ni Michibikareshi Mono-tachi (Japan)
+	{{'T', 'E', 'N', 'J'}, GAMERULE_AP}, // Tennis no Ouji-sama: Gyutto! Dokidoki Survival: Umi to Yama no Love Passion (Japan)
+	{{'T', 'F', 'L', 'J'}, GAMERULE_AP}, // Sora no Otoshimono Forte: Dreamy Season (Japan)
+	{{'T', 'F', 'T', 'J'}, GAMERULE_AP}, // Original Story from Fairy Tail: Gekitotsu! Kardia Daiseidou (Japan)
+	{{'T', 'G', 'B', 'J'}, GAMERULE_AP}, // One Piece Gigant Battle 2: Shin Sekai (Japan)
+	{{'T', 'G', 'C', 'J'}, GAMERULE_AP}, // Tamagotchi Collection (Japan)
+	{{'T', 'G', 'K', 'J'}, GAMERULE_AP}, // Kaizoku Sentai Gokaiger: Atsumete Henshin! 35 Sentai! (Japan)
+	{{'T', 'H', 'M', 'J'}, GAMERULE_AP}, // FabStyle (Japan)
+	{{'T', 'J', '7', 'J'}, GAMERULE_AP}, // New Horizon: English Course 3 (Japan)
+	{{'T', 'J', '8', 'J'}, GAMERULE_AP}, // New Horizon: English Course 2 (Japan)
+	{{'T', 'J', '9', 'J'}, GAMERULE_AP}, // New Horizon: English Course 1 (Japan)
+	{{'T', 'K', '2', 'J'}, GAMERULE_AP}, // Kaidan Restaurant: Zoku! Shin Menu 100-sen (Japan)
+	{{'T', 'K', '9', 'J'}, GAMERULE_AP}, // Kimi ni Todoke: Special (Japan)
+	{{'T', 'K', 'D', 'J'}, GAMERULE_AP}, // Ore-Sama Kingdom: Koi mo Manga mo Debut o Mezase! Doki Doki Love Lesson (Japan)
+	{{'T', 'K', 'G', 'J'}, GAMERULE_AP}, // Tobidase! Kagaku-kun: Chikyuu Daitanken! Nazo no Chinkai Seibutsu ni Idome! (Japan)
+	{{'T', 'K', 'N', 'J'}, GAMERULE_AP}, // Meitantei Conan: Aoki Houseki no Rondo (Japan)
+	{{'T', 'K', 'T', 'J'}, GAMERULE_AP}, // Kimi ni Todoke: Tsutaeru Kimochi (Japan)
+	{{'T', 'L', 'J', 0}, GAMERULE_NO_ASYNC_READ}, // LEGO Friends
+	{{'T', 'L', 'M', 0}, GAMERULE_NO_ASYNC_READ}, // LEGO Marvel Super Heroes: Universe in Peril
+	{{'T', 'L', 'R', 0}, GAMERULE_NO_ASYNC_READ}, // LEGO The Lord of the Rings
+	{{'T', 'L', 'T', 'J'}, GAMERULE_AP}, // Digimon Story: Super Xros Wars: Red (Japan)
+	{{'T', 'M', 'C', 'P'}, GAMERULE_AP}, // Cooking Mama World: Combo Pack: Volume 1 (Europe)
+	{{'T', 'M', 'D', 'P'}, GAMERULE_AP}, // Cooking Mama World: Combo Pack: Volume 2 (Europe)
+	{{'T', 'M', 'K', 'J'}, GAMERULE_AP}, // Meitantei Conan: Kako Kara no Zensou Kyoku (Japan)
+	{{'T', 'M', 'X', 'J'}, GAMERULE_AP}, // Metal Max 2: Reloaded (Japan)
+	{{'T', 'N', 'R', 'J'}, GAMERULE_AP}, // Nora to Toki no Koubou: Kiri no Mori no Majo (Japan)
+	{{'T', 'P', '4', 'J'}, GAMERULE_AP}, // Puyo Puyo!!: Puyopuyo 20th Anniversary (Japan)
+	{{'T', 'P', 'G', 'J'}, GAMERULE_AP}, // Dengeki Gakuen RPG: Cross of Venus Special (Japan)
+	{{'T', 'P', 'Q', 'J'}, GAMERULE_AP}, // Suite PreCure: Melody Collection (Japan)
+	{{'T', 'Q', '5', 'J'}, GAMERULE_AP}, // Tokumei Sentai Go Busters (Japan)
+	{{'T', 'R', '2', 0}, GAMERULE_AP}, // The Smurfs 2
+	{{'U', 'S', 'K', 0}, GAMERULE_NO_ASYNC_READ}, // Face Training
+	{{'U', 'X', 'B', 'P'}, GAMERULE_AP}, // Jam with the Band (Europe)
+	{{'V', '2', '9', 'J'}, GAMERULE_AP}, // RPG Tkool DS (Japan)
+	{{'V', '2', 'G', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Mario vs. Donkey Kong: Mini-Land Mayhem!
+	{{'V', 'A', 'A', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Art Academy
+	{{'V', 'A', 'L', 0}, GAMERULE_AP}, // Alice in Wonderland
+	{{'V', 'A', 'O', 0}, GAMERULE_AP}, // Crime Lab: Body of Evidence
+	{{'V', 'C', 'A', 0}, GAMERULE_AP}, // Cars 2
+	{{'V', 'C', 'D', 0}, GAMERULE_AP}, // Solatorobo: Red the Hunter
+	{{'V', 'C', 'G', 'J'}, GAMERULE_AP}, // Kirakira Rhythm Collection (Japan)
+	{{'V', 'C', 'M', 0}, GAMERULE_AP}, // Camp Rock: The Final Jam
+	{{'V', 'C', 'P', 'J'}, GAMERULE_AP}, // Cosmetick Paradise: Kirei no Mahou (Japan)
+	{{'V', 'C', 'T', 'J'}, GAMERULE_AP}, // Cosmetick Paradise: Princess Life (Japan)
+	{{'V', 'C', 'W', 0}, GAMERULE_NO_ASYNC_READ}, // Classic Word Games
+	{{'V', 'D', 'E', 0}, GAMERULE_AP}, // Fossil Fighters Champions
+	{{'V', 'E', 'B', 'J'}, GAMERULE_AP}, // RPG Tsukuru DS+: Create The New World (Japan)
+	{{'V', 'E', 'T', 'P'}, GAMERULE_AP}, // 1000 Cooking Recipes from Elle a Table (Europe)
+	{{'V', 'F', 'B', 'E'}, GAMERULE_AP}, // Petz Fantasy: Moonlight Magic (USA)
+	{{'V', 'F', 'Z', 0}, GAMERULE_AP}, // Petz: Fantasy
+	{{'V', 'I', '2', 'J'}, GAMERULE_AP}, // Fire Emblem: Shin Monshou no Nazo: Hikari to Kage no Eiyuu (Japan)
+	{{'V', 'I', 'D', 0}, GAMERULE_AP_ALT}, // Imagine: Resort Owner
+	{{'V', 'I', 'M', 'J'}, GAMERULE_AP}, // The Idolm@ster: Dearly Stars (Japan)
+	{{'V', 'K', 'G', 0}, GAMERULE_AP}, // Korg DS-10+ Synthesizer
+	{{'V', 'K', 'H', 0}, GAMERULE_AP}, // Brainstorm Series: Treasure Chase
+	{{'V', 'K', 'P', 'J'}, GAMERULE_AP}, // Korg DS-10+ Synthesizer Limited Edition (Japan)
+	{{'V', 'L', '3', 'J'}, GAMERULE_AP}, // Elminage II: Sousei no Megami to Unmei no Daichi: DS Remix (Japan)
+	{{'V', 'L', 'I', 'P'}, GAMERULE_AP}, // Lost Identities (Europe)
+	{{'V', 'M', 'M', 'J'}, GAMERULE_AP}, // Gokujou!! Mecha Mote Iinchou: MM My Best Friend! (Japan)
+	{{'V', 'M', 'Y', 0}, GAMERULE_AP}, // Chronicles of Mystery: The Secret Tree of Life
+	{{'V', 'P', '4', 'J'}, GAMERULE_AP}, // Power Pro Kun Pocket 14 (Japan)
+	{{'V', 'P', 'F', 0}, GAMERULE_AP}, // Phineas and Ferb: Ride Again
+	{{'V', 'P', 'L', 'J'}, GAMERULE_AP}, // Power Pro Kun Pocket 13 (Japan)
+	{{'V', 'P', 'P', 0}, GAMERULE_AP}, // Prince of Persia: The Forgotten Sands
+	{{'V', 'P', 'T', 'J'}, GAMERULE_AP}, // Power Pro Kun Pocket 12 (Japan)
+	{{'V', 'P', 'Y', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Pokemon Conquest
+	{{'V', 'R', 'G', 0}, GAMERULE_AP}, // Rabbids Go Home: A Comedy Adventure
+	{{'V', 'S', '3', 0}, GAMERULE_AP}, // The Sims 3
+	{{'V', 'S', 'N', 0}, GAMERULE_AP}, // Sonny with a Chance
+	{{'V', 'S', 'O', 0}, GAMERULE_NO_ASYNC_READ}, // Sonic Classic Collection
+	{{'V', 'T', '3', 0}, GAMERULE_AP}, // Toy Story 3
+	{{'V', 'T', 'E', 0}, GAMERULE_AP}, // TRON: Evolution
+	{{'V', 'T', 'P', 'V'}, GAMERULE_AP}, // Phineas and Ferb: 2 Disney Games (Europe)
+	{{'Y', '4', '9', 0}, GAMERULE_NO_ASYNC_READ}, // Professor Layton and the Curious Village (Demo)
+	{{'Y', '6', 'Z', 0}, GAMERULE_NO_ASYNC_READ}, // Professor Layton and the Diabolical/Pandora's Box (Demo)
+	{{'Y', '7', 'S', 0}, GAMERULE_NO_ASYNC_READ}, // The Legend of Zelda: Spirit Tracks (Demo)
+	{{'Y', '8', 'L', 0}, GAMERULE_NO_CARD_DMA}, // Golden Sun: Dark Dawn (Demo)
+	{{'Y', '9', 'B', 0}, GAMERULE_NO_ASYNC_READ}, // Professor Layton and the Last Specter/Spectre's Call (Demo)
+	{{'Y', 'B', 'N', 0}, GAMERULE_AP}, // 100 Classic Books
+	{{'Y', 'B', 'U', 0}, GAMERULE_AP}, // Blue Dragon: Awakened Shadow
+	{{'Y', 'C', 'U', 'P'}, GAMERULE_AP}, // Nintendo Presents: Crossword Collection (Europe)
+	{{'Y', 'D', 'Q', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Dragon Quest IX: Sentinels of the Starry Skies
+	{{'Y', 'E', '9', 'K'}, GAMERULE_AP}, // Jeoldaeuwi: Yeongdaneo 1900 DS (Korea)
+	{{'Y', 'E', 'E', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Inazuma Eleven
+	{{'Y', 'E', 'E', 'J'}, GAMERULE_AP_NONE}, // Inazuma Eleven (Japan)
+	{{'Y', 'E', 'O', 'K'}, GAMERULE_AP}, // Jeoldaepiryo: Yeongsugeo 1000 DS (Korea)
+	{{'Y', 'F', 'T', 'K'}, GAMERULE_AP}, // Pokemon Bulgasaui Dungeon: Siganui Tamheomdae (Korea)
+	{{'Y', 'F', 'Y', 'K'}, GAMERULE_AP}, // Pokemon Bulgasaui Dungeon: Eodumui Tamheomdae (Korea)
+	{{'Y', 'G', '4', 'K'}, GAMERULE_AP}, // Hwansangsuhojeon: Tierkreis (Korea)
+	{{'Y', 'G', 'D', 0}, GAMERULE_NO_TWL_CLOCK}, // Diary Girl
+	{{'Y', 'G', 'X', 0}, GAMERULE_AP | GAMERULE_NO_TWL_CLOCK}, // Grand Theft Auto: Chinatown Wars
+	{{'Y', 'H', 'G', 'J'}, GAMERULE_AP}, // Houkago Shounen (Japan)
+	{{'Y', 'J', 'B', 0}, GAMERULE_NO_TWL_CLOCK}, // LEGO Batman: The Videogame
+	{{'Y', 'K', 'G', 0}, GAMERULE_AP}, // Kindgom Hearts: 358/2 Days
+	{{'Y', 'K', 'R', 0}, GAMERULE_INCOMPATIBLE_B4DS}, // Culdcept DS
+	{{'Y', 'L', '2', 0}, GAMERULE_NO_ASYNC_READ}, // Luminous Arc 2
+	{{'Y', 'L', 'G', 0}, GAMERULE_NO_TWL_CLOCK}, // LEGO Star Wars: The Complete Saga
+	{{'Y', 'L', 'J', 0}, GAMERULE_NO_TWL_CLOCK}, // LEGO Indiana Jones: The Original Adventures
+	{{'Y', 'L', 'T', 0}, GAMERULE_NO_ASYNC_READ}, // Professor Layton and the Diabolical/Pandora's Box
+	{{'Y', 'L', 'U', 0}, GAMERULE_AP | GAMERULE_NO_ASYNC_READ}, // Last Window: The Secret of Cape West
+	{{'Y', 'L', 'Z', 'K'}, GAMERULE_AP}, // Rhythm Sesang (Korea)
+	{{'Y', 'M', 'P', 0}, GAMERULE_AP}, // MapleStory DS
+	{{'Y', 'N', 'O', 'K'}, GAMERULE_AP}, // Mabeopcheonjamun DS (Korea)
+	{{'Y', 'N', 'R', 'K'}, GAMERULE_AP}, // Naruto Jilpungjeon: Daenantu! Geurimja Bunsinsul (Korea)
+	{{'Y', 'Q', 'U', 0}, GAMERULE_AP}, // Chrono Trigger
+	{{'Y', 'R', '4', 'J'}, GAMERULE_AP}, // Sengoku Spirits: Shukun Den (Japan)
+	{{'Y', 'R', 'B', 'K'}, GAMERULE_AP}, // Ragnarok DS (Korea)
+	{{'Y', 'R', 'C', 0}, GAMERULE_INCOMPATIBLE_B4DS}, // Crayon Shin-chan - Arashi o Yobu Cinemaland Kachinko Gachinko Daikatsugeki!
+	{{'Y', 'R', 'C', 'K'}, GAMERULE_AP}, // Jjangguneun Monmallyeo: Cinemaland Chalkak Chalkak Daesodong! (Korea)
+	{{'Y', 'R', 'O', 'K'}, GAMERULE_AP}, // Isanghan Naraui Princess (Korea)
+	{{'Y', 'S', 'L', 0}, GAMERULE_NO_ASYNC_READ}, // Sands of Destruction
+	{{'Y', 'U', 'T', 0}, GAMERULE_INCOMPATIBLE_FC}, // Ultimate Mortal Kombat
+	{{'Y', 'V', '5', 0}, GAMERULE_AP}, // Dragon Quest V: Hand of the Heavenly Bride
+	{{'Y', 'V', 'I', 0}, GAMERULE_AP}, // Dragon Quest VI: Realms of Revelation
+	{{'Y', 'V', 'K', 'K'}, GAMERULE_AP}, // DS Vitamin: Widaehan Bapsang: Malhaneun! Geongangyori Giljabi (Korea)
+	{{'Y', 'W', '4', 'K'}, GAMERULE_AP}, // Spectral Force: Genesis (Korea)
+	{{'Y', 'Z', 'X', 0}, GAMERULE_INCOMPATIBLE_B4DS | GAMERULE_NO_ASYNC_READ}, // Rockman ZX Advent/MegaMan ZX Advent
+	{{'Z', '2', 'A', 0}, GAMERULE_DSIWARE_B4DS | GAMERULE_RAM_LIMITED_ALL | (1 << 24)}, // WarioWare: Touched! DL
+	{{'Z', '2', 'E', 0}, GAMERULE_DSIWARE_B4DS}, // Famicom Wars DS: Ushinawareta Hikari
+};
+
+static inline const GameRule* findGameRule(const char* key)
+{
+	int low = 0;
+	int high = (int)(sizeof(gameRuleList)/sizeof(gameRuleList[0])) - 1;
+	while (low <= high) {
+		int mid = (low + high) / 2;
+		int cmp = memcmp(gameRuleList[mid].gameTid, key, 4);
+		if (cmp < 0) {
+			low = mid + 1;
+		} else if (cmp > 0) {
+			high = mid - 1;
+		} else {
+			return &gameRuleList[mid];
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Get the compatibility rules for a game.
+ * @param gameTid The game's 4-character ID.
+ * @return GAMERULE_* flags from both the 3-character and exact ID entries.
+ */
+static inline u32 getGameRules(const char* gameTid)
+{
+	const char prefix[4] = {gameTid[0], gameTid[1], gameTid[2], 0};
+	u32 rules = 0;
+
+	const GameRule* rule = findGameRule(prefix);
+	if (rule) rules |= rule->rules;
+	rule = findGameRule(gameTid);
+	if (rule) rules |= rule->rules;
+
+	if (rules & GAMERULE_AP_NONE) {
+		rules &= ~(GAMERULE_AP | GAMERULE_AP_ALT);
+	}
+	return rules;
+}
+
+#endif // GAMERULES_H
@@ -0,0 +1,109 @@
+#pragma once
+#ifndef _GAMESETTINGSDB_H_
+#define _GAMESETTINGSDB_H_
+
+#include <nds/ndstypes.h>
+#include <stddef.h>
+#include <string>
+
+/*
+ * Per-game settings, kept in one file instead of an .ini per game in
+ * _nds/TWiLightMenu/gamesettings, which gets slow to open files in once
+ * there are thousands of them.
+ *
+ * _nds/TWiLightMenu/gamesettings.db is a hash table of fixed-size records,
+ * keyed by a hash of the ROM's file name. A record is read with one seek and
+ * usually one read, and is written back in place on its own, never across a
+ * sector, so a save cut short can only lose that game's change. The table is
+ * only rewritten as a whole, to a new file, when it has to grow.
+ *
+ * The first time the file is made, the .ini files already in gamesettings
+ * (and gamesettings/slot1) are copied into it. They're left where they are,
+ * but not read again.
+ */
+
+enum GameSettingsKey {
+	GAMESETTINGS_DIRECT_BOOT = 0,
+	GAMESETTINGS_DSI_MODE,
+	GAMESETTINGS_LANGUAGE,
+	GAMESETTINGS_REGION,
+	GAMESETTINGS_SAVE_NUMBER,
+	GAMESETTINGS_RAM_DISK,
+	GAMESETTINGS_BOOST_CPU,
+	GAMESETTINGS_BOOST_VRAM,
+	GAMESETTINGS_CARD_READ_DMA,
+	GAMESETTINGS_ASYNC_CARD_READ,
+	GAMESETTINGS_SWI_HALT_HOOK,
+	GAMESETTINGS_BOOTSTRAP_FILE,
+	GAMESETTINGS_WIDESCREEN,
+	GAMESETTINGS_EXTENDED_MEMORY,
+	GAMESETTINGS_DSIWARE_BOOTER,
+	GAMESETTINGS_USE_BOOTSTRAP,
+	GAMESETTINGS_HEAP_SHRINK,
+	GAMESETTINGS_NO_SHOW_AP_MSG,
+	GAMESETTINGS_NO_SHOW_RAM_LIMIT_MSG,
+	GAMESETTINGS_KEYS
+};
+
+// What a setting never set reads as, before the default is given in its place
+#define GAMESETTINGS_UNSET (-128)
+
+// How many games can be looked up at once, one page of a file list
+#define GAMESETTINGS_BATCH_MAX 40
+
+struct GameSettingsRecord {
+	u32 nameHash;
+	u32 nameHash2;	// A second hash of the name, so two names are never taken for one
+	u32 tid;		// The game's TID, or 0 if it wasn't known when saved. Not a key, see below
+	s8 value[GAMESETTINGS_KEYS];
+	u8 check;		// Of everything before it, so a torn write reads as no record
+};
+
+/**
+ * Look up the settings of several games at once, for a page of a file list.
+ * The records wanted are read in the order they're in the file, so each
+ * sector is read once.
+ *
+ * Records are found by file name alone, as the .ini files were. A TID would
+ * tie together what shouldn't be: homebrew and ROM hacks share the TIDs of
+ * others, and two copies of one game can be kept with different settings.
+ *
+ * @param drive "sd:" or "fat:".
+ * @param names The ROMs' file names, without their path. Up to GAMESETTINGS_BATCH_MAX.
+ * @param records Set for each name to its record, or to a new one if it has none.
+ * @param found Set for each name to whether it has settings.
+ */
+void gameSettingsFindBatch(const char *drive, const char *const *names, int count, GameSettingsRecord *records, bool *found);
+
+/**
+ * A game's settings, read by its constructor and written back by Save(),
+ * in the same way as a CIniFile of its .ini was used.
+ */
+class GameSettings
+{
+public:
+	/**
+	 * @param name The ROM's file name, without its path, or "slot1/" and a TID for a game card.
+	 * @param tid If not 0, kept in the record when it's saved.
+	 * @param pageRecord What gameSettingsFindBatch() gave for the name, if it was on the page
+	 * looked up, so it isn't read again. Save() keeps it up to date. Ignored if it's another name's.
+	 */
+	GameSettings(const char *drive, const std::string &name, u32 tid = 0, GameSettingsRecord *pageRecord = NULL);
+
+	int GetInt(GameSettingsKey key, int defaultValue) const;
+	void SetInt(GameSettingsKey key, int value);
+
+	/**
+	 * Write the record back, if anything was set.
+	 * @return false if it couldn't be written.
+	 */
+	bool Save(void);
+
+private:
+	const char *_drive;
+	GameSettingsRecord _record;
+	GameSettingsRecord *_pageRecord;
+	bool _modified;
+};
+
+#endif // _GAMESETTINGSDB_H_
@@ -0,0 +1,28 @@
+#ifndef __GBANORFLASH_H__
+#define __GBANORFLASH_H__
+
+#include <nds/ndstypes.h>
+#include <stdio.h>
+
+// Erase block size of the Expansion Pak's NOR, and the most it holds
+#define GBA_NOR_BLOCK_SIZE 0x40000
+#define GBA_NOR_MAX_SIZE 0x2000000
+#define GBA_NOR_BLOCKS (GBA_NOR_MAX_SIZE / GBA_NOR_BLOCK_SIZE)
+
+/**
+ * Flash a GBA ROM to the Expansion Pak's NOR, which must already be mapped
+ * in and open for writing.
+ *
+ * What was last flashed is remembered in _nds/TWiLightMenu/cache/gbanor.bin:
+ * the ROM's path, size and a hash of each block. Flashing the same,
+ * unchanged ROM again is skipped altogether, and a changed one only has the
+ * blocks that differ erased and written.
+ *
+ * @param file The ROM, read from its start.
+ * @param buffer At least 0x8000 bytes, the size written at a time.
+ * @param progress If not NULL, called with the bytes done so far and romSize.
+ * @return false if the ROM couldn't be read.
+ */
+bool gbaNorFlash(FILE *file, const char *path, u32 romSize, u8 *buffer, void (*progress)(u32 done, u32 total));
+
+#endif
@@ -1,6 +1,8 @@
 #pragma once
 #include "Save.h"
 
+void eeprom_addScanPatterns();
+
 bool eeprom_patchV111(const save_type_t* type);
 bool eeprom_patchV120(const save_type_t* type);
 bool eeprom_patchV124(const save_type_t* type);
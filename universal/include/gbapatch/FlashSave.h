@@ -1,6 +1,8 @@
 #pragma once
 #include "Save.h"
 
+void flash_addScanPatterns();
+
 bool flash_patchV120(const save_type_t* type);
 bool flash_patchV123(const save_type_t* type);
 bool flash_patchV126(const save_type_t* type);
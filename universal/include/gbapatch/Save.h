@@ -50,4 +50,9 @@ struct save_type_t
 	bool (*  patchFunc)(const save_type_t* type);
 };
 
+/**
+ * Add the save tags and patch signatures to the ROM scan, before romScan_run().
+ */
+void save_addScanPatterns();
+
 const save_type_t* save_findTag();
@@ -0,0 +1,93 @@
+#ifndef ROMSCAN_H
+#define ROMSCAN_H
+
+#include <nds/ndstypes.h>
+
+/*
+ * Finds every save tag and save patch signature in one pass over the ROM,
+ * patching out the wait states as it goes, instead of searching the whole
+ * ROM again for each one.
+ *
+ * Patterns are added first, then the ROM is scanned, either by
+ * romScan_run() from slot-2, or a chunk at a time by whatever is loading
+ * it. romScan_find() then stands in for memsearch8().
+ *
+ * The menus scan the ROM as they load it, and pass the results on to
+ * gbapatcher with romScan_save() and romScan_load(), so it doesn't have to
+ * read the ROM again.
+ */
+
+#define ROMSCAN_MAX_PATTERNS		64
+#define ROMSCAN_MAX_PATTERN_SIZE	128
+#define ROMSCAN_MAX_HITS			8	// Per pattern, enough for each ROM in a 2-3 in 1 pack
+
+// Bytes of the ROM needed either side of a chunk, for the wait state check and the longest pattern
+#define ROMSCAN_BEHIND	4
+#define ROMSCAN_AHEAD	(ROMSCAN_MAX_PATTERN_SIZE + 8)
+
+// Only match at word-aligned offsets past the header, as save tags are looked for
+#define ROMSCAN_TAG		BIT(0)
+
+// Size of the ROM in slot-2
+extern u32 romSize;
+
+/**
+ * Add a pattern to look for. find must stay valid, as it's also how
+ * romScan_find() tells the patterns apart.
+ * @return The pattern's index, or -1 if there's no room.
+ */
+int romScan_addPattern(const u8* find, u32 findSize, u32 flags);
+
+/**
+ * Scan the ROM in slot-2 for every pattern added.
+ * @param waitStateEnd ROM offset to patch out wait states up to, or 0 for none.
+ */
+void romScan_run(u32 waitStateEnd);
+
+/**
+ * Scan the ROM a chunk at a time, in order, ending with romScan_end().
+ */
+void romScan_begin(u32 waitStateEnd);
+
+/**
+ * Scan the size bytes at data, which are at offset in the ROM. The
+ * ROMSCAN_BEHIND bytes before data and the ROMSCAN_AHEAD bytes after the
+ * chunk must hold the ROM either side of it. Wait states are patched out in
+ * both the chunk and the bytes after it.
+ * @param rom If not NULL, where the chunk is in slot-2, for wait states to be patched out there too.
+ */
+void romScan_chunk(u8* data, u32 offset, u32 size, u8* rom);
+
+void romScan_end(void);
+
+/**
+ * Find the first pattern added with this find, in the given range, the same
+ * as memsearch8(start, dataSize, find, findSize, true). Anything overwritten
+ * since the scan is searched again, and patterns never added are searched
+ * for the old way.
+ */
+u8* romScan_find(const u8* start, u32 dataSize, const u8* find, u32 findSize);
+
+/**
+ * @return Where a pattern was first found, or NULL.
+ */
+u8* romScan_first(int pattern);
+
+/**
+ * @return The offset wait states were patched out up to, 0 if they weren't.
+ */
+u32 romScan_waitStateEnd(void);
+
+/**
+ * Keep the results of the last scan of the ROM at path, for romScan_load().
+ */
+void romScan_save(const char* path);
+
+/**
+ * Take the results romScan_save() kept for the ROM at path, if it's
+ * unchanged and the same patterns were added. They can only be taken once.
+ * @return true if there were any, so the ROM needn't be scanned.
+ */
+bool romScan_load(const char* path);
+
+#endif // ROMSCAN_H
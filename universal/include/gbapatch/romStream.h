@@ -0,0 +1,28 @@
+#ifndef ROMSTREAM_H
+#define ROMSTREAM_H
+
+#include <nds/ndstypes.h>
+#include <stdio.h>
+
+/*
+ * Loads a GBA ROM into slot-2 RAM, scanning and patching each chunk with
+ * romScan_chunk() before it's written, so gbapatcher can take the results
+ * with romScan_load() instead of reading the whole ROM back to patch it.
+ *
+ * With a slot-1 DLDI driver, slot-2 can be written to while the card is
+ * read, so the next chunk is read and scanned while the last one is DMAed
+ * out. Otherwise, the bus is switched between the two for each chunk.
+ */
+
+/**
+ * @param file The ROM, read from its start.
+ * @param ptr Where in slot-2 to load it.
+ * @param scan Whether to scan for the patterns added to romScan, if the ROM
+ *             is loaded where gbapatcher would patch it.
+ * @param buffer At least 0x8000 bytes, used if there isn't memory for more.
+ * @param progress If not NULL, called with the bytes done so far and romSize.
+ * @return false if the ROM couldn't be read.
+ */
+bool romStream_load(FILE* file, u32 ptr, u32 romSize, bool scan, u8* buffer, void (*progress)(u32 done, u32 total));
+
+#endif // ROMSTREAM_H
@@ -1,48 +0,0 @@
-#ifndef INCOMPATIBLEMAP_H
-#define INCOMPATIBLEMAP_H
-
-static const char incompatibleGameListB4DS[][4] = {
-	"ADM", // Animal Crossing: Wild World
-	"AQC", // Crayon Shin-chan DS - Arashi o Yobu Nutte Crayoon Daisakusen!
-	"YRC", // Crayon Shin-chan - Arashi o Yobu Cinemaland Kachinko Gachinko Daikatsugeki!
-	"CL4", // Crayon Shin-Chan - Arashi o Yobu Nendororoon Daihenshin!
-	"BQB", // Crayon Shin-chan - Obaka Dainin Den - Susume! Kasukabe Ninja Tai!
-	"YKR", // Culdcept DS
-	"AWD", // Diddy Kong Racing
-	"AK4", // Kabu Trader Shun
-	"B7F", // The Magic School Bus: Oceans
-	"ARM", // Mario & Luigi: Partners in Time
-	"CLJ", // Mario & Luigi: Bowser's Inside Story
-	"COL", // Mario & Sonic at the Olympic Winter Games
-	"AMM", // Minna no Mahjong DS
-	"ARZ", // Rockman ZX/MegaMan ZX
-	"YZX", // Rockman ZX Advent/MegaMan ZX Advent
-	"B6Z", // Rockman Zero Collection/MegaMan Zero Collection
-	"CS3", // Sonic & Sega All-Stars Racing
-	"AH9", // Tony Hawk's American Sk8land
-	"CTX", // Tropix
-};
-
-static const char incompatibleGameListFC[][4] = {
-	"CAY", // Army Men: Soldiers of Misfortune
-	"YUT", // Ultimate Mortal Kombat
-};
-
-static const char incompatibleGameList[][4] = {
-	"BO5", // Golden Sun: Dark Dawn
-};
-
-// DSiWare
-static const char incompatibleGameListMemoryPit[][4] = {
-	"KFZ", // Faceez
-	"KGU", // Flipnote Studio
-	"KHJ", // Hidden Photo (DSiWare)
-	"HNG", // Nintendo DSi Browser
-	"KHD", // Sparkle Snapshots
-	"KDY", // Starship Defense
-	"KDZ", // Trajectile
-	"KUW", // WarioWare: Snapped!
-	"KDX", // X-Scape
-};
-
-#endif // INCOMPATIBLEMAP_H
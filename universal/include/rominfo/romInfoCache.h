@@ -0,0 +1,138 @@
+#pragma once
+#ifndef _ROMINFOCACHE_H_
+#define _ROMINFOCACHE_H_
+
+#include "common/singleton.h"
+#include <nds/ndstypes.h>
+#include <stdio.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Maximum number of files remembered per directory
+#define ROMINFO_CACHE_MAX_ENTRIES 1024
+// Once the data area grows past this, the directory's cache is started over
+#define ROMINFO_CACHE_MAX_DATA_SIZE 0x400000
+// Most of a page's cached data that readPage() holds in memory
+#define ROMINFO_CACHE_PAGE_MAX_SIZE 0x20000
+
+/**
+ * On-disk cache of ROM metadata (header fields and banner), one file per
+ * directory in _nds/TWiLightMenu/cache/rominfo.
+ *
+ * Entries are keyed by the file name's hash, and are only used while the
+ * file's size, first cluster and modification time still match, so a
+ * replaced or edited ROM is read again from the ROM itself. Those are taken
+ * from the directory listing when the file was noted by listFile(), and
+ * from stat() otherwise.
+ *
+ * The layout of the info block is up to the caller. Bump the version passed
+ * to openDir() whenever it changes; each version is kept in its own file.
+ */
+class RomInfoCache
+{
+public:
+	RomInfoCache();
+	~RomInfoCache();
+
+	/**
+	 * Open the cache for a directory, closing the previous one.
+	 * Does nothing if that directory's cache is already open.
+	 * @param dirPath Full path of the directory, as returned by getcwd().
+	 * @param version Layout version of the caller's info block.
+	 */
+	void openDir(const char *dirPath, u32 version);
+	void closeDir(void);
+
+	/**
+	 * Note a file found while listing a directory, so get() and put() don't
+	 * have to look it up by its path again.
+	 * @param name As it will be passed to get() and put().
+	 * @param dirEntry The file's 32-byte FAT directory entry.
+	 */
+	void listFile(const char *name, const u8 *dirEntry);
+
+	/**
+	 * Forget the files noted by listFile(), before listing again.
+	 */
+	void clearListing(void);
+
+	/**
+	 * Read the cached data of a page of files in the current directory in as
+	 * few sequential reads as it takes, for the get() calls that follow.
+	 * Files that aren't cached are skipped.
+	 */
+	void readPage(const char *const *names, int count);
+
+	/**
+	 * Look up a file in the current directory.
+	 * @param name File name, relative to the working directory, or a full path.
+	 * @param info Filled with the cached info block, infoSize bytes.
+	 * @param banner If not NULL, filled with the cached banner, up to bannerMaxSize bytes.
+	 * @param bannerSize Set to the size of the cached banner, 0 if the ROM has none.
+	 * @return true if the file was found and is unchanged.
+	 */
+	bool get(const char *name, void *info, u32 infoSize, void *banner, u32 bannerMaxSize, u32 *bannerSize);
+
+	/**
+	 * Remember a file's info block and banner. bannerSize may be 0.
+	 */
+	void put(const char *name, const void *info, u32 infoSize, const void *banner, u32 bannerSize);
+
+private:
+	struct Header {
+		char magic[4];
+		u32 version;
+		u32 count;
+		u32 dataEnd;
+	};
+
+	struct Entry {
+		u32 nameHash;
+		u32 fileSize;
+		u32 cluster;
+		u32 modified;
+		u32 offset;
+		u16 infoSize;
+		u16 bannerSize;
+	};
+
+	// A file as listFile() noted it, with its FAT modification time as it is on disk
+	struct ListedFile {
+		u32 nameHash;
+		u32 fileSize;
+		u32 cluster;
+		u16 time;
+		u16 date;
+	};
+
+	// Cached data read by readPage(), from the file's offset, at _page[pageOffset]
+	struct PageRun {
+		u32 offset;
+		u32 size;
+		u32 pageOffset;
+	};
+
+	bool fileKey(const char *name, Entry &entry);
+	int findEntry(u32 nameHash);
+	const u8 *findInPage(const Entry &entry);
+	void reset(void);
+	void writeHeader(void);
+	void writeEntry(u32 slot);
+
+	FILE *_file;
+	std::string _dirPath;
+	Header _header;
+	std::vector<Entry> _entries;
+	std::unordered_map<u32, u32> _slots; // Index in _entries by name hash
+	std::vector<ListedFile> _listing;
+	bool _listingSorted;
+	std::vector<u8> _page;
+	std::vector<PageRun> _pageRuns;
+};
+
+typedef singleton<RomInfoCache> romInfoCache_s;
+
+inline RomInfoCache &romInfoCache() { return romInfoCache_s::instance(); }
+
+#endif // _ROMINFOCACHE_H_
@@ -1,22 +0,0 @@
-#ifndef TWLCLOCKEXCLUDEMAP_H
-#define TWLCLOCKEXCLUDEMAP_H
-
-static const char twlClockExcludeList[][4] = {
-	"CRL", // Coraline
-	"YGD", // Diary Girl
-	"YGX", // Grand Theft Auto: Chinatown Wars
-	"C6C", // Infinite Space
-	"YJB", // LEGO Batman: The Videogame
-	"BLH", // LEGO Harry Potter: Years 1-4
-	"YLJ", // LEGO Indiana Jones: The Original Adventures
-	"YLG", // LEGO Star Wars: The Complete Saga
-	"AY9", // Mario & Sonic at the Olympic Games
-	"BZP", // Peppa Pig: Theme Park Fun
-	"ARF", // Rune Factory: A Fantasy Harvest Moon
-	"AN6", // Rune Factory 2: A Fantasy Harvest Moon
-	"BRF", // Rune Factory 3: A Fantasy Harvest Moon
-	"ASC", // Sonic Rush
-	"CY8", // Yu-Gi-Oh! 5D's Stardust Accelerator: World Championship 2009
-};
-
-#endif // TWLCLOCKEXCLUDEMAP_H
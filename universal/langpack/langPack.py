@@ -0,0 +1,166 @@
+# -*- coding: utf8 -*-
+# Compile a module's language.ini files into language.bin packs
+#
+# A pack holds every string in language.inl, in the same order, already
+# looked up and with its escapes replaced, the same as getString() in
+# language.cpp would give. langInit() reads it with a single fread and no
+# INI parsing, and falls back to language.ini if it's missing or out of date.
+#
+# Format, little endian:
+#   char magic[4]      "LNG1"
+#   u32  idsHash       FNV-1a of each string's name followed by '\n'
+#   u32  count         Strings in language.inl
+#   u32  offset[count] Of each string, from the start of the file
+#   NUL-terminated UTF-8 strings
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+MAGIC = b'LNG1'
+
+STRING_RE = re.compile(r'^\s*STRING\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)\s*$')
+
+# Characters after a '\', and what getString() replaces the pair with
+ESCAPES = {
+	b'n': b'\n',
+	b'a': '\ue000'.encode(),
+	b'b': '\ue001'.encode(),
+	b'x': '\ue002'.encode(),
+	b'y': '\ue003'.encode(),
+	b'l': '\ue004'.encode(),
+	b'r': '\ue005'.encode(),
+}
+
+# Characters after a '\d', for the D-pad icons
+DPAD_ESCAPES = {
+	b'u': '\ue079'.encode(),
+	b'd': '\ue07a'.encode(),
+	b'l': '\ue07b'.encode(),
+	b'r': '\ue07c'.encode(),
+	b'v': '\ue07d'.encode(),
+	b'h': '\ue07e'.encode(),
+}
+
+
+def fnv1a(data, h=0x811C9DC5):
+	for b in data:
+		h = ((h ^ b) * 0x01000193) & 0xFFFFFFFF
+	return h
+
+
+def parseInl(path):
+	strings = []  # (name, default)
+	with open(path, encoding='utf-8') as f:
+		for lineNo, line in enumerate(f, 1):
+			stripped = line.strip()
+			if not stripped or stripped.startswith('//'):
+				continue
+			match = STRING_RE.match(line)
+			if not match:
+				sys.exit('%s:%d: expected STRING(NAME, "default")' % (path, lineNo))
+			default = re.sub(r'\\(.)', lambda m: '\n' if m.group(1) == 'n' else m.group(1), match.group(2))
+			strings.append((match.group(1), default.encode('utf-8')))
+	return strings
+
+
+def parseIni(path):
+	"""The [LANGUAGE] items, as CIniFile reads them: the first of each key, in the first [LANGUAGE]."""
+	with open(path, 'rb') as f:
+		data = f.read()
+	if data.startswith(b'\xef\xbb\xbf'):
+		data = data[3:]
+
+	items = {}
+	inSection = False
+	seenSection = False
+	for line in re.split(b'[\r\n]', data):
+		line = line.strip(b' \t')
+		if not line or line[:1] in (b';', b'/', b'!'):
+			continue
+
+		if inSection and b'=' in line:
+			key, _, value = line.partition(b'=')
+			items.setdefault(key.rstrip(b' \t'), value.lstrip(b' \t'))
+			continue
+
+		if not line.startswith(b'['):
+			continue
+
+		# Any line starting with '[' ends the current section
+		inSection = False
+		end = line.find(b']')
+		if end > 0:
+			if line[1:end] == b'LANGUAGE' and not seenSection:
+				inSection = True
+			if line[1:end] == b'LANGUAGE':
+				seenSection = True
+	return items
+
+
+def unescape(out):
+	"""getString()'s escape processing, replacement for replacement."""
+	i = 0
+	while i < len(out) - 1:
+		if out[i:i + 1] == b'\\':
+			c = out[i + 1:i + 2].lower()
+			if c == b'd':
+				d = out[i + 2:i + 3].lower()
+				if d in DPAD_ESCAPES:
+					out = out[:i] + DPAD_ESCAPES[d] + out[i + 3:]
+				else:
+					out = out[:i] + '\ue006'.encode() + out[i + 2:]
+			elif c in ESCAPES:
+				out = out[:i] + ESCAPES[c] + out[i + 2:]
+		elif out[i:i + 1] == b'&':
+			if out[i + 1:i + 4] == b'lrm':
+				out = out[:i] + '\u200e'.encode() + out[i + 4:]
+			elif out[i + 1:i + 4] == b'rlm':
+				out = out[:i] + '\u200f'.encode() + out[i + 4:]
+		i += 1
+	return out
+
+
+def build(strings, iniPath):
+	items = parseIni(iniPath)
+
+	idsHash = 0x811C9DC5
+	for name, _ in strings:
+		idsHash = fnv1a(name.encode('ascii') + b'\n', idsHash)
+
+	offset = 12 + 4 * len(strings)
+	offsets = []
+	blob = bytearray()
+	for name, default in strings:
+		value = unescape(items.get(name.encode('ascii'), default))
+		if b'\0' in value:
+			sys.exit('%s: %s contains a NUL' % (iniPath, name))
+		offsets.append(offset + len(blob))
+		blob += value + b'\0'
+
+	return MAGIC + struct.pack('<II', idsHash, len(strings)) + struct.pack('<%dI' % len(offsets), *offsets) + bytes(blob)
+
+
+if __name__ == '__main__':
+	parser = argparse.ArgumentParser(description='Compile language.ini files into binary language packs.')
+	parser.add_argument('inl', help="the module's language.inl")
+	parser.add_argument('languages', help='directory of <language>/language.ini, where each language.bin is written')
+	args = parser.parse_args()
+
+	strings = parseInl(args.inl)
+	for language in sorted(os.listdir(args.languages)):
+		iniPath = os.path.join(args.languages, language, 'language.ini')
+		if not os.path.isfile(iniPath):
+			continue
+		pack = build(strings, iniPath)
+
+		# Only write packs that changed, so ndstool isn't given newer files for nothing
+		binPath = os.path.join(args.languages, language, 'language.bin')
+		if os.path.isfile(binPath):
+			with open(binPath, 'rb') as f:
+				if f.read() == pack:
+					continue
+		with open(binPath, 'wb') as f:
+			f.write(pack)
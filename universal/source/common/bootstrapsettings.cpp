@@ -3,6 +3,7 @@
 #include "common/bootstrappaths.h"
 #include "common/flashcard.h"
 #include "common/inifile.h"
+#include "common/iniSnapshot.h"
 #include "myDSiMode.h"
 
 #include <string.h>
@@ -27,7 +28,7 @@ void BootstrapSettings::loadSettings()
 		bootstrapinipath = BOOTSTRAP_INI_FC; // Fallback to .ini path on flashcard, if not found on SD card, or if SD access is disabled
 	}
 
-	CIniFile bootstrapini(bootstrapinipath);
+	IniSnapshot bootstrapini(bootstrapinipath, "nds-bootstrap");
 
 	debug = bootstrapini.GetInt("NDS-BOOTSTRAP", "DEBUG", debug);
 	logging = bootstrapini.GetInt("NDS-BOOTSTRAP", "LOGGING", logging);
@@ -41,6 +42,8 @@ void BootstrapSettings::loadSettings()
 	sdNand = bootstrapini.GetInt( "NDS-BOOTSTRAP", "SDNAND", sdNand);
 	consoleModel = (TWLSettings::TConsoleModel)bootstrapini.GetInt("NDS-BOOTSTRAP", "CONSOLE_MODEL", consoleModel);
 	bootstrapHotkey = strtol(bootstrapini.GetString("NDS-BOOTSTRAP", "HOTKEY", "284").c_str(), NULL, 16);
+
+	bootstrapini.SaveSnapshot();
 }
 
 void BootstrapSettings::saveSettings()
@@ -0,0 +1,165 @@
+#include "common/cheatIndex.h"
+#include "common/flashcard.h"
+
+#include <algorithm>
+#include <string.h>
+#include <sys/stat.h>
+#include <vector>
+
+// Where usrcheat.dat's index starts, and how many of its entries are read at a time
+#define CHEAT_DAT_INDEX_START 0x100
+#define CHEAT_DAT_INDEX_READ 256
+
+#define CHEAT_INDEX_BUCKETS 256
+
+static const char cheatIndexMagic[4] = {'C', 'I', 'X', '1'};
+
+// An entry in usrcheat.dat's index, ended by one with an offset of 0
+struct DatIndexEntry {
+	u32 gameCode;
+	u32 crc32;
+	u64 offset;
+};
+
+struct CheatIndexHeader {
+	char magic[4];
+	u32 datSize;
+	u32 cluster;
+	u32 modified;
+	u32 count;
+	u32 bucketStart[CHEAT_INDEX_BUCKETS + 1];	// First entry of each bucket, then count
+};
+
+// Sorted by crc32 then gameCode, with duplicates left in the .dat's order
+struct CheatIndexEntry {
+	u32 crc32;
+	u32 gameCode;
+	u32 offset;
+	u32 size;
+};
+
+static inline bool entryLess(const CheatIndexEntry &a, const CheatIndexEntry &b)
+{
+	return (a.crc32 != b.crc32) ? (a.crc32 < b.crc32) : (a.gameCode < b.gameCode);
+}
+
+static inline u32 bucketOf(u32 crc32)
+{
+	return crc32 >> 24;
+}
+
+static bool findEntry(const CheatIndexEntry *entries, u32 count, u32 gameCode, u32 crc32, u32 &offset, u32 &size)
+{
+	const CheatIndexEntry key = {crc32, gameCode, 0, 0};
+	const CheatIndexEntry *found = std::lower_bound(entries, entries + count, key, entryLess);
+	if (found == entries + count || found->crc32 != crc32 || found->gameCode != gameCode)
+		return false;
+
+	offset = found->offset;
+	size = found->size;
+	return true;
+}
+
+/**
+ * Read usrcheat.dat's index, each entry's size being up to the next entry,
+ * the same as it was searched before, and sort it.
+ */
+static void readDatIndex(FILE *dat, u32 datSize, std::vector<CheatIndexEntry> &entries)
+{
+	std::vector<DatIndexEntry> chunk(CHEAT_DAT_INDEX_READ);
+	fseek(dat, CHEAT_DAT_INDEX_START, SEEK_SET);
+
+	bool ended = false;
+	while (!ended) {
+		const size_t read = fread(chunk.data(), sizeof(DatIndexEntry), CHEAT_DAT_INDEX_READ, dat);
+		for (size_t i = 0; i < read; i++) {
+			if (chunk[i].offset == 0) {
+				ended = true;
+				break;
+			}
+			const CheatIndexEntry entry = {chunk[i].crc32, chunk[i].gameCode, (u32)chunk[i].offset, 0};
+			entries.push_back(entry);
+		}
+		if (read < CHEAT_DAT_INDEX_READ)
+			ended = true;
+	}
+
+	for (size_t i = 0; i < entries.size(); i++) {
+		const u32 end = (i + 1 < entries.size()) ? entries[i + 1].offset : datSize;
+		entries[i].size = end - entries[i].offset;
+	}
+
+	std::stable_sort(entries.begin(), entries.end(), entryLess);
+}
+
+bool cheatIndexFind(FILE *dat, u32 gameCode, u32 crc32, u32 &offset, u32 &size)
+{
+	struct stat st;
+	if (fstat(fileno(dat), &st) != 0)
+		return false;
+
+	CheatIndexHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, cheatIndexMagic, sizeof(cheatIndexMagic));
+	header.datSize = st.st_size;
+	header.cluster = st.st_ino; // libfat reports the first cluster as the inode
+	header.modified = st.st_mtime;
+
+	const char *drive = sdFound() ? "sd" : "fat";
+	char indexPath[64];
+	snprintf(indexPath, sizeof(indexPath), "%s:/_nds/TWiLightMenu/cache/cheats_%08lX.idx", drive, (unsigned long)header.cluster);
+
+	FILE *indexFile = fopen(indexPath, "rb");
+	if (indexFile) {
+		CheatIndexHeader cached;
+		if (fread(&cached, sizeof(cached), 1, indexFile) == 1
+		 && memcmp(cached.magic, cheatIndexMagic, sizeof(cheatIndexMagic)) == 0
+		 && cached.datSize == header.datSize && cached.cluster == header.cluster
+		 && cached.modified == header.modified
+		 && cached.bucketStart[CHEAT_INDEX_BUCKETS] == cached.count) {
+			const u32 bucket = bucketOf(crc32);
+			const u32 start = cached.bucketStart[bucket];
+			const u32 count = cached.bucketStart[bucket + 1] - start;
+
+			bool found = false;
+			if (start <= cached.count && count <= cached.count - start && count > 0) {
+				std::vector<CheatIndexEntry> entries(count);
+				fseek(indexFile, sizeof(cached) + start * sizeof(CheatIndexEntry), SEEK_SET);
+				if (fread(entries.data(), sizeof(CheatIndexEntry), count, indexFile) == count)
+					found = findEntry(entries.data(), count, gameCode, crc32, offset, size);
+			}
+			fclose(indexFile);
+			return found;
+		}
+		fclose(indexFile);
+	}
+
+	// Missing or out of date, so make it again
+	std::vector<CheatIndexEntry> entries;
+	readDatIndex(dat, header.datSize, entries);
+
+	header.count = entries.size();
+	u32 entry = 0;
+	for (u32 bucket = 0; bucket <= CHEAT_INDEX_BUCKETS; bucket++) {
+		while (entry < header.count && bucketOf(entries[entry].crc32) < bucket)
+			entry++;
+		header.bucketStart[bucket] = entry;
+	}
+	header.bucketStart[CHEAT_INDEX_BUCKETS] = header.count;
+
+	snprintf(indexPath, sizeof(indexPath), "%s:/_nds/TWiLightMenu/cache", drive);
+	mkdir(indexPath, 0777);
+	snprintf(indexPath, sizeof(indexPath), "%s:/_nds/TWiLightMenu/cache/cheats_%08lX.idx", drive, (unsigned long)header.cluster);
+	indexFile = fopen(indexPath, "wb");
+	if (indexFile) {
+		if (fwrite(&header, sizeof(header), 1, indexFile) != 1
+		 || fwrite(entries.data(), sizeof(CheatIndexEntry), header.count, indexFile) != header.count) {
+			fclose(indexFile);
+			remove(indexPath);
+		} else {
+			fclose(indexFile);
+		}
+	}
+
+	return findEntry(entries.data(), header.count, gameCode, crc32, offset, size);
+}
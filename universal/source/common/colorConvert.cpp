@@ -0,0 +1,109 @@
+#include "common/colorConvert.h"
+#include <nds/ndstypes.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 8-bit channel value lowered by 4 (if it can be) and cut to 5 bits, for the second deband frame
+struct DebandTable {
+	u8 lowered[256];
+
+	constexpr DebandTable() : lowered() {
+		for (int i = 0; i < 256; i++) {
+			lowered[i] = ((i >= 4) ? i - 4 : i) >> 3;
+		}
+	}
+};
+
+static constexpr DebandTable debandTable;
+
+static inline u16 grayscale(u16 color) {
+	u8 b = (color >> 10) & 31;
+	u8 g = (color >> 5) & 31;
+	u8 r = color & 31;
+	u8 max = (b > g) ? b : g;
+	max = (max > r) ? max : r;
+	u8 min = (b < g) ? b : g;
+	min = (min < r) ? min : r;
+	max = (max + min) / 2;
+	return BIT(15) | (max << 10) | (max << 5) | max;
+}
+
+// Same as alphablend(color, 0, alpha)
+static inline u16 blendOntoBlack(u16 color, u8 alpha) {
+	u16 r = (color & 31) * alpha;
+	u16 g = ((color >> 5) & 31) * alpha;
+	u16 b = ((color >> 10) & 31) * alpha;
+	r = (r + 1 + (r >> 8)) >> 8;
+	g = (g + 1 + (g >> 8)) >> 8;
+	b = (b + 1 + (b >> 8)) >> 8;
+	return BIT(15) | (b << 10) | (g << 5) | r;
+}
+
+static inline u16 finishPixel(u16 color, u8 alpha, u32 flags) {
+	if (flags & COLORCONVERT_GRAYSCALE)
+		color = grayscale(color);
+	if (flags & COLORCONVERT_ALPHA)
+		color = alpha ? blendOntoBlack(color, alpha) : 0;
+	return color;
+}
+
+/**
+ * Convert one pixel to both deband frames (or just the first, if !deband).
+ */
+static inline void convertPixel(const u8 *p, int ri, int bi, bool deband, bool alternate, u32 flags, u16 &out, u16 &out2) {
+	const u8 r = p[ri], g = p[1], b = p[bi];
+	const u8 alpha = (flags & COLORCONVERT_ALPHA) ? p[3] : 0; // Alpha needs 4 bytes per pixel
+	const u16 full = (r >> 3) | (g >> 3) << 5 | (b >> 3) << 10 | BIT(15);
+	if (!deband) {
+		out = finishPixel(full, alpha, flags);
+		return;
+	}
+
+	const u16 lowered = debandTable.lowered[r] | debandTable.lowered[g] << 5 | debandTable.lowered[b] << 10 | BIT(15);
+	out = finishPixel(alternate ? lowered : full, alpha, flags);
+	out2 = finishPixel(alternate ? full : lowered, alpha, flags);
+}
+
+ITCM_CODE void rgbaToBgr555(u16 *dst, u16 *dst2, int dstStride, const u8 *src, u32 width, u32 height, u32 bytesPerPixel, u32 flags) {
+	const bool deband = (dst2 != NULL);
+	const int ri = (flags & COLORCONVERT_SWAP_RB) ? 2 : 0;
+	const int bi = 2 - ri;
+	u16 out0 = 0, out1 = 0, out2 = 0, out3 = 0;
+
+	for (u32 y = 0; y < height; y++) {
+		u16 *row = dst + (int)y * dstStride;
+		u16 *row2 = deband ? dst2 + (int)y * dstStride : row;
+
+		// Pixels alternate along each row, and each row starts where the last one left off, plus one
+		bool alternate = (y * (width + 1)) & 1;
+		u32 x = 0;
+
+		// Two pixels per store, once the row is word aligned in both frames
+		if (((uintptr_t)row ^ (uintptr_t)row2) & 2) {
+			// Frames aren't aligned the same way, so store a pixel at a time
+		} else {
+			if (((uintptr_t)row & 2) && x < width) {
+				convertPixel(src, ri, bi, deband, alternate, flags, out0, out1);
+				row[x] = out0;
+				if (deband) row2[x] = out1;
+				src += bytesPerPixel;
+				alternate = !alternate;
+				x++;
+			}
+			for (; x + 1 < width; x += 2) {
+				convertPixel(src, ri, bi, deband, alternate, flags, out0, out1);
+				convertPixel(src + bytesPerPixel, ri, bi, deband, !alternate, flags, out2, out3);
+				*(u32 *)(row + x) = out0 | (u32)out2 << 16;
+				if (deband) *(u32 *)(row2 + x) = out1 | (u32)out3 << 16;
+				src += bytesPerPixel * 2;
+			}
+		}
+		for (; x < width; x++) {
+			convertPixel(src, ri, bi, deband, alternate, flags, out0, out1);
+			row[x] = out0;
+			if (deband) row2[x] = out1;
+			src += bytesPerPixel;
+			alternate = !alternate;
+		}
+	}
+}
@@ -0,0 +1,57 @@
+#include "common/crc32.h"
+
+#include <stdbool.h>
+
+#define CRC32_POLY 0xEDB88320
+
+/*
+ * Slicing-by-4: crc32Table[0] is the usual byte-at-a-time table, and
+ * crc32Table[n] is the same byte run through n more zero bytes, so a whole
+ * word can be taken with four lookups instead of 32 shifts.
+ */
+static uint32_t crc32Table[4][256];
+static bool crc32TableMade = false;
+
+static void crc32MakeTable(void)
+{
+	for (int i = 0; i < 256; i++) {
+		uint32_t crc = i;
+		for (int bit = 0; bit < 8; bit++)
+			crc = (crc >> 1) ^ ((crc & 1) ? CRC32_POLY : 0);
+		crc32Table[0][i] = crc;
+	}
+	for (int i = 0; i < 256; i++) {
+		for (int n = 1; n < 4; n++)
+			crc32Table[n][i] = (crc32Table[n - 1][i] >> 8) ^ crc32Table[0][crc32Table[n - 1][i] & 0xFF];
+	}
+	crc32TableMade = true;
+}
+
+uint32_t crc32Update(uint32_t crc, const void *buf, size_t size)
+{
+	if (!crc32TableMade)
+		crc32MakeTable();
+
+	const uint8_t *p = (const uint8_t *)buf;
+
+	// Up to a word boundary, then a word at a time (little-endian), then the rest
+	for (; size > 0 && ((uintptr_t)p & 3); size--)
+		crc = (crc >> 8) ^ crc32Table[0][(crc ^ *p++) & 0xFF];
+
+	for (; size >= 4; size -= 4) {
+		crc ^= *(const uint32_t *)p;
+		p += 4;
+		crc = crc32Table[3][crc & 0xFF] ^ crc32Table[2][(crc >> 8) & 0xFF]
+		    ^ crc32Table[1][(crc >> 16) & 0xFF] ^ crc32Table[0][crc >> 24];
+	}
+
+	for (; size > 0; size--)
+		crc = (crc >> 8) ^ crc32Table[0][(crc ^ *p++) & 0xFF];
+
+	return crc;
+}
+
+uint32_t crc32(const char *buf, size_t size)
+{
+	return ~crc32Update(0xFFFFFFFF, buf, size);
+}
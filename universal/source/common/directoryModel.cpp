@@ -0,0 +1,101 @@
+#include "common/directoryModel.h"
+
+#include <ctype.h>
+#include <string.h>
+#include <strings.h>
+
+// The first 4 characters, lowercased the same as strcasecmp() does, with the
+// first in the top byte so the keys compare in the same order as the strings
+static u32 collationKey(const char *str)
+{
+	u32 key = 0;
+	for (int i = 0; i < 4; i++) {
+		key <<= 8;
+		if (*str)
+			key |= (u8)tolower((u8)*str++);
+	}
+	return key;
+}
+
+static const char *extensionOf(const char *name)
+{
+	const char *dot = strrchr(name, '.');
+	return dot ? dot + 1 : name;
+}
+
+// Compare two strings with equal keys. If a key ends within its 4 characters,
+// the strings do too, and are the same.
+static int compareFrom4(u32 key, const char *lhs, const char *rhs)
+{
+	if ((key & 0xFF) == 0)
+		return 0;
+	return strcasecmp(lhs + 4, rhs + 4);
+}
+
+void DirectoryModel::clear(void)
+{
+	_chunks.clear();
+	_chunkUsed = CHUNK_SIZE;
+	_entries.clear();
+}
+
+DirectoryModel::Entry DirectoryModel::newEntry(const char *name, bool isDirectory, int position)
+{
+	// Names never cross into the next chunk, so a new one is started for any that doesn't fit
+	size_t length = strnlen(name, CHUNK_SIZE - 1);
+	if (_chunkUsed + length + 1 > CHUNK_SIZE) {
+		_chunks.emplace_back(new char[CHUNK_SIZE]);
+		_chunkUsed = 0;
+	}
+
+	char *chunk = _chunks.back().get();
+	memcpy(chunk + _chunkUsed, name, length);
+	chunk[_chunkUsed + length] = '\0';
+
+	Entry entry;
+	entry.nameOffset = ((_chunks.size() - 1) * CHUNK_SIZE) + _chunkUsed;
+	entry.isDirectory = isDirectory;
+	entry.customPos = false;
+	entry.position = position;
+	entry.nameKey = collationKey(chunk + _chunkUsed);
+	entry.extensionKey = collationKey(extensionOf(chunk + _chunkUsed));
+	_chunkUsed += length + 1;
+	return entry;
+}
+
+void DirectoryModel::add(const char *name, bool isDirectory, int position)
+{
+	_entries.push_back(newEntry(name, isDirectory, position));
+}
+
+void DirectoryModel::insert(size_t index, const char *name, bool isDirectory, int position)
+{
+	_entries.insert(_entries.begin() + index, newEntry(name, isDirectory, position));
+}
+
+void DirectoryModel::erase(size_t index)
+{
+	// The name stays in its chunk until the listing is cleared
+	_entries.erase(_entries.begin() + index);
+}
+
+void DirectoryModel::move(size_t from, size_t to)
+{
+	const Entry entry = _entries[from];
+	_entries.erase(_entries.begin() + from);
+	_entries.insert(_entries.begin() + to, entry);
+}
+
+int DirectoryModel::compareNames(const Entry &lhs, const Entry &rhs) const
+{
+	if (lhs.nameKey != rhs.nameKey)
+		return (lhs.nameKey < rhs.nameKey) ? -1 : 1;
+	return compareFrom4(lhs.nameKey, name(lhs), name(rhs));
+}
+
+int DirectoryModel::compareExtensions(const Entry &lhs, const Entry &rhs) const
+{
+	if (lhs.extensionKey != rhs.extensionKey)
+		return (lhs.extensionKey < rhs.extensionKey) ? -1 : 1;
+	return compareFrom4(lhs.extensionKey, extensionOf(name(lhs)), extensionOf(name(rhs)));
+}
@@ -0,0 +1,139 @@
+#include "common/fileType.h"
+
+#include <algorithm>
+#include <ctype.h>
+#include <string.h>
+#include <strings.h>
+
+struct FileTypeEntry {
+	const char *extension;
+	FileType type;
+};
+
+static constexpr FileTypeEntry fileTypes[] = {
+	{"nds", {0, 0}}, {"dsi", {0, 0}}, {"ids", {0, 0}}, {"srl", {0, 0}}, {"app", {0, 0}}, {"argv", {0, 0}},
+	{"xex", {10, 0}}, {"atr", {10, 0}}, {"a26", {10, 0}}, {"a52", {10, 0}}, {"a78", {10, 0}},
+	{"col", {13, 0}},
+	{"m5", {14, 0}},
+	{"int", {12, 0}},
+	{"plg", {9, 0}},
+	{"avi", {19, 2}}, {"rvid", {19, 2}}, {"fv", {19, 2}},
+	{"gif", {20, -1}}, {"bmp", {20, -1}}, {"png", {20, -1}},
+	{"agb", {1, 1}}, {"gba", {1, 1}}, {"mb", {1, 1}},
+	{"gb", {2, 1}}, {"sgb", {2, 1}},
+	{"gbc", {3, 1}},
+	{"nes", {4, 2}},
+	{"fds", {4, 1}},
+	{"sg", {15, 2}},
+	{"sms", {5, 2}},
+	{"gg", {6, 2}},
+	{"gen", {7, 2}},
+	{"smc", {8, 3}},
+	{"sfc", {8, 2}},
+	{"pce", {11, 0}},
+	{"ws", {16, 0}}, {"wsc", {16, 0}},
+	{"ngp", {17, 0}}, {"ngc", {17, 0}},
+	{"dsk", {18, 0}},
+};
+
+static const FileType unknownFileType = {9, -1};
+
+// A power of 2, at least twice the number of extensions
+#define FILE_TYPE_SLOTS 128
+#define FILE_TYPE_SLOT_BITS 7
+
+static_assert(FILE_TYPE_SLOTS >= sizeof(fileTypes) / sizeof(fileTypes[0]) * 2, "Too many file types for the table");
+
+// The extensions in fileTypes are already lowercase
+static constexpr u32 keyOf(const char *extension)
+{
+	u32 key = 0;
+	for (int i = 0; i < 4 && extension[i]; i++)
+		key |= (u32)(u8)extension[i] << (i * 8);
+	return key;
+}
+
+static constexpr u32 slotOf(u32 key)
+{
+	return (u32)(key * 0x9E3779B1u) >> (32 - FILE_TYPE_SLOT_BITS);
+}
+
+struct FileTypeTable {
+	u32 keys[FILE_TYPE_SLOTS];	// 0 for an empty slot
+	FileType types[FILE_TYPE_SLOTS];
+};
+
+static constexpr FileTypeTable makeFileTypeTable(void)
+{
+	FileTypeTable table{};
+	for (const FileTypeEntry &entry : fileTypes) {
+		const u32 key = keyOf(entry.extension);
+		u32 slot = slotOf(key);
+		while (table.keys[slot] != 0)
+			slot = (slot + 1) & (FILE_TYPE_SLOTS - 1);
+		table.keys[slot] = key;
+		table.types[slot] = entry.type;
+	}
+	return table;
+}
+
+static constexpr FileTypeTable fileTypeTable = makeFileTypeTable();
+
+u32 fileExtensionKey(const char *name)
+{
+	const char *dot = strrchr(name, '.');
+	if (!dot || dot[1] == '\0')
+		return 0;
+
+	u32 key = 0;
+	for (int i = 0; dot[i + 1]; i++) {
+		if (i == 4)
+			return 0;
+		key |= (u32)(u8)tolower((u8)dot[i + 1]) << (i * 8);
+	}
+	return key;
+}
+
+const FileType &fileTypeOf(const char *name)
+{
+	const u32 key = fileExtensionKey(name);
+	if (key == 0)
+		return unknownFileType;
+
+	for (u32 slot = slotOf(key); fileTypeTable.keys[slot] != 0; slot = (slot + 1) & (FILE_TYPE_SLOTS - 1)) {
+		if (fileTypeTable.keys[slot] == key)
+			return fileTypeTable.types[slot];
+	}
+	return unknownFileType;
+}
+
+FileExtensionSet::FileExtensionSet(const std::vector<std::string_view> &extensions)
+{
+	for (const std::string_view &extension : extensions) {
+		u32 key = 0;
+		if (extension.size() >= 2 && extension.size() <= 5 && extension[0] == '.' && extension.find('.', 1) == extension.npos) {
+			for (size_t i = 1; i < extension.size(); i++)
+				key |= (u32)(u8)tolower((u8)extension[i]) << ((i - 1) * 8);
+		}
+		if (key != 0)
+			_keys.push_back(key);
+		else
+			_longExtensions.push_back(extension);
+	}
+	std::sort(_keys.begin(), _keys.end());
+}
+
+bool FileExtensionSet::matches(const char *name) const
+{
+	// Not a name that's only the extension
+	const u32 key = (strrchr(name, '.') != name) ? fileExtensionKey(name) : 0;
+	if (key != 0 && std::binary_search(_keys.begin(), _keys.end(), key))
+		return true;
+
+	const size_t length = strlen(name);
+	for (const std::string_view &extension : _longExtensions) {
+		if (length > extension.size() && strncasecmp(name + length - extension.size(), extension.data(), extension.size()) == 0)
+			return true;
+	}
+	return false;
+}
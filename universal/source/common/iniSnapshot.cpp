@@ -0,0 +1,213 @@
+#include "common/iniSnapshot.h"
+#include "common/fnv1a.h"
+#include "common/inifile.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+// FAT only keeps modification times to 2 seconds, so an .ini changed twice
+// within that, to the same size, would look unchanged. A snapshot is only
+// written once the .ini has been left alone for longer than that, so any
+// change after it has a later time.
+#define INI_SNAPSHOT_SETTLE 2
+
+static const char iniSnapshotMagic[4] = {'I', 'N', 'S', '1'};
+
+// Then the hashes of each item's key, in order, the offset of each item from
+// the end of the offsets, and the items. An item is a byte for whether it's
+// in the .ini, "Section\nItem", and its value, each ending with a 0.
+struct IniSnapshotHeader {
+	char magic[4];
+	u32 iniSize;
+	u32 iniCluster;
+	u32 iniModified;
+	u32 count;
+	u32 size;	// Of everything after the header
+	u32 check;	// FNV-1a of everything after the header
+};
+
+static u32 itemHash(const std::string &Section, const std::string &Item)
+{
+	u32 hash = fnv1aHash(Section.c_str());
+	hash = fnv1aHash("\n", hash);
+	return fnv1aHash(Item.c_str(), hash);
+}
+
+static bool itemMatches(const char *key, const std::string &Section, const std::string &Item)
+{
+	const size_t length = Section.length();
+	return strncmp(key, Section.c_str(), length) == 0 && key[length] == '\n' && strcmp(key + length + 1, Item.c_str()) == 0;
+}
+
+IniSnapshot::IniSnapshot(const char *iniPath, const char *name)
+	: _iniPath(iniPath), _iniFound(false), _iniSize(0), _iniCluster(0), _iniModified(0), _snapshot(NULL), _count(0), _ini(NULL)
+{
+	const char *colon = strchr(iniPath, ':');
+	const std::string drive(iniPath, colon ? colon - iniPath + 1 : 0);
+	_snapshotPath = drive + "/_nds/TWiLightMenu/cache/" + name + ".bin";
+
+	struct stat st;
+	if (stat(iniPath, &st) != 0)
+		return;
+	_iniFound = true;
+	_iniSize = st.st_size;
+	_iniCluster = st.st_ino; // libfat reports the first cluster as the inode
+	_iniModified = st.st_mtime;
+
+	FILE *file = fopen(_snapshotPath.c_str(), "rb");
+	if (!file)
+		return;
+
+	fseek(file, 0, SEEK_END);
+	const long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	u8 *snapshot = (size > (long)sizeof(IniSnapshotHeader)) ? (u8 *)malloc(size) : NULL;
+	const bool read = snapshot && fread(snapshot, 1, size, file) == (size_t)size;
+	fclose(file);
+
+	const IniSnapshotHeader *header = (const IniSnapshotHeader *)snapshot;
+	const u8 *data = snapshot + sizeof(IniSnapshotHeader);
+	bool ok = read && memcmp(header->magic, iniSnapshotMagic, sizeof(iniSnapshotMagic)) == 0
+		&& header->iniSize == _iniSize && header->iniCluster == _iniCluster && header->iniModified == _iniModified
+		&& header->size == size - sizeof(IniSnapshotHeader) && header->count <= header->size / 8
+		&& header->check == fnv1aHash(data, header->size) && data[header->size - 1] == 0;
+
+	// Every item has to start inside the snapshot
+	const u32 itemsSize = ok ? header->size - (header->count * 8) : 0;
+	const u32 *offsets = (const u32 *)data + (ok ? header->count : 0);
+	for (u32 i = 0; ok && i < header->count; i++)
+		ok = (offsets[i] < itemsSize);
+
+	if (!ok) {
+		free(snapshot);
+		return;
+	}
+	_snapshot = snapshot;
+	_count = header->count;
+}
+
+IniSnapshot::~IniSnapshot()
+{
+	free(_snapshot);
+	delete _ini;
+}
+
+const char *IniSnapshot::find(const std::string &Section, const std::string &Item)
+{
+	const u32 hash = itemHash(Section, Item);
+
+	if (_snapshot) {
+		const u32 *hashes = (const u32 *)(_snapshot + sizeof(IniSnapshotHeader));
+		const u32 *offsets = hashes + _count;
+		const char *items = (const char *)(offsets + _count);
+		for (const u32 *it = std::lower_bound(hashes, hashes + _count, hash); it < hashes + _count && *it == hash; it++) {
+			const char *item = items + offsets[it - hashes];
+			if (itemMatches(item + 1, Section, Item))
+				return item[0] ? item + 1 + strlen(item + 1) + 1 : NULL;
+		}
+	}
+
+	for (size_t i = 0; i < _newItems.size(); i++) {
+		const NewItem &item = _newItems[i];
+		if (item.hash == hash && itemMatches(item.key.c_str(), Section, Item))
+			return item.found ? item.value.c_str() : NULL;
+	}
+
+	// Not in the snapshot, so read it from the .ini
+	if (!_ini)
+		_ini = new CIniFile(_iniPath);
+
+	NewItem item;
+	item.hash = hash;
+	item.key = Section + '\n' + Item;
+	item.found = _ini->GetFileValue(Section, Item, item.value);
+	_newItems.push_back(item);
+	return _newItems.back().found ? _newItems.back().value.c_str() : NULL;
+}
+
+std::string IniSnapshot::GetString(const std::string &Section, const std::string &Item, const std::string &DefaultValue)
+{
+	const char *value = find(Section, Item);
+	return value ? std::string(value) : DefaultValue;
+}
+
+int IniSnapshot::GetInt(const std::string &Section, const std::string &Item, int DefaultValue)
+{
+	const char *value = find(Section, Item);
+	if (!value)
+		return DefaultValue;
+	// The same as CIniFile::GetInt()
+	if (strlen(value) > 2 && '0' == value[0] && ('x' == value[1] || 'X' == value[1]))
+		return strtol(value, NULL, 16);
+	return strtol(value, NULL, 10);
+}
+
+void IniSnapshot::SaveSnapshot(void)
+{
+	if (_newItems.empty() || !_iniFound || time(NULL) < (time_t)_iniModified + INI_SNAPSHOT_SETTLE)
+		return;
+
+	// Everything already in the snapshot, then everything new, sorted by hash
+	std::vector<std::pair<u32, std::string>> items;
+	items.reserve(_count + _newItems.size());
+	if (_snapshot) {
+		const u32 *hashes = (const u32 *)(_snapshot + sizeof(IniSnapshotHeader));
+		const u32 *offsets = hashes + _count;
+		const char *data = (const char *)(offsets + _count);
+		for (u32 i = 0; i < _count; i++) {
+			const char *item = data + offsets[i];
+			size_t length = 1 + strlen(item + 1) + 1;
+			if (item[0])
+				length += strlen(item + length) + 1;
+			items.push_back(std::make_pair(hashes[i], std::string(item, length)));
+		}
+	}
+	for (size_t i = 0; i < _newItems.size(); i++) {
+		const NewItem &item = _newItems[i];
+		std::string record(1, item.found ? 1 : 0);
+		record += item.key;
+		record += '\0';
+		if (item.found) {
+			record += item.value;
+			record += '\0';
+		}
+		items.push_back(std::make_pair(item.hash, record));
+	}
+	std::stable_sort(items.begin(), items.end(), [](const std::pair<u32, std::string> &a, const std::pair<u32, std::string> &b) {
+		return a.first < b.first;
+	});
+
+	std::vector<u32> table(items.size() * 2);
+	std::string data;
+	for (size_t i = 0; i < items.size(); i++) {
+		table[i] = items[i].first;
+		table[items.size() + i] = data.size();
+		data += items[i].second;
+	}
+
+	IniSnapshotHeader header;
+	memcpy(header.magic, iniSnapshotMagic, sizeof(iniSnapshotMagic));
+	header.iniSize = _iniSize;
+	header.iniCluster = _iniCluster;
+	header.iniModified = _iniModified;
+	header.count = items.size();
+	header.size = (table.size() * sizeof(u32)) + data.size();
+	header.check = fnv1aHash(table.data(), table.size() * sizeof(u32));
+	header.check = fnv1aHash(data.data(), data.size(), header.check);
+
+	const size_t cacheEnd = _snapshotPath.rfind('/');
+	mkdir(_snapshotPath.substr(0, cacheEnd).c_str(), 0777);
+
+	FILE *file = fopen(_snapshotPath.c_str(), "wb");
+	if (!file)
+		return;
+	fwrite(&header, sizeof(header), 1, file);
+	fwrite(table.data(), sizeof(u32), table.size(), file);
+	fwrite(data.data(), 1, data.size(), file);
+	fclose(file);
+}
@@ -26,44 +26,14 @@
 
 bool gbar2Fix = false;
 
-static bool freadLine(FILE *f, std::string &str)
+// Returns the length of the key in an "Item = Value" line, or npos if the line has no '='.
+static size_t itemKeyEnd(const std::string &strline)
 {
-	str.clear();
-__read:
-	char p = 0;
-
-	size_t readed = fread(&p, 1, 1, f);
-	if (0 == readed) {
-		str = "";
-		return false;
-	}
-	if ('\n' == p || '\r' == p) {
-		str = "";
-		return true;
-	}
-
-	while (p != '\n' && p != '\r' && readed) {
-		str += p;
-		readed = fread(&p, 1, 1, f);
-	}
-
-	if (str.empty() || "" == str) {
-		goto __read;
-	}
-
-	return true;
-}
-
-static void trimString(std::string &str)
-{
-	size_t first = str.find_first_not_of(" \t"), last;
-	if (first == str.npos) {
-		str = "";
-	} else {
-		last = str.find_last_not_of(" \t");
-		if (first > 0 || (last + 1) < str.length())
-			str = str.substr(first, last - first + 1);
-	}
+	size_t equalsignPos = strline.find('=');
+	if (equalsignPos == strline.npos)
+		return strline.npos;
+	size_t last = equalsignPos ? strline.find_last_not_of(" \t", equalsignPos - 1) : strline.npos;
+	return (last == strline.npos) ? 0 : last + 1;
 }
 
 CIniFile::CIniFile()
@@ -122,6 +92,12 @@ std::string CIniFile::GetString(const std::string &Section, const std::string &I
 	return temp;
 }
 
+bool CIniFile::GetFileValue(const std::string &Section, const std::string &Item, std::string &Value)
+{
+	Value = GetFileString(Section, Item);
+	return m_bLastResult;
+}
+
 void CIniFile::GetStringVector(const std::string &Section, const std::string &Item, std::vector<std::string> &strings, char delimiter)
 {
 	std::string strValue = GetFileString(Section, Item);
@@ -181,23 +157,44 @@ bool CIniFile::LoadIniFile(const std::string &FileName)
 	if (NULL == f)
 		return false;
 
+	// Pull the whole file in with a single read, instead of a byte at a time
+	fseek(f, 0, SEEK_END);
+	long fileSize = ftell(f);
+	fseek(f, 0, SEEK_SET);
+
+	std::string buffer;
+	if (fileSize > 0) {
+		buffer.resize(fileSize);
+		buffer.resize(fread(&buffer[0], 1, fileSize, f));
+	}
+
+	fclose(f);
+
+	size_t pos = 0;
 	//check for utf8 bom.
-	char bom[3];
-	if (fread(bom, 3, 1, f) == 1 && bom[0] == 0xef && bom[1] == 0xbb && bom[2] == 0xbf)
-		;
-	else
-		fseek(f, 0, SEEK_SET);
+	if (buffer.size() >= 3 && (unsigned char)buffer[0] == 0xef && (unsigned char)buffer[1] == 0xbb && (unsigned char)buffer[2] == 0xbf)
+		pos = 3;
 
-	std::string strline("");
 	m_FileContainer.clear();
 
-	while (freadLine(f, strline)) {
-		trimString(strline);
-		if (strline != "" && ';' != strline[0] && '/' != strline[0] && '!' != strline[0])
-			m_FileContainer.push_back(strline);
+	const size_t bufferSize = buffer.size();
+	while (pos < bufferSize) {
+		size_t lineEnd = buffer.find_first_of("\r\n", pos);
+		if (lineEnd == buffer.npos)
+			lineEnd = bufferSize;
+
+		size_t first = buffer.find_first_not_of(" \t", pos);
+		if (first < lineEnd) {
+			size_t last = buffer.find_last_not_of(" \t", lineEnd - 1);
+			const char c = buffer[first];
+			if (';' != c && '/' != c && '!' != c)
+				m_FileContainer.push_back(buffer.substr(first, last - first + 1));
+		}
+
+		pos = lineEnd + 1;
 	}
 
-	fclose(f);
+	BuildIndex();
 
 	m_bLastResult = false;
 	m_bModified = false;
@@ -224,20 +221,23 @@ bool CIniFile::SaveIniFile(const std::string &FileName)
 		return false;
 	}
 
+	const char *newLine = (gbar2Fix ? "\n" : "\r\n");
+
+	// Build the whole file in memory, then write it out in one go
+	std::string buffer;
 	for (size_t ii = 0; ii < m_FileContainer.size(); ii++) {
-		std::string &strline = m_FileContainer[ii];
+		const std::string &strline = m_FileContainer[ii];
 		size_t notSpace = strline.find_first_not_of(' ');
-		strline = strline.substr(notSpace);
-		if (strline.find('[') == 0 && ii > 0) {
-			if (!m_FileContainer[ii - 1].empty() && m_FileContainer[ii - 1] != "")
-				fwrite((gbar2Fix ? "\n" : "\r\n"), 1, 2-gbar2Fix, f);
-		}
-		if (!strline.empty() && strline != "") {
-			fwrite(strline.c_str(), 1, strline.length(), f);
-			fwrite((gbar2Fix ? "\n" : "\r\n"), 1, 2-gbar2Fix, f);
+		if (notSpace == strline.npos)
+			continue;
+		if (strline[notSpace] == '[' && ii > 0) {
+			buffer += newLine;
 		}
+		buffer.append(strline, notSpace, strline.npos);
+		buffer += newLine;
 	}
 
+	fwrite(buffer.c_str(), 1, buffer.length(), f);
 	fclose(f);
 
 	m_bModified = false;
@@ -245,121 +245,114 @@ bool CIniFile::SaveIniFile(const std::string &FileName)
 	return true;
 }
 
-std::string CIniFile::GetFileString(const std::string &Section, const std::string &Item)
+std::string CIniFile::ItemKey(const std::string &Section, const std::string &Item)
 {
-	std::string strline;
+	std::string key;
+	key.reserve(Section.length() + Item.length() + 1);
+	key += Section;
+	key += '\n'; // Can never appear in a loaded line
+	key += Item;
+	return key;
+}
+
+void CIniFile::BuildIndex(void)
+{
+	m_Cache.clear();
+	m_Items.clear();
+
+	SectionInfo *section = NULL;
 	std::string strSection;
-	std::string strItem;
-	std::string strValue;
 
-	size_t ii = 0;
-	size_t iFileLines = m_FileContainer.size();
+	const size_t iFileLines = m_FileContainer.size();
+	for (size_t ii = 0; ii < iFileLines; ii++) {
+		const std::string &strline = m_FileContainer[ii];
 
-	if (m_bReadOnly) {
-		SectionCache::iterator it = m_Cache.find(Section);
-		if ((it != m_Cache.end()))
-			ii = it->second;
-	}
+		size_t keyEnd = itemKeyEnd(strline);
+		if (section && keyEnd != strline.npos) {
+			m_Items.emplace(ItemKey(strSection, strline.substr(0, keyEnd)), ii);
+			section->end = ii + 1;
+			continue;
+		}
 
-	m_bLastResult = false;
+		if ('[' != strline[0]) {
+			if (section)
+				section->end = ii + 1;
+			continue;
+		}
 
-	if (iFileLines >= 0) {
-		while (ii < iFileLines) {
-			strline = m_FileContainer[ii++];
-
-			size_t rBracketPos = 0;
-			if ('[' == strline[0])
-				rBracketPos = strline.find(']');
-			if (rBracketPos > 0 && rBracketPos != std::string::npos) {
-				strSection = strline.substr(1, rBracketPos - 1);
-				if (m_bReadOnly)
-					m_Cache.insert(std::make_pair(strSection, ii - 1));
-				if (strSection == Section) {
-					while (ii < iFileLines) {
-						strline = m_FileContainer[ii++];
-						size_t equalsignPos = strline.find('=');
-						if (equalsignPos != strline.npos) {
-							size_t last = equalsignPos ? strline.find_last_not_of(" \t", equalsignPos - 1) : strline.npos;
-							if (last == strline.npos)
-								strItem = "";
-							else
-								strItem = strline.substr(0, last + 1);
-
-							if (strItem == Item) {
-								size_t first = strline.find_first_not_of(" \t", equalsignPos + 1);
-								if (first == strline.npos)
-									strValue = "";
-								else
-									strValue = strline.substr(first);
-								m_bLastResult = true;
-								return strValue;
-							}
-						} else if ('[' == strline[0]) {
-							break;
-						}
-					}
-					break;
-				}
-			}
+		// Any line starting with '[' ends the current section
+		section = NULL;
+		size_t rBracketPos = strline.find(']');
+		if (rBracketPos > 0 && rBracketPos != std::string::npos) {
+			strSection = strline.substr(1, rBracketPos - 1);
+			// Only the first section with a given name is searched, as before
+			std::pair<SectionCache::iterator, bool> res = m_Cache.emplace(strSection, SectionInfo{ii, ii + 1});
+			if (res.second)
+				section = &res.first->second;
 		}
 	}
-	return std::string("");
 }
 
-void CIniFile::SetFileString(const std::string &Section, const std::string &Item, const std::string &Value)
+std::string CIniFile::GetFileString(const std::string &Section, const std::string &Item)
 {
-	std::string strline;
-	std::string strSection;
-	std::string strItem;
+	m_bLastResult = false;
 
+	ItemCache::const_iterator it = m_Items.find(ItemKey(Section, Item));
+	if (it == m_Items.end())
+		return std::string("");
+
+	const std::string &strline = m_FileContainer[it->second];
+	size_t first = strline.find_first_not_of(" \t", strline.find('=') + 1);
+	m_bLastResult = true;
+	if (first == strline.npos)
+		return std::string("");
+	return strline.substr(first);
+}
+
+void CIniFile::SetFileString(const std::string &Section, const std::string &Item, const std::string &Value)
+{
 	if (m_bReadOnly)
 		return;
 
-	size_t ii = 0;
-	size_t iFileLines = m_FileContainer.size();
-
-	while (ii < iFileLines) {
-		strline = m_FileContainer[ii++];
+	const std::string strline = Item + (gbar2Fix ? "=" : " = ") + Value;
+	const std::string key = ItemKey(Section, Item);
 
-		size_t rBracketPos = 0;
-		if ('[' == strline[0])
-			rBracketPos = strline.find(']');
-		if (rBracketPos > 0 && rBracketPos != std::string::npos) {
-			strSection = strline.substr(1, rBracketPos - 1);
-			if (strSection == Section) {
-				while (ii < iFileLines) {
-					strline = m_FileContainer[ii++];
-					size_t equalsignPos = strline.find('=');
-					if (equalsignPos != strline.npos) {
-						size_t last = equalsignPos ? strline.find_last_not_of(" \t", equalsignPos - 1) : strline.npos;
-						if (last == strline.npos)
-							strItem = "";
-						else
-							strItem = strline.substr(0, last + 1);
-
-						if (Item == strItem) {
-							ReplaceLine(ii - 1, Item + (gbar2Fix ? "=" : " = ") + Value);
-							return;
-						}
-					} else if ('[' == strline[0]) {
-						InsertLine(ii - 1, Item + (gbar2Fix ? "=" : " = ") + Value);
-						return;
-					}
-				}
-				InsertLine(ii, Item + (gbar2Fix ? "=" : " = ") + Value);
-				return;
-			}
-		}
+	ItemCache::const_iterator it = m_Items.find(key);
+	if (it != m_Items.end()) {
+		ReplaceLine(it->second, strline);
+		return;
 	}
 
-	InsertLine(ii, "[" + Section + "]");
-	InsertLine(ii + 1, Item + (gbar2Fix ? "=" : " = ") + Value);
-	return;
+	size_t line;
+	SectionCache::iterator sec = m_Cache.find(Section);
+	if (sec != m_Cache.end()) {
+		line = sec->second.end;
+		InsertLine(line, strline);
+	} else {
+		// Appending at the end of the file, so nothing needs shifting
+		m_FileContainer.push_back("[" + Section + "]");
+		m_FileContainer.push_back(strline);
+		line = m_FileContainer.size() - 1;
+		m_Cache.emplace(Section, SectionInfo{line - 1, line + 1});
+	}
+	m_Items.emplace(key, line);
 }
 
 bool CIniFile::InsertLine(size_t line, const std::string &str)
 {
 	m_FileContainer.insert(m_FileContainer.begin() + line, str);
+
+	// Keep the index valid by shifting everything at or after the new line
+	for (ItemCache::iterator it = m_Items.begin(); it != m_Items.end(); ++it) {
+		if (it->second >= line)
+			it->second++;
+	}
+	for (SectionCache::iterator it = m_Cache.begin(); it != m_Cache.end(); ++it) {
+		if (it->second.header >= line)
+			it->second.header++;
+		if (it->second.end >= line)
+			it->second.end++;
+	}
 	return true;
 }
 
@@ -0,0 +1,67 @@
+#include "common/langPack.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char langPackMagic[4] = {'L', 'N', 'G', '1'};
+
+struct LangPackHeader {
+	char magic[4];
+	u32 idsHash;
+	u32 count;
+	// Then the offset of each string from the start of the pack
+};
+
+LangPack::~LangPack()
+{
+	free(_data);
+}
+
+bool LangPack::load(const char *path, u32 idsHash, u32 count)
+{
+	FILE *file = fopen(path, "rb");
+	if (!file)
+		return false;
+
+	fseek(file, 0, SEEK_END);
+	const long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	const u32 stringsStart = sizeof(LangPackHeader) + (count * sizeof(u32));
+	if (size <= (long)stringsStart) {
+		fclose(file);
+		return false;
+	}
+
+	u8 *data = (u8 *)malloc(size);
+	if (!data) {
+		fclose(file);
+		return false;
+	}
+	const bool read = (fread(data, 1, size, file) == (size_t)size);
+	fclose(file);
+
+	// Every string has to be inside the pack, and end before it does
+	const LangPackHeader *header = (const LangPackHeader *)data;
+	bool ok = read && memcmp(header->magic, langPackMagic, sizeof(langPackMagic)) == 0
+		&& header->idsHash == idsHash && header->count == count && data[size - 1] == 0;
+	const u32 *offsets = (const u32 *)(header + 1);
+	for (u32 i = 0; ok && i < count; i++)
+		ok = (offsets[i] >= stringsStart && offsets[i] < (u32)size);
+
+	if (!ok) {
+		free(data);
+		return false;
+	}
+
+	free(_data);
+	_data = data;
+	return true;
+}
+
+const char *LangPack::get(u32 id) const
+{
+	const u32 *offsets = (const u32 *)((const LangPackHeader *)_data + 1);
+	return (const char *)_data + offsets[id];
+}
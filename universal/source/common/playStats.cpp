@@ -0,0 +1,343 @@
+#include "common/playStats.h"
+#include "common/flashcard.h"
+#include "common/fnv1a.h"
+
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define PLAYSTATS_MIN_CAPACITY 64
+#define PLAYSTATS_MAX_CAPACITY 0x10000
+
+// For the second hashes, so they don't collide where the first ones do
+#define PLAYSTATS_HASH2_BASIS 0x050C5D1F
+
+static_assert(sizeof(PlayStats::Header) == 32, "PlayStats::Header must be 32 bytes");
+static_assert(sizeof(PlayStats::Record) == 16, "PlayStats::Record must be 16 bytes");
+
+static const char playStatsMagic[4] = {'P', 'S', 'T', '1'};
+
+typedef PlayStats::Header Header;
+typedef PlayStats::Record Record;
+
+static inline u32 hash2(const char *str)
+{
+	return fnv1aHash(str, PLAYSTATS_HASH2_BASIS) | 1;
+}
+
+static inline const char *statsDrive(void)
+{
+	return sdFound() ? "sd" : "fat";
+}
+
+static std::string statsPath(const char *dirPath)
+{
+	char path[64];
+	snprintf(path, sizeof(path), "%s:/_nds/TWiLightMenu/extras/playstats/%08lX.bin", statsDrive(), (unsigned long)fnv1aHash(dirPath));
+	return path;
+}
+
+static void initHeader(Header &header, const char *dirPath)
+{
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, playStatsMagic, sizeof(playStatsMagic));
+	header.dirHash2 = hash2(dirPath);
+}
+
+// The name's slot, or the empty one it would go in, or records.size() if
+// it isn't there and there's no room for it
+static u32 findSlot(const std::vector<Record> &records, u32 nameHash, u32 nameHash2)
+{
+	const u32 mask = records.size() - 1;
+	u32 i = nameHash & mask;
+	for (u32 probe = 0; probe < records.size(); probe++, i = (i + 1) & mask) {
+		const Record &record = records[i];
+		if (record.nameHash2 == 0 || (record.nameHash == nameHash && record.nameHash2 == nameHash2))
+			return i;
+	}
+	return records.size();
+}
+
+static u32 usedSlots(const std::vector<Record> &records)
+{
+	u32 used = 0;
+	for (const Record &record : records) {
+		if (record.nameHash2 != 0)
+			used++;
+	}
+	return used;
+}
+
+static void resize(Header &header, std::vector<Record> &records, u32 capacity)
+{
+	std::vector<Record> old;
+	old.swap(records);
+	records.assign(capacity, Record{0, 0, 0, 0});
+	for (const Record &record : old) {
+		if (record.nameHash2 != 0)
+			records[findSlot(records, record.nameHash, record.nameHash2)] = record;
+	}
+	header.capacity = capacity;
+}
+
+static void writeStats(const char *path, const Header &header, const std::vector<Record> &records)
+{
+	FILE *file = fopen(path, "wb");
+	if (!file)
+		return;
+	fwrite(&header, sizeof(Header), 1, file);
+	fwrite(records.data(), sizeof(Record), records.size(), file);
+	fclose(file);
+}
+
+// Call item() with each item in the .ini, as CIniFile reads them
+template <class F>
+static void readIniItems(const char *iniPath, F item)
+{
+	FILE *file = fopen(iniPath, "rb");
+	if (!file)
+		return;
+	fseek(file, 0, SEEK_END);
+	const long fileSize = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	std::string buffer;
+	if (fileSize > 0) {
+		buffer.resize(fileSize);
+		buffer.resize(fread(&buffer[0], 1, fileSize, file));
+	}
+	fclose(file);
+
+	std::string section;
+	bool inSection = false;
+	size_t pos = 0;
+	while (pos < buffer.size()) {
+		size_t lineEnd = buffer.find_first_of("\r\n", pos);
+		if (lineEnd == buffer.npos)
+			lineEnd = buffer.size();
+		const size_t first = buffer.find_first_not_of(" \t", pos);
+		pos = lineEnd + 1;
+		if (first >= lineEnd || buffer[first] == ';' || buffer[first] == '/' || buffer[first] == '!')
+			continue;
+		const std::string line = buffer.substr(first, buffer.find_last_not_of(" \t", lineEnd - 1) - first + 1);
+
+		const size_t equals = line.find('=');
+		if (inSection && equals != line.npos) {
+			const size_t keyEnd = equals ? line.find_last_not_of(" \t", equals - 1) : line.npos;
+			const size_t valueStart = line.find_first_not_of(" \t", equals + 1);
+			item(section, line.substr(0, keyEnd == line.npos ? 0 : keyEnd + 1), valueStart == line.npos ? std::string() : line.substr(valueStart));
+		} else if (line[0] == '[') {
+			const size_t end = line.find(']');
+			inSection = (end > 0 && end != line.npos);
+			if (inSection)
+				section = line.substr(1, end - 1);
+		}
+	}
+}
+
+// Copy recentlyplayed.ini and timesplayed.ini into a file for each directory in them
+static void migrateIni(void)
+{
+	struct Played {
+		u32 lastPlayed;
+		u32 timesPlayed;
+		bool timesFound;
+	};
+	struct Dir {
+		u32 clock;
+		std::map<std::string, Played> files;
+	};
+	std::map<std::string, Dir> dirs;
+
+	char iniPath[64];
+	snprintf(iniPath, sizeof(iniPath), "%s:/_nds/TWiLightMenu/extras/timesplayed.ini", statsDrive());
+	readIniItems(iniPath, [&](const std::string &section, const std::string &key, const std::string &value) {
+		Played &played = dirs[section].files[key];
+		// CIniFile took the first of a name written twice
+		if (played.timesFound)
+			return;
+		played.timesFound = true;
+		const bool hex = (value.size() > 2 && value[0] == '0' && (value[1] == 'x' || value[1] == 'X'));
+		played.timesPlayed = strtol(value.c_str(), NULL, hex ? 16 : 10);
+	});
+
+	// The most recent first, each separated by a ':'
+	snprintf(iniPath, sizeof(iniPath), "%s:/_nds/TWiLightMenu/extras/recentlyplayed.ini", statsDrive());
+	readIniItems(iniPath, [&](const std::string &section, const std::string &key, const std::string &value) {
+		if (section != "RECENT")
+			return;
+		Dir &dir = dirs[key];
+		if (dir.clock != 0)
+			return;
+		std::vector<std::string> names;
+		size_t start = 0;
+		while (start <= value.size()) {
+			size_t end = value.find(':', start);
+			if (end == value.npos)
+				end = value.size();
+			if (end > start)
+				names.push_back(value.substr(start, end - start));
+			start = end + 1;
+		}
+		dir.clock = names.size();
+		for (size_t i = 0; i < names.size(); i++) {
+			Played &played = dir.files[names[i]];
+			if (played.lastPlayed == 0)
+				played.lastPlayed = names.size() - i;
+		}
+	});
+
+	for (const auto &dir : dirs) {
+		Header header;
+		initHeader(header, dir.first.c_str());
+		header.clock = dir.second.clock;
+
+		u32 capacity = PLAYSTATS_MIN_CAPACITY;
+		while (dir.second.files.size() * 4 >= capacity * 3 && capacity < PLAYSTATS_MAX_CAPACITY)
+			capacity *= 2;
+		std::vector<Record> records;
+		resize(header, records, capacity);
+
+		for (const auto &file : dir.second.files) {
+			if (header.count + 1 >= capacity)
+				break;
+			const u32 nameHash = fnv1aHash(file.first.c_str());
+			const u32 nameHash2 = hash2(file.first.c_str());
+			Record &record = records[findSlot(records, nameHash, nameHash2)];
+			record.nameHash = nameHash;
+			record.nameHash2 = nameHash2;
+			record.lastPlayed = file.second.lastPlayed;
+			record.timesPlayed = file.second.timesPlayed;
+			header.count++;
+		}
+		writeStats(statsPath(dir.first.c_str()).c_str(), header, records);
+	}
+}
+
+PlayStats::PlayStats()
+{
+	initHeader(_header, "");
+}
+
+void PlayStats::openDir(const char *dirPath)
+{
+	if (!_statsPath.empty() && _dirPath == dirPath)
+		return;
+
+	static bool folderChecked = false;
+	if (!folderChecked) {
+		folderChecked = true;
+		char folderPath[64];
+		snprintf(folderPath, sizeof(folderPath), "%s:/_nds/TWiLightMenu/extras/playstats", statsDrive());
+		if (access(folderPath, F_OK) != 0) {
+			snprintf(folderPath, sizeof(folderPath), "%s:/_nds/TWiLightMenu/extras", statsDrive());
+			mkdir(folderPath, 0777);
+			snprintf(folderPath, sizeof(folderPath), "%s:/_nds/TWiLightMenu/extras/playstats", statsDrive());
+			if (mkdir(folderPath, 0777) == 0)
+				migrateIni();
+		}
+	}
+
+	_dirPath = dirPath;
+	_statsPath = statsPath(dirPath);
+	initHeader(_header, dirPath);
+	_records.clear();
+
+	FILE *file = fopen(_statsPath.c_str(), "rb");
+	if (!file)
+		return;
+
+	// The header, then the whole table, in one go
+	Header header;
+	if (fread(&header, sizeof(Header), 1, file) == 1
+	 && memcmp(header.magic, playStatsMagic, sizeof(playStatsMagic)) == 0
+	 && header.dirHash2 == _header.dirHash2
+	 && header.capacity >= PLAYSTATS_MIN_CAPACITY && header.capacity <= PLAYSTATS_MAX_CAPACITY
+	 && (header.capacity & (header.capacity - 1)) == 0
+	 && header.count < header.capacity) {
+		_records.resize(header.capacity);
+		if (fread(_records.data(), sizeof(Record), header.capacity, file) == header.capacity) {
+			// Counted again, as an interrupted addPlay() can leave the header's
+			// count out, and a search needs an empty slot to end at
+			header.count = usedSlots(_records);
+			if (header.count < header.capacity)
+				_header = header;
+			else
+				_records.clear();
+		} else {
+			_records.clear();
+		}
+	}
+	fclose(file);
+}
+
+const Record *PlayStats::find(const char *name) const
+{
+	if (_records.empty())
+		return NULL;
+	const u32 slot = findSlot(_records, fnv1aHash(name), hash2(name));
+	if (slot == _records.size())
+		return NULL;
+	const Record &record = _records[slot];
+	return (record.nameHash2 != 0) ? &record : NULL;
+}
+
+int PlayStats::recentRank(const char *name) const
+{
+	const Record *record = find(name);
+	return (record && record->lastPlayed != 0) ? (int)(_header.clock - record->lastPlayed) : -1;
+}
+
+int PlayStats::timesPlayed(const char *name) const
+{
+	const Record *record = find(name);
+	return record ? (int)record->timesPlayed : 0;
+}
+
+void PlayStats::addPlay(const char *name)
+{
+	if (_statsPath.empty())
+		return;
+
+	const u32 nameHash = fnv1aHash(name);
+	const u32 nameHash2 = hash2(name);
+
+	bool rewrite = _records.empty();
+	if (rewrite)
+		resize(_header, _records, PLAYSTATS_MIN_CAPACITY);
+
+	u32 slot = findSlot(_records, nameHash, nameHash2);
+	if (slot == _records.size())
+		return;
+	if (_records[slot].nameHash2 == 0) {
+		// Grow at 3/4 full, so a search always ends at an empty slot before long
+		if ((_header.count + 1) * 4 > _header.capacity * 3 && _header.capacity < PLAYSTATS_MAX_CAPACITY) {
+			resize(_header, _records, _header.capacity * 2);
+			slot = findSlot(_records, nameHash, nameHash2);
+			rewrite = true;
+		} else if (_header.count + 1 >= _header.capacity) {
+			return;
+		}
+		_records[slot].nameHash = nameHash;
+		_records[slot].nameHash2 = nameHash2;
+		_header.count++;
+	}
+
+	Record &record = _records[slot];
+	record.lastPlayed = ++_header.clock;
+	record.timesPlayed++;
+
+	if (!rewrite) {
+		FILE *file = fopen(_statsPath.c_str(), "r+b");
+		if (file) {
+			fwrite(&_header, sizeof(Header), 1, file);
+			fseek(file, sizeof(Header) + (slot * sizeof(Record)), SEEK_SET);
+			fwrite(&record, sizeof(Record), 1, file);
+			fclose(file);
+			return;
+		}
+	}
+	writeStats(_statsPath.c_str(), _header, _records);
+}
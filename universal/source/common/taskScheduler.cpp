@@ -0,0 +1,73 @@
+#include "common/taskScheduler.h"
+
+#include <algorithm>
+
+TaskScheduler::TaskScheduler(Clock clock)
+	: _clock(clock)
+	, _lastToken(0)
+	, _runningToken(0)
+	, _runningCancelled(false)
+{
+}
+
+u32 TaskScheduler::newToken(void)
+{
+	if (++_lastToken == 0)
+		_lastToken = 1;
+	return _lastToken;
+}
+
+void TaskScheduler::add(const Task &task, Priority priority, u32 token)
+{
+	_queues[priority].push_back({task, token});
+}
+
+void TaskScheduler::cancel(u32 token)
+{
+	if (token == 0)
+		return;
+
+	for (std::deque<QueuedTask> &queue : _queues) {
+		queue.erase(std::remove_if(queue.begin(), queue.end(), [token](const QueuedTask &queued) { return queued.token == token; }), queue.end());
+	}
+	if (_runningToken == token)
+		_runningCancelled = true;
+}
+
+bool TaskScheduler::run(u32 budget)
+{
+	const u32 start = _clock();
+	while (_clock() - start < budget) {
+		std::deque<QueuedTask> *queue = NULL;
+		for (std::deque<QueuedTask> &candidate : _queues) {
+			if (!candidate.empty()) {
+				queue = &candidate;
+				break;
+			}
+		}
+		if (!queue)
+			return false;
+
+		QueuedTask running = std::move(queue->front());
+		queue->pop_front();
+
+		_runningToken = running.token;
+		_runningCancelled = false;
+		const bool done = running.task();
+		_runningToken = 0;
+
+		// Resumed before anything else of its priority, even tasks it added
+		if (!done && !_runningCancelled)
+			queue->push_front(std::move(running));
+	}
+	return !empty();
+}
+
+bool TaskScheduler::empty(void) const
+{
+	for (const std::deque<QueuedTask> &queue : _queues) {
+		if (!queue.empty())
+			return false;
+	}
+	return true;
+}
@@ -0,0 +1,642 @@
+#include "common/titleIndex.h"
+#include "common/directoryModel.h"
+#include "common/flashcard.h"
+#include "common/fnv1a.h"
+
+#include <algorithm>
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+// For the second hash of the directory's path, so it doesn't collide where the first one does
+#define TITLEINDEX_HASH2_BASIS 0x2F6A3C71
+
+static_assert(sizeof(TitleIndex::Header) == 32, "TitleIndex::Header must be 32 bytes");
+static_assert(sizeof(TitleIndex::Entry) == 12, "TitleIndex::Entry must be 12 bytes");
+
+static const char titleIndexMagic[4] = {'T', 'I', 'X', '2'};
+
+typedef TitleIndex::Header Header;
+typedef TitleIndex::Entry Entry;
+typedef TitleIndex::Trigram Trigram;
+
+// Latin-1 and Latin Extended-A letters from U+00C0 to U+017F as the letters
+// they're typed as without their accents, empty for the two signs among them
+static const char latinFolds[0x180 - 0xC0][3] = {
+	"a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",	// U+00C0
+	"d", "n", "o", "o", "o", "o", "o", "", "o", "u", "u", "u", "u", "y", "th", "ss",	// U+00D0
+	"a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",	// U+00E0
+	"d", "n", "o", "o", "o", "o", "o", "", "o", "u", "u", "u", "u", "y", "th", "y",	// U+00F0
+	"a", "a", "a", "a", "a", "a", "c", "c", "c", "c", "c", "c", "c", "c", "d", "d",	// U+0100
+	"d", "d", "e", "e", "e", "e", "e", "e", "e", "e", "e", "e", "g", "g", "g", "g",	// U+0110
+	"g", "g", "g", "g", "h", "h", "h", "h", "i", "i", "i", "i", "i", "i", "i", "i",	// U+0120
+	"i", "i", "ij", "ij", "j", "j", "k", "k", "k", "l", "l", "l", "l", "l", "l", "l",	// U+0130
+	"l", "l", "l", "n", "n", "n", "n", "n", "n", "n", "n", "n", "o", "o", "o", "o",	// U+0140
+	"o", "o", "oe", "oe", "r", "r", "r", "r", "r", "r", "s", "s", "s", "s", "s", "s",	// U+0150
+	"s", "s", "t", "t", "t", "t", "t", "t", "u", "u", "u", "u", "u", "u", "u", "u",	// U+0160
+	"u", "u", "u", "u", "w", "w", "y", "y", "y", "z", "z", "z", "z", "z", "z", "s",	// U+0170
+};
+
+// Letters and digits lowercased, accented Latin letters as their base letters,
+// any other ASCII as one space between words, and anything else as UTF-8
+static void appendNormalized(std::string &text, u32 c)
+{
+	if (c >= 0xC0 && c < 0x180) {
+		const char *fold = latinFolds[c - 0xC0];
+		if (fold[0] == '\0')
+			appendNormalized(text, ' ');
+		for (; *fold; fold++)
+			text += *fold;
+		return;
+	}
+
+	if (c < 0x80) {
+		if (isalnum(c))
+			text += (char)tolower(c);
+		else if (!text.empty() && text.back() != ' ' && text.back() != '\n')
+			text += ' ';
+	} else if (c < 0x800) {
+		text += (char)(0xC0 | (c >> 6));
+		text += (char)(0x80 | (c & 0x3F));
+	} else {
+		text += (char)(0xE0 | (c >> 12));
+		text += (char)(0x80 | ((c >> 6) & 0x3F));
+		text += (char)(0x80 | (c & 0x3F));
+	}
+}
+
+static void endField(std::string &text)
+{
+	if (!text.empty() && text.back() == ' ')
+		text.pop_back();
+}
+
+// The name without its extension, or a query, already UTF-8
+static std::string normalizedName(const char *name, bool stripExtension)
+{
+	size_t length = strlen(name);
+	const char *dot = strrchr(name, '.');
+	if (stripExtension && dot && dot != name)
+		length = dot - name;
+
+	std::string text;
+	for (size_t i = 0; i < length; i++) {
+		const u8 c = name[i];
+		if (c < 0x80) {
+			appendNormalized(text, c);
+		} else if (c >= 0xC2 && c <= 0xDF && i + 1 < length && ((u8)name[i + 1] & 0xC0) == 0x80) {
+			// Two bytes, which has the accented letters a title's U+00C0 to U+017F are folded from
+			appendNormalized(text, ((c & 0x1F) << 6) | ((u8)name[++i] & 0x3F));
+		} else {
+			text += (char)c;
+		}
+	}
+	endField(text);
+	return text;
+}
+
+static inline u32 trigramKey(const char *text)
+{
+	return ((u32)(u8)text[0] << 16) | ((u32)(u8)text[1] << 8) | (u8)text[2];
+}
+
+// Each trigram of an entry's text once, not crossing from one field to the next
+static void entryTrigrams(const char *text, u32 length, std::vector<u32> &keys)
+{
+	keys.clear();
+	for (u32 i = 0; i + 3 <= length; i++) {
+		if (text[i] == '\n' || text[i + 1] == '\n' || text[i + 2] == '\n')
+			continue;
+		keys.push_back(trigramKey(text + i));
+	}
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
+
+/**
+ * A u32 for each trigram, by open addressing, for counting the entries
+ * with each one while rebuilding. Trigram keys are never 0, as the text
+ * has no '\0' in it, so 0 marks an empty slot.
+ */
+class TrigramTable
+{
+public:
+	TrigramTable() : _keys(1024, 0), _values(1024, 0), _size(0) {}
+
+	size_t size(void) const { return _size; }
+
+	u32 &slot(u32 key)
+	{
+		u32 i = find(key);
+		if (_keys[i] == 0) {
+			// Kept at most half full, so a search always ends before long
+			if ((_size + 1) * 2 > _keys.size()) {
+				grow();
+				i = find(key);
+			}
+			_keys[i] = key;
+			_size++;
+		}
+		return _values[i];
+	}
+
+	template <typename F>
+	void forEach(F function)
+	{
+		for (size_t i = 0; i < _keys.size(); i++) {
+			if (_keys[i] != 0)
+				function(_keys[i], _values[i]);
+		}
+	}
+
+private:
+	u32 find(u32 key) const
+	{
+		const u32 mask = _keys.size() - 1;
+		u32 i = (key * 0x9E3779B1u) & mask;
+		while (_keys[i] != 0 && _keys[i] != key)
+			i = (i + 1) & mask;
+		return i;
+	}
+
+	void grow(void)
+	{
+		std::vector<u32> keys(_keys.size() * 2, 0);
+		std::vector<u32> values(_values.size() * 2, 0);
+		keys.swap(_keys);
+		values.swap(_values);
+		for (size_t i = 0; i < keys.size(); i++) {
+			if (keys[i] != 0) {
+				const u32 slot = find(keys[i]);
+				_keys[slot] = keys[i];
+				_values[slot] = values[i];
+			}
+		}
+	}
+
+	std::vector<u32> _keys;
+	std::vector<u32> _values;
+	size_t _size;
+};
+
+static inline bool isFieldEnd(char c)
+{
+	return c == '\n' || c == '\0';
+}
+
+// Compare the rest of the fields two words start, up to the length of the shorter
+// one, if limit is set
+static int compareWords(const char *lhs, const char *rhs, size_t limit)
+{
+	for (size_t i = 0; i < limit; i++) {
+		const u8 l = isFieldEnd(lhs[i]) ? 0 : (u8)lhs[i];
+		const u8 r = isFieldEnd(rhs[i]) ? 0 : (u8)rhs[i];
+		if (l != r)
+			return (l < r) ? -1 : 1;
+		if (l == 0)
+			return 0;
+	}
+	return 0;
+}
+
+TitleIndex::TitleIndex() : _postingsReady(false), _changed(false)
+{
+	memset(&_header, 0, sizeof(_header));
+}
+
+void TitleIndex::clear(void)
+{
+	_entries.clear();
+	_positions.clear();
+	_text.clear();
+	_trigrams.clear();
+	_postings.clear();
+	_words.clear();
+	_postingsReady = false;
+	_changed = false;
+}
+
+void TitleIndex::openDir(const char *dirPath)
+{
+	if (!_indexPath.empty() && _dirPath == dirPath)
+		return;
+
+	flush();
+	clear();
+	_dirPath = dirPath;
+
+	const char *drive = sdFound() ? "sd" : "fat";
+	char path[64];
+	snprintf(path, sizeof(path), "%s:/_nds/TWiLightMenu/cache", drive);
+	mkdir(path, 0777);
+	snprintf(path, sizeof(path), "%s:/_nds/TWiLightMenu/cache/titleindex", drive);
+	mkdir(path, 0777);
+	snprintf(path, sizeof(path), "%s:/_nds/TWiLightMenu/cache/titleindex/%08lX.bin", drive, (unsigned long)fnv1aHash(dirPath));
+	_indexPath = path;
+
+	const u32 dirHash2 = fnv1aHash(dirPath, TITLEINDEX_HASH2_BASIS);
+
+	// The entries and text are read now, the rest only if there's a search
+	FILE *file = fopen(_indexPath.c_str(), "rb");
+	if (file) {
+		fseek(file, 0, SEEK_END);
+		const u64 fileSize = ftell(file);
+		fseek(file, 0, SEEK_SET);
+
+		// The sizes are checked against the file's before anything is allocated for them
+		if (fread(&_header, sizeof(_header), 1, file) == 1
+		 && memcmp(_header.magic, titleIndexMagic, sizeof(titleIndexMagic)) == 0
+		 && _header.dirHash2 == dirHash2
+		 && _header.count <= TITLE_INDEX_MAX_ENTRIES
+		 && fileSize == sizeof(Header) + (u64)_header.count * sizeof(Entry) + _header.textSize
+						+ (u64)_header.trigramCount * sizeof(Trigram) + (u64)_header.postingCount * sizeof(u16) + (u64)_header.wordCount * sizeof(u32)) {
+			_entries.resize(_header.count);
+			_text.resize(_header.textSize);
+			if ((_header.count > 0 && fread(_entries.data(), sizeof(Entry), _header.count, file) != _header.count)
+			 || (_header.textSize > 0 && fread(_text.data(), 1, _header.textSize, file) != _header.textSize)
+			 || !entriesValid()) {
+				clear();
+			}
+		}
+		fclose(file);
+	}
+
+	if (_entries.empty()) {
+		memset(&_header, 0, sizeof(_header));
+		memcpy(_header.magic, titleIndexMagic, sizeof(titleIndexMagic));
+		_header.dirHash2 = dirHash2;
+	}
+	_positions.assign(_entries.size(), -1);
+}
+
+bool TitleIndex::entriesValid(void) const
+{
+	// Each text has to end inside _text, and the hashes be in order for find()
+	for (size_t i = 0; i < _entries.size(); i++) {
+		const Entry &entry = _entries[i];
+		if ((u64)entry.textOffset + entry.textLength >= _text.size() || _text[entry.textOffset + entry.textLength] != '\0')
+			return false;
+		if (i > 0 && _entries[i - 1].nameHash >= entry.nameHash)
+			return false;
+	}
+	return _text.empty() || _text.back() == '\0';
+}
+
+bool TitleIndex::postingsValid(void) const
+{
+	for (size_t i = 0; i < _trigrams.size(); i++) {
+		if (_trigrams[i].firstPosting > _postings.size() || (i > 0 && _trigrams[i].firstPosting < _trigrams[i - 1].firstPosting))
+			return false;
+	}
+	for (u16 id : _postings) {
+		if (id >= _entries.size())
+			return false;
+	}
+
+	// entryAt() needs the texts in order to tell which one a word is in
+	for (size_t i = 1; i < _entries.size(); i++) {
+		if (_entries[i].textOffset < _entries[i - 1].textOffset)
+			return false;
+	}
+	for (u32 offset : _words) {
+		if (offset >= _text.size() || _entries.empty() || offset < _entries[0].textOffset)
+			return false;
+	}
+	return true;
+}
+
+int TitleIndex::find(u32 nameHash) const
+{
+	auto it = std::lower_bound(_entries.begin(), _entries.end(), nameHash, [](const Entry &entry, u32 hash) { return entry.nameHash < hash; });
+	if (it == _entries.end() || it->nameHash != nameHash)
+		return -1;
+	return it - _entries.begin();
+}
+
+void TitleIndex::addEntry(u32 nameHash, const std::string &text, bool hasTitles, int position)
+{
+	const size_t length = std::min(text.size(), (size_t)0xFFFF);
+	Entry entry = {nameHash, (u32)_text.size(), (u16)length, hasTitles};
+	_text.insert(_text.end(), text.begin(), text.begin() + length);
+	_text.push_back('\0');
+	_entries.push_back(entry);
+	_positions.push_back(position);
+}
+
+void TitleIndex::sortEntries(void)
+{
+	std::vector<u32> order(_entries.size());
+	for (size_t i = 0; i < order.size(); i++)
+		order[i] = i;
+	std::stable_sort(order.begin(), order.end(), [this](u32 lhs, u32 rhs) { return _entries[lhs].nameHash < _entries[rhs].nameHash; });
+
+	std::vector<Entry> entries;
+	std::vector<int> positions;
+	entries.reserve(order.size());
+	positions.reserve(order.size());
+	for (u32 i : order) {
+		// Two names with one hash are taken for one file
+		if (!entries.empty() && entries.back().nameHash == _entries[i].nameHash)
+			continue;
+		entries.push_back(_entries[i]);
+		positions.push_back(_positions[i]);
+	}
+	_entries.swap(entries);
+	_positions.swap(positions);
+}
+
+void TitleIndex::sync(const DirectoryModel &dirContents)
+{
+	if (_indexPath.empty())
+		return;
+
+	_positions.assign(_entries.size(), -1);
+
+	std::vector<int> added;
+	for (size_t i = 0; i < dirContents.size(); i++) {
+		const char *name = dirContents.name(i);
+		if (name[0] == '\0' || strcmp(name, "..") == 0)
+			continue;
+		const int index = find(fnv1aHash(name));
+		if (index < 0)
+			added.push_back(i);
+		else if (_positions[index] < 0)
+			_positions[index] = i;
+	}
+
+	// Drop the files that are gone, keeping the order
+	size_t kept = 0;
+	for (size_t i = 0; i < _entries.size(); i++) {
+		if (_positions[i] >= 0) {
+			_entries[kept] = _entries[i];
+			_positions[kept] = _positions[i];
+			kept++;
+		}
+	}
+	if (kept == _entries.size() && added.empty())
+		return;
+	_entries.resize(kept);
+	_positions.resize(kept);
+
+	for (int position : added) {
+		if (_entries.size() >= TITLE_INDEX_MAX_ENTRIES)
+			break;
+		const char *name = dirContents.name(position);
+		addEntry(fnv1aHash(name), normalizedName(name, !dirContents.isDirectory(position)), false, position);
+	}
+	if (!added.empty())
+		sortEntries();
+
+	_changed = true;
+	_postingsReady = false;
+}
+
+void TitleIndex::setTitles(const char *name, const u16 (*titles)[128], int count)
+{
+	if (_indexPath.empty())
+		return;
+
+	std::string text = normalizedName(name, true);
+	std::vector<std::string> fields;
+	for (int i = 0; i < count; i++) {
+		std::string title;
+		for (int j = 0; j < 128 && titles[i][j] != 0; j++)
+			appendNormalized(title, titles[i][j]);
+		endField(title);
+
+		// Most banners have the same title in several languages
+		if (title.empty() || std::find(fields.begin(), fields.end(), title) != fields.end())
+			continue;
+		text += '\n';
+		text += title;
+		fields.push_back(std::move(title));
+	}
+
+	const u32 nameHash = fnv1aHash(name);
+	const int index = find(nameHash);
+	if (index >= 0) {
+		Entry &entry = _entries[index];
+		if (entry.hasTitles && entry.textLength == std::min(text.size(), (size_t)0xFFFF) && memcmp(&_text[entry.textOffset], text.data(), entry.textLength) == 0)
+			return;
+
+		// The old text is left behind until the index is rebuilt
+		entry.textOffset = _text.size();
+		entry.textLength = std::min(text.size(), (size_t)0xFFFF);
+		entry.hasTitles = true;
+		_text.insert(_text.end(), text.begin(), text.begin() + entry.textLength);
+		_text.push_back('\0');
+	} else {
+		if (_entries.size() >= TITLE_INDEX_MAX_ENTRIES)
+			return;
+		addEntry(nameHash, text, true, -1);
+		sortEntries();
+	}
+
+	_changed = true;
+	_postingsReady = false;
+}
+
+void TitleIndex::compactText(void)
+{
+	// Leave out text that's been replaced, and put the entries' text in their order
+	std::vector<char> text;
+	text.reserve(_text.size());
+	for (Entry &entry : _entries) {
+		const u32 offset = text.size();
+		text.insert(text.end(), _text.begin() + entry.textOffset, _text.begin() + entry.textOffset + entry.textLength);
+		text.push_back('\0');
+		entry.textOffset = offset;
+	}
+	_text.swap(text);
+}
+
+void TitleIndex::rebuild(void)
+{
+	// The old ones are out of date, so they're freed before the new ones are made
+	std::vector<Trigram>().swap(_trigrams);
+	std::vector<u16>().swap(_postings);
+	std::vector<u32>().swap(_words);
+
+	compactText();
+
+	// Count the entries with each trigram, then give each trigram its place
+	// in the postings, and fill them in entry order, so they're sorted
+	// without a list of every trigram and entry pair
+	TrigramTable table;
+	std::vector<u32> keys;
+	for (const Entry &entry : _entries) {
+		entryTrigrams(&_text[entry.textOffset], entry.textLength, keys);
+		for (u32 key : keys)
+			table.slot(key)++;
+	}
+
+	_trigrams.reserve(table.size());
+	table.forEach([this](u32 key, u32 &count) { _trigrams.push_back({key, count}); });
+	std::sort(_trigrams.begin(), _trigrams.end(), [](const Trigram &lhs, const Trigram &rhs) { return lhs.key < rhs.key; });
+
+	u32 postingCount = 0;
+	for (Trigram &trigram : _trigrams) {
+		const u32 count = trigram.firstPosting;
+		trigram.firstPosting = postingCount;
+		table.slot(trigram.key) = postingCount;	// Now where its next entry goes
+		postingCount += count;
+	}
+
+	_postings.resize(postingCount);
+	for (size_t i = 0; i < _entries.size(); i++) {
+		const Entry &entry = _entries[i];
+		entryTrigrams(&_text[entry.textOffset], entry.textLength, keys);
+		for (u32 key : keys)
+			_postings[table.slot(key)++] = i;
+	}
+
+	for (const Entry &entry : _entries) {
+		const char *entryText = &_text[entry.textOffset];
+		for (int j = 0; j < entry.textLength; j++) {
+			if (entryText[j] != ' ' && entryText[j] != '\n' && (j == 0 || entryText[j - 1] == ' ' || entryText[j - 1] == '\n'))
+				_words.push_back(entry.textOffset + j);
+		}
+	}
+	const char *textStart = _text.data();
+	std::sort(_words.begin(), _words.end(), [textStart](u32 lhs, u32 rhs) { return compareWords(textStart + lhs, textStart + rhs, (size_t)-1) < 0; });
+
+	_postingsReady = true;
+}
+
+bool TitleIndex::loadPostings(void)
+{
+	// Postings aren't written until there's been a search
+	if (_changed || _header.wordCount == 0 || _header.count != _entries.size())
+		return false;
+
+	FILE *file = fopen(_indexPath.c_str(), "rb");
+	if (!file)
+		return false;
+
+	_trigrams.resize(_header.trigramCount);
+	_postings.resize(_header.postingCount);
+	_words.resize(_header.wordCount);
+	fseek(file, sizeof(Header) + _header.count * sizeof(Entry) + _header.textSize, SEEK_SET);
+	const bool read = fread(_trigrams.data(), sizeof(Trigram), _header.trigramCount, file) == _header.trigramCount
+				   && fread(_postings.data(), sizeof(u16), _header.postingCount, file) == _header.postingCount
+				   && fread(_words.data(), sizeof(u32), _header.wordCount, file) == _header.wordCount;
+	fclose(file);
+
+	_postingsReady = read && postingsValid();
+	if (!_postingsReady) {
+		_trigrams.clear();
+		_postings.clear();
+		_words.clear();
+	}
+	return _postingsReady;
+}
+
+void TitleIndex::flush(void)
+{
+	if (!_changed || _indexPath.empty())
+		return;
+
+	// Rebuilding takes much longer than writing, so it's left for a search if
+	// there hasn't been one since the index changed
+	if (!_postingsReady)
+		compactText();
+
+	_header.count = _entries.size();
+	_header.textSize = _text.size();
+	_header.trigramCount = _postingsReady ? _trigrams.size() : 0;
+	_header.postingCount = _postingsReady ? _postings.size() : 0;
+	_header.wordCount = _postingsReady ? _words.size() : 0;
+
+	FILE *file = fopen(_indexPath.c_str(), "wb");
+	if (!file)
+		return;
+	fwrite(&_header, sizeof(Header), 1, file);
+	fwrite(_entries.data(), sizeof(Entry), _entries.size(), file);
+	fwrite(_text.data(), 1, _text.size(), file);
+	fwrite(_trigrams.data(), sizeof(Trigram), _trigrams.size(), file);
+	fwrite(_postings.data(), sizeof(u16), _postings.size(), file);
+	fwrite(_words.data(), sizeof(u32), _words.size(), file);
+	fclose(file);
+
+	_changed = false;
+}
+
+u32 TitleIndex::entryAt(u32 textOffset) const
+{
+	// After a rebuild, the entries' text is in their order
+	auto it = std::upper_bound(_entries.begin(), _entries.end(), textOffset, [](u32 offset, const Entry &entry) { return offset < entry.textOffset; });
+	return (it - _entries.begin()) - 1;
+}
+
+size_t TitleIndex::search(const char *query, std::vector<int> &results, size_t maxResults)
+{
+	results.clear();
+
+	const std::string normalized = normalizedName(query, false);
+	if (normalized.empty() || _entries.empty())
+		return 0;
+
+	if (!_postingsReady && !loadPostings()) {
+		rebuild();
+		_changed = true;
+	}
+
+	std::vector<u16> matches;
+	if (normalized.size() >= 3) {
+		// Start from the trigram the fewest entries have, and check the rest have the others
+		struct Postings {
+			const u16 *begin;
+			const u16 *end;
+		};
+		std::vector<Postings> lists;
+		for (size_t i = 0; i + 3 <= normalized.size(); i++) {
+			const u32 key = trigramKey(normalized.c_str() + i);
+			auto it = std::lower_bound(_trigrams.begin(), _trigrams.end(), key, [](const Trigram &trigram, u32 key) { return trigram.key < key; });
+			if (it == _trigrams.end() || it->key != key)
+				return 0;
+			const u32 last = (it + 1 == _trigrams.end()) ? _postings.size() : (it + 1)->firstPosting;
+			lists.push_back({_postings.data() + it->firstPosting, _postings.data() + last});
+		}
+		std::sort(lists.begin(), lists.end(), [](const Postings &lhs, const Postings &rhs) { return (lhs.end - lhs.begin) < (rhs.end - rhs.begin); });
+
+		// The lists are in order, so each is only searched from where the last id was
+		for (const u16 *id = lists[0].begin; id != lists[0].end; id++) {
+			bool inAll = true;
+			for (size_t i = 1; i < lists.size() && inAll; i++) {
+				lists[i].begin = std::lower_bound(lists[i].begin, lists[i].end, *id);
+				inAll = (lists[i].begin != lists[i].end && *lists[i].begin == *id);
+			}
+			if (!inAll)
+				continue;
+
+			// Having every trigram doesn't make it contain the query
+			const Entry &entry = _entries[*id];
+			const char *entryText = &_text[entry.textOffset];
+			if (std::search(entryText, entryText + entry.textLength, normalized.begin(), normalized.end()) != entryText + entry.textLength)
+				matches.push_back(*id);
+		}
+	} else {
+		const char *textStart = _text.data();
+		const size_t length = normalized.size();
+		auto it = std::lower_bound(_words.begin(), _words.end(), normalized.c_str(), [textStart, length](u32 offset, const char *prefix) { return compareWords(textStart + offset, prefix, length) < 0; });
+
+		std::vector<bool> found(_entries.size(), false);
+		for (; it != _words.end() && compareWords(textStart + *it, normalized.c_str(), length) == 0; ++it)
+			found[entryAt(*it)] = true;
+		for (size_t i = 0; i < found.size(); i++) {
+			if (found[i])
+				matches.push_back(i);
+		}
+	}
+
+	for (u16 id : matches) {
+		if (_positions[id] >= 0)
+			results.push_back(_positions[id]);
+	}
+	std::sort(results.begin(), results.end());
+	const size_t total = results.size();
+	if (results.size() > maxResults)
+		results.resize(maxResults);
+	return total;
+}
@@ -2,12 +2,22 @@
 #include "common/twlmenusettings.h"
 #include "common/flashcard.h"
 #include "common/inifile.h"
+#include "common/iniSnapshot.h"
 #include "common/systemdetails.h"
 #include "myDSiMode.h"
 
 #include <nds/arm9/dldi.h>
+#include <stdio.h>
 #include <string.h>
 
+// Log how long loadSettings() takes, and how long parsing settings.ini with a CIniFile takes, through nocashMessage()
+// #define SETTINGS_LOAD_DEBUG
+
+#ifdef SETTINGS_LOAD_DEBUG
+// Timers 2 and 3, also the dsimenu theme's task clock, so left running if already started
+#define SETTINGS_TIMER	2
+#endif
+
 const char *charUnlaunchBg;
 bool *removeLauncherPatchesPtr;
 
@@ -134,11 +144,18 @@ TWLSettings::TWLSettings()
 
 void TWLSettings::loadSettings()
 {
+#ifdef SETTINGS_LOAD_DEBUG
+	if (!(TIMER_CR(SETTINGS_TIMER) & TIMER_ENABLE))
+		cpuStartTiming(SETTINGS_TIMER);
+	const u32 startTime = cpuGetTiming();
+#endif
+
 	if (access(settingsinipath, F_OK) != 0 && flashcardFound()) {
 		settingsinipath = DSIMENUPP_INI_FC; // Fallback to .ini path on flashcard, if not found on SD card, or if SD access is disabled
 	}
 
-	CIniFile settingsini(settingsinipath);
+	// Read from what the last module to boot kept of settings.ini, while it's unchanged
+	IniSnapshot settingsini(settingsinipath, "settings");
 
 	// UI settings.
 	romfolder[0] = settingsini.GetString("SRLOADER", "ROM_FOLDER", romfolder[0]);
@@ -312,6 +329,24 @@ void TWLSettings::loadSettings()
 	extendedMemory = settingsini.GetInt("NDS-BOOTSTRAP", "EXTENDED_MEMORY", extendedMemory);
 	forceSleepPatch = settingsini.GetInt("NDS-BOOTSTRAP", "FORCE_SLEEP_PATCH", forceSleepPatch);
 	soundFreq = (TSoundFreq)settingsini.GetInt("NDS-BOOTSTRAP", "SOUND_FREQ", soundFreq);
+
+	settingsini.SaveSnapshot();
+
+#ifdef SETTINGS_LOAD_DEBUG
+	const u32 loadTime = cpuGetTiming() - startTime;
+	// What every load took before, and what a stale snapshot still takes on top
+	const u32 iniStartTime = cpuGetTiming();
+	{
+		CIniFile parsedini(settingsinipath);
+	}
+	const u32 iniTime = cpuGetTiming() - iniStartTime;
+
+	char message[128];
+	snprintf(message, sizeof(message), "Settings load: %luus, %s. Parsing settings.ini: %luus",
+			 (u32)timerTicks2usec(loadTime), (settingsini.ReadFromIni() ? "read from settings.ini" : "all from the snapshot"),
+			 (u32)timerTicks2usec(iniTime));
+	nocashMessage(message);
+#endif
 }
 
 void TWLSettings::saveSettings()
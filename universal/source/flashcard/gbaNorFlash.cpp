@@ -0,0 +1,142 @@
+#include "gbaNorFlash.h"
+#include "exptools.h"
+#include "common/flashcard.h"
+#include "common/fnv1a.h"
+
+#include <stddef.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Written to the NOR this much at a time
+#define GBA_NOR_CHUNK_SIZE 0x8000
+// Compared against the start of the NOR, to tell if anything else has flashed it since
+#define GBA_NOR_HEADER_SIZE 0xC0
+
+static const char gbaNorMagic[4] = {'G', 'N', 'R', '1'};
+
+struct GbaNorManifest {
+	char magic[4];
+	u32 romSize;		// 0 while the NOR is being changed
+	u32 cluster;
+	u32 modified;
+	char path[256];
+	u8 header[GBA_NOR_HEADER_SIZE];
+	u32 blockHash[GBA_NOR_BLOCKS];	// FNV-1a of each block, up to romSize
+};
+
+static GbaNorManifest lastFlash;
+static GbaNorManifest thisFlash;
+
+static void writeManifest(const char *manifestPath, const GbaNorManifest &manifest)
+{
+	FILE *manifestFile = fopen(manifestPath, "wb");
+	if (manifestFile) {
+		fwrite(&manifest, sizeof(manifest), 1, manifestFile);
+		fclose(manifestFile);
+	}
+}
+
+bool gbaNorFlash(FILE *file, const char *path, u32 romSize, u8 *buffer, void (*progress)(u32 done, u32 total))
+{
+	if (romSize > GBA_NOR_MAX_SIZE)
+		romSize = GBA_NOR_MAX_SIZE;
+
+	const char *drive = sdFound() ? "sd" : "fat";
+	char manifestPath[64];
+	snprintf(manifestPath, sizeof(manifestPath), "%s:/_nds/TWiLightMenu/cache", drive);
+	mkdir(manifestPath, 0777);
+	snprintf(manifestPath, sizeof(manifestPath), "%s:/_nds/TWiLightMenu/cache/gbanor.bin", drive);
+
+	bool lastValid = false;
+	FILE *manifestFile = fopen(manifestPath, "rb");
+	if (manifestFile) {
+		lastValid = (fread(&lastFlash, sizeof(lastFlash), 1, manifestFile) == 1
+		 && memcmp(lastFlash.magic, gbaNorMagic, sizeof(gbaNorMagic)) == 0
+		 && lastFlash.romSize > 0 && lastFlash.romSize <= GBA_NOR_MAX_SIZE
+		 && memcmp((const void *)0x08000000, lastFlash.header, GBA_NOR_HEADER_SIZE) == 0);
+		fclose(manifestFile);
+	}
+
+	memset(&thisFlash, 0, sizeof(thisFlash));
+	memcpy(thisFlash.magic, gbaNorMagic, sizeof(gbaNorMagic));
+	if (strchr(path, ':')) {
+		strncpy(thisFlash.path, path, sizeof(thisFlash.path) - 1);
+	} else {
+		// Relative to the current directory, so a ROM of the same name elsewhere isn't taken for it
+		getcwd(thisFlash.path, sizeof(thisFlash.path));
+		strncat(thisFlash.path, path, sizeof(thisFlash.path) - strlen(thisFlash.path) - 1);
+	}
+
+	struct stat st;
+	const bool haveStat = (stat(path, &st) == 0);
+	if (haveStat) {
+		thisFlash.cluster = st.st_ino; // libfat reports the first cluster as the inode
+		thisFlash.modified = st.st_mtime;
+	}
+
+	fseek(file, 0, SEEK_SET);
+	const u32 headerSize = (romSize < GBA_NOR_HEADER_SIZE) ? romSize : GBA_NOR_HEADER_SIZE;
+	if (fread(thisFlash.header, 1, headerSize, file) != headerSize)
+		return false;
+	fseek(file, 0, SEEK_SET);
+
+	cExpansion::OpenNorWrite();
+	cExpansion::SetSerialMode();
+
+	// The same file, untouched since it was flashed
+	if (lastValid && haveStat && lastFlash.romSize == romSize
+	 && lastFlash.cluster == thisFlash.cluster && lastFlash.modified == thisFlash.modified
+	 && strcmp(lastFlash.path, thisFlash.path) == 0
+	 && memcmp(lastFlash.header, thisFlash.header, GBA_NOR_HEADER_SIZE) == 0) {
+		if (progress)
+			progress(romSize, romSize);
+		return true;
+	}
+
+	// In case flashing is cut short, so the blocks it did get to aren't trusted next time
+	writeManifest(manifestPath, thisFlash);
+
+	for (u32 block = 0; block < romSize; block += GBA_NOR_BLOCK_SIZE) {
+		const u32 index = block / GBA_NOR_BLOCK_SIZE;
+		const u32 blockSize = (romSize - block < GBA_NOR_BLOCK_SIZE) ? romSize - block : GBA_NOR_BLOCK_SIZE;
+		u32 hash = FNV1A_OFFSET_BASIS;
+
+		// Hash the block first if the last ROM had the same amount there, and leave it be if it matches
+		if (lastValid && lastFlash.romSize > block
+		 && ((lastFlash.romSize - block < GBA_NOR_BLOCK_SIZE) ? lastFlash.romSize - block : GBA_NOR_BLOCK_SIZE) == blockSize) {
+			for (u32 offset = 0; offset < blockSize; offset += GBA_NOR_CHUNK_SIZE) {
+				const u32 size = (blockSize - offset < GBA_NOR_CHUNK_SIZE) ? blockSize - offset : GBA_NOR_CHUNK_SIZE;
+				if (fread(buffer, 1, size, file) != size)
+					return false;
+				hash = fnv1aHash(buffer, size, hash);
+			}
+
+			if (hash == lastFlash.blockHash[index]) {
+				thisFlash.blockHash[index] = hash;
+				if (progress)
+					progress(block + blockSize, romSize);
+				continue;
+			}
+
+			fseek(file, block, SEEK_SET);
+			hash = FNV1A_OFFSET_BASIS;
+		}
+
+		expansion().Block_Erase(block);
+		for (u32 offset = 0; offset < blockSize; offset += GBA_NOR_CHUNK_SIZE) {
+			const u32 size = (blockSize - offset < GBA_NOR_CHUNK_SIZE) ? blockSize - offset : GBA_NOR_CHUNK_SIZE;
+			if (fread(buffer, 1, size, file) != size)
+				return false;
+			hash = fnv1aHash(buffer, size, hash);
+			expansion().WriteNorFlash(block + offset, buffer, size);
+			if (progress)
+				progress(block + offset + size, romSize);
+		}
+		thisFlash.blockHash[index] = hash;
+	}
+
+	thisFlash.romSize = romSize;
+	writeManifest(manifestPath, thisFlash);
+	return true;
+}
@@ -0,0 +1,471 @@
+#include "gamesettings/gameSettingsDb.h"
+#include "common/fnv1a.h"
+
+#include <algorithm>
+#include <ctype.h>
+#include <dirent.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <vector>
+
+// The header takes the first sector, so no record is ever split across two
+#define GAMESETTINGS_HEADER_SIZE 0x200
+#define GAMESETTINGS_SECTOR_RECORDS (0x200 / sizeof(GameSettingsRecord))
+#define GAMESETTINGS_MIN_CAPACITY 1024
+
+static_assert(sizeof(GameSettingsRecord) == 32, "GameSettingsRecord must divide a sector");
+
+static const char gameSettingsMagic[4] = {'G', 'S', 'D', '1'};
+
+struct GameSettingsHeader {
+	char magic[4];
+	u32 capacity;	// A power of 2
+	u32 count;
+};
+
+// The .ini names of each setting, with what older versions wrote as well
+static const struct {
+	const char *name;
+	GameSettingsKey key;
+} iniKeys[] = {
+	{"DIRECT_BOOT", GAMESETTINGS_DIRECT_BOOT},
+	{"DSI_MODE", GAMESETTINGS_DSI_MODE},
+	{"LANGUAGE", GAMESETTINGS_LANGUAGE},
+	{"REGION", GAMESETTINGS_REGION},
+	{"SAVE_NUMBER", GAMESETTINGS_SAVE_NUMBER},
+	{"RAM_DISK", GAMESETTINGS_RAM_DISK},
+	{"BOOST_CPU", GAMESETTINGS_BOOST_CPU},
+	{"BOOST_VRAM", GAMESETTINGS_BOOST_VRAM},
+	{"CARD_READ_DMA", GAMESETTINGS_CARD_READ_DMA},
+	{"ASYNC_CARD_READ", GAMESETTINGS_ASYNC_CARD_READ},
+	{"SWI_HALT_HOOK", GAMESETTINGS_SWI_HALT_HOOK},
+	{"BOOTSTRAP_FILE", GAMESETTINGS_BOOTSTRAP_FILE},
+	{"WIDESCREEN", GAMESETTINGS_WIDESCREEN},
+	{"EXTENDED_MEMORY", GAMESETTINGS_EXTENDED_MEMORY},
+	{"DSIWARE_BOOTER", GAMESETTINGS_DSIWARE_BOOTER},
+	{"USE_BOOTSTRAP", GAMESETTINGS_USE_BOOTSTRAP},
+	{"HEAP_SHRINK", GAMESETTINGS_HEAP_SHRINK},
+	{"NO_SHOW_AP_MSG", GAMESETTINGS_NO_SHOW_AP_MSG},
+	{"NO_SHOW_RAM_LIMIT_MSG", GAMESETTINGS_NO_SHOW_RAM_LIMIT_MSG},
+	{"NO_SHOW_RAM_LIMIT", GAMESETTINGS_NO_SHOW_RAM_LIMIT_MSG},
+};
+
+static u8 recordCheck(const GameSettingsRecord &record)
+{
+	const u8 *bytes = (const u8 *)&record;
+	u8 sum = 0x5A;
+	for (size_t i = 0; i < offsetof(GameSettingsRecord, check); i++)
+		sum += bytes[i];
+	return sum;
+}
+
+static inline bool slotEmpty(const GameSettingsRecord &record)
+{
+	return record.nameHash2 == 0;
+}
+
+static inline bool slotValid(const GameSettingsRecord &record)
+{
+	return !slotEmpty(record) && record.check == recordCheck(record);
+}
+
+static inline bool sameName(const GameSettingsRecord &a, const GameSettingsRecord &b)
+{
+	return a.nameHash == b.nameHash && a.nameHash2 == b.nameHash2;
+}
+
+// Ignoring case, as FAT does when opening a file by its name
+static u32 nameHash(const char *name, u32 hash)
+{
+	for (; *name; name++) {
+		hash ^= (u8)tolower((u8)*name);
+		hash *= FNV1A_PRIME;
+	}
+	return hash;
+}
+
+static void initRecord(GameSettingsRecord &record, const char *name, u32 tid)
+{
+	memset(&record, 0, sizeof(record));
+	record.nameHash = nameHash(name, FNV1A_OFFSET_BASIS);
+	record.nameHash2 = nameHash(name, ~FNV1A_OFFSET_BASIS) | 1;
+	record.tid = tid;
+	memset(record.value, GAMESETTINGS_UNSET, sizeof(record.value));
+}
+
+static void dbPath(char *path, size_t size, const char *drive, const char *suffix)
+{
+	snprintf(path, size, "%s/_nds/TWiLightMenu/gamesettings.db%s", drive, suffix);
+}
+
+/*
+ * Reads records a sector at a time, keeping the last sector read, as lookups
+ * probe the slots after the one a name hashes to.
+ */
+class SlotReader
+{
+public:
+	SlotReader(FILE *file) : _file(file), _sector(-1) {}
+
+	bool read(u32 slot, GameSettingsRecord &record)
+	{
+		const s32 sector = slot / GAMESETTINGS_SECTOR_RECORDS;
+		if (sector != _sector) {
+			_sector = -1;
+			if (fseek(_file, GAMESETTINGS_HEADER_SIZE + (sector * GAMESETTINGS_SECTOR_RECORDS * sizeof(GameSettingsRecord)), SEEK_SET) != 0
+			 || fread(_records, sizeof(GameSettingsRecord), GAMESETTINGS_SECTOR_RECORDS, _file) != GAMESETTINGS_SECTOR_RECORDS)
+				return false;
+			_sector = sector;
+		}
+		record = _records[slot % GAMESETTINGS_SECTOR_RECORDS];
+		return true;
+	}
+
+private:
+	FILE *_file;
+	s32 _sector;
+	GameSettingsRecord _records[GAMESETTINGS_SECTOR_RECORDS];
+};
+
+/**
+ * Find where a name's record is, or where it would go.
+ * @return false if the table couldn't be read, or is full.
+ */
+static bool findSlot(SlotReader &reader, u32 capacity, const GameSettingsRecord &key, u32 &slot, GameSettingsRecord &record)
+{
+	for (u32 probe = 0; probe < capacity; probe++) {
+		slot = (key.nameHash + probe) & (capacity - 1);
+		if (!reader.read(slot, record))
+			return false;
+		// A torn write of this name's record is taken as its place, but nothing else's
+		if (slotEmpty(record) || sameName(record, key))
+			return true;
+	}
+	return false;
+}
+
+static bool insertRecord(std::vector<GameSettingsRecord> &table, const GameSettingsRecord &record)
+{
+	const u32 capacity = table.size();
+	for (u32 probe = 0; probe < capacity; probe++) {
+		GameSettingsRecord &slot = table[(record.nameHash + probe) & (capacity - 1)];
+		if (slotEmpty(slot) || sameName(slot, record)) {
+			slot = record;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Write a new table holding records, to the .tmp file first, so the old one
+ * is whole until the new one is.
+ */
+static bool writeTable(const char *drive, const std::vector<GameSettingsRecord> &records)
+{
+	u32 capacity = GAMESETTINGS_MIN_CAPACITY;
+	while (capacity * 3 < records.size() * 4)
+		capacity <<= 1;
+
+	std::vector<GameSettingsRecord> table(capacity);
+	for (const GameSettingsRecord &record : records)
+		insertRecord(table, record);
+
+	char path[64], tmpPath[64];
+	dbPath(path, sizeof(path), drive, "");
+	dbPath(tmpPath, sizeof(tmpPath), drive, ".tmp");
+
+	FILE *file = fopen(tmpPath, "wb");
+	if (!file)
+		return false;
+
+	u8 header[GAMESETTINGS_HEADER_SIZE] = {0};
+	GameSettingsHeader *info = (GameSettingsHeader *)header;
+	memcpy(info->magic, gameSettingsMagic, sizeof(gameSettingsMagic));
+	info->capacity = capacity;
+	info->count = records.size();
+	bool ok = (fwrite(header, sizeof(header), 1, file) == 1
+	 && fwrite(table.data(), sizeof(GameSettingsRecord), capacity, file) == capacity);
+	ok = (fclose(file) == 0) && ok;
+	if (!ok) {
+		remove(tmpPath);
+		return false;
+	}
+
+	// FAT can't rename over a file, so there's a moment with only the .tmp, which openDb() finishes
+	remove(path);
+	return rename(tmpPath, path) == 0;
+}
+
+// Parse one .ini's [GAMESETTINGS] section into a record
+static bool migrateIni(const char *iniPath, const char *name, GameSettingsRecord &record)
+{
+	FILE *file = fopen(iniPath, "rb");
+	if (!file)
+		return false;
+
+	initRecord(record, name, 0);
+
+	char line[128];
+	bool inSection = false;
+	while (fgets(line, sizeof(line), file)) {
+		char *start = line + strspn(line, " \t");
+		if (*start == '[') {
+			inSection = (strncmp(start, "[GAMESETTINGS]", 14) == 0);
+			continue;
+		}
+		char *equals = strchr(start, '=');
+		if (!inSection || !equals)
+			continue;
+
+		char *keyEnd = equals;
+		while (keyEnd > start && (keyEnd[-1] == ' ' || keyEnd[-1] == '\t'))
+			keyEnd--;
+		*keyEnd = '\0';
+
+		for (const auto &iniKey : iniKeys) {
+			if (strcmp(start, iniKey.name) != 0)
+				continue;
+			const char *valueStart = equals + 1 + strspn(equals + 1, " \t");
+			const bool hex = (valueStart[0] == '0' && (valueStart[1] == 'x' || valueStart[1] == 'X'));
+			long value = strtol(valueStart, NULL, hex ? 16 : 10);
+			if (value < GAMESETTINGS_UNSET + 1)
+				value = GAMESETTINGS_UNSET + 1;
+			else if (value > 127)
+				value = 127;
+			// CIniFile took the first of a setting written twice
+			if (record.value[iniKey.key] == GAMESETTINGS_UNSET)
+				record.value[iniKey.key] = value;
+			break;
+		}
+	}
+	fclose(file);
+
+	record.check = recordCheck(record);
+	return true;
+}
+
+static void migrateDir(const char *drive, const char *subdir, std::vector<GameSettingsRecord> &records)
+{
+	char dirPath[64];
+	snprintf(dirPath, sizeof(dirPath), "%s/_nds/TWiLightMenu/gamesettings%s", drive, subdir);
+	DIR *dir = opendir(dirPath);
+	if (!dir)
+		return;
+
+	// The same prefix the menus name game card settings with
+	const char *namePrefix = (*subdir ? subdir + 1 : "");
+	const size_t prefixLength = strlen(namePrefix);
+
+	struct dirent *pent;
+	while ((pent = readdir(dir)) != NULL) {
+		const size_t length = strlen(pent->d_name);
+		if (pent->d_type == DT_DIR || length <= 4 || strcasecmp(pent->d_name + length - 4, ".ini") != 0)
+			continue;
+
+		std::string name(namePrefix, prefixLength);
+		if (prefixLength)
+			name += '/';
+		name.append(pent->d_name, length - 4);
+
+		std::string iniPath = std::string(dirPath) + "/" + pent->d_name;
+		GameSettingsRecord record;
+		if (migrateIni(iniPath.c_str(), name.c_str(), record))
+			records.push_back(record);
+	}
+	closedir(dir);
+}
+
+// Open the table, making it first from the .ini files if there isn't one
+static FILE *openTable(const char *drive, const char *path, const char *mode)
+{
+	FILE *file = fopen(path, mode);
+	if (!file) {
+		char tmpPath[64];
+		dbPath(tmpPath, sizeof(tmpPath), drive, ".tmp");
+		FILE *tmpFile = fopen(tmpPath, "rb");
+		bool tmpWhole = false;
+		if (tmpFile) {
+			GameSettingsHeader tmpHeader;
+			if (fread(&tmpHeader, sizeof(tmpHeader), 1, tmpFile) == 1) {
+				fseek(tmpFile, 0, SEEK_END);
+				tmpWhole = ((u32)ftell(tmpFile) == GAMESETTINGS_HEADER_SIZE + (tmpHeader.capacity * sizeof(GameSettingsRecord)));
+			}
+			fclose(tmpFile);
+		}
+
+		if (!(tmpWhole && rename(tmpPath, path) == 0)) {
+			std::vector<GameSettingsRecord> records;
+			migrateDir(drive, "", records);
+			migrateDir(drive, "/slot1", records);
+			if (!writeTable(drive, records))
+				return NULL;
+		}
+
+		file = fopen(path, mode);
+	}
+	return file;
+}
+
+/**
+ * Open the table and read its header.
+ * @return NULL if there's no table and one couldn't be made.
+ */
+static FILE *openDb(const char *drive, const char *mode, GameSettingsHeader &header)
+{
+	char path[64];
+	dbPath(path, sizeof(path), drive, "");
+
+	for (int attempt = 0; attempt < 2; attempt++) {
+		FILE *file = openTable(drive, path, mode);
+		if (!file)
+			return NULL;
+
+		if (fread(&header, sizeof(header), 1, file) == 1
+		 && memcmp(header.magic, gameSettingsMagic, sizeof(gameSettingsMagic)) == 0
+		 && header.capacity >= GAMESETTINGS_MIN_CAPACITY && (header.capacity & (header.capacity - 1)) == 0)
+			return file;
+
+		// Not a table, so it's made again from the .ini files
+		fclose(file);
+		remove(path);
+	}
+	return NULL;
+}
+
+void gameSettingsFindBatch(const char *drive, const char *const *names, int count, GameSettingsRecord *records, bool *found)
+{
+	if (count > GAMESETTINGS_BATCH_MAX)
+		count = GAMESETTINGS_BATCH_MAX;
+
+	int order[GAMESETTINGS_BATCH_MAX];
+	for (int i = 0; i < count; i++) {
+		initRecord(records[i], names[i], 0);
+		found[i] = false;
+		order[i] = i;
+	}
+
+	GameSettingsHeader header;
+	FILE *file = openDb(drive, "rb", header);
+	if (!file) {
+		// The table couldn't be made, maybe as the card is locked, so the .ini files are still read
+		for (int i = 0; i < count; i++) {
+			char iniPath[256];
+			snprintf(iniPath, sizeof(iniPath), "%s/_nds/TWiLightMenu/gamesettings/%s.ini", drive, names[i]);
+			found[i] = migrateIni(iniPath, names[i], records[i]);
+		}
+		return;
+	}
+
+	// Read in file order, so each sector is read once however many of the names are in it
+	const u32 mask = header.capacity - 1;
+	std::sort(order, order + count, [&](int a, int b) {
+		return (records[a].nameHash & mask) < (records[b].nameHash & mask);
+	});
+
+	SlotReader reader(file);
+	for (int i = 0; i < count; i++) {
+		GameSettingsRecord &record = records[order[i]];
+		GameSettingsRecord stored;
+		u32 slot;
+		if (findSlot(reader, header.capacity, record, slot, stored) && slotValid(stored)) {
+			record = stored;
+			found[order[i]] = true;
+		}
+	}
+	fclose(file);
+}
+
+GameSettings::GameSettings(const char *drive, const std::string &name, u32 tid, GameSettingsRecord *pageRecord)
+{
+	_drive = drive;
+	_modified = false;
+
+	const char *nameStr = name.c_str();
+	GameSettingsRecord key;
+	initRecord(key, nameStr, 0);
+	_pageRecord = (pageRecord && sameName(*pageRecord, key)) ? pageRecord : NULL;
+	if (_pageRecord) {
+		_record = *_pageRecord;
+	} else {
+		bool found;
+		gameSettingsFindBatch(drive, &nameStr, 1, &_record, &found);
+	}
+
+	if (tid)
+		_record.tid = tid;
+}
+
+int GameSettings::GetInt(GameSettingsKey key, int defaultValue) const
+{
+	const int value = _record.value[key];
+	return (value == GAMESETTINGS_UNSET) ? defaultValue : value;
+}
+
+void GameSettings::SetInt(GameSettingsKey key, int value)
+{
+	if (value <= GAMESETTINGS_UNSET)
+		value = GAMESETTINGS_UNSET + 1;
+	else if (value > 127)
+		value = 127;
+	if (_record.value[key] == value)
+		return;
+	_record.value[key] = value;
+	_modified = true;
+}
+
+bool GameSettings::Save(void)
+{
+	if (!_modified)
+		return true;
+
+	GameSettingsHeader header;
+	FILE *file = openDb(_drive, "r+b", header);
+	if (!file)
+		return false;
+
+	_record.check = recordCheck(_record);
+
+	SlotReader reader(file);
+	GameSettingsRecord stored;
+	u32 slot;
+	const bool haveSlot = findSlot(reader, header.capacity, _record, slot, stored);
+	const bool isNew = !haveSlot || slotEmpty(stored);
+
+	if (isNew && (header.count + 1) * 4 > header.capacity * 3) {
+		// Too full to probe quickly, so make a bigger table with this record in it
+		std::vector<GameSettingsRecord> records;
+		records.reserve(header.count + 1);
+		for (u32 i = 0; i < header.capacity; i++) {
+			if (reader.read(i, stored) && slotValid(stored))
+				records.push_back(stored);
+		}
+		records.push_back(_record);
+		fclose(file);
+		if (!writeTable(_drive, records))
+			return false;
+		if (_pageRecord)
+			*_pageRecord = _record;
+		_modified = false;
+		return true;
+	}
+
+	bool ok = haveSlot
+	 && fseek(file, GAMESETTINGS_HEADER_SIZE + (slot * sizeof(GameSettingsRecord)), SEEK_SET) == 0
+	 && fwrite(&_record, sizeof(_record), 1, file) == 1;
+	if (ok && isNew) {
+		// Only a hint of when to grow, so it's fine for it to be behind if this is cut short
+		header.count++;
+		ok = fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1;
+	}
+	ok = (fclose(file) == 0) && ok;
+	if (ok) {
+		if (_pageRecord)
+			*_pageRecord = _record;
+		_modified = false;
+	}
+	return ok;
+}
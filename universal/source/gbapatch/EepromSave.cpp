@@ -1,7 +1,7 @@
 #include "common/tonccpy.h"
-#include "find.h"
-#include "Save.h"
-#include "EepromSave.h"
+#include "gbapatch/romScan.h"
+#include "gbapatch/Save.h"
+#include "gbapatch/EepromSave.h"
 
 extern u32 romSize;
 
@@ -75,14 +75,24 @@ const u8 patch_eeprom_2[]=
     0x70,0x47  // BX      LR
 };
 
+void eeprom_addScanPatterns()
+{
+	romScan_addPattern(sReadEepromDwordV111Sig, 0x10, 0);
+	romScan_addPattern(sReadEepromDwordV120Sig, 0x10, 0);
+	romScan_addPattern(sProgramEepromDwordV111Sig, 0x10, 0);
+	romScan_addPattern(sProgramEepromDwordV120Sig, 0x10, 0);
+	romScan_addPattern(sProgramEepromDwordV124Sig, 0x10, 0);
+	romScan_addPattern(sProgramEepromDwordV126Sig, 0x10, 0);
+}
+
 bool eeprom_patchV111(const save_type_t* type)
 {
-	u8* readFunc = memsearch8((u8*)0x08000000, romSize, sReadEepromDwordV111Sig, 0x10, true);
+	u8* readFunc = romScan_find((u8*)0x08000000, romSize, sReadEepromDwordV111Sig, 0x10);
 	if (!readFunc)
 		return false;
 	tonccpy(readFunc, &patch_eeprom_1, sizeof(patch_eeprom_1));
 
-	u8* progFunc = memsearch8((u8*)0x08000000, romSize, sProgramEepromDwordV111Sig, 0x10, true);
+	u8* progFunc = romScan_find((u8*)0x08000000, romSize, sProgramEepromDwordV111Sig, 0x10);
 	if (!progFunc)
 		return false;
 	tonccpy(progFunc, &patch_eeprom_2, sizeof(patch_eeprom_2));
@@ -118,12 +128,12 @@ bool eeprom_patchV120(const save_type_t* type)
 		if (romPos >= romPos+romSize) break;
 	}
 
-	u8* readFunc = memsearch8((u8*)romPos, curRomSize, sReadEepromDwordV120Sig, 0x10, true);
+	u8* readFunc = romScan_find((u8*)romPos, curRomSize, sReadEepromDwordV120Sig, 0x10);
 	if (!readFunc)
 		return false;
 	tonccpy(readFunc, &patch_eeprom_1, sizeof(patch_eeprom_1));
 
-	u8* progFunc = memsearch8((u8*)romPos, curRomSize, sProgramEepromDwordV120Sig, 0x10, true);
+	u8* progFunc = romScan_find((u8*)romPos, curRomSize, sProgramEepromDwordV120Sig, 0x10);
 	if (!progFunc)
 		return false;
 	tonccpy(progFunc, &patch_eeprom_2, sizeof(patch_eeprom_2));
@@ -162,12 +172,12 @@ bool eeprom_patchV124(const save_type_t* type)
 		if (romPos >= romPos+romSize) break;
 	}
 
-	u8* readFunc = memsearch8((u8*)romPos, curRomSize, sReadEepromDwordV120Sig, 0x10, true);
+	u8* readFunc = romScan_find((u8*)romPos, curRomSize, sReadEepromDwordV120Sig, 0x10);
 	if (!readFunc)
 		return false;
 	tonccpy(readFunc, &patch_eeprom_1, sizeof(patch_eeprom_1));
 
-	u8* progFunc = memsearch8((u8*)romPos, curRomSize, sProgramEepromDwordV124Sig, 0x10, true);
+	u8* progFunc = romScan_find((u8*)romPos, curRomSize, sProgramEepromDwordV124Sig, 0x10);
 	if (!progFunc)
 		return false;
 	tonccpy(progFunc, &patch_eeprom_2, sizeof(patch_eeprom_2));
@@ -179,12 +189,12 @@ bool eeprom_patchV124(const save_type_t* type)
 
 bool eeprom_patchV126(const save_type_t* type)
 {
-	u8* readFunc = memsearch8((u8*)0x08000000, romSize, sReadEepromDwordV120Sig, 0x10, true);
+	u8* readFunc = romScan_find((u8*)0x08000000, romSize, sReadEepromDwordV120Sig, 0x10);
 	if (!readFunc)
 		return false;
 	tonccpy(readFunc, &patch_eeprom_1, sizeof(patch_eeprom_1));
 
-	u8* progFunc = memsearch8((u8*)0x08000000, romSize, sProgramEepromDwordV126Sig, 0x10, true);
+	u8* progFunc = romScan_find((u8*)0x08000000, romSize, sProgramEepromDwordV126Sig, 0x10);
 	if (!progFunc)
 		return false;
 	tonccpy(progFunc, &patch_eeprom_2, sizeof(patch_eeprom_2));
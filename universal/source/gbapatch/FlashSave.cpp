@@ -1,7 +1,7 @@
 #include "common/tonccpy.h"
-#include "find.h"
-#include "Save.h"
-#include "FlashSave.h"
+#include "gbapatch/romScan.h"
+#include "gbapatch/Save.h"
+#include "gbapatch/FlashSave.h"
 
 extern u32 romSize;
 
@@ -195,19 +195,44 @@ static const u8 flash_V12Y_replace4[38] = {
 };
 
 
+void flash_addScanPatterns()
+{
+	romScan_addPattern(flash_V12X_find1, sizeof(flash_V12X_find1), 0);
+	romScan_addPattern(flash_V12X_find2, sizeof(flash_V12X_find2), 0);
+	romScan_addPattern(flash_V12X_find3, sizeof(flash_V12X_find3), 0);
+	romScan_addPattern(flash_V12Y_find1, sizeof(flash_V12Y_find1), 0);
+	romScan_addPattern(flash_V12Y_find2, sizeof(flash_V12Y_find2), 0);
+	romScan_addPattern(flash_V12Y_find3, sizeof(flash_V12Y_find3), 0);
+	romScan_addPattern(flash_V12Y_find4, sizeof(flash_V12Y_find4), 0);
+	romScan_addPattern(flash512_V13X_find1, sizeof(flash512_V13X_find1), 0);
+	romScan_addPattern(flash512_V13X_find2, sizeof(flash512_V13X_find2), 0);
+	romScan_addPattern(flash512_V13X_find3, sizeof(flash512_V13X_find3), 0);
+	romScan_addPattern(flash512_V13X_find4, sizeof(flash512_V13X_find4), 0);
+	romScan_addPattern(flash512_V13X_find5, sizeof(flash512_V13X_find5), 0);
+	romScan_addPattern(flash1M_V102_find1, sizeof(flash1M_V102_find1), 0);
+	romScan_addPattern(flash1M_V102_find2, sizeof(flash1M_V102_find2), 0);
+	romScan_addPattern(flash1M_V102_find3, sizeof(flash1M_V102_find3), 0);
+	romScan_addPattern(flash1M_V102_find4, sizeof(flash1M_V102_find4), 0);
+	romScan_addPattern(flash1M_V103_find1, sizeof(flash1M_V103_find1), 0);
+	romScan_addPattern(flash1M_V103_find2, sizeof(flash1M_V103_find2), 0);
+	romScan_addPattern(flash1M_V103_find3, sizeof(flash1M_V103_find3), 0);
+	romScan_addPattern(flash1M_V103_find4, sizeof(flash1M_V103_find4), 0);
+	romScan_addPattern(flash1M_V103_find5, sizeof(flash1M_V103_find5), 0);
+}
+
 bool flash_patchV120(const save_type_t* type)
 {
-	u8* func1 = memsearch8((u8*)0x08000000, romSize, flash_V12X_find1, sizeof(flash_V12X_find1), true);
+	u8* func1 = romScan_find((u8*)0x08000000, romSize, flash_V12X_find1, sizeof(flash_V12X_find1));
 	if (!func1)
 		return false;
 	tonccpy(func1, &flash_V12X_replace1, sizeof(flash_V12X_replace1));
 
-	u8* func2 = memsearch8((u8*)0x08000000, romSize, flash_V12X_find2, sizeof(flash_V12X_find2), true);
+	u8* func2 = romScan_find((u8*)0x08000000, romSize, flash_V12X_find2, sizeof(flash_V12X_find2));
 	if (!func2)
 		return false;
 	tonccpy(func2, &flash_V12X_replace2, sizeof(flash_V12X_replace2));
 
-	u8* func3 = memsearch8((u8*)0x08000000, romSize, flash_V12X_find3, sizeof(flash_V12X_find3), true);
+	u8* func3 = romScan_find((u8*)0x08000000, romSize, flash_V12X_find3, sizeof(flash_V12X_find3));
 	if (!func3)
 		return false;
 	tonccpy(func3, &flash_V12X_replace3, sizeof(flash_V12X_replace3));
@@ -217,22 +242,22 @@ bool flash_patchV120(const save_type_t* type)
 
 bool flash_patchV123(const save_type_t* type)
 {
-	u8* func1 = memsearch8((u8*)0x08000000, romSize, flash_V12Y_find1, sizeof(flash_V12Y_find1), true);
+	u8* func1 = romScan_find((u8*)0x08000000, romSize, flash_V12Y_find1, sizeof(flash_V12Y_find1));
 	if (!func1)
 		return false;
 	tonccpy(func1, &flash_V12Y_replace1, sizeof(flash_V12Y_replace1));
 
-	u8* func2 = memsearch8((u8*)0x08000000, romSize, flash_V12Y_find2, sizeof(flash_V12Y_find2), true);
+	u8* func2 = romScan_find((u8*)0x08000000, romSize, flash_V12Y_find2, sizeof(flash_V12Y_find2));
 	if (!func2)
 		return false;
 	tonccpy(func2, &flash_V12Y_replace2, sizeof(flash_V12Y_replace2));
 
-	u8* func3 = memsearch8((u8*)0x08000000, romSize, flash_V12Y_find3, sizeof(flash_V12Y_find3), true);
+	u8* func3 = romScan_find((u8*)0x08000000, romSize, flash_V12Y_find3, sizeof(flash_V12Y_find3));
 	if (!func3)
 		return false;
 	tonccpy(func3, &flash_V12Y_replace3, sizeof(flash_V12Y_replace3));
 
-	u8* func4 = memsearch8((u8*)0x08000000, romSize, flash_V12Y_find4, sizeof(flash_V12Y_find4), true);
+	u8* func4 = romScan_find((u8*)0x08000000, romSize, flash_V12Y_find4, sizeof(flash_V12Y_find4));
 	if (!func4)
 		return false;
 	tonccpy(func4, &flash_V12Y_replace4, sizeof(flash_V12Y_replace4));
@@ -273,27 +298,27 @@ bool flash_patch512V130(const save_type_t* type)
 		if (romPos >= romPos+romSize) break;
 	}
 
-	u8* func1 = memsearch8((u8*)romPos, curRomSize, flash512_V13X_find1, sizeof(flash512_V13X_find1), true);
+	u8* func1 = romScan_find((u8*)romPos, curRomSize, flash512_V13X_find1, sizeof(flash512_V13X_find1));
 	if (!func1)
 		return false;
 	tonccpy(func1, &flash512_V13X_replace1, sizeof(flash512_V13X_replace1));
 
-	u8* func2 = memsearch8((u8*)romPos, curRomSize, flash512_V13X_find2, sizeof(flash512_V13X_find2), true);
+	u8* func2 = romScan_find((u8*)romPos, curRomSize, flash512_V13X_find2, sizeof(flash512_V13X_find2));
 	if (!func2)
 		return false;
 	tonccpy(func2, &flash512_V13X_replace2, sizeof(flash512_V13X_replace2));
 
-	u8* func3 = memsearch8((u8*)romPos, curRomSize, flash512_V13X_find3, sizeof(flash512_V13X_find3), true);
+	u8* func3 = romScan_find((u8*)romPos, curRomSize, flash512_V13X_find3, sizeof(flash512_V13X_find3));
 	if (!func3)
 		return false;
 	tonccpy(func3, &flash512_V13X_replace3_4, sizeof(flash512_V13X_replace3_4));
 
-	u8* func4 = memsearch8((u8*)romPos, curRomSize, flash512_V13X_find4, sizeof(flash512_V13X_find4), true);
+	u8* func4 = romScan_find((u8*)romPos, curRomSize, flash512_V13X_find4, sizeof(flash512_V13X_find4));
 	if (!func4)
 		return false;
 	tonccpy(func4, &flash512_V13X_replace3_4, sizeof(flash512_V13X_replace3_4));
 
-	u8* func5 = memsearch8((u8*)romPos, curRomSize, flash512_V13X_find5, sizeof(flash512_V13X_find5), true);
+	u8* func5 = romScan_find((u8*)romPos, curRomSize, flash512_V13X_find5, sizeof(flash512_V13X_find5));
 	if (!func5)
 		return false;
 	tonccpy(func5, &flash512_V13X_replace5, sizeof(flash512_V13X_replace5));
@@ -305,22 +330,22 @@ bool flash_patch512V130(const save_type_t* type)
 
 bool flash_patch1MV102(const save_type_t* type)
 {
-	u8* func1 = memsearch8((u8*)0x08000000, romSize, flash1M_V102_find1, sizeof(flash1M_V102_find1), true);
+	u8* func1 = romScan_find((u8*)0x08000000, romSize, flash1M_V102_find1, sizeof(flash1M_V102_find1));
 	if (!func1)
 		return false;
 	tonccpy(func1, &flash1M_V102_replace1, sizeof(flash1M_V102_replace1));
 
-	u8* func2 = memsearch8((u8*)0x08000000, romSize, flash1M_V102_find2, sizeof(flash1M_V102_find2), true);
+	u8* func2 = romScan_find((u8*)0x08000000, romSize, flash1M_V102_find2, sizeof(flash1M_V102_find2));
 	if (!func2)
 		return false;
 	tonccpy(func2, &flash1M_V102_replace2, sizeof(flash1M_V102_replace2));
 
-	u8* func3 = memsearch8((u8*)0x08000000, romSize, flash1M_V102_find3, sizeof(flash1M_V102_find3), true);
+	u8* func3 = romScan_find((u8*)0x08000000, romSize, flash1M_V102_find3, sizeof(flash1M_V102_find3));
 	if (!func3)
 		return false;
 	tonccpy(func3, &flash1M_V102_replace3, sizeof(flash1M_V102_replace3));
 
-	u8* func4 = memsearch8((u8*)0x08000000, romSize, flash1M_V102_find4, sizeof(flash1M_V102_find4), true);
+	u8* func4 = romScan_find((u8*)0x08000000, romSize, flash1M_V102_find4, sizeof(flash1M_V102_find4));
 	if (!func4)
 		return false;
 	tonccpy(func4, &flash1M_V102_replace4, sizeof(flash1M_V102_replace4));
@@ -330,27 +355,27 @@ bool flash_patch1MV102(const save_type_t* type)
 
 bool flash_patch1MV103(const save_type_t* type)
 {
-	u8* func1 = memsearch8((u8*)0x08000000, romSize, flash1M_V103_find1, sizeof(flash1M_V103_find1), true);
+	u8* func1 = romScan_find((u8*)0x08000000, romSize, flash1M_V103_find1, sizeof(flash1M_V103_find1));
 	if (!func1)
 		return false;
 	tonccpy(func1, &flash1M_V103_replace1, sizeof(flash1M_V103_replace1));
 
-	u8* func2 = memsearch8((u8*)0x08000000, romSize, flash1M_V103_find2, sizeof(flash1M_V103_find2), true);
+	u8* func2 = romScan_find((u8*)0x08000000, romSize, flash1M_V103_find2, sizeof(flash1M_V103_find2));
 	if (!func2)
 		return false;
 	tonccpy(func2, &flash1M_V103_replace2, sizeof(flash1M_V103_replace2));
 
-	u8* func3 = memsearch8((u8*)0x08000000, romSize, flash1M_V103_find3, sizeof(flash1M_V103_find3), true);
+	u8* func3 = romScan_find((u8*)0x08000000, romSize, flash1M_V103_find3, sizeof(flash1M_V103_find3));
 	if (!func3)
 		return false;
 	tonccpy(func3, &flash1M_V103_replace3, sizeof(flash1M_V103_replace3));
 
-	u8* func4 = memsearch8((u8*)0x08000000, romSize, flash1M_V103_find4, sizeof(flash1M_V103_find4), true);
+	u8* func4 = romScan_find((u8*)0x08000000, romSize, flash1M_V103_find4, sizeof(flash1M_V103_find4));
 	if (!func4)
 		return false;
 	tonccpy(func4, &flash1M_V103_replace4, sizeof(flash1M_V103_replace4));
 
-	u8* func5 = memsearch8((u8*)0x08000000, romSize, flash1M_V103_find5, sizeof(flash1M_V103_find5), true);
+	u8* func5 = romScan_find((u8*)0x08000000, romSize, flash1M_V103_find5, sizeof(flash1M_V103_find5));
 	if (!func5)
 		return false;
 	tonccpy(func5, &flash1M_V103_replace5, sizeof(flash1M_V103_replace5));
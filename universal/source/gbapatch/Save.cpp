@@ -1,8 +1,8 @@
 #include <nds.h>
-#include "common/tonccpy.h"
-#include "EepromSave.h"
-#include "FlashSave.h"
-#include "Save.h"
+#include "gbapatch/romScan.h"
+#include "gbapatch/EepromSave.h"
+#include "gbapatch/FlashSave.h"
+#include "gbapatch/Save.h"
 
 extern u32 romSize;
 
@@ -41,33 +41,29 @@ static const save_type_t sSaveTypes[SAVE_TYPE_COUNT] =
 	{"SRAM_V113", 10, SAVE_TYPE_SRAM_V113, 32 * 1024, NULL},
 };
 
-ITCM_CODE const save_type_t* save_findTag()
+static int sTagPatterns[SAVE_TYPE_COUNT];
+
+void save_addScanPatterns()
 {
-	u32  curAddr = 0x080000C0;
-	char saveTag[16];
-	while (curAddr < 0x08000000+romSize) {
-		u32 fst = *(u32*)curAddr;
-		tonccpy(&saveTag, (u8*)curAddr, 16);
-		SaveType type = SAVE_TYPE_NONE;
-		if (fst == 0x53414C46 && (saveTag[5] == '_' || saveTag[5] == '5' || saveTag[5] == '1')) {
-			//FLAS
-			type = SAVE_TYPE_FLASH;
-		} else if (fst == 0x4D415253) {
-			//SRAM
-			type = SAVE_TYPE_SRAM;
-		} else if (fst == 0x52504545 && saveTag[6] == '_') {
-			//EEPR
-			type = SAVE_TYPE_EEPROM;
-		}
+	// Tags are matched with their terminator, as strncmp() with tagLength did
+	for (int i = 0; i < SAVE_TYPE_COUNT; i++)
+		sTagPatterns[i] = romScan_addPattern((const u8*)sSaveTypes[i].tag, sSaveTypes[i].tagLength, ROMSCAN_TAG);
 
-		if (type != SAVE_TYPE_NONE) {
-			for (int i = 0; i < SAVE_TYPE_COUNT; i++) {
-				if (strncmp(saveTag, sSaveTypes[i].tag, sSaveTypes[i].tagLength) != 0)
-					continue;
-				return &sSaveTypes[i];
-			}
+	eeprom_addScanPatterns();
+	flash_addScanPatterns();
+}
+
+const save_type_t* save_findTag()
+{
+	// Whichever tag comes first in the ROM
+	const save_type_t* saveType = NULL;
+	u8* first = NULL;
+	for (int i = 0; i < SAVE_TYPE_COUNT; i++) {
+		u8* tag = romScan_first(sTagPatterns[i]);
+		if (tag && (!first || tag < first)) {
+			first = tag;
+			saveType = &sSaveTypes[i];
 		}
-		curAddr += 4;
 	}
-	return NULL;
+	return saveType;
 }
@@ -0,0 +1,356 @@
+#include <nds.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "common/flashcard.h"
+#include "common/fnv1a.h"
+#include "common/tonccpy.h"
+#include "gbapatch/find.h"
+#include "gbapatch/romScan.h"
+
+u32 romSize = 0;
+
+#define ROM			((u8*)0x08000000)
+#define ROM_MAX_SIZE	0x02000000
+
+// romScan_run() reads the ROM in chunks this size, plus enough either side, so every byte goes
+// over the slot-2 bus about once
+#define CHUNK_SIZE	0x4000
+
+// Save tags are only looked for from here
+#define TAG_START	0xC0
+
+static const char romScanMagic[4] = {'R', 'S', 'C', '1'};
+
+// What romScan_save() keeps, followed by each pattern's RomScanHits
+struct RomScanCache
+{
+	char magic[4];
+	u32  patternsHash;	// Of every pattern added, in order, so a different set isn't trusted
+	u32  patternCount;
+	u32  romSize;
+	u32  cluster;
+	u32  modified;
+	u32  waitStateEnd;
+};
+
+struct RomScanHits
+{
+	u16 hitCount;
+	u16 overflow;
+	u32 hits[ROMSCAN_MAX_HITS];
+};
+
+struct RomScanPattern
+{
+	const u8* find;
+	u32       size;
+	u32       flags;
+	u16       prefix;    // First two bytes, as a little-endian u16
+	u16       hitCount;
+	bool      overflow;  // Found more than ROMSCAN_MAX_HITS times
+	u32       hits[ROMSCAN_MAX_HITS];
+};
+
+static RomScanPattern patterns[ROMSCAN_MAX_PATTERNS];
+static int patternCount = 0;
+static bool scanned = false;
+static u32 waitStateEnd = 0;
+static u32 waitOffset = 0;	// Next word to check, each only once and in order
+
+// One bit for each possible first two bytes of a pattern, so most positions are ruled out
+// with a single lookup
+static u32 prefixBits[0x10000 / 32];
+
+static inline bool matches(const u8* data, const u8* find, u32 findSize)
+{
+	for (u32 i = 0; i < findSize; i++) {
+		if (data[i] != find[i])
+			return false;
+	}
+	return true;
+}
+
+int romScan_addPattern(const u8* find, u32 findSize, u32 flags)
+{
+	if (patternCount == ROMSCAN_MAX_PATTERNS || findSize < 2 || findSize > ROMSCAN_MAX_PATTERN_SIZE)
+		return -1;
+
+	RomScanPattern& pattern = patterns[patternCount];
+	pattern.find = find;
+	pattern.size = findSize;
+	pattern.flags = flags;
+	pattern.prefix = find[0] | (find[1] << 8);
+	pattern.hitCount = 0;
+	pattern.overflow = false;
+
+	prefixBits[pattern.prefix >> 5] |= BIT(pattern.prefix & 31);
+	return patternCount++;
+}
+
+/*
+ * The same check as gptc_patchWait() always made, on the buffered copy at data. The check at
+ * 0x410 was made after the others, but as it's never changed by a later one, it can be made in
+ * order here.
+ */
+static inline bool isWaitState(const u8* data, u32 offset)
+{
+	if (*(const u32*)data != 0x04000204)
+		return false;
+
+	const u8 prev = data[-1];
+	return (prev == 0x00 || prev == 0x03 || prev == 0x04 || data[7] == 0x04
+	  || prev == 0x08 || prev == 0x09
+	  || prev == 0x47 || prev == 0x81 || prev == 0x85
+	  || prev == 0xE0 || prev == 0xE7 || *(const u16*)(data-2) == 0xFFFE
+	  || offset == 0x410);
+}
+
+ITCM_CODE static void matchAt(const u8* data, u32 offset, u16 prefix)
+{
+	for (int i = 0; i < patternCount; i++) {
+		RomScanPattern& pattern = patterns[i];
+		if (pattern.prefix != prefix)
+			continue;
+		if ((pattern.flags & ROMSCAN_TAG) && ((offset & 3) || offset < TAG_START))
+			continue;
+		if (!matches(data, pattern.find, pattern.size))
+			continue;
+
+		if (pattern.hitCount < ROMSCAN_MAX_HITS)
+			pattern.hits[pattern.hitCount++] = offset;
+		else
+			pattern.overflow = true;
+	}
+}
+
+void romScan_begin(u32 end)
+{
+	for (int i = 0; i < patternCount; i++) {
+		patterns[i].hitCount = 0;
+		patterns[i].overflow = false;
+	}
+
+	scanned = false;
+	waitStateEnd = end;
+	waitOffset = TAG_START;
+}
+
+ITCM_CODE void romScan_chunk(u8* data, u32 offset, u32 size, u8* rom)
+{
+	// Patch out wait states first, as far as they can be looked ahead of, so the patterns are
+	// matched against the same bytes as when these were patched before searching
+	u32 waitEnd = offset + size + ROMSCAN_AHEAD - 8;
+	if (waitEnd > waitStateEnd)
+		waitEnd = waitStateEnd;
+	for (; waitOffset < waitEnd; waitOffset += 4) {
+		u8* word = data + waitOffset - offset;
+		if (isWaitState(word, waitOffset)) {
+			*(u32*)word = 0;
+			if (rom)
+				toncset((u16*)(rom + waitOffset - offset), 0, sizeof(u32));
+		}
+	}
+
+	if (offset + size > romSize)
+		size = (offset < romSize) ? romSize - offset : 0;
+
+	u32 prefix = data[0];
+	for (u32 i = 0; i < size; i++) {
+		prefix |= data[i + 1] << 8;
+		if (prefixBits[prefix >> 5] & BIT(prefix & 31))
+			matchAt(data + i, offset + i, prefix);
+		prefix >>= 8;
+	}
+}
+
+void romScan_end(void)
+{
+	scanned = true;
+}
+
+void romScan_run(u32 waitStateEnd)
+{
+	u8* chunkBuffer = new u8[ROMSCAN_BEHIND + CHUNK_SIZE + ROMSCAN_AHEAD];
+	u8* data = chunkBuffer + ROMSCAN_BEHIND;
+
+	romScan_begin(waitStateEnd);
+	for (u32 chunk = 0; chunk < romSize; chunk += CHUNK_SIZE) {
+		// chunkBuffer holds the ROM from chunk-ROMSCAN_BEHIND, including anything patched so far
+		const u32 bufferEnd = chunk + CHUNK_SIZE + ROMSCAN_AHEAD;
+		const u32 copyStart = (chunk == 0) ? 0 : chunk - ROMSCAN_BEHIND;
+		const u32 copyEnd = (bufferEnd < ROM_MAX_SIZE) ? bufferEnd : ROM_MAX_SIZE;
+		if (chunk == 0)
+			toncset(chunkBuffer, 0, ROMSCAN_BEHIND);
+		tonccpy(data + copyStart - chunk, ROM + copyStart, copyEnd - copyStart);
+		if (copyEnd < bufferEnd)
+			toncset(data + copyEnd - chunk, 0, bufferEnd - copyEnd);
+
+		romScan_chunk(data, chunk, CHUNK_SIZE, ROM + chunk);
+	}
+	romScan_end();
+
+	delete[] chunkBuffer;
+}
+
+u8* romScan_find(const u8* start, u32 dataSize, const u8* find, u32 findSize)
+{
+	const RomScanPattern* pattern = NULL;
+	for (int i = 0; i < patternCount; i++) {
+		if (patterns[i].find == find && patterns[i].size == findSize) {
+			pattern = &patterns[i];
+			break;
+		}
+	}
+
+	const u32 from = start - ROM;
+	if (!scanned || !pattern || start < ROM || from >= romSize)
+		return memsearch8(start, dataSize, find, findSize, true);
+
+	// Only the ROM itself was scanned
+	const u32 to = (dataSize < romSize - from) ? from + dataSize : romSize;
+
+	// Hits are in order, and any after the last one kept are still to be found
+	u32 searchFrom = pattern->overflow ? from : to;
+	for (int i = 0; i < pattern->hitCount; i++) {
+		const u32 hit = pattern->hits[i];
+		if (hit < from)
+			continue;
+		if (hit >= to)
+			return NULL;
+		if (matches(ROM + hit, find, findSize))
+			return ROM + hit;
+
+		// Patched over since, so anything after it could now be first
+		searchFrom = hit + 1;
+		break;
+	}
+
+	if (searchFrom < to) {
+		u8* found = memsearch8(ROM + searchFrom, to - searchFrom, find, findSize, true);
+		if (found)
+			return found;
+	}
+
+	if (dataSize > to - from)
+		return memsearch8(ROM + to, dataSize - (to - from), find, findSize, true);
+	return NULL;
+}
+
+u8* romScan_first(int pattern)
+{
+	if (!scanned || pattern < 0 || pattern >= patternCount)
+		return NULL;
+
+	// Skipping any patched over since
+	const RomScanPattern& p = patterns[pattern];
+	for (int i = 0; i < p.hitCount; i++) {
+		if (matches(ROM + p.hits[i], p.find, p.size))
+			return ROM + p.hits[i];
+	}
+	return NULL;
+}
+
+u32 romScan_waitStateEnd(void)
+{
+	return scanned ? waitStateEnd : 0;
+}
+
+static u32 patternsHash(void)
+{
+	u32 hash = FNV1A_OFFSET_BASIS;
+	for (int i = 0; i < patternCount; i++) {
+		hash = fnv1aHash(&patterns[i].size, sizeof(u32), hash);
+		hash = fnv1aHash(&patterns[i].flags, sizeof(u32), hash);
+		hash = fnv1aHash(patterns[i].find, patterns[i].size, hash);
+	}
+	return hash;
+}
+
+static void cachePath(char* path, size_t size, bool makeDir)
+{
+	const char* drive = sdFound() ? "sd" : "fat";
+	snprintf(path, size, "%s:/_nds/TWiLightMenu/cache", drive);
+	if (makeDir)
+		mkdir(path, 0777);
+	snprintf(path, size, "%s:/_nds/TWiLightMenu/cache/romscan.bin", drive);
+}
+
+void romScan_save(const char* path)
+{
+	char scanPath[64];
+	cachePath(scanPath, sizeof(scanPath), true);
+
+	struct stat st;
+	if (!scanned || stat(path, &st) != 0) {
+		remove(scanPath);
+		return;
+	}
+
+	RomScanCache cache;
+	tonccpy(cache.magic, romScanMagic, sizeof(romScanMagic));
+	cache.patternsHash = patternsHash();
+	cache.patternCount = patternCount;
+	cache.romSize = romSize;
+	cache.cluster = st.st_ino; // libfat reports the first cluster as the inode
+	cache.modified = st.st_mtime;
+	cache.waitStateEnd = waitStateEnd;
+
+	FILE* file = fopen(scanPath, "wb");
+	if (!file)
+		return;
+	fwrite(&cache, sizeof(cache), 1, file);
+	for (int i = 0; i < patternCount; i++) {
+		RomScanHits hits;
+		toncset(&hits, 0, sizeof(hits));
+		hits.hitCount = patterns[i].hitCount;
+		hits.overflow = patterns[i].overflow;
+		tonccpy(hits.hits, patterns[i].hits, sizeof(hits.hits));
+		fwrite(&hits, sizeof(hits), 1, file);
+	}
+	fclose(file);
+}
+
+bool romScan_load(const char* path)
+{
+	char scanPath[64];
+	cachePath(scanPath, sizeof(scanPath), false);
+
+	FILE* file = fopen(scanPath, "rb");
+	if (!file)
+		return false;
+
+	RomScanCache cache;
+	struct stat st;
+	bool valid = (fread(&cache, sizeof(cache), 1, file) == 1
+	 && memcmp(cache.magic, romScanMagic, sizeof(romScanMagic)) == 0
+	 && cache.patternsHash == patternsHash() && cache.patternCount == (u32)patternCount
+	 && cache.romSize == romSize
+	 && stat(path, &st) == 0 && cache.cluster == (u32)st.st_ino && cache.modified == (u32)st.st_mtime);
+
+	for (int i = 0; valid && i < patternCount; i++) {
+		RomScanHits hits;
+		valid = (fread(&hits, sizeof(hits), 1, file) == 1 && hits.hitCount <= ROMSCAN_MAX_HITS);
+		if (valid) {
+			patterns[i].hitCount = hits.hitCount;
+			patterns[i].overflow = hits.overflow;
+			tonccpy(patterns[i].hits, hits.hits, sizeof(hits.hits));
+		}
+	}
+	fclose(file);
+
+	// Only good for the one launch, as the ROM in slot-2 may be changed after
+	remove(scanPath);
+
+	if (!valid) {
+		for (int i = 0; i < patternCount; i++) {
+			patterns[i].hitCount = 0;
+			patterns[i].overflow = false;
+		}
+		return false;
+	}
+
+	waitStateEnd = cache.waitStateEnd;
+	scanned = true;
+	return true;
+}
@@ -0,0 +1,187 @@
+#include <nds.h>
+#include <nds/arm9/dldi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "common/tonccpy.h"
+#include "gbapatch/romScan.h"
+#include "gbapatch/romStream.h"
+
+#define ROM			((u8*)0x08000000)
+
+// gbapatcher puts the green swap patch from here, so the scan mustn't reach it
+#define PATCH_AREA	0x01FFFFB0
+
+#define STREAM_CHUNK_SIZE	0x8000
+#define STREAM_BUFFERS		3	// Reading into one, while another is DMAed out and the last is scanned
+#define STREAM_BUFFER_SIZE	(ROMSCAN_BEHIND + STREAM_CHUNK_SIZE + ROMSCAN_AHEAD)
+
+// The channel dmaCopy() and dmaFill() use, neither of which the menus call while loading
+#define STREAM_DMA		3
+
+// Log how long reading, scanning and writing each load takes, through nocashMessage()
+// #define ROM_STREAM_DEBUG
+
+#ifdef ROM_STREAM_DEBUG
+// Timers 2 and 3, also the dsimenu theme's task clock, so left running if already started
+#define STREAM_TIMER	2
+
+static struct {
+	u32 read;
+	u32 scan;
+	u32 write;	// Including waiting for the last DMA to finish
+} timing;
+static u32 lastTime;
+
+// Add the time since the last call to a stage
+static inline void lap(u32& stage)
+{
+	const u32 now = cpuGetTiming();
+	stage += now - lastTime;
+	lastTime = now;
+}
+#define LAP(stage) lap(timing.stage)
+#else
+#define LAP(stage)
+#endif
+
+extern void s2RamAccess(bool open);
+
+static void writeChunk(const u8* data, u32 dest, u32 size, bool async)
+{
+	if (!async) {
+		s2RamAccess(true);
+		tonccpy((u8*)dest, data, size);
+		s2RamAccess(false);
+		return;
+	}
+
+	const u32 words = size & ~3;
+	DC_FlushRange(data, words);
+	while (dmaBusy(STREAM_DMA));
+	dmaCopyWordsAsynch(STREAM_DMA, data, (u8*)dest, words);
+	if (size > words) {
+		while (dmaBusy(STREAM_DMA));
+		tonccpy((u8*)dest + words, data + words, size - words);
+	}
+}
+
+/*
+ * Fill the ROMSCAN_AHEAD bytes after a chunk with what the scan would see there in slot-2: the
+ * start of the next chunk, as much as there is, then whatever's already past the end of the ROM.
+ */
+static void fillAhead(u8* tail, const u8* next, u32 nextSize)
+{
+	const u32 fromNext = (nextSize < ROMSCAN_AHEAD) ? nextSize : ROMSCAN_AHEAD;
+	if (fromNext > 0)
+		tonccpy(tail, next, fromNext);
+	if (fromNext == ROMSCAN_AHEAD)
+		return;
+
+	const u32 count = ROMSCAN_AHEAD - fromNext;
+	s2RamAccess(true);
+	tonccpy(tail + fromNext, ROM + romSize, count);
+	s2RamAccess(false);
+}
+
+bool romStream_load(FILE* file, u32 ptr, u32 size, bool scan, u8* buffer, void (*progress)(u32 done, u32 total))
+{
+	u8* streamBuffers = (u8*)malloc(STREAM_BUFFERS * STREAM_BUFFER_SIZE);
+	u8* data[STREAM_BUFFERS];
+	int bufferCount = STREAM_BUFFERS;
+	if (streamBuffers) {
+		for (int i = 0; i < STREAM_BUFFERS; i++)
+			data[i] = streamBuffers + (i * STREAM_BUFFER_SIZE) + ROMSCAN_BEHIND;
+	} else {
+		// One chunk at a time, unscanned, through the buffer given
+		data[0] = buffer;
+		bufferCount = 1;
+		scan = false;
+	}
+
+	// Only scan if the results would be the same as gbapatcher scanning slot-2 itself
+	if ((u8*)ptr != ROM || size + ROMSCAN_AHEAD > PATCH_AREA)
+		scan = false;
+	const bool async = (bufferCount > 1) && (io_dldi_data->ioInterface.features & FEATURE_SLOT_NDS);
+
+	romSize = size;
+	if (scan) {
+		// gbapatcher leaves wait states alone with an EZ-Flash, as it doesn't call gptc_patchRom() then
+		romScan_begin((*(u16*)(0x020000C0) == 0x5A45) ? 0 : size);
+		toncset(data[0] - ROMSCAN_BEHIND, 0, ROMSCAN_BEHIND);
+	}
+
+#ifdef ROM_STREAM_DEBUG
+	timing = {0, 0, 0};
+	if (!(TIMER_CR(STREAM_TIMER) & TIMER_ENABLE))
+		cpuStartTiming(STREAM_TIMER);
+	lastTime = cpuGetTiming();
+	const u32 startTime = lastTime;
+#endif
+
+	const u32 chunks = (size + STREAM_CHUNK_SIZE - 1) / STREAM_CHUNK_SIZE;
+	const u32 firstSize = (size < STREAM_CHUNK_SIZE) ? size : STREAM_CHUNK_SIZE;
+	bool ok = (fread(data[0], 1, firstSize, file) == firstSize);
+	LAP(read);
+
+	for (u32 chunk = 0; ok && chunk < chunks; chunk++) {
+		const u32 offset = chunk * STREAM_CHUNK_SIZE;
+		const u32 chunkSize = (size - offset < STREAM_CHUNK_SIZE) ? size - offset : STREAM_CHUNK_SIZE;
+		u8* chunkData = data[chunk % bufferCount];
+
+		// Read the next chunk first, for the scan to look ahead into, and while the last is DMAed
+		u8* nextData = NULL;
+		u32 nextSize = 0;
+		if (bufferCount > 1 && chunk + 1 < chunks) {
+			nextData = data[(chunk + 1) % bufferCount];
+			nextSize = (size - offset - chunkSize < STREAM_CHUNK_SIZE) ? size - offset - chunkSize : STREAM_CHUNK_SIZE;
+			if (fread(nextData, 1, nextSize, file) != nextSize) {
+				ok = false;
+				nextSize = 0;
+			}
+			LAP(read);
+		}
+
+		if (scan) {
+			fillAhead(chunkData + chunkSize, nextData, nextSize);
+			romScan_chunk(chunkData, offset, chunkSize, NULL);
+
+			// Wait states patched out past the chunk go to the next one, which also needs the
+			// end of this one behind it
+			if (nextSize > 0) {
+				tonccpy(nextData, chunkData + chunkSize, (nextSize < ROMSCAN_AHEAD) ? nextSize : ROMSCAN_AHEAD);
+				tonccpy(nextData - ROMSCAN_BEHIND, chunkData + chunkSize - ROMSCAN_BEHIND, ROMSCAN_BEHIND);
+			}
+			LAP(scan);
+		}
+
+		writeChunk(chunkData, ptr + offset, chunkSize, async);
+		LAP(write);
+
+		if (progress)
+			progress(offset + chunkSize, size);
+
+		if (bufferCount == 1 && chunk + 1 < chunks) {
+			const u32 readSize = (size - offset - chunkSize < STREAM_CHUNK_SIZE) ? size - offset - chunkSize : STREAM_CHUNK_SIZE;
+			ok = (fread(chunkData, 1, readSize, file) == readSize);
+			LAP(read);
+		}
+	}
+
+	while (dmaBusy(STREAM_DMA));
+	LAP(write);
+
+#ifdef ROM_STREAM_DEBUG
+	char message[128];
+	snprintf(message, sizeof(message), "GBA ROM load: %luKB, dma=%d scan=%d. read %luus, scan %luus, write %luus, total %luus",
+			 size / 1024, async, scan,
+			 timerTicks2usec(timing.read), timerTicks2usec(timing.scan),
+			 timerTicks2usec(timing.write), timerTicks2usec(lastTime - startTime));
+	nocashMessage(message);
+#endif
+
+	if (scan && ok)
+		romScan_end();
+	free(streamBuffers);
+
+	return ok;
+}
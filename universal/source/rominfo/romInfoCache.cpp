@@ -0,0 +1,331 @@
+#include "rominfo/romInfoCache.h"
+#include "common/flashcard.h"
+#include "common/fnv1a.h"
+
+#include <algorithm>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+// File layout: Header, then ROMINFO_CACHE_MAX_ENTRIES index slots (only the
+// first count are in use), then the info and banner data of each entry.
+#define ROMINFO_CACHE_INDEX_START (sizeof(Header))
+#define ROMINFO_CACHE_DATA_START (sizeof(Header) + ROMINFO_CACHE_MAX_ENTRIES * sizeof(Entry))
+
+// Reads of cached data closer than this are joined into one by readPage()
+#define ROMINFO_CACHE_PAGE_GAP 0x1000
+
+// Offsets in a FAT directory entry
+#define DIR_ENTRY_CLUSTER_HIGH 0x14
+#define DIR_ENTRY_MODIFIED_TIME 0x16
+#define DIR_ENTRY_MODIFIED_DATE 0x18
+#define DIR_ENTRY_CLUSTER 0x1A
+#define DIR_ENTRY_FILE_SIZE 0x1C
+
+static const char romInfoCacheMagic[4] = {'R', 'I', 'C', '1'};
+
+static inline u16 readLE16(const u8 *p) { return p[0] | (p[1] << 8); }
+
+/**
+ * A FAT modification time as stat() reports it, the way libfat's
+ * _FAT_filetime_to_time_t() converts it, so both kinds of key match.
+ */
+static u32 fatModifiedTime(u16 time, u16 date)
+{
+	struct tm timeParts = {};
+	timeParts.tm_hour = time >> 11;
+	timeParts.tm_min = (time >> 5) & 0x3F;
+	timeParts.tm_sec = (time & 0x1F) << 1;
+	timeParts.tm_mday = date & 0x1F;
+	timeParts.tm_mon = ((date >> 5) & 0x0F) - 1;
+	timeParts.tm_year = (date >> 9) + 80;
+	timeParts.tm_isdst = 0;
+	return mktime(&timeParts);
+}
+
+RomInfoCache::RomInfoCache() : _file(NULL), _listingSorted(true)
+{
+	memset(&_header, 0, sizeof(_header));
+}
+
+RomInfoCache::~RomInfoCache()
+{
+	closeDir();
+}
+
+void RomInfoCache::openDir(const char *dirPath, u32 version)
+{
+	if (_file && _header.version == version && _dirPath == dirPath)
+		return;
+
+	closeDir();
+	_dirPath = dirPath;
+
+	const char *drive = sdFound() ? "sd" : "fat";
+	char cachePath[64];
+	snprintf(cachePath, sizeof(cachePath), "%s:/_nds/TWiLightMenu/cache", drive);
+	mkdir(cachePath, 0777);
+	snprintf(cachePath, sizeof(cachePath), "%s:/_nds/TWiLightMenu/cache/rominfo", drive);
+	mkdir(cachePath, 0777);
+	// Each layout gets its own file, so themes with different info blocks
+	// don't keep throwing away each other's cache
+	const u32 pathHash = fnv1aHash(&version, sizeof(version), fnv1aHash(dirPath));
+	snprintf(cachePath, sizeof(cachePath), "%s:/_nds/TWiLightMenu/cache/rominfo/%08lX.bin", drive, (unsigned long)pathHash);
+
+	_file = fopen(cachePath, "r+b");
+	if (!_file) {
+		_file = fopen(cachePath, "w+b");
+		if (!_file)
+			return;
+	}
+
+	// Read the header and the used part of the index in one go
+	if (fread(&_header, sizeof(_header), 1, _file) != 1
+	 || memcmp(_header.magic, romInfoCacheMagic, sizeof(romInfoCacheMagic)) != 0
+	 || _header.version != version
+	 || _header.count > ROMINFO_CACHE_MAX_ENTRIES
+	 || _header.dataEnd < ROMINFO_CACHE_DATA_START) {
+		_header.version = version;
+		reset();
+		return;
+	}
+
+	_entries.resize(_header.count);
+	if (_header.count > 0 && fread(_entries.data(), sizeof(Entry), _header.count, _file) != _header.count) {
+		reset();
+		return;
+	}
+	_slots.reserve(_entries.size());
+	for (u32 i = 0; i < _entries.size(); i++)
+		_slots.emplace(_entries[i].nameHash, i);
+}
+
+void RomInfoCache::closeDir(void)
+{
+	if (_file) {
+		fclose(_file);
+		_file = NULL;
+	}
+	_dirPath.clear();
+	_entries.clear();
+	_slots.clear();
+	_page.clear();
+	_pageRuns.clear();
+}
+
+void RomInfoCache::listFile(const char *name, const u8 *dirEntry)
+{
+	ListedFile file;
+	file.nameHash = fnv1aHash(name);
+	file.fileSize = readLE16(dirEntry + DIR_ENTRY_FILE_SIZE) | ((u32)readLE16(dirEntry + DIR_ENTRY_FILE_SIZE + 2) << 16);
+	// libfat only reads the high half on FAT32, but it's 0 everywhere else
+	file.cluster = readLE16(dirEntry + DIR_ENTRY_CLUSTER) | ((u32)readLE16(dirEntry + DIR_ENTRY_CLUSTER_HIGH) << 16);
+	file.time = readLE16(dirEntry + DIR_ENTRY_MODIFIED_TIME);
+	file.date = readLE16(dirEntry + DIR_ENTRY_MODIFIED_DATE);
+	_listing.push_back(file);
+	_listingSorted = false;
+}
+
+void RomInfoCache::clearListing(void)
+{
+	_listing.clear();
+	_listingSorted = true;
+}
+
+void RomInfoCache::readPage(const char *const *names, int count)
+{
+	_page.clear();
+	_pageRuns.clear();
+	if (!_file)
+		return;
+
+	std::vector<const Entry *> hits;
+	for (int i = 0; i < count; i++) {
+		int index = findEntry(fnv1aHash(names[i]));
+		if (index >= 0)
+			hits.push_back(&_entries[index]);
+	}
+	std::sort(hits.begin(), hits.end(), [](const Entry *lhs, const Entry *rhs) { return lhs->offset < rhs->offset; });
+
+	// Join the entries into runs, reading through small gaps rather than seeking
+	u32 pageSize = 0;
+	for (const Entry *entry : hits) {
+		const u32 size = entry->infoSize + entry->bannerSize;
+		PageRun *run = _pageRuns.empty() ? NULL : &_pageRuns.back();
+		if (run && entry->offset < run->offset + run->size)
+			continue; // A name listed twice
+		const u32 gap = run ? entry->offset - (run->offset + run->size) : 0;
+		if (run && gap <= ROMINFO_CACHE_PAGE_GAP) {
+			if (pageSize + gap + size > ROMINFO_CACHE_PAGE_MAX_SIZE)
+				break;
+			run->size += gap + size;
+			pageSize += gap + size;
+		} else {
+			if (pageSize + size > ROMINFO_CACHE_PAGE_MAX_SIZE)
+				break;
+			_pageRuns.push_back({entry->offset, size, pageSize});
+			pageSize += size;
+		}
+	}
+
+	_page.resize(pageSize);
+	for (size_t i = 0; i < _pageRuns.size(); i++) {
+		const PageRun &run = _pageRuns[i];
+		fseek(_file, run.offset, SEEK_SET);
+		if (fread(&_page[run.pageOffset], 1, run.size, _file) != run.size) {
+			_pageRuns.resize(i);
+			break;
+		}
+	}
+}
+
+const u8 *RomInfoCache::findInPage(const Entry &entry)
+{
+	const u32 size = entry.infoSize + entry.bannerSize;
+	for (const PageRun &run : _pageRuns) {
+		if (entry.offset >= run.offset && entry.offset + size <= run.offset + run.size)
+			return &_page[run.pageOffset + (entry.offset - run.offset)];
+	}
+	return NULL;
+}
+
+bool RomInfoCache::get(const char *name, void *info, u32 infoSize, void *banner, u32 bannerMaxSize, u32 *bannerSize)
+{
+	if (!_file)
+		return false;
+
+	Entry key;
+	if (!fileKey(name, key))
+		return false;
+
+	int index = findEntry(key.nameHash);
+	if (index < 0)
+		return false;
+
+	const Entry &entry = _entries[index];
+	if (entry.fileSize != key.fileSize || entry.cluster != key.cluster || entry.modified != key.modified || entry.infoSize != infoSize)
+		return false;
+
+	u32 size = entry.bannerSize;
+	if (banner && size > bannerMaxSize)
+		size = bannerMaxSize;
+
+	const u8 *data = findInPage(entry);
+	if (data) {
+		memcpy(info, data, infoSize);
+		if (banner && size > 0)
+			memcpy(banner, data + infoSize, size);
+	} else {
+		fseek(_file, entry.offset, SEEK_SET);
+		if (fread(info, 1, infoSize, _file) != infoSize)
+			return false;
+		if (banner && size > 0 && fread(banner, 1, size, _file) != size)
+			return false;
+	}
+
+	*bannerSize = size;
+	return true;
+}
+
+void RomInfoCache::put(const char *name, const void *info, u32 infoSize, const void *banner, u32 bannerSize)
+{
+	if (!_file)
+		return;
+
+	Entry entry;
+	if (!fileKey(name, entry))
+		return;
+
+	const u32 size = infoSize + bannerSize;
+	if (_header.count >= ROMINFO_CACHE_MAX_ENTRIES || _header.dataEnd + size > ROMINFO_CACHE_MAX_DATA_SIZE) {
+		reset();
+	}
+
+	entry.offset = _header.dataEnd;
+	entry.infoSize = infoSize;
+	entry.bannerSize = bannerSize;
+
+	fseek(_file, entry.offset, SEEK_SET);
+	if (fwrite(info, 1, infoSize, _file) != infoSize)
+		return;
+	if (bannerSize > 0 && fwrite(banner, 1, bannerSize, _file) != bannerSize)
+		return;
+	_header.dataEnd += size;
+
+	// Write the slot and header in the order that leaves the file valid if
+	// interrupted: a new slot is only counted once it's written, and a
+	// replaced slot only points at data already past dataEnd.
+	int index = findEntry(entry.nameHash);
+	if (index < 0) {
+		_slots.emplace(entry.nameHash, _entries.size());
+		_entries.push_back(entry);
+		writeEntry(_header.count);
+		_header.count++;
+		writeHeader();
+	} else {
+		_entries[index] = entry;
+		writeHeader();
+		writeEntry(index);
+	}
+	fflush(_file);
+}
+
+bool RomInfoCache::fileKey(const char *name, Entry &entry)
+{
+	memset(&entry, 0, sizeof(entry));
+	entry.nameHash = fnv1aHash(name);
+
+	// A listed file is found without searching its directory for the name again
+	if (!_listingSorted) {
+		std::sort(_listing.begin(), _listing.end(), [](const ListedFile &lhs, const ListedFile &rhs) { return lhs.nameHash < rhs.nameHash; });
+		_listingSorted = true;
+	}
+	std::vector<ListedFile>::const_iterator listed = std::lower_bound(_listing.begin(), _listing.end(), entry.nameHash,
+		[](const ListedFile &file, u32 nameHash) { return file.nameHash < nameHash; });
+	if (listed != _listing.end() && listed->nameHash == entry.nameHash) {
+		entry.fileSize = listed->fileSize;
+		entry.cluster = listed->cluster;
+		entry.modified = fatModifiedTime(listed->time, listed->date);
+		return true;
+	}
+
+	struct stat st;
+	if (stat(name, &st) != 0 || S_ISDIR(st.st_mode))
+		return false;
+
+	entry.fileSize = st.st_size;
+	entry.cluster = st.st_ino; // libfat reports the first cluster as the inode
+	entry.modified = st.st_mtime;
+	return true;
+}
+
+int RomInfoCache::findEntry(u32 nameHash)
+{
+	std::unordered_map<u32, u32>::const_iterator it = _slots.find(nameHash);
+	return (it == _slots.end()) ? -1 : (int)it->second;
+}
+
+void RomInfoCache::reset(void)
+{
+	_entries.clear();
+	_slots.clear();
+	_page.clear();
+	_pageRuns.clear();
+	memcpy(_header.magic, romInfoCacheMagic, sizeof(romInfoCacheMagic));
+	_header.count = 0;
+	_header.dataEnd = ROMINFO_CACHE_DATA_START;
+	writeHeader();
+	fflush(_file);
+}
+
+void RomInfoCache::writeHeader(void)
+{
+	fseek(_file, 0, SEEK_SET);
+	fwrite(&_header, sizeof(_header), 1, _file);
+}
+
+void RomInfoCache::writeEntry(u32 slot)
+{
+	fseek(_file, ROMINFO_CACHE_INDEX_START + slot * sizeof(Entry), SEEK_SET);
+	fwrite(&_entries[slot], sizeof(Entry), 1, _file);
+}